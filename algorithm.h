@@ -8,9 +8,30 @@
 #ifndef ALGORITHM_H_
 #define ALGORITHM_H_
 
+#include "functional.h"
 #include "iterator.h"
 #include "type_traits.h"
 #include "utility.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstring>
+
+// SSE2 在x86-64上总是可用；其他平台走标量路径
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SUGAR_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define SUGAR_HAS_SSE2 0
+#endif
+
+// SSSE3 提供 pshufb（_mm_shuffle_epi8），需要编译时开启（如 -mssse3 / -march=native）
+#if SUGAR_HAS_SSE2 && defined(__SSSE3__)
+#define SUGAR_HAS_SSSE3 1
+#include <tmmintrin.h>
+#else
+#define SUGAR_HAS_SSSE3 0
+#endif
 
 namespace sugar {
 
@@ -451,6 +472,2607 @@ sugar::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first, ForwardIt last
     return sugar::make_pair(smallest, largest);
 }
 
+// ============================ 子串查找 ============================
+
+/**
+ * @brief 相等比较（两侧类型可以不同），用于不带谓词的查找算法
+ */
+struct iter_equal_to {
+    template<typename T, typename U>
+    bool operator()(const T& a, const U& b) const {
+        return a == b;
+    }
+};
+
+/**
+ * @brief 朴素子串查找
+ * @param first 被查找区间的起始迭代器
+ * @param last 被查找区间的结束迭代器
+ * @param s_first 模式的起始迭代器
+ * @param s_last 模式的结束迭代器
+ * @param pred 相等谓词
+ * @return 第一次出现的位置，未找到返回last
+ */
+template<typename ForwardIt1, typename ForwardIt2, typename BinaryPredicate>
+ForwardIt1 search(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last, BinaryPredicate pred) {
+    for (;; ++first) {
+        ForwardIt1 it = first;
+        for (ForwardIt2 s_it = s_first; ; ++it, ++s_it) {
+            if (s_it == s_last) {
+                return first;
+            }
+            if (it == last) {
+                return last;
+            }
+            if (!pred(*it, *s_it)) {
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 朴素查找器：对任意前向迭代器和谓词可用，最坏O(nm)
+ */
+template<typename ForwardIt, typename BinaryPredicate = iter_equal_to>
+class default_searcher {
+private:
+    ForwardIt pat_first_;
+    ForwardIt pat_last_;
+    BinaryPredicate pred_;
+
+public:
+    default_searcher(ForwardIt pat_first, ForwardIt pat_last, BinaryPredicate pred = BinaryPredicate())
+        : pat_first_(pat_first), pat_last_(pat_last), pred_(pred) {}
+
+    /**
+     * @brief 查找模式
+     * @return 匹配区间[match, match_end)，未找到时两者都为last
+     */
+    template<typename ForwardIt2>
+    sugar::pair<ForwardIt2, ForwardIt2> operator()(ForwardIt2 first, ForwardIt2 last) const {
+        ForwardIt2 match = sugar::search(first, last, pat_first_, pat_last_, pred_);
+        if (match == last) {
+            return sugar::pair<ForwardIt2, ForwardIt2>(last, last);
+        }
+        ForwardIt2 match_end = match;
+        sugar::advance(match_end, sugar::distance(pat_first_, pat_last_));
+        return sugar::pair<ForwardIt2, ForwardIt2>(match, match_end);
+    }
+};
+
+/**
+ * @brief Two-Way 查找器（Crochemore-Perrin）
+ *
+ * 预处理时把模式在临界位置切成左右两半：先从左到右比较右半，失配时按已比较长度跳跃；
+ * 右半完全匹配后再从右到左比较左半，失配时按模式周期跳跃。总比较次数不超过2n，
+ * 额外空间O(1)，用作其他快速算法的最坏情况兜底。
+ *
+ * @tparam RandomIt 模式的随机访问迭代器，元素需支持 == 与 <
+ */
+template<typename RandomIt>
+class two_way_searcher {
+private:
+    RandomIt pat_;          // 模式起点
+    ptrdiff_t m_;           // 模式长度
+    ptrdiff_t ms_;          // 临界位置：左半为[0, ms_]，右半为[ms_ + 1, m_)
+    ptrdiff_t period_;      // 跳跃周期
+    ptrdiff_t memory0_;     // 周期性模式在整段匹配后可以跳过的前缀长度，非周期性时为0
+
+    /**
+     * @brief 计算模式在给定序下的最大后缀
+     * @param greater 为true时使用反序
+     * @param period 输出：最大后缀的周期
+     * @return 最大后缀起点的前一个位置
+     */
+    ptrdiff_t maximal_suffix(bool greater, ptrdiff_t& period) const {
+        ptrdiff_t ip = -1;
+        ptrdiff_t jp = 0;
+        ptrdiff_t k = 1;
+        ptrdiff_t p = 1;
+        while (jp + k < m_) {
+            const auto& a = pat_[ip + k];
+            const auto& b = pat_[jp + k];
+            if (a == b) {
+                if (k == p) {
+                    jp += p;
+                    k = 1;
+                } else {
+                    ++k;
+                }
+            } else if (greater ? (b < a) : (a < b)) {
+                jp += k;
+                k = 1;
+                p = jp - ip;
+            } else {
+                ip = jp++;
+                k = p = 1;
+            }
+        }
+        period = p;
+        return ip;
+    }
+
+public:
+    two_way_searcher(RandomIt pat_first, RandomIt pat_last)
+        : pat_(pat_first), m_(pat_last - pat_first), ms_(-1), period_(1), memory0_(0) {
+        ptrdiff_t p1 = 1;
+        ptrdiff_t p2 = 1;
+        ptrdiff_t ms1 = maximal_suffix(true, p1);
+        ptrdiff_t ms2 = maximal_suffix(false, p2);
+        if (ms2 > ms1) {
+            ms_ = ms2;
+            period_ = p2;
+        } else {
+            ms_ = ms1;
+            period_ = p1;
+        }
+        bool periodic = period_ + ms_ < m_;
+        for (ptrdiff_t i = 0; periodic && i <= ms_; ++i) {
+            periodic = pat_[i] == pat_[i + period_];
+        }
+        if (periodic) {
+            memory0_ = m_ - period_;
+        } else {
+            period_ = (ms_ > m_ - ms_ - 1 ? ms_ : m_ - ms_ - 1) + 1;
+            memory0_ = 0;
+        }
+    }
+
+    /**
+     * @brief 返回模式在[first, first + n)中第一次出现的下标，未找到返回n
+     */
+    template<typename RandomIt2>
+    ptrdiff_t find_index(RandomIt2 first, ptrdiff_t n) const {
+        if (m_ == 0) {
+            return 0;
+        }
+        ptrdiff_t pos = 0;
+        ptrdiff_t memory = 0;
+        while (pos + m_ <= n) {
+            ptrdiff_t k = ms_ + 1 > memory ? ms_ + 1 : memory;
+            while (k < m_ && pat_[k] == first[pos + k]) {
+                ++k;
+            }
+            if (k < m_) {
+                pos += k - ms_;
+                memory = 0;
+                continue;
+            }
+            k = ms_ + 1;
+            while (k > memory && pat_[k - 1] == first[pos + k - 1]) {
+                --k;
+            }
+            if (k <= memory) {
+                return pos;
+            }
+            pos += period_;
+            memory = memory0_;
+        }
+        return n;
+    }
+
+    /**
+     * @brief 查找模式
+     * @return 匹配区间[match, match_end)，未找到时两者都为last
+     */
+    template<typename RandomIt2>
+    sugar::pair<RandomIt2, RandomIt2> operator()(RandomIt2 first, RandomIt2 last) const {
+        ptrdiff_t n = last - first;
+        ptrdiff_t pos = find_index(first, n);
+        if (pos == n && m_ != 0) {
+            return sugar::pair<RandomIt2, RandomIt2>(last, last);
+        }
+        return sugar::pair<RandomIt2, RandomIt2>(first + pos, first + (pos + m_));
+    }
+};
+
+/**
+ * @brief 字节串查找器：按模式长度选择算法，最坏情况退回Two-Way
+ *
+ * - 长度1：memchr
+ * - 长度小于64（需SSE2）：首尾字节预过滤，每次检查16个起点，只对首尾字节都相同的候选做memcmp
+ * - 更长的模式：Boyer-Moore-Horspool，按窗口末字节跳跃
+ *
+ * 后两种在病态输入（如在"aaa..."里找"aa...ab"）下会退化为O(nm)，
+ * 因此累计验证的字节数超过已扫描长度的常数倍时，从当前位置改用Two-Way继续。
+ */
+class byte_searcher {
+private:
+    static const size_t horspool_threshold = 64;
+
+    const unsigned char* pat_;
+    size_t m_;
+    two_way_searcher<const unsigned char*> two_way_;
+    size_t shift_[256];  // 仅Horspool使用
+
+    /**
+     * @brief 验证工作量是否已超出预算：超过后改用Two-Way
+     */
+    static bool over_budget(size_t verified, size_t scanned) {
+        return verified > 4 * scanned + 4096;
+    }
+
+    size_t find_two_way(const unsigned char* h, size_t n, size_t pos) const {
+        return pos + static_cast<size_t>(two_way_.find_index(h + pos, static_cast<ptrdiff_t>(n - pos)));
+    }
+
+    size_t find_naive(const unsigned char* h, size_t n, size_t pos) const {
+        for (; pos + m_ <= n; ++pos) {
+            if (h[pos] == pat_[0] && h[pos + m_ - 1] == pat_[m_ - 1] &&
+                std::memcmp(h + pos + 1, pat_ + 1, m_ - 2) == 0) {
+                return pos;
+            }
+        }
+        return n;
+    }
+
+#if SUGAR_HAS_SSE2
+    size_t find_prefilter(const unsigned char* h, size_t n) const {
+        const __m128i first_byte = _mm_set1_epi8(static_cast<char>(pat_[0]));
+        const __m128i last_byte = _mm_set1_epi8(static_cast<char>(pat_[m_ - 1]));
+        size_t verified = 0;
+        size_t pos = 0;
+        for (; pos + m_ + 15 <= n; pos += 16) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + pos));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + pos + m_ - 1));
+            unsigned int mask = static_cast<unsigned int>(
+                _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first_byte), _mm_cmpeq_epi8(b, last_byte))));
+            while (mask != 0) {
+                size_t candidate = pos + static_cast<size_t>(__builtin_ctz(mask));
+                if (std::memcmp(h + candidate + 1, pat_ + 1, m_ - 2) == 0) {
+                    return candidate;
+                }
+                verified += m_;
+                if (over_budget(verified, candidate)) {
+                    return find_two_way(h, n, candidate + 1);
+                }
+                mask &= mask - 1;
+            }
+        }
+        return find_naive(h, n, pos);
+    }
+#endif
+
+    size_t find_horspool(const unsigned char* h, size_t n) const {
+        const unsigned char first = pat_[0];
+        const unsigned char last = pat_[m_ - 1];
+        size_t verified = 0;
+        size_t pos = 0;
+        while (pos + m_ <= n) {
+            unsigned char c = h[pos + m_ - 1];
+            if (c == last && h[pos] == first) {
+                if (std::memcmp(h + pos + 1, pat_ + 1, m_ - 2) == 0) {
+                    return pos;
+                }
+                verified += m_;
+                if (over_budget(verified, pos)) {
+                    return find_two_way(h, n, pos + 1);
+                }
+            }
+            pos += shift_[c];
+        }
+        return n;
+    }
+
+public:
+    /**
+     * @brief 编译模式；查找器只保存模式指针，模式须在查找器之后销毁
+     */
+    template<typename CharT>
+    byte_searcher(const CharT* pat_first, const CharT* pat_last)
+        : pat_(reinterpret_cast<const unsigned char*>(pat_first)),
+          m_(static_cast<size_t>(pat_last - pat_first)),
+          two_way_(reinterpret_cast<const unsigned char*>(pat_first),
+                   reinterpret_cast<const unsigned char*>(pat_last)) {
+        static_assert(sizeof(CharT) == 1, "byte_searcher requires a byte pattern");
+        bool use_horspool = m_ >= horspool_threshold;
+#if !SUGAR_HAS_SSE2
+        use_horspool = m_ >= 3;
+#endif
+        if (use_horspool) {
+            for (size_t c = 0; c < 256; ++c) {
+                shift_[c] = m_;
+            }
+            for (size_t j = 0; j + 1 < m_; ++j) {
+                shift_[pat_[j]] = m_ - 1 - j;
+            }
+        }
+    }
+
+    /**
+     * @brief 返回模式在[h, h + n)中第一次出现的下标，未找到返回n
+     */
+    size_t find_index(const unsigned char* h, size_t n) const {
+        if (m_ == 0) {
+            return 0;
+        }
+        if (m_ > n) {
+            return n;
+        }
+        if (m_ == 1) {
+            const void* p = std::memchr(h, pat_[0], n);
+            return p == nullptr ? n : static_cast<size_t>(static_cast<const unsigned char*>(p) - h);
+        }
+#if SUGAR_HAS_SSE2
+        if (m_ < horspool_threshold) {
+            return find_prefilter(h, n);
+        }
+        return find_horspool(h, n);
+#else
+        return m_ >= 3 ? find_horspool(h, n) : find_naive(h, n, 0);
+#endif
+    }
+
+    /**
+     * @brief 查找模式
+     * @return 匹配区间[match, match_end)，未找到时两者都为last
+     */
+    template<typename Pointer>
+    sugar::pair<Pointer, Pointer> operator()(Pointer first, Pointer last) const {
+        static_assert(sizeof(*first) == 1, "byte_searcher requires a byte range");
+        size_t n = static_cast<size_t>(last - first);
+        size_t pos = find_index(reinterpret_cast<const unsigned char*>(first), n);
+        if (pos == n && m_ != 0) {
+            return sugar::pair<Pointer, Pointer>(last, last);
+        }
+        return sugar::pair<Pointer, Pointer>(first + pos, first + (pos + m_));
+    }
+};
+
+/**
+ * @brief 两侧是否都是指向字节类型的指针
+ */
+template<typename It1, typename It2>
+struct is_byte_search
+    : conditional<is_pointer<It1>::value && is_pointer<It2>::value &&
+                  is_char<typename iterator_traits<It1>::value_type>::value &&
+                  is_char<typename iterator_traits<It2>::value_type>::value,
+                  true_type, false_type>::type {};
+
+template<typename ForwardIt1, typename ForwardIt2>
+ForwardIt1 search_dispatch(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last, false_type) {
+    return sugar::search(first, last, s_first, s_last, iter_equal_to());
+}
+
+template<typename Pointer1, typename Pointer2>
+Pointer1 search_dispatch(Pointer1 first, Pointer1 last, Pointer2 s_first, Pointer2 s_last, true_type) {
+    return byte_searcher(s_first, s_last)(first, last).first;
+}
+
+/**
+ * @brief 子串查找：字节指针区间使用byte_searcher，其他情况逐位置比较
+ * @param first 被查找区间的起始迭代器
+ * @param last 被查找区间的结束迭代器
+ * @param s_first 模式的起始迭代器
+ * @param s_last 模式的结束迭代器
+ * @return 第一次出现的位置，未找到返回last；模式为空时返回first
+ */
+template<typename ForwardIt1, typename ForwardIt2>
+ForwardIt1 search(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last) {
+    return sugar::search_dispatch(first, last, s_first, s_last, is_byte_search<ForwardIt1, ForwardIt2>());
+}
+
+/**
+ * @brief 使用预先构造的查找器查找，模式只需编译一次
+ * @param first 被查找区间的起始迭代器
+ * @param last 被查找区间的结束迭代器
+ * @param searcher 查找器（default_searcher / two_way_searcher / byte_searcher）
+ * @return 第一次出现的位置，未找到返回last
+ */
+template<typename ForwardIt, typename Searcher>
+ForwardIt search(ForwardIt first, ForwardIt last, const Searcher& searcher) {
+    return searcher(first, last).first;
+}
+
+/**
+ * @brief 查找连续count个满足pred(*it, value)的元素
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param count 连续个数
+ * @param value 比较值
+ * @param pred 二元谓词
+ * @return 第一段的起点，未找到返回last；count <= 0时返回first
+ */
+template<typename ForwardIt, typename Size, typename T, typename BinaryPredicate>
+ForwardIt search_n(ForwardIt first, ForwardIt last, Size count, const T& value, BinaryPredicate pred) {
+    if (count <= 0) {
+        return first;
+    }
+    for (; first != last; ++first) {
+        if (!pred(*first, value)) {
+            continue;
+        }
+        ForwardIt candidate = first;
+        Size run = 1;
+        for (;;) {
+            if (run == count) {
+                return candidate;
+            }
+            if (++first == last) {
+                return last;
+            }
+            if (!pred(*first, value)) {
+                break;
+            }
+            ++run;
+        }
+    }
+    return last;
+}
+
+template<typename ForwardIt, typename Size, typename T>
+ForwardIt search_n_dispatch(ForwardIt first, ForwardIt last, Size count, const T& value, false_type) {
+    return sugar::search_n(first, last, count, value, iter_equal_to());
+}
+
+/**
+ * @brief 字节区间的search_n：用memchr跳到下一个候选，再检查后续count-1个字节
+ */
+template<typename Pointer, typename Size, typename T>
+Pointer search_n_dispatch(Pointer first, Pointer last, Size count, const T& value, true_type) {
+    if (count <= 0) {
+        return first;
+    }
+    if (!(value == static_cast<typename iterator_traits<Pointer>::value_type>(value))) {
+        return last;
+    }
+    const unsigned char byte = static_cast<unsigned char>(value);
+    const size_t need = static_cast<size_t>(count);
+    while (static_cast<size_t>(last - first) >= need) {
+        const void* p = std::memchr(first, byte, static_cast<size_t>(last - first) - (need - 1));
+        if (p == nullptr) {
+            return last;
+        }
+        first += static_cast<const unsigned char*>(p) - reinterpret_cast<const unsigned char*>(first);
+        size_t run = 1;
+        while (run < need && static_cast<unsigned char>(first[run]) == byte) {
+            ++run;
+        }
+        if (run == need) {
+            return first;
+        }
+        first += run + 1;
+    }
+    return last;
+}
+
+/**
+ * @brief 查找连续count个等于value的元素
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param count 连续个数
+ * @param value 比较值
+ * @return 第一段的起点，未找到返回last
+ */
+template<typename ForwardIt, typename Size, typename T>
+ForwardIt search_n(ForwardIt first, ForwardIt last, Size count, const T& value) {
+    return sugar::search_n_dispatch(first, last, count, value,
+        typename conditional<is_pointer<ForwardIt>::value &&
+                             is_char<typename iterator_traits<ForwardIt>::value_type>::value &&
+                             (is_char<T>::value || is_integer<T>::value),
+                             true_type, false_type>::type());
+}
+
+/**
+ * @brief 查找子串最后一次出现的位置
+ * @param first 被查找区间的起始迭代器
+ * @param last 被查找区间的结束迭代器
+ * @param s_first 模式的起始迭代器
+ * @param s_last 模式的结束迭代器
+ * @param pred 相等谓词
+ * @return 最后一次出现的位置，未找到或模式为空时返回last
+ */
+template<typename ForwardIt1, typename ForwardIt2, typename BinaryPredicate>
+ForwardIt1 find_end(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last, BinaryPredicate pred) {
+    if (s_first == s_last) {
+        return last;
+    }
+    ForwardIt1 result = last;
+    for (;;) {
+        ForwardIt1 match = sugar::search(first, last, s_first, s_last, pred);
+        if (match == last) {
+            return result;
+        }
+        result = match;
+        first = match;
+        ++first;
+    }
+}
+
+template<typename ForwardIt1, typename ForwardIt2>
+ForwardIt1 find_end_dispatch(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last, false_type) {
+    return sugar::find_end(first, last, s_first, s_last, iter_equal_to());
+}
+
+/**
+ * @brief 字节区间的find_end：在反向视图上运行Two-Way，线性时间
+ */
+template<typename Pointer1, typename Pointer2>
+Pointer1 find_end_dispatch(Pointer1 first, Pointer1 last, Pointer2 s_first, Pointer2 s_last, true_type) {
+    if (s_first == s_last) {
+        return last;
+    }
+    typedef reverse_iterator<const unsigned char*> reverse_bytes;
+    const unsigned char* h = reinterpret_cast<const unsigned char*>(first);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s_first);
+    two_way_searcher<reverse_bytes> searcher(reverse_bytes(p + (s_last - s_first)), reverse_bytes(p));
+    sugar::pair<reverse_bytes, reverse_bytes> match = searcher(reverse_bytes(h + (last - first)), reverse_bytes(h));
+    if (match.first == reverse_bytes(h)) {
+        return last;
+    }
+    return first + (match.second.base() - h);
+}
+
+/**
+ * @brief 查找子串最后一次出现的位置
+ * @param first 被查找区间的起始迭代器
+ * @param last 被查找区间的结束迭代器
+ * @param s_first 模式的起始迭代器
+ * @param s_last 模式的结束迭代器
+ * @return 最后一次出现的位置，未找到或模式为空时返回last
+ */
+template<typename ForwardIt1, typename ForwardIt2>
+ForwardIt1 find_end(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last) {
+    return sugar::find_end_dispatch(first, last, s_first, s_last, is_byte_search<ForwardIt1, ForwardIt2>());
+}
+
+// ============================ 堆算法 ============================
+
+/**
+ * @brief 将hole处的值上浮到合适位置（堆算法内部辅助函数）
+ * @param first 堆的起始迭代器
+ * @param hole 当前空位下标
+ * @param top 上浮的最高位置
+ * @param value 需要放入的值
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Distance, typename T, typename Compare>
+void heap_sift_up(RandomIt first, Distance hole, Distance top, T value, Compare comp) {
+    Distance parent = (hole - 1) / 2;
+    while (hole > top && comp(*(first + parent), value)) {
+        *(first + hole) = sugar::move(*(first + parent));
+        hole = parent;
+        parent = (hole - 1) / 2;
+    }
+    *(first + hole) = sugar::move(value);
+}
+
+/**
+ * @brief 调整堆（Floyd 自底向上）：空位沿较优子节点一路下沉到叶子，
+ *        再把value上浮，每层只需一次子节点比较
+ * @param first 堆的起始迭代器
+ * @param hole 空位下标
+ * @param len 堆的长度
+ * @param value 需要放入的值
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Distance, typename T, typename Compare>
+void adjust_heap(RandomIt first, Distance hole, Distance len, T value, Compare comp) {
+    const Distance top = hole;
+    Distance child = 2 * hole + 2;
+    while (child < len) {
+        if (comp(*(first + child), *(first + (child - 1)))) {
+            --child;
+        }
+        *(first + hole) = sugar::move(*(first + child));
+        hole = child;
+        child = 2 * child + 2;
+    }
+    if (child == len) {
+        // 只有左孩子
+        *(first + hole) = sugar::move(*(first + (child - 1)));
+        hole = child - 1;
+    }
+    sugar::heap_sift_up(first, hole, top, sugar::move(value), comp);
+}
+
+/**
+ * @brief 将[first, last-1)堆的末尾元素last-1加入堆中（使用比较函数）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void push_heap(RandomIt first, RandomIt last, Compare comp) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    using T = typename iterator_traits<RandomIt>::value_type;
+    Distance len = last - first;
+    if (len < 2) {
+        return;
+    }
+    T value = sugar::move(*(last - 1));
+    sugar::heap_sift_up(first, len - 1, Distance(0), sugar::move(value), comp);
+}
+
+/**
+ * @brief 将[first, last-1)堆的末尾元素last-1加入堆中
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template<typename RandomIt>
+void push_heap(RandomIt first, RandomIt last) {
+    sugar::push_heap(first, last, sugar::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief 将堆顶元素移动到last-1，并使[first, last-1)重新成为堆（使用比较函数）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void pop_heap(RandomIt first, RandomIt last, Compare comp) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    using T = typename iterator_traits<RandomIt>::value_type;
+    Distance len = last - first;
+    if (len < 2) {
+        return;
+    }
+    T value = sugar::move(*(last - 1));
+    *(last - 1) = sugar::move(*first);
+    sugar::adjust_heap(first, Distance(0), len - 1, sugar::move(value), comp);
+}
+
+/**
+ * @brief 将堆顶元素移动到last-1，并使[first, last-1)重新成为堆
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template<typename RandomIt>
+void pop_heap(RandomIt first, RandomIt last) {
+    sugar::pop_heap(first, last, sugar::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief 将[first, last)构造成堆，O(n)（使用比较函数）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void make_heap(RandomIt first, RandomIt last, Compare comp) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    using T = typename iterator_traits<RandomIt>::value_type;
+    Distance len = last - first;
+    if (len < 2) {
+        return;
+    }
+    for (Distance parent = (len - 2) / 2; ; --parent) {
+        T value = sugar::move(*(first + parent));
+        sugar::adjust_heap(first, parent, len, sugar::move(value), comp);
+        if (parent == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 将[first, last)构造成堆，O(n)
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template<typename RandomIt>
+void make_heap(RandomIt first, RandomIt last) {
+    sugar::make_heap(first, last, sugar::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief 将堆[first, last)排序为升序（使用比较函数）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void sort_heap(RandomIt first, RandomIt last, Compare comp) {
+    for (; last - first > 1; --last) {
+        sugar::pop_heap(first, last, comp);
+    }
+}
+
+/**
+ * @brief 将堆[first, last)排序为升序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template<typename RandomIt>
+void sort_heap(RandomIt first, RandomIt last) {
+    sugar::sort_heap(first, last, sugar::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief 查找第一个破坏堆序的位置（使用比较函数）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return [first, it)是堆的最大的it
+ */
+template<typename RandomIt, typename Compare>
+RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    Distance len = last - first;
+    for (Distance child = 1; child < len; ++child) {
+        if (comp(*(first + (child - 1) / 2), *(first + child))) {
+            return first + child;
+        }
+    }
+    return last;
+}
+
+/**
+ * @brief 查找第一个破坏堆序的位置
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @return [first, it)是堆的最大的it
+ */
+template<typename RandomIt>
+RandomIt is_heap_until(RandomIt first, RandomIt last) {
+    return sugar::is_heap_until(first, last, sugar::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief 判断[first, last)是否为堆（使用比较函数）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return 如果是堆返回true，否则返回false
+ */
+template<typename RandomIt, typename Compare>
+bool is_heap(RandomIt first, RandomIt last, Compare comp) {
+    return sugar::is_heap_until(first, last, comp) == last;
+}
+
+/**
+ * @brief 判断[first, last)是否为堆
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @return 如果是堆返回true，否则返回false
+ */
+template<typename RandomIt>
+bool is_heap(RandomIt first, RandomIt last) {
+    return sugar::is_heap_until(first, last) == last;
+}
+
+// ============================ 变序算法 ============================
+
+/**
+ * @brief 交换两个迭代器所指向的元素
+ * @param a 第一个迭代器
+ * @param b 第二个迭代器
+ */
+template<typename ForwardIt1, typename ForwardIt2>
+void iter_swap(ForwardIt1 a, ForwardIt2 b) {
+    sugar::swap(*a, *b);
+}
+
+/**
+ * @brief 判断T能否按字节整体搬运（memmove/SIMD快速路径的前提）
+ */
+template<typename T>
+struct is_bitwise_movable
+    : conditional<is_trivial<typename remove_cv<T>::type>::value ||
+                  is_pointer<typename remove_cv<T>::type>::value,
+                  true_type, false_type>::type {};
+
+/**
+ * @brief 双向迭代器反转
+ */
+template<typename BidirIt>
+void reverse_dispatch(BidirIt first, BidirIt last, bidirectional_iterator_tag) {
+    while (first != last) {
+        if (first == --last) {
+            return;
+        }
+        sugar::iter_swap(first, last);
+        ++first;
+    }
+}
+
+/**
+ * @brief 随机访问迭代器反转
+ */
+template<typename RandomIt>
+void reverse_dispatch(RandomIt first, RandomIt last, random_access_iterator_tag) {
+    if (first == last) {
+        return;
+    }
+    for (--last; first < last; ++first, --last) {
+        sugar::iter_swap(first, last);
+    }
+}
+
+#if SUGAR_HAS_SSE2
+/**
+ * @brief 反转16字节寄存器内元素的顺序（元素大小为Size字节）
+ */
+template<size_t Size>
+inline __m128i reverse_lanes_sse2(__m128i x) {
+    return x;  // 仅1/2/4/8字节的元素会走到SIMD路径
+}
+
+template<>
+inline __m128i reverse_lanes_sse2<8>(__m128i x) {
+    return _mm_shuffle_epi32(x, 0x4E);
+}
+
+template<>
+inline __m128i reverse_lanes_sse2<4>(__m128i x) {
+    return _mm_shuffle_epi32(x, 0x1B);
+}
+
+template<>
+inline __m128i reverse_lanes_sse2<2>(__m128i x) {
+    x = _mm_shufflelo_epi16(x, 0x1B);
+    x = _mm_shufflehi_epi16(x, 0x1B);
+    return _mm_shuffle_epi32(x, 0x4E);
+}
+
+template<>
+inline __m128i reverse_lanes_sse2<1>(__m128i x) {
+    // 先交换每个16位字内的两个字节，再按16位元素反转
+    x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+    return reverse_lanes_sse2<2>(x);
+}
+#endif
+
+/**
+ * @brief 可按字节搬运类型的指针区间反转：两端各取16字节，寄存器内反转后交叉写回
+ */
+template<typename T>
+void reverse_pointer(T* first, T* last, true_type) {
+#if SUGAR_HAS_SSE2
+    if (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+        unsigned char* lo = reinterpret_cast<unsigned char*>(first);
+        unsigned char* hi = reinterpret_cast<unsigned char*>(last);
+        while (hi - lo >= 32) {
+            hi -= 16;
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lo), sugar::reverse_lanes_sse2<sizeof(T)>(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(hi), sugar::reverse_lanes_sse2<sizeof(T)>(a));
+            lo += 16;
+        }
+        first = reinterpret_cast<T*>(lo);
+        last = reinterpret_cast<T*>(hi);
+    }
+#endif
+    sugar::reverse_dispatch(first, last, random_access_iterator_tag());
+}
+
+template<typename T>
+void reverse_pointer(T* first, T* last, false_type) {
+    sugar::reverse_dispatch(first, last, random_access_iterator_tag());
+}
+
+/**
+ * @brief 反转算法
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template<typename BidirIt>
+void reverse(BidirIt first, BidirIt last) {
+    sugar::reverse_dispatch(first, last, typename iterator_traits<BidirIt>::iterator_category());
+}
+
+/**
+ * @brief 反转算法（指针版本，平凡类型走SIMD路径）
+ * @param first 起始指针
+ * @param last 结束指针
+ */
+template<typename T>
+void reverse(T* first, T* last) {
+    sugar::reverse_pointer(first, last, is_bitwise_movable<T>());
+}
+
+/**
+ * @brief 前向迭代器旋转（Gries-Mills 交换法）
+ */
+template<typename ForwardIt>
+ForwardIt rotate_dispatch(ForwardIt first, ForwardIt middle, ForwardIt last, forward_iterator_tag) {
+    ForwardIt next = middle;
+    ForwardIt result = last;
+    while (first != next) {
+        sugar::iter_swap(first++, next++);
+        if (next == last) {
+            if (result == last) {
+                result = first;
+            }
+            next = middle;
+        } else if (first == middle) {
+            middle = next;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 双向迭代器旋转（三次反转）
+ */
+template<typename BidirIt>
+BidirIt rotate_dispatch(BidirIt first, BidirIt middle, BidirIt last, bidirectional_iterator_tag) {
+    sugar::reverse(first, middle);
+    sugar::reverse(middle, last);
+    while (first != middle && middle != last) {
+        sugar::iter_swap(first++, --last);
+    }
+    if (first == middle) {
+        sugar::reverse(middle, last);
+        return last;
+    }
+    sugar::reverse(first, middle);
+    return first;
+}
+
+/**
+ * @brief 随机访问迭代器旋转（cycle-leader：按gcd个环搬运，每个元素只移动一次）
+ */
+template<typename RandomIt>
+RandomIt rotate_dispatch(RandomIt first, RandomIt middle, RandomIt last, random_access_iterator_tag) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    using T = typename iterator_traits<RandomIt>::value_type;
+    Distance n = last - first;
+    Distance k = middle - first;
+    RandomIt result = first + (n - k);
+    Distance a = n;
+    Distance b = k;
+    while (b != 0) {
+        Distance t = a % b;
+        a = b;
+        b = t;
+    }
+    for (Distance cycle = 0; cycle < a; ++cycle) {
+        T tmp = sugar::move(*(first + cycle));
+        Distance hole = cycle;
+        for (;;) {
+            Distance next = hole + k;
+            if (next >= n) {
+                next -= n;
+            }
+            if (next == cycle) {
+                break;
+            }
+            *(first + hole) = sugar::move(*(first + next));
+            hole = next;
+        }
+        *(first + hole) = sugar::move(tmp);
+    }
+    return result;
+}
+
+/**
+ * @brief 可按字节搬运类型的指针区间旋转：较短一侧放入栈缓冲后memmove，
+ *        两侧都较长时用（SIMD）三次反转，访存顺序友好
+ */
+template<typename T>
+T* rotate_pointer(T* first, T* middle, T* last, true_type) {
+    const size_t buffer_bytes = 512;
+    size_t left = static_cast<size_t>(middle - first);
+    size_t right = static_cast<size_t>(last - middle);
+    T* result = first + right;
+    if (left * sizeof(T) <= buffer_bytes) {
+        unsigned char buffer[buffer_bytes];
+        std::memcpy(buffer, first, left * sizeof(T));
+        std::memmove(first, middle, right * sizeof(T));
+        std::memcpy(result, buffer, left * sizeof(T));
+        return result;
+    }
+    if (right * sizeof(T) <= buffer_bytes) {
+        unsigned char buffer[buffer_bytes];
+        std::memcpy(buffer, middle, right * sizeof(T));
+        std::memmove(first + right, first, left * sizeof(T));
+        std::memcpy(first, buffer, right * sizeof(T));
+        return result;
+    }
+    sugar::reverse(first, middle);
+    sugar::reverse(middle, last);
+    sugar::reverse(first, last);
+    return result;
+}
+
+template<typename T>
+T* rotate_pointer(T* first, T* middle, T* last, false_type) {
+    return sugar::rotate_dispatch(first, middle, last, random_access_iterator_tag());
+}
+
+/**
+ * @brief 旋转算法：使middle成为新的首元素
+ * @param first 起始迭代器
+ * @param middle 新的首元素
+ * @param last 结束迭代器
+ * @return 原first所指元素的新位置
+ */
+template<typename ForwardIt>
+ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last) {
+    if (first == middle) {
+        return last;
+    }
+    if (middle == last) {
+        return first;
+    }
+    return sugar::rotate_dispatch(first, middle, last, typename iterator_traits<ForwardIt>::iterator_category());
+}
+
+/**
+ * @brief 旋转算法（指针版本，平凡类型走memmove路径）
+ * @param first 起始指针
+ * @param middle 新的首元素
+ * @param last 结束指针
+ * @return 原first所指元素的新位置
+ */
+template<typename T>
+T* rotate(T* first, T* middle, T* last) {
+    if (first == middle) {
+        return last;
+    }
+    if (middle == last) {
+        return first;
+    }
+    return sugar::rotate_pointer(first, middle, last, is_bitwise_movable<T>());
+}
+
+/**
+ * @brief 前向迭代器划分
+ */
+template<typename ForwardIt, typename UnaryPredicate>
+ForwardIt partition_dispatch(ForwardIt first, ForwardIt last, UnaryPredicate pred, forward_iterator_tag) {
+    first = sugar::find_if(first, last, [&pred](const typename iterator_traits<ForwardIt>::value_type& x) {
+        return !pred(x);
+    });
+    if (first == last) {
+        return first;
+    }
+    for (ForwardIt it = first; ++it != last; ) {
+        if (pred(*it)) {
+            sugar::iter_swap(it, first);
+            ++first;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief 双向迭代器划分（Hoare）
+ */
+template<typename BidirIt, typename UnaryPredicate>
+BidirIt partition_dispatch(BidirIt first, BidirIt last, UnaryPredicate pred, bidirectional_iterator_tag) {
+    for (;;) {
+        for (;;) {
+            if (first == last) {
+                return first;
+            }
+            if (!pred(*first)) {
+                break;
+            }
+            ++first;
+        }
+        do {
+            if (first == --last) {
+                return first;
+            }
+        } while (!pred(*last));
+        sugar::iter_swap(first, last);
+        ++first;
+    }
+}
+
+/**
+ * @brief 随机访问迭代器划分（BlockQuicksort 式块划分）
+ *
+ * 两端各取一块，先无分支地把“放错侧”元素的偏移写入缓冲区，再成对交换。
+ * 谓词结果不再决定分支走向，消除了Hoare划分中难以预测的分支。
+ */
+template<typename RandomIt, typename UnaryPredicate>
+RandomIt partition_dispatch(RandomIt first, RandomIt last, UnaryPredicate pred, random_access_iterator_tag) {
+    const int block = 64;
+    unsigned char offsets_l[block];
+    unsigned char offsets_r[block];
+    int num_l = 0;
+    int num_r = 0;
+    int start_l = 0;
+    int start_r = 0;
+    while (last - first >= 2 * block) {
+        if (num_l == 0) {
+            start_l = 0;
+            for (int i = 0; i < block; ++i) {
+                offsets_l[num_l] = static_cast<unsigned char>(i);
+                num_l += !pred(*(first + i));
+            }
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            for (int i = 0; i < block; ++i) {
+                offsets_r[num_r] = static_cast<unsigned char>(i);
+                num_r += !!pred(*(last - 1 - i));
+            }
+        }
+        int n = num_l < num_r ? num_l : num_r;
+        for (int j = 0; j < n; ++j) {
+            sugar::iter_swap(first + offsets_l[start_l + j], last - 1 - offsets_r[start_r + j]);
+        }
+        num_l -= n;
+        num_r -= n;
+        start_l += n;
+        start_r += n;
+        if (num_l == 0) {
+            first += block;
+        }
+        if (num_r == 0) {
+            last -= block;
+        }
+    }
+    // [原first, first) 全部满足谓词，[last, 原last) 全部不满足，剩余部分用Hoare收尾
+    return sugar::partition_dispatch(first, last, pred, bidirectional_iterator_tag());
+}
+
+/**
+ * @brief 划分算法：满足谓词的元素移到前面（不稳定）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param pred 谓词函数
+ * @return 指向第一个不满足谓词的元素的迭代器
+ */
+template<typename ForwardIt, typename UnaryPredicate>
+ForwardIt partition(ForwardIt first, ForwardIt last, UnaryPredicate pred) {
+    return sugar::partition_dispatch(first, last, pred, typename iterator_traits<ForwardIt>::iterator_category());
+}
+
+/**
+ * @brief 判断区间是否已按谓词划分
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param pred 谓词函数
+ * @return 如果满足谓词的元素都在不满足的元素之前返回true
+ */
+template<typename InputIt, typename UnaryPredicate>
+bool is_partitioned(InputIt first, InputIt last, UnaryPredicate pred) {
+    for (; first != last; ++first) {
+        if (!pred(*first)) {
+            break;
+        }
+    }
+    for (; first != last; ++first) {
+        if (pred(*first)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 稳定划分的原地版本（分治 + 旋转，O(n log n)）
+ */
+template<typename ForwardIt, typename UnaryPredicate, typename Distance>
+ForwardIt stable_partition_inplace(ForwardIt first, ForwardIt last, UnaryPredicate pred, Distance len) {
+    if (len == 1) {
+        return pred(*first) ? last : first;
+    }
+    ForwardIt middle = first;
+    sugar::advance(middle, len / 2);
+    ForwardIt left = sugar::stable_partition_inplace(first, middle, pred, len / 2);
+    ForwardIt right = sugar::stable_partition_inplace(middle, last, pred, len - len / 2);
+    return sugar::rotate(left, middle, right);
+}
+
+/**
+ * @brief 稳定划分算法：满足谓词的元素移到前面，保持两组内部的相对顺序
+ *
+ * 优先使用临时缓冲区（O(n)），分配失败时退化为原地分治版本。
+ *
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param pred 谓词函数
+ * @return 指向第一个不满足谓词的元素的迭代器
+ */
+template<typename ForwardIt, typename UnaryPredicate>
+ForwardIt stable_partition(ForwardIt first, ForwardIt last, UnaryPredicate pred) {
+    using T = typename iterator_traits<ForwardIt>::value_type;
+    first = sugar::find_if(first, last, [&pred](const T& x) { return !pred(x); });
+    if (first == last) {
+        return first;
+    }
+    typename iterator_traits<ForwardIt>::difference_type len = sugar::distance(first, last);
+    T* buffer = nullptr;
+    try {
+        buffer = static_cast<T*>(sugar::allocate(static_cast<size_t>(len) * sizeof(T)));
+    } catch (const sugar::bad_alloc&) {
+        return sugar::stable_partition_inplace(first, last, pred, len);
+    }
+    T* buffer_end = buffer;
+    ForwardIt out = first;
+    try {
+        for (ForwardIt it = first; it != last; ++it) {
+            if (pred(*it)) {
+                *out = sugar::move(*it);
+                ++out;
+            } else {
+                sugar::construct(buffer_end, sugar::move(*it));
+                ++buffer_end;
+            }
+        }
+    } catch (...) {
+        sugar::destroy(buffer, buffer_end);
+        sugar::deallocate(buffer, static_cast<size_t>(len) * sizeof(T));
+        throw;
+    }
+    sugar::move(buffer, buffer_end, out);
+    sugar::destroy(buffer, buffer_end);
+    sugar::deallocate(buffer, static_cast<size_t>(len) * sizeof(T));
+    return out;
+}
+
+/**
+ * @brief 删除满足谓词的元素（将保留的元素前移）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param pred 谓词函数
+ * @return 新的逻辑结尾
+ */
+template<typename ForwardIt, typename UnaryPredicate>
+ForwardIt remove_if(ForwardIt first, ForwardIt last, UnaryPredicate pred) {
+    first = sugar::find_if(first, last, pred);
+    if (first == last) {
+        return first;
+    }
+    for (ForwardIt it = first; ++it != last; ) {
+        if (!pred(*it)) {
+            *first = sugar::move(*it);
+            ++first;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief 可按字节搬运类型的无分支流压缩：每个元素都先写入，再按谓词结果决定是否前进
+ */
+template<typename T, typename UnaryPredicate>
+T* remove_if_pointer(T* first, T* last, UnaryPredicate pred, true_type) {
+    first = sugar::find_if(first, last, pred);
+    if (first == last) {
+        return first;
+    }
+    T* out = first;
+    for (T* it = first + 1; it != last; ++it) {
+        T value = *it;
+        *out = value;
+        out += !pred(value);
+    }
+    return out;
+}
+
+template<typename T, typename UnaryPredicate>
+T* remove_if_pointer(T* first, T* last, UnaryPredicate pred, false_type) {
+    return sugar::remove_if<T*, UnaryPredicate>(first, last, pred);
+}
+
+/**
+ * @brief 删除满足谓词的元素（指针版本，平凡类型走无分支压缩路径）
+ * @param first 起始指针
+ * @param last 结束指针
+ * @param pred 谓词函数
+ * @return 新的逻辑结尾
+ */
+template<typename T, typename UnaryPredicate>
+T* remove_if(T* first, T* last, UnaryPredicate pred) {
+    return sugar::remove_if_pointer(first, last, pred, is_bitwise_movable<T>());
+}
+
+/**
+ * @brief 删除等于value的元素
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param value 要删除的值
+ * @return 新的逻辑结尾
+ */
+template<typename ForwardIt, typename T>
+ForwardIt remove(ForwardIt first, ForwardIt last, const T& value) {
+    first = sugar::find(first, last, value);
+    if (first == last) {
+        return first;
+    }
+    for (ForwardIt it = first; ++it != last; ) {
+        if (!(*it == value)) {
+            *first = sugar::move(*it);
+            ++first;
+        }
+    }
+    return first;
+}
+
+#if SUGAR_HAS_SSE2
+/**
+ * @brief 整数元素的16字节相等比较掩码
+ */
+template<size_t Size>
+inline int equal_mask_sse2(__m128i a, __m128i b);
+
+template<>
+inline int equal_mask_sse2<1>(__m128i a, __m128i b) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+}
+
+template<>
+inline int equal_mask_sse2<2>(__m128i a, __m128i b) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(a, b));
+}
+
+template<>
+inline int equal_mask_sse2<4>(__m128i a, __m128i b) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(a, b));
+}
+
+/**
+ * @brief 把value广播到16字节寄存器
+ */
+template<typename T>
+inline __m128i broadcast_sse2(T value) {
+    if (sizeof(T) == 1) return _mm_set1_epi8(static_cast<char>(value));
+    if (sizeof(T) == 2) return _mm_set1_epi16(static_cast<short>(value));
+    return _mm_set1_epi32(static_cast<int>(value));
+}
+#endif
+
+/**
+ * @brief 整数元素的SIMD流压缩：16字节块内无匹配时整块写出，否则逐个无分支写出
+ */
+template<typename T>
+T* remove_pointer(T* first, T* last, const T& value, true_type) {
+    T* out = first;
+    T* it = first;
+#if SUGAR_HAS_SSE2
+    const size_t lanes = 16 / sizeof(T);
+    const __m128i needle = sugar::broadcast_sse2(value);
+    for (; static_cast<size_t>(last - it) >= lanes; it += lanes) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        if (sugar::equal_mask_sse2<sizeof(T)>(chunk, needle) == 0) {
+            // out <= it，块已读入寄存器，写回不会覆盖未读数据
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chunk);
+            out += lanes;
+        } else {
+            for (size_t i = 0; i < lanes; ++i) {
+                T x = it[i];
+                *out = x;
+                out += !(x == value);
+            }
+        }
+    }
+#endif
+    for (; it != last; ++it) {
+        T x = *it;
+        *out = x;
+        out += !(x == value);
+    }
+    return out;
+}
+
+template<typename T>
+T* remove_pointer(T* first, T* last, const T& value, false_type) {
+    return sugar::remove<T*, T>(first, last, value);
+}
+
+/**
+ * @brief 删除等于value的元素（指针版本，1/2/4字节整数走SIMD路径）
+ * @param first 起始指针
+ * @param last 结束指针
+ * @param value 要删除的值
+ * @return 新的逻辑结尾
+ */
+template<typename T>
+T* remove(T* first, T* last, const T& value) {
+    first = sugar::find(first, last, value);
+    if (first == last) {
+        return first;
+    }
+    return sugar::remove_pointer(first, last, value,
+        typename conditional<(is_integer<T>::value || is_char<T>::value) &&
+                             (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4),
+                             true_type, false_type>::type());
+}
+
+/**
+ * @brief 删除相邻的重复元素（使用比较函数）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param pred 相等判断函数
+ * @return 新的逻辑结尾
+ */
+template<typename ForwardIt, typename BinaryPredicate>
+ForwardIt unique(ForwardIt first, ForwardIt last, BinaryPredicate pred) {
+    if (first == last) {
+        return last;
+    }
+    ForwardIt result = first;
+    while (++first != last) {
+        if (!pred(*result, *first) && ++result != first) {
+            *result = sugar::move(*first);
+        }
+    }
+    return ++result;
+}
+
+/**
+ * @brief 可按字节搬运类型的无分支去重
+ */
+template<typename T, typename BinaryPredicate>
+T* unique_pointer(T* first, T* last, BinaryPredicate pred, true_type) {
+    if (first == last) {
+        return last;
+    }
+    T* out = first;
+    T kept = *first;
+    for (T* it = first + 1; it != last; ++it) {
+        T value = *it;
+        // out+1 <= it，先写入候选位置，再按是否重复决定是否前进
+        bool keep = !pred(kept, value);
+        out[1] = value;
+        out += keep;
+        kept = keep ? value : kept;
+    }
+    return out + 1;
+}
+
+template<typename T, typename BinaryPredicate>
+T* unique_pointer(T* first, T* last, BinaryPredicate pred, false_type) {
+    return sugar::unique<T*, BinaryPredicate>(first, last, pred);
+}
+
+/**
+ * @brief 删除相邻的重复元素（指针版本，平凡类型走无分支路径）
+ * @param first 起始指针
+ * @param last 结束指针
+ * @param pred 相等判断函数
+ * @return 新的逻辑结尾
+ */
+template<typename T, typename BinaryPredicate>
+T* unique(T* first, T* last, BinaryPredicate pred) {
+    return sugar::unique_pointer(first, last, pred, is_bitwise_movable<T>());
+}
+
+/**
+ * @brief 删除相邻的重复元素
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @return 新的逻辑结尾
+ */
+template<typename ForwardIt>
+ForwardIt unique(ForwardIt first, ForwardIt last) {
+    return sugar::unique(first, last, sugar::equal_to<typename iterator_traits<ForwardIt>::value_type>());
+}
+
+/**
+ * @brief 从随机数生成器中均匀抽取 [0, n) 内的整数
+ *
+ * 生成器值域恰为全部64位或全部32位（且n不超过2^32）时使用Lemire乘法法（几乎不需要除法），
+ * 否则使用整除缩放 + 拒绝采样；值域不足时拼接多次输出。
+ *
+ * @param g 满足UniformRandomBitGenerator的生成器
+ * @param n 上界（不含），必须大于0
+ * @return 均匀分布的整数
+ */
+template<typename URBG>
+unsigned long long uniform_index(URBG& g, unsigned long long n) {
+    typedef unsigned long long u64;
+    const u64 gmin = static_cast<u64>(URBG::min());
+    const u64 range = static_cast<u64>(URBG::max()) - gmin;
+    if (range == ~u64(0)) {
+#if defined(__SIZEOF_INT128__)
+        u64 x = static_cast<u64>(g()) - gmin;
+        unsigned __int128 m = static_cast<unsigned __int128>(x) * n;
+        u64 low = static_cast<u64>(m);
+        if (low < n) {
+            u64 threshold = (0 - n) % n;
+            while (low < threshold) {
+                x = static_cast<u64>(g()) - gmin;
+                m = static_cast<unsigned __int128>(x) * n;
+                low = static_cast<u64>(m);
+            }
+        }
+        return static_cast<u64>(m >> 64);
+#else
+        const u64 threshold = (0 - n) % n;
+        u64 r;
+        do {
+            r = static_cast<u64>(g()) - gmin;
+        } while (r < threshold);
+        return r % n;
+#endif
+    }
+    if (range == 0xffffffffull && n <= 0xffffffffull) {
+        // 32位生成器：32x32->64位乘法即可完成Lemire法
+        typedef unsigned int u32;
+        u64 m = (static_cast<u64>(g()) - gmin) * n;
+        u32 low = static_cast<u32>(m);
+        if (low < n) {
+            const u32 threshold = (0u - static_cast<u32>(n)) % static_cast<u32>(n);
+            while (low < threshold) {
+                m = (static_cast<u64>(g()) - gmin) * n;
+                low = static_cast<u32>(m);
+            }
+        }
+        return m >> 32;
+    }
+    if (range >= n - 1) {
+        // scaling = (range + 1) / n，改写以免range为最大值时溢出
+        const u64 scaling = (range - (n - 1)) / n + 1;
+        const u64 past = n * scaling;
+        u64 r;
+        do {
+            r = static_cast<u64>(g()) - gmin;
+        } while (r >= past);
+        return r / scaling;
+    }
+    // 生成器值域小于n：高位递归抽取，低位拼接一次输出
+    u64 r;
+    u64 high;
+    do {
+        high = sugar::uniform_index(g, (n - 1) / (range + 1) + 1) * (range + 1);
+        r = high + (static_cast<u64>(g()) - gmin);
+    } while (r >= n || r < high);
+    return r;
+}
+
+/**
+ * @brief 随机打乱算法（Fisher-Yates）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param g 随机数生成器
+ */
+template<typename RandomIt, typename URBG>
+void shuffle(RandomIt first, RandomIt last, URBG&& g) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    typedef unsigned long long u64;
+    typedef typename remove_reference<URBG>::type generator_type;
+    const u64 range = static_cast<u64>(generator_type::max()) - static_cast<u64>(generator_type::min());
+    Distance n = last - first;
+    Distance i = n - 1;
+    // 生成器值域足够大时，一次抽取 [0, (i+1)*i) 拆成两个下标，减少生成器调用次数
+    for (; i > 1 && static_cast<u64>(i) + 1 <= range / static_cast<u64>(i); i -= 2) {
+        u64 x = sugar::uniform_index(g, (static_cast<u64>(i) + 1) * static_cast<u64>(i));
+        Distance j1 = static_cast<Distance>(x / static_cast<u64>(i));
+        Distance j2 = static_cast<Distance>(x % static_cast<u64>(i));
+        sugar::iter_swap(first + i, first + j1);
+        sugar::iter_swap(first + (i - 1), first + j2);
+    }
+    for (; i > 0; --i) {
+        Distance j = static_cast<Distance>(sugar::uniform_index(g, static_cast<unsigned long long>(i) + 1));
+        if (j != i) {
+            sugar::iter_swap(first + i, first + j);
+        }
+    }
+}
+
+
+// ============================ 排序与选择 ============================
+
+/**
+ * @brief 区间长度不超过该值时改用插入排序
+ */
+const ptrdiff_t sort_insertion_threshold = 16;
+
+/**
+ * @brief 判断[first, last)是否已按comp升序排列
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return 第一个破坏顺序的位置，全部有序时返回last
+ */
+template<typename ForwardIt, typename Compare>
+ForwardIt is_sorted_until(ForwardIt first, ForwardIt last, Compare comp) {
+    if (first == last) {
+        return last;
+    }
+    ForwardIt next = first;
+    for (++next; next != last; first = next, ++next) {
+        if (comp(*next, *first)) {
+            return next;
+        }
+    }
+    return last;
+}
+
+/**
+ * @brief 判断[first, last)是否已升序排列
+ */
+template<typename ForwardIt>
+ForwardIt is_sorted_until(ForwardIt first, ForwardIt last) {
+    return sugar::is_sorted_until(first, last, less<typename iterator_traits<ForwardIt>::value_type>());
+}
+
+/**
+ * @brief 判断[first, last)是否已按comp升序排列
+ */
+template<typename ForwardIt, typename Compare>
+bool is_sorted(ForwardIt first, ForwardIt last, Compare comp) {
+    return sugar::is_sorted_until(first, last, comp) == last;
+}
+
+/**
+ * @brief 判断[first, last)是否已升序排列
+ */
+template<typename ForwardIt>
+bool is_sorted(ForwardIt first, ForwardIt last) {
+    return sugar::is_sorted_until(first, last) == last;
+}
+
+/**
+ * @brief 无边界检查的插入：调用方保证last之前存在不大于*last的元素
+ */
+template<typename RandomIt, typename Compare>
+void unguarded_linear_insert(RandomIt last, Compare comp) {
+    typename iterator_traits<RandomIt>::value_type value = sugar::move(*last);
+    RandomIt prev = last - 1;
+    while (comp(value, *prev)) {
+        *last = sugar::move(*prev);
+        last = prev;
+        --prev;
+    }
+    *last = sugar::move(value);
+}
+
+/**
+ * @brief 插入排序，适合短区间或基本有序的区间
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+    if (first == last) {
+        return;
+    }
+    for (RandomIt i = first + 1; i != last; ++i) {
+        if (comp(*i, *first)) {
+            // 比首元素还小：整体后移一格
+            typename iterator_traits<RandomIt>::value_type value = sugar::move(*i);
+            for (RandomIt j = i; j != first; --j) {
+                *j = sugar::move(*(j - 1));
+            }
+            *first = sugar::move(value);
+        } else {
+            sugar::unguarded_linear_insert(i, comp);
+        }
+    }
+}
+
+/**
+ * @brief 把a、b、c三者的中位数交换到result
+ */
+template<typename RandomIt, typename Compare>
+void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+    if (comp(*a, *b)) {
+        if (comp(*b, *c)) {
+            sugar::iter_swap(result, b);
+        } else if (comp(*a, *c)) {
+            sugar::iter_swap(result, c);
+        } else {
+            sugar::iter_swap(result, a);
+        }
+    } else if (comp(*a, *c)) {
+        sugar::iter_swap(result, a);
+    } else if (comp(*b, *c)) {
+        sugar::iter_swap(result, c);
+    } else {
+        sugar::iter_swap(result, b);
+    }
+}
+
+/**
+ * @brief 以*pivot为枢轴的Hoare划分，不做边界检查：
+ *        两侧扫描都会停在与枢轴相等的元素上，大量重复值时也能均分
+ * @return 右半部分的起点
+ */
+template<typename RandomIt, typename Compare>
+RandomIt unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare comp) {
+    while (true) {
+        while (comp(*first, *pivot)) {
+            ++first;
+        }
+        --last;
+        while (comp(*pivot, *last)) {
+            --last;
+        }
+        if (!(first < last)) {
+            return first;
+        }
+        sugar::iter_swap(first, last);
+        ++first;
+    }
+}
+
+/**
+ * @brief 三数取中选枢轴（放在first处）并划分[first + 1, last)
+ * @return 划分点，[first, cut)均不大于[cut, last)
+ */
+template<typename RandomIt, typename Compare>
+RandomIt partition_median_pivot(RandomIt first, RandomIt last, Compare comp) {
+    RandomIt mid = first + (last - first) / 2;
+    sugar::move_median_to_first(first, first + 1, mid, last - 1, comp);
+    return sugar::unguarded_partition(first + 1, last, first, comp);
+}
+
+/**
+ * @brief 快速排序/选择的递归深度上限 2*floor(log2(n))，超过后改用堆算法保证O(n log n)
+ */
+template<typename Distance>
+int sort_depth_limit(Distance n) {
+    int depth = 0;
+    for (; n > 1; n >>= 1) {
+        ++depth;
+    }
+    return 2 * depth;
+}
+
+/**
+ * @brief 堆选择：使[first, middle)成为[first, last)中最小的middle-first个元素构成的堆
+ */
+template<typename RandomIt, typename Compare>
+void heap_select(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    using T = typename iterator_traits<RandomIt>::value_type;
+    sugar::make_heap(first, middle, comp);
+    const Distance len = middle - first;
+    for (RandomIt i = middle; i < last; ++i) {
+        if (comp(*i, *first)) {
+            T value = sugar::move(*i);
+            *i = sugar::move(*first);
+            sugar::adjust_heap(first, Distance(0), len, sugar::move(value), comp);
+        }
+    }
+}
+
+/**
+ * @brief 部分排序：[first, middle)按升序放置[first, last)中最小的若干元素，其余元素顺序未指定
+ * @param first 起始迭代器
+ * @param middle 排序部分的结束位置
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+    sugar::heap_select(first, middle, last, comp);
+    sugar::sort_heap(first, middle, comp);
+}
+
+/**
+ * @brief 部分排序（使用operator<）
+ */
+template<typename RandomIt>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+    sugar::partial_sort(first, middle, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief 内省排序主循环：只处理长度超过阈值的区间，剩余的短区间留给最后的插入排序
+ */
+template<typename RandomIt, typename Compare>
+void introsort_loop(RandomIt first, RandomIt last, int depth_limit, Compare comp) {
+    while (last - first > sort_insertion_threshold) {
+        if (depth_limit == 0) {
+            sugar::partial_sort(first, last, last, comp);
+            return;
+        }
+        --depth_limit;
+        RandomIt cut = sugar::partition_median_pivot(first, last, comp);
+        // 递归处理右半，循环处理左半
+        sugar::introsort_loop(cut, last, depth_limit, comp);
+        last = cut;
+    }
+}
+
+/**
+ * @brief 不稳定排序（内省排序）：三数取中快排，递归过深时改用堆排序，最后整体做一次插入排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+    if (last - first < 2) {
+        return;
+    }
+    sugar::introsort_loop(first, last, sugar::sort_depth_limit(last - first), comp);
+    if (last - first > sort_insertion_threshold) {
+        // 首段必然包含全局最小值，其后可以放心使用无边界检查的插入
+        sugar::insertion_sort(first, first + sort_insertion_threshold, comp);
+        for (RandomIt i = first + sort_insertion_threshold; i != last; ++i) {
+            sugar::unguarded_linear_insert(i, comp);
+        }
+    } else {
+        sugar::insertion_sort(first, last, comp);
+    }
+}
+
+/**
+ * @brief 不稳定排序（使用operator<）
+ */
+template<typename RandomIt>
+void sort(RandomIt first, RandomIt last) {
+    sugar::sort(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief 选择第n小的元素放到nth处，使[first, nth)均不大于*nth、(nth, last)均不小于*nth；
+ *        期望O(n)，递归过深时改用堆选择
+ * @param first 起始迭代器
+ * @param nth 目标位置
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template<typename RandomIt, typename Compare>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
+    if (first == last || nth == last) {
+        return;
+    }
+    int depth_limit = sugar::sort_depth_limit(last - first);
+    while (last - first > 3) {
+        if (depth_limit == 0) {
+            sugar::heap_select(first, nth + 1, last, comp);
+            // 堆顶是最小的nth-first+1个元素中的最大者
+            sugar::iter_swap(first, nth);
+            return;
+        }
+        --depth_limit;
+        RandomIt cut = sugar::partition_median_pivot(first, last, comp);
+        if (cut <= nth) {
+            first = cut;
+        } else {
+            last = cut;
+        }
+    }
+    sugar::insertion_sort(first, last, comp);
+}
+
+/**
+ * @brief 选择第n小的元素放到nth处（使用operator<）
+ */
+template<typename RandomIt>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
+    sugar::nth_element(first, nth, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// ============================ 有序区间算法 ============================
+
+/**
+ * @brief 二分查找第一个不小于value的位置
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param value 查找值
+ * @param comp 比较函数
+ * @return 第一个满足!comp(*it, value)的迭代器
+ */
+template<typename ForwardIt, typename T, typename Compare>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+    typename iterator_traits<ForwardIt>::difference_type len = sugar::distance(first, last);
+    while (len > 0) {
+        typename iterator_traits<ForwardIt>::difference_type half = len / 2;
+        ForwardIt middle = first;
+        sugar::advance(middle, half);
+        if (comp(*middle, value)) {
+            first = ++middle;
+            len -= half + 1;
+        } else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief 二分查找第一个不小于value的位置（使用operator<）
+ */
+template<typename ForwardIt, typename T>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value) {
+    return sugar::lower_bound(first, last, value, less<T>());
+}
+
+/**
+ * @brief 二分查找第一个大于value的位置
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param value 查找值
+ * @param comp 比较函数
+ * @return 第一个满足comp(value, *it)的迭代器
+ */
+template<typename ForwardIt, typename T, typename Compare>
+ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+    typename iterator_traits<ForwardIt>::difference_type len = sugar::distance(first, last);
+    while (len > 0) {
+        typename iterator_traits<ForwardIt>::difference_type half = len / 2;
+        ForwardIt middle = first;
+        sugar::advance(middle, half);
+        if (!comp(value, *middle)) {
+            first = ++middle;
+            len -= half + 1;
+        } else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief 二分查找第一个大于value的位置（使用operator<）
+ */
+template<typename ForwardIt, typename T>
+ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value) {
+    return sugar::upper_bound(first, last, value, less<T>());
+}
+
+/**
+ * @brief 判断有序区间中是否存在value
+ */
+template<typename ForwardIt, typename T, typename Compare>
+bool binary_search(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+    first = sugar::lower_bound(first, last, value, comp);
+    return first != last && !comp(value, *first);
+}
+
+template<typename ForwardIt, typename T>
+bool binary_search(ForwardIt first, ForwardIt last, const T& value) {
+    return sugar::binary_search(first, last, value, less<T>());
+}
+
+/**
+ * @brief 指数（galloping）查找：从first开始以1, 2, 4, ...的步长探测，再在最后一段内二分。
+ *        目标离first越近越快，代价为O(log d)，d为目标到first的距离
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param value 查找值
+ * @param comp 比较函数
+ * @return 第一个满足!comp(*it, value)的迭代器
+ */
+template<typename RandomIt, typename T, typename Compare>
+RandomIt gallop_lower_bound(RandomIt first, RandomIt last, const T& value, Compare comp) {
+    using Distance = typename iterator_traits<RandomIt>::difference_type;
+    Distance n = last - first;
+    if (n == 0 || !comp(*first, value)) {
+        return first;
+    }
+    // 不变式：first[low] < value
+    Distance low = 0;
+    Distance step = 1;
+    while (step < n && comp(first[step], value)) {
+        low = step;
+        step *= 2;
+    }
+    return sugar::lower_bound(first + (low + 1), first + (step < n ? step : n), value, comp);
+}
+
+/**
+ * @brief 两个区间大小之比超过此值时改用galloping：对小区间的每个元素在大区间里指数查找，
+ *        代价为O(m log(n/m))而非O(m + n)
+ */
+const size_t set_gallop_ratio = 32;
+
+/**
+ * @brief 并、差、对称差需要把大区间的大部分元素写出，galloping只省比较、省不了写入，
+ *        因此生成结果时要更悬殊才值得（计数版本仍按set_gallop_ratio）
+ */
+const size_t set_gallop_output_ratio = 512;
+
+/**
+ * @brief 集合算法的输出端：写入输出迭代器
+ */
+template<typename OutputIt>
+struct set_output_sink {
+    static const size_t gallop_ratio = set_gallop_output_ratio;
+
+    OutputIt out;
+
+    explicit set_output_sink(OutputIt d_first) : out(d_first) {}
+
+    template<typename T>
+    void put(const T& value) {
+        *out = value;
+        ++out;
+    }
+
+    template<typename InputIt>
+    void put_range(InputIt first, InputIt last) {
+        out = sugar::copy(first, last, out);
+    }
+
+    // 大区间的整段输出在galloping中很常见，可平凡复制的类型直接memmove
+    template<typename T>
+    void put_range(const T* first, const T* last) {
+        put_range_pointer(first, last, out, is_trivial<T>());
+    }
+
+    template<typename T, typename U, typename Trivial>
+    void put_range_pointer(const T* first, const T* last, U, Trivial) {
+        out = sugar::copy(first, last, out);
+    }
+
+    template<typename T>
+    void put_range_pointer(const T* first, const T* last, T*, true_type) {
+        if (first != last) {
+            std::memmove(out, first, static_cast<size_t>(last - first) * sizeof(T));
+        }
+        out += last - first;
+    }
+
+    // block[i]在mask的第i位为1时输出
+    template<typename T>
+    void put_mask(const T* block, unsigned int mask) {
+        for (; mask != 0; ++block, mask >>= 1) {
+            if (mask & 1u) {
+                put(*block);
+            }
+        }
+    }
+};
+
+/**
+ * @brief 集合算法的输出端：只计数，不生成结果
+ */
+struct set_count_sink {
+    static const size_t gallop_ratio = set_gallop_ratio;
+
+    size_t count;
+
+    set_count_sink() : count(0) {}
+
+    template<typename T>
+    void put(const T&) {
+        ++count;
+    }
+
+    template<typename InputIt>
+    void put_range(InputIt first, InputIt last) {
+        count += static_cast<size_t>(sugar::distance(first, last));
+    }
+
+    template<typename T>
+    void put_mask(const T*, unsigned int mask) {
+        static const unsigned char popcount4[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+        count += popcount4[mask & 15u];
+    }
+};
+
+/**
+ * @brief 两个迭代器是否都是随机访问迭代器
+ */
+template<typename It1, typename It2>
+struct both_random_access
+    : conditional<is_same<typename iterator_traits<It1>::iterator_category, random_access_iterator_tag>::value &&
+                  is_same<typename iterator_traits<It2>::iterator_category, random_access_iterator_tag>::value,
+                  true_type, false_type>::type {};
+
+/**
+ * @brief 区间大小是否足够悬殊，值得galloping
+ */
+template<typename Distance>
+bool set_is_skewed(Distance n1, Distance n2, size_t ratio = set_gallop_ratio) {
+    return static_cast<size_t>(n1) / ratio > static_cast<size_t>(n2) ||
+           static_cast<size_t>(n2) / ratio > static_cast<size_t>(n1);
+}
+
+/**
+ * @brief 能否使用SIMD块求交：两侧都是指向同一种4字节整数的指针，且按operator<排序
+ */
+template<typename It1, typename It2, typename Compare>
+struct is_simd_set_intersection
+    : conditional<is_pointer<It1>::value && is_pointer<It2>::value &&
+                  is_same<typename remove_cv<typename iterator_traits<It1>::value_type>::type,
+                          typename remove_cv<typename iterator_traits<It2>::value_type>::type>::value &&
+                  is_integer<typename iterator_traits<It1>::value_type>::value &&
+                  sizeof(typename iterator_traits<It1>::value_type) == 4 &&
+                  is_same<Compare, less<typename remove_cv<typename iterator_traits<It1>::value_type>::type>>::value,
+                  true_type, false_type>::type {};
+
+// ---------------------------- set_intersection ----------------------------
+
+/**
+ * @brief 线性归并求交
+ */
+template<typename InputIt1, typename InputIt2, typename Sink, typename Compare>
+void set_intersection_merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                            Sink& sink, Compare comp) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first1, *first2)) {
+            ++first1;
+        } else if (comp(*first2, *first1)) {
+            ++first2;
+        } else {
+            sink.put(*first1);
+            ++first1;
+            ++first2;
+        }
+    }
+}
+
+/**
+ * @brief galloping求交：遍历小区间，在大区间里指数查找
+ */
+template<typename RandomIt1, typename RandomIt2, typename Sink, typename Compare>
+void set_intersection_gallop(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                             Sink& sink, Compare comp) {
+    if (last1 - first1 <= last2 - first2) {
+        for (; first1 != last1; ++first1) {
+            first2 = sugar::gallop_lower_bound(first2, last2, *first1, comp);
+            if (first2 == last2) {
+                return;
+            }
+            if (!comp(*first1, *first2)) {
+                sink.put(*first1);
+                ++first2;
+            }
+        }
+    } else {
+        for (; first2 != last2; ++first2) {
+            first1 = sugar::gallop_lower_bound(first1, last1, *first2, comp);
+            if (first1 == last1) {
+                return;
+            }
+            if (!comp(*first2, *first1)) {
+                sink.put(*first1);
+                ++first1;
+            }
+        }
+    }
+}
+
+template<typename RandomIt1, typename RandomIt2, typename Sink, typename Compare>
+void set_intersection_block(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                            Sink& sink, Compare comp, false_type) {
+    sugar::set_intersection_merge(first1, last1, first2, last2, sink, comp);
+}
+
+/**
+ * @brief SIMD块求交：每次取两侧各4个元素做4x4全比较（B块轮转3次），
+ *        再按两块的最大值决定前进哪一侧。块内含相邻重复值时退回一步标量归并，
+ *        以保持多重集合语义
+ */
+template<typename T, typename Sink, typename Compare>
+void set_intersection_block(const T* first1, const T* last1, const T* first2, const T* last2,
+                            Sink& sink, Compare comp, true_type) {
+#if SUGAR_HAS_SSE2
+    // 多读一个元素用于重复值检测，因此要求每侧至少剩5个
+    while (last1 - first1 > 4 && last2 - first2 > 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first1));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first2));
+        __m128i dup = _mm_or_si128(
+            _mm_cmpeq_epi32(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(first1 + 1))),
+            _mm_cmpeq_epi32(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(first2 + 1))));
+        if (_mm_movemask_epi8(dup) != 0) {
+            if (*first1 < *first2) {
+                ++first1;
+            } else if (*first2 < *first1) {
+                ++first2;
+            } else {
+                sink.put(*first1);
+                ++first1;
+                ++first2;
+            }
+            continue;
+        }
+        __m128i m = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(a, b), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, 0x39))),
+            _mm_or_si128(_mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, 0x4E)), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, 0x93))));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+        if (mask != 0) {
+            sink.put_mask(first1, mask);
+        }
+        const T max1 = first1[3];
+        const T max2 = first2[3];
+        first1 += max1 <= max2 ? 4 : 0;
+        first2 += max2 <= max1 ? 4 : 0;
+    }
+#endif
+    sugar::set_intersection_merge(first1, last1, first2, last2, sink, comp);
+}
+
+template<typename InputIt1, typename InputIt2, typename Sink, typename Compare>
+void set_intersection_dispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                               Sink& sink, Compare comp, false_type) {
+    sugar::set_intersection_merge(first1, last1, first2, last2, sink, comp);
+}
+
+template<typename RandomIt1, typename RandomIt2, typename Sink, typename Compare>
+void set_intersection_dispatch(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                               Sink& sink, Compare comp, true_type) {
+    if (sugar::set_is_skewed(last1 - first1, last2 - first2)) {
+        sugar::set_intersection_gallop(first1, last1, first2, last2, sink, comp);
+    } else {
+        sugar::set_intersection_block(first1, last1, first2, last2, sink, comp,
+                                      is_simd_set_intersection<RandomIt1, RandomIt2, Compare>());
+    }
+}
+
+/**
+ * @brief 有序区间求交（多重集合语义：相同元素输出min(m, n)个，取自第一个区间）
+ *
+ * 随机访问区间大小悬殊时使用galloping；大小相近的4字节整数指针区间使用SIMD块比较。
+ *
+ * @param first1 第一个区间的起始迭代器
+ * @param last1 第一个区间的结束迭代器
+ * @param first2 第二个区间的起始迭代器
+ * @param last2 第二个区间的结束迭代器
+ * @param d_first 输出起始迭代器
+ * @param comp 比较函数
+ * @return 指向输出末尾的迭代器
+ */
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt set_intersection(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                          OutputIt d_first, Compare comp) {
+    set_output_sink<OutputIt> sink(d_first);
+    sugar::set_intersection_dispatch(first1, last1, first2, last2, sink, comp,
+                                     both_random_access<InputIt1, InputIt2>());
+    return sink.out;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt set_intersection(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return sugar::set_intersection(first1, last1, first2, last2, d_first,
+                                   less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+/**
+ * @brief 求交集的大小，不生成结果
+ */
+template<typename InputIt1, typename InputIt2, typename Compare>
+size_t set_intersection_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, Compare comp) {
+    set_count_sink sink;
+    sugar::set_intersection_dispatch(first1, last1, first2, last2, sink, comp,
+                                     both_random_access<InputIt1, InputIt2>());
+    return sink.count;
+}
+
+template<typename InputIt1, typename InputIt2>
+size_t set_intersection_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+    return sugar::set_intersection_count(first1, last1, first2, last2,
+                                         less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+// ---------------------------- set_union ----------------------------
+
+template<typename InputIt1, typename InputIt2, typename Sink, typename Compare>
+void set_union_dispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                        Sink& sink, Compare comp, false_type) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first2, *first1)) {
+            sink.put(*first2);
+            ++first2;
+        } else {
+            if (!comp(*first1, *first2)) {
+                ++first2;
+            }
+            sink.put(*first1);
+            ++first1;
+        }
+    }
+    sink.put_range(first1, last1);
+    sink.put_range(first2, last2);
+}
+
+/**
+ * @brief galloping求并：遍历小区间，大区间中夹在两个小区间元素之间的整段直接批量输出
+ */
+template<typename RandomIt1, typename RandomIt2, typename Sink, typename Compare>
+void set_union_dispatch(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                        Sink& sink, Compare comp, true_type) {
+    if (!sugar::set_is_skewed(last1 - first1, last2 - first2, Sink::gallop_ratio)) {
+        sugar::set_union_dispatch(first1, last1, first2, last2, sink, comp, false_type());
+        return;
+    }
+    if (last1 - first1 <= last2 - first2) {
+        for (; first1 != last1; ++first1) {
+            RandomIt2 pos = sugar::gallop_lower_bound(first2, last2, *first1, comp);
+            sink.put_range(first2, pos);
+            first2 = pos;
+            if (first2 != last2 && !comp(*first1, *first2)) {
+                ++first2;
+            }
+            sink.put(*first1);
+        }
+        sink.put_range(first2, last2);
+    } else {
+        for (; first2 != last2; ++first2) {
+            RandomIt1 pos = sugar::gallop_lower_bound(first1, last1, *first2, comp);
+            sink.put_range(first1, pos);
+            first1 = pos;
+            if (first1 != last1 && !comp(*first2, *first1)) {
+                sink.put(*first1);
+                ++first1;
+            } else {
+                sink.put(*first2);
+            }
+        }
+        sink.put_range(first1, last1);
+    }
+}
+
+/**
+ * @brief 有序区间求并（多重集合语义：相同元素输出max(m, n)个，相等时优先取第一个区间）
+ * @param first1 第一个区间的起始迭代器
+ * @param last1 第一个区间的结束迭代器
+ * @param first2 第二个区间的起始迭代器
+ * @param last2 第二个区间的结束迭代器
+ * @param d_first 输出起始迭代器
+ * @param comp 比较函数
+ * @return 指向输出末尾的迭代器
+ */
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt set_union(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                   OutputIt d_first, Compare comp) {
+    set_output_sink<OutputIt> sink(d_first);
+    sugar::set_union_dispatch(first1, last1, first2, last2, sink, comp, both_random_access<InputIt1, InputIt2>());
+    return sink.out;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt set_union(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return sugar::set_union(first1, last1, first2, last2, d_first,
+                            less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+/**
+ * @brief 求并集的大小，不生成结果
+ */
+template<typename InputIt1, typename InputIt2, typename Compare>
+size_t set_union_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, Compare comp) {
+    set_count_sink sink;
+    sugar::set_union_dispatch(first1, last1, first2, last2, sink, comp, both_random_access<InputIt1, InputIt2>());
+    return sink.count;
+}
+
+template<typename InputIt1, typename InputIt2>
+size_t set_union_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+    return sugar::set_union_count(first1, last1, first2, last2,
+                                  less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+// ---------------------------- set_difference ----------------------------
+
+template<typename InputIt1, typename InputIt2, typename Sink, typename Compare>
+void set_difference_dispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                             Sink& sink, Compare comp, false_type) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first1, *first2)) {
+            sink.put(*first1);
+            ++first1;
+        } else {
+            if (!comp(*first2, *first1)) {
+                ++first1;
+            }
+            ++first2;
+        }
+    }
+    sink.put_range(first1, last1);
+}
+
+/**
+ * @brief galloping求差：第一个区间大时批量输出两次命中之间的整段，第二个区间大时逐个查找
+ */
+template<typename RandomIt1, typename RandomIt2, typename Sink, typename Compare>
+void set_difference_dispatch(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                             Sink& sink, Compare comp, true_type) {
+    if (!sugar::set_is_skewed(last1 - first1, last2 - first2, Sink::gallop_ratio)) {
+        sugar::set_difference_dispatch(first1, last1, first2, last2, sink, comp, false_type());
+        return;
+    }
+    if (last1 - first1 <= last2 - first2) {
+        for (; first1 != last1; ++first1) {
+            first2 = sugar::gallop_lower_bound(first2, last2, *first1, comp);
+            if (first2 != last2 && !comp(*first1, *first2)) {
+                ++first2;
+            } else {
+                sink.put(*first1);
+            }
+        }
+    } else {
+        for (; first2 != last2 && first1 != last1; ++first2) {
+            RandomIt1 pos = sugar::gallop_lower_bound(first1, last1, *first2, comp);
+            sink.put_range(first1, pos);
+            first1 = pos;
+            if (first1 != last1 && !comp(*first2, *first1)) {
+                ++first1;
+            }
+        }
+        sink.put_range(first1, last1);
+    }
+}
+
+/**
+ * @brief 有序区间求差：输出在第一个区间而不在第二个区间的元素（多重集合语义：max(m - n, 0)个）
+ * @param first1 第一个区间的起始迭代器
+ * @param last1 第一个区间的结束迭代器
+ * @param first2 第二个区间的起始迭代器
+ * @param last2 第二个区间的结束迭代器
+ * @param d_first 输出起始迭代器
+ * @param comp 比较函数
+ * @return 指向输出末尾的迭代器
+ */
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt set_difference(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                        OutputIt d_first, Compare comp) {
+    set_output_sink<OutputIt> sink(d_first);
+    sugar::set_difference_dispatch(first1, last1, first2, last2, sink, comp,
+                                   both_random_access<InputIt1, InputIt2>());
+    return sink.out;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt set_difference(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return sugar::set_difference(first1, last1, first2, last2, d_first,
+                                 less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+/**
+ * @brief 求差集的大小，不生成结果
+ */
+template<typename InputIt1, typename InputIt2, typename Compare>
+size_t set_difference_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, Compare comp) {
+    set_count_sink sink;
+    sugar::set_difference_dispatch(first1, last1, first2, last2, sink, comp,
+                                   both_random_access<InputIt1, InputIt2>());
+    return sink.count;
+}
+
+template<typename InputIt1, typename InputIt2>
+size_t set_difference_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+    return sugar::set_difference_count(first1, last1, first2, last2,
+                                       less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+// ---------------------------- set_symmetric_difference ----------------------------
+
+template<typename InputIt1, typename InputIt2, typename Sink, typename Compare>
+void set_symmetric_difference_dispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                                       Sink& sink, Compare comp, false_type) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first1, *first2)) {
+            sink.put(*first1);
+            ++first1;
+        } else if (comp(*first2, *first1)) {
+            sink.put(*first2);
+            ++first2;
+        } else {
+            ++first1;
+            ++first2;
+        }
+    }
+    sink.put_range(first1, last1);
+    sink.put_range(first2, last2);
+}
+
+/**
+ * @brief galloping求对称差：遍历小区间，大区间中的整段直接批量输出
+ */
+template<typename RandomIt1, typename RandomIt2, typename Sink, typename Compare>
+void set_symmetric_difference_dispatch(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                                       Sink& sink, Compare comp, true_type) {
+    if (!sugar::set_is_skewed(last1 - first1, last2 - first2, Sink::gallop_ratio)) {
+        sugar::set_symmetric_difference_dispatch(first1, last1, first2, last2, sink, comp, false_type());
+        return;
+    }
+    if (last1 - first1 <= last2 - first2) {
+        for (; first1 != last1; ++first1) {
+            RandomIt2 pos = sugar::gallop_lower_bound(first2, last2, *first1, comp);
+            sink.put_range(first2, pos);
+            first2 = pos;
+            if (first2 != last2 && !comp(*first1, *first2)) {
+                ++first2;
+            } else {
+                sink.put(*first1);
+            }
+        }
+        sink.put_range(first2, last2);
+    } else {
+        for (; first2 != last2; ++first2) {
+            RandomIt1 pos = sugar::gallop_lower_bound(first1, last1, *first2, comp);
+            sink.put_range(first1, pos);
+            first1 = pos;
+            if (first1 != last1 && !comp(*first2, *first1)) {
+                ++first1;
+            } else {
+                sink.put(*first2);
+            }
+        }
+        sink.put_range(first1, last1);
+    }
+}
+
+/**
+ * @brief 有序区间求对称差：输出只在其中一个区间出现的元素（多重集合语义：|m - n|个）
+ * @param first1 第一个区间的起始迭代器
+ * @param last1 第一个区间的结束迭代器
+ * @param first2 第二个区间的起始迭代器
+ * @param last2 第二个区间的结束迭代器
+ * @param d_first 输出起始迭代器
+ * @param comp 比较函数
+ * @return 指向输出末尾的迭代器
+ */
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt set_symmetric_difference(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                                  OutputIt d_first, Compare comp) {
+    set_output_sink<OutputIt> sink(d_first);
+    sugar::set_symmetric_difference_dispatch(first1, last1, first2, last2, sink, comp,
+                                             both_random_access<InputIt1, InputIt2>());
+    return sink.out;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt set_symmetric_difference(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                                  OutputIt d_first) {
+    return sugar::set_symmetric_difference(first1, last1, first2, last2, d_first,
+                                           less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+/**
+ * @brief 求对称差集的大小，不生成结果
+ */
+template<typename InputIt1, typename InputIt2, typename Compare>
+size_t set_symmetric_difference_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                                      Compare comp) {
+    set_count_sink sink;
+    sugar::set_symmetric_difference_dispatch(first1, last1, first2, last2, sink, comp,
+                                             both_random_access<InputIt1, InputIt2>());
+    return sink.count;
+}
+
+template<typename InputIt1, typename InputIt2>
+size_t set_symmetric_difference_count(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+    return sugar::set_symmetric_difference_count(first1, last1, first2, last2,
+                                                 less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+// ---------------------------- includes ----------------------------
+
+template<typename InputIt1, typename InputIt2, typename Compare>
+bool includes_dispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                       Compare comp, false_type) {
+    for (; first2 != last2; ++first1) {
+        if (first1 == last1 || comp(*first2, *first1)) {
+            return false;
+        }
+        if (!comp(*first1, *first2)) {
+            ++first2;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief galloping判断包含：第二个区间比第一个区间大时直接返回false
+ */
+template<typename RandomIt1, typename RandomIt2, typename Compare>
+bool includes_dispatch(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+                       Compare comp, true_type) {
+    if (last2 - first2 > last1 - first1) {
+        return false;
+    }
+    if (!sugar::set_is_skewed(last1 - first1, last2 - first2)) {
+        return sugar::includes_dispatch(first1, last1, first2, last2, comp, false_type());
+    }
+    for (; first2 != last2; ++first2, ++first1) {
+        first1 = sugar::gallop_lower_bound(first1, last1, *first2, comp);
+        if (first1 == last1 || comp(*first2, *first1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 判断有序区间[first1, last1)是否包含[first2, last2)（多重集合语义）
+ * @param first1 第一个区间的起始迭代器
+ * @param last1 第一个区间的结束迭代器
+ * @param first2 第二个区间的起始迭代器
+ * @param last2 第二个区间的结束迭代器
+ * @param comp 比较函数
+ * @return 包含返回true，否则返回false
+ */
+template<typename InputIt1, typename InputIt2, typename Compare>
+bool includes(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, Compare comp) {
+    return sugar::includes_dispatch(first1, last1, first2, last2, comp, both_random_access<InputIt1, InputIt2>());
+}
+
+template<typename InputIt1, typename InputIt2>
+bool includes(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+    return sugar::includes(first1, last1, first2, last2, less<typename iterator_traits<InputIt1>::value_type>());
+}
+
 } // namespace sugar
 
 #endif // ALGORITHM_H_ 
\ No newline at end of file
@@ -233,6 +233,36 @@ bool operator!=(const allocator<T1>& lhs, const allocator<T2>& rhs) noexcept {
 
 // ============================ allocator_traits ============================
 
+/**
+ * allocator_substitute - 把形如A<T, Args...>的分配器的首个模板参数换成U
+ * 不是这种形式时退回allocator<U>
+ */
+template<typename Alloc, typename U>
+struct allocator_substitute {
+    using type = allocator<U>;
+};
+
+template<template<typename, typename...> class A, typename T, typename... Args, typename U>
+struct allocator_substitute<A<T, Args...>, U> {
+    using type = A<U, Args...>;
+};
+
+/**
+ * allocator_rebind - 把分配器Alloc换成分配U的同类分配器
+ * 优先使用Alloc::rebind<U>::other，没有时交给allocator_substitute
+ */
+template<typename Alloc, typename U>
+struct allocator_rebind {
+private:
+    template<typename A>
+    static typename A::template rebind<U>::other test(int);
+    template<typename A>
+    static typename allocator_substitute<A, U>::type test(...);
+
+public:
+    using type = decltype(test<Alloc>(0));
+};
+
 /**
  * allocator_traits - 分配器特征
  */
@@ -280,7 +310,7 @@ struct allocator_traits {
 
     // 选择分配器
     template<typename T>
-    using rebind_alloc = allocator<T>;
+    using rebind_alloc = typename allocator_rebind<Alloc, T>::type;
 };
 
 // ============================ 内存池分配器 ============================
@@ -419,6 +449,15 @@ using allocator_t = allocator<T>;
 template<typename T, size_t BlockSize = 4096>
 using pool_allocator_t = pool_allocator<T, BlockSize>;
 
+/**
+ * 标签类型，用于选择接受分配器参数的构造函数
+ */
+struct allocator_arg_t {
+    explicit allocator_arg_t() = default;
+};
+
+const allocator_arg_t allocator_arg = allocator_arg_t();
+
 // ============================ 便捷函数 ============================
 
 /**
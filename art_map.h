@@ -0,0 +1,1272 @@
+/*
+ * @file art_map.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 自适应基数树（ART）：Node4/16/48/256 四种内部节点随子节点数伸缩，路径压缩，
+ *        Node16 用SSE2并行查找，叶子按键序串成链表以支持有序遍历、范围与前缀查询，节点从页式slab分配
+ */
+
+#ifndef ART_MAP_H_
+#define ART_MAP_H_
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "utility.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace sugar {
+
+// ============================ 键编码 ============================
+
+/**
+ * @brief 键的字节视图，按字节字典序比较
+ */
+struct art_key {
+    const unsigned char* data;
+    size_t size;
+};
+
+/**
+ * @brief 整数键编码时使用的临时缓冲区大小
+ */
+const size_t art_key_scratch = 16;
+
+/**
+ * @brief 内部节点内存储的压缩路径字节数上限，更长的路径查找时跳过、在叶子处整体校验
+ */
+const uint32_t art_max_prefix = 8;
+
+template<typename Key, typename Enable = void>
+struct art_key_traits;
+
+/**
+ * @brief 整数键：按大端序展开，有符号数翻转符号位，使字节序与数值序一致
+ */
+template<typename Key>
+struct art_key_traits<Key, typename enable_if<is_integer<Key>::value>::type> {
+    static art_key view(const Key& key, unsigned char* scratch) noexcept {
+        uint64_t v = static_cast<uint64_t>(key);
+        if (Key(-1) < Key(0)) {
+            v ^= uint64_t(1) << (8 * sizeof(Key) - 1);
+        }
+        for (size_t i = 0; i < sizeof(Key); ++i) {
+            scratch[i] = static_cast<unsigned char>(v >> (8 * (sizeof(Key) - 1 - i)));
+        }
+        art_key k = {scratch, sizeof(Key)};
+        return k;
+    }
+};
+
+/**
+ * @brief 字符串键：直接使用字符串的字节，允许包含'\0'，也允许一个键是另一个键的前缀
+ */
+template<>
+struct art_key_traits<std::string> {
+    static art_key view(const std::string& key, unsigned char*) noexcept {
+        art_key k = {reinterpret_cast<const unsigned char*>(key.data()), key.size()};
+        return k;
+    }
+};
+
+// ============================ 页式slab分配器 ============================
+
+/**
+ * @brief art_slab_pool 类，固定大小对象的分配器
+ *
+ * 每次向 sugar::allocate 申请整页（4KB的倍数，至少容纳8个对象）的slab，
+ * 释放的对象进入空闲链表复用；只有析构或 release() 时才归还slab。
+ */
+class art_slab_pool {
+private:
+    struct free_slot {
+        free_slot* next;
+    };
+
+    static const size_t page_size = 4096;
+
+    vector<void*> slabs_;
+    free_slot* free_;
+    char* cursor_;
+    char* end_;
+    size_t object_size_;
+    size_t slab_size_;
+
+public:
+    explicit art_slab_pool(size_t object_size)
+        : free_(nullptr), cursor_(nullptr), end_(nullptr), object_size_((object_size + 15) & ~size_t(15)) {
+        size_t bytes = object_size_ * 8;
+        if (bytes < page_size) {
+            bytes = page_size;
+        }
+        slab_size_ = (bytes + page_size - 1) / page_size * page_size;
+    }
+
+    art_slab_pool(const art_slab_pool&) = delete;
+    art_slab_pool& operator=(const art_slab_pool&) = delete;
+
+    ~art_slab_pool() { release(); }
+
+    void* allocate() {
+        if (free_ != nullptr) {
+            free_slot* p = free_;
+            free_ = p->next;
+            return p;
+        }
+        if (cursor_ == end_) {
+            // 先扩容再分配slab，push_back不会抛出；按倍数扩容，避免每个slab都复制整个指针数组
+            if (slabs_.size() == slabs_.capacity()) {
+                slabs_.reserve(2 * slabs_.size() + 1);
+            }
+            char* slab = static_cast<char*>(sugar::allocate(slab_size_));
+            slabs_.push_back(slab);
+            cursor_ = slab;
+            end_ = slab + slab_size_ / object_size_ * object_size_;
+        }
+        void* p = cursor_;
+        cursor_ += object_size_;
+        return p;
+    }
+
+    void deallocate(void* p) noexcept {
+        free_slot* s = static_cast<free_slot*>(p);
+        s->next = free_;
+        free_ = s;
+    }
+
+    /**
+     * @brief 归还全部slab，之前分配的对象全部失效
+     */
+    void release() noexcept {
+        for (size_t i = 0; i < slabs_.size(); ++i) {
+            sugar::deallocate(slabs_[i], slab_size_);
+        }
+        slabs_.clear();
+        free_ = nullptr;
+        cursor_ = nullptr;
+        end_ = nullptr;
+    }
+
+    size_t memory_bytes() const noexcept { return slabs_.size() * slab_size_; }
+
+    void swap(art_slab_pool& other) noexcept {
+        slabs_.swap(other.slabs_);
+        sugar::swap(free_, other.free_);
+        sugar::swap(cursor_, other.cursor_);
+        sugar::swap(end_, other.end_);
+        sugar::swap(object_size_, other.object_size_);
+        sugar::swap(slab_size_, other.slab_size_);
+    }
+};
+
+// ============================ art_map 类 ============================
+
+enum class art_node_type : uint8_t { node4, node16, node48, node256 };
+
+/**
+ * @brief art_map 类，基于自适应基数树的有序映射
+ *
+ * 键按字节逐层分派：子节点少时用Node4/Node16（有序键数组，Node16用SSE2一次比较16个键），
+ * 多时用Node48（256字节的间接下标）或Node256（直接数组），节点随插入删除伸缩。
+ * 只有一个子节点的路径压缩进节点前缀：前8个字节存在节点里，更长的部分查找时跳过、
+ * 到叶子再整体校验（混合路径压缩）。恰好在某节点处结束的键挂在该节点的terminal上，
+ * 因此字符串键可以互为前缀。
+ *
+ * 叶子按键序串成双向链表，有序遍历、lower_bound 之后的范围扫描和前缀扫描都是顺链表前进。
+ * 节点与叶子从各自尺寸的页式slab分配，不会为每个节点单独调用 sugar::allocate。
+ *
+ * @tparam Key 键类型：整数或 std::string
+ * @tparam T 值类型
+ */
+template<typename Key, typename T>
+class art_map {
+private:
+    typedef art_key_traits<Key> traits;
+
+    struct link {
+        link* prev;
+        link* next;
+    };
+
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = pair<const Key, T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    struct leaf : link {
+        value_type kv;
+
+        template<typename... Args>
+        explicit leaf(Args&&... args) : kv(sugar::forward<Args>(args)...) {}
+    };
+
+    // ============================ 迭代器 ============================
+
+    template<bool IsConst>
+    class art_iterator {
+        friend class art_map;
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = typename art_map::value_type;
+        using difference_type = ptrdiff_t;
+        using pointer = typename conditional<IsConst, const value_type*, value_type*>::type;
+        using reference = typename conditional<IsConst, const value_type&, value_type&>::type;
+
+    private:
+        link* node_;
+
+        explicit art_iterator(link* node) : node_(node) {}
+
+    public:
+        art_iterator() : node_(nullptr) {}
+
+        // 非const迭代器可以转换为const迭代器
+        template<bool OtherConst, typename = typename enable_if<IsConst && !OtherConst>::type>
+        art_iterator(const art_iterator<OtherConst>& other) : node_(other.node_) {}
+
+        reference operator*() const { return static_cast<leaf*>(node_)->kv; }
+        pointer operator->() const { return &static_cast<leaf*>(node_)->kv; }
+
+        art_iterator& operator++() {
+            node_ = node_->next;
+            return *this;
+        }
+
+        art_iterator operator++(int) {
+            art_iterator tmp = *this;
+            node_ = node_->next;
+            return tmp;
+        }
+
+        art_iterator& operator--() {
+            node_ = node_->prev;
+            return *this;
+        }
+
+        art_iterator operator--(int) {
+            art_iterator tmp = *this;
+            node_ = node_->prev;
+            return tmp;
+        }
+
+        friend bool operator==(const art_iterator& a, const art_iterator& b) { return a.node_ == b.node_; }
+        friend bool operator!=(const art_iterator& a, const art_iterator& b) { return a.node_ != b.node_; }
+
+        template<bool>
+        friend class art_iterator;
+    };
+
+public:
+    using iterator = art_iterator<false>;
+    using const_iterator = art_iterator<true>;
+
+private:
+    // 节点内最多存储的压缩路径字节数
+    static constexpr uint32_t max_prefix = art_max_prefix;
+
+    // ============================ 节点布局 ============================
+
+    struct node {
+        art_node_type type;
+        uint16_t count;                    // 子节点数
+        uint32_t prefix_len;               // 压缩路径的总长度
+        unsigned char prefix[max_prefix];  // 压缩路径的前max_prefix个字节
+        leaf* terminal;                    // 恰好在本节点（前缀之后）结束的键
+    };
+
+    struct node4 : node {
+        unsigned char keys[4];
+        void* children[4];
+    };
+
+    struct node16 : node {
+        unsigned char keys[16];
+        void* children[16];
+    };
+
+    struct node48 : node {
+        unsigned char index[256];   // 0表示没有子节点，否则为children下标加1
+        void* children[48];
+    };
+
+    struct node256 : node {
+        void* children[256];
+    };
+
+    // ============================ 私有成员 ============================
+    void* root_;            // 内部节点指针，或最低位为1的叶子指针
+    link sentinel_;         // 叶子按键序组成的带哨兵双向循环链表
+    size_type size_;
+    art_slab_pool leaves_;
+    art_slab_pool nodes4_;
+    art_slab_pool nodes16_;
+    art_slab_pool nodes48_;
+    art_slab_pool nodes256_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static bool is_leaf(const void* p) noexcept { return (reinterpret_cast<uintptr_t>(p) & 1) != 0; }
+
+    static leaf* as_leaf(const void* p) noexcept {
+        return reinterpret_cast<leaf*>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(1));
+    }
+
+    static void* tag(leaf* l) noexcept { return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(l) | 1); }
+
+    static node* as_node(void* p) noexcept { return static_cast<node*>(p); }
+
+    static art_key leaf_key(const leaf* l, unsigned char* scratch) noexcept { return traits::view(l->kv.first, scratch); }
+
+    static bool key_equal(art_key a, art_key b) noexcept {
+        return a.size == b.size && (a.size == 0 || std::memcmp(a.data, b.data, a.size) == 0);
+    }
+
+    /**
+     * @brief 字节字典序比较，返回负数、0或正数
+     */
+    static int key_compare(art_key a, art_key b) noexcept {
+        const size_t n = a.size < b.size ? a.size : b.size;
+        const int c = n == 0 ? 0 : std::memcmp(a.data, b.data, n);
+        if (c != 0) {
+            return c;
+        }
+        return a.size < b.size ? -1 : a.size > b.size ? 1 : 0;
+    }
+
+    // ---------------------------- 链表 ----------------------------
+
+    static void link_before(link* pos, link* l) noexcept {
+        l->prev = pos->prev;
+        l->next = pos;
+        pos->prev->next = l;
+        pos->prev = l;
+    }
+
+    static void unlink(link* l) noexcept {
+        l->prev->next = l->next;
+        l->next->prev = l->prev;
+    }
+
+    /**
+     * @brief 把首尾为ends.next/ends.prev、原哨兵为old的链表改挂到哨兵s上
+     */
+    static void adopt(link& s, const link& ends, const link* old) noexcept {
+        if (ends.next == old) {
+            s.prev = &s;
+            s.next = &s;
+            return;
+        }
+        s.next = ends.next;
+        s.prev = ends.prev;
+        s.next->prev = &s;
+        s.prev->next = &s;
+    }
+
+    // ---------------------------- 分配 ----------------------------
+
+    template<typename... Args>
+    leaf* make_leaf(Args&&... args) {
+        void* p = leaves_.allocate();
+        try {
+            return ::new (p) leaf(sugar::forward<Args>(args)...);
+        } catch (...) {
+            leaves_.deallocate(p);
+            throw;
+        }
+    }
+
+    void destroy_leaf(leaf* l) noexcept {
+        l->~leaf();
+        leaves_.deallocate(l);
+    }
+
+    template<typename N>
+    static N* init_node(void* p, art_node_type type) noexcept {
+        N* n = static_cast<N*>(p);
+        std::memset(static_cast<void*>(n), 0, sizeof(N));
+        n->type = type;
+        return n;
+    }
+
+    node4* new_node4() { return init_node<node4>(nodes4_.allocate(), art_node_type::node4); }
+    node16* new_node16() { return init_node<node16>(nodes16_.allocate(), art_node_type::node16); }
+    node48* new_node48() { return init_node<node48>(nodes48_.allocate(), art_node_type::node48); }
+    node256* new_node256() { return init_node<node256>(nodes256_.allocate(), art_node_type::node256); }
+
+    void free_node(node* n) noexcept {
+        switch (n->type) {
+        case art_node_type::node4: nodes4_.deallocate(n); break;
+        case art_node_type::node16: nodes16_.deallocate(n); break;
+        case art_node_type::node48: nodes48_.deallocate(n); break;
+        case art_node_type::node256: nodes256_.deallocate(n); break;
+        }
+    }
+
+    static void copy_header(node* to, const node* from) noexcept {
+        to->count = from->count;
+        to->prefix_len = from->prefix_len;
+        std::memcpy(to->prefix, from->prefix, max_prefix);
+        to->terminal = from->terminal;
+    }
+
+    // ---------------------------- 子节点查找 ----------------------------
+
+    static void** find_child(node* n, unsigned char b) noexcept {
+        switch (n->type) {
+        case art_node_type::node4: {
+            node4* p = static_cast<node4*>(n);
+            for (uint32_t i = 0; i < p->count; ++i) {
+                if (p->keys[i] == b) {
+                    return &p->children[i];
+                }
+            }
+            return nullptr;
+        }
+        case art_node_type::node16: {
+            node16* p = static_cast<node16*>(n);
+#if SUGAR_HAS_SSE2
+            const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p->keys));
+            const __m128i hit = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(b)));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit)) & ((1u << p->count) - 1);
+            return mask != 0 ? &p->children[__builtin_ctz(mask)] : nullptr;
+#else
+            for (uint32_t i = 0; i < p->count; ++i) {
+                if (p->keys[i] == b) {
+                    return &p->children[i];
+                }
+            }
+            return nullptr;
+#endif
+        }
+        case art_node_type::node48: {
+            node48* p = static_cast<node48*>(n);
+            return p->index[b] != 0 ? &p->children[p->index[b] - 1] : nullptr;
+        }
+        case art_node_type::node256: {
+            node256* p = static_cast<node256*>(n);
+            return p->children[b] != nullptr ? &p->children[b] : nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 键大于b的最小子节点，没有时返回nullptr；b为-1时返回第一个子节点
+     */
+    static void* next_child(node* n, int b) noexcept {
+        switch (n->type) {
+        case art_node_type::node4:
+        case art_node_type::node16: {
+            const unsigned char* keys = n->type == art_node_type::node4 ? static_cast<node4*>(n)->keys
+                                                                       : static_cast<node16*>(n)->keys;
+            void** children = n->type == art_node_type::node4 ? static_cast<node4*>(n)->children
+                                                             : static_cast<node16*>(n)->children;
+            for (uint32_t i = 0; i < n->count; ++i) {
+                if (keys[i] > b) {
+                    return children[i];
+                }
+            }
+            return nullptr;
+        }
+        case art_node_type::node48: {
+            node48* p = static_cast<node48*>(n);
+            for (int k = b + 1; k < 256; ++k) {
+                if (p->index[k] != 0) {
+                    return p->children[p->index[k] - 1];
+                }
+            }
+            return nullptr;
+        }
+        case art_node_type::node256: {
+            node256* p = static_cast<node256*>(n);
+            for (int k = b + 1; k < 256; ++k) {
+                if (p->children[k] != nullptr) {
+                    return p->children[k];
+                }
+            }
+            return nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    static void* last_child(node* n) noexcept {
+        switch (n->type) {
+        case art_node_type::node4: return static_cast<node4*>(n)->children[n->count - 1];
+        case art_node_type::node16: return static_cast<node16*>(n)->children[n->count - 1];
+        case art_node_type::node48: {
+            node48* p = static_cast<node48*>(n);
+            for (int k = 255; k >= 0; --k) {
+                if (p->index[k] != 0) {
+                    return p->children[p->index[k] - 1];
+                }
+            }
+            return nullptr;
+        }
+        case art_node_type::node256: {
+            node256* p = static_cast<node256*>(n);
+            for (int k = 255; k >= 0; --k) {
+                if (p->children[k] != nullptr) {
+                    return p->children[k];
+                }
+            }
+            return nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    static leaf* min_leaf(void* p) noexcept {
+        while (!is_leaf(p)) {
+            node* n = as_node(p);
+            if (n->terminal != nullptr) {
+                return n->terminal;
+            }
+            p = next_child(n, -1);
+        }
+        return as_leaf(p);
+    }
+
+    static leaf* max_leaf(void* p) noexcept {
+        while (!is_leaf(p)) {
+            node* n = as_node(p);
+            p = n->count != 0 ? last_child(n) : tag(n->terminal);
+        }
+        return as_leaf(p);
+    }
+
+    /**
+     * @brief 节点前缀与key从depth起第一个不同的位置，key先结束也算不同；相同时返回prefix_len。
+     *        超出节点内存储部分的前缀字节取自子树中任一叶子
+     */
+    static uint32_t prefix_mismatch(node* n, art_key key, size_t depth) noexcept {
+        const uint32_t stored = stored_len(n->prefix_len);
+        uint32_t i = 0;
+        for (; i < stored; ++i) {
+            if (depth + i >= key.size || n->prefix[i] != key.data[depth + i]) {
+                return i;
+            }
+        }
+        if (n->prefix_len > max_prefix) {
+            unsigned char scratch[art_key_scratch];
+            const art_key full = leaf_key(min_leaf(n), scratch);
+            for (; i < n->prefix_len; ++i) {
+                if (depth + i >= key.size || full.data[depth + i] != key.data[depth + i]) {
+                    return i;
+                }
+            }
+        }
+        return i;
+    }
+
+    /**
+     * @brief 长度为len的压缩路径在节点内实际存储的字节数
+     */
+    static uint32_t stored_len(uint32_t len) noexcept {
+        if (len > max_prefix) {
+            len = max_prefix;
+        }
+        return len;
+    }
+
+    static void set_prefix(node* n, const unsigned char* bytes, uint32_t len) noexcept {
+        n->prefix_len = len;
+        std::memcpy(n->prefix, bytes, stored_len(len));
+    }
+
+    // ---------------------------- 子节点增删 ----------------------------
+
+    /**
+     * @brief 向有序键数组插入(b, child)，调用者保证有空位
+     */
+    static void insert_sorted(unsigned char* keys, void** children, uint32_t count, unsigned char b, void* child) noexcept {
+        uint32_t i = 0;
+        while (i < count && keys[i] < b) {
+            ++i;
+        }
+        std::memmove(keys + i + 1, keys + i, count - i);
+        std::memmove(children + i + 1, children + i, (count - i) * sizeof(void*));
+        keys[i] = b;
+        children[i] = child;
+    }
+
+    /**
+     * @brief 在*slot指向的节点上添加子节点，节点已满时换成更大的类型并更新*slot
+     */
+    void add_child(void** slot, node* n, unsigned char b, void* child) {
+        switch (n->type) {
+        case art_node_type::node4: {
+            node4* p = static_cast<node4*>(n);
+            if (p->count < 4) {
+                insert_sorted(p->keys, p->children, p->count++, b, child);
+                return;
+            }
+            node16* q = new_node16();
+            copy_header(q, p);
+            std::memcpy(q->keys, p->keys, 4);
+            std::memcpy(q->children, p->children, 4 * sizeof(void*));
+            insert_sorted(q->keys, q->children, q->count++, b, child);
+            *slot = q;
+            nodes4_.deallocate(p);
+            return;
+        }
+        case art_node_type::node16: {
+            node16* p = static_cast<node16*>(n);
+            if (p->count < 16) {
+                insert_sorted(p->keys, p->children, p->count++, b, child);
+                return;
+            }
+            node48* q = new_node48();
+            copy_header(q, p);
+            for (uint32_t i = 0; i < 16; ++i) {
+                q->index[p->keys[i]] = static_cast<unsigned char>(i + 1);
+                q->children[i] = p->children[i];
+            }
+            q->index[b] = 17;
+            q->children[16] = child;
+            ++q->count;
+            *slot = q;
+            nodes16_.deallocate(p);
+            return;
+        }
+        case art_node_type::node48: {
+            node48* p = static_cast<node48*>(n);
+            if (p->count < 48) {
+                uint32_t free_slot = 0;
+                while (p->children[free_slot] != nullptr) {
+                    ++free_slot;
+                }
+                p->children[free_slot] = child;
+                p->index[b] = static_cast<unsigned char>(free_slot + 1);
+                ++p->count;
+                return;
+            }
+            node256* q = new_node256();
+            copy_header(q, p);
+            for (int k = 0; k < 256; ++k) {
+                if (p->index[k] != 0) {
+                    q->children[k] = p->children[p->index[k] - 1];
+                }
+            }
+            q->children[b] = child;
+            ++q->count;
+            *slot = q;
+            nodes48_.deallocate(p);
+            return;
+        }
+        case art_node_type::node256: {
+            node256* p = static_cast<node256*>(n);
+            p->children[b] = child;
+            ++p->count;
+            return;
+        }
+        }
+    }
+
+    static void remove_child(node* n, unsigned char b) noexcept {
+        switch (n->type) {
+        case art_node_type::node4:
+        case art_node_type::node16: {
+            unsigned char* keys = n->type == art_node_type::node4 ? static_cast<node4*>(n)->keys
+                                                                 : static_cast<node16*>(n)->keys;
+            void** children = n->type == art_node_type::node4 ? static_cast<node4*>(n)->children
+                                                             : static_cast<node16*>(n)->children;
+            uint32_t i = 0;
+            while (keys[i] != b) {
+                ++i;
+            }
+            std::memmove(keys + i, keys + i + 1, n->count - i - 1);
+            std::memmove(children + i, children + i + 1, (n->count - i - 1) * sizeof(void*));
+            break;
+        }
+        case art_node_type::node48: {
+            node48* p = static_cast<node48*>(n);
+            p->children[p->index[b] - 1] = nullptr;
+            p->index[b] = 0;
+            break;
+        }
+        case art_node_type::node256:
+            static_cast<node256*>(n)->children[b] = nullptr;
+            break;
+        }
+        --n->count;
+    }
+
+    /**
+     * @brief 删除后整理*slot处的节点：只剩一项时与唯一的子节点合并，子节点过少时换成更小的类型
+     */
+    void shrink(void** slot) {
+        node* n = as_node(*slot);
+        if (n->count + (n->terminal != nullptr) == 1) {
+            if (n->count == 0) {
+                *slot = tag(n->terminal);
+            } else {
+                void* child = next_child(n, -1);
+                if (!is_leaf(child)) {
+                    // 父前缀 + 分派字节 + 子前缀 拼成子节点的新前缀
+                    node* c = as_node(child);
+                    unsigned char b = 0;
+                    for (int k = 0; k < 256; ++k) {
+                        void** s = find_child(n, static_cast<unsigned char>(k));
+                        if (s != nullptr) {
+                            b = static_cast<unsigned char>(k);
+                            break;
+                        }
+                    }
+                    unsigned char bytes[2 * max_prefix + 1];
+                    uint32_t len = stored_len(n->prefix_len);
+                    std::memcpy(bytes, n->prefix, len);
+                    bytes[len++] = b;
+                    const uint32_t child_stored = stored_len(c->prefix_len);
+                    std::memcpy(bytes + len, c->prefix, child_stored);
+                    const uint32_t total = n->prefix_len + 1 + c->prefix_len;
+                    // 父前缀超过max_prefix时存储部分已满，后面的字节本来就不存
+                    if (n->prefix_len >= max_prefix) {
+                        std::memcpy(c->prefix, n->prefix, max_prefix);
+                    } else {
+                        std::memcpy(c->prefix, bytes, stored_len(len + child_stored));
+                    }
+                    c->prefix_len = total;
+                }
+                *slot = child;
+            }
+            free_node(n);
+            return;
+        }
+        switch (n->type) {
+        case art_node_type::node16:
+            if (n->count == 3) {
+                node16* p = static_cast<node16*>(n);
+                node4* q = new_node4();
+                copy_header(q, p);
+                std::memcpy(q->keys, p->keys, 3);
+                std::memcpy(q->children, p->children, 3 * sizeof(void*));
+                *slot = q;
+                nodes16_.deallocate(p);
+            }
+            break;
+        case art_node_type::node48:
+            if (n->count == 12) {
+                node48* p = static_cast<node48*>(n);
+                node16* q = new_node16();
+                copy_header(q, p);
+                uint32_t i = 0;
+                for (int k = 0; k < 256; ++k) {
+                    if (p->index[k] != 0) {
+                        q->keys[i] = static_cast<unsigned char>(k);
+                        q->children[i++] = p->children[p->index[k] - 1];
+                    }
+                }
+                *slot = q;
+                nodes48_.deallocate(p);
+            }
+            break;
+        case art_node_type::node256:
+            if (n->count == 40) {
+                node256* p = static_cast<node256*>(n);
+                node48* q = new_node48();
+                copy_header(q, p);
+                uint32_t i = 0;
+                for (int k = 0; k < 256; ++k) {
+                    if (p->children[k] != nullptr) {
+                        q->index[k] = static_cast<unsigned char>(i + 1);
+                        q->children[i++] = p->children[k];
+                    }
+                }
+                *slot = q;
+                nodes256_.deallocate(p);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // ---------------------------- 查找与插入 ----------------------------
+
+    leaf* find_leaf(const Key& k) const noexcept {
+        unsigned char scratch[art_key_scratch];
+        const art_key key = traits::view(k, scratch);
+        void* p = root_;
+        size_t depth = 0;
+        while (p != nullptr) {
+            if (is_leaf(p)) {
+                unsigned char other[art_key_scratch];
+                leaf* l = as_leaf(p);
+                return key_equal(leaf_key(l, other), key) ? l : nullptr;
+            }
+            node* n = as_node(p);
+            // 乐观比较：只核对存储的前缀字节，跳过的部分由最后的整键比较兜底
+            if (n->prefix_len != 0) {
+                if (key.size - depth < n->prefix_len) {
+                    return nullptr;
+                }
+                const uint32_t stored = stored_len(n->prefix_len);
+                if (std::memcmp(n->prefix, key.data + depth, stored) != 0) {
+                    return nullptr;
+                }
+                depth += n->prefix_len;
+            }
+            if (depth == key.size) {
+                leaf* l = n->terminal;
+                unsigned char other[art_key_scratch];
+                return l != nullptr && key_equal(leaf_key(l, other), key) ? l : nullptr;
+            }
+            void** child = find_child(n, key.data[depth]);
+            if (child == nullptr) {
+                return nullptr;
+            }
+            p = *child;
+            ++depth;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 查找键，不存在时用make()创建叶子插入；返回叶子与是否新插入
+     */
+    template<typename Make>
+    pair<leaf*, bool> insert_leaf(const Key& k, Make make) {
+        unsigned char scratch[art_key_scratch];
+        const art_key key = traits::view(k, scratch);
+        if (root_ == nullptr) {
+            leaf* l = make();
+            root_ = tag(l);
+            link_before(&sentinel_, l);
+            ++size_;
+            return pair<leaf*, bool>(l, true);
+        }
+        void** slot = &root_;
+        size_t depth = 0;
+        for (;;) {
+            void* p = *slot;
+            if (is_leaf(p)) {
+                // 与已有叶子分叉：新建Node4，公共部分作为前缀
+                leaf* old = as_leaf(p);
+                unsigned char other[art_key_scratch];
+                const art_key existing = leaf_key(old, other);
+                size_t split = depth;
+                while (split < key.size && split < existing.size && key.data[split] == existing.data[split]) {
+                    ++split;
+                }
+                if (split == key.size && split == existing.size) {
+                    return pair<leaf*, bool>(old, false);
+                }
+                node4* n = new_node4();
+                leaf* l;
+                try {
+                    l = make();
+                } catch (...) {
+                    nodes4_.deallocate(n);
+                    throw;
+                }
+                set_prefix(n, key.data + depth, static_cast<uint32_t>(split - depth));
+                if (split == existing.size) {
+                    n->terminal = old;
+                } else {
+                    insert_sorted(n->keys, n->children, n->count++, existing.data[split], tag(old));
+                }
+                if (split == key.size) {
+                    n->terminal = l;
+                } else {
+                    insert_sorted(n->keys, n->children, n->count++, key.data[split], tag(l));
+                }
+                *slot = n;
+                link_before(key_compare(key, existing) < 0 ? static_cast<link*>(old) : old->next, l);
+                ++size_;
+                return pair<leaf*, bool>(l, true);
+            }
+            node* n = as_node(p);
+            const uint32_t m = n->prefix_len == 0 ? 0 : prefix_mismatch(n, key, depth);
+            if (m < n->prefix_len) {
+                // 在压缩路径中间分叉：新建Node4接管前m个字节，原节点保留剩余部分
+                unsigned char full_scratch[art_key_scratch];
+                const art_key full = leaf_key(min_leaf(n), full_scratch);
+                const unsigned char b = full.data[depth + m];
+                node4* parent = new_node4();
+                leaf* l;
+                try {
+                    l = make();
+                } catch (...) {
+                    nodes4_.deallocate(parent);
+                    throw;
+                }
+                set_prefix(parent, key.data + depth, m);
+                const uint32_t rest = n->prefix_len - m - 1;
+                set_prefix(n, full.data + depth + m + 1, rest);
+                insert_sorted(parent->keys, parent->children, parent->count++, b, n);
+                const bool before = depth + m == key.size || key.data[depth + m] < b;
+                if (depth + m == key.size) {
+                    parent->terminal = l;
+                } else {
+                    insert_sorted(parent->keys, parent->children, parent->count++, key.data[depth + m], tag(l));
+                }
+                link_before(before ? static_cast<link*>(min_leaf(n)) : max_leaf(n)->next, l);
+                *slot = parent;
+                ++size_;
+                return pair<leaf*, bool>(l, true);
+            }
+            depth += n->prefix_len;
+            if (depth == key.size) {
+                if (n->terminal != nullptr) {
+                    return pair<leaf*, bool>(n->terminal, false);
+                }
+                leaf* l = make();
+                link_before(min_leaf(n), l);
+                n->terminal = l;
+                ++size_;
+                return pair<leaf*, bool>(l, true);
+            }
+            const unsigned char b = key.data[depth];
+            void** child = find_child(n, b);
+            if (child != nullptr) {
+                slot = child;
+                ++depth;
+                continue;
+            }
+            leaf* l = make();
+            void* greater = next_child(n, b);
+            link* pos = greater != nullptr ? static_cast<link*>(min_leaf(greater)) : max_leaf(n)->next;
+            try {
+                add_child(slot, n, b, tag(l));
+            } catch (...) {
+                destroy_leaf(l);
+                throw;
+            }
+            link_before(pos, l);
+            ++size_;
+            return pair<leaf*, bool>(l, true);
+        }
+    }
+
+    /**
+     * @brief 第一个不小于key的叶子，没有时返回哨兵
+     */
+    link* lower_bound_link(art_key key) const noexcept {
+        link* end = const_cast<link*>(&sentinel_);
+        void* p = root_;
+        size_t depth = 0;
+        while (p != nullptr) {
+            if (is_leaf(p)) {
+                leaf* l = as_leaf(p);
+                unsigned char other[art_key_scratch];
+                return key_compare(leaf_key(l, other), key) >= 0 ? static_cast<link*>(l) : l->next;
+            }
+            node* n = as_node(p);
+            if (n->prefix_len != 0) {
+                const uint32_t m = prefix_mismatch(n, key, depth);
+                if (m < n->prefix_len) {
+                    // key在前缀内结束或某字节更小：整棵子树都更大；某字节更大：整棵子树都更小
+                    unsigned char scratch[art_key_scratch];
+                    const art_key full = leaf_key(min_leaf(n), scratch);
+                    if (depth + m == key.size || key.data[depth + m] < full.data[depth + m]) {
+                        return min_leaf(n);
+                    }
+                    return max_leaf(n)->next;
+                }
+                depth += n->prefix_len;
+            }
+            if (depth == key.size) {
+                return min_leaf(n);
+            }
+            const unsigned char b = key.data[depth];
+            void** child = find_child(const_cast<node*>(n), b);
+            if (child != nullptr) {
+                p = *child;
+                ++depth;
+                continue;
+            }
+            void* greater = next_child(n, b);
+            return greater != nullptr ? static_cast<link*>(min_leaf(greater)) : max_leaf(n)->next;
+        }
+        return end;
+    }
+
+    void destroy_all() noexcept {
+        link* p = sentinel_.next;
+        while (p != &sentinel_) {
+            link* next = p->next;
+            static_cast<leaf*>(p)->~leaf();
+            p = next;
+        }
+        leaves_.release();
+        nodes4_.release();
+        nodes16_.release();
+        nodes48_.release();
+        nodes256_.release();
+        root_ = nullptr;
+        sentinel_.prev = &sentinel_;
+        sentinel_.next = &sentinel_;
+        size_ = 0;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 默认构造函数
+     */
+    art_map()
+        : root_(nullptr), size_(0), leaves_(sizeof(leaf)), nodes4_(sizeof(node4)), nodes16_(sizeof(node16)),
+          nodes48_(sizeof(node48)), nodes256_(sizeof(node256)) {
+        sentinel_.prev = &sentinel_;
+        sentinel_.next = &sentinel_;
+    }
+
+    art_map(const art_map& other) : art_map() {
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            insert(*it);
+        }
+    }
+
+    art_map(art_map&& other) noexcept : art_map() { swap(other); }
+
+    art_map& operator=(art_map other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~art_map() { destroy_all(); }
+
+    // ============================ 迭代器 ============================
+
+    iterator begin() noexcept { return iterator(sentinel_.next); }
+    iterator end() noexcept { return iterator(&sentinel_); }
+    const_iterator begin() const noexcept { return const_iterator(const_cast<link*>(sentinel_.next)); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<link*>(&sentinel_)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief 节点与叶子slab占用的字节数
+     */
+    size_type memory_bytes() const noexcept {
+        return leaves_.memory_bytes() + nodes4_.memory_bytes() + nodes16_.memory_bytes() + nodes48_.memory_bytes()
+               + nodes256_.memory_bytes();
+    }
+
+    // ============================ 查找 ============================
+
+    iterator find(const Key& key) noexcept {
+        leaf* l = find_leaf(key);
+        return l != nullptr ? iterator(l) : end();
+    }
+
+    const_iterator find(const Key& key) const noexcept {
+        leaf* l = find_leaf(key);
+        return l != nullptr ? const_iterator(l) : end();
+    }
+
+    bool contains(const Key& key) const noexcept { return find_leaf(key) != nullptr; }
+    size_type count(const Key& key) const noexcept { return find_leaf(key) != nullptr ? 1 : 0; }
+
+    T& at(const Key& key) {
+        leaf* l = find_leaf(key);
+        SUGAR_THROW_OUT_OF_RANGE_IF(l == nullptr, "art_map::at - key not found");
+        return l->kv.second;
+    }
+
+    const T& at(const Key& key) const {
+        leaf* l = find_leaf(key);
+        SUGAR_THROW_OUT_OF_RANGE_IF(l == nullptr, "art_map::at - key not found");
+        return l->kv.second;
+    }
+
+    /**
+     * @brief 第一个不小于key的元素
+     */
+    iterator lower_bound(const Key& key) noexcept {
+        unsigned char scratch[art_key_scratch];
+        return iterator(lower_bound_link(traits::view(key, scratch)));
+    }
+
+    const_iterator lower_bound(const Key& key) const noexcept {
+        unsigned char scratch[art_key_scratch];
+        return const_iterator(lower_bound_link(traits::view(key, scratch)));
+    }
+
+    /**
+     * @brief 第一个大于key的元素
+     */
+    iterator upper_bound(const Key& key) noexcept {
+        iterator it = lower_bound(key);
+        return it != end() && !(key < it->first) ? ++it : it;
+    }
+
+    const_iterator upper_bound(const Key& key) const noexcept {
+        const_iterator it = lower_bound(key);
+        return it != end() && !(key < it->first) ? ++it : it;
+    }
+
+    /**
+     * @brief 以prefix（按字节）开头的所有元素组成的区间，按键序排列
+     */
+    pair<iterator, iterator> prefix_range(const Key& prefix) noexcept {
+        unsigned char scratch[art_key_scratch];
+        const art_key key = traits::view(prefix, scratch);
+        void* p = root_;
+        size_t depth = 0;
+        while (p != nullptr) {
+            if (is_leaf(p)) {
+                leaf* l = as_leaf(p);
+                unsigned char other[art_key_scratch];
+                const art_key k = leaf_key(l, other);
+                if (k.size >= key.size && (key.size == 0 || std::memcmp(k.data, key.data, key.size) == 0)) {
+                    return pair<iterator, iterator>(iterator(l), iterator(l->next));
+                }
+                break;
+            }
+            node* n = as_node(p);
+            const uint32_t m = n->prefix_len == 0 ? 0 : prefix_mismatch(n, key, depth);
+            if (depth + m >= key.size) {
+                return pair<iterator, iterator>(iterator(min_leaf(n)), iterator(max_leaf(n)->next));
+            }
+            if (m < n->prefix_len) {
+                break;
+            }
+            depth += n->prefix_len;
+            void** child = find_child(n, key.data[depth]);
+            if (child == nullptr) {
+                break;
+            }
+            p = *child;
+            ++depth;
+        }
+        return pair<iterator, iterator>(end(), end());
+    }
+
+    // ============================ 修改操作 ============================
+
+    pair<iterator, bool> insert(const value_type& value) {
+        pair<leaf*, bool> r = insert_leaf(value.first, [&]() -> leaf* { return make_leaf(value.first, value.second); });
+        return pair<iterator, bool>(iterator(r.first), r.second);
+    }
+
+    /**
+     * @brief 键不存在时用args构造值插入，存在时什么也不做
+     */
+    template<typename... Args>
+    pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        pair<leaf*, bool> r = insert_leaf(key, [&]() -> leaf* {
+            return make_leaf(key, T(sugar::forward<Args>(args)...));
+        });
+        return pair<iterator, bool>(iterator(r.first), r.second);
+    }
+
+    template<typename M>
+    pair<iterator, bool> insert_or_assign(const Key& key, M&& value) {
+        pair<iterator, bool> r = try_emplace(key, sugar::forward<M>(value));
+        if (!r.second) {
+            r.first->second = sugar::forward<M>(value);
+        }
+        return r;
+    }
+
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    /**
+     * @brief 删除键，返回删除的个数（0或1）
+     */
+    size_type erase(const Key& k) {
+        unsigned char scratch[art_key_scratch];
+        const art_key key = traits::view(k, scratch);
+        void** slot = &root_;
+        void** parent = nullptr;
+        size_t depth = 0;
+        while (*slot != nullptr) {
+            void* p = *slot;
+            if (is_leaf(p)) {
+                leaf* l = as_leaf(p);
+                unsigned char other[art_key_scratch];
+                if (!key_equal(leaf_key(l, other), key)) {
+                    return 0;
+                }
+                if (parent == nullptr) {
+                    root_ = nullptr;
+                } else {
+                    remove_child(as_node(*parent), key.data[depth - 1]);
+                    shrink(parent);
+                }
+                unlink(l);
+                destroy_leaf(l);
+                --size_;
+                return 1;
+            }
+            node* n = as_node(p);
+            if (n->prefix_len != 0 && prefix_mismatch(n, key, depth) < n->prefix_len) {
+                return 0;
+            }
+            depth += n->prefix_len;
+            if (depth == key.size) {
+                leaf* l = n->terminal;
+                if (l == nullptr) {
+                    return 0;
+                }
+                n->terminal = nullptr;
+                shrink(slot);
+                unlink(l);
+                destroy_leaf(l);
+                --size_;
+                return 1;
+            }
+            void** child = find_child(n, key.data[depth]);
+            if (child == nullptr) {
+                return 0;
+            }
+            parent = slot;
+            slot = child;
+            ++depth;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 删除迭代器指向的元素，返回下一个元素
+     */
+    iterator erase(const_iterator pos) {
+        iterator next(pos.node_->next);
+        erase(static_cast<leaf*>(pos.node_)->kv.first);
+        return next;
+    }
+
+    void clear() noexcept { destroy_all(); }
+
+    void swap(art_map& other) noexcept {
+        sugar::swap(root_, other.root_);
+        sugar::swap(size_, other.size_);
+        leaves_.swap(other.leaves_);
+        nodes4_.swap(other.nodes4_);
+        nodes16_.swap(other.nodes16_);
+        nodes48_.swap(other.nodes48_);
+        nodes256_.swap(other.nodes256_);
+        const link mine = sentinel_;
+        const link theirs = other.sentinel_;
+        adopt(sentinel_, theirs, &other.sentinel_);
+        adopt(other.sentinel_, mine, &sentinel_);
+    }
+
+    friend void swap(art_map& a, art_map& b) noexcept { a.swap(b); }
+};
+
+} // namespace sugar
+
+#endif // ART_MAP_H_
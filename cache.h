@@ -0,0 +1,716 @@
+/*
+ * @file cache.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 定长缓存：lru_cache（下标双向链表）、clock_cache（引用位+时钟指针）
+ *        以及按散列分片加锁的 sharded_cache；节点连续存放在sugar::vector中，运行期不再分配内存
+ */
+
+#ifndef CACHE_H_
+#define CACHE_H_
+
+#include "hash.h"
+#include "functional.h"
+#include "vector.h"
+#include "utility.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace sugar {
+
+// ============================ cache_base 类模板 ============================
+
+/**
+ * @brief 定长缓存的公共部分：节点数组、散列索引与空闲链
+ *
+ * 全部节点在构造时一次分配，键和值在节点内原地构造，节点之间用32位下标互相引用。
+ * 散列索引是线性探测的开放寻址表，每个桶只存节点下标和散列值低32位，
+ * 装载率不超过1/2；删除时后移填补空洞，不留墓碑。
+ *
+ * @tparam Link 替换策略附加在节点上的字段
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Link>
+class cache_base {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using mapped_type = Value;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using size_type = size_t;
+    using eviction_callback = std::function<void(const Key&, Value&)>;
+
+protected:
+    static const uint32_t nil = 0xffffffffu;
+
+    struct node {
+        alignas(Key) unsigned char key_buf[sizeof(Key)];
+        alignas(Value) unsigned char value_buf[sizeof(Value)];
+        uint32_t tag;    // 散列值低32位，删除时据此定位桶
+        Link link;
+
+        Key& key() { return *reinterpret_cast<Key*>(key_buf); }
+        Value& value() { return *reinterpret_cast<Value*>(value_buf); }
+        const Key& key() const { return *reinterpret_cast<const Key*>(key_buf); }
+        const Value& value() const { return *reinterpret_cast<const Value*>(value_buf); }
+    };
+
+    struct bucket {
+        uint32_t node;   // nil表示空桶
+        uint32_t tag;
+    };
+
+    // ============================ 私有成员 ============================
+    vector<node> nodes_;          // 节点数组，大小即容量
+    vector<bucket> index_;        // 散列索引
+    vector<uint32_t> free_;       // 被erase释放的节点
+    uint32_t unused_;             // [unused_, capacity) 的节点从未使用过
+    size_type size_;
+    size_type mask_;
+    Hash hash_;
+    KeyEqual equal_;
+    eviction_callback on_evict_;
+
+    // ============================ 私有辅助函数 ============================
+
+    explicit cache_base(size_type capacity, const Hash& hash, const KeyEqual& equal)
+        : unused_(0), size_(0), mask_(0), hash_(hash), equal_(equal) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(capacity == 0, "cache - capacity must be positive");
+        SUGAR_THROW_LENGTH_ERROR_IF(capacity > (size_type(1) << 30), "cache - capacity too large");
+        size_type buckets = 4;
+        while (buckets < capacity * 2) {
+            buckets <<= 1;
+        }
+        mask_ = buckets - 1;
+        nodes_.resize(capacity);
+        bucket empty = {nil, 0};
+        index_.assign(buckets, empty);
+    }
+
+    ~cache_base() {
+        destroy_all();
+    }
+
+    cache_base(const cache_base&) = delete;
+    cache_base& operator=(const cache_base&) = delete;
+
+    uint32_t tag_of(const Key& key) const {
+        return static_cast<uint32_t>(hash_(key));
+    }
+
+    /**
+     * @brief 按键查找节点下标，不存在返回nil
+     */
+    uint32_t lookup(const Key& key, uint32_t tag) const {
+        for (size_type i = tag & mask_;; i = (i + 1) & mask_) {
+            const bucket& b = index_[i];
+            if (b.node == nil) {
+                return nil;
+            }
+            if (b.tag == tag && equal_(nodes_[b.node].key(), key)) {
+                return b.node;
+            }
+        }
+    }
+
+    void index_insert(uint32_t n, uint32_t tag) {
+        size_type i = tag & mask_;
+        while (index_[i].node != nil) {
+            i = (i + 1) & mask_;
+        }
+        index_[i].node = n;
+        index_[i].tag = tag;
+    }
+
+    /**
+     * @brief 从索引中删除节点n：找到它的桶后，把后面探测链上的元素前移填补空洞
+     */
+    void index_erase(uint32_t n) {
+        size_type hole = nodes_[n].tag & mask_;
+        while (index_[hole].node != n) {
+            hole = (hole + 1) & mask_;
+        }
+        for (size_type i = (hole + 1) & mask_; index_[i].node != nil; i = (i + 1) & mask_) {
+            // 元素的理想位置不在 (hole, i] 之间时才能前移到hole
+            const size_type home = index_[i].tag & mask_;
+            if (((i - home) & mask_) >= ((i - hole) & mask_)) {
+                index_[hole] = index_[i];
+                hole = i;
+            }
+        }
+        index_[hole].node = nil;
+    }
+
+    /**
+     * @brief 取一个空闲节点，缓存已满时返回nil
+     */
+    uint32_t acquire() {
+        if (!free_.empty()) {
+            const uint32_t n = free_.back();
+            free_.pop_back();
+            return n;
+        }
+        if (unused_ < nodes_.size()) {
+            return unused_++;
+        }
+        return nil;
+    }
+
+    /**
+     * @brief 在节点n上构造键值并加入索引；构造失败时节点归还空闲链
+     */
+    template<typename K, typename V>
+    void construct(uint32_t n, uint32_t tag, K&& key, V&& value) {
+        node& x = nodes_[n];
+        try {
+            ::new (static_cast<void*>(x.key_buf)) Key(sugar::forward<K>(key));
+        } catch (...) {
+            free_.push_back(n);
+            throw;
+        }
+        try {
+            ::new (static_cast<void*>(x.value_buf)) Value(sugar::forward<V>(value));
+        } catch (...) {
+            x.key().~Key();
+            free_.push_back(n);
+            throw;
+        }
+        x.tag = tag;
+        index_insert(n, tag);
+        ++size_;
+    }
+
+    /**
+     * @brief 把节点n移出索引并析构键值，evicted为真时先调用淘汰回调
+     */
+    void remove(uint32_t n, bool evicted) {
+        node& x = nodes_[n];
+        if (evicted && on_evict_) {
+            on_evict_(x.key(), x.value());
+        }
+        index_erase(n);
+        x.key().~Key();
+        x.value().~Value();
+        --size_;
+    }
+
+    void destroy_all() {
+        for (size_type i = 0; i <= mask_ && size_ > 0; ++i) {
+            if (index_[i].node != nil) {
+                node& x = nodes_[index_[i].node];
+                x.key().~Key();
+                x.value().~Value();
+                index_[i].node = nil;
+                --size_;
+            }
+        }
+        free_.clear();
+        unused_ = 0;
+    }
+
+public:
+    // ============================ 容量 ============================
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_type capacity() const noexcept { return nodes_.size(); }
+
+    bool contains(const Key& key) const {
+        return lookup(key, tag_of(key)) != nil;
+    }
+
+    /**
+     * @brief 不改变替换顺序地查看值
+     * @return 值的指针，键不存在时为nullptr
+     */
+    const Value* peek(const Key& key) const {
+        const uint32_t n = lookup(key, tag_of(key));
+        return n == nil ? nullptr : &nodes_[n].value();
+    }
+
+    /**
+     * @brief 设置淘汰回调：容量已满、插入新键而挤出旧元素时调用，erase和clear不调用
+     */
+    void set_eviction_callback(eviction_callback callback) {
+        on_evict_ = sugar::move(callback);
+    }
+
+    /**
+     * @brief 空间占用（节点数组与索引），用于估计每个元素的内存开销
+     */
+    size_type memory_bytes() const noexcept {
+        return nodes_.size() * sizeof(node) + index_.size() * sizeof(bucket) + free_.capacity() * sizeof(uint32_t);
+    }
+};
+
+// ============================ lru_cache 类模板 ============================
+
+struct lru_link {
+    uint32_t prev;
+    uint32_t next;
+};
+
+/**
+ * @brief lru_cache 类模板，容量固定的最近最少使用缓存
+ *
+ * 节点按使用时间串成下标双向链表，表头最近使用；命中时把节点移到表头，
+ * 缓存已满时淘汰表尾。get / put / erase 都是 O(1)，且不分配内存。
+ *
+ * @tparam Key 键类型
+ * @tparam Value 值类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>
+ * @tparam KeyEqual 键相等比较，默认为sugar::equal_to<Key>
+ */
+template<typename Key, typename Value, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+class lru_cache : public cache_base<Key, Value, Hash, KeyEqual, lru_link> {
+    typedef cache_base<Key, Value, Hash, KeyEqual, lru_link> base;
+    using base::nil;
+    using base::nodes_;
+
+public:
+    using typename base::size_type;
+
+private:
+    // ============================ 私有成员 ============================
+    uint32_t head_;    // 最近使用
+    uint32_t tail_;    // 最久未用
+
+    // ============================ 私有辅助函数 ============================
+
+    void unlink(uint32_t n) {
+        const lru_link l = nodes_[n].link;
+        if (l.prev != nil) {
+            nodes_[l.prev].link.next = l.next;
+        } else {
+            head_ = l.next;
+        }
+        if (l.next != nil) {
+            nodes_[l.next].link.prev = l.prev;
+        } else {
+            tail_ = l.prev;
+        }
+    }
+
+    void push_front(uint32_t n) {
+        nodes_[n].link.prev = nil;
+        nodes_[n].link.next = head_;
+        if (head_ != nil) {
+            nodes_[head_].link.prev = n;
+        } else {
+            tail_ = n;
+        }
+        head_ = n;
+    }
+
+    void touch(uint32_t n) {
+        if (n != head_) {
+            unlink(n);
+            push_front(n);
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param capacity 最多容纳的元素个数
+     */
+    explicit lru_cache(size_type capacity, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : base(capacity, hash, equal), head_(nil), tail_(nil) {}
+
+    // ============================ 访问 ============================
+
+    /**
+     * @brief 查找并标记为最近使用
+     * @return 值的指针，键不存在时为nullptr；指针在下一次修改缓存前有效
+     */
+    Value* get(const Key& key) {
+        const uint32_t n = this->lookup(key, this->tag_of(key));
+        if (n == nil) {
+            return nullptr;
+        }
+        touch(n);
+        return &nodes_[n].value();
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 插入或覆盖，并标记为最近使用；缓存已满时先淘汰最久未用的元素
+     * @return 是否插入了新键
+     */
+    template<typename K, typename V>
+    bool put(K&& key, V&& value) {
+        const uint32_t tag = this->tag_of(key);
+        uint32_t n = this->lookup(key, tag);
+        if (n != nil) {
+            nodes_[n].value() = sugar::forward<V>(value);
+            touch(n);
+            return false;
+        }
+        n = this->acquire();
+        if (n == nil) {
+            n = tail_;
+            unlink(n);
+            this->remove(n, true);
+        }
+        this->construct(n, tag, sugar::forward<K>(key), sugar::forward<V>(value));
+        push_front(n);
+        return true;
+    }
+
+    /**
+     * @brief 删除键
+     * @return 是否删除了元素
+     */
+    bool erase(const Key& key) {
+        const uint32_t n = this->lookup(key, this->tag_of(key));
+        if (n == nil) {
+            return false;
+        }
+        unlink(n);
+        this->remove(n, false);
+        this->free_.push_back(n);
+        return true;
+    }
+
+    void clear() {
+        this->destroy_all();
+        head_ = nil;
+        tail_ = nil;
+    }
+
+    /**
+     * @brief 从最近使用到最久未用依次调用f(键, 值)
+     */
+    template<typename F>
+    void for_each(F f) const {
+        for (uint32_t n = head_; n != nil; n = nodes_[n].link.next) {
+            f(nodes_[n].key(), nodes_[n].value());
+        }
+    }
+};
+
+// ============================ clock_cache 类模板 ============================
+
+struct clock_link {
+    unsigned char referenced;
+};
+
+/**
+ * @brief clock_cache 类模板，CLOCK（二次机会）近似LRU缓存
+ *
+ * 命中时只把节点的引用位置1，不移动任何节点；淘汰时时钟指针在节点数组上循环，
+ * 清掉沿途的引用位，停在第一个引用位为0的节点。命中路径只有一次字节写，
+ * 比LRU的链表摘挂少几次随机访存，在分片加锁时临界区也更短。
+ *
+ * @tparam Key 键类型
+ * @tparam Value 值类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>
+ * @tparam KeyEqual 键相等比较，默认为sugar::equal_to<Key>
+ */
+template<typename Key, typename Value, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+class clock_cache : public cache_base<Key, Value, Hash, KeyEqual, clock_link> {
+    typedef cache_base<Key, Value, Hash, KeyEqual, clock_link> base;
+    using base::nil;
+    using base::nodes_;
+
+public:
+    using typename base::size_type;
+
+private:
+    // ============================ 私有成员 ============================
+    uint32_t hand_;    // 时钟指针
+
+    // ============================ 私有辅助函数 ============================
+
+    /**
+     * @brief 选出被淘汰的节点；只在全部节点都在用时调用
+     */
+    uint32_t sweep() {
+        const uint32_t capacity = static_cast<uint32_t>(nodes_.size());
+        for (;;) {
+            const uint32_t n = hand_;
+            hand_ = hand_ + 1 == capacity ? 0 : hand_ + 1;
+            if (!nodes_[n].link.referenced) {
+                return n;
+            }
+            nodes_[n].link.referenced = 0;
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param capacity 最多容纳的元素个数
+     */
+    explicit clock_cache(size_type capacity, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : base(capacity, hash, equal), hand_(0) {}
+
+    // ============================ 访问 ============================
+
+    /**
+     * @brief 查找并置引用位
+     * @return 值的指针，键不存在时为nullptr；指针在下一次修改缓存前有效
+     */
+    Value* get(const Key& key) {
+        const uint32_t n = this->lookup(key, this->tag_of(key));
+        if (n == nil) {
+            return nullptr;
+        }
+        nodes_[n].link.referenced = 1;
+        return &nodes_[n].value();
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 插入或覆盖；新元素引用位为0，缓存已满时由时钟指针选出淘汰对象
+     * @return 是否插入了新键
+     */
+    template<typename K, typename V>
+    bool put(K&& key, V&& value) {
+        const uint32_t tag = this->tag_of(key);
+        uint32_t n = this->lookup(key, tag);
+        if (n != nil) {
+            nodes_[n].value() = sugar::forward<V>(value);
+            nodes_[n].link.referenced = 1;
+            return false;
+        }
+        n = this->acquire();
+        if (n == nil) {
+            n = sweep();
+            this->remove(n, true);
+        }
+        this->construct(n, tag, sugar::forward<K>(key), sugar::forward<V>(value));
+        nodes_[n].link.referenced = 0;
+        return true;
+    }
+
+    /**
+     * @brief 删除键
+     * @return 是否删除了元素
+     */
+    bool erase(const Key& key) {
+        const uint32_t n = this->lookup(key, this->tag_of(key));
+        if (n == nil) {
+            return false;
+        }
+        this->remove(n, false);
+        this->free_.push_back(n);
+        return true;
+    }
+
+    void clear() {
+        this->destroy_all();
+        hand_ = 0;
+    }
+
+    /**
+     * @brief 按索引顺序对每个元素调用f(键, 值)
+     */
+    template<typename F>
+    void for_each(F f) const {
+        for (size_type i = 0; i <= this->mask_; ++i) {
+            const uint32_t n = this->index_[i].node;
+            if (n != nil) {
+                f(nodes_[n].key(), nodes_[n].value());
+            }
+        }
+    }
+};
+
+// ============================ sharded_cache 类模板 ============================
+
+/**
+ * @brief sharded_cache 类模板，线程安全的分片缓存
+ *
+ * 按键的散列值高位分到若干个独立加锁的Cache上，各分片独立替换，
+ * 整体是全局LRU/CLOCK的近似。读操作把值拷贝出来，不返回指针。
+ *
+ * @tparam Cache lru_cache 或 clock_cache
+ */
+template<typename Cache>
+class sharded_cache {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = typename Cache::key_type;
+    using mapped_type = typename Cache::mapped_type;
+    using hasher = typename Cache::hasher;
+    using size_type = size_t;
+    using eviction_callback = typename Cache::eviction_callback;
+
+private:
+    /**
+     * @brief 分片：按缓存行对齐，避免相邻分片的锁伪共享
+     */
+    struct alignas(64) shard {
+        std::mutex lock;
+        Cache cache;
+
+        explicit shard(size_type capacity) : cache(capacity) {}
+    };
+
+    // ============================ 私有成员 ============================
+    shard* shards_;
+    void* storage_;
+    size_type shard_bits_;
+    size_type shard_count_;
+    hasher hash_;
+
+    // ============================ 私有辅助函数 ============================
+
+    shard& shard_of(const key_type& key) const {
+        const uint64_t h = static_cast<uint64_t>(hash_(key));
+        return shards_[shard_bits_ == 0 ? 0 : static_cast<size_type>(h >> (64 - shard_bits_))];
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param capacity 总容量，平均分给各分片
+     * @param shard_count 分片数，向上取整为2的幂；0表示取硬件并发数的4倍，且每个分片至少容纳64个元素
+     */
+    explicit sharded_cache(size_type capacity, size_type shard_count = 0)
+        : shards_(nullptr), storage_(nullptr), shard_bits_(0), shard_count_(1) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(capacity == 0, "sharded_cache - capacity must be positive");
+        if (shard_count == 0) {
+            const unsigned hw = std::thread::hardware_concurrency();
+            shard_count = 4 * (hw == 0 ? 1 : hw);
+            while (shard_count > 1 && capacity / shard_count < 64) {
+                shard_count >>= 1;
+            }
+        }
+        SUGAR_THROW_LENGTH_ERROR_IF(shard_count > capacity, "sharded_cache - more shards than capacity");
+        while (shard_count_ < shard_count) {
+            shard_count_ <<= 1;
+            ++shard_bits_;
+        }
+        // 向上取整为2的幂后分片数可能超过容量，按实际分片数均分
+        const size_type per_shard = (capacity + shard_count_ - 1) / shard_count_;
+        storage_ = ::operator new(shard_count_ * sizeof(shard) + alignof(shard));
+        shards_ = reinterpret_cast<shard*>((reinterpret_cast<uintptr_t>(storage_) + alignof(shard) - 1) &
+                                           ~static_cast<uintptr_t>(alignof(shard) - 1));
+        size_type built = 0;
+        try {
+            for (; built < shard_count_; ++built) {
+                ::new (static_cast<void*>(shards_ + built)) shard(per_shard);
+            }
+        } catch (...) {
+            while (built > 0) {
+                shards_[--built].~shard();
+            }
+            ::operator delete(storage_);
+            throw;
+        }
+    }
+
+    sharded_cache(const sharded_cache&) = delete;
+    sharded_cache& operator=(const sharded_cache&) = delete;
+
+    ~sharded_cache() {
+        for (size_type i = 0; i < shard_count_; ++i) {
+            shards_[i].~shard();
+        }
+        ::operator delete(storage_);
+    }
+
+    // ============================ 访问 ============================
+
+    /**
+     * @brief 查找，命中时把值拷贝到out并更新替换状态
+     * @return 是否命中
+     */
+    bool get(const key_type& key, mapped_type& out) {
+        shard& s = shard_of(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        const mapped_type* v = s.cache.get(key);
+        if (v == nullptr) {
+            return false;
+        }
+        out = *v;
+        return true;
+    }
+
+    bool contains(const key_type& key) const {
+        shard& s = shard_of(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        return s.cache.contains(key);
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 插入或覆盖，所在分片已满时淘汰该分片中的元素
+     * @return 是否插入了新键
+     */
+    template<typename K, typename V>
+    bool put(K&& key, V&& value) {
+        shard& s = shard_of(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        return s.cache.put(sugar::forward<K>(key), sugar::forward<V>(value));
+    }
+
+    bool erase(const key_type& key) {
+        shard& s = shard_of(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        return s.cache.erase(key);
+    }
+
+    void clear() {
+        for (size_type i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> guard(shards_[i].lock);
+            shards_[i].cache.clear();
+        }
+    }
+
+    /**
+     * @brief 为每个分片设置淘汰回调，回调在分片锁内执行，不应再访问本缓存
+     */
+    void set_eviction_callback(const eviction_callback& callback) {
+        for (size_type i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> guard(shards_[i].lock);
+            shards_[i].cache.set_eviction_callback(callback);
+        }
+    }
+
+    // ============================ 容量 ============================
+
+    /**
+     * @brief 元素个数；并发修改时是近似快照
+     */
+    size_type size() const {
+        size_type n = 0;
+        for (size_type i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> guard(shards_[i].lock);
+            n += shards_[i].cache.size();
+        }
+        return n;
+    }
+
+    size_type capacity() const noexcept {
+        return shard_count_ * shards_[0].cache.capacity();
+    }
+
+    size_type shard_count() const noexcept { return shard_count_; }
+};
+
+template<typename Key, typename Value, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+using concurrent_lru_cache = sharded_cache<lru_cache<Key, Value, Hash, KeyEqual>>;
+
+template<typename Key, typename Value, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+using concurrent_clock_cache = sharded_cache<clock_cache<Key, Value, Hash, KeyEqual>>;
+
+} // namespace sugar
+
+#endif // CACHE_H_
@@ -0,0 +1,563 @@
+/*
+ * @file concurrent_hash_map.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 并发散列表：分片开放寻址 + 分片锁，平凡类型的读操作走seqlock无锁路径，
+ *        扩容在单个分片内增量迁移，不会阻塞其他分片
+ */
+
+#ifndef CONCURRENT_HASH_MAP_H_
+#define CONCURRENT_HASH_MAP_H_
+
+#include "hash.h"
+#include "functional.h"
+#include "vector.h"
+#include "utility.h"
+#include "type_traits.h"
+#include "exceptdef.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace sugar {
+
+// ============================ concurrent_hash_map 类模板 ============================
+
+/**
+ * @brief concurrent_hash_map 类模板，分片的并发散列表
+ *
+ * 键的散列值高位选分片，低位在分片内线性探测。每个分片有自己的互斥锁和序列号，
+ * 写操作持锁并把序列号置为奇数；键和值都是平凡类型时，读操作不加锁，
+ * 先读序列号、再拷贝数据、最后确认序列号未变（seqlock），与写者冲突时重试。
+ * 非平凡类型的读操作改为持锁。
+ *
+ * 分片装载率超过3/4时分配新表，此后该分片的每次写操作顺带把旧表的一段槽位搬到新表，
+ * 读操作依次查新表和旧表。被替换的旧表要等析构时才释放（无锁读者可能仍在访问），
+ * 因为容量按倍数增长，这部分内存不超过当前表的大小。
+ *
+ * @tparam Key 键类型
+ * @tparam T 值类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>
+ * @tparam KeyEqual 键相等比较，默认为sugar::equal_to<Key>
+ */
+template<typename Key, typename T, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+class concurrent_hash_map {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using mapped_type = T;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using size_type = size_t;
+
+    /**
+     * @brief 键和值都是平凡类型时，读操作走无锁的seqlock路径
+     */
+    static constexpr bool lock_free_reads = is_trivial<Key>::value && is_trivial<T>::value;
+
+private:
+    typedef typename conditional<lock_free_reads, true_type, false_type>::type read_tag;
+
+    static const uint64_t empty_hash = 0;        // 空槽
+    static const uint64_t tombstone_hash = 1;    // 已删除
+    static const size_type migrate_batch = 64;   // 每次写操作迁移的旧表槽位数
+    static const size_type min_capacity = 16;
+
+    /**
+     * @brief 槽位：散列值为0表示空、1表示墓碑，其余表示键值已构造
+     */
+    struct slot {
+        uint64_t hash;
+        alignas(Key) unsigned char key_buf[sizeof(Key)];
+        alignas(T) unsigned char value_buf[sizeof(T)];
+
+        Key& key() { return *reinterpret_cast<Key*>(key_buf); }
+        T& value() { return *reinterpret_cast<T*>(value_buf); }
+        const Key& key() const { return *reinterpret_cast<const Key*>(key_buf); }
+        const T& value() const { return *reinterpret_cast<const T*>(value_buf); }
+    };
+
+    struct table {
+        size_type mask;
+        slot* slots;
+
+        explicit table(size_type capacity) : mask(capacity - 1), slots(new slot[capacity]()) {}
+        ~table() { delete[] slots; }
+        size_type capacity() const { return mask + 1; }
+    };
+
+    /**
+     * @brief 分片：写者持lock修改，seq为奇数表示写入进行中。按缓存行填充，避免相邻分片伪共享
+     */
+    struct shard {
+        std::atomic<uint64_t> seq;
+        std::atomic<table*> cur;       // 当前表，新元素只写入这里
+        std::atomic<table*> old;       // 迁移中的旧表，没有迁移时为空
+        std::atomic<size_type> count;  // 元素个数（两张表合计）
+        size_type used;                // 当前表中满槽与墓碑之和
+        size_type migrate_pos;         // 旧表中下一个待迁移的槽位
+        std::mutex lock;
+        vector<table*> retired;        // 已替换下来的表，析构时释放
+        char pad[64];
+
+        shard() : seq(0), cur(nullptr), old(nullptr), count(0), used(0), migrate_pos(0) {}
+    };
+
+    // ============================ 私有成员 ============================
+    shard* shards_;
+    size_type shard_bits_;
+    size_type shard_count_;
+    Hash hash_;
+    KeyEqual equal_;
+
+    // ============================ 私有辅助函数 ============================
+
+    uint64_t hash_of(const Key& key) const {
+        uint64_t h = static_cast<uint64_t>(hash_(key));
+        return h < 2 ? h + 2 : h;
+    }
+
+    shard& shard_of(uint64_t h) const {
+        return shards_[shard_bits_ == 0 ? 0 : static_cast<size_type>(h >> (64 - shard_bits_))];
+    }
+
+    static size_type round_up_pow2(size_type n) {
+        size_type cap = 1;
+        while (cap < n) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    /**
+     * @brief 在表中查找键，返回槽位或nullptr；探测次数不超过容量，读者看到写到一半的表也能结束
+     */
+    slot* probe(table* t, const Key& key, uint64_t h) const {
+        size_type i = static_cast<size_type>(h) & t->mask;
+        for (size_type step = 0; step <= t->mask; ++step, i = (i + 1) & t->mask) {
+            slot& s = t->slots[i];
+            if (s.hash == empty_hash) {
+                return nullptr;
+            }
+            if (s.hash == h && equal_(s.key(), key)) {
+                return &s;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 为确定不存在的键找一个可写入的槽位（优先复用墓碑）
+     */
+    static slot* insert_slot(table* t, uint64_t h, size_type& used) {
+        size_type i = static_cast<size_type>(h) & t->mask;
+        while (t->slots[i].hash > tombstone_hash) {
+            i = (i + 1) & t->mask;
+        }
+        if (t->slots[i].hash == empty_hash) {
+            ++used;
+        }
+        return &t->slots[i];
+    }
+
+    static void destroy_slot(slot& s) {
+        s.key().~Key();
+        s.value().~T();
+    }
+
+    void write_begin(shard& s) {
+        s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void write_end(shard& s) {
+        s.seq.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 把旧表的一个槽位搬到当前表
+     */
+    void migrate_slot(shard& s, slot& from) {
+        if (from.hash > tombstone_hash) {
+            slot* to = insert_slot(s.cur.load(std::memory_order_relaxed), from.hash, s.used);
+            ::new (static_cast<void*>(to->key_buf)) Key(sugar::move(from.key()));
+            ::new (static_cast<void*>(to->value_buf)) T(sugar::move(from.value()));
+            to->hash = from.hash;
+            destroy_slot(from);
+            from.hash = tombstone_hash;
+        }
+    }
+
+    /**
+     * @brief 迁移最多limit个旧表槽位，旧表搬空后退役
+     */
+    void migrate_step(shard& s, size_type limit) {
+        table* o = s.old.load(std::memory_order_relaxed);
+        if (o == nullptr) {
+            return;
+        }
+        const size_type end = limit >= o->capacity() - s.migrate_pos ? o->capacity() : s.migrate_pos + limit;
+        for (; s.migrate_pos < end; ++s.migrate_pos) {
+            migrate_slot(s, o->slots[s.migrate_pos]);
+        }
+        if (s.migrate_pos == o->capacity()) {
+            s.old.store(nullptr, std::memory_order_relaxed);
+            s.retired.push_back(o);
+        }
+    }
+
+    /**
+     * @brief 当前表将超过3/4装载时换新表：元素多则容量翻倍，墓碑多则同容量重建
+     */
+    void maybe_grow(shard& s) {
+        table* c = s.cur.load(std::memory_order_relaxed);
+        if ((s.used + 1) * 4 <= c->capacity() * 3) {
+            return;
+        }
+        // 上一轮迁移还没完成：先搬完，保证任何时刻最多两张表
+        migrate_step(s, ~size_type(0));
+        const size_type live = s.count.load(std::memory_order_relaxed);
+        const size_type new_capacity = live * 2 >= c->capacity() ? c->capacity() * 2 : c->capacity();
+        table* fresh = new table(new_capacity);
+        s.old.store(c, std::memory_order_relaxed);
+        s.cur.store(fresh, std::memory_order_relaxed);
+        s.used = 0;
+        s.migrate_pos = 0;
+    }
+
+    /**
+     * @brief 写者查找键：若还在旧表中，先把它搬到当前表，保证每个键只在一张表中
+     */
+    slot* locate_for_write(shard& s, const Key& key, uint64_t h) {
+        slot* found = probe(s.cur.load(std::memory_order_relaxed), key, h);
+        if (found != nullptr) {
+            return found;
+        }
+        table* o = s.old.load(std::memory_order_relaxed);
+        if (o != nullptr) {
+            slot* in_old = probe(o, key, h);
+            if (in_old != nullptr) {
+                migrate_slot(s, *in_old);
+                return probe(s.cur.load(std::memory_order_relaxed), key, h);
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 写操作的公共框架：加锁、进入写区间、顺带迁移，再执行op
+     */
+    template<typename Op>
+    auto write(const Key& key, Op op) -> decltype(op(static_cast<shard*>(nullptr), static_cast<slot*>(nullptr), uint64_t(0))) {
+        const uint64_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> guard(s.lock);
+        write_begin(s);
+        struct end_guard {
+            concurrent_hash_map* self;
+            shard& s;
+            ~end_guard() { self->write_end(s); }
+        } ender = {this, s};
+        migrate_step(s, migrate_batch);
+        slot* found = locate_for_write(s, key, h);
+        return op(&s, found, h);
+    }
+
+    /**
+     * @brief 在当前表中为新键构造槽位
+     */
+    template<typename V>
+    void emplace_new(shard& s, const Key& key, uint64_t h, V&& value) {
+        maybe_grow(s);
+        const size_type used_before = s.used;
+        slot* to = insert_slot(s.cur.load(std::memory_order_relaxed), h, s.used);
+        // 槽位的hash在键值都构造成功后才写入，构造失败时槽位仍是空位或墓碑，只需回退used
+        bool key_built = false;
+        try {
+            ::new (static_cast<void*>(to->key_buf)) Key(key);
+            key_built = true;
+            ::new (static_cast<void*>(to->value_buf)) T(sugar::forward<V>(value));
+        } catch (...) {
+            if (key_built) {
+                to->key().~Key();
+            }
+            s.used = used_before;
+            throw;
+        }
+        to->hash = h;
+        s.count.store(s.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // 无锁读：seqlock乐观读取，冲突时重试
+    bool find_impl(const Key& key, T* out, true_type) const {
+        const uint64_t h = hash_of(key);
+        shard& s = shard_of(h);
+        alignas(T) unsigned char buf[sizeof(T)] = {};
+        for (;;) {
+            const uint64_t before = s.seq.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            bool found = false;
+            slot* hit = probe(s.cur.load(std::memory_order_relaxed), key, h);
+            if (hit == nullptr) {
+                table* o = s.old.load(std::memory_order_relaxed);
+                if (o != nullptr) {
+                    hit = probe(o, key, h);
+                }
+            }
+            if (hit != nullptr) {
+                found = true;
+                if (out != nullptr) {
+                    std::memcpy(buf, hit->value_buf, sizeof(T));
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) == before) {
+                if (found && out != nullptr) {
+                    std::memcpy(static_cast<void*>(out), buf, sizeof(T));
+                }
+                return found;
+            }
+        }
+    }
+
+    // 加锁读
+    bool find_impl(const Key& key, T* out, false_type) const {
+        const uint64_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> guard(s.lock);
+        slot* hit = probe(s.cur.load(std::memory_order_relaxed), key, h);
+        table* o = s.old.load(std::memory_order_relaxed);
+        if (hit == nullptr && o != nullptr) {
+            hit = probe(o, key, h);
+        }
+        if (hit != nullptr && out != nullptr) {
+            *out = hit->value();
+        }
+        return hit != nullptr;
+    }
+
+    static void destroy_table(table* t) {
+        for (size_type i = 0; i <= t->mask; ++i) {
+            if (t->slots[i].hash > tombstone_hash) {
+                destroy_slot(t->slots[i]);
+            }
+        }
+        delete t;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param shard_count 分片数，向上取整为2的幂；0表示取硬件并发数的8倍（至少16）
+     * @param initial_capacity 预计的元素个数，平均分给各分片
+     * @param hash 散列函数
+     * @param equal 键相等比较
+     */
+    explicit concurrent_hash_map(size_type shard_count = 0, size_type initial_capacity = 0,
+                                 const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : shards_(nullptr), shard_bits_(0), shard_count_(0), hash_(hash), equal_(equal) {
+        if (shard_count == 0) {
+            shard_count = 8 * (std::thread::hardware_concurrency() == 0 ? 1 : std::thread::hardware_concurrency());
+            if (shard_count < 16) {
+                shard_count = 16;
+            }
+        }
+        SUGAR_THROW_LENGTH_ERROR_IF(shard_count > (size_type(1) << 16), "concurrent_hash_map - too many shards");
+        shard_count_ = round_up_pow2(shard_count);
+        while ((size_type(1) << shard_bits_) < shard_count_) {
+            ++shard_bits_;
+        }
+        size_type per_shard = round_up_pow2((initial_capacity / shard_count_ + 1) * 4 / 3 + 1);
+        if (per_shard < min_capacity) {
+            per_shard = min_capacity;
+        }
+        shards_ = new shard[shard_count_];
+        for (size_type i = 0; i < shard_count_; ++i) {
+            shards_[i].cur.store(new table(per_shard), std::memory_order_relaxed);
+        }
+    }
+
+    concurrent_hash_map(const concurrent_hash_map&) = delete;
+    concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+    ~concurrent_hash_map() {
+        for (size_type i = 0; i < shard_count_; ++i) {
+            shard& s = shards_[i];
+            destroy_table(s.cur.load(std::memory_order_relaxed));
+            if (s.old.load(std::memory_order_relaxed) != nullptr) {
+                destroy_table(s.old.load(std::memory_order_relaxed));
+            }
+            for (size_type j = 0; j < s.retired.size(); ++j) {
+                delete s.retired[j];
+            }
+        }
+        delete[] shards_;
+    }
+
+    // ============================ 查找 ============================
+
+    /**
+     * @brief 查找键，找到时把值拷贝到out
+     * @return 是否找到
+     */
+    bool find(const Key& key, T& out) const {
+        return find_impl(key, &out, read_tag());
+    }
+
+    bool contains(const Key& key) const {
+        return find_impl(key, nullptr, read_tag());
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 键不存在时插入
+     * @return 是否插入了新元素
+     */
+    bool insert(const Key& key, const T& value) {
+        return write(key, [&](shard* s, slot* found, uint64_t h) -> bool {
+            if (found != nullptr) {
+                return false;
+            }
+            emplace_new(*s, key, h, value);
+            return true;
+        });
+    }
+
+    /**
+     * @brief 键存在时覆盖值，否则插入，整个过程对其他线程是原子的
+     * @return 是否插入了新元素
+     */
+    bool insert_or_assign(const Key& key, const T& value) {
+        return write(key, [&](shard* s, slot* found, uint64_t h) -> bool {
+            if (found != nullptr) {
+                found->value() = value;
+                return false;
+            }
+            emplace_new(*s, key, h, value);
+            return true;
+        });
+    }
+
+    /**
+     * @brief 原子地读-改-写：键不存在时先插入T()，再在分片锁内调用f(值)
+     * @param key 键
+     * @param f 形如 void(T&) 的函数，不应再访问本表
+     * @return 调用f之后的值
+     */
+    template<typename F>
+    T compute(const Key& key, F f) {
+        return write(key, [&](shard* s, slot* found, uint64_t h) -> T {
+            if (found == nullptr) {
+                emplace_new(*s, key, h, T());
+                found = probe(s->cur.load(std::memory_order_relaxed), key, h);
+            }
+            f(found->value());
+            return found->value();
+        });
+    }
+
+    /**
+     * @brief 只在键存在时原子地调用f(值)
+     * @return 键是否存在
+     */
+    template<typename F>
+    bool update(const Key& key, F f) {
+        return write(key, [&](shard*, slot* found, uint64_t) -> bool {
+            if (found == nullptr) {
+                return false;
+            }
+            f(found->value());
+            return true;
+        });
+    }
+
+    /**
+     * @brief 删除键
+     * @return 是否删除了元素
+     */
+    bool erase(const Key& key) {
+        return write(key, [&](shard* s, slot* found, uint64_t) -> bool {
+            if (found == nullptr) {
+                return false;
+            }
+            destroy_slot(*found);
+            found->hash = tombstone_hash;
+            s->count.store(s->count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            return true;
+        });
+    }
+
+    /**
+     * @brief 清空全部元素（逐分片加锁，不释放表）
+     */
+    void clear() {
+        for (size_type i = 0; i < shard_count_; ++i) {
+            shard& s = shards_[i];
+            std::lock_guard<std::mutex> guard(s.lock);
+            write_begin(s);
+            migrate_step(s, ~size_type(0));
+            table* c = s.cur.load(std::memory_order_relaxed);
+            for (size_type j = 0; j <= c->mask; ++j) {
+                if (c->slots[j].hash > tombstone_hash) {
+                    destroy_slot(c->slots[j]);
+                }
+                c->slots[j].hash = empty_hash;
+            }
+            s.used = 0;
+            s.count.store(0, std::memory_order_relaxed);
+            write_end(s);
+        }
+    }
+
+    // ============================ 容量与遍历 ============================
+
+    /**
+     * @brief 元素个数；并发修改时是各分片计数的近似快照
+     */
+    size_type size() const noexcept {
+        size_type n = 0;
+        for (size_type i = 0; i < shard_count_; ++i) {
+            n += shards_[i].count.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+    size_type shard_count() const noexcept { return shard_count_; }
+
+    /**
+     * @brief 逐分片加锁遍历，对每个元素调用f(键, 值)
+     */
+    template<typename F>
+    void for_each(F f) const {
+        for (size_type i = 0; i < shard_count_; ++i) {
+            shard& s = shards_[i];
+            std::lock_guard<std::mutex> guard(s.lock);
+            table* tables[2] = {s.cur.load(std::memory_order_relaxed), s.old.load(std::memory_order_relaxed)};
+            for (table* t : tables) {
+                if (t == nullptr) {
+                    continue;
+                }
+                for (size_type j = 0; j <= t->mask; ++j) {
+                    if (t->slots[j].hash > tombstone_hash) {
+                        f(static_cast<const Key&>(t->slots[j].key()), static_cast<const T&>(t->slots[j].value()));
+                    }
+                }
+            }
+        }
+    }
+};
+
+} // namespace sugar
+
+#endif // CONCURRENT_HASH_MAP_H_
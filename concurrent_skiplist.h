@@ -0,0 +1,404 @@
+/*
+ * @file concurrent_skiplist.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 并发跳表：CAS逐层链接的无锁插入，读操作不加锁也不重试，
+ *        节点从每个跳表自己的无锁bump arena分配，适合只增不删的内存写缓冲
+ */
+
+#ifndef CONCURRENT_SKIPLIST_H_
+#define CONCURRENT_SKIPLIST_H_
+
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "random.h"
+#include "utility.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace sugar {
+
+// ============================ skiplist_arena 类 ============================
+
+/**
+ * @brief skiplist_arena 类，多线程共享的bump分配器
+ *
+ * 当前块的偏移用fetch_add推进，块用完时各线程各自申请新块，CAS安装成功者胜出，
+ * 失败者归还自己的块后重试，整个过程不加锁。大于块大小1/4的请求单独成块，不占用当前块。
+ * 内存只在析构时整体归还。
+ */
+class skiplist_arena {
+private:
+    struct block {
+        block* next;
+        size_t capacity;
+        std::atomic<size_t> used;
+        size_t pad;  // 让数据区按16字节对齐
+
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    static const size_t default_block_size = 64 * 1024;
+
+    std::atomic<block*> current_;   // 正在切分的块，其next串起此前所有的普通块
+    std::atomic<block*> large_;     // 单独分配的大块
+    std::atomic<size_t> bytes_;
+
+    block* new_block(size_t capacity, size_t used) {
+        block* b = static_cast<block*>(sugar::allocate(sizeof(block) + capacity));
+        b->next = nullptr;
+        b->capacity = capacity;
+        ::new (&b->used) std::atomic<size_t>(used);
+        bytes_.fetch_add(sizeof(block) + capacity, std::memory_order_relaxed);
+        return b;
+    }
+
+    void free_block(block* b) noexcept {
+        sugar::deallocate(b, sizeof(block) + b->capacity);
+    }
+
+    void free_chain(block* b) noexcept {
+        while (b != nullptr) {
+            block* next = b->next;
+            free_block(b);
+            b = next;
+        }
+    }
+
+public:
+    skiplist_arena() : current_(nullptr), large_(nullptr), bytes_(0) {}
+
+    skiplist_arena(const skiplist_arena&) = delete;
+    skiplist_arena& operator=(const skiplist_arena&) = delete;
+
+    ~skiplist_arena() {
+        free_chain(current_.load(std::memory_order_relaxed));
+        free_chain(large_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 分配size字节，按16字节对齐；可由多个线程同时调用
+     */
+    void* allocate(size_t size) {
+        size = (size + 15) & ~size_t(15);
+        if (size > default_block_size / 4) {
+            block* b = new_block(size, size);
+            b->next = large_.load(std::memory_order_relaxed);
+            while (!large_.compare_exchange_weak(b->next, b, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+            return b->data();
+        }
+        block* b = current_.load(std::memory_order_acquire);
+        for (;;) {
+            if (b != nullptr) {
+                const size_t offset = b->used.fetch_add(size, std::memory_order_relaxed);
+                if (offset + size <= b->capacity) {
+                    return b->data() + offset;
+                }
+            }
+            // 当前块用完：新块预留出本次请求，CAS失败说明别的线程已换块，归还后在新块上重试
+            block* fresh = new_block(default_block_size, size);
+            fresh->next = b;
+            if (current_.compare_exchange_strong(b, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return fresh->data();
+            }
+            bytes_.fetch_sub(sizeof(block) + default_block_size, std::memory_order_relaxed);
+            free_block(fresh);
+        }
+    }
+
+    /**
+     * @brief 已向系统申请的字节数
+     */
+    size_t memory_bytes() const noexcept { return bytes_.load(std::memory_order_relaxed); }
+};
+
+// ============================ concurrent_skiplist 类模板 ============================
+
+/**
+ * @brief concurrent_skiplist 类模板，支持多线程并发插入与有序读取的跳表
+ *
+ * 插入先自顶向下为每一层找到前驱与后继（splice），再从第0层开始逐层用CAS把新节点
+ * 接到前驱后面；CAS失败说明有并发插入落在同一位置，只从该层的前驱重新向后查找，
+ * 不需要从头开始。第0层链接成功即对读者可见，高层链接只影响查找速度。
+ * 读操作只做acquire加载，既不加锁也不重试，遍历过程中并发插入的节点可能看到也可能看不到。
+ *
+ * 节点不可删除，值在插入后不可修改（迭代器只提供const访问），
+ * 这正是内存写缓冲的用法：写满后整体冻结、有序导出、随跳表一起释放。
+ * 所有节点都从跳表自己的arena切分，析构时只需逐个调用值的析构函数再整体归还内存。
+ *
+ * @tparam Key 键类型
+ * @tparam T 值类型
+ * @tparam Compare 键的严格弱序，默认为sugar::less<Key>
+ */
+template<typename Key, typename T, typename Compare = less<Key>>
+class concurrent_skiplist {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = pair<const Key, T>;
+    using key_compare = Compare;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    /**
+     * @brief 塔的最大高度，每层晋升概率1/4，足以支撑千万级元素
+     */
+    static const int max_height = 12;
+
+private:
+    struct node {
+        alignas(value_type) unsigned char storage[sizeof(value_type)];
+        std::atomic<node*> next[1];  // 实际长度为塔高，随节点一起从arena分配
+
+        value_type& value() noexcept { return *reinterpret_cast<value_type*>(storage); }
+        const Key& key() const noexcept { return reinterpret_cast<const value_type*>(storage)->first; }
+
+        node* load_next(int level) const noexcept { return next[level].load(std::memory_order_acquire); }
+    };
+
+public:
+    // ============================ 迭代器 ============================
+
+    /**
+     * @brief const_iterator 类，沿第0层前进的只读前向迭代器
+     */
+    class const_iterator {
+        friend class concurrent_skiplist;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = typename concurrent_skiplist::value_type;
+        using difference_type = ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+    private:
+        node* node_;
+
+        explicit const_iterator(node* n) : node_(n) {}
+
+    public:
+        const_iterator() : node_(nullptr) {}
+
+        reference operator*() const { return node_->value(); }
+        pointer operator->() const { return &node_->value(); }
+
+        const_iterator& operator++() {
+            node_ = node_->load_next(0);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            node_ = node_->load_next(0);
+            return tmp;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.node_ == b.node_; }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a.node_ != b.node_; }
+    };
+
+    using iterator = const_iterator;
+
+private:
+    // ============================ 私有成员 ============================
+    skiplist_arena arena_;
+    node* head_;
+    std::atomic<int> height_;       // 当前最高的塔高
+    std::atomic<size_type> size_;
+    Compare comp_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static size_t node_bytes(int height) noexcept {
+        return sizeof(node) + sizeof(std::atomic<node*>) * static_cast<size_t>(height - 1);
+    }
+
+    node* allocate_node(int height) {
+        node* n = static_cast<node*>(arena_.allocate(node_bytes(height)));
+        for (int i = 0; i < height; ++i) {
+            ::new (&n->next[i]) std::atomic<node*>(nullptr);
+        }
+        return n;
+    }
+
+    /**
+     * @brief 随机塔高：每层以1/4的概率继续晋升。状态按线程保存，插入路径上没有共享写
+     */
+    static int random_height() noexcept {
+        static thread_local uint64_t state = reinterpret_cast<uintptr_t>(&state) * 0x9e3779b97f4a7c15ull;
+        uint64_t bits = splitmix64(state);
+        int height = 1;
+        while (height < max_height && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    bool before(const node* n, const Key& key) const { return n != nullptr && comp_(n->key(), key); }
+
+    /**
+     * @brief 从start出发在第level层查找：*prev为最后一个键小于key的节点，*next为其后继。
+     *        bound是上一层找到的后继，走到它时不必再比较（它的键不小于key），省掉一次访存
+     */
+    void find_splice(const Key& key, node* start, int level, node* bound, node** prev, node** next) const {
+        node* p = start;
+        node* n = p->load_next(level);
+        while (n != bound && before(n, key)) {
+            p = n;
+            n = p->load_next(level);
+        }
+        *prev = p;
+        *next = n;
+    }
+
+    /**
+     * @brief 第一个键不小于key的节点
+     */
+    node* find_greater_or_equal(const Key& key) const {
+        node* p = head_;
+        node* n = nullptr;
+        for (int level = height_.load(std::memory_order_acquire) - 1; level >= 0; --level) {
+            find_splice(key, p, level, n, &p, &n);
+        }
+        return n;
+    }
+
+    bool equal(const node* n, const Key& key) const { return n != nullptr && !comp_(key, n->key()); }
+
+    /**
+     * @brief 定位key的splice，键不存在时分配节点、用args构造值并逐层链接；返回节点与是否新插入
+     */
+    template<typename... Args>
+    pair<node*, bool> insert_impl(const Key& key, Args&&... args) {
+        node* prev[max_height];
+        node* next[max_height];
+        const int height = random_height();
+        int top = height_.load(std::memory_order_acquire);
+        while (top < height && !height_.compare_exchange_weak(top, height, std::memory_order_acq_rel)) {
+        }
+        // 自顶向下定位每一层的splice，高于原塔高的层从头节点开始
+        node* p = head_;
+        node* bound = nullptr;
+        for (int level = (top > height ? top : height) - 1; level >= 0; --level) {
+            find_splice(key, p, level, bound, &prev[level], &next[level]);
+            p = prev[level];
+            bound = next[level];
+        }
+        if (equal(next[0], key)) {
+            return pair<node*, bool>(next[0], false);
+        }
+        node* x = allocate_node(height);
+        ::new (x->storage) value_type(key, T(sugar::forward<Args>(args)...));
+        for (int level = 0; level < height; ++level) {
+            for (;;) {
+                x->next[level].store(next[level], std::memory_order_relaxed);
+                if (prev[level]->next[level].compare_exchange_strong(next[level], x, std::memory_order_release,
+                                                                      std::memory_order_acquire)) {
+                    break;
+                }
+                // 同一位置有并发插入：从原前驱向后重新定位
+                find_splice(key, prev[level], level, nullptr, &prev[level], &next[level]);
+                if (level == 0 && equal(next[0], key)) {
+                    x->value().~value_type();
+                    return pair<node*, bool>(next[0], false);
+                }
+            }
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return pair<node*, bool>(x, true);
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造空跳表
+     */
+    explicit concurrent_skiplist(const Compare& comp = Compare())
+        : head_(nullptr), height_(1), size_(0), comp_(comp) {
+        head_ = allocate_node(max_height);
+    }
+
+    concurrent_skiplist(const concurrent_skiplist&) = delete;
+    concurrent_skiplist& operator=(const concurrent_skiplist&) = delete;
+
+    /**
+     * @brief 析构函数，不可与其他操作并发
+     */
+    ~concurrent_skiplist() {
+        node* n = head_->load_next(0);
+        while (n != nullptr) {
+            node* next = n->load_next(0);
+            n->value().~value_type();
+            n = next;
+        }
+    }
+
+    // ============================ 迭代器 ============================
+
+    const_iterator begin() const noexcept { return const_iterator(head_->load_next(0)); }
+    const_iterator end() const noexcept { return const_iterator(nullptr); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // ============================ 容量 ============================
+
+    /**
+     * @brief 元素个数；有并发插入时是某一时刻的近似值
+     */
+    size_type size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief arena已申请的字节数
+     */
+    size_type memory_bytes() const noexcept { return arena_.memory_bytes(); }
+
+    // ============================ 查找 ============================
+
+    const_iterator find(const Key& key) const {
+        node* n = find_greater_or_equal(key);
+        return const_iterator(equal(n, key) ? n : nullptr);
+    }
+
+    bool contains(const Key& key) const { return equal(find_greater_or_equal(key), key); }
+
+    /**
+     * @brief 第一个键不小于key的元素
+     */
+    const_iterator lower_bound(const Key& key) const { return const_iterator(find_greater_or_equal(key)); }
+
+    /**
+     * @brief 第一个键大于key的元素
+     */
+    const_iterator upper_bound(const Key& key) const {
+        node* n = find_greater_or_equal(key);
+        return const_iterator(equal(n, key) ? n->load_next(0) : n);
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 键不存在时用args构造值插入，存在时什么也不做；可由多个线程同时调用
+     *
+     * 并发插入同一个键时只有一个成功，失败者构造的值被析构，其节点内存留在arena中直到跳表析构。
+     */
+    template<typename... Args>
+    pair<const_iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        pair<node*, bool> r = insert_impl(key, sugar::forward<Args>(args)...);
+        return pair<const_iterator, bool>(const_iterator(r.first), r.second);
+    }
+
+    pair<const_iterator, bool> insert(const Key& key, const T& value) { return try_emplace(key, value); }
+};
+
+} // namespace sugar
+
+#endif // CONCURRENT_SKIPLIST_H_
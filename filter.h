@@ -0,0 +1,924 @@
+/*
+ * @file filter.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 近似成员过滤器：分块布隆过滤器、支持删除的布谷鸟过滤器和面向静态集合的 binary fuse 过滤器，
+ *        只会误报、不会漏报，用于在昂贵的查找之前做廉价的否定判断
+ */
+
+#ifndef FILTER_H_
+#define FILTER_H_
+
+#include "algorithm.h"
+#include "hash.h"
+#include "random.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace sugar {
+
+// ============================ 序列化工具 ============================
+
+// 序列化统一使用小端字节序，与平台无关
+
+inline void filter_store32(unsigned char* p, uint32_t v) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline void filter_store64(unsigned char* p, uint64_t v) noexcept {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline uint32_t filter_load32(const unsigned char* p) noexcept {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t filter_load64(const unsigned char* p) noexcept {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/**
+ * @brief 把32位散列值均匀映射到[0, n)，用乘法代替取模
+ */
+inline uint32_t filter_reduce(uint32_t hash, uint32_t n) noexcept {
+    return static_cast<uint32_t>((uint64_t(hash) * n) >> 32);
+}
+
+#if SUGAR_HAS_SSE2
+/**
+ * @brief 4路32位乘法取低32位（SSE4.1的_mm_mullo_epi32在SSE2下的替代）
+ */
+inline __m128i filter_mullo_epi32(__m128i a, __m128i b) {
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * @brief 4路 1 << x（x在[0, 31]）：SSE2没有逐路可变移位，借浮点指数构造2^x再截断回整数；
+ *        x = 31 时截断溢出得到0x80000000，恰好就是 1 << 31
+ */
+inline __m128i filter_pow2_epi32(__m128i x) {
+    const __m128i exponent = _mm_slli_epi32(_mm_add_epi32(x, _mm_set1_epi32(127)), 23);
+    return _mm_cvttps_epi32(_mm_castsi128_ps(exponent));
+}
+#endif
+
+// ============================ bloom_filter 类 ============================
+
+/**
+ * @brief bloom_filter 类，分块布隆过滤器（split block）
+ *
+ * 位数组划分为32字节的块，块按64字节对齐，一次查询只访问一个块、一条缓存行。
+ * 键的散列值高位选块，低32位与8个奇数常量相乘后取高5位，在块内8个32位字中各置一位；
+ * SSE2下8个掩码用两条向量指令并行生成，查询只需一次 andnot 加比较。
+ * 每键10位时误报率约1%，16位约0.1%。
+ *
+ * @tparam Key 键类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>，要求输出的高低位都充分混合
+ */
+template<typename Key, typename Hash = hash<Key>>
+class bloom_filter {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using hasher = Hash;
+    using size_type = size_t;
+
+private:
+    static const uint32_t format_magic = 0x314c4253;   // "SBL1"
+    static const size_type block_words = 8;
+    static const size_type header_bytes = 24;
+
+    // ============================ 私有成员 ============================
+    void* raw_;            // ::operator new 返回的原始指针
+    uint32_t* blocks_;     // 按64字节对齐后的位数组
+    size_type block_count_;
+    size_type count_;
+    Hash hash_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static const uint32_t* salts() noexcept {
+        alignas(16) static const uint32_t values[block_words] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                                                                 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+        return values;
+    }
+
+    static size_type blocks_for(size_type keys, double bits_per_key) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(!(bits_per_key > 0), "bloom_filter - bits_per_key must be positive");
+        const double bits = static_cast<double>(keys) * bits_per_key;
+        const size_type blocks = static_cast<size_type>(std::ceil(bits / (32 * block_words)));
+        return blocks == 0 ? 1 : blocks;
+    }
+
+    void allocate(size_type blocks) {
+        const size_type bytes = blocks * block_words * sizeof(uint32_t);
+        raw_ = ::operator new(bytes + 63);
+        blocks_ = reinterpret_cast<uint32_t*>((reinterpret_cast<uintptr_t>(raw_) + 63) & ~uintptr_t(63));
+        block_count_ = blocks;
+    }
+
+    const uint32_t* block_of(uint64_t h) const noexcept {
+        uint64_t hi;
+        sugar::mul128(h, block_count_, hi);
+        return blocks_ + hi * block_words;
+    }
+
+    uint32_t* block_of(uint64_t h) noexcept {
+        return const_cast<uint32_t*>(static_cast<const bloom_filter*>(this)->block_of(h));
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 为expected_keys个键分配空间
+     * @param expected_keys 预计插入的键数
+     * @param bits_per_key 每个键分摊的位数，决定误报率
+     */
+    explicit bloom_filter(size_type expected_keys = 0, double bits_per_key = 10.0, const Hash& hash = Hash())
+        : raw_(nullptr), blocks_(nullptr), block_count_(0), count_(0), hash_(hash) {
+        allocate(blocks_for(expected_keys, bits_per_key));
+        clear();
+    }
+
+    /**
+     * @brief 从一组键构造
+     */
+    explicit bloom_filter(const vector<Key>& keys, double bits_per_key = 10.0, const Hash& hash = Hash())
+        : bloom_filter(keys.size(), bits_per_key, hash) {
+        for (size_type i = 0; i < keys.size(); ++i) {
+            insert(keys[i]);
+        }
+    }
+
+    bloom_filter(const bloom_filter& other)
+        : raw_(nullptr), blocks_(nullptr), block_count_(0), count_(other.count_), hash_(other.hash_) {
+        allocate(other.block_count_);
+        std::memcpy(blocks_, other.blocks_, block_count_ * block_words * sizeof(uint32_t));
+    }
+
+    bloom_filter(bloom_filter&& other) noexcept
+        : raw_(other.raw_), blocks_(other.blocks_), block_count_(other.block_count_), count_(other.count_),
+          hash_(other.hash_) {
+        other.raw_ = nullptr;
+        other.blocks_ = nullptr;
+        other.block_count_ = 0;
+        other.count_ = 0;
+    }
+
+    bloom_filter& operator=(bloom_filter other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~bloom_filter() { ::operator delete(raw_); }
+
+    // ============================ 容量 ============================
+
+    /**
+     * @brief 插入过的键数（重复插入也计数）
+     */
+    size_type size() const noexcept { return count_; }
+    size_type block_count() const noexcept { return block_count_; }
+
+    /**
+     * @brief 位数组占用的字节数
+     */
+    size_type memory_bytes() const noexcept { return block_count_ * block_words * sizeof(uint32_t); }
+
+    double bits_per_key() const noexcept {
+        return count_ == 0 ? 0.0 : 8.0 * memory_bytes() / count_;
+    }
+
+    // ============================ 查找 ============================
+
+    /**
+     * @brief 键可能在集合中时返回true；返回false时键一定不在
+     */
+    bool contains(const Key& key) const {
+        const uint64_t h = static_cast<uint64_t>(hash_(key));
+        const uint32_t* block = block_of(h);
+#if SUGAR_HAS_SSE2
+        const __m128i k = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(h)));
+        const __m128i* s = reinterpret_cast<const __m128i*>(salts());
+        const __m128i* b = reinterpret_cast<const __m128i*>(block);
+        const __m128i m0 = sugar::filter_pow2_epi32(_mm_srli_epi32(sugar::filter_mullo_epi32(k, _mm_load_si128(s)), 27));
+        const __m128i m1 = sugar::filter_pow2_epi32(_mm_srli_epi32(sugar::filter_mullo_epi32(k, _mm_load_si128(s + 1)), 27));
+        const __m128i miss = _mm_or_si128(_mm_andnot_si128(_mm_load_si128(b), m0), _mm_andnot_si128(_mm_load_si128(b + 1), m1));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(miss, _mm_setzero_si128())) == 0xffff;
+#else
+        const uint32_t low = static_cast<uint32_t>(h);
+        for (size_type i = 0; i < block_words; ++i) {
+            if (((block[i] >> ((low * salts()[i]) >> 27)) & 1) == 0) {
+                return false;
+            }
+        }
+        return true;
+#endif
+    }
+
+    // ============================ 修改操作 ============================
+
+    void insert(const Key& key) {
+        const uint64_t h = static_cast<uint64_t>(hash_(key));
+        uint32_t* block = block_of(h);
+#if SUGAR_HAS_SSE2
+        const __m128i k = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(h)));
+        const __m128i* s = reinterpret_cast<const __m128i*>(salts());
+        __m128i* b = reinterpret_cast<__m128i*>(block);
+        const __m128i m0 = sugar::filter_pow2_epi32(_mm_srli_epi32(sugar::filter_mullo_epi32(k, _mm_load_si128(s)), 27));
+        const __m128i m1 = sugar::filter_pow2_epi32(_mm_srli_epi32(sugar::filter_mullo_epi32(k, _mm_load_si128(s + 1)), 27));
+        _mm_store_si128(b, _mm_or_si128(_mm_load_si128(b), m0));
+        _mm_store_si128(b + 1, _mm_or_si128(_mm_load_si128(b + 1), m1));
+#else
+        const uint32_t low = static_cast<uint32_t>(h);
+        for (size_type i = 0; i < block_words; ++i) {
+            block[i] |= uint32_t(1) << ((low * salts()[i]) >> 27);
+        }
+#endif
+        ++count_;
+    }
+
+    void clear() noexcept {
+        if (blocks_ != nullptr) {
+            std::memset(blocks_, 0, memory_bytes());
+        }
+        count_ = 0;
+    }
+
+    void swap(bloom_filter& other) noexcept {
+        sugar::swap(raw_, other.raw_);
+        sugar::swap(blocks_, other.blocks_);
+        sugar::swap(block_count_, other.block_count_);
+        sugar::swap(count_, other.count_);
+        sugar::swap(hash_, other.hash_);
+    }
+
+    friend void swap(bloom_filter& a, bloom_filter& b) noexcept { a.swap(b); }
+
+    // ============================ 序列化 ============================
+
+    size_type serialized_size() const noexcept { return header_bytes + memory_bytes(); }
+
+    /**
+     * @brief 写入serialized_size()个字节
+     */
+    void serialize(unsigned char* out) const noexcept {
+        sugar::filter_store32(out, format_magic);
+        sugar::filter_store32(out + 4, 0);
+        sugar::filter_store64(out + 8, block_count_);
+        sugar::filter_store64(out + 16, count_);
+        unsigned char* p = out + header_bytes;
+        for (size_type i = 0; i < block_count_ * block_words; ++i) {
+            sugar::filter_store32(p + 4 * i, blocks_[i]);
+        }
+    }
+
+    /**
+     * @brief 从序列化数据构造，格式错误时抛出 invalid_argument
+     */
+    static bloom_filter deserialize(const unsigned char* data, size_type bytes, const Hash& hash = Hash()) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(bytes < header_bytes || sugar::filter_load32(data) != format_magic,
+                                        "bloom_filter::deserialize - bad header");
+        const uint64_t blocks = sugar::filter_load64(data + 8);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(blocks == 0 || blocks > (bytes - header_bytes) / (4 * block_words)
+                                            || bytes != header_bytes + blocks * 4 * block_words,
+                                        "bloom_filter::deserialize - size mismatch");
+        bloom_filter out(0, 1.0, hash);
+        ::operator delete(out.raw_);
+        out.raw_ = nullptr;
+        out.allocate(static_cast<size_type>(blocks));
+        out.count_ = static_cast<size_type>(sugar::filter_load64(data + 16));
+        const unsigned char* p = data + header_bytes;
+        for (size_type i = 0; i < out.block_count_ * block_words; ++i) {
+            out.blocks_[i] = sugar::filter_load32(p + 4 * i);
+        }
+        return out;
+    }
+};
+
+// ============================ cuckoo_filter 类 ============================
+
+/**
+ * @brief cuckoo_filter 类，布谷鸟过滤器：每桶4个16位指纹，支持删除
+ *
+ * 键的候选桶为 i1 与 alt(i1, fp)，其中 alt(i, fp) = (h(fp) - i) mod m 是对合映射，
+ * 只凭指纹就能从任一候选桶算出另一个，因此桶数不必是2的幂。
+ * 桶打包在一个64位字里，查询用SWAR一次比较4个槽，只访问两个缓存行。
+ * 误报率约 8 / 2^16 ≈ 0.012%，装载率90%时每键约17.8位。
+ *
+ * 删除只应作用于确实插入过的键，否则可能删掉碰撞的指纹造成漏报。
+ *
+ * @tparam Key 键类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>
+ */
+template<typename Key, typename Hash = hash<Key>>
+class cuckoo_filter {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using hasher = Hash;
+    using size_type = size_t;
+
+private:
+    static const uint32_t format_magic = 0x31464353;   // "SCF1"
+    static const size_type header_bytes = 32;
+    static const uint32_t max_kicks = 500;
+    static const uint64_t lane_ones = 0x0001000100010001ull;
+    static const uint64_t lane_highs = 0x8000800080008000ull;
+
+    // ============================ 私有成员 ============================
+    vector<uint64_t> buckets_;   // 每桶4个16位指纹，0表示空槽
+    size_type count_;
+    uint16_t victim_fp_;         // 踢出链过长时暂存的指纹，非0表示过滤器已满
+    uint32_t victim_bucket_;
+    wyrand rng_;
+    Hash hash_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static size_type buckets_for(size_type capacity) {
+        // 目标装载率90%
+        const size_type buckets = (capacity * 10 + 35) / 36;
+        SUGAR_THROW_LENGTH_ERROR_IF(buckets > 0xffffffffull, "cuckoo_filter - too many buckets");
+        return buckets == 0 ? 1 : buckets;
+    }
+
+    static uint16_t fingerprint(uint64_t h) noexcept {
+        const uint16_t fp = static_cast<uint16_t>(h >> 48);
+        return fp == 0 ? 1 : fp;
+    }
+
+    uint32_t index_of(uint64_t h) const noexcept {
+        return sugar::filter_reduce(static_cast<uint32_t>(h), static_cast<uint32_t>(buckets_.size()));
+    }
+
+    uint32_t alt_index(uint32_t i, uint16_t fp) const noexcept {
+        const uint32_t m = static_cast<uint32_t>(buckets_.size());
+        const uint32_t hf = sugar::filter_reduce(uint32_t(fp) * 0x5bd1e995u, m);
+        return hf >= i ? hf - i : hf + m - i;
+    }
+
+    /**
+     * @brief 桶中是否有等于fp的槽（SWAR判断是否有16位分量为0，结论精确）
+     */
+    static bool bucket_has(uint64_t bucket, uint16_t fp) noexcept {
+        const uint64_t x = bucket ^ (lane_ones * fp);
+        return ((x - lane_ones) & ~x & lane_highs) != 0;
+    }
+
+    static uint16_t lane(uint64_t bucket, uint32_t k) noexcept {
+        return static_cast<uint16_t>(bucket >> (16 * k));
+    }
+
+    static void set_lane(uint64_t& bucket, uint32_t k, uint16_t fp) noexcept {
+        bucket = (bucket & ~(uint64_t(0xffff) << (16 * k))) | (uint64_t(fp) << (16 * k));
+    }
+
+    bool put(uint32_t i, uint16_t fp) noexcept {
+        for (uint32_t k = 0; k < 4; ++k) {
+            if (lane(buckets_[i], k) == 0) {
+                set_lane(buckets_[i], k, fp);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool take(uint32_t i, uint16_t fp) noexcept {
+        for (uint32_t k = 0; k < 4; ++k) {
+            if (lane(buckets_[i], k) == fp) {
+                set_lane(buckets_[i], k, 0);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 把指纹放入桶i或其备选桶，必要时随机踢出已有指纹；踢出链过长时暂存最后一个被踢出的指纹
+     */
+    void place(uint32_t i, uint16_t fp) {
+        if (put(i, fp)) {
+            return;
+        }
+        i = alt_index(i, fp);
+        if (put(i, fp)) {
+            return;
+        }
+        for (uint32_t kick = 0; kick < max_kicks; ++kick) {
+            const uint32_t k = static_cast<uint32_t>(rng_() & 3);
+            const uint16_t evicted = lane(buckets_[i], k);
+            set_lane(buckets_[i], k, fp);
+            fp = evicted;
+            i = alt_index(i, fp);
+            if (put(i, fp)) {
+                return;
+            }
+        }
+        victim_fp_ = fp;
+        victim_bucket_ = i;
+    }
+
+    void reset(size_type capacity) {
+        buckets_.clear();
+        buckets_.resize(buckets_for(capacity), 0);
+        count_ = 0;
+        victim_fp_ = 0;
+        victim_bucket_ = 0;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 按容量分配桶（装载率90%）
+     */
+    explicit cuckoo_filter(size_type capacity = 0, const Hash& hash = Hash())
+        : count_(0), victim_fp_(0), victim_bucket_(0), hash_(hash) {
+        reset(capacity);
+    }
+
+    /**
+     * @brief 从一组键构造；装不下时扩容25%重建，只有大量重复键才会最终失败并抛出 length_error
+     */
+    explicit cuckoo_filter(const vector<Key>& keys, const Hash& hash = Hash())
+        : count_(0), victim_fp_(0), victim_bucket_(0), hash_(hash) {
+        size_type capacity = keys.size();
+        for (int attempt = 0;; ++attempt) {
+            reset(capacity);
+            size_type i = 0;
+            while (i < keys.size() && insert(keys[i])) {
+                ++i;
+            }
+            if (i == keys.size()) {
+                return;
+            }
+            SUGAR_THROW_LENGTH_ERROR_IF(attempt == 7, "cuckoo_filter - keys do not fit, too many duplicates");
+            capacity += capacity / 4 + 1;
+        }
+    }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return count_ == 0; }
+    size_type size() const noexcept { return count_; }
+    size_type bucket_count() const noexcept { return buckets_.size(); }
+
+    /**
+     * @brief 是否已满：有暂存的指纹时insert将失败
+     */
+    bool full() const noexcept { return victim_fp_ != 0; }
+
+    size_type memory_bytes() const noexcept { return buckets_.capacity() * sizeof(uint64_t); }
+
+    double bits_per_key() const noexcept {
+        return count_ == 0 ? 0.0 : 8.0 * memory_bytes() / count_;
+    }
+
+    // ============================ 查找 ============================
+
+    /**
+     * @brief 键可能在集合中时返回true；返回false时键一定不在
+     */
+    bool contains(const Key& key) const {
+        const uint64_t h = static_cast<uint64_t>(hash_(key));
+        const uint16_t fp = fingerprint(h);
+        const uint32_t i1 = index_of(h);
+        const uint32_t i2 = alt_index(i1, fp);
+        return bucket_has(buckets_[i1], fp) || bucket_has(buckets_[i2], fp)
+               || (victim_fp_ == fp && (victim_bucket_ == i1 || victim_bucket_ == i2));
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 插入键；过滤器已满时返回false且不做修改
+     */
+    bool insert(const Key& key) {
+        if (victim_fp_ != 0) {
+            return false;
+        }
+        const uint64_t h = static_cast<uint64_t>(hash_(key));
+        place(index_of(h), fingerprint(h));
+        ++count_;
+        return true;
+    }
+
+    /**
+     * @brief 删除键的一个副本，找不到时返回false；删除后会尝试放回暂存的指纹
+     */
+    bool erase(const Key& key) {
+        const uint64_t h = static_cast<uint64_t>(hash_(key));
+        const uint16_t fp = fingerprint(h);
+        const uint32_t i1 = index_of(h);
+        const uint32_t i2 = alt_index(i1, fp);
+        if (victim_fp_ == fp && (victim_bucket_ == i1 || victim_bucket_ == i2)) {
+            victim_fp_ = 0;
+            --count_;
+            return true;
+        }
+        if (!take(i1, fp) && !take(i2, fp)) {
+            return false;
+        }
+        --count_;
+        if (victim_fp_ != 0) {
+            const uint16_t victim = victim_fp_;
+            victim_fp_ = 0;
+            place(victim_bucket_, victim);
+        }
+        return true;
+    }
+
+    void clear() noexcept {
+        for (size_type i = 0; i < buckets_.size(); ++i) {
+            buckets_[i] = 0;
+        }
+        count_ = 0;
+        victim_fp_ = 0;
+    }
+
+    void swap(cuckoo_filter& other) noexcept {
+        buckets_.swap(other.buckets_);
+        sugar::swap(count_, other.count_);
+        sugar::swap(victim_fp_, other.victim_fp_);
+        sugar::swap(victim_bucket_, other.victim_bucket_);
+        sugar::swap(rng_, other.rng_);
+        sugar::swap(hash_, other.hash_);
+    }
+
+    friend void swap(cuckoo_filter& a, cuckoo_filter& b) noexcept { a.swap(b); }
+
+    // ============================ 序列化 ============================
+
+    size_type serialized_size() const noexcept { return header_bytes + buckets_.size() * sizeof(uint64_t); }
+
+    /**
+     * @brief 写入serialized_size()个字节
+     */
+    void serialize(unsigned char* out) const noexcept {
+        sugar::filter_store32(out, format_magic);
+        sugar::filter_store32(out + 4, victim_fp_);
+        sugar::filter_store64(out + 8, buckets_.size());
+        sugar::filter_store64(out + 16, count_);
+        sugar::filter_store64(out + 24, victim_bucket_);
+        unsigned char* p = out + header_bytes;
+        for (size_type i = 0; i < buckets_.size(); ++i) {
+            sugar::filter_store64(p + 8 * i, buckets_[i]);
+        }
+    }
+
+    /**
+     * @brief 从序列化数据构造，检查桶数与指纹计数，格式错误时抛出 invalid_argument
+     */
+    static cuckoo_filter deserialize(const unsigned char* data, size_type bytes, const Hash& hash = Hash()) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(bytes < header_bytes || sugar::filter_load32(data) != format_magic,
+                                        "cuckoo_filter::deserialize - bad header");
+        const uint64_t buckets = sugar::filter_load64(data + 8);
+        const uint32_t victim = sugar::filter_load32(data + 4);
+        const uint64_t victim_bucket = sugar::filter_load64(data + 24);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(buckets == 0 || buckets > 0xffffffffull
+                                            || bytes - header_bytes != buckets * sizeof(uint64_t)
+                                            || victim > 0xffff || victim_bucket >= buckets,
+                                        "cuckoo_filter::deserialize - size mismatch");
+        cuckoo_filter out(0, hash);
+        out.buckets_.resize(static_cast<size_type>(buckets), 0);
+        size_type stored = victim != 0;
+        const unsigned char* p = data + header_bytes;
+        for (size_type i = 0; i < out.buckets_.size(); ++i) {
+            out.buckets_[i] = sugar::filter_load64(p + 8 * i);
+            for (uint32_t k = 0; k < 4; ++k) {
+                stored += lane(out.buckets_[i], k) != 0;
+            }
+        }
+        out.count_ = static_cast<size_type>(sugar::filter_load64(data + 16));
+        out.victim_fp_ = static_cast<uint16_t>(victim);
+        out.victim_bucket_ = static_cast<uint32_t>(victim_bucket);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(stored != out.count_, "cuckoo_filter::deserialize - count mismatch");
+        return out;
+    }
+};
+
+// ============================ binary_fuse_filter 类 ============================
+
+/**
+ * @brief binary_fuse_filter 类，3路 binary fuse 过滤器（8位指纹），只能从静态键集合一次性构造
+ *
+ * 每个键映射到相邻三段中的各一个位置，三处指纹异或等于键的指纹。构造时反复“剥离”
+ * 只被一个键占用的位置得到赋值顺序，再倒序填写指纹。空间约为键数的1.125倍字节
+ * （每键约9位），误报率约 1/256 ≈ 0.39%，查询固定访问三个字节。
+ *
+ * @tparam Key 键类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>
+ */
+template<typename Key, typename Hash = hash<Key>>
+class binary_fuse_filter {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using hasher = Hash;
+    using size_type = size_t;
+
+private:
+    static const uint32_t format_magic = 0x31465342;   // "BSF1"
+    static const size_type header_bytes = 32;
+    static const int max_iterations = 100;
+    static const uint32_t max_segment_length = 262144;
+
+    // ============================ 私有成员 ============================
+    vector<uint8_t> fingerprints_;
+    uint64_t seed_;
+    uint32_t segment_length_;
+    uint32_t segment_length_mask_;
+    uint32_t segment_count_;
+    uint32_t segment_count_length_;
+    size_type count_;
+    Hash hash_;
+
+    // ============================ 私有辅助函数 ============================
+
+    /**
+     * @brief 按键数确定段长与段数（参数取自 Graf & Lemire 2022 的经验公式）
+     */
+    void configure(uint32_t n) {
+        uint32_t length = 4;
+        if (n > 1) {
+            length = uint32_t(1) << static_cast<int>(std::floor(std::log(double(n)) / std::log(3.33) + 2.25));
+        }
+        if (length > max_segment_length) {
+            length = max_segment_length;
+        }
+        uint64_t capacity = 0;
+        if (n > 1) {
+            const double factor = sugar::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(double(n)));
+            capacity = static_cast<uint64_t>(std::round(double(n) * factor));
+        }
+        const uint64_t segments = (capacity + length - 1) / length;
+        segment_length_ = length;
+        segment_length_mask_ = length - 1;
+        segment_count_ = segments <= 2 ? 1 : static_cast<uint32_t>(segments - 2);
+        segment_count_length_ = segment_count_ * segment_length_;
+    }
+
+    size_type array_length() const noexcept { return size_type(segment_count_ + 2) * segment_length_; }
+
+    static uint8_t fingerprint(uint64_t h) noexcept {
+        return static_cast<uint8_t>(h ^ (h >> 32));
+    }
+
+    /**
+     * @brief 键在第index段（0、1、2）中的位置
+     */
+    uint32_t position(uint32_t index, uint64_t h) const noexcept {
+        uint64_t hi;
+        sugar::mul128(h, segment_count_length_, hi);
+        hi += uint64_t(index) * segment_length_;
+        const uint64_t low = h & ((uint64_t(1) << 36) - 1);
+        hi ^= (low >> (36 - 18 * index)) & segment_length_mask_;
+        return static_cast<uint32_t>(hi);
+    }
+
+    static uint32_t mod3(uint32_t x) noexcept { return x > 2 ? x - 3 : x; }
+
+    /**
+     * @brief 对去重后的散列值构造过滤器
+     */
+    void build(const vector<uint64_t>& hashes) {
+        const uint32_t n = static_cast<uint32_t>(hashes.size());
+        configure(n);
+        const size_type capacity = array_length();
+        fingerprints_.clear();
+        fingerprints_.resize(capacity, 0);
+        count_ = n;
+
+        vector<uint64_t> mixed(n);
+        vector<uint64_t> order(n);
+        vector<uint8_t> reverse_h(n);
+        vector<uint64_t> t2hash(capacity, 0);
+        vector<uint8_t> t2count(capacity, 0);
+        vector<uint32_t> alone(capacity);
+        uint32_t block_bits = 1;
+        while ((uint32_t(1) << block_bits) < segment_count_) {
+            ++block_bits;
+        }
+        vector<uint32_t> start((size_type(1) << block_bits) + 1);
+        uint64_t rng = 0x726b2b9d438b9d4dull;
+
+        for (int loop = 0;; ++loop) {
+            SUGAR_THROW_RUNTIME_ERROR_IF(loop == max_iterations, "binary_fuse_filter - construction failed");
+            seed_ = sugar::splitmix64(rng);
+
+            // 按散列高位（近似第一段段号）计数排序，使后续对t2count/t2hash的访问近似顺序
+            for (size_type b = 0; b < start.size(); ++b) {
+                start[b] = 0;
+            }
+            for (uint32_t i = 0; i < n; ++i) {
+                mixed[i] = sugar::hash_mix64(hashes[i], seed_);
+                ++start[(mixed[i] >> (64 - block_bits)) + 1];
+            }
+            for (size_type b = 1; b < start.size(); ++b) {
+                start[b] += start[b - 1];
+            }
+            for (uint32_t i = 0; i < n; ++i) {
+                order[start[mixed[i] >> (64 - block_bits)]++] = mixed[i];
+            }
+
+            // 每个位置记录占用它的键数（高6位）、这些键所在段序号的异或（低2位）与散列值的异或
+            bool overflow = false;
+            for (uint32_t i = 0; i < n; ++i) {
+                const uint64_t h = order[i];
+                for (uint32_t index = 0; index < 3; ++index) {
+                    const uint32_t p = position(index, h);
+                    t2count[p] = static_cast<uint8_t>((t2count[p] + 4) ^ index);
+                    t2hash[p] ^= h;
+                    overflow = overflow || t2count[p] < 4;
+                }
+            }
+
+            uint32_t stack = 0;
+            if (!overflow) {
+                uint32_t queue = 0;
+                for (uint32_t i = 0; i < capacity; ++i) {
+                    alone[queue] = i;
+                    queue += (t2count[i] >> 2) == 1;
+                }
+                while (queue > 0) {
+                    const uint32_t index = alone[--queue];
+                    if ((t2count[index] >> 2) != 1) {
+                        continue;
+                    }
+                    const uint64_t h = t2hash[index];
+                    const uint32_t found = t2count[index] & 3;
+                    reverse_h[stack] = static_cast<uint8_t>(found);
+                    order[stack++] = h;
+                    for (uint32_t step = 1; step < 3; ++step) {
+                        const uint32_t other = mod3(found + step);
+                        const uint32_t p = position(other, h);
+                        alone[queue] = p;
+                        queue += (t2count[p] >> 2) == 2;
+                        t2count[p] = static_cast<uint8_t>((t2count[p] - 4) ^ other);
+                        t2hash[p] ^= h;
+                    }
+                }
+            }
+            if (stack == n) {
+                break;
+            }
+            for (size_type i = 0; i < capacity; ++i) {
+                t2count[i] = 0;
+                t2hash[i] = 0;
+            }
+        }
+
+        // 倒序赋值：每个键被剥离时独占的位置在它之后的键中不再被写
+        for (uint32_t i = n; i-- > 0;) {
+            const uint64_t h = order[i];
+            const uint32_t found = reverse_h[i];
+            const uint32_t p0 = position(found, h);
+            const uint32_t p1 = position(mod3(found + 1), h);
+            const uint32_t p2 = position(mod3(found + 2), h);
+            fingerprints_[p0] = static_cast<uint8_t>(fingerprint(h) ^ fingerprints_[p1] ^ fingerprints_[p2]);
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 空过滤器，对任何键的误报率与非空时相同
+     */
+    explicit binary_fuse_filter(const Hash& hash = Hash()) : seed_(0), count_(0), hash_(hash) {
+        build(vector<uint64_t>());
+    }
+
+    /**
+     * @brief 从一组键构造，重复的键只计一次；键数不能超过2^32-1，否则抛出 length_error
+     */
+    explicit binary_fuse_filter(const vector<Key>& keys, const Hash& hash = Hash())
+        : seed_(0), count_(0), hash_(hash) {
+        SUGAR_THROW_LENGTH_ERROR_IF(keys.size() >= 0xffffffffull, "binary_fuse_filter - too many keys");
+        vector<uint64_t> hashes(keys.size());
+        for (size_type i = 0; i < keys.size(); ++i) {
+            hashes[i] = static_cast<uint64_t>(hash_(keys[i]));
+        }
+        sugar::sort(hashes.begin(), hashes.end());
+        size_type unique = 0;
+        for (size_type i = 0; i < hashes.size(); ++i) {
+            if (unique == 0 || hashes[unique - 1] != hashes[i]) {
+                hashes[unique++] = hashes[i];
+            }
+        }
+        hashes.resize(unique);
+        build(hashes);
+    }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return count_ == 0; }
+
+    /**
+     * @brief 构造时去重后的键数
+     */
+    size_type size() const noexcept { return count_; }
+
+    size_type memory_bytes() const noexcept { return fingerprints_.capacity(); }
+
+    double bits_per_key() const noexcept {
+        return count_ == 0 ? 0.0 : 8.0 * memory_bytes() / count_;
+    }
+
+    // ============================ 查找 ============================
+
+    /**
+     * @brief 键可能在集合中时返回true；返回false时键一定不在
+     */
+    bool contains(const Key& key) const {
+        const uint64_t h = sugar::hash_mix64(static_cast<uint64_t>(hash_(key)), seed_);
+        uint64_t hi;
+        sugar::mul128(h, segment_count_length_, hi);
+        const uint32_t p0 = static_cast<uint32_t>(hi);
+        const uint32_t p1 = (p0 + segment_length_) ^ (static_cast<uint32_t>(h >> 18) & segment_length_mask_);
+        const uint32_t p2 = (p0 + 2 * segment_length_) ^ (static_cast<uint32_t>(h) & segment_length_mask_);
+        const uint8_t* f = fingerprints_.data();
+        return (fingerprint(h) ^ f[p0] ^ f[p1] ^ f[p2]) == 0;
+    }
+
+    void swap(binary_fuse_filter& other) noexcept {
+        fingerprints_.swap(other.fingerprints_);
+        sugar::swap(seed_, other.seed_);
+        sugar::swap(segment_length_, other.segment_length_);
+        sugar::swap(segment_length_mask_, other.segment_length_mask_);
+        sugar::swap(segment_count_, other.segment_count_);
+        sugar::swap(segment_count_length_, other.segment_count_length_);
+        sugar::swap(count_, other.count_);
+        sugar::swap(hash_, other.hash_);
+    }
+
+    friend void swap(binary_fuse_filter& a, binary_fuse_filter& b) noexcept { a.swap(b); }
+
+    // ============================ 序列化 ============================
+
+    size_type serialized_size() const noexcept { return header_bytes + fingerprints_.size(); }
+
+    /**
+     * @brief 写入serialized_size()个字节
+     */
+    void serialize(unsigned char* out) const noexcept {
+        sugar::filter_store32(out, format_magic);
+        sugar::filter_store32(out + 4, segment_length_);
+        sugar::filter_store32(out + 8, segment_count_);
+        sugar::filter_store32(out + 12, 0);
+        sugar::filter_store64(out + 16, seed_);
+        sugar::filter_store64(out + 24, count_);
+        std::memcpy(out + header_bytes, fingerprints_.data(), fingerprints_.size());
+    }
+
+    /**
+     * @brief 从序列化数据构造，格式错误时抛出 invalid_argument
+     */
+    static binary_fuse_filter deserialize(const unsigned char* data, size_type bytes, const Hash& hash = Hash()) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(bytes < header_bytes || sugar::filter_load32(data) != format_magic,
+                                        "binary_fuse_filter::deserialize - bad header");
+        const uint32_t length = sugar::filter_load32(data + 4);
+        const uint32_t segments = sugar::filter_load32(data + 8);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(length == 0 || (length & (length - 1)) != 0 || length > max_segment_length
+                                            || segments == 0 || uint64_t(segments) * length > 0xffffffffull
+                                            || bytes - header_bytes != (uint64_t(segments) + 2) * length,
+                                        "binary_fuse_filter::deserialize - size mismatch");
+        binary_fuse_filter out(hash);
+        out.segment_length_ = length;
+        out.segment_length_mask_ = length - 1;
+        out.segment_count_ = segments;
+        out.segment_count_length_ = segments * length;
+        out.seed_ = sugar::filter_load64(data + 16);
+        out.count_ = static_cast<size_type>(sugar::filter_load64(data + 24));
+        out.fingerprints_.clear();
+        out.fingerprints_.resize(out.array_length(), 0);
+        std::memcpy(out.fingerprints_.data(), data + header_bytes, out.fingerprints_.size());
+        return out;
+    }
+};
+
+} // namespace sugar
+
+#endif // FILTER_H_
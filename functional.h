@@ -0,0 +1,109 @@
+/*
+ * @file functional.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 函数对象（比较与算术仿函数），完全独立实现，不依赖std
+ */
+
+#ifndef FUNCTIONAL_H_
+#define FUNCTIONAL_H_
+
+namespace sugar {
+
+// ============================ 比较仿函数 ============================
+
+/**
+ * @brief 小于比较仿函数
+ */
+template<typename T>
+struct less {
+    bool operator()(const T& a, const T& b) const {
+        return a < b;
+    }
+};
+
+/**
+ * @brief 大于比较仿函数
+ */
+template<typename T>
+struct greater {
+    bool operator()(const T& a, const T& b) const {
+        return b < a;
+    }
+};
+
+/**
+ * @brief 小于等于比较仿函数
+ */
+template<typename T>
+struct less_equal {
+    bool operator()(const T& a, const T& b) const {
+        return !(b < a);
+    }
+};
+
+/**
+ * @brief 大于等于比较仿函数
+ */
+template<typename T>
+struct greater_equal {
+    bool operator()(const T& a, const T& b) const {
+        return !(a < b);
+    }
+};
+
+/**
+ * @brief 相等比较仿函数
+ */
+template<typename T>
+struct equal_to {
+    bool operator()(const T& a, const T& b) const {
+        return a == b;
+    }
+};
+
+/**
+ * @brief 不等比较仿函数
+ */
+template<typename T>
+struct not_equal_to {
+    bool operator()(const T& a, const T& b) const {
+        return !(a == b);
+    }
+};
+
+// ============================ 算术仿函数 ============================
+
+/**
+ * @brief 加法仿函数
+ */
+template<typename T>
+struct plus {
+    T operator()(const T& a, const T& b) const {
+        return a + b;
+    }
+};
+
+/**
+ * @brief 减法仿函数
+ */
+template<typename T>
+struct minus {
+    T operator()(const T& a, const T& b) const {
+        return a - b;
+    }
+};
+
+/**
+ * @brief 乘法仿函数
+ */
+template<typename T>
+struct multiplies {
+    T operator()(const T& a, const T& b) const {
+        return a * b;
+    }
+};
+
+} // namespace sugar
+
+#endif // FUNCTIONAL_H_
@@ -0,0 +1,879 @@
+/*
+ * @file future.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 异步任务：promise / future、then 续接（就地执行或投递到内置线程池）、
+ *        async、when_all / when_any；共享状态经 allocator_traits 一次分配，续接与结果共用同一块状态
+ */
+
+#ifndef FUTURE_H_
+#define FUTURE_H_
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "type_traits.h"
+#include "utility.h"
+#include "vector.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace sugar {
+
+template<typename T>
+class future;
+
+template<typename T>
+class promise;
+
+template<typename T>
+struct when_any_result;
+
+// ============================ 完成回调 ============================
+
+/**
+ * @brief 挂在共享状态上、在其完成时调用的回调节点；投递到线程池时也用 next 串成队列
+ */
+struct future_hook {
+    future_hook* next;
+    void (*fire)(future_hook*);
+};
+
+/**
+ * @brief 就地执行的续接最多嵌套的层数，更深的续接推迟到最外层回调返回后依次执行，避免长链耗尽栈空间
+ */
+const uint32_t future_inline_depth = 32;
+
+/**
+ * @brief 依次调用一串回调
+ */
+inline void run_future_hooks(future_hook* list) noexcept {
+    struct context {
+        future_hook* deferred;
+        uint32_t depth;
+    };
+    static thread_local context ctx = {nullptr, 0};
+    if (ctx.depth >= future_inline_depth) {
+        while (list != nullptr) {
+            future_hook* next = list->next;
+            list->next = ctx.deferred;
+            ctx.deferred = list;
+            list = next;
+        }
+        return;
+    }
+    ++ctx.depth;
+    while (list != nullptr) {
+        future_hook* next = list->next;
+        list->fire(list);
+        list = next;
+    }
+    if (ctx.depth == 1) {
+        while (ctx.deferred != nullptr) {
+            future_hook* h = ctx.deferred;
+            ctx.deferred = h->next;
+            h->fire(h);
+        }
+    }
+    --ctx.depth;
+}
+
+// ============================ task_executor 类 ============================
+
+/**
+ * @brief task_executor 类，固定线程数的小线程池，执行投递来的回调
+ *
+ * 任务队列是回调节点串成的侵入式链表，投递不分配内存。析构时先执行完队列中剩余的任务再退出，
+ * 因此投递到池中的续接总会被执行。池中的任务不应阻塞等待同一个池里尚未执行的任务。
+ */
+class task_executor {
+private:
+    std::mutex lock_;
+    std::condition_variable ready_;
+    future_hook* head_;
+    future_hook* tail_;
+    bool stop_;
+    vector<std::thread> workers_;
+
+    void worker() {
+        for (;;) {
+            future_hook* h;
+            {
+                std::unique_lock<std::mutex> guard(lock_);
+                while (head_ == nullptr && !stop_) {
+                    ready_.wait(guard);
+                }
+                if (head_ == nullptr) {
+                    return;
+                }
+                h = head_;
+                head_ = h->next;
+                if (head_ == nullptr) {
+                    tail_ = nullptr;
+                }
+            }
+            h->fire(h);
+        }
+    }
+
+public:
+    /**
+     * @param threads 线程数；0表示取硬件并发数，且至少为2
+     */
+    explicit task_executor(size_t threads = 0) : head_(nullptr), tail_(nullptr), stop_(false) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+            if (threads < 2) {
+                threads = 2;
+            }
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.push_back(std::thread([this]() { worker(); }));
+        }
+    }
+
+    task_executor(const task_executor&) = delete;
+    task_executor& operator=(const task_executor&) = delete;
+
+    ~task_executor() {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stop_ = true;
+        }
+        ready_.notify_all();
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            workers_[i].join();
+        }
+    }
+
+    /**
+     * @brief 投递一个回调，由某个工作线程调用 h->fire(h)
+     */
+    void post(future_hook* h) {
+        h->next = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            if (tail_ == nullptr) {
+                head_ = h;
+            } else {
+                tail_->next = h;
+            }
+            tail_ = h;
+        }
+        ready_.notify_one();
+    }
+
+    size_t size() const noexcept { return workers_.size(); }
+};
+
+/**
+ * @brief 进程内共享的默认线程池
+ */
+inline task_executor& default_executor() {
+    static task_executor executor;
+    return executor;
+}
+
+// ============================ 共享状态 ============================
+
+/**
+ * @brief future_state_base 类，promise 与 future 之间的共享状态中与值类型无关的部分
+ *
+ * hooks_ 在完成前是待调用回调的栈，完成时被原子地换成 ready_marker()，之后再挂的回调立即执行；
+ * 阻塞等待也是挂一个唤醒条件变量的回调，所以没有人等待时状态里不需要互斥锁。
+ * 引用计数归零时调用 destroy_，由分配时记下的分配器析构并释放整块状态。
+ */
+class future_state_base {
+private:
+    std::atomic<future_hook*> hooks_;
+    std::atomic<uint32_t> refs_;
+    void (*destroy_)(future_state_base*);
+
+    static future_hook* ready_marker() noexcept {
+        static future_hook marker = {nullptr, nullptr};
+        return &marker;
+    }
+
+    struct waiter : future_hook {
+        std::mutex lock;
+        std::condition_variable cv;
+        bool done;
+
+        static void wake(future_hook* h) {
+            waiter* w = static_cast<waiter*>(h);
+            std::lock_guard<std::mutex> guard(w->lock);
+            w->done = true;
+            w->cv.notify_one();  // 持锁通知：等待者醒来前 w 不会被销毁
+        }
+    };
+
+protected:
+    std::exception_ptr error_;
+
+    explicit future_state_base(void (*destroy)(future_state_base*)) noexcept
+        : hooks_(nullptr), refs_(1), destroy_(destroy) {}
+
+    ~future_state_base() {}
+
+    /**
+     * @brief 结果已写入，唤醒等待者并按挂上的顺序执行续接
+     */
+    void complete() noexcept {
+        future_hook* list = hooks_.exchange(ready_marker(), std::memory_order_acq_rel);
+        future_hook* ordered = nullptr;
+        while (list != nullptr) {
+            future_hook* next = list->next;
+            list->next = ordered;
+            ordered = list;
+            list = next;
+        }
+        run_future_hooks(ordered);
+    }
+
+public:
+    future_state_base(const future_state_base&) = delete;
+    future_state_base& operator=(const future_state_base&) = delete;
+
+    void retain() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+    void release() noexcept {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            destroy_(this);
+        }
+    }
+
+    bool ready() const noexcept { return hooks_.load(std::memory_order_acquire) == ready_marker(); }
+
+    /**
+     * @brief 挂上回调；若状态已完成则返回false，回调不会被调用
+     */
+    bool try_attach(future_hook* h) noexcept {
+        future_hook* head = hooks_.load(std::memory_order_acquire);
+        do {
+            if (head == ready_marker()) {
+                return false;
+            }
+            h->next = head;
+        } while (!hooks_.compare_exchange_weak(head, h, std::memory_order_release, std::memory_order_acquire));
+        return true;
+    }
+
+    /**
+     * @brief 挂上回调；若状态已完成则在当前线程立即调用
+     */
+    void attach(future_hook* h) noexcept {
+        if (!try_attach(h)) {
+            h->next = nullptr;
+            run_future_hooks(h);
+        }
+    }
+
+    void wait() {
+        if (ready()) {
+            return;
+        }
+        waiter w;
+        w.fire = &waiter::wake;
+        w.done = false;
+        if (!try_attach(&w)) {
+            return;
+        }
+        std::unique_lock<std::mutex> guard(w.lock);
+        while (!w.done) {
+            w.cv.wait(guard);
+        }
+    }
+
+    void set_exception(std::exception_ptr e) noexcept {
+        error_ = e;
+        complete();
+    }
+};
+
+/**
+ * @brief future_state 类模板，保存类型为T的结果
+ */
+template<typename T>
+class future_state : public future_state_base {
+private:
+    alignas(T) unsigned char storage_[sizeof(T)];
+    bool has_value_;
+
+    T* value_ptr() noexcept { return reinterpret_cast<T*>(storage_); }
+
+protected:
+    explicit future_state(void (*destroy)(future_state_base*)) noexcept
+        : future_state_base(destroy), has_value_(false) {}
+
+    ~future_state() {
+        if (has_value_) {
+            value_ptr()->~T();
+        }
+    }
+
+public:
+    template<typename... Args>
+    void set_value(Args&&... args) {
+        ::new (static_cast<void*>(storage_)) T(sugar::forward<Args>(args)...);
+        has_value_ = true;
+        complete();
+    }
+
+    /**
+     * @brief 取出结果（移出），或重新抛出保存的异常；只能在完成后调用一次
+     */
+    T take() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return sugar::move(*value_ptr());
+    }
+};
+
+template<>
+class future_state<void> : public future_state_base {
+protected:
+    explicit future_state(void (*destroy)(future_state_base*)) noexcept : future_state_base(destroy) {}
+
+public:
+    void set_value() noexcept { complete(); }
+
+    void take() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+};
+
+/**
+ * @brief allocated_state 类模板，为状态类型State附加分配器：一次分配，引用计数归零时用同一分配器释放
+ */
+template<typename State, typename Alloc>
+class allocated_state : public State {
+private:
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<allocated_state> alloc_type;
+
+    alloc_type alloc_;
+
+    static void destroy(future_state_base* base) {
+        allocated_state* self = static_cast<allocated_state*>(base);
+        alloc_type alloc(self->alloc_);
+        allocator_traits<alloc_type>::destroy(alloc, self);
+        allocator_traits<alloc_type>::deallocate(alloc, self, 1);
+    }
+
+public:
+    template<typename... Args>
+    allocated_state(const alloc_type& alloc, Args&&... args)
+        : State(&allocated_state::destroy, sugar::forward<Args>(args)...), alloc_(alloc) {}
+
+    template<typename... Args>
+    static allocated_state* create(const Alloc& alloc, Args&&... args) {
+        alloc_type a(alloc);
+        allocated_state* p = allocator_traits<alloc_type>::allocate(a, 1);
+        try {
+            allocator_traits<alloc_type>::construct(a, p, a, sugar::forward<Args>(args)...);
+        } catch (...) {
+            allocator_traits<alloc_type>::deallocate(a, p, 1);
+            throw;
+        }
+        return p;
+    }
+};
+
+/**
+ * @brief 调用 f(args...)，把返回值（或抛出的异常）写入 state
+ */
+template<typename R>
+struct future_setter {
+    template<typename F, typename... Args>
+    static void apply(future_state<R>* state, F& f, Args&&... args) noexcept {
+        try {
+            state->set_value(f(sugar::forward<Args>(args)...));
+        } catch (...) {
+            state->set_exception(std::current_exception());
+        }
+    }
+};
+
+template<>
+struct future_setter<void> {
+    template<typename F, typename... Args>
+    static void apply(future_state<void>* state, F& f, Args&&... args) noexcept {
+        try {
+            f(sugar::forward<Args>(args)...);
+        } catch (...) {
+            state->set_exception(std::current_exception());
+            return;
+        }
+        state->set_value();
+    }
+};
+
+/**
+ * @brief then_state 类模板，then 的结果状态，同时也是挂在前一个状态上的回调
+ *
+ * 引用计数初值为2：一份属于返回给调用者的future，一份属于尚未执行的续接。
+ */
+template<typename R, typename T, typename F>
+class then_state : public future_state<R>, public future_hook {
+private:
+    future<T> input_;
+    F func_;
+    task_executor* executor_;
+
+    static void dispatch(future_hook* h) {
+        then_state* self = static_cast<then_state*>(h);
+        if (self->executor_ != nullptr) {
+            self->fire = &then_state::run;
+            self->executor_->post(self);
+        } else {
+            run(h);
+        }
+    }
+
+    static void run(future_hook* h) {
+        then_state* self = static_cast<then_state*>(h);
+        future_setter<R>::apply(self, self->func_, sugar::move(self->input_));
+        self->release();
+    }
+
+public:
+    template<typename G>
+    then_state(void (*destroy)(future_state_base*), future<T>&& input, G&& func, task_executor* executor)
+        : future_state<R>(destroy), input_(sugar::move(input)), func_(sugar::forward<G>(func)), executor_(executor) {
+        this->next = nullptr;
+        this->fire = &then_state::dispatch;
+        this->retain();
+    }
+
+    void start() noexcept { input_.state_->attach(this); }
+};
+
+/**
+ * @brief async_state 类模板，async 的结果状态，同时也是投递到线程池的任务
+ */
+template<typename R, typename F>
+class async_state : public future_state<R>, public future_hook {
+private:
+    F func_;
+
+    static void run(future_hook* h) {
+        async_state* self = static_cast<async_state*>(h);
+        future_setter<R>::apply(self, self->func_);
+        self->release();
+    }
+
+public:
+    template<typename G>
+    async_state(void (*destroy)(future_state_base*), G&& func)
+        : future_state<R>(destroy), func_(sugar::forward<G>(func)) {
+        this->next = nullptr;
+        this->fire = &async_state::run;
+        this->retain();
+    }
+};
+
+// ============================ future 类模板 ============================
+
+/**
+ * @brief future 续接函数 f(future<T>) 的返回类型
+ */
+template<typename F, typename T>
+struct future_then_result {
+    typedef typename decay<decltype(sugar::declval<F&>()(sugar::declval<future<T>>()))>::type type;
+};
+
+/**
+ * @brief future 类模板，异步结果的只移动句柄
+ *
+ * get() 阻塞到结果就绪后取出结果并使 future 失效；then(f) 挂上续接 f(future<T>)，返回续接结果的 future，
+ * 原 future 随之失效。不带线程池的续接在完成前一个结果的线程中就地执行（若已完成则在调用 then 的线程中执行），
+ * 适合很短的处理；带线程池的续接投递到线程池执行，不占用完成者的线程。
+ */
+template<typename T>
+class future {
+private:
+    future_state<T>* state_;
+
+    template<typename U>
+    friend class future;
+    template<typename U>
+    friend class promise;
+    template<typename R, typename U, typename F>
+    friend class then_state;
+    template<typename U>
+    friend future<vector<future<U>>> when_all(vector<future<U>> inputs);
+    template<typename U>
+    friend future<when_any_result<U>> when_any(vector<future<U>> inputs);
+    template<typename U>
+    friend class when_all_state;
+    template<typename U>
+    friend class when_any_state;
+    template<typename F>
+    friend future<typename decay<decltype(sugar::declval<F&>()())>::type> async(task_executor& executor, F&& f);
+    template<typename U>
+    friend future<typename decay<U>::type> make_ready_future(U&& value);
+    friend future<void> make_ready_future();
+    template<typename U>
+    friend future<U> make_exceptional_future(std::exception_ptr e);
+
+    explicit future(future_state<T>* state) noexcept : state_(state) {}
+
+    template<typename F>
+    future<typename future_then_result<F, T>::type> chain(task_executor* executor, F&& f) {
+        typedef typename future_then_result<F, T>::type result_type;
+        typedef then_state<result_type, T, typename decay<F>::type> state_type;
+        typedef allocated_state<state_type, allocator<char>> node_type;
+        SUGAR_THROW_LOGIC_ERROR_IF(state_ == nullptr, "future::then - no state");
+        node_type* node = node_type::create(allocator<char>(), sugar::move(*this), sugar::forward<F>(f), executor);
+        node->start();
+        return future<result_type>(node);
+    }
+
+public:
+    typedef T value_type;
+
+    // ============================ 构造函数 ============================
+
+    future() noexcept : state_(nullptr) {}
+
+    future(future&& rhs) noexcept : state_(rhs.state_) { rhs.state_ = nullptr; }
+
+    future& operator=(future&& rhs) noexcept {
+        if (this != &rhs) {
+            if (state_ != nullptr) {
+                state_->release();
+            }
+            state_ = rhs.state_;
+            rhs.state_ = nullptr;
+        }
+        return *this;
+    }
+
+    future(const future&) = delete;
+    future& operator=(const future&) = delete;
+
+    ~future() {
+        if (state_ != nullptr) {
+            state_->release();
+        }
+    }
+
+    // ============================ 状态 ============================
+
+    bool valid() const noexcept { return state_ != nullptr; }
+
+    bool is_ready() const noexcept { return state_ != nullptr && state_->ready(); }
+
+    void wait() const {
+        SUGAR_THROW_LOGIC_ERROR_IF(state_ == nullptr, "future::wait - no state");
+        state_->wait();
+    }
+
+    // ============================ 取值与续接 ============================
+
+    /**
+     * @brief 等待并取出结果，或重新抛出异步操作的异常；调用后 future 失效
+     */
+    T get() {
+        SUGAR_THROW_LOGIC_ERROR_IF(state_ == nullptr, "future::get - no state");
+        future_state<T>* state = state_;
+        state_ = nullptr;
+        struct releaser {
+            future_state<T>* state;
+            ~releaser() { state->release(); }
+        } guard = {state};
+        state->wait();
+        return state->take();
+    }
+
+    /**
+     * @brief 结果就绪后在完成者的线程中就地调用 f(future<T>)
+     */
+    template<typename F>
+    future<typename future_then_result<F, T>::type> then(F&& f) {
+        return chain(nullptr, sugar::forward<F>(f));
+    }
+
+    /**
+     * @brief 结果就绪后把 f(future<T>) 投递到 executor 执行
+     */
+    template<typename F>
+    future<typename future_then_result<F, T>::type> then(task_executor& executor, F&& f) {
+        return chain(&executor, sugar::forward<F>(f));
+    }
+};
+
+// ============================ promise 类模板 ============================
+
+/**
+ * @brief promise 类模板，异步结果的写入端
+ *
+ * 构造时分配共享状态（可指定分配器），get_future() 只能调用一次，结果只能设置一次。
+ * 未设置结果就析构时，future 端得到 broken_promise 异常。
+ */
+template<typename T>
+class promise {
+private:
+    future_state<T>* state_;
+    bool retrieved_;
+
+public:
+    // ============================ 构造函数 ============================
+
+    promise() : state_(allocated_state<future_state<T>, allocator<char>>::create(allocator<char>())), retrieved_(false) {}
+
+    template<typename Alloc>
+    promise(allocator_arg_t, const Alloc& alloc)
+        : state_(allocated_state<future_state<T>, Alloc>::create(alloc)), retrieved_(false) {}
+
+    promise(promise&& rhs) noexcept : state_(rhs.state_), retrieved_(rhs.retrieved_) { rhs.state_ = nullptr; }
+
+    promise& operator=(promise&& rhs) noexcept {
+        if (this != &rhs) {
+            promise(sugar::move(rhs)).swap(*this);
+        }
+        return *this;
+    }
+
+    promise(const promise&) = delete;
+    promise& operator=(const promise&) = delete;
+
+    ~promise() {
+        if (state_ != nullptr) {
+            if (!state_->ready()) {
+                state_->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            }
+            state_->release();
+        }
+    }
+
+    void swap(promise& rhs) noexcept {
+        sugar::swap(state_, rhs.state_);
+        sugar::swap(retrieved_, rhs.retrieved_);
+    }
+
+    // ============================ 操作 ============================
+
+    future<T> get_future() {
+        SUGAR_THROW_LOGIC_ERROR_IF(state_ == nullptr, "promise::get_future - no state");
+        SUGAR_THROW_LOGIC_ERROR_IF(retrieved_, "promise::get_future - future already retrieved");
+        retrieved_ = true;
+        state_->retain();
+        return future<T>(state_);
+    }
+
+    /**
+     * @brief 用 args 构造结果并唤醒等待者、执行续接；void 特化不带参数
+     */
+    template<typename... Args>
+    void set_value(Args&&... args) {
+        SUGAR_THROW_LOGIC_ERROR_IF(state_ == nullptr, "promise::set_value - no state");
+        SUGAR_THROW_LOGIC_ERROR_IF(state_->ready(), "promise::set_value - already satisfied");
+        state_->set_value(sugar::forward<Args>(args)...);
+    }
+
+    void set_exception(std::exception_ptr e) {
+        SUGAR_THROW_LOGIC_ERROR_IF(state_ == nullptr, "promise::set_exception - no state");
+        SUGAR_THROW_LOGIC_ERROR_IF(state_->ready(), "promise::set_exception - already satisfied");
+        state_->set_exception(e);
+    }
+};
+
+// ============================ 创建 future ============================
+
+/**
+ * @brief 在 executor 上执行 f()，返回其结果的 future；状态与任务共用一次分配
+ */
+template<typename F>
+future<typename decay<decltype(sugar::declval<F&>()())>::type> async(task_executor& executor, F&& f) {
+    typedef typename decay<decltype(sugar::declval<F&>()())>::type result_type;
+    typedef allocated_state<async_state<result_type, typename decay<F>::type>, allocator<char>> node_type;
+    node_type* node = node_type::create(allocator<char>(), sugar::forward<F>(f));
+    future<result_type> result(node);
+    executor.post(node);
+    return result;
+}
+
+/**
+ * @brief 在默认线程池上执行 f()
+ */
+template<typename F>
+future<typename decay<decltype(sugar::declval<F&>()())>::type> async(F&& f) {
+    return sugar::async(default_executor(), sugar::forward<F>(f));
+}
+
+template<typename T>
+future<typename decay<T>::type> make_ready_future(T&& value) {
+    typedef typename decay<T>::type value_type;
+    typedef allocated_state<future_state<value_type>, allocator<char>> node_type;
+    node_type* node = node_type::create(allocator<char>());
+    node->set_value(sugar::forward<T>(value));
+    return future<value_type>(node);
+}
+
+inline future<void> make_ready_future() {
+    typedef allocated_state<future_state<void>, allocator<char>> node_type;
+    node_type* node = node_type::create(allocator<char>());
+    node->set_value();
+    return future<void>(node);
+}
+
+template<typename T>
+future<T> make_exceptional_future(std::exception_ptr e) {
+    typedef allocated_state<future_state<T>, allocator<char>> node_type;
+    node_type* node = node_type::create(allocator<char>());
+    node->set_exception(e);
+    return future<T>(node);
+}
+
+// ============================ when_all / when_any ============================
+
+/**
+ * @brief when_all_state 类模板，所有输入完成后以输入本身作为结果
+ *
+ * 每个输入挂一个回调，回调各持有一份引用；计数多预留一份给挂回调的过程本身，
+ * 保证全部挂完之前结果不会被提前写入。
+ */
+template<typename T>
+class when_all_state : public future_state<vector<future<T>>> {
+private:
+    struct link : future_hook {
+        when_all_state* owner;
+    };
+
+    vector<future<T>> inputs_;
+    vector<link> links_;
+    std::atomic<size_t> remaining_;
+
+    void arrive() noexcept {
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->set_value(sugar::move(inputs_));
+        }
+    }
+
+    static void fire(future_hook* h) {
+        when_all_state* owner = static_cast<link*>(h)->owner;
+        owner->arrive();
+        owner->release();
+    }
+
+public:
+    when_all_state(void (*destroy)(future_state_base*), vector<future<T>>&& inputs)
+        : future_state<vector<future<T>>>(destroy), inputs_(sugar::move(inputs)), links_(inputs_.size()),
+          remaining_(inputs_.size() + 1) {}
+
+    void start() noexcept {
+        const size_t n = inputs_.size();
+        for (size_t i = 0; i < n; ++i) {
+            links_[i].owner = this;
+            links_[i].fire = &when_all_state::fire;
+            this->retain();
+            inputs_[i].state_->attach(&links_[i]);
+        }
+        arrive();
+    }
+};
+
+/**
+ * @brief when_any 的结果：最先完成的输入的下标，以及全部输入
+ */
+template<typename T>
+struct when_any_result {
+    size_t index;
+    vector<future<T>> futures;
+};
+
+/**
+ * @brief when_any_state 类模板，第一个输入完成时写入结果，其余回调到来时只释放引用
+ */
+template<typename T>
+class when_any_state : public future_state<when_any_result<T>> {
+private:
+    struct link : future_hook {
+        when_any_state* owner;
+        size_t index;
+    };
+
+    vector<future<T>> inputs_;
+    vector<link> links_;
+    std::atomic<size_t> winner_;
+    std::atomic<int> gate_;  // 第一个完成者与挂回调的过程各占一份，两者都到齐才写入结果
+
+    void open() noexcept {
+        if (gate_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            when_any_result<T> result;
+            result.index = winner_.load(std::memory_order_relaxed);
+            result.futures = sugar::move(inputs_);
+            this->set_value(sugar::move(result));
+        }
+    }
+
+    static void fire(future_hook* h) {
+        link* l = static_cast<link*>(h);
+        when_any_state* owner = l->owner;
+        size_t expected = static_cast<size_t>(-1);
+        if (owner->winner_.compare_exchange_strong(expected, l->index, std::memory_order_acq_rel)) {
+            owner->open();
+        }
+        owner->release();
+    }
+
+public:
+    when_any_state(void (*destroy)(future_state_base*), vector<future<T>>&& inputs)
+        : future_state<when_any_result<T>>(destroy), inputs_(sugar::move(inputs)), links_(inputs_.size()),
+          winner_(static_cast<size_t>(-1)), gate_(inputs_.empty() ? 1 : 2) {}
+
+    void start() noexcept {
+        const size_t n = inputs_.size();
+        for (size_t i = 0; i < n; ++i) {
+            links_[i].owner = this;
+            links_[i].index = i;
+            links_[i].fire = &when_any_state::fire;
+            this->retain();
+            inputs_[i].state_->attach(&links_[i]);
+        }
+        open();
+    }
+};
+
+/**
+ * @brief 所有输入完成后就绪，结果是按原顺序排列的输入（均已就绪）；输入为空时立即就绪
+ */
+template<typename T>
+future<vector<future<T>>> when_all(vector<future<T>> inputs) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        SUGAR_THROW_LOGIC_ERROR_IF(!inputs[i].valid(), "when_all - no state");
+    }
+    typedef allocated_state<when_all_state<T>, allocator<char>> node_type;
+    node_type* node = node_type::create(allocator<char>(), sugar::move(inputs));
+    future<vector<future<T>>> result(node);
+    node->start();
+    return result;
+}
+
+/**
+ * @brief 任一输入完成后就绪，结果给出最先完成者的下标；输入为空时立即就绪，下标为 size_t(-1)
+ */
+template<typename T>
+future<when_any_result<T>> when_any(vector<future<T>> inputs) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        SUGAR_THROW_LOGIC_ERROR_IF(!inputs[i].valid(), "when_any - no state");
+    }
+    typedef allocated_state<when_any_state<T>, allocator<char>> node_type;
+    node_type* node = node_type::create(allocator<char>(), sugar::move(inputs));
+    future<when_any_result<T>> result(node);
+    node->start();
+    return result;
+}
+
+} // namespace sugar
+
+#endif // FUTURE_H_
@@ -0,0 +1,312 @@
+/*
+ * @file histogram.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 直方图与计数排序：8/16位键的多子直方图内核、SSE2游程检测、
+ *        多线程分块统计后合并，以及基于直方图的计数排序
+ */
+
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+#include "algorithm.h"
+#include "numeric.h"
+#include "vector.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+namespace sugar {
+
+// ============================ 键类型分类 ============================
+
+struct histogram_generic_tag {};
+struct histogram_byte_tag {};
+struct histogram_u16_tag {};
+
+/**
+ * @brief 根据迭代器选择直方图内核：字节指针、uint16指针走专用内核，其余逐个计数
+ */
+template<typename It>
+struct histogram_kind {
+    typedef typename remove_cv<typename iterator_traits<It>::value_type>::type key_type;
+    typedef typename conditional<is_pointer<It>::value && is_char<key_type>::value, histogram_byte_tag,
+            typename conditional<is_pointer<It>::value && is_same<key_type, uint16_t>::value, histogram_u16_tag,
+                                 histogram_generic_tag>::type>::type type;
+};
+
+/**
+ * @brief 键值域已知（8位或16位）时的桶数，否则为0
+ */
+template<typename It>
+struct histogram_bins {
+    static const size_t value =
+        is_same<typename histogram_kind<It>::type, histogram_byte_tag>::value ? 256 :
+        is_same<typename histogram_kind<It>::type, histogram_u16_tag>::value ? 65536 : 0;
+};
+
+/**
+ * @brief 键对应的桶下标：字节一律按unsigned char取值
+ */
+inline size_t histogram_index(char key) { return static_cast<unsigned char>(key); }
+inline size_t histogram_index(signed char key) { return static_cast<unsigned char>(key); }
+inline size_t histogram_index(unsigned char key) { return key; }
+inline size_t histogram_index(uint16_t key) { return key; }
+
+/**
+ * @brief 排序时桶下标与键序的偏置：有符号字节按unsigned char统计，负数落在128~255号桶，
+ *        按 下标 ^ 0x80 的顺序遍历桶才是按值升序；无符号键不需要偏置
+ */
+template<typename Key>
+struct histogram_sort_bias {
+    static const size_t value = is_char<Key>::value && static_cast<Key>(-1) < static_cast<Key>(0) ? 0x80 : 0;
+};
+
+// ============================ 直方图内核 ============================
+
+/**
+ * @brief 字节直方图内核，结果累加到counts[256]
+ *
+ * 连续相同的字节会反复读改写同一个计数器，每次都要等上一次的存储转发完成。
+ * 这里把字节轮流分配到8个子直方图，相邻字节的写入落在不同计数器上；
+ * 每次读入16字节，SSE2下先检查是否整块相同，游程（如填充的0）直接加16。
+ * 子直方图用32位计数，每处理1GB折叠一次，避免溢出。
+ */
+inline void histogram_bytes(const unsigned char* p, size_t n, uint64_t* counts) {
+    const size_t block_limit = size_t(1) << 30;
+    uint32_t sub[8][256];
+    while (n > 0) {
+        const size_t block = n < block_limit ? n : block_limit;
+        const unsigned char* end = p + block;
+        std::memset(sub, 0, sizeof(sub));
+        while (end - p >= 16) {
+#if SUGAR_HAS_SSE2
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(p[0])))) == 0xffff) {
+                sub[0][p[0]] += 16;
+                p += 16;
+                continue;
+            }
+#endif
+            uint64_t a;
+            uint64_t b;
+            std::memcpy(&a, p, 8);
+            std::memcpy(&b, p + 8, 8);
+            ++sub[0][a & 0xff];
+            ++sub[1][(a >> 8) & 0xff];
+            ++sub[2][(a >> 16) & 0xff];
+            ++sub[3][(a >> 24) & 0xff];
+            ++sub[4][(a >> 32) & 0xff];
+            ++sub[5][(a >> 40) & 0xff];
+            ++sub[6][(a >> 48) & 0xff];
+            ++sub[7][a >> 56];
+            ++sub[0][b & 0xff];
+            ++sub[1][(b >> 8) & 0xff];
+            ++sub[2][(b >> 16) & 0xff];
+            ++sub[3][(b >> 24) & 0xff];
+            ++sub[4][(b >> 32) & 0xff];
+            ++sub[5][(b >> 40) & 0xff];
+            ++sub[6][(b >> 48) & 0xff];
+            ++sub[7][b >> 56];
+            p += 16;
+        }
+        for (; p != end; ++p) {
+            ++sub[0][*p];
+        }
+        for (size_t i = 0; i < 256; ++i) {
+            counts[i] += static_cast<uint64_t>(sub[0][i]) + sub[1][i] + sub[2][i] + sub[3][i] +
+                         sub[4][i] + sub[5][i] + sub[6][i] + sub[7][i];
+        }
+        n -= block;
+    }
+}
+
+/**
+ * @brief 16位直方图内核，结果累加到counts[65536]；两个子直方图共512KB，放在堆上
+ */
+inline void histogram_u16(const uint16_t* p, size_t n, uint64_t* counts) {
+    const size_t block_limit = size_t(1) << 31;
+    vector<uint32_t> sub(2 * 65536);
+    uint32_t* even = sub.data();
+    uint32_t* odd = even + 65536;
+    while (n > 0) {
+        const size_t block = n < block_limit ? n : block_limit;
+        const uint16_t* end = p + block;
+        sugar::fill(sub.begin(), sub.end(), 0u);
+        while (end - p >= 4) {
+            uint64_t a;
+            std::memcpy(&a, p, 8);
+            ++even[a & 0xffff];
+            ++odd[(a >> 16) & 0xffff];
+            ++even[(a >> 32) & 0xffff];
+            ++odd[a >> 48];
+            p += 4;
+        }
+        for (; p != end; ++p) {
+            ++even[*p];
+        }
+        for (size_t i = 0; i < 65536; ++i) {
+            counts[i] += static_cast<uint64_t>(even[i]) + odd[i];
+        }
+        n -= block;
+    }
+}
+
+template<typename InputIt, typename CountIt>
+void histogram_dispatch(InputIt first, InputIt last, CountIt bins, histogram_generic_tag) {
+    for (; first != last; ++first) {
+        ++bins[*first];
+    }
+}
+
+template<typename Pointer, typename CountIt>
+void histogram_dispatch(Pointer first, Pointer last, CountIt bins, histogram_byte_tag) {
+    uint64_t counts[256] = {0};
+    sugar::histogram_bytes(reinterpret_cast<const unsigned char*>(first), static_cast<size_t>(last - first), counts);
+    for (size_t i = 0; i < 256; ++i) {
+        bins[i] += counts[i];
+    }
+}
+
+template<typename Pointer, typename CountIt>
+void histogram_dispatch(Pointer first, Pointer last, CountIt bins, histogram_u16_tag) {
+    vector<uint64_t> counts(65536, 0);
+    sugar::histogram_u16(first, static_cast<size_t>(last - first), counts.data());
+    for (size_t i = 0; i < 65536; ++i) {
+        bins[i] += counts[i];
+    }
+}
+
+// ============================ 直方图 ============================
+
+/**
+ * @brief 统计[first, last)中每个键出现的次数，累加到bins[键]
+ *
+ * 字节指针（按unsigned char取值，256个桶）与uint16_t指针（65536个桶）走多子直方图内核；
+ * 其他迭代器逐个执行++bins[*it]，键必须是bins的合法下标。
+ *
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param bins 计数数组的随机访问迭代器，调用前应清零或保留上次的累计值
+ */
+template<typename InputIt, typename CountIt>
+void histogram(InputIt first, InputIt last, CountIt bins) {
+    sugar::histogram_dispatch(first, last, bins, typename histogram_kind<InputIt>::type());
+}
+
+/**
+ * @brief 多线程直方图：每个线程统计一块到自己的局部直方图，最后按桶合并
+ *
+ * 仅支持键值域已知的字节与uint16_t指针。
+ *
+ * @param first 起始指针
+ * @param last 结束指针
+ * @param bins 计数数组，按键累加
+ * @param threads 线程数，0表示使用硬件并发数
+ */
+template<typename Pointer, typename CountIt>
+void parallel_histogram(Pointer first, Pointer last, CountIt bins, size_t threads = 0) {
+    static_assert(histogram_bins<Pointer>::value != 0,
+                  "parallel_histogram requires pointers to 8-bit or uint16_t keys");
+    const size_t bin_count = histogram_bins<Pointer>::value;
+    const size_t n = static_cast<size_t>(last - first);
+    if (threads == 0) {
+        threads = sugar::default_thread_count();
+    }
+    // 每块至少64KB，否则合并局部直方图的开销不划算
+    if (threads > n / 65536 + 1) {
+        threads = n / 65536 + 1;
+    }
+    if (threads <= 1) {
+        sugar::histogram(first, last, bins);
+        return;
+    }
+    vector<uint64_t> local(threads * bin_count, 0);
+    vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.push_back(std::thread([=, &local]() {
+            sugar::histogram(first + chunk_begin(n, threads, t), first + chunk_begin(n, threads, t + 1),
+                             local.data() + t * bin_count);
+        }));
+    }
+    sugar::histogram(first, first + chunk_begin(n, threads, 1), local.data());
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    for (size_t i = 0; i < bin_count; ++i) {
+        uint64_t sum = 0;
+        for (size_t t = 0; t < threads; ++t) {
+            sum += local[t * bin_count + i];
+        }
+        bins[i] += sum;
+    }
+}
+
+// ============================ 计数排序 ============================
+
+/**
+ * @brief 对8位键（char / signed char / unsigned char）或uint16_t键原地计数排序：
+ *        先统计直方图，再按键值升序逐桶写回，O(n + 值域)
+ * @param first 起始指针
+ * @param last 结束指针
+ */
+template<typename Pointer>
+void counting_sort(Pointer first, Pointer last) {
+    static_assert(histogram_bins<Pointer>::value != 0, "counting_sort requires pointers to 8-bit or uint16_t keys");
+    typedef typename remove_cv<typename iterator_traits<Pointer>::value_type>::type key_type;
+    const size_t bin_count = histogram_bins<Pointer>::value;
+    const size_t bias = histogram_sort_bias<key_type>::value;
+    vector<uint64_t> counts(bin_count, 0);
+    sugar::histogram(first, last, counts.data());
+    // 字节按unsigned char取值统计；有符号字节从负数所在的高半部分桶开始写回
+    for (size_t rank = 0; rank < bin_count; ++rank) {
+        const size_t bin = rank ^ bias;
+        first = sugar::fill_n(first, counts[bin], static_cast<key_type>(bin));
+    }
+}
+
+/**
+ * @brief 按小值域键的稳定计数排序：把[first, last)按key(元素)升序写入d_first
+ *
+ * 先把键提取到连续数组用直方图内核统计，再做前缀和得到每个桶的起点，最后按原顺序分发。
+ *
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标随机访问迭代器，不能与输入重叠
+ * @param key 键函数，返回char / signed char / unsigned char或uint16_t，按键值升序
+ * @return 目标区间末尾
+ */
+template<typename RandomIt, typename OutputIt, typename KeyFunc>
+OutputIt counting_sort(RandomIt first, RandomIt last, OutputIt d_first, KeyFunc key) {
+    typedef typename remove_cv<typename remove_reference<decltype(key(*first))>::type>::type key_type;
+    static_assert(histogram_bins<key_type*>::value != 0, "counting_sort key must be an 8-bit or uint16_t key");
+    const size_t bin_count = histogram_bins<key_type*>::value;
+    const size_t bias = histogram_sort_bias<key_type>::value;
+    const size_t n = static_cast<size_t>(last - first);
+    vector<key_type> keys(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = key(first[i]);
+    }
+    vector<uint64_t> offsets(bin_count, 0);
+    sugar::histogram(keys.data(), keys.data() + n, offsets.data());
+    uint64_t running = 0;
+    for (size_t rank = 0; rank < bin_count; ++rank) {
+        const size_t bin = rank ^ bias;
+        const uint64_t c = offsets[bin];
+        offsets[bin] = running;
+        running += c;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        d_first[static_cast<ptrdiff_t>(offsets[sugar::histogram_index(keys[i])]++)] = first[i];
+    }
+    return d_first + static_cast<ptrdiff_t>(n);
+}
+
+} // namespace sugar
+
+#endif // HISTOGRAM_H_
@@ -0,0 +1,627 @@
+/*
+ * @file hive.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 蜂巢容器：hive 按块存放元素，删除只在跳跃域中标记空洞，
+ *        元素地址在其生命周期内不变；遍历时整段跳过空洞，空块整块释放
+ */
+
+#ifndef HIVE_H_
+#define HIVE_H_
+
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "utility.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace sugar {
+
+// ============================ hive 类模板 ============================
+
+/**
+ * @brief hive 类模板，删除O(1)、指针稳定的无序容器
+ *
+ * 元素放在容量递增（8到8192）的块中，块之间串成双向链表。每个块有一个跳跃域：
+ * 存活元素为0，连续的空洞段在首尾两个位置记录段长，因此向前或向后遍历时
+ * 一步跳过整段空洞。每段空洞的首个槽位借用元素的存储，串成块内的空闲段链表；
+ * 有空洞的块再串成一个链表，插入时优先复用空洞，其次追加到最后一个块，最后才分配新块。
+ * 块变空时立即释放（保留一个备用块，避免在边界上反复分配）。
+ *
+ * 插入不会移动已有元素，删除只影响被删元素，指向其他元素的指针和迭代器始终有效。
+ * 元素的遍历顺序不是插入顺序。
+ *
+ * @tparam T 元素类型
+ */
+template<typename T>
+class hive {
+    struct block;
+
+    // 空洞段首个槽位中保存的链接
+    struct free_link {
+        uint16_t prev;
+        uint16_t next;
+    };
+
+    static const size_t slot_bytes = sizeof(T) > sizeof(free_link) ? sizeof(T) : sizeof(free_link);
+
+    struct slot {
+        alignas(T) alignas(free_link) unsigned char bytes[slot_bytes];
+    };
+
+    static const uint16_t nil = 0xffff;
+    static const size_t min_block = 8;
+    static const size_t max_block = 8192;
+
+    /**
+     * @brief 元素块：slots与skip在同一次分配中，skip多一个哨兵位（恒为0）
+     */
+    struct block {
+        slot* slots;
+        uint16_t* skip;
+        block* prev;
+        block* next;
+        block* prev_free;      // 有空洞的块组成的链表
+        block* next_free;
+        uint16_t capacity;
+        uint16_t top;          // [0, top) 的槽位被使用过
+        uint16_t size;         // 存活元素个数
+        uint16_t free_head;    // 第一个空洞段的起点
+
+        T* element(size_t i) { return reinterpret_cast<T*>(slots[i].bytes); }
+        free_link& link(size_t i) { return *reinterpret_cast<free_link*>(slots[i].bytes); }
+    };
+
+public:
+    // ============================ 迭代器 ============================
+
+    /**
+     * @brief hive 的双向迭代器：块指针加块内下标
+     */
+    template<bool IsConst>
+    class hive_iterator {
+        friend class hive;
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = typename conditional<IsConst, const T*, T*>::type;
+        using reference = typename conditional<IsConst, const T&, T&>::type;
+
+    private:
+        block* b_;
+        size_t i_;
+
+        hive_iterator(block* b, size_t i) : b_(b), i_(i) {}
+
+    public:
+        hive_iterator() : b_(nullptr), i_(0) {}
+
+        // 非const迭代器可以转换为const迭代器
+        template<bool OtherConst, typename = typename enable_if<IsConst && !OtherConst>::type>
+        hive_iterator(const hive_iterator<OtherConst>& other) : b_(other.b_), i_(other.i_) {}
+
+        reference operator*() const { return *b_->element(i_); }
+        pointer operator->() const { return b_->element(i_); }
+
+        hive_iterator& operator++() {
+            ++i_;
+            i_ += b_->skip[i_];
+            if (i_ == b_->top && b_->next != nullptr) {
+                b_ = b_->next;
+                i_ = b_->skip[0];
+            }
+            return *this;
+        }
+
+        hive_iterator operator++(int) {
+            hive_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        hive_iterator& operator--() {
+            for (;;) {
+                if (i_ == 0) {
+                    b_ = b_->prev;
+                    i_ = b_->top;
+                }
+                --i_;
+                if (b_->skip[i_] == 0) {
+                    return *this;
+                }
+                // 落在空洞段的末尾，跳到段首；段首之前要么是存活元素，要么是块的开头
+                i_ = i_ + 1 - b_->skip[i_];
+            }
+        }
+
+        hive_iterator operator--(int) {
+            hive_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        friend bool operator==(const hive_iterator& a, const hive_iterator& b) {
+            return a.b_ == b.b_ && a.i_ == b.i_;
+        }
+
+        friend bool operator!=(const hive_iterator& a, const hive_iterator& b) {
+            return !(a == b);
+        }
+
+        template<bool>
+        friend class hive_iterator;
+    };
+
+    // ============================ 类型定义 ============================
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = hive_iterator<false>;
+    using const_iterator = hive_iterator<true>;
+
+private:
+    // ============================ 私有成员 ============================
+    block* head_;
+    block* tail_;
+    block* free_blocks_;    // 有空洞的块
+    block* spare_;          // 备用空块
+    size_type size_;
+    size_type capacity_;
+
+    // ============================ 私有辅助函数 ============================
+
+    /**
+     * @brief 块的元素区与skip数组合计字节数
+     */
+    static size_t block_bytes(size_t capacity) noexcept {
+        return capacity * sizeof(slot) + (capacity + 1) * sizeof(uint16_t);
+    }
+
+    static block* allocate_block(size_t capacity) {
+        unsigned char* raw = static_cast<unsigned char*>(sugar::allocate(block_bytes(capacity)));
+        void* header;
+        try {
+            header = sugar::allocate(sizeof(block));
+        } catch (...) {
+            sugar::deallocate(raw, block_bytes(capacity));
+            throw;
+        }
+        block* b = ::new (header) block;
+        b->slots = reinterpret_cast<slot*>(raw);
+        b->skip = reinterpret_cast<uint16_t*>(raw + capacity * sizeof(slot));
+        b->capacity = static_cast<uint16_t>(capacity);
+        reset_block(b);
+        return b;
+    }
+
+    static void reset_block(block* b) {
+        std::memset(b->skip, 0, (b->capacity + size_t(1)) * sizeof(uint16_t));
+        b->prev = b->next = nullptr;
+        b->prev_free = b->next_free = nullptr;
+        b->top = 0;
+        b->size = 0;
+        b->free_head = nil;
+    }
+
+    static void deallocate_block(block* b) {
+        sugar::deallocate(b->slots, block_bytes(b->capacity));
+        b->~block();
+        sugar::deallocate(b, sizeof(block));
+    }
+
+    /**
+     * @brief 析构块中全部存活元素
+     */
+    static void destroy_elements(block* b) {
+        for (size_t i = b->skip[0]; i < b->top; ++i, i += b->skip[i]) {
+            b->element(i)->~T();
+        }
+    }
+
+    void link_free_block(block* b) {
+        b->prev_free = nullptr;
+        b->next_free = free_blocks_;
+        if (free_blocks_ != nullptr) {
+            free_blocks_->prev_free = b;
+        }
+        free_blocks_ = b;
+    }
+
+    void unlink_free_block(block* b) {
+        if (b->prev_free != nullptr) {
+            b->prev_free->next_free = b->next_free;
+        } else {
+            free_blocks_ = b->next_free;
+        }
+        if (b->next_free != nullptr) {
+            b->next_free->prev_free = b->prev_free;
+        }
+        b->prev_free = b->next_free = nullptr;
+    }
+
+    // 块内空闲段链表
+    static void push_run(block* b, uint16_t start) {
+        b->link(start).prev = nil;
+        b->link(start).next = b->free_head;
+        if (b->free_head != nil) {
+            b->link(b->free_head).prev = start;
+        }
+        b->free_head = start;
+    }
+
+    static void remove_run(block* b, uint16_t start) {
+        const free_link l = b->link(start);
+        if (l.prev != nil) {
+            b->link(l.prev).next = l.next;
+        } else {
+            b->free_head = l.next;
+        }
+        if (l.next != nil) {
+            b->link(l.next).prev = l.prev;
+        }
+    }
+
+    /**
+     * @brief 把空闲段的起点从from换成to（链表位置不变）
+     */
+    static void move_run(block* b, uint16_t from, uint16_t to) {
+        const free_link l = b->link(from);
+        b->link(to) = l;
+        if (l.prev != nil) {
+            b->link(l.prev).next = to;
+        } else {
+            b->free_head = to;
+        }
+        if (l.next != nil) {
+            b->link(l.next).prev = to;
+        }
+    }
+
+    /**
+     * @brief 选一个可写入的槽位：优先复用空洞，其次块尾，最后追加新块
+     */
+    iterator acquire_slot() {
+        if (free_blocks_ != nullptr) {
+            block* b = free_blocks_;
+            const uint16_t start = b->free_head;
+            const uint16_t len = b->skip[start];
+            if (len == 1) {
+                remove_run(b, start);
+                if (b->free_head == nil) {
+                    unlink_free_block(b);
+                }
+            } else {
+                // 段缩短一格，起点后移
+                const uint16_t next = static_cast<uint16_t>(start + 1);
+                move_run(b, start, next);
+                b->skip[next] = static_cast<uint16_t>(len - 1);
+                b->skip[start + len - 1] = static_cast<uint16_t>(len - 1);
+            }
+            b->skip[start] = 0;
+            return iterator(b, start);
+        }
+        if (tail_ == nullptr || tail_->top == tail_->capacity) {
+            block* b;
+            if (spare_ != nullptr) {
+                b = spare_;
+                spare_ = nullptr;
+            } else {
+                size_t cap = size_ < min_block ? min_block : size_;
+                cap = cap > max_block ? max_block : cap;
+                b = allocate_block(cap);
+                capacity_ += cap;
+            }
+            b->prev = tail_;
+            if (tail_ != nullptr) {
+                tail_->next = b;
+            } else {
+                head_ = b;
+            }
+            tail_ = b;
+        }
+        return iterator(tail_, tail_->top++);
+    }
+
+    /**
+     * @brief 槽位构造成功后的簿记
+     */
+    iterator commit(iterator it) {
+        ++it.b_->size;
+        ++size_;
+        return it;
+    }
+
+    /**
+     * @brief 构造失败时把槽位退回（重新标记为空洞）
+     */
+    void rollback(iterator it) {
+        ++it.b_->size;    // mark_erased 会减回去
+        mark_erased(it.b_, it.i_);
+        if (it.b_->size == 0) {
+            release_block(it.b_);
+        }
+    }
+
+    /**
+     * @brief 把块b的第i个槽位标记为空洞，合并相邻空洞段并维护空闲段链表
+     */
+    void mark_erased(block* b, size_t i) {
+        const bool left = i > 0 && b->skip[i - 1] != 0;
+        const bool right = b->skip[i + 1] != 0;
+        const bool had_runs = b->free_head != nil;
+        if (left && right) {
+            const size_t start = i - b->skip[i - 1];
+            const size_t end = i + b->skip[i + 1];
+            remove_run(b, static_cast<uint16_t>(i + 1));
+            const uint16_t len = static_cast<uint16_t>(end - start + 1);
+            b->skip[start] = len;
+            b->skip[end] = len;
+            b->skip[i] = 1;
+        } else if (left) {
+            const size_t start = i - b->skip[i - 1];
+            const uint16_t len = static_cast<uint16_t>(b->skip[i - 1] + 1);
+            b->skip[start] = len;
+            b->skip[i] = len;
+        } else if (right) {
+            const size_t end = i + b->skip[i + 1];
+            const uint16_t len = static_cast<uint16_t>(b->skip[i + 1] + 1);
+            move_run(b, static_cast<uint16_t>(i + 1), static_cast<uint16_t>(i));
+            b->skip[i] = len;
+            b->skip[end] = len;
+        } else {
+            b->skip[i] = 1;
+            push_run(b, static_cast<uint16_t>(i));
+        }
+        --b->size;
+        if (!had_runs) {
+            link_free_block(b);
+        }
+    }
+
+    /**
+     * @brief 从块链表中摘下空块，留作备用或释放
+     */
+    void release_block(block* b) {
+        unlink_free_block(b);
+        if (b->prev != nullptr) {
+            b->prev->next = b->next;
+        } else {
+            head_ = b->next;
+        }
+        if (b->next != nullptr) {
+            b->next->prev = b->prev;
+        } else {
+            tail_ = b->prev;
+        }
+        if (spare_ == nullptr) {
+            reset_block(b);
+            spare_ = b;
+        } else {
+            capacity_ -= b->capacity;
+            deallocate_block(b);
+        }
+    }
+
+    void swap_members(hive& other) noexcept {
+        sugar::swap(head_, other.head_);
+        sugar::swap(tail_, other.tail_);
+        sugar::swap(free_blocks_, other.free_blocks_);
+        sugar::swap(spare_, other.spare_);
+        sugar::swap(size_, other.size_);
+        sugar::swap(capacity_, other.capacity_);
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    hive() noexcept : head_(nullptr), tail_(nullptr), free_blocks_(nullptr), spare_(nullptr), size_(0), capacity_(0) {}
+
+    hive(const hive& other) : hive() {
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            insert(*it);
+        }
+    }
+
+    hive(hive&& other) noexcept : hive() {
+        swap_members(other);
+    }
+
+    hive& operator=(const hive& other) {
+        if (this != &other) {
+            hive tmp(other);
+            swap_members(tmp);
+        }
+        return *this;
+    }
+
+    hive& operator=(hive&& other) noexcept {
+        if (this != &other) {
+            hive tmp(sugar::move(other));
+            swap_members(tmp);
+        }
+        return *this;
+    }
+
+    ~hive() {
+        clear();
+        if (spare_ != nullptr) {
+            deallocate_block(spare_);
+        }
+    }
+
+    // ============================ 迭代器 ============================
+
+    iterator begin() noexcept {
+        return head_ == nullptr ? iterator() : iterator(head_, head_->skip[0]);
+    }
+
+    iterator end() noexcept {
+        return tail_ == nullptr ? iterator() : iterator(tail_, tail_->top);
+    }
+
+    const_iterator begin() const noexcept {
+        return head_ == nullptr ? const_iterator() : const_iterator(head_, head_->skip[0]);
+    }
+
+    const_iterator end() const noexcept {
+        return tail_ == nullptr ? const_iterator() : const_iterator(tail_, tail_->top);
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief 已分配的槽位总数（含备用块）
+     */
+    size_type capacity() const noexcept { return capacity_; }
+
+    // ============================ 修改操作 ============================
+
+    iterator insert(const T& value) {
+        iterator it = acquire_slot();
+        try {
+            ::new (static_cast<void*>(it.b_->element(it.i_))) T(value);
+        } catch (...) {
+            rollback(it);
+            throw;
+        }
+        return commit(it);
+    }
+
+    iterator insert(T&& value) {
+        iterator it = acquire_slot();
+        try {
+            ::new (static_cast<void*>(it.b_->element(it.i_))) T(sugar::move(value));
+        } catch (...) {
+            rollback(it);
+            throw;
+        }
+        return commit(it);
+    }
+
+    template<typename... Args>
+    iterator emplace(Args&&... args) {
+        iterator it = acquire_slot();
+        try {
+            ::new (static_cast<void*>(it.b_->element(it.i_))) T(sugar::forward<Args>(args)...);
+        } catch (...) {
+            rollback(it);
+            throw;
+        }
+        return commit(it);
+    }
+
+    /**
+     * @brief 删除迭代器指向的元素，O(1)
+     * @return 下一个元素的迭代器
+     */
+    iterator erase(const_iterator pos) {
+        SUGAR_DEBUG(pos.b_ != nullptr && pos.i_ < pos.b_->top && pos.b_->skip[pos.i_] == 0);
+        block* b = pos.b_;
+        const size_t i = pos.i_;
+        iterator next(b, i);
+        ++next;
+        b->element(i)->~T();
+        --size_;
+        mark_erased(b, i);
+        if (b->size == 0) {
+            const bool last = b == tail_;
+            release_block(b);
+            if (last) {
+                return end();
+            }
+        }
+        return next;
+    }
+
+    /**
+     * @brief 由元素地址取得迭代器，地址必须指向本容器中的存活元素；按块线性查找
+     */
+    iterator get_iterator(const T* p) noexcept {
+        const unsigned char* addr = reinterpret_cast<const unsigned char*>(p);
+        for (block* b = head_; b != nullptr; b = b->next) {
+            const unsigned char* first = reinterpret_cast<const unsigned char*>(b->slots);
+            if (addr >= first && addr < first + b->capacity * sizeof(slot)) {
+                return iterator(b, static_cast<size_t>(addr - first) / sizeof(slot));
+            }
+        }
+        return end();
+    }
+
+    /**
+     * @brief 删除满足pred的全部元素
+     * @return 删除的个数
+     */
+    template<typename Pred>
+    size_type erase_if(Pred pred) {
+        const size_type before = size_;
+        for (iterator it = begin(); it != end();) {
+            if (pred(*it)) {
+                it = erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return before - size_;
+    }
+
+    /**
+     * @brief 删除全部元素并释放所有块（保留一个备用块）
+     */
+    void clear() noexcept {
+        block* b = head_;
+        while (b != nullptr) {
+            block* next = b->next;
+            destroy_elements(b);
+            if (spare_ == nullptr) {
+                reset_block(b);
+                spare_ = b;
+            } else {
+                capacity_ -= b->capacity;
+                deallocate_block(b);
+            }
+            b = next;
+        }
+        head_ = tail_ = free_blocks_ = nullptr;
+        size_ = 0;
+    }
+
+    /**
+     * @brief 释放备用块
+     */
+    void trim() noexcept {
+        if (spare_ != nullptr) {
+            capacity_ -= spare_->capacity;
+            deallocate_block(spare_);
+            spare_ = nullptr;
+        }
+    }
+
+    void swap(hive& other) noexcept {
+        swap_members(other);
+    }
+};
+
+template<typename T>
+void swap(hive<T>& lhs, hive<T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace sugar
+
+#endif // HIVE_H_
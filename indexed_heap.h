@@ -0,0 +1,676 @@
+/*
+ * @file indexed_heap.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 可寻址堆：indexed_heap（d叉+位置索引）、pairing_heap、radix_heap，
+ *        支持按句柄decrease_key/erase，存储全部位于sugar::vector中
+ */
+
+#ifndef INDEXED_HEAP_H_
+#define INDEXED_HEAP_H_
+
+#include "vector.h"
+#include "functional.h"
+#include "utility.h"
+#include "type_traits.h"
+#include "exceptdef.h"
+#include <cstddef>
+
+namespace sugar {
+
+// ============================ indexed_heap 类模板 ============================
+
+/**
+ * @brief indexed_heap 类模板，带位置索引的d叉堆
+ *
+ * 元素由用户给定的整数句柄 [0, capacity) 标识，pos_ 数组记录每个句柄在堆中的位置，
+ * 因此 decrease_key / update / erase 都是 O(log n)，不需要惰性删除。
+ * 与priority_queue不同，top()返回按comp最小的元素，便于最短路径类算法直接使用。
+ *
+ * @tparam Key 优先级类型
+ * @tparam Compare 比较函数，默认为sugar::less<Key>（小顶堆）
+ * @tparam Arity 堆的叉数，默认为4
+ */
+template<typename Key, typename Compare = less<Key>, size_t Arity = 4>
+class indexed_heap {
+    static_assert(Arity >= 2, "indexed_heap arity must be at least 2");
+
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using key_compare = Compare;
+    using size_type = size_t;
+    using handle_type = size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    /**
+     * @brief 堆节点：优先级与句柄放在一起，下沉比较时无需再间接访问
+     */
+    struct node {
+        Key key;
+        handle_type handle;
+    };
+
+    // ============================ 私有成员 ============================
+    vector<node> heap_;        // d叉堆
+    vector<size_type> pos_;    // 句柄 -> 堆中位置，不在堆中为npos
+    Compare comp_;             // 比较函数
+
+    // ============================ 私有辅助函数 ============================
+
+    void place(size_type i, node&& n) {
+        pos_[n.handle] = i;
+        heap_[i] = sugar::move(n);
+    }
+
+    void sift_up(size_type hole, node n) {
+        while (hole > 0) {
+            size_type parent = (hole - 1) / Arity;
+            if (!comp_(n.key, heap_[parent].key)) {
+                break;
+            }
+            place(hole, sugar::move(heap_[parent]));
+            hole = parent;
+        }
+        place(hole, sugar::move(n));
+    }
+
+    void sift_down(size_type hole, node n) {
+        size_type size = heap_.size();
+        for (;;) {
+            size_type child = Arity * hole + 1;
+            if (child >= size) {
+                break;
+            }
+            size_type best = child;
+            size_type end = child + Arity < size ? child + Arity : size;
+            for (size_type i = child + 1; i < end; ++i) {
+                if (comp_(heap_[i].key, heap_[best].key)) {
+                    best = i;
+                }
+            }
+            if (!comp_(heap_[best].key, n.key)) {
+                break;
+            }
+            place(hole, sugar::move(heap_[best]));
+            hole = best;
+        }
+        place(hole, sugar::move(n));
+    }
+
+    void check_handle(handle_type h) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(h >= pos_.size(), "indexed_heap - handle out of range");
+    }
+
+    void check_contains(handle_type h) const {
+        check_handle(h);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(pos_[h] == npos, "indexed_heap - handle not in heap");
+    }
+
+    /**
+     * @brief 从位置i移除元素，并用堆尾元素填补
+     */
+    void remove_at(size_type i) {
+        pos_[heap_[i].handle] = npos;
+        size_type last = heap_.size() - 1;
+        if (i == last) {
+            heap_.pop_back();
+            return;
+        }
+        node tail = sugar::move(heap_[last]);
+        heap_.pop_back();
+        if (i > 0 && comp_(tail.key, heap_[(i - 1) / Arity].key)) {
+            sift_up(i, sugar::move(tail));
+        } else {
+            sift_down(i, sugar::move(tail));
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param capacity 句柄的取值范围 [0, capacity)
+     * @param comp 比较函数
+     */
+    explicit indexed_heap(size_type capacity = 0, const Compare& comp = Compare())
+        : heap_(), pos_(capacity, npos), comp_(comp) {}
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept {
+        return heap_.empty();
+    }
+
+    size_type size() const noexcept {
+        return heap_.size();
+    }
+
+    /**
+     * @brief 句柄的取值范围
+     */
+    size_type capacity() const noexcept {
+        return pos_.size();
+    }
+
+    /**
+     * @brief 扩大句柄的取值范围
+     * @param capacity 新的句柄取值范围
+     */
+    void reserve_handles(size_type capacity) {
+        if (capacity > pos_.size()) {
+            pos_.resize(capacity, npos);
+        }
+    }
+
+    // ============================ 查询 ============================
+
+    /**
+     * @brief 判断句柄是否在堆中
+     */
+    bool contains(handle_type h) const {
+        return h < pos_.size() && pos_[h] != npos;
+    }
+
+    /**
+     * @brief 获取堆顶句柄
+     */
+    handle_type top() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(heap_.empty(), "indexed_heap::top - heap is empty");
+        return heap_[0].handle;
+    }
+
+    /**
+     * @brief 获取堆顶优先级
+     */
+    const key_type& top_key() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(heap_.empty(), "indexed_heap::top_key - heap is empty");
+        return heap_[0].key;
+    }
+
+    /**
+     * @brief 获取句柄当前的优先级
+     */
+    const key_type& key(handle_type h) const {
+        check_contains(h);
+        return heap_[pos_[h]].key;
+    }
+
+    // ============================ 修改器 ============================
+
+    /**
+     * @brief 插入句柄
+     * @param h 句柄，必须不在堆中
+     * @param k 优先级
+     */
+    void push(handle_type h, const key_type& k) {
+        check_handle(h);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(pos_[h] != npos, "indexed_heap::push - handle already in heap");
+        node n;
+        n.key = k;
+        n.handle = h;
+        heap_.push_back(n);
+        sift_up(heap_.size() - 1, sugar::move(n));
+    }
+
+    /**
+     * @brief 弹出堆顶
+     * @return 被弹出的句柄
+     */
+    handle_type pop() {
+        SUGAR_THROW_OUT_OF_RANGE_IF(heap_.empty(), "indexed_heap::pop - heap is empty");
+        handle_type h = heap_[0].handle;
+        remove_at(0);
+        return h;
+    }
+
+    /**
+     * @brief 提升句柄的优先级（按comp变小）
+     * @param h 句柄
+     * @param k 新的优先级，不得劣于当前优先级
+     */
+    void decrease_key(handle_type h, const key_type& k) {
+        check_contains(h);
+        size_type i = pos_[h];
+        SUGAR_THROW_INVALID_ARGUMENT_IF(comp_(heap_[i].key, k), "indexed_heap::decrease_key - key would increase");
+        node n;
+        n.key = k;
+        n.handle = h;
+        sift_up(i, sugar::move(n));
+    }
+
+    /**
+     * @brief 修改句柄的优先级（任意方向）
+     */
+    void update(handle_type h, const key_type& k) {
+        check_contains(h);
+        size_type i = pos_[h];
+        bool up = comp_(k, heap_[i].key);
+        node n;
+        n.key = k;
+        n.handle = h;
+        if (up) {
+            sift_up(i, sugar::move(n));
+        } else {
+            sift_down(i, sugar::move(n));
+        }
+    }
+
+    /**
+     * @brief 若句柄不在堆中则插入，否则在新优先级更优时提升（Dijkstra 松弛操作）
+     * @return 如果堆发生变化返回true
+     */
+    bool push_or_decrease(handle_type h, const key_type& k) {
+        if (!contains(h)) {
+            push(h, k);
+            return true;
+        }
+        if (comp_(k, heap_[pos_[h]].key)) {
+            decrease_key(h, k);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 按句柄删除
+     */
+    void erase(handle_type h) {
+        check_contains(h);
+        remove_at(pos_[h]);
+    }
+
+    /**
+     * @brief 清空堆，O(size)
+     */
+    void clear() {
+        for (size_type i = 0; i < heap_.size(); ++i) {
+            pos_[heap_[i].handle] = npos;
+        }
+        heap_.clear();
+    }
+};
+
+template<typename Key, typename Compare, size_t Arity>
+constexpr typename indexed_heap<Key, Compare, Arity>::size_type indexed_heap<Key, Compare, Arity>::npos;
+
+// ============================ pairing_heap 类模板 ============================
+
+/**
+ * @brief pairing_heap 类模板，可寻址配对堆
+ *
+ * 节点按句柄存放在一个sugar::vector中，链接全部是下标而非指针；
+ * push/decrease_key 为O(1)，pop为均摊O(log n)，适合decrease_key远多于pop的负载。
+ *
+ * @tparam Key 优先级类型
+ * @tparam Compare 比较函数，默认为sugar::less<Key>（小顶堆）
+ */
+template<typename Key, typename Compare = less<Key>>
+class pairing_heap {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using key_compare = Compare;
+    using size_type = size_t;
+    using handle_type = size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    /**
+     * @brief 节点：prev 指向左兄弟，若为最左孩子则指向父节点
+     */
+    struct node {
+        Key key;
+        size_type child;
+        size_type sibling;
+        size_type prev;
+        bool in_heap;
+
+        node() : key(), child(npos), sibling(npos), prev(npos), in_heap(false) {}
+    };
+
+    // ============================ 私有成员 ============================
+    vector<node> nodes_;         // 句柄 -> 节点
+    vector<size_type> scratch_;  // pop时两趟合并的临时缓冲，复用以避免分配
+    size_type root_;
+    size_type size_;
+    Compare comp_;
+
+    // ============================ 私有辅助函数 ============================
+
+    size_type meld(size_type a, size_type b) {
+        if (a == npos) return b;
+        if (b == npos) return a;
+        if (comp_(nodes_[b].key, nodes_[a].key)) {
+            sugar::swap(a, b);
+        }
+        // b 成为 a 的最左孩子
+        node& na = nodes_[a];
+        node& nb = nodes_[b];
+        nb.sibling = na.child;
+        if (na.child != npos) {
+            nodes_[na.child].prev = b;
+        }
+        nb.prev = a;
+        na.child = b;
+        na.sibling = npos;
+        na.prev = npos;
+        return a;
+    }
+
+    /**
+     * @brief 两趟合并：先从左到右两两配对，再从右到左依次合并
+     */
+    size_type merge_pairs(size_type first) {
+        if (first == npos) {
+            return npos;
+        }
+        scratch_.clear();
+        while (first != npos) {
+            size_type a = first;
+            size_type b = nodes_[a].sibling;
+            first = b == npos ? npos : nodes_[b].sibling;
+            nodes_[a].sibling = npos;
+            nodes_[a].prev = npos;
+            if (b != npos) {
+                nodes_[b].sibling = npos;
+                nodes_[b].prev = npos;
+            }
+            scratch_.push_back(meld(a, b));
+        }
+        size_type result = scratch_.back();
+        for (size_type i = scratch_.size() - 1; i > 0; --i) {
+            result = meld(scratch_[i - 1], result);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 把非根节点h连同子树从父节点上剪下
+     */
+    void cut(size_type h) {
+        node& n = nodes_[h];
+        if (nodes_[n.prev].child == h) {
+            nodes_[n.prev].child = n.sibling;
+        } else {
+            nodes_[n.prev].sibling = n.sibling;
+        }
+        if (n.sibling != npos) {
+            nodes_[n.sibling].prev = n.prev;
+        }
+        n.sibling = npos;
+        n.prev = npos;
+    }
+
+    void check_handle(handle_type h) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(h >= nodes_.size(), "pairing_heap - handle out of range");
+    }
+
+    void check_contains(handle_type h) const {
+        check_handle(h);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(!nodes_[h].in_heap, "pairing_heap - handle not in heap");
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param capacity 句柄的取值范围 [0, capacity)
+     * @param comp 比较函数
+     */
+    explicit pairing_heap(size_type capacity = 0, const Compare& comp = Compare())
+        : nodes_(capacity), scratch_(), root_(npos), size_(0), comp_(comp) {}
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    size_type capacity() const noexcept {
+        return nodes_.size();
+    }
+
+    void reserve_handles(size_type capacity) {
+        if (capacity > nodes_.size()) {
+            nodes_.resize(capacity);
+        }
+    }
+
+    // ============================ 查询 ============================
+
+    bool contains(handle_type h) const {
+        return h < nodes_.size() && nodes_[h].in_heap;
+    }
+
+    handle_type top() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(empty(), "pairing_heap::top - heap is empty");
+        return root_;
+    }
+
+    const key_type& top_key() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(empty(), "pairing_heap::top_key - heap is empty");
+        return nodes_[root_].key;
+    }
+
+    const key_type& key(handle_type h) const {
+        check_contains(h);
+        return nodes_[h].key;
+    }
+
+    // ============================ 修改器 ============================
+
+    void push(handle_type h, const key_type& k) {
+        check_handle(h);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(nodes_[h].in_heap, "pairing_heap::push - handle already in heap");
+        node& n = nodes_[h];
+        n.key = k;
+        n.child = npos;
+        n.sibling = npos;
+        n.prev = npos;
+        n.in_heap = true;
+        root_ = meld(root_, h);
+        ++size_;
+    }
+
+    handle_type pop() {
+        SUGAR_THROW_OUT_OF_RANGE_IF(empty(), "pairing_heap::pop - heap is empty");
+        handle_type h = root_;
+        root_ = merge_pairs(nodes_[h].child);
+        nodes_[h].child = npos;
+        nodes_[h].in_heap = false;
+        --size_;
+        return h;
+    }
+
+    void decrease_key(handle_type h, const key_type& k) {
+        check_contains(h);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(comp_(nodes_[h].key, k), "pairing_heap::decrease_key - key would increase");
+        nodes_[h].key = k;
+        if (h != root_) {
+            cut(h);
+            root_ = meld(root_, h);
+        }
+    }
+
+    bool push_or_decrease(handle_type h, const key_type& k) {
+        if (!contains(h)) {
+            push(h, k);
+            return true;
+        }
+        if (comp_(k, nodes_[h].key)) {
+            decrease_key(h, k);
+            return true;
+        }
+        return false;
+    }
+
+    void erase(handle_type h) {
+        check_contains(h);
+        if (h == root_) {
+            pop();
+            return;
+        }
+        cut(h);
+        size_type sub = merge_pairs(nodes_[h].child);
+        nodes_[h].child = npos;
+        nodes_[h].in_heap = false;
+        root_ = meld(root_, sub);
+        --size_;
+    }
+
+    void clear() {
+        for (size_type i = 0; i < nodes_.size(); ++i) {
+            nodes_[i] = node();
+        }
+        root_ = npos;
+        size_ = 0;
+    }
+};
+
+template<typename Key, typename Compare>
+constexpr typename pairing_heap<Key, Compare>::size_type pairing_heap<Key, Compare>::npos;
+
+// ============================ radix_heap 类模板 ============================
+
+/**
+ * @brief radix_heap 类模板，单调整数优先级的基数堆
+ *
+ * 要求弹出的键单调不减、新插入的键不小于最近一次弹出的键（Dijkstra 满足该条件）。
+ * 按与last_的最高不同位分桶，每个元素至多被重新分桶 O(位宽) 次，
+ * push为O(1)，pop为均摊O(log C)。
+ *
+ * @tparam Key 无符号整数键类型
+ * @tparam Value 附带的值类型
+ */
+template<typename Key, typename Value>
+class radix_heap {
+    static_assert(is_integer<Key>::value && static_cast<Key>(-1) > Key(0),
+                  "radix_heap key must be an unsigned integer type");
+
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using value_type = pair<Key, Value>;
+    using size_type = size_t;
+
+private:
+    static constexpr size_type key_bits = sizeof(Key) * 8;
+
+    // ============================ 私有成员 ============================
+    vector<value_type> buckets_[key_bits + 1];  // 桶i存放与last_最高不同位为第i-1位的元素
+    Key last_;                                  // 最近一次弹出的键
+    size_type size_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static size_type bucket_of(Key k, Key last) {
+        Key diff = k ^ last;
+        if (diff == 0) {
+            return 0;
+        }
+        return key_bits - static_cast<size_type>(
+            sizeof(Key) <= sizeof(unsigned int)
+                ? __builtin_clz(static_cast<unsigned int>(diff)) - (sizeof(unsigned int) - sizeof(Key)) * 8
+                : __builtin_clzll(static_cast<unsigned long long>(diff)) - (sizeof(unsigned long long) - sizeof(Key)) * 8);
+    }
+
+    /**
+     * @brief 保证桶0非空：找到第一个非空桶，以其最小键为新的last_重新分桶
+     */
+    void pull() {
+        if (!buckets_[0].empty()) {
+            return;
+        }
+        size_type i = 1;
+        while (buckets_[i].empty()) {
+            ++i;
+        }
+        vector<value_type>& b = buckets_[i];
+        Key new_last = b[0].first;
+        for (size_type j = 1; j < b.size(); ++j) {
+            if (b[j].first < new_last) {
+                new_last = b[j].first;
+            }
+        }
+        last_ = new_last;
+        for (size_type j = 0; j < b.size(); ++j) {
+            buckets_[bucket_of(b[j].first, last_)].push_back(sugar::move(b[j]));
+        }
+        b.clear();
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    radix_heap() : last_(0), size_(0) {}
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    // ============================ 修改器 ============================
+
+    /**
+     * @brief 插入元素
+     * @param k 键，不得小于最近一次弹出的键
+     * @param v 值
+     */
+    void push(Key k, const Value& v) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(k < last_, "radix_heap::push - key below last popped key");
+        buckets_[bucket_of(k, last_)].push_back(value_type(k, v));
+        ++size_;
+    }
+
+    /**
+     * @brief 获取最小元素
+     */
+    const value_type& top() {
+        SUGAR_THROW_OUT_OF_RANGE_IF(empty(), "radix_heap::top - heap is empty");
+        pull();
+        return buckets_[0].back();
+    }
+
+    /**
+     * @brief 弹出最小元素
+     * @return 被弹出的元素
+     */
+    value_type pop() {
+        SUGAR_THROW_OUT_OF_RANGE_IF(empty(), "radix_heap::pop - heap is empty");
+        pull();
+        value_type result = sugar::move(buckets_[0].back());
+        buckets_[0].pop_back();
+        --size_;
+        return result;
+    }
+
+    /**
+     * @brief 清空堆并重置单调下界（保留桶容量）
+     */
+    void clear() {
+        for (size_type i = 0; i <= key_bits; ++i) {
+            buckets_[i].clear();
+        }
+        last_ = 0;
+        size_ = 0;
+    }
+};
+
+} // namespace sugar
+
+#endif // INDEXED_HEAP_H_
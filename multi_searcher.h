@@ -0,0 +1,477 @@
+/*
+ * @file multi_searcher.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 多模式字节串匹配：Aho-Corasick 稠密DFA与Teddy风格SIMD预过滤
+ */
+
+#ifndef MULTI_SEARCHER_H_
+#define MULTI_SEARCHER_H_
+
+#include "algorithm.h"
+#include "vector.h"
+#include "utility.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace sugar {
+
+// ============================ multi_match ============================
+
+/**
+ * @brief 一次匹配：模式编号与匹配区间[begin, end)在文本中的下标
+ */
+struct multi_match {
+    size_t pattern;
+    size_t begin;
+    size_t end;
+};
+
+// ============================ multi_searcher 类 ============================
+
+/**
+ * @brief 多模式匹配器：先add()所有模式，再compile()，之后可在任意字节区间上反复查找
+ *
+ * 两种引擎：
+ * - aho_corasick：稠密转移表的DFA。字节先映射到等价类（未出现在任何模式里的字节共用一类），
+ *   表宽为类数而非256；状态编号预乘表宽，内循环每字节只有一次查表。
+ *   接受状态被重新编号到表尾，判断是否命中只需一次比较。
+ * - teddy：模式较少时使用的SIMD预过滤，每次检查16个起点，只对指纹命中的位置逐个验证。
+ *   有SSSE3时用半字节查表（Teddy）对前3个字节做指纹，否则用SSE2比较每个模式的前两个字节。
+ *
+ * 所有重叠的匹配都会报告。aho_corasick按匹配终点的顺序报告，teddy按起点的顺序报告。
+ */
+class multi_searcher {
+public:
+    enum engine_type {
+        automatic,      // 按模式数量自动选择
+        aho_corasick,
+        teddy
+    };
+
+private:
+    static const uint32_t no_state = 0xFFFFFFFFu;
+    static const size_t teddy_buckets = 8;
+    static const size_t teddy_auto_patterns = 8;   // 自动选择teddy的模式数上限：每个模式独占一个桶
+#if SUGAR_HAS_SSSE3
+    static const size_t teddy_max_patterns = 32;   // 显式指定teddy时的上限
+#else
+    static const size_t teddy_max_patterns = 8;
+#endif
+
+    // 模式存储：第i个模式为bytes_[starts_[i], starts_[i + 1])
+    vector<unsigned char> bytes_;
+    vector<size_t> starts_;
+    size_t min_length_;
+    engine_type engine_;
+    bool compiled_;
+
+    // Aho-Corasick
+    unsigned char classes_[256];      // 字节 -> 等价类
+    size_t stride_;                   // 等价类数，即转移表每行宽度
+    vector<uint32_t> table_;          // 预乘后的转移表
+    uint32_t accept_begin_;           // 编号不小于此值的状态为接受状态
+    vector<size_t> out_offsets_;      // 第k个接受状态的输出为out_ids_[out_offsets_[k], out_offsets_[k + 1])
+    vector<size_t> out_ids_;
+
+    // Teddy
+    size_t fingerprint_;              // 指纹字节数
+    vector<size_t> bucket_offsets_;   // 第b个桶的模式为bucket_ids_[bucket_offsets_[b], bucket_offsets_[b + 1])
+    vector<size_t> bucket_ids_;
+#if SUGAR_HAS_SSSE3
+    __m128i low_masks_[3];            // 第j个指纹字节低半字节 -> 桶位图
+    __m128i high_masks_[3];           // 第j个指纹字节高半字节 -> 桶位图
+#elif SUGAR_HAS_SSE2
+    __m128i first_bytes_[teddy_max_patterns];   // 每个模式的首字节广播
+    __m128i second_bytes_[teddy_max_patterns];  // 每个模式的第二个字节广播
+#endif
+
+    size_t pattern_length(size_t id) const {
+        return starts_[id + 1] - starts_[id];
+    }
+
+    bool matches_at(size_t id, const unsigned char* h, size_t n, size_t pos) const {
+        size_t len = pattern_length(id);
+        return len <= n - pos && std::memcmp(h + pos, bytes_.data() + starts_[id], len) == 0;
+    }
+
+    template<typename OutputIt>
+    static OutputIt emit(OutputIt out, size_t pattern, size_t begin, size_t end) {
+        multi_match m;
+        m.pattern = pattern;
+        m.begin = begin;
+        m.end = end;
+        *out = m;
+        ++out;
+        return out;
+    }
+
+    // ============================ Aho-Corasick 构建 ============================
+
+    void build_aho_corasick() {
+        const size_t count = starts_.size() - 1;
+
+        // 字节等价类：0留给不出现在任何模式里的字节（256个字节都出现时每个字节各占一类）
+        bool used[256] = {};
+        size_t used_count = 0;
+        for (size_t i = 0; i < bytes_.size(); ++i) {
+            used_count += used[bytes_[i]] ? 0 : 1;
+            used[bytes_[i]] = true;
+        }
+        stride_ = used_count == 256 ? 0 : 1;
+        for (size_t c = 0; c < 256; ++c) {
+            classes_[c] = used[c] ? static_cast<unsigned char>(stride_++) : 0;
+        }
+
+        // 字典树
+        vector<uint32_t> trie(stride_, uint32_t(no_state));
+        vector<uint32_t> terminal(count, 0);
+        uint32_t states = 1;
+        for (size_t id = 0; id < count; ++id) {
+            uint32_t s = 0;
+            for (size_t k = starts_[id]; k < starts_[id + 1]; ++k) {
+                size_t slot = s * stride_ + classes_[bytes_[k]];
+                if (trie[slot] == no_state) {
+                    SUGAR_THROW_LENGTH_ERROR_IF(static_cast<uint64_t>(states + 1) * stride_ > 0xFFFFFFFFull,
+                                                "multi_searcher::compile - automaton too large");
+                    trie[slot] = states++;
+                    trie.resize(static_cast<size_t>(states) * stride_, uint32_t(no_state));
+                }
+                s = trie[slot];
+            }
+            terminal[id] = s;
+        }
+
+        // 广度优先补全转移并计算失配链接
+        vector<uint32_t> order;
+        vector<uint32_t> fail(states, 0);
+        order.reserve(states);
+        order.push_back(0);
+        for (size_t head = 0; head < order.size(); ++head) {
+            uint32_t s = order[head];
+            for (size_t c = 0; c < stride_; ++c) {
+                uint32_t& t = trie[s * stride_ + c];
+                uint32_t via_fail = s == 0 ? 0 : trie[fail[s] * stride_ + c];
+                if (t == no_state) {
+                    t = via_fail;
+                } else {
+                    fail[t] = via_fail;
+                    order.push_back(t);
+                }
+            }
+        }
+
+        // 每个状态的输出 = 自身结束的模式 + 失配链接状态的输出（按BFS顺序，失配状态先算好）
+        vector<size_t> own_offsets(states + 1, 0);
+        for (size_t id = 0; id < count; ++id) {
+            ++own_offsets[terminal[id] + 1];
+        }
+        for (size_t s = 0; s < states; ++s) {
+            own_offsets[s + 1] += own_offsets[s];
+        }
+        vector<size_t> own_ids(count, 0);
+        vector<size_t> cursor(own_offsets.begin(), own_offsets.end());
+        for (size_t id = 0; id < count; ++id) {
+            own_ids[cursor[terminal[id]]++] = id;
+        }
+        vector<size_t> all_begin(states, 0);
+        vector<size_t> all_end(states, 0);
+        vector<size_t> all_ids;
+        for (size_t head = 0; head < order.size(); ++head) {
+            uint32_t s = order[head];
+            all_begin[s] = all_ids.size();
+            for (size_t k = own_offsets[s]; k < own_offsets[s + 1]; ++k) {
+                all_ids.push_back(own_ids[k]);
+            }
+            if (s != 0) {
+                for (size_t k = all_begin[fail[s]]; k < all_end[fail[s]]; ++k) {
+                    size_t id = all_ids[k];
+                    all_ids.push_back(id);
+                }
+            }
+            all_end[s] = all_ids.size();
+        }
+
+        // 重新编号：非接受状态在前（根仍为0），接受状态在后
+        vector<uint32_t> renumber(states, 0);
+        uint32_t next = 0;
+        for (size_t head = 0; head < order.size(); ++head) {
+            uint32_t s = order[head];
+            if (all_begin[s] == all_end[s]) {
+                renumber[s] = next++;
+            }
+        }
+        accept_begin_ = static_cast<uint32_t>(next * stride_);
+        out_offsets_.clear();
+        out_ids_.clear();
+        out_offsets_.push_back(0);
+        for (size_t head = 0; head < order.size(); ++head) {
+            uint32_t s = order[head];
+            if (all_begin[s] != all_end[s]) {
+                renumber[s] = next++;
+                for (size_t k = all_begin[s]; k < all_end[s]; ++k) {
+                    out_ids_.push_back(all_ids[k]);
+                }
+                out_offsets_.push_back(out_ids_.size());
+            }
+        }
+
+        table_.assign(static_cast<size_t>(states) * stride_, 0);
+        for (uint32_t s = 0; s < states; ++s) {
+            for (size_t c = 0; c < stride_; ++c) {
+                table_[renumber[s] * stride_ + c] = static_cast<uint32_t>(renumber[trie[s * stride_ + c]] * stride_);
+            }
+        }
+    }
+
+    template<typename OutputIt>
+    OutputIt find_aho_corasick(const unsigned char* h, size_t n, OutputIt out) const {
+        const uint32_t* table = table_.data();
+        const unsigned char* classes = classes_;
+        const uint32_t accept = accept_begin_;
+        uint32_t s = 0;
+        for (size_t i = 0; i < n; ++i) {
+            s = table[s + classes[h[i]]];
+            if (s >= accept) {
+                size_t k = (s - accept) / stride_;
+                for (size_t j = out_offsets_[k]; j < out_offsets_[k + 1]; ++j) {
+                    size_t id = out_ids_[j];
+                    out = emit(out, id, i + 1 - pattern_length(id), i + 1);
+                }
+            }
+        }
+        return out;
+    }
+
+    // ============================ Teddy 构建 ============================
+
+    void build_teddy() {
+        const size_t count = starts_.size() - 1;
+        fingerprint_ = min_length_ < 3 ? min_length_ : 3;
+#if !SUGAR_HAS_SSSE3
+        if (fingerprint_ > 2) {
+            fingerprint_ = 2;
+        }
+#endif
+        // 模式按编号轮流分到各个桶
+        bucket_offsets_.assign(teddy_buckets + 1, 0);
+        bucket_ids_.clear();
+        for (size_t b = 0; b < teddy_buckets; ++b) {
+            for (size_t id = b; id < count; id += teddy_buckets) {
+                bucket_ids_.push_back(id);
+            }
+            bucket_offsets_[b + 1] = bucket_ids_.size();
+        }
+#if SUGAR_HAS_SSSE3
+        for (size_t j = 0; j < fingerprint_; ++j) {
+            unsigned char low[16] = {};
+            unsigned char high[16] = {};
+            for (size_t id = 0; id < count; ++id) {
+                unsigned char byte = bytes_[starts_[id] + j];
+                unsigned char bit = static_cast<unsigned char>(1u << (id % teddy_buckets));
+                low[byte & 15] |= bit;
+                high[byte >> 4] |= bit;
+            }
+            low_masks_[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low));
+            high_masks_[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high));
+        }
+#elif SUGAR_HAS_SSE2
+        for (size_t id = 0; id < count; ++id) {
+            const unsigned char* p = bytes_.data() + starts_[id];
+            first_bytes_[id] = _mm_set1_epi8(static_cast<char>(p[0]));
+            second_bytes_[id] = _mm_set1_epi8(static_cast<char>(fingerprint_ > 1 ? p[1] : p[0]));
+        }
+#endif
+    }
+
+    /**
+     * @brief 在pos处验证buckets位图中各桶的模式
+     */
+    template<typename OutputIt>
+    OutputIt verify_buckets(const unsigned char* h, size_t n, size_t pos, unsigned int buckets, OutputIt out) const {
+        for (size_t b = 0; buckets != 0; ++b, buckets >>= 1) {
+            if ((buckets & 1u) == 0) {
+                continue;
+            }
+            for (size_t k = bucket_offsets_[b]; k < bucket_offsets_[b + 1]; ++k) {
+                size_t id = bucket_ids_[k];
+                if (matches_at(id, h, n, pos)) {
+                    out = emit(out, id, pos, pos + pattern_length(id));
+                }
+            }
+        }
+        return out;
+    }
+
+    template<typename OutputIt>
+    OutputIt find_teddy(const unsigned char* h, size_t n, OutputIt out) const {
+        const unsigned int all_buckets = (1u << teddy_buckets) - 1;
+        size_t pos = 0;
+#if SUGAR_HAS_SSSE3
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i low_nibble = _mm_set1_epi8(0x0F);
+        for (; pos + 16 + fingerprint_ - 1 <= n; pos += 16) {
+            __m128i result = _mm_set1_epi8(static_cast<char>(0xFF));
+            for (size_t j = 0; j < fingerprint_; ++j) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + pos + j));
+                __m128i lo = _mm_shuffle_epi8(low_masks_[j], _mm_and_si128(v, low_nibble));
+                __m128i hi = _mm_shuffle_epi8(high_masks_[j], _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble));
+                result = _mm_and_si128(result, _mm_and_si128(lo, hi));
+            }
+            unsigned int mask = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(result, zero))) & 0xFFFFu;
+            if (mask == 0) {
+                continue;
+            }
+            unsigned char buckets[16];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buckets), result);
+            for (; mask != 0; mask &= mask - 1) {
+                size_t k = static_cast<size_t>(__builtin_ctz(mask));
+                out = verify_buckets(h, n, pos + k, buckets[k], out);
+            }
+        }
+#elif SUGAR_HAS_SSE2
+        // 无SSSE3：逐个模式比较前两个字节（单字节模式的第二个字节与首字节相同，比较的是同一位置）
+        const size_t count = starts_.size() - 1;
+        const size_t second = fingerprint_ > 1 ? 1 : 0;
+        for (; pos + 16 + second <= n; pos += 16) {
+            __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + pos));
+            __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + pos + second));
+            __m128i hit = _mm_setzero_si128();
+            for (size_t id = 0; id < count; ++id) {
+                hit = _mm_or_si128(hit, _mm_and_si128(_mm_cmpeq_epi8(v0, first_bytes_[id]),
+                                                      _mm_cmpeq_epi8(v1, second_bytes_[id])));
+            }
+            unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(hit));
+            for (; mask != 0; mask &= mask - 1) {
+                out = verify_buckets(h, n, pos + static_cast<size_t>(__builtin_ctz(mask)), all_buckets, out);
+            }
+        }
+#endif
+        for (; pos < n; ++pos) {
+            out = verify_buckets(h, n, pos, all_buckets, out);
+        }
+        return out;
+    }
+
+public:
+    // ============================ 构造与编译 ============================
+
+    /**
+     * @brief 默认构造函数：空模式集
+     */
+    multi_searcher()
+        : bytes_(), starts_(1, 0), min_length_(0), engine_(automatic), compiled_(false),
+          stride_(1), table_(), accept_begin_(0), out_offsets_(), out_ids_(),
+          fingerprint_(0), bucket_offsets_(), bucket_ids_() {
+        for (size_t c = 0; c < 256; ++c) {
+            classes_[c] = 0;
+        }
+    }
+
+    /**
+     * @brief 添加一个模式（添加后需重新compile）
+     * @param first 模式起始指针
+     * @param last 模式结束指针
+     * @return 模式编号，匹配结果中以此编号报告
+     */
+    template<typename CharT>
+    size_t add(const CharT* first, const CharT* last) {
+        static_assert(sizeof(CharT) == 1, "multi_searcher patterns must be byte strings");
+        SUGAR_THROW_INVALID_ARGUMENT_IF(first == last, "multi_searcher::add - empty pattern");
+        size_t len = static_cast<size_t>(last - first);
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(first);
+        for (size_t i = 0; i < len; ++i) {
+            bytes_.push_back(p[i]);
+        }
+        starts_.push_back(bytes_.size());
+        min_length_ = starts_.size() == 2 || len < min_length_ ? len : min_length_;
+        compiled_ = false;
+        return starts_.size() - 2;
+    }
+
+    /**
+     * @brief 添加一个以'\0'结尾的模式
+     */
+    size_t add(const char* pattern) {
+        return add(pattern, pattern + std::strlen(pattern));
+    }
+
+    /**
+     * @brief 编译模式集
+     * @param engine 指定引擎；automatic在模式不超过8个时选teddy。
+     *        teddy在模式过多或平台无SIMD时退回aho_corasick
+     */
+    void compile(engine_type engine = automatic) {
+        const size_t count = starts_.size() - 1;
+        bool teddy_ok = SUGAR_HAS_SSE2 && count > 0 && count <= teddy_max_patterns;
+        if (engine == automatic) {
+            engine = teddy_ok && count <= teddy_auto_patterns ? teddy : aho_corasick;
+        } else if (engine == teddy && !teddy_ok) {
+            engine = aho_corasick;
+        }
+        if (engine == teddy) {
+            build_teddy();
+        } else {
+            build_aho_corasick();
+        }
+        engine_ = engine;
+        compiled_ = true;
+    }
+
+    // ============================ 查找 ============================
+
+    /**
+     * @brief 报告[first, last)中所有模式的所有出现位置（包括重叠的出现）
+     * @param first 文本起始指针
+     * @param last 文本结束指针
+     * @param out 接收multi_match的输出迭代器
+     * @return 指向输出末尾的迭代器
+     */
+    template<typename Pointer, typename OutputIt>
+    OutputIt find_all(Pointer first, Pointer last, OutputIt out) const {
+        static_assert(sizeof(*first) == 1, "multi_searcher searches byte ranges");
+        SUGAR_THROW_LOGIC_ERROR_IF(!compiled_, "multi_searcher::find_all - compile() not called");
+        const unsigned char* h = reinterpret_cast<const unsigned char*>(first);
+        size_t n = static_cast<size_t>(last - first);
+        if (starts_.size() == 1 || n == 0) {
+            return out;
+        }
+        return engine_ == teddy ? find_teddy(h, n, out) : find_aho_corasick(h, n, out);
+    }
+
+    // ============================ 容量与状态 ============================
+
+    /**
+     * @brief 模式数量
+     */
+    size_t size() const {
+        return starts_.size() - 1;
+    }
+
+    /**
+     * @brief 是否没有模式
+     */
+    bool empty() const {
+        return starts_.size() == 1;
+    }
+
+    /**
+     * @brief compile()实际选用的引擎
+     */
+    engine_type engine() const {
+        return engine_;
+    }
+
+    /**
+     * @brief Aho-Corasick转移表占用的字节数
+     */
+    size_t table_bytes() const {
+        return table_.size() * sizeof(uint32_t);
+    }
+};
+
+} // namespace sugar
+
+#endif // MULTI_SEARCHER_H_
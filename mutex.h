@@ -0,0 +1,371 @@
+/*
+ * @file mutex.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 轻量锁：带指数退避的自旋锁、公平的票据锁、先自旋后用futex休眠的自适应互斥锁、
+ *        读写自旋锁，以及按缓存行对齐的包装 cache_aligned
+ */
+
+#ifndef MUTEX_H_
+#define MUTEX_H_
+
+#include "type_traits.h"
+#include "utility.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define SUGAR_HAS_FUTEX 1
+#else
+#define SUGAR_HAS_FUTEX 0
+#endif
+
+namespace sugar {
+
+// ============================ 基础设施 ============================
+
+/**
+ * @brief 缓存行大小
+ */
+const size_t cache_line_size = 64;
+
+/**
+ * @brief 自旋等待中的一次停顿：x86上为PAUSE，降低功耗并避免退出循环时的流水线清空
+ */
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * @brief backoff 类，指数退避：每次等待的停顿次数翻倍，超过上限后改为让出CPU
+ *
+ * 让出CPU这一步在线程数多于核数时必不可少：持锁线程被换下时，
+ * 纯自旋的等待者只会白白耗尽自己的时间片。
+ */
+class backoff {
+private:
+    static const uint32_t spin_limit = 64;
+
+    uint32_t step_;
+
+public:
+    backoff() noexcept : step_(1) {}
+
+    void pause() noexcept {
+        if (step_ <= spin_limit) {
+            for (uint32_t i = 0; i < step_; ++i) {
+                cpu_relax();
+            }
+            step_ <<= 1;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief 是否已经退避到让出CPU的阶段
+     */
+    bool yielding() const noexcept { return step_ > spin_limit; }
+
+    void reset() noexcept { step_ = 1; }
+};
+
+// ============================ cache_aligned 类模板 ============================
+
+/**
+ * @brief cache_aligned 类模板，独占整条缓存行的值，避免相邻的计数器、锁等相互伪共享
+ *
+ * 类型按缓存行对齐，大小补齐为缓存行的整数倍。作为成员、静态或栈上对象时严格对齐；
+ * 在只保证16字节对齐的堆上分配时，补齐后的大小仍使相邻元素不落在同一条缓存行的热点上。
+ */
+template<typename T>
+struct alignas(cache_line_size) cache_aligned {
+    T value;
+
+    cache_aligned() : value() {}
+
+    // 单参数的转发构造排除 cache_aligned 自身，否则非const左值的拷贝会误选它而不是拷贝构造函数
+    template<typename Arg, typename = typename enable_if<!is_same<typename decay<Arg>::type, cache_aligned>::value>::type>
+    explicit cache_aligned(Arg&& arg) : value(sugar::forward<Arg>(arg)) {}
+
+    template<typename Arg1, typename Arg2, typename... Args>
+    cache_aligned(Arg1&& arg1, Arg2&& arg2, Args&&... args)
+        : value(sugar::forward<Arg1>(arg1), sugar::forward<Arg2>(arg2), sugar::forward<Args>(args)...) {}
+
+    T& get() noexcept { return value; }
+    const T& get() const noexcept { return value; }
+    T& operator*() noexcept { return value; }
+    const T& operator*() const noexcept { return value; }
+    T* operator->() noexcept { return &value; }
+    const T* operator->() const noexcept { return &value; }
+};
+
+// ============================ spinlock 类 ============================
+
+/**
+ * @brief spinlock 类，test-and-test-and-set 自旋锁
+ *
+ * 抢锁失败后只读等待锁变为空闲（读命中本地缓存，不产生总线流量），再尝试交换；
+ * 等待时按指数退避停顿。适合只有几十纳秒的临界区，满足 Lockable 要求，可与 std::lock_guard 配合使用。
+ */
+class spinlock {
+private:
+    std::atomic<bool> locked_;
+
+public:
+    spinlock() noexcept : locked_(false) {}
+
+    spinlock(const spinlock&) = delete;
+    spinlock& operator=(const spinlock&) = delete;
+
+    void lock() noexcept {
+        for (;;) {
+            if (!locked_.exchange(true, std::memory_order_acquire)) {
+                return;
+            }
+            backoff b;
+            while (locked_.load(std::memory_order_relaxed)) {
+                b.pause();
+            }
+        }
+    }
+
+    bool try_lock() noexcept {
+        return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+    bool is_locked() const noexcept { return locked_.load(std::memory_order_relaxed); }
+};
+
+// ============================ ticket_lock 类 ============================
+
+/**
+ * @brief ticket_lock 类，按到达顺序获得锁的票据锁
+ *
+ * 取号用fetch_add，叫号由持锁者在释放时推进，因此严格先来先得、不会饿死。
+ * 等待时按前面排队的人数成比例停顿，排得越靠后越少地读叫号计数。
+ * 公平的代价是：排在前面的线程被换下时，后面所有线程都要等它，线程数超过核数时吞吐明显下降。
+ */
+class ticket_lock {
+private:
+    std::atomic<uint32_t> next_;
+    char pad_[cache_line_size - sizeof(std::atomic<uint32_t>)];  // 取号与叫号分属不同缓存行
+    std::atomic<uint32_t> serving_;
+
+public:
+    ticket_lock() noexcept : next_(0), serving_(0) {}
+
+    ticket_lock(const ticket_lock&) = delete;
+    ticket_lock& operator=(const ticket_lock&) = delete;
+
+    void lock() noexcept {
+        const uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        uint32_t rounds = 0;
+        for (;;) {
+            const uint32_t ahead = ticket - serving_.load(std::memory_order_acquire);
+            if (ahead == 0) {
+                return;
+            }
+            // 轮到自己之前大约还要经过ahead个临界区；长时间等不到说明前面的线程被换下了
+            if (ahead > 1 || ++rounds > 8) {
+                std::this_thread::yield();
+            } else {
+                for (uint32_t i = 0; i < ahead * 8; ++i) {
+                    cpu_relax();
+                }
+            }
+        }
+    }
+
+    bool try_lock() noexcept {
+        uint32_t serving = serving_.load(std::memory_order_relaxed);
+        uint32_t expected = serving;
+        return next_.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool is_locked() const noexcept {
+        return next_.load(std::memory_order_relaxed) != serving_.load(std::memory_order_relaxed);
+    }
+};
+
+// ============================ adaptive_mutex 类 ============================
+
+/**
+ * @brief adaptive_mutex 类，先自旋、再在futex上休眠的互斥锁
+ *
+ * 状态取值：0 空闲，1 已加锁且无人休眠，2 已加锁且可能有人休眠。
+ * 无竞争时加锁解锁各只有一次原子操作，不进入内核；有竞争时先自旋一段时间，
+ * 自旋上限随最近几次实际自旋的次数自适应调整（类似glibc的adaptive mutex）：
+ * 临界区短时很快就能拿到锁，上限随之保持在较小的值；拿不到就把状态置为2并在futex上休眠，
+ * 解锁者只在状态为2时才发起唤醒系统调用。非Linux平台上休眠退化为让出CPU。
+ */
+class adaptive_mutex {
+private:
+    static const int32_t max_spins = 1000;
+
+    std::atomic<int32_t> state_;
+    std::atomic<int32_t> spins_;  // 最近成功自旋次数的滑动平均
+
+    void wait(int32_t expected) noexcept {
+#if SUGAR_HAS_FUTEX
+        syscall(SYS_futex, reinterpret_cast<int32_t*>(&state_), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+        (void)expected;
+        std::this_thread::yield();
+#endif
+    }
+
+    void wake_one() noexcept {
+#if SUGAR_HAS_FUTEX
+        syscall(SYS_futex, reinterpret_cast<int32_t*>(&state_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+
+    void lock_slow() noexcept {
+        const int32_t average = spins_.load(std::memory_order_relaxed);
+        int32_t limit = average * 2 + 10;
+        if (limit > max_spins) {
+            limit = max_spins;
+        }
+        int32_t count = 0;
+        for (; count < limit; ++count) {
+            int32_t expected = 0;
+            if (state_.load(std::memory_order_relaxed) == 0
+                && state_.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                spins_.store(average + (count - average) / 8, std::memory_order_relaxed);
+                return;
+            }
+            cpu_relax();
+        }
+        spins_.store(average + (count - average) / 8, std::memory_order_relaxed);
+        // 置为2后再休眠：之后的解锁者因此知道需要唤醒
+        int32_t c = state_.exchange(2, std::memory_order_acquire);
+        while (c != 0) {
+            wait(2);
+            c = state_.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+public:
+    adaptive_mutex() noexcept : state_(0), spins_(0) {}
+
+    adaptive_mutex(const adaptive_mutex&) = delete;
+    adaptive_mutex& operator=(const adaptive_mutex&) = delete;
+
+    void lock() noexcept {
+        int32_t expected = 0;
+        if (!state_.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            lock_slow();
+        }
+    }
+
+    bool try_lock() noexcept {
+        int32_t expected = 0;
+        return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        if (state_.exchange(0, std::memory_order_release) == 2) {
+            wake_one();
+        }
+    }
+
+    bool is_locked() const noexcept { return state_.load(std::memory_order_relaxed) != 0; }
+};
+
+// ============================ shared_spin_mutex 类 ============================
+
+/**
+ * @brief shared_spin_mutex 类，写者优先的读写自旋锁
+ *
+ * 一个32位状态字：第0位表示写者持锁，第1位表示有写者在等待，其余位是读者计数。
+ * 写者等待时新读者不再进入，避免读多写少时写者饿死。提供 lock_shared / unlock_shared，
+ * 可与 std::shared_lock 风格的用法配合。
+ */
+class shared_spin_mutex {
+private:
+    static const uint32_t writer = 1;
+    static const uint32_t pending = 2;
+    static const uint32_t reader = 4;
+
+    std::atomic<uint32_t> state_;
+
+public:
+    shared_spin_mutex() noexcept : state_(0) {}
+
+    shared_spin_mutex(const shared_spin_mutex&) = delete;
+    shared_spin_mutex& operator=(const shared_spin_mutex&) = delete;
+
+    void lock() noexcept {
+        backoff b;
+        for (;;) {
+            uint32_t s = state_.load(std::memory_order_relaxed);
+            if ((s & ~pending) == 0) {
+                if (state_.compare_exchange_weak(s, writer, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            if ((s & pending) == 0) {
+                state_.fetch_or(pending, std::memory_order_relaxed);
+            }
+            b.pause();
+        }
+    }
+
+    bool try_lock() noexcept {
+        uint32_t s = state_.load(std::memory_order_relaxed);
+        return (s & ~pending) == 0
+               && state_.compare_exchange_strong(s, writer, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept { state_.fetch_and(~writer, std::memory_order_release); }
+
+    void lock_shared() noexcept {
+        backoff b;
+        for (;;) {
+            uint32_t s = state_.load(std::memory_order_relaxed);
+            if ((s & (writer | pending)) == 0) {
+                if (state_.compare_exchange_weak(s, s + reader, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            b.pause();
+        }
+    }
+
+    bool try_lock_shared() noexcept {
+        uint32_t s = state_.load(std::memory_order_relaxed);
+        return (s & (writer | pending)) == 0
+               && state_.compare_exchange_strong(s, s + reader, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock_shared() noexcept { state_.fetch_sub(reader, std::memory_order_release); }
+
+    /**
+     * @brief 当前持有共享锁的读者数
+     */
+    uint32_t readers() const noexcept { return state_.load(std::memory_order_relaxed) / reader; }
+};
+
+} // namespace sugar
+
+#endif // MUTEX_H_
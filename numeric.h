@@ -0,0 +1,869 @@
+/*
+ * @file numeric.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 数值算法：归约、扫描、补偿求和与多线程两趟扫描
+ */
+
+#ifndef NUMERIC_H_
+#define NUMERIC_H_
+
+#include "algorithm.h"
+#include "functional.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "utility.h"
+#include "vector.h"
+#include <cstddef>
+#include <thread>
+
+namespace sugar {
+
+// ============================ 顺序算法 ============================
+
+/**
+ * @brief 以递增值填充区间
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param value 起始值
+ */
+template<typename ForwardIt, typename T>
+void iota(ForwardIt first, ForwardIt last, T value) {
+    for (; first != last; ++first, ++value) {
+        *first = value;
+    }
+}
+
+/**
+ * @brief 严格从左到右的累加
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @return init + *first + ... + *(last-1)
+ */
+template<typename InputIt, typename T>
+T accumulate(InputIt first, InputIt last, T init) {
+    for (; first != last; ++first) {
+        init = sugar::move(init) + *first;
+    }
+    return init;
+}
+
+/**
+ * @brief 严格从左到右的折叠（使用二元操作）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @param op 二元操作
+ * @return 折叠结果
+ */
+template<typename InputIt, typename T, typename BinaryOp>
+T accumulate(InputIt first, InputIt last, T init, BinaryOp op) {
+    for (; first != last; ++first) {
+        init = op(sugar::move(init), *first);
+    }
+    return init;
+}
+
+/**
+ * @brief 内积（严格从左到右）
+ * @param first1 第一个范围的起始迭代器
+ * @param last1 第一个范围的结束迭代器
+ * @param first2 第二个范围的起始迭代器
+ * @param init 初始值
+ * @return init + sum(a[i] * b[i])
+ */
+template<typename InputIt1, typename InputIt2, typename T>
+T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init) {
+    for (; first1 != last1; ++first1, ++first2) {
+        init = sugar::move(init) + *first1 * *first2;
+    }
+    return init;
+}
+
+/**
+ * @brief 内积（使用自定义操作，严格从左到右）
+ * @param first1 第一个范围的起始迭代器
+ * @param last1 第一个范围的结束迭代器
+ * @param first2 第二个范围的起始迭代器
+ * @param init 初始值
+ * @param op1 归约操作
+ * @param op2 逐元素操作
+ * @return 折叠结果
+ */
+template<typename InputIt1, typename InputIt2, typename T, typename BinaryOp1, typename BinaryOp2>
+T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, BinaryOp1 op1, BinaryOp2 op2) {
+    for (; first1 != last1; ++first1, ++first2) {
+        init = op1(sugar::move(init), op2(*first1, *first2));
+    }
+    return init;
+}
+
+// ============================ 可重结合归约 ============================
+
+/**
+ * @brief 判断能否使用SIMD求和内核：指向float/double/int的指针、累加类型相同、操作为sugar::plus
+ */
+template<typename It, typename T, typename Op>
+struct is_simd_sum
+    : conditional<is_pointer<It>::value &&
+                  is_same<typename remove_cv<typename iterator_traits<It>::value_type>::type, T>::value &&
+                  (is_same<T, float>::value || is_same<T, double>::value || is_same<T, int>::value) &&
+                  is_same<Op, plus<T>>::value,
+                  true_type, false_type>::type {};
+
+#if SUGAR_HAS_SSE2
+/**
+ * @brief SSE2 求和内核：4个向量累加器，打断加法的依赖链
+ */
+inline float simd_sum(const float* first, const float* last) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    for (; last - first >= 16; first += 16) {
+        acc0 = _mm_add_ps(acc0, _mm_loadu_ps(first));
+        acc1 = _mm_add_ps(acc1, _mm_loadu_ps(first + 4));
+        acc2 = _mm_add_ps(acc2, _mm_loadu_ps(first + 8));
+        acc3 = _mm_add_ps(acc3, _mm_loadu_ps(first + 12));
+    }
+    __m128 acc = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    float result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; first != last; ++first) {
+        result += *first;
+    }
+    return result;
+}
+
+inline double simd_sum(const double* first, const double* last) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd();
+    __m128d acc3 = _mm_setzero_pd();
+    for (; last - first >= 8; first += 8) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(first));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(first + 2));
+        acc2 = _mm_add_pd(acc2, _mm_loadu_pd(first + 4));
+        acc3 = _mm_add_pd(acc3, _mm_loadu_pd(first + 6));
+    }
+    __m128d acc = _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3));
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    double result = lanes[0] + lanes[1];
+    for (; first != last; ++first) {
+        result += *first;
+    }
+    return result;
+}
+
+inline int simd_sum(const int* first, const int* last) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    for (; last - first >= 8; first += 8) {
+        acc0 = _mm_add_epi32(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(first)));
+        acc1 = _mm_add_epi32(acc1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + 4)));
+    }
+    int lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi32(acc0, acc1));
+    // 按无符号回绕相加，与SIMD整数加法的语义一致
+    unsigned int result = static_cast<unsigned int>(lanes[0]) + static_cast<unsigned int>(lanes[1]) +
+                          static_cast<unsigned int>(lanes[2]) + static_cast<unsigned int>(lanes[3]);
+    for (; first != last; ++first) {
+        result += static_cast<unsigned int>(*first);
+    }
+    return static_cast<int>(result);
+}
+
+/**
+ * @brief SSE2 点积内核
+ */
+inline float simd_dot(const float* first1, const float* last1, const float* first2) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    for (; last1 - first1 >= 16; first1 += 16, first2 += 16) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(first1), _mm_loadu_ps(first2)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(first1 + 4), _mm_loadu_ps(first2 + 4)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(first1 + 8), _mm_loadu_ps(first2 + 8)));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(first1 + 12), _mm_loadu_ps(first2 + 12)));
+    }
+    __m128 acc = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    float result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; first1 != last1; ++first1, ++first2) {
+        result += *first1 * *first2;
+    }
+    return result;
+}
+
+inline double simd_dot(const double* first1, const double* last1, const double* first2) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd();
+    __m128d acc3 = _mm_setzero_pd();
+    for (; last1 - first1 >= 8; first1 += 8, first2 += 8) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(first1), _mm_loadu_pd(first2)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(first1 + 2), _mm_loadu_pd(first2 + 2)));
+        acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(first1 + 4), _mm_loadu_pd(first2 + 4)));
+        acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(first1 + 6), _mm_loadu_pd(first2 + 6)));
+    }
+    __m128d acc = _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3));
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    double result = lanes[0] + lanes[1];
+    for (; first1 != last1; ++first1, ++first2) {
+        result += *first1 * *first2;
+    }
+    return result;
+}
+#endif
+
+/**
+ * @brief 通用可重结合归约：随机访问迭代器使用4个独立累加器
+ */
+template<typename RandomIt, typename T, typename BinaryOp>
+T reduce_dispatch(RandomIt first, RandomIt last, T init, BinaryOp op, random_access_iterator_tag, false_type) {
+    if (last - first < 8) {
+        return sugar::accumulate(first, last, sugar::move(init), op);
+    }
+    T acc0 = *first;
+    T acc1 = *(first + 1);
+    T acc2 = *(first + 2);
+    T acc3 = *(first + 3);
+    first += 4;
+    for (; last - first >= 4; first += 4) {
+        acc0 = op(sugar::move(acc0), *first);
+        acc1 = op(sugar::move(acc1), *(first + 1));
+        acc2 = op(sugar::move(acc2), *(first + 2));
+        acc3 = op(sugar::move(acc3), *(first + 3));
+    }
+    for (; first != last; ++first) {
+        acc0 = op(sugar::move(acc0), *first);
+    }
+    return op(sugar::move(init), op(op(sugar::move(acc0), sugar::move(acc1)), op(sugar::move(acc2), sugar::move(acc3))));
+}
+
+template<typename InputIt, typename T, typename BinaryOp>
+T reduce_dispatch(InputIt first, InputIt last, T init, BinaryOp op, input_iterator_tag, false_type) {
+    return sugar::accumulate(first, last, sugar::move(init), op);
+}
+
+template<typename Pointer, typename T, typename BinaryOp>
+T reduce_dispatch(Pointer first, Pointer last, T init, BinaryOp op, random_access_iterator_tag, true_type) {
+    (void)op;
+#if SUGAR_HAS_SSE2
+    return init + sugar::simd_sum(first, last);
+#else
+    return sugar::reduce_dispatch(first, last, init, op, random_access_iterator_tag(), false_type());
+#endif
+}
+
+/**
+ * @brief 可重结合归约：op须满足结合律与交换律，允许以任意顺序分组计算，
+ *        因此浮点求和可以使用多累加器/SIMD，结果可能与accumulate有舍入差异
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @param op 二元操作
+ * @return 归约结果
+ */
+template<typename InputIt, typename T, typename BinaryOp>
+T reduce(InputIt first, InputIt last, T init, BinaryOp op) {
+    return sugar::reduce_dispatch(first, last, sugar::move(init), op,
+                                  typename iterator_traits<InputIt>::iterator_category(),
+                                  is_simd_sum<InputIt, T, BinaryOp>());
+}
+
+/**
+ * @brief 可重结合求和
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @return 求和结果
+ */
+template<typename InputIt, typename T>
+T reduce(InputIt first, InputIt last, T init) {
+    return sugar::reduce(first, last, sugar::move(init), sugar::plus<T>());
+}
+
+/**
+ * @brief 可重结合求和，初始值为值类型的默认值
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @return 求和结果
+ */
+template<typename InputIt>
+typename iterator_traits<InputIt>::value_type reduce(InputIt first, InputIt last) {
+    using T = typename iterator_traits<InputIt>::value_type;
+    return sugar::reduce(first, last, T(), sugar::plus<T>());
+}
+
+/**
+ * @brief 一元变换归约：随机访问迭代器使用4个独立累加器
+ */
+template<typename RandomIt, typename T, typename BinaryReduceOp, typename UnaryTransformOp>
+T transform_reduce_dispatch(RandomIt first, RandomIt last, T init, BinaryReduceOp reduce_op,
+                            UnaryTransformOp transform_op, random_access_iterator_tag) {
+    if (last - first < 8) {
+        for (; first != last; ++first) {
+            init = reduce_op(sugar::move(init), transform_op(*first));
+        }
+        return init;
+    }
+    T acc0 = transform_op(*first);
+    T acc1 = transform_op(*(first + 1));
+    T acc2 = transform_op(*(first + 2));
+    T acc3 = transform_op(*(first + 3));
+    first += 4;
+    for (; last - first >= 4; first += 4) {
+        acc0 = reduce_op(sugar::move(acc0), transform_op(*first));
+        acc1 = reduce_op(sugar::move(acc1), transform_op(*(first + 1)));
+        acc2 = reduce_op(sugar::move(acc2), transform_op(*(first + 2)));
+        acc3 = reduce_op(sugar::move(acc3), transform_op(*(first + 3)));
+    }
+    for (; first != last; ++first) {
+        acc0 = reduce_op(sugar::move(acc0), transform_op(*first));
+    }
+    return reduce_op(sugar::move(init), reduce_op(reduce_op(sugar::move(acc0), sugar::move(acc1)),
+                                                  reduce_op(sugar::move(acc2), sugar::move(acc3))));
+}
+
+template<typename InputIt, typename T, typename BinaryReduceOp, typename UnaryTransformOp>
+T transform_reduce_dispatch(InputIt first, InputIt last, T init, BinaryReduceOp reduce_op,
+                            UnaryTransformOp transform_op, input_iterator_tag) {
+    for (; first != last; ++first) {
+        init = reduce_op(sugar::move(init), transform_op(*first));
+    }
+    return init;
+}
+
+/**
+ * @brief 变换后归约（一元变换，可重结合）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @param reduce_op 归约操作
+ * @param transform_op 一元变换
+ * @return 归约结果
+ */
+template<typename InputIt, typename T, typename BinaryReduceOp, typename UnaryTransformOp>
+T transform_reduce(InputIt first, InputIt last, T init, BinaryReduceOp reduce_op, UnaryTransformOp transform_op) {
+    return sugar::transform_reduce_dispatch(first, last, sugar::move(init), reduce_op, transform_op,
+                                            typename iterator_traits<InputIt>::iterator_category());
+}
+
+/**
+ * @brief 二元变换归约：随机访问迭代器使用4个独立累加器
+ */
+template<typename RandomIt1, typename RandomIt2, typename T, typename BinaryReduceOp, typename BinaryTransformOp>
+T transform_reduce_dispatch(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, T init, BinaryReduceOp reduce_op,
+                            BinaryTransformOp transform_op, random_access_iterator_tag) {
+    if (last1 - first1 < 8) {
+        for (; first1 != last1; ++first1, ++first2) {
+            init = reduce_op(sugar::move(init), transform_op(*first1, *first2));
+        }
+        return init;
+    }
+    T acc0 = transform_op(*first1, *first2);
+    T acc1 = transform_op(*(first1 + 1), *(first2 + 1));
+    T acc2 = transform_op(*(first1 + 2), *(first2 + 2));
+    T acc3 = transform_op(*(first1 + 3), *(first2 + 3));
+    first1 += 4;
+    first2 += 4;
+    for (; last1 - first1 >= 4; first1 += 4, first2 += 4) {
+        acc0 = reduce_op(sugar::move(acc0), transform_op(*first1, *first2));
+        acc1 = reduce_op(sugar::move(acc1), transform_op(*(first1 + 1), *(first2 + 1)));
+        acc2 = reduce_op(sugar::move(acc2), transform_op(*(first1 + 2), *(first2 + 2)));
+        acc3 = reduce_op(sugar::move(acc3), transform_op(*(first1 + 3), *(first2 + 3)));
+    }
+    for (; first1 != last1; ++first1, ++first2) {
+        acc0 = reduce_op(sugar::move(acc0), transform_op(*first1, *first2));
+    }
+    return reduce_op(sugar::move(init), reduce_op(reduce_op(sugar::move(acc0), sugar::move(acc1)),
+                                                  reduce_op(sugar::move(acc2), sugar::move(acc3))));
+}
+
+template<typename InputIt1, typename InputIt2, typename T, typename BinaryReduceOp, typename BinaryTransformOp>
+T transform_reduce_dispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, BinaryReduceOp reduce_op,
+                            BinaryTransformOp transform_op, input_iterator_tag) {
+    for (; first1 != last1; ++first1, ++first2) {
+        init = reduce_op(sugar::move(init), transform_op(*first1, *first2));
+    }
+    return init;
+}
+
+/**
+ * @brief 变换后归约（二元变换，可重结合）
+ * @param first1 第一个范围的起始迭代器
+ * @param last1 第一个范围的结束迭代器
+ * @param first2 第二个范围的起始迭代器
+ * @param init 初始值
+ * @param reduce_op 归约操作
+ * @param transform_op 二元变换
+ * @return 归约结果
+ */
+template<typename InputIt1, typename InputIt2, typename T, typename BinaryReduceOp, typename BinaryTransformOp>
+T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init,
+                   BinaryReduceOp reduce_op, BinaryTransformOp transform_op) {
+    return sugar::transform_reduce_dispatch(first1, last1, first2, sugar::move(init), reduce_op, transform_op,
+                                            typename iterator_traits<InputIt1>::iterator_category());
+}
+
+/**
+ * @brief 点积辅助：float/double指针走SIMD内核
+ */
+template<typename It1, typename It2, typename T>
+T dot_dispatch(It1 first1, It1 last1, It2 first2, T init, false_type) {
+    return sugar::transform_reduce(first1, last1, first2, sugar::move(init),
+                                   sugar::plus<T>(), sugar::multiplies<T>());
+}
+
+template<typename It1, typename It2, typename T>
+T dot_dispatch(It1 first1, It1 last1, It2 first2, T init, true_type) {
+#if SUGAR_HAS_SSE2
+    return init + sugar::simd_dot(first1, last1, first2);
+#else
+    return sugar::dot_dispatch(first1, last1, first2, init, false_type());
+#endif
+}
+
+/**
+ * @brief 点积（可重结合的inner_product）
+ * @param first1 第一个范围的起始迭代器
+ * @param last1 第一个范围的结束迭代器
+ * @param first2 第二个范围的起始迭代器
+ * @param init 初始值
+ * @return init + sum(a[i] * b[i])
+ */
+template<typename InputIt1, typename InputIt2, typename T>
+T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init) {
+    return sugar::dot_dispatch(first1, last1, first2, sugar::move(init),
+        typename conditional<is_simd_sum<InputIt1, T, plus<T>>::value &&
+                             is_simd_sum<InputIt2, T, plus<T>>::value &&
+                             !is_same<T, int>::value,
+                             true_type, false_type>::type());
+}
+
+// ============================ 高精度求和 ============================
+
+/**
+ * @brief 成对（树形）求和：误差增长为O(log n)而非O(n)，底层块使用多累加器归约
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @return 求和结果
+ */
+template<typename RandomIt, typename T>
+T pairwise_sum(RandomIt first, RandomIt last, T init) {
+    typename iterator_traits<RandomIt>::difference_type n = last - first;
+    if (n <= 128) {
+        return init + sugar::reduce(first, last, T());
+    }
+    RandomIt middle = first + n / 2;
+    return init + (sugar::pairwise_sum(first, middle, T()) + sugar::pairwise_sum(middle, last, T()));
+}
+
+/**
+ * @brief Kahan-Babuska（Neumaier）补偿求和：单独累计每次加法丢失的低位
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @return 求和结果
+ */
+template<typename InputIt, typename T>
+T kahan_sum(InputIt first, InputIt last, T init) {
+    T sum = init;
+    T compensation = T();
+    for (; first != last; ++first) {
+        T x = *first;
+        T t = sum + x;
+        if ((sum < T() ? -sum : sum) >= (x < T() ? -x : x)) {
+            compensation += (sum - t) + x;
+        } else {
+            compensation += (x - t) + sum;
+        }
+        sum = t;
+    }
+    return sum + compensation;
+}
+
+// ============================ 扫描 ============================
+
+/**
+ * @brief 包含扫描（使用二元操作）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器
+ * @param op 二元操作
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename InputIt, typename OutputIt, typename BinaryOp>
+OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOp op) {
+    if (first == last) {
+        return d_first;
+    }
+    typename iterator_traits<InputIt>::value_type sum = *first;
+    *d_first = sum;
+    for (++first, ++d_first; first != last; ++first, ++d_first) {
+        sum = op(sugar::move(sum), *first);
+        *d_first = sum;
+    }
+    return d_first;
+}
+
+/**
+ * @brief 包含扫描（使用二元操作和初始值）
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器
+ * @param op 二元操作
+ * @param init 初始值
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOp op, T init) {
+    for (; first != last; ++first, ++d_first) {
+        init = op(sugar::move(init), *first);
+        *d_first = init;
+    }
+    return d_first;
+}
+
+#if SUGAR_HAS_SSE2
+/**
+ * @brief SSE2 前缀和内核：寄存器内做两步移位相加（log2(4)步），再加上前一块的进位
+ * @param carry 之前所有元素的和
+ */
+inline int* simd_inclusive_scan(const int* first, const int* last, int* d_first, int carry) {
+    __m128i running = _mm_set1_epi32(carry);
+    for (; last - first >= 4; first += 4, d_first += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, running);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d_first), x);
+        running = _mm_shuffle_epi32(x, 0xFF);
+    }
+    unsigned int sum = static_cast<unsigned int>(_mm_cvtsi128_si32(running));
+    for (; first != last; ++first, ++d_first) {
+        sum += static_cast<unsigned int>(*first);
+        *d_first = static_cast<int>(sum);
+    }
+    return d_first;
+}
+
+inline float* simd_inclusive_scan(const float* first, const float* last, float* d_first, float carry) {
+    __m128 running = _mm_set1_ps(carry);
+    for (; last - first >= 4; first += 4, d_first += 4) {
+        __m128 x = _mm_loadu_ps(first);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+        x = _mm_add_ps(x, running);
+        _mm_storeu_ps(d_first, x);
+        running = _mm_shuffle_ps(x, x, 0xFF);
+    }
+    float sum = _mm_cvtss_f32(running);
+    for (; first != last; ++first, ++d_first) {
+        sum += *first;
+        *d_first = sum;
+    }
+    return d_first;
+}
+#endif
+
+/**
+ * @brief 包含求和扫描的分派：int/float指针走SIMD内核
+ */
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt scan_sum_dispatch(InputIt first, InputIt last, OutputIt d_first, T init, false_type) {
+    return sugar::inclusive_scan(first, last, d_first, sugar::plus<T>(), sugar::move(init));
+}
+
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt scan_sum_dispatch(InputIt first, InputIt last, OutputIt d_first, T init, true_type) {
+#if SUGAR_HAS_SSE2
+    return sugar::simd_inclusive_scan(first, last, d_first, init);
+#else
+    return sugar::scan_sum_dispatch(first, last, d_first, init, false_type());
+#endif
+}
+
+template<typename InputIt, typename OutputIt, typename T>
+struct is_simd_scan
+    : conditional<is_simd_sum<InputIt, T, plus<T>>::value &&
+                  is_same<OutputIt, T*>::value &&
+                  !is_same<T, double>::value,
+                  true_type, false_type>::type {};
+
+/**
+ * @brief 包含求和扫描
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器（可以等于first，原地扫描）
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename InputIt, typename OutputIt>
+OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first) {
+    using T = typename iterator_traits<InputIt>::value_type;
+    if (first == last) {
+        return d_first;
+    }
+    T init = *first;
+    *d_first = init;
+    ++first;
+    ++d_first;
+    return sugar::scan_sum_dispatch(first, last, d_first, init, is_simd_scan<InputIt, OutputIt, T>());
+}
+
+/**
+ * @brief 排除扫描（使用二元操作）：第i个输出为init与前i个元素的折叠
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器
+ * @param init 初始值
+ * @param op 二元操作
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt d_first, T init, BinaryOp op) {
+    for (; first != last; ++first, ++d_first) {
+        T next = op(init, *first);
+        *d_first = sugar::move(init);
+        init = sugar::move(next);
+    }
+    return d_first;
+}
+
+/**
+ * @brief 排除求和扫描
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器
+ * @param init 初始值
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt d_first, T init) {
+    return sugar::exclusive_scan(first, last, d_first, sugar::move(init), sugar::plus<T>());
+}
+
+// ============================ 多线程归约与扫描 ============================
+
+/**
+ * @brief 默认工作线程数
+ */
+inline size_t default_thread_count() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+/**
+ * @brief 把[0, n)均分为parts块，返回第i块的起点
+ */
+inline size_t chunk_begin(size_t n, size_t parts, size_t i) {
+    return n / parts * i + (i < n % parts ? i : n % parts);
+}
+
+/**
+ * @brief 多线程可重结合归约：每个线程归约一块，再按块顺序合并
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @param op 二元操作（须满足结合律）
+ * @param threads 线程数，0表示使用硬件并发数
+ * @return 归约结果
+ */
+template<typename RandomIt, typename T, typename BinaryOp>
+T parallel_reduce(RandomIt first, RandomIt last, T init, BinaryOp op, size_t threads = 0) {
+    size_t n = static_cast<size_t>(last - first);
+    if (threads == 0) {
+        threads = sugar::default_thread_count();
+    }
+    if (threads > n / 4096 + 1) {
+        threads = n / 4096 + 1;
+    }
+    if (threads <= 1) {
+        return sugar::reduce(first, last, sugar::move(init), op);
+    }
+    vector<T> partial(threads, T());
+    vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.push_back(std::thread([=, &partial]() {
+            RandomIt b = first + chunk_begin(n, threads, t);
+            RandomIt e = first + chunk_begin(n, threads, t + 1);
+            partial[t] = sugar::reduce(b + 1, e, T(*b), op);
+        }));
+    }
+    partial[0] = sugar::reduce(first + 1, first + chunk_begin(n, threads, 1), T(*first), op);
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    for (size_t t = 0; t < threads; ++t) {
+        init = op(sugar::move(init), sugar::move(partial[t]));
+    }
+    return init;
+}
+
+/**
+ * @brief 带进位的块内扫描：求和且类型合适时走SIMD前缀和内核
+ */
+template<typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+OutputIt scan_chunk_dispatch(InputIt first, InputIt last, OutputIt d_first, BinaryOp op, T carry, false_type) {
+    return sugar::inclusive_scan(first, last, d_first, op, sugar::move(carry));
+}
+
+template<typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+OutputIt scan_chunk_dispatch(InputIt first, InputIt last, OutputIt d_first, BinaryOp, T carry, true_type) {
+    return sugar::scan_sum_dispatch(first, last, d_first, carry, true_type());
+}
+
+template<typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+struct is_simd_scan_op
+    : conditional<is_simd_scan<InputIt, OutputIt, T>::value && is_same<BinaryOp, plus<T>>::value,
+                  true_type, false_type>::type {};
+
+/**
+ * @brief 多线程两趟包含扫描
+ *
+ * 第一趟各线程并行归约自己的块；串行地对块和做一次排除扫描得到每块的进位；
+ * 第二趟各线程带着进位并行扫描自己的块。总访存约为单线程的两倍，
+ * 但两趟都按线程数线性扩展。
+ *
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器（可以等于first）
+ * @param op 二元操作（须满足结合律）
+ * @param threads 线程数，0表示使用硬件并发数
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename RandomIt, typename OutputIt, typename BinaryOp>
+OutputIt parallel_inclusive_scan(RandomIt first, RandomIt last, OutputIt d_first, BinaryOp op, size_t threads = 0) {
+    using T = typename iterator_traits<RandomIt>::value_type;
+    size_t n = static_cast<size_t>(last - first);
+    if (threads == 0) {
+        threads = sugar::default_thread_count();
+    }
+    if (threads > n / 4096 + 1) {
+        threads = n / 4096 + 1;
+    }
+    if (threads <= 1) {
+        return sugar::inclusive_scan(first, last, d_first, op);
+    }
+
+    // 第一趟：块内归约（最后一块的和用不到，不计算）
+    vector<T> carry(threads, T());
+    vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t + 1 < threads; ++t) {
+        workers.push_back(std::thread([=, &carry]() {
+            RandomIt b = first + chunk_begin(n, threads, t);
+            RandomIt e = first + chunk_begin(n, threads, t + 1);
+            carry[t] = sugar::reduce(b + 1, e, T(*b), op);
+        }));
+    }
+    carry[0] = sugar::reduce(first + 1, first + chunk_begin(n, threads, 1), T(*first), op);
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    workers.clear();
+
+    // 块和的前缀：carry[t] 变为第t块之前所有元素的折叠
+    for (size_t t = 1; t + 1 < threads; ++t) {
+        carry[t] = op(carry[t - 1], carry[t]);
+    }
+
+    // 第二趟：带进位的块内扫描
+    for (size_t t = 1; t < threads; ++t) {
+        workers.push_back(std::thread([=, &carry]() {
+            size_t b = chunk_begin(n, threads, t);
+            size_t e = chunk_begin(n, threads, t + 1);
+            sugar::scan_chunk_dispatch(first + b, first + e, d_first + b, op, carry[t - 1],
+                                       is_simd_scan_op<RandomIt, OutputIt, T, BinaryOp>());
+        }));
+    }
+    sugar::inclusive_scan(first, first + chunk_begin(n, threads, 1), d_first, op);
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    return d_first + n;
+}
+
+/**
+ * @brief 多线程两趟包含求和扫描
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器（可以等于first）
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename RandomIt, typename OutputIt>
+OutputIt parallel_inclusive_scan(RandomIt first, RandomIt last, OutputIt d_first) {
+    using T = typename iterator_traits<RandomIt>::value_type;
+    return sugar::parallel_inclusive_scan(first, last, d_first, sugar::plus<T>(), 0);
+}
+
+/**
+ * @brief 多线程两趟排除扫描
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param d_first 目标起始迭代器（不能与输入重叠）
+ * @param init 初始值
+ * @param op 二元操作（须满足结合律）
+ * @param threads 线程数，0表示使用硬件并发数
+ * @return 指向目标范围末尾的迭代器
+ */
+template<typename RandomIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt parallel_exclusive_scan(RandomIt first, RandomIt last, OutputIt d_first, T init, BinaryOp op,
+                                 size_t threads = 0) {
+    size_t n = static_cast<size_t>(last - first);
+    if (threads == 0) {
+        threads = sugar::default_thread_count();
+    }
+    if (threads > n / 4096 + 1) {
+        threads = n / 4096 + 1;
+    }
+    if (threads <= 1) {
+        return sugar::exclusive_scan(first, last, d_first, sugar::move(init), op);
+    }
+
+    vector<T> carry(threads, T());
+    vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t + 1 < threads; ++t) {
+        workers.push_back(std::thread([=, &carry]() {
+            RandomIt b = first + chunk_begin(n, threads, t);
+            RandomIt e = first + chunk_begin(n, threads, t + 1);
+            carry[t] = sugar::reduce(b + 1, e, T(*b), op);
+        }));
+    }
+    carry[0] = sugar::reduce(first, first + chunk_begin(n, threads, 1), init, op);
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    workers.clear();
+
+    for (size_t t = 1; t + 1 < threads; ++t) {
+        carry[t] = op(carry[t - 1], carry[t]);
+    }
+
+    for (size_t t = 1; t < threads; ++t) {
+        workers.push_back(std::thread([=, &carry]() {
+            size_t b = chunk_begin(n, threads, t);
+            size_t e = chunk_begin(n, threads, t + 1);
+            sugar::exclusive_scan(first + b, first + e, d_first + b, carry[t - 1], op);
+        }));
+    }
+    sugar::exclusive_scan(first, first + chunk_begin(n, threads, 1), d_first, init, op);
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    return d_first + n;
+}
+
+} // namespace sugar
+
+#endif // NUMERIC_H_
@@ -0,0 +1,451 @@
+/*
+ * @file packed_vector.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 压缩整数序列：定宽位打包的 packed_vector 与按128个一块做参考帧压缩的 delta_vector
+ */
+
+#ifndef PACKED_VECTOR_H_
+#define PACKED_VECTOR_H_
+
+#include "algorithm.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace sugar {
+
+// ============================ packed_vector 类 ============================
+
+/**
+ * @brief packed_vector 类，每个值占Bits位、首尾相接存放的无符号整数序列
+ *
+ * 第i个值从第 i*Bits 位开始，可能跨两个64位字。字数组末尾多留一个字，
+ * 读取时总是无分支地拼接当前字与下一字再截取。批量解码按64个值一组进行：
+ * 一组恰好占Bits个字，组内各值的字下标与移位量都是编译期可知的。
+ *
+ * @tparam Bits 每个值的位数，1~64
+ */
+template<unsigned Bits>
+class packed_vector {
+    static_assert(Bits >= 1 && Bits <= 64, "packed_vector requires 1 <= Bits <= 64");
+
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint64_t;
+    using size_type = size_t;
+
+    /**
+     * @brief 可存放的最大值
+     */
+    static constexpr uint64_t max_value() noexcept {
+        return Bits == 64 ? ~uint64_t(0) : (uint64_t(1) << (Bits % 64)) - 1;
+    }
+
+private:
+    // ============================ 私有成员 ============================
+    vector<uint64_t> words_;
+    size_type size_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static size_type words_for(size_type n) noexcept { return (n * Bits + 63) / 64 + 1; }
+
+    static uint64_t read(const uint64_t* words, size_type i) noexcept {
+        const size_type bit = i * Bits;
+        const unsigned shift = static_cast<unsigned>(bit & 63);
+        const uint64_t* w = words + (bit >> 6);
+        // shift为0时 (w[1] << 1) << 63 恰好为0，不需要分支
+        return ((w[0] >> shift) | ((w[1] << 1) << (63 - shift))) & max_value();
+    }
+
+    void write(size_type i, uint64_t value) noexcept {
+        const size_type bit = i * Bits;
+        const unsigned shift = static_cast<unsigned>(bit & 63);
+        uint64_t* w = words_.data() + (bit >> 6);
+        w[0] = (w[0] & ~(max_value() << shift)) | (value << shift);
+        if (shift + Bits > 64) {
+            const unsigned spill = 64 - shift;
+            w[1] = (w[1] & ~(max_value() >> spill)) | (value >> spill);
+        }
+    }
+
+    /**
+     * @brief 解码从字边界开始的64个值
+     */
+    static void decode64(const uint64_t* in, uint64_t* out) noexcept {
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 8
+#pragma GCC unroll 64
+#endif
+        for (unsigned k = 0; k < 64; ++k) {
+            const unsigned bit = k * Bits;
+            const unsigned shift = bit & 63;
+            const uint64_t* w = in + (bit >> 6);
+            out[k] = ((w[0] >> shift) | ((w[1] << 1) << (63 - shift))) & max_value();
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 默认构造函数
+     */
+    packed_vector() : words_(1), size_(0) {}
+
+    /**
+     * @brief 构造n个值为value的序列
+     */
+    explicit packed_vector(size_type n, uint64_t value = 0) : words_(1), size_(0) {
+        resize(n, value);
+    }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief 占用的堆内存字节数
+     */
+    size_type memory_bytes() const noexcept { return words_.capacity() * sizeof(uint64_t); }
+
+    void reserve(size_type n) { words_.reserve(words_for(n)); }
+    void shrink_to_fit() { words_.shrink_to_fit(); }
+
+    // ============================ 元素访问 ============================
+
+    uint64_t operator[](size_type i) const noexcept {
+        SUGAR_DEBUG(i < size_);
+        return read(words_.data(), i);
+    }
+
+    uint64_t at(size_type i) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= size_, "packed_vector::at - index out of range");
+        return read(words_.data(), i);
+    }
+
+    uint64_t back() const noexcept {
+        SUGAR_DEBUG(size_ > 0);
+        return read(words_.data(), size_ - 1);
+    }
+
+    /**
+     * @brief 批量解码[first, first + count)到out
+     */
+    void decode(size_type first, size_type count, uint64_t* out) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(first > size_ || count > size_ - first,
+                                    "packed_vector::decode - range out of bounds");
+        const uint64_t* words = words_.data();
+        const size_type last = first + count;
+        size_type i = first;
+        // 先逐个解到64的倍数，之后每组64个值正好从字边界开始
+        for (; i < last && (i & 63) != 0; ++i) {
+            *out++ = read(words, i);
+        }
+        for (; last - i >= 64; i += 64, out += 64) {
+            decode64(words + i / 64 * Bits, out);
+        }
+        for (; i < last; ++i) {
+            *out++ = read(words, i);
+        }
+    }
+
+    /**
+     * @brief 全部解码到out
+     */
+    void decode(vector<uint64_t>& out) const {
+        out.resize(size_);
+        decode(0, size_, out.data());
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 把第i个值改为value，value必须不超过max_value()
+     */
+    void set(size_type i, uint64_t value) {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= size_, "packed_vector::set - index out of range");
+        SUGAR_THROW_OUT_OF_RANGE_IF(value > max_value(), "packed_vector::set - value does not fit");
+        write(i, value);
+    }
+
+    void push_back(uint64_t value) {
+        SUGAR_THROW_OUT_OF_RANGE_IF(value > max_value(), "packed_vector::push_back - value does not fit");
+        if (words_.size() < words_for(size_ + 1)) {
+            words_.push_back(0);
+        }
+        write(size_++, value);
+    }
+
+    void pop_back() noexcept {
+        SUGAR_DEBUG(size_ > 0);
+        --size_;
+    }
+
+    void resize(size_type n, uint64_t value = 0) {
+        SUGAR_THROW_OUT_OF_RANGE_IF(value > max_value(), "packed_vector::resize - value does not fit");
+        words_.resize(words_for(n > size_ ? n : size_));
+        for (size_type i = size_; i < n; ++i) {
+            write(i, value);
+        }
+        size_ = n;
+        words_.resize(words_for(n));
+    }
+
+    void clear() noexcept {
+        size_ = 0;
+        words_.resize(1);
+    }
+};
+
+// ============================ delta_vector 类 ============================
+
+/**
+ * @brief delta_vector 类，参考帧（frame-of-reference）压缩的64位无符号整数序列，只支持追加
+ *
+ * 每128个值一块，块内以最小值为参考，存各值与它的差，位宽b取块内最大差所需的位数。
+ * 时间戳、递增ID、计数这类局部取值集中的数据，b通常远小于64。
+ * b不超过32时按4路竖排打包：第k个值属于第 k%4 路，每路32个值各占b位连续存放，
+ * 四路的第w个32位字相邻。这样解码时四路的移位量完全相同，一条SSE2移位指令即可同时处理4个值。
+ * b超过32的块（差值跨度很大）直接存64位差值。不满128个的末尾值原样存放。
+ * 随机访问是O(1)的：由下标直接算出所在的路、字与移位量。
+ */
+class delta_vector {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint64_t;
+    using size_type = size_t;
+
+private:
+    static const size_type block_size = 128;
+
+    struct block_header {
+        uint64_t base;      // 块内最小值
+        size_type offset;   // 在data_中的起始下标（以32位字计）
+        uint32_t bits;      // 差值位宽；大于32表示直接存64位差值
+    };
+
+    // ============================ 私有成员 ============================
+    vector<block_header> blocks_;
+    vector<uint32_t> data_;
+    vector<uint64_t> tail_;
+    size_type size_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static uint32_t low_mask(uint32_t bits) noexcept {
+        return bits >= 32 ? ~uint32_t(0) : (uint32_t(1) << bits) - 1;
+    }
+
+    /**
+     * @brief 把tail_中凑满的128个值压成一块
+     */
+    void flush_block() {
+        const uint64_t* v = tail_.data();
+        uint64_t lo = v[0];
+        uint64_t hi = v[0];
+        for (size_type i = 1; i < block_size; ++i) {
+            lo = v[i] < lo ? v[i] : lo;
+            hi = v[i] > hi ? v[i] : hi;
+        }
+        const uint64_t range = hi - lo;
+        block_header h;
+        h.base = lo;
+        h.offset = data_.size();
+        h.bits = range == 0 ? 0 : 64 - static_cast<uint32_t>(__builtin_clzll(range));
+        if (h.bits > 32) {
+            data_.resize(h.offset + 2 * block_size);
+            uint32_t* out = data_.data() + h.offset;
+            for (size_type i = 0; i < block_size; ++i) {
+                const uint64_t delta = v[i] - lo;
+                out[2 * i] = static_cast<uint32_t>(delta);
+                out[2 * i + 1] = static_cast<uint32_t>(delta >> 32);
+            }
+        } else if (h.bits > 0) {
+            data_.resize(h.offset + 4 * h.bits);
+            uint32_t* out = data_.data() + h.offset;
+            for (size_type lane = 0; lane < 4; ++lane) {
+                uint64_t acc = 0;
+                uint32_t filled = 0;
+                size_type w = 0;
+                for (size_type j = 0; j < 32; ++j) {
+                    acc |= (v[4 * j + lane] - lo) << filled;
+                    filled += h.bits;
+                    if (filled >= 32) {
+                        out[4 * w++ + lane] = static_cast<uint32_t>(acc);
+                        acc >>= 32;
+                        filled -= 32;
+                    }
+                }
+            }
+        }
+        blocks_.push_back(h);
+        tail_.clear();
+    }
+
+    /**
+     * @brief 解码一整块（128个值）到out
+     */
+    void unpack_block(const block_header& h, uint64_t* out) const noexcept {
+        const uint32_t* in = data_.data() + h.offset;
+        if (h.bits == 0) {
+            for (size_type i = 0; i < block_size; ++i) {
+                out[i] = h.base;
+            }
+            return;
+        }
+        if (h.bits > 32) {
+            for (size_type i = 0; i < block_size; ++i) {
+                out[i] = h.base + (in[2 * i] | (uint64_t(in[2 * i + 1]) << 32));
+            }
+            return;
+        }
+#if SUGAR_HAS_SSE2
+        const __m128i mask = _mm_set1_epi32(static_cast<int>(low_mask(h.bits)));
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i base = _mm_set1_epi64x(static_cast<long long>(h.base));
+        for (uint32_t j = 0; j < 32; ++j) {
+            const uint32_t bit = j * h.bits;
+            const uint32_t shift = bit & 31;
+            const __m128i* w = reinterpret_cast<const __m128i*>(in + 4 * (bit >> 5));
+            __m128i x = _mm_srl_epi32(_mm_loadu_si128(w), _mm_cvtsi32_si128(static_cast<int>(shift)));
+            if (shift + h.bits > 32) {
+                x = _mm_or_si128(x, _mm_sll_epi32(_mm_loadu_si128(w + 1), _mm_cvtsi32_si128(static_cast<int>(32 - shift))));
+            }
+            x = _mm_and_si128(x, mask);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * j), _mm_add_epi64(_mm_unpacklo_epi32(x, zero), base));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * j + 2), _mm_add_epi64(_mm_unpackhi_epi32(x, zero), base));
+        }
+#else
+        for (size_type i = 0; i < block_size; ++i) {
+            out[i] = unpack_one(h, i);
+        }
+#endif
+    }
+
+    /**
+     * @brief 解码块内第k个值
+     */
+    uint64_t unpack_one(const block_header& h, size_type k) const noexcept {
+        const uint32_t* in = data_.data() + h.offset;
+        if (h.bits == 0) {
+            return h.base;
+        }
+        if (h.bits > 32) {
+            return h.base + (in[2 * k] | (uint64_t(in[2 * k + 1]) << 32));
+        }
+        const size_type lane = k & 3;
+        const uint32_t bit = static_cast<uint32_t>(k >> 2) * h.bits;
+        const uint32_t shift = bit & 31;
+        const uint32_t* w = in + 4 * (bit >> 5) + lane;
+        uint64_t x = w[0] >> shift;
+        if (shift + h.bits > 32) {
+            x |= uint64_t(w[4]) << (32 - shift);
+        }
+        return h.base + (x & low_mask(h.bits));
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 默认构造函数
+     */
+    delta_vector() : size_(0) {}
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief 占用的堆内存字节数
+     */
+    size_type memory_bytes() const noexcept {
+        return blocks_.capacity() * sizeof(block_header) + data_.capacity() * sizeof(uint32_t)
+               + tail_.capacity() * sizeof(uint64_t);
+    }
+
+    void shrink_to_fit() {
+        blocks_.shrink_to_fit();
+        data_.shrink_to_fit();
+        tail_.shrink_to_fit();
+    }
+
+    // ============================ 元素访问 ============================
+
+    uint64_t operator[](size_type i) const noexcept {
+        SUGAR_DEBUG(i < size_);
+        const size_type b = i / block_size;
+        return b < blocks_.size() ? unpack_one(blocks_[b], i % block_size) : tail_[i - b * block_size];
+    }
+
+    uint64_t at(size_type i) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= size_, "delta_vector::at - index out of range");
+        return (*this)[i];
+    }
+
+    /**
+     * @brief 批量解码[first, first + count)到out；整块直接解到out，首尾不完整的块经栈上缓冲区
+     */
+    void decode(size_type first, size_type count, uint64_t* out) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(first > size_ || count > size_ - first,
+                                    "delta_vector::decode - range out of bounds");
+        const size_type last = first + count;
+        const size_type packed = blocks_.size() * block_size;
+        uint64_t buffer[block_size];
+        size_type i = first;
+        while (i < last && i < packed) {
+            const size_type b = i / block_size;
+            const size_type begin = i - b * block_size;
+            size_type end = last - b * block_size;
+            if (end > block_size) {
+                end = block_size;
+            }
+            if (begin == 0 && end == block_size) {
+                unpack_block(blocks_[b], out);
+            } else {
+                unpack_block(blocks_[b], buffer);
+                for (size_type k = begin; k < end; ++k) {
+                    out[k - begin] = buffer[k];
+                }
+            }
+            out += end - begin;
+            i += end - begin;
+        }
+        for (; i < last; ++i) {
+            *out++ = tail_[i - packed];
+        }
+    }
+
+    /**
+     * @brief 全部解码到out
+     */
+    void decode(vector<uint64_t>& out) const {
+        out.resize(size_);
+        decode(0, size_, out.data());
+    }
+
+    // ============================ 修改操作 ============================
+
+    void push_back(uint64_t value) {
+        tail_.push_back(value);
+        ++size_;
+        if (tail_.size() == block_size) {
+            flush_block();
+        }
+    }
+
+    void clear() noexcept {
+        blocks_.clear();
+        data_.clear();
+        tail_.clear();
+        size_ = 0;
+    }
+};
+
+} // namespace sugar
+
+#endif // PACKED_VECTOR_H_
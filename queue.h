@@ -0,0 +1,298 @@
+/*
+ * @file queue.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL priority_queue 容器适配器（d叉堆），完全独立实现，不依赖std
+ */
+
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+#include "vector.h"
+#include "functional.h"
+#include "utility.h"
+#include "exceptdef.h"
+#include <cstddef>
+
+namespace sugar {
+
+// ============================ priority_queue 类模板 ============================
+
+/**
+ * @brief priority_queue 类模板，基于d叉堆的优先队列
+ * @tparam T 元素类型
+ * @tparam Container 底层容器，需支持随机访问、push_back、pop_back，默认为sugar::vector<T>
+ * @tparam Compare 比较函数，默认为sugar::less<T>（大顶堆）
+ * @tparam Arity 堆的叉数，默认为4：树高更低，同一父节点的子节点位于同一缓存行
+ */
+template<typename T, typename Container = vector<T>,
+         typename Compare = less<typename Container::value_type>, size_t Arity = 4>
+class priority_queue {
+    static_assert(Arity >= 2, "priority_queue arity must be at least 2");
+
+public:
+    // ============================ 类型定义 ============================
+    using container_type = Container;
+    using value_compare = Compare;
+    using value_type = typename Container::value_type;
+    using size_type = typename Container::size_type;
+    using reference = typename Container::reference;
+    using const_reference = typename Container::const_reference;
+
+    static constexpr size_t arity = Arity;
+
+private:
+    // ============================ 私有成员 ============================
+    Container c_;   // 底层容器，按d叉堆顺序存储
+    Compare comp_;  // 比较函数
+
+    // ============================ 私有辅助函数 ============================
+
+    /**
+     * @brief 将value从hole处上浮，不超过top
+     * @param hole 当前空位下标
+     * @param top 上浮的最高位置
+     * @param value 需要放入的值
+     */
+    void sift_up(size_type hole, size_type top, value_type value) {
+        while (hole > top) {
+            size_type parent = (hole - 1) / Arity;
+            if (!comp_(c_[parent], value)) {
+                break;
+            }
+            c_[hole] = sugar::move(c_[parent]);
+            hole = parent;
+        }
+        c_[hole] = sugar::move(value);
+    }
+
+    /**
+     * @brief Floyd 自底向上下沉：空位沿最优子节点一路下沉到叶子，再把value上浮。
+     *        被放入的value通常来自堆尾，几乎总要回到底层，这样每层可省去与value的比较
+     * @param hole 空位下标
+     * @param n 堆的大小
+     * @param value 需要放入的值
+     */
+    void sift_down(size_type hole, size_type n, value_type value) {
+        const size_type top = hole;
+        size_type child = Arity * hole + 1;
+        while (child < n) {
+            size_type best = child;
+            size_type end = child + Arity < n ? child + Arity : n;
+            for (size_type i = child + 1; i < end; ++i) {
+                if (comp_(c_[best], c_[i])) {
+                    best = i;
+                }
+            }
+            c_[hole] = sugar::move(c_[best]);
+            hole = best;
+            child = Arity * hole + 1;
+        }
+        sift_up(hole, top, sugar::move(value));
+    }
+
+    /**
+     * @brief 自底向上建堆，O(n)
+     */
+    void heapify() {
+        size_type n = c_.size();
+        if (n < 2) {
+            return;
+        }
+        for (size_type parent = (n - 2) / Arity; ; --parent) {
+            value_type value = sugar::move(c_[parent]);
+            sift_down(parent, n, sugar::move(value));
+            if (parent == 0) {
+                return;
+            }
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 默认构造函数
+     */
+    priority_queue() : c_(), comp_() {}
+
+    /**
+     * @brief 指定比较函数的构造函数
+     * @param comp 比较函数
+     */
+    explicit priority_queue(const Compare& comp) : c_(), comp_(comp) {}
+
+    /**
+     * @brief 从已有容器构造，O(n)建堆
+     * @param comp 比较函数
+     * @param cont 初始元素
+     */
+    priority_queue(const Compare& comp, const Container& cont) : c_(cont), comp_(comp) {
+        heapify();
+    }
+
+    /**
+     * @brief 从已有容器构造（移动版本），O(n)建堆
+     * @param comp 比较函数
+     * @param cont 初始元素
+     */
+    priority_queue(const Compare& comp, Container&& cont) : c_(sugar::move(cont)), comp_(comp) {
+        heapify();
+    }
+
+    /**
+     * @brief 从迭代器范围构造，O(n)建堆
+     * @param first 起始迭代器
+     * @param last 结束迭代器
+     * @param comp 比较函数
+     */
+    template<typename InputIt>
+    priority_queue(InputIt first, InputIt last, const Compare& comp = Compare())
+        : c_(first, last), comp_(comp) {
+        heapify();
+    }
+
+    // ============================ 元素访问 ============================
+
+    /**
+     * @brief 访问堆顶元素
+     * @return 堆顶元素的const引用
+     */
+    const_reference top() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(c_.empty(), "priority_queue::top - queue is empty");
+        return c_[0];
+    }
+
+    // ============================ 容量 ============================
+
+    /**
+     * @brief 检查队列是否为空
+     * @return 如果为空返回true，否则返回false
+     */
+    bool empty() const {
+        return c_.empty();
+    }
+
+    /**
+     * @brief 获取队列大小
+     * @return 元素数量
+     */
+    size_type size() const {
+        return c_.size();
+    }
+
+    /**
+     * @brief 预留底层容器容量
+     * @param n 新的容量
+     */
+    void reserve(size_type n) {
+        c_.reserve(n);
+    }
+
+    // ============================ 修改器 ============================
+
+    /**
+     * @brief 插入元素
+     * @param value 要插入的值
+     */
+    void push(const value_type& value) {
+        c_.push_back(value);
+        value_type tmp = sugar::move(c_[c_.size() - 1]);
+        sift_up(c_.size() - 1, 0, sugar::move(tmp));
+    }
+
+    /**
+     * @brief 插入元素（移动版本）
+     * @param value 要插入的值
+     */
+    void push(value_type&& value) {
+        c_.push_back(sugar::move(value));
+        value_type tmp = sugar::move(c_[c_.size() - 1]);
+        sift_up(c_.size() - 1, 0, sugar::move(tmp));
+    }
+
+    /**
+     * @brief 原地构造并插入元素
+     * @param args 构造参数
+     */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        push(value_type(sugar::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 批量插入元素：新增元素较多时整体重新建堆（O(n)），否则逐个上浮
+     * @param first 起始迭代器
+     * @param last 结束迭代器
+     */
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        size_type old_size = c_.size();
+        for (; first != last; ++first) {
+            c_.push_back(*first);
+        }
+        size_type added = c_.size() - old_size;
+        if (added == 0) {
+            return;
+        }
+        if (added > old_size / 2) {
+            heapify();
+            return;
+        }
+        for (size_type i = old_size; i < c_.size(); ++i) {
+            value_type tmp = sugar::move(c_[i]);
+            sift_up(i, 0, sugar::move(tmp));
+        }
+    }
+
+    /**
+     * @brief 移除堆顶元素
+     */
+    void pop() {
+        SUGAR_THROW_OUT_OF_RANGE_IF(c_.empty(), "priority_queue::pop - queue is empty");
+        size_type n = c_.size() - 1;
+        if (n == 0) {
+            c_.pop_back();
+            return;
+        }
+        value_type value = sugar::move(c_[n]);
+        c_.pop_back();
+        sift_down(0, n, sugar::move(value));
+    }
+
+    /**
+     * @brief 清空队列（保留底层容器容量）
+     */
+    void clear() {
+        c_.clear();
+    }
+
+    /**
+     * @brief 交换两个priority_queue
+     * @param other 要交换的priority_queue
+     */
+    void swap(priority_queue& other) noexcept {
+        sugar::swap(c_, other.c_);
+        sugar::swap(comp_, other.comp_);
+    }
+};
+
+template<typename T, typename Container, typename Compare, size_t Arity>
+constexpr size_t priority_queue<T, Container, Compare, Arity>::arity;
+
+// ============================ 非成员函数 ============================
+
+/**
+ * @brief 交换两个priority_queue
+ * @param lhs 左操作数
+ * @param rhs 右操作数
+ */
+template<typename T, typename Container, typename Compare, size_t Arity>
+void swap(priority_queue<T, Container, Compare, Arity>& lhs,
+          priority_queue<T, Container, Compare, Arity>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace sugar
+
+#endif // QUEUE_H_
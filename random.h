@@ -0,0 +1,588 @@
+/*
+ * @file random.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 随机数：xoshiro256++ / wyrand / pcg32 生成器，有界整数与浮点分布，
+ *        选择抽样与蓄水池抽样、别名法加权抽样，以及SIMD批量生成
+ */
+
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include "algorithm.h"
+#include "hash.h"
+#include "vector.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "utility.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+namespace sugar {
+
+// ============================ 内部辅助 ============================
+
+/**
+ * @brief splitmix64：把任意种子扩散成质量良好的状态字，用于初始化其他生成器
+ * @param state 计数状态，每次调用后递增
+ * @return 下一个输出
+ */
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// ============================ 生成器 ============================
+
+/**
+ * @brief xoshiro256++：256位状态，周期2^256-1，通过BigCrush/PractRand；
+ *        jump()前进2^128步，可为各线程切出互不重叠的子序列
+ */
+class xoshiro256pp {
+public:
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    explicit xoshiro256pp(uint64_t seed_value = 0x853c49e6748fea9bull) {
+        seed(seed_value);
+    }
+
+    /**
+     * @brief 用splitmix64把种子展开成完整状态
+     */
+    void seed(uint64_t seed_value) {
+        for (int i = 0; i < 4; ++i) {
+            s_[i] = splitmix64(seed_value);
+        }
+    }
+
+    result_type operator()() {
+        const uint64_t result = rotl64(s_[0] + s_[3], 23) + s_[0];
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl64(s_[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief 前进2^128步，等价于调用2^128次operator()
+     */
+    void jump() {
+        static const uint64_t polynomial[4] = {
+            0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (polynomial[i] & (uint64_t(1) << b)) {
+                    for (int j = 0; j < 4; ++j) {
+                        t[j] ^= s_[j];
+                    }
+                }
+                (*this)();
+            }
+        }
+        for (int j = 0; j < 4; ++j) {
+            s_[j] = t[j];
+        }
+    }
+
+    /**
+     * @brief 丢弃n个输出
+     */
+    void discard(unsigned long long n) {
+        for (; n > 0; --n) {
+            (*this)();
+        }
+    }
+
+    bool operator==(const xoshiro256pp& other) const {
+        return s_[0] == other.s_[0] && s_[1] == other.s_[1] && s_[2] == other.s_[2] && s_[3] == other.s_[3];
+    }
+    bool operator!=(const xoshiro256pp& other) const { return !(*this == other); }
+
+private:
+    uint64_t s_[4];
+
+    friend class xoshiro256pp_x4;
+};
+
+/**
+ * @brief wyrand：64位状态，每次输出一次加法加一次128位乘法，是目前最快的高质量生成器之一
+ */
+class wyrand {
+public:
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    explicit wyrand(uint64_t seed_value = 0x853c49e6748fea9bull) : state_(seed_value) {}
+
+    void seed(uint64_t seed_value) { state_ = seed_value; }
+
+    result_type operator()() {
+        state_ += 0xa0761d6478bd642full;
+        uint64_t hi;
+        uint64_t lo = mul128(state_, state_ ^ 0xe7037ed1a0b428dbull, hi);
+        return hi ^ lo;
+    }
+
+    void discard(unsigned long long n) { state_ += n * 0xa0761d6478bd642full; }
+
+    bool operator==(const wyrand& other) const { return state_ == other.state_; }
+    bool operator!=(const wyrand& other) const { return !(*this == other); }
+
+private:
+    uint64_t state_;
+};
+
+/**
+ * @brief pcg32（PCG-XSH-RR 64/32）：64位LCG状态加输出置换，输出32位；
+ *        stream选择LCG增量，不同stream的序列互不相关
+ */
+class pcg32 {
+public:
+    using result_type = uint32_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    explicit pcg32(uint64_t seed_value = 0x853c49e6748fea9bull, uint64_t stream = 0xda3e39cb94b95bdbull) {
+        seed(seed_value, stream);
+    }
+
+    void seed(uint64_t seed_value, uint64_t stream = 0xda3e39cb94b95bdbull) {
+        state_ = 0;
+        inc_ = (stream << 1) | 1;
+        (*this)();
+        state_ += seed_value;
+        (*this)();
+    }
+
+    result_type operator()() {
+        const uint64_t old = state_;
+        state_ = old * multiplier + inc_;
+        const uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    /**
+     * @brief O(log n)跳过n个输出（LCG幂的快速计算）
+     */
+    void discard(unsigned long long n) {
+        uint64_t acc_mult = 1;
+        uint64_t acc_plus = 0;
+        uint64_t cur_mult = multiplier;
+        uint64_t cur_plus = inc_;
+        for (; n > 0; n >>= 1) {
+            if (n & 1) {
+                acc_mult *= cur_mult;
+                acc_plus = acc_plus * cur_mult + cur_plus;
+            }
+            cur_plus = (cur_mult + 1) * cur_plus;
+            cur_mult *= cur_mult;
+        }
+        state_ = acc_mult * state_ + acc_plus;
+    }
+
+    bool operator==(const pcg32& other) const { return state_ == other.state_ && inc_ == other.inc_; }
+    bool operator!=(const pcg32& other) const { return !(*this == other); }
+
+private:
+    static const uint64_t multiplier = 6364136223846793005ull;
+
+    uint64_t state_;
+    uint64_t inc_;
+};
+
+// ============================ 分布 ============================
+
+/**
+ * @brief 从任意生成器取出均匀的64位整数：64位生成器直接返回，其他生成器拼接两次32位抽取
+ */
+template<typename URBG>
+uint64_t random_u64(URBG& g) {
+    typedef typename remove_reference<URBG>::type generator_type;
+    const uint64_t range = static_cast<uint64_t>(generator_type::max()) - static_cast<uint64_t>(generator_type::min());
+    if (range == ~uint64_t(0)) {
+        return static_cast<uint64_t>(g()) - static_cast<uint64_t>(generator_type::min());
+    }
+    if (range == 0xffffffffull) {
+        const uint64_t high = static_cast<uint64_t>(g()) - static_cast<uint64_t>(generator_type::min());
+        return (high << 32) | (static_cast<uint64_t>(g()) - static_cast<uint64_t>(generator_type::min()));
+    }
+    const uint64_t high = sugar::uniform_index(g, uint64_t(1) << 32);
+    return (high << 32) | sugar::uniform_index(g, uint64_t(1) << 32);
+}
+
+/**
+ * @brief 均匀抽取闭区间[lo, hi]内的整数，内部使用Lemire几乎无除法的有界整数算法
+ * @param g 生成器
+ * @param lo 下界
+ * @param hi 上界（含），必须不小于lo
+ */
+template<typename IntType, typename URBG>
+IntType uniform_int(URBG& g, IntType lo, IntType hi) {
+    SUGAR_THROW_INVALID_ARGUMENT_IF(hi < lo, "uniform_int - hi is less than lo");
+    const uint64_t span = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    if (span == ~uint64_t(0)) {
+        return static_cast<IntType>(sugar::random_u64(g));
+    }
+    return static_cast<IntType>(static_cast<uint64_t>(lo) + sugar::uniform_index(g, span + 1));
+}
+
+/**
+ * @brief 均匀抽取[0, 1)内的double，取53位随机数保证所有可表示的等间距值等概率
+ */
+template<typename URBG>
+double uniform_real(URBG& g) {
+    return static_cast<double>(sugar::random_u64(g) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief 均匀抽取[lo, hi)内的double
+ */
+template<typename URBG>
+double uniform_real(URBG& g, double lo, double hi) {
+    return lo + (hi - lo) * sugar::uniform_real(g);
+}
+
+/**
+ * @brief 均匀抽取开区间(0, 1)内的double，可安全取对数
+ */
+template<typename URBG>
+double uniform_real_open(URBG& g) {
+    return (static_cast<double>(sugar::random_u64(g) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// ============================ 抽样 ============================
+
+/**
+ * @brief 选择抽样（Knuth算法S）：已知总数时逐个决定是否选中，输出保持原有相对顺序
+ */
+template<typename ForwardIt, typename OutputIt, typename Distance, typename URBG>
+OutputIt sample_dispatch(ForwardIt first, ForwardIt last, OutputIt out, Distance n, URBG& g,
+                         forward_iterator_tag) {
+    typedef unsigned long long u64;
+    u64 unsampled = static_cast<u64>(sugar::distance(first, last));
+    u64 remaining = static_cast<u64>(n);
+    if (remaining > unsampled) {
+        remaining = unsampled;
+    }
+    for (; remaining != 0; ++first, --unsampled) {
+        if (sugar::uniform_index(g, unsampled) < remaining) {
+            *out = *first;
+            ++out;
+            --remaining;
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief 蓄水池抽样（Li的算法L）：只遍历一遍、总数未知；
+ *        用几何分布直接算出下一个被替换的位置，期望只抽取O(k log(N/k))次随机数。
+ *        输出必须是随机访问迭代器，且顺序不保证
+ */
+template<typename InputIt, typename RandomIt, typename Distance, typename URBG>
+RandomIt sample_dispatch(InputIt first, InputIt last, RandomIt out, Distance n, URBG& g,
+                         input_iterator_tag) {
+    typedef unsigned long long u64;
+    const u64 k = static_cast<u64>(n);
+    if (k == 0) {
+        return out;
+    }
+    u64 filled = 0;
+    for (; first != last && filled < k; ++first, ++filled) {
+        out[filled] = *first;
+    }
+    if (filled < k) {
+        return out + filled;
+    }
+    const double inv_k = 1.0 / static_cast<double>(k);
+    double w = std::exp(std::log(sugar::uniform_real_open(g)) * inv_k);
+    while (first != last) {
+        // 跳过的元素个数服从几何分布
+        double skip = std::floor(std::log(sugar::uniform_real_open(g)) / std::log1p(-w));
+        for (; skip > 0 && first != last; skip -= 1) {
+            ++first;
+        }
+        if (first == last) {
+            break;
+        }
+        out[sugar::uniform_index(g, k)] = *first;
+        ++first;
+        w *= std::exp(std::log(sugar::uniform_real_open(g)) * inv_k);
+    }
+    return out + k;
+}
+
+/**
+ * @brief 从[first, last)中无放回地等概率抽取min(n, 总数)个元素
+ *
+ * 前向迭代器用选择抽样，结果保持原顺序；单遍输入迭代器用蓄水池抽样，此时out必须可随机访问。
+ *
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param out 输出迭代器
+ * @param n 抽取个数，非负
+ * @param g 生成器
+ * @return 输出结束位置
+ */
+template<typename PopulationIt, typename SampleIt, typename Distance, typename URBG>
+SampleIt sample(PopulationIt first, PopulationIt last, SampleIt out, Distance n, URBG&& g) {
+    return sugar::sample_dispatch(first, last, out, n, g,
+                                  typename iterator_traits<PopulationIt>::iterator_category());
+}
+
+// ============================ alias_table 类 ============================
+
+/**
+ * @brief alias_table 类，Vose别名法加权抽样
+ *
+ * 构造O(n)，每次抽样O(1)：一个64位随机数的高32位选桶，低32位与桶的阈值比较决定取桶本身还是其别名。
+ * 选桶使用乘法缩放而非拒绝采样，桶数为n时各桶概率的相对偏差不超过n/2^32。
+ */
+class alias_table {
+public:
+    using size_type = size_t;
+
+private:
+    // ============================ 私有成员 ============================
+    vector<uint32_t> threshold_;   // 低32位小于阈值时取桶本身
+    vector<uint32_t> alias_;       // 否则取别名
+
+public:
+    // ============================ 构造函数 ============================
+
+    alias_table() = default;
+
+    /**
+     * @brief 由权重序列构造
+     * @param first 权重起始迭代器，权重需非负且有限，总和大于0
+     * @param last 权重结束迭代器
+     */
+    template<typename InputIt>
+    alias_table(InputIt first, InputIt last) {
+        assign(first, last);
+    }
+
+    /**
+     * @brief 重新设置权重
+     */
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        vector<double> p;
+        double sum = 0;
+        for (; first != last; ++first) {
+            const double w = static_cast<double>(*first);
+            SUGAR_THROW_INVALID_ARGUMENT_IF(!(w >= 0) || !std::isfinite(w), "alias_table - invalid weight");
+            p.push_back(w);
+            sum += w;
+        }
+        const size_type n = p.size();
+        SUGAR_THROW_INVALID_ARGUMENT_IF(n == 0 || !(sum > 0) || !std::isfinite(sum), "alias_table - invalid weights");
+        SUGAR_THROW_LENGTH_ERROR_IF(n > 0xffffffffull, "alias_table - too many weights");
+
+        threshold_.assign(n, ~uint32_t(0));
+        alias_.assign(n, 0);
+        vector<uint32_t> small;
+        vector<uint32_t> large;
+        const double scale = static_cast<double>(n) / sum;
+        for (size_type i = 0; i < n; ++i) {
+            p[i] *= scale;
+            alias_[i] = static_cast<uint32_t>(i);
+            if (p[i] < 1.0) {
+                small.push_back(static_cast<uint32_t>(i));
+            } else {
+                large.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        while (!small.empty() && !large.empty()) {
+            const uint32_t s = small.back();
+            small.pop_back();
+            const uint32_t l = large.back();
+            double fraction = p[s] * 4294967296.0;
+            threshold_[s] = fraction >= 4294967295.0 ? ~uint32_t(0) : static_cast<uint32_t>(fraction);
+            alias_[s] = l;
+            p[l] = (p[l] + p[s]) - 1.0;
+            if (p[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // 剩下的桶概率应为1，舍入误差留下的也按1处理（阈值全满、别名指向自身）
+    }
+
+    // ============================ 访问 ============================
+
+    size_type size() const noexcept { return threshold_.size(); }
+    bool empty() const noexcept { return threshold_.empty(); }
+
+    /**
+     * @brief 下标i被抽中的概率（由表反推，用于检验）
+     */
+    double probability(size_type i) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= size(), "alias_table::probability - index out of range");
+        const double bucket = 1.0 / static_cast<double>(size());
+        double p = 0;
+        for (size_type j = 0; j < size(); ++j) {
+            const double keep = alias_[j] == j ? 1.0 : static_cast<double>(threshold_[j]) / 4294967296.0;
+            if (j == i) {
+                p += keep * bucket;
+            }
+            if (alias_[j] == i && j != i) {
+                p += (1.0 - keep) * bucket;
+            }
+        }
+        return p;
+    }
+
+    /**
+     * @brief 抽取一个下标
+     */
+    template<typename URBG>
+    size_type operator()(URBG& g) const {
+        const uint64_t x = sugar::random_u64(g);
+        const size_type i = static_cast<size_type>(((x >> 32) * threshold_.size()) >> 32);
+        return static_cast<uint32_t>(x) < threshold_[i] ? i : alias_[i];
+    }
+};
+
+// ============================ 批量生成 ============================
+
+/**
+ * @brief xoshiro256pp_x4：4路交错的xoshiro256++，专用于批量填充
+ *
+ * 4条通道的状态按“分量”存放（s[k][lane]），每步用两组SSE2寄存器各推进2条通道，
+ * 各通道由jump()错开2^128步，互不重叠。输出序列与单个xoshiro256pp不同，但每条通道质量相同。
+ */
+class xoshiro256pp_x4 {
+public:
+    using result_type = uint64_t;
+    static const size_t lanes = 4;
+
+    explicit xoshiro256pp_x4(uint64_t seed_value = 0x853c49e6748fea9bull) {
+        seed(seed_value);
+    }
+
+    void seed(uint64_t seed_value) {
+        xoshiro256pp g(seed_value);
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            for (int k = 0; k < 4; ++k) {
+                s_[k][lane] = g.s_[k];
+            }
+            g.jump();
+        }
+    }
+
+    /**
+     * @brief 用随机64位整数填满[first, last)
+     */
+    void fill(uint64_t* first, uint64_t* last) {
+        const size_t blocks = static_cast<size_t>(last - first) / lanes;
+        generate_blocks(first, blocks);
+        first += blocks * lanes;
+        if (first != last) {
+            uint64_t tail[lanes];
+            generate_blocks(tail, 1);
+            for (size_t i = 0; first != last; ++first, ++i) {
+                *first = tail[i];
+            }
+        }
+    }
+
+    /**
+     * @brief 用[0, 1)内的double填满[first, last)
+     */
+    void fill_real(double* first, double* last) {
+        uint64_t block[lanes];
+        while (first != last) {
+            generate_blocks(block, 1);
+            for (size_t i = 0; i < lanes && first != last; ++i, ++first) {
+                *first = static_cast<double>(block[i] >> 11) * (1.0 / 9007199254740992.0);
+            }
+        }
+    }
+
+    /**
+     * @brief 把count个随机64位整数写入out（覆盖原有内容）
+     */
+    void generate(vector<uint64_t>& out, size_t count) {
+        out.resize(count);
+        fill(out.data(), out.data() + count);
+    }
+
+private:
+    alignas(16) uint64_t s_[4][lanes];
+
+    // 连续推进blocks步，每步写出4个结果；状态在循环中保持在寄存器里
+    void generate_blocks(uint64_t* out, size_t blocks) {
+#if SUGAR_HAS_SSE2
+        __m128i s0a = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[0][0]));
+        __m128i s0b = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[0][2]));
+        __m128i s1a = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[1][0]));
+        __m128i s1b = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[1][2]));
+        __m128i s2a = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[2][0]));
+        __m128i s2b = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[2][2]));
+        __m128i s3a = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[3][0]));
+        __m128i s3b = _mm_load_si128(reinterpret_cast<const __m128i*>(&s_[3][2]));
+        for (size_t i = 0; i < blocks; ++i, out += lanes) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), next_sse2(s0a, s1a, s2a, s3a));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2), next_sse2(s0b, s1b, s2b, s3b));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[0][0]), s0a);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[0][2]), s0b);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[1][0]), s1a);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[1][2]), s1b);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[2][0]), s2a);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[2][2]), s2b);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[3][0]), s3a);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&s_[3][2]), s3b);
+#else
+        for (size_t i = 0; i < blocks; ++i, out += lanes) {
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                out[lane] = rotl64(s_[0][lane] + s_[3][lane], 23) + s_[0][lane];
+                const uint64_t t = s_[1][lane] << 17;
+                s_[2][lane] ^= s_[0][lane];
+                s_[3][lane] ^= s_[1][lane];
+                s_[1][lane] ^= s_[2][lane];
+                s_[0][lane] ^= s_[3][lane];
+                s_[2][lane] ^= t;
+                s_[3][lane] = rotl64(s_[3][lane], 45);
+            }
+        }
+#endif
+    }
+
+#if SUGAR_HAS_SSE2
+    // 两条通道各推进一步，返回两个输出
+    static __m128i next_sse2(__m128i& s0, __m128i& s1, __m128i& s2, __m128i& s3) {
+        const __m128i sum = _mm_add_epi64(s0, s3);
+        const __m128i result = _mm_add_epi64(_mm_or_si128(_mm_slli_epi64(sum, 23), _mm_srli_epi64(sum, 41)), s0);
+        const __m128i t = _mm_slli_epi64(s1, 17);
+        s2 = _mm_xor_si128(s2, s0);
+        s3 = _mm_xor_si128(s3, s1);
+        s1 = _mm_xor_si128(s1, s2);
+        s0 = _mm_xor_si128(s0, s3);
+        s2 = _mm_xor_si128(s2, t);
+        s3 = _mm_or_si128(_mm_slli_epi64(s3, 45), _mm_srli_epi64(s3, 19));
+        return result;
+    }
+#endif
+};
+
+} // namespace sugar
+
+#endif // RANDOM_H_
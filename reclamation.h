@@ -0,0 +1,606 @@
+/*
+ * @file reclamation.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 无锁结构的内存回收：基于纪元的回收（EBR，每线程三个待回收桶）与危险指针（有界的待回收量），
+ *        被摘下的节点按批通过 allocator.h 的分配器析构并释放
+ */
+
+#ifndef RECLAMATION_H_
+#define RECLAMATION_H_
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "utility.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace sugar {
+
+// ============================ 待回收节点 ============================
+
+/**
+ * @brief 一个已从数据结构摘下、等待回收的对象及其回收函数
+ */
+struct retired_node {
+    void* ptr;
+    void (*reclaim)(void*);
+};
+
+/**
+ * @brief 用分配器Alloc析构并释放单个T对象，分配器须是无状态的
+ */
+template<typename T, typename Alloc>
+void reclaim_with_allocator(void* p) {
+    Alloc alloc;
+    T* obj = static_cast<T*>(p);
+    allocator_traits<Alloc>::destroy(alloc, obj);
+    allocator_traits<Alloc>::deallocate(alloc, obj, 1);
+}
+
+/**
+ * @brief 按批执行回收函数
+ */
+inline void reclaim_batch(vector<retired_node>& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].reclaim(batch[i].ptr);
+    }
+    batch.clear();
+}
+
+// ============================ epoch_domain 类 ============================
+
+/**
+ * @brief epoch_domain 类，基于纪元的内存回收（EBR）
+ *
+ * 全局纪元单调递增。线程访问共享结构前 pin()，把自己标记为“活跃于当前纪元”；
+ * 只有所有活跃线程都已进入当前纪元时，全局纪元才能前进一步。
+ * 在纪元e被摘下的对象，等全局纪元到达e+2时，所有可能持有它的读者都已退出临界区，可以安全释放。
+ *
+ * 每个线程通过 attach() 取得一个 handle，摘下的对象先进入handle自己的三个待回收桶（按纪元模3），
+ * 纪元推进后整桶按批回收。读操作只付出一次存储加一次栅栏的代价，与访问的节点个数无关；
+ * 代价是某个线程长时间停在临界区内会阻止纪元推进，待回收对象随之无界增长。
+ * handle 析构时尚未到期的对象交给域统一保管，由其他线程在之后的回收中释放。
+ */
+class epoch_domain {
+private:
+    // 线程记录：state为 纪元<<1 | 活跃位。按缓存行填充，避免各线程的记录伪共享
+    struct record {
+        std::atomic<uint64_t> state;
+        std::atomic<bool> in_use;
+        record* next;
+        char pad[64];
+
+        record() : state(0), in_use(true), next(nullptr) {}
+    };
+
+    struct orphan {
+        retired_node node;
+        uint64_t epoch;
+    };
+
+    static const size_t collect_interval = 64;  // 每摘下这么多对象尝试推进一次纪元
+
+    // ============================ 私有成员 ============================
+    std::atomic<uint64_t> epoch_;
+    std::atomic<record*> records_;   // 只增不减的记录链表，handle析构后记录可被复用
+    std::mutex orphan_lock_;
+    vector<orphan> orphans_;
+
+    // ============================ 私有辅助函数 ============================
+
+    record* acquire_record() {
+        for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed)
+                && r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return r;
+            }
+        }
+        record* r = new record();
+        r->next = records_.load(std::memory_order_relaxed);
+        while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return r;
+    }
+
+    /**
+     * @brief 所有活跃线程都已进入当前纪元时把全局纪元加一，返回（可能已前进的）全局纪元
+     */
+    uint64_t try_advance() {
+        // 与enter中的栅栏配对：摘下对象的写入先于扫描，扫描必能看到之前已进入临界区的读者
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint64_t e = epoch_.load(std::memory_order_seq_cst);
+        for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            const uint64_t s = r->state.load(std::memory_order_seq_cst);
+            if ((s & 1) != 0 && (s >> 1) != e) {
+                return e;
+            }
+        }
+        uint64_t expected = e;
+        if (epoch_.compare_exchange_strong(expected, e + 1, std::memory_order_seq_cst)) {
+            return e + 1;
+        }
+        return expected;
+    }
+
+    /**
+     * @brief 回收已到期的托管对象；拿不到锁时跳过，下次再试
+     */
+    void collect_orphans(uint64_t e) {
+        std::unique_lock<std::mutex> guard(orphan_lock_, std::try_to_lock);
+        if (!guard.owns_lock() || orphans_.empty()) {
+            return;
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < orphans_.size(); ++i) {
+            if (orphans_[i].epoch + 2 <= e) {
+                orphans_[i].node.reclaim(orphans_[i].node.ptr);
+            } else {
+                orphans_[kept++] = orphans_[i];
+            }
+        }
+        orphans_.resize(kept);
+    }
+
+public:
+    // ============================ handle 类 ============================
+
+    class guard;
+
+    /**
+     * @brief handle 类，线程访问域的入口，同一时刻只能由一个线程使用
+     */
+    class handle {
+        friend class epoch_domain;
+
+    private:
+        epoch_domain* domain_;
+        record* record_;
+        size_t nesting_;                 // pin的嵌套层数
+        size_t since_collect_;
+        vector<retired_node> limbo_[3];  // 按摘下时的纪元模3分桶
+        uint64_t limbo_epoch_[3];
+
+        explicit handle(epoch_domain* domain)
+            : domain_(domain), record_(domain->acquire_record()), nesting_(0), since_collect_(0) {
+            limbo_epoch_[0] = limbo_epoch_[1] = limbo_epoch_[2] = 0;
+        }
+
+        /**
+         * @brief 回收全局纪元为e时已到期的桶
+         */
+        void reclaim_expired(uint64_t e) {
+            for (int i = 0; i < 3; ++i) {
+                if (!limbo_[i].empty() && limbo_epoch_[i] + 2 <= e) {
+                    reclaim_batch(limbo_[i]);
+                }
+            }
+        }
+
+        void detach() {
+            if (domain_ == nullptr) {
+                return;
+            }
+            SUGAR_DEBUG(nesting_ == 0);
+            collect();
+            {
+                std::lock_guard<std::mutex> guard(domain_->orphan_lock_);
+                for (int i = 0; i < 3; ++i) {
+                    for (size_t j = 0; j < limbo_[i].size(); ++j) {
+                        orphan o = {limbo_[i][j], limbo_epoch_[i]};
+                        domain_->orphans_.push_back(o);
+                    }
+                    limbo_[i].clear();
+                }
+            }
+            record_->state.store(0, std::memory_order_relaxed);
+            record_->in_use.store(false, std::memory_order_release);
+            domain_ = nullptr;
+            record_ = nullptr;
+        }
+
+    public:
+        handle(const handle&) = delete;
+        handle& operator=(const handle&) = delete;
+
+        handle(handle&& other) noexcept
+            : domain_(other.domain_), record_(other.record_), nesting_(other.nesting_),
+              since_collect_(other.since_collect_) {
+            for (int i = 0; i < 3; ++i) {
+                limbo_[i].swap(other.limbo_[i]);
+                limbo_epoch_[i] = other.limbo_epoch_[i];
+            }
+            other.domain_ = nullptr;
+            other.record_ = nullptr;
+        }
+
+        ~handle() { detach(); }
+
+        /**
+         * @brief 进入临界区，可以嵌套
+         */
+        void enter() noexcept {
+            if (nesting_++ == 0) {
+                const uint64_t e = domain_->epoch_.load(std::memory_order_relaxed);
+                record_->state.store(e << 1 | 1, std::memory_order_relaxed);
+                // 与try_advance中扫描前的栅栏配对：之后对共享结构的读取（哪怕是relaxed/acquire）
+                // 不会被重排到活跃标记可见之前
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        /**
+         * @brief 离开临界区，此后不得再使用临界区内读到的指针
+         */
+        void leave() noexcept {
+            SUGAR_DEBUG(nesting_ > 0);
+            if (--nesting_ == 0) {
+                record_->state.store(record_->state.load(std::memory_order_relaxed) & ~uint64_t(1),
+                                     std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief 进入临界区并返回离开时自动调用leave()的守卫
+         */
+        guard pin() noexcept;
+
+        bool pinned() const noexcept { return nesting_ > 0; }
+
+        /**
+         * @brief 摘下对象p，到期后用回收函数reclaim释放
+         */
+        void retire(void* p, void (*reclaim)(void*)) {
+            // 调用者摘下对象的写入先于读取纪元，对象不会被标记为比仍可能读到它的读者更早的纪元
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const uint64_t e = domain_->epoch_.load(std::memory_order_acquire);
+            const int i = static_cast<int>(e % 3);
+            if (limbo_epoch_[i] != e) {
+                // 桶里是e-3或更早摘下的对象，早已到期
+                reclaim_batch(limbo_[i]);
+                limbo_epoch_[i] = e;
+            }
+            retired_node n = {p, reclaim};
+            limbo_[i].push_back(n);
+            if (++since_collect_ >= collect_interval) {
+                collect();
+            }
+        }
+
+        /**
+         * @brief 摘下由Alloc分配的对象p，到期后用Alloc析构并释放
+         */
+        template<typename T, typename Alloc = allocator<T>>
+        void retire(T* p) {
+            retire(p, &reclaim_with_allocator<T, Alloc>);
+        }
+
+        /**
+         * @brief 尝试推进纪元并回收已到期的对象
+         */
+        void collect() {
+            since_collect_ = 0;
+            const uint64_t e = domain_->try_advance();
+            reclaim_expired(e);
+            domain_->collect_orphans(e);
+        }
+
+        /**
+         * @brief 本handle中尚未回收的对象个数
+         */
+        size_t pending() const noexcept { return limbo_[0].size() + limbo_[1].size() + limbo_[2].size(); }
+    };
+
+    /**
+     * @brief guard 类，作用域内保持临界区
+     */
+    class guard {
+        friend class handle;
+
+    private:
+        handle* handle_;
+
+        explicit guard(handle* h) noexcept : handle_(h) {}
+
+    public:
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+        guard(guard&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+
+        ~guard() {
+            if (handle_ != nullptr) {
+                handle_->leave();
+            }
+        }
+    };
+
+    // ============================ 构造函数 ============================
+
+    epoch_domain() : epoch_(0), records_(nullptr) {}
+
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    /**
+     * @brief 析构函数，此时所有handle必须已经析构
+     */
+    ~epoch_domain() {
+        for (size_t i = 0; i < orphans_.size(); ++i) {
+            orphans_[i].node.reclaim(orphans_[i].node.ptr);
+        }
+        record* r = records_.load(std::memory_order_relaxed);
+        while (r != nullptr) {
+            record* next = r->next;
+            SUGAR_DEBUG(!r->in_use.load(std::memory_order_relaxed));
+            delete r;
+            r = next;
+        }
+    }
+
+    // ============================ 操作 ============================
+
+    /**
+     * @brief 为当前线程注册一个handle
+     */
+    handle attach() { return handle(this); }
+
+    /**
+     * @brief 当前全局纪元
+     */
+    uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_relaxed); }
+};
+
+inline epoch_domain::guard epoch_domain::handle::pin() noexcept {
+    enter();
+    return guard(this);
+}
+
+// ============================ hazard_domain 类 ============================
+
+/**
+ * @brief hazard_domain 类，危险指针（hazard pointer）内存回收
+ *
+ * 读者在解引用共享指针前先把它发布到自己的危险指针槽，再确认源位置仍指向它；
+ * 回收方只释放不在任何槽中的对象。每个线程的待回收对象攒到阈值（不少于全部槽数的两倍）
+ * 时扫描一次：收集所有槽、排序，逐个二分判断。因此每个线程积压的对象不超过阈值，
+ * 即使有线程停在临界区内，最多也只有它发布的那几个对象无法回收。
+ * 代价是读者每经过一个节点都要一次存储加一次全栅栏，遍历长链表时明显慢于EBR。
+ */
+class hazard_domain {
+public:
+    /**
+     * @brief 每个handle的危险指针槽数
+     */
+    static const size_t slots = 4;
+
+private:
+    struct record {
+        std::atomic<void*> hazards[slots];
+        std::atomic<bool> in_use;
+        record* next;
+        char pad[64];
+
+        record() : in_use(true), next(nullptr) {
+            for (size_t i = 0; i < slots; ++i) {
+                hazards[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    static const size_t min_threshold = 64;
+
+    // ============================ 私有成员 ============================
+    std::atomic<record*> records_;
+    std::atomic<size_t> record_count_;
+    std::mutex orphan_lock_;
+    vector<retired_node> orphans_;
+
+    // ============================ 私有辅助函数 ============================
+
+    record* acquire_record() {
+        for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed)
+                && r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return r;
+            }
+        }
+        record* r = new record();
+        r->next = records_.load(std::memory_order_relaxed);
+        while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        record_count_.fetch_add(1, std::memory_order_relaxed);
+        return r;
+    }
+
+    /**
+     * @brief 收集当前发布的所有危险指针，排序后用于二分查找
+     */
+    void snapshot(vector<void*>& out) const {
+        out.clear();
+        for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            for (size_t i = 0; i < slots; ++i) {
+                void* p = r->hazards[i].load(std::memory_order_seq_cst);
+                if (p != nullptr) {
+                    out.push_back(p);
+                }
+            }
+        }
+        sugar::sort(out.begin(), out.end());
+    }
+
+public:
+    // ============================ handle 类 ============================
+
+    /**
+     * @brief handle 类，线程访问域的入口，同一时刻只能由一个线程使用
+     */
+    class handle {
+        friend class hazard_domain;
+
+    private:
+        hazard_domain* domain_;
+        record* record_;
+        vector<retired_node> retired_;
+        vector<void*> scratch_;
+
+        explicit handle(hazard_domain* domain) : domain_(domain), record_(domain->acquire_record()) {}
+
+        size_t threshold() const noexcept {
+            const size_t n = 2 * slots * domain_->record_count_.load(std::memory_order_relaxed);
+            return n < min_threshold ? min_threshold : n;
+        }
+
+        void detach() {
+            if (domain_ == nullptr) {
+                return;
+            }
+            clear_all();
+            scan();
+            if (!retired_.empty()) {
+                std::lock_guard<std::mutex> guard(domain_->orphan_lock_);
+                for (size_t i = 0; i < retired_.size(); ++i) {
+                    domain_->orphans_.push_back(retired_[i]);
+                }
+                retired_.clear();
+            }
+            record_->in_use.store(false, std::memory_order_release);
+            domain_ = nullptr;
+            record_ = nullptr;
+        }
+
+    public:
+        handle(const handle&) = delete;
+        handle& operator=(const handle&) = delete;
+
+        handle(handle&& other) noexcept : domain_(other.domain_), record_(other.record_) {
+            retired_.swap(other.retired_);
+            other.domain_ = nullptr;
+            other.record_ = nullptr;
+        }
+
+        ~handle() { detach(); }
+
+        /**
+         * @brief 读取src并发布到第slot个槽，返回时该对象在槽被覆盖或清除之前不会被回收
+         */
+        template<typename T>
+        T* protect(size_t slot, const std::atomic<T*>& src) noexcept {
+            T* p = src.load(std::memory_order_relaxed);
+            for (;;) {
+                // 发布与复查都是seq_cst：复查仍读到p，则扫描方一定能看到这次发布
+                record_->hazards[slot].store(p, std::memory_order_seq_cst);
+                T* q = src.load(std::memory_order_seq_cst);
+                if (q == p) {
+                    return p;
+                }
+                p = q;
+            }
+        }
+
+        /**
+         * @brief 直接发布p，调用者负责在之后确认p仍可达
+         */
+        void set(size_t slot, void* p) noexcept {
+            record_->hazards[slot].store(p, std::memory_order_seq_cst);
+        }
+
+        void clear(size_t slot) noexcept { record_->hazards[slot].store(nullptr, std::memory_order_release); }
+
+        void clear_all() noexcept {
+            for (size_t i = 0; i < slots; ++i) {
+                clear(i);
+            }
+        }
+
+        /**
+         * @brief 摘下对象p，待其不在任何危险指针槽中后用回收函数reclaim释放
+         */
+        void retire(void* p, void (*reclaim)(void*)) {
+            retired_node n = {p, reclaim};
+            retired_.push_back(n);
+            if (retired_.size() >= threshold()) {
+                scan();
+            }
+        }
+
+        template<typename T, typename Alloc = allocator<T>>
+        void retire(T* p) {
+            retire(p, &reclaim_with_allocator<T, Alloc>);
+        }
+
+        /**
+         * @brief 回收所有未被保护的已摘下对象，并顺带接管域中托管的对象
+         */
+        void scan() {
+            // 与protect中的发布配对：调用者摘下对象的写入先于读取危险指针槽，
+            // 复查仍读到旧指针的读者一定出现在快照中
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> guard(domain_->orphan_lock_, std::try_to_lock);
+                if (guard.owns_lock() && !domain_->orphans_.empty()) {
+                    for (size_t i = 0; i < domain_->orphans_.size(); ++i) {
+                        retired_.push_back(domain_->orphans_[i]);
+                    }
+                    domain_->orphans_.clear();
+                }
+            }
+            domain_->snapshot(scratch_);
+            size_t kept = 0;
+            for (size_t i = 0; i < retired_.size(); ++i) {
+                const retired_node n = retired_[i];
+                vector<void*>::iterator pos = sugar::lower_bound(scratch_.begin(), scratch_.end(), n.ptr);
+                if (pos != scratch_.end() && *pos == n.ptr) {
+                    retired_[kept++] = n;
+                } else {
+                    n.reclaim(n.ptr);
+                }
+            }
+            retired_.resize(kept);
+        }
+
+        /**
+         * @brief 本handle中尚未回收的对象个数
+         */
+        size_t pending() const noexcept { return retired_.size(); }
+    };
+
+    // ============================ 构造函数 ============================
+
+    hazard_domain() : records_(nullptr), record_count_(0) {}
+
+    hazard_domain(const hazard_domain&) = delete;
+    hazard_domain& operator=(const hazard_domain&) = delete;
+
+    /**
+     * @brief 析构函数，此时所有handle必须已经析构
+     */
+    ~hazard_domain() {
+        for (size_t i = 0; i < orphans_.size(); ++i) {
+            orphans_[i].reclaim(orphans_[i].ptr);
+        }
+        record* r = records_.load(std::memory_order_relaxed);
+        while (r != nullptr) {
+            record* next = r->next;
+            SUGAR_DEBUG(!r->in_use.load(std::memory_order_relaxed));
+            delete r;
+            r = next;
+        }
+    }
+
+    // ============================ 操作 ============================
+
+    /**
+     * @brief 为当前线程注册一个handle
+     */
+    handle attach() { return handle(this); }
+};
+
+} // namespace sugar
+
+#endif // RECLAMATION_H_
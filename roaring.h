@@ -0,0 +1,1582 @@
+/*
+ * @file roaring.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 压缩位图：32位整数按高16位分块，每块按密度选用数组、位图或行程容器（Roaring 格式），
+ *        支持SIMD集合运算、rank/select以及可直接mmap读取的序列化格式
+ */
+
+#ifndef ROARING_H_
+#define ROARING_H_
+
+#include "algorithm.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace sugar {
+
+// ============================ 位运算工具 ============================
+
+/**
+ * @brief 位图容器的字数（65536位）
+ */
+const uint32_t roaring_bitmap_words = 1024;
+
+/**
+ * @brief 数组容器的最大元素数；超过后位图（8KB）更省内存
+ */
+const uint32_t roaring_array_max = 4096;
+
+/**
+ * @brief 64位字中1的个数（SWAR，不依赖POPCNT指令）
+ */
+inline uint32_t roaring_popcount64(uint64_t x) noexcept {
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<uint32_t>((x * 0x0101010101010101ull) >> 56);
+}
+
+#if SUGAR_HAS_SSE2
+/**
+ * @brief 128位中1的个数：先逐字节SWAR计数，再用_mm_sad_epu8横向求和，结果为两个64位部分和
+ */
+inline __m128i roaring_popcount_sse2(__m128i v) {
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0f);
+    v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+    v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+    v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+    return _mm_sad_epu8(v, _mm_setzero_si128());
+}
+
+inline uint32_t roaring_sum_lanes(__m128i v) {
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v);
+    return static_cast<uint32_t>(lanes[0] + lanes[1]);
+}
+#endif
+
+struct roaring_and_op {
+    static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a & b; }
+#if SUGAR_HAS_SSE2
+    static __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+};
+
+struct roaring_or_op {
+    static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a | b; }
+#if SUGAR_HAS_SSE2
+    static __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+};
+
+struct roaring_andnot_op {
+    static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a & ~b; }
+#if SUGAR_HAS_SSE2
+    static __m128i apply(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+};
+
+/**
+ * @brief 对两个位图容器逐字做Op，写入out，同时统计结果的基数
+ */
+template<typename Op>
+inline uint32_t roaring_words_op(const uint64_t* a, const uint64_t* b, uint64_t* out) noexcept {
+#if SUGAR_HAS_SSE2
+    __m128i total = _mm_setzero_si128();
+    for (uint32_t i = 0; i < roaring_bitmap_words; i += 2) {
+        const __m128i v = Op::apply(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        total = _mm_add_epi64(total, sugar::roaring_popcount_sse2(v));
+    }
+    return sugar::roaring_sum_lanes(total);
+#else
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < roaring_bitmap_words; ++i) {
+        out[i] = Op::apply(a[i], b[i]);
+        count += sugar::roaring_popcount64(out[i]);
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief 位图容器的基数
+ */
+inline uint32_t roaring_words_count(const uint64_t* a) noexcept {
+#if SUGAR_HAS_SSE2
+    __m128i total = _mm_setzero_si128();
+    for (uint32_t i = 0; i < roaring_bitmap_words; i += 2) {
+        total = _mm_add_epi64(total, sugar::roaring_popcount_sse2(
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))));
+    }
+    return sugar::roaring_sum_lanes(total);
+#else
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < roaring_bitmap_words; ++i) {
+        count += sugar::roaring_popcount64(a[i]);
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief 置位[lo, hi)
+ */
+inline void roaring_set_range(uint64_t* words, uint32_t lo, uint32_t hi) noexcept {
+    if (lo >= hi) {
+        return;
+    }
+    const uint32_t first = lo >> 6;
+    const uint32_t last = (hi - 1) >> 6;
+    const uint64_t first_mask = ~uint64_t(0) << (lo & 63);
+    const uint64_t last_mask = ~uint64_t(0) >> (63 - ((hi - 1) & 63));
+    if (first == last) {
+        words[first] |= first_mask & last_mask;
+        return;
+    }
+    words[first] |= first_mask;
+    for (uint32_t i = first + 1; i < last; ++i) {
+        words[i] = ~uint64_t(0);
+    }
+    words[last] |= last_mask;
+}
+
+/**
+ * @brief 两个升序uint16_t数组求交，返回写入out的个数。规模相近时用无分支归并
+ *        （随机数据上分支归并的预测失败率接近一半），悬殊时交给 sugar::set_intersection 的galloping
+ */
+inline uint32_t roaring_intersect_arrays(const uint16_t* a, uint32_t na, const uint16_t* b, uint32_t nb,
+                                         uint16_t* out) noexcept {
+    if (sugar::set_is_skewed(na, nb)) {
+        return static_cast<uint32_t>(sugar::set_intersection(a, a + na, b, b + nb, out) - out);
+    }
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t n = 0;
+    while (i < na && j < nb) {
+        const uint16_t x = a[i];
+        const uint16_t y = b[j];
+        out[n] = x;
+        n += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+    return n;
+}
+
+// ============================ 序列化字节序 ============================
+
+// 序列化格式固定为小端，逐字节读写，与主机字节序和对齐无关
+
+inline void roaring_store16(unsigned char* p, uint16_t v) noexcept {
+    p[0] = static_cast<unsigned char>(v);
+    p[1] = static_cast<unsigned char>(v >> 8);
+}
+
+inline void roaring_store32(unsigned char* p, uint32_t v) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline void roaring_store64(unsigned char* p, uint64_t v) noexcept {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline uint16_t roaring_load16(const unsigned char* p) noexcept {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t roaring_load32(const unsigned char* p) noexcept {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t roaring_load64(const unsigned char* p) noexcept {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// ============================ roaring_bitmap 类 ============================
+
+/**
+ * @brief 容器类型
+ */
+enum class roaring_container_type : uint8_t {
+    array = 0,     // 升序uint16_t数组，元素不超过4096个
+    bitmap = 1,    // 65536位位图
+    run = 2        // 行程（起点, 长度-1）序列
+};
+
+class roaring_view;
+
+/**
+ * @brief roaring_bitmap 类，32位无符号整数的压缩集合
+ *
+ * 整数按高16位分块，每块一个容器，容器按键升序存放。稀疏块用数组，稠密块用位图，
+ * 连续区间多的块可经 run_optimize() 转为行程容器。集合运算逐块进行：
+ * 位图与位图用SSE2按128位做与/或/差并同时统计基数，数组与数组用无分支归并或
+ * sugar::set_* 的galloping，行程容器参与运算时先物化为数组或位图。运算结果按基数规范为
+ * 数组（不超过4096）或位图。
+ *
+ * 序列化格式（小端）：
+ *   [0, 4)   魔数 "SRB1"
+ *   [4, 8)   容器数 n
+ *   [8, 8 + 16n) 每个容器一个描述符：uint16 键, uint16 类型, uint32 元素数（数组为值数，
+ *                行程为行程数，位图为1024）, uint32 基数, uint32 负载偏移
+ *   之后为各容器负载，每段从8字节对齐的偏移开始：数组为uint16序列，行程为uint16对，
+ *   位图为1024个uint64
+ * 映射到内存的字节可以直接用 roaring_view 查询，无需反序列化。
+ */
+class roaring_bitmap {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint32_t;
+    using size_type = size_t;
+
+private:
+    friend class roaring_view;
+
+    static const uint32_t format_magic = 0x31425253u;    // "SRB1"
+    static const uint32_t bitmap_units = roaring_bitmap_words * 4;    // 位图负载折合的uint16_t个数
+
+    /**
+     * @brief 一个16位块的容器；data按类型解释，capacity以uint16_t计
+     */
+    struct container {
+        void* data;
+        uint32_t cardinality;
+        uint32_t size;        // 数组：值数；行程：行程数；位图：不使用
+        uint32_t capacity;
+        uint16_t key;
+        roaring_container_type type;
+    };
+
+    /**
+     * @brief 运算时把行程容器临时物化为数组或位图，离开作用域时释放
+     */
+    class plain_view {
+        container temp_;
+        const container* ref_;
+
+    public:
+        explicit plain_view(const container& c) : ref_(&c) {
+            temp_.data = nullptr;
+            if (c.type == roaring_container_type::run) {
+                temp_ = roaring_bitmap::materialize(c);
+                ref_ = &temp_;
+            }
+        }
+        ~plain_view() {
+            if (temp_.data != nullptr) {
+                roaring_bitmap::release(temp_);
+            }
+        }
+        plain_view(const plain_view&) = delete;
+        plain_view& operator=(const plain_view&) = delete;
+
+        const container& get() const noexcept { return *ref_; }
+    };
+
+    // ============================ 私有成员 ============================
+    vector<container> containers_;
+    size_type size_;
+
+    // ============================ 容器内存 ============================
+
+    static uint16_t* values(const container& c) noexcept { return static_cast<uint16_t*>(c.data); }
+    static uint64_t* words(const container& c) noexcept { return static_cast<uint64_t*>(c.data); }
+
+    /**
+     * @brief 负载占用的uint16_t个数
+     */
+    static uint32_t payload_units(const container& c) noexcept {
+        switch (c.type) {
+            case roaring_container_type::array:
+                return c.size;
+            case roaring_container_type::run:
+                return 2 * c.size;
+            default:
+                return bitmap_units;
+        }
+    }
+
+    static container make(uint16_t key, roaring_container_type type, uint32_t capacity) {
+        container c;
+        c.data = capacity > 0 ? ::operator new(capacity * sizeof(uint16_t)) : nullptr;
+        c.cardinality = 0;
+        c.size = 0;
+        c.capacity = capacity;
+        c.key = key;
+        c.type = type;
+        return c;
+    }
+
+    static container make_bitmap(uint16_t key) {
+        container c = make(key, roaring_container_type::bitmap, bitmap_units);
+        std::memset(c.data, 0, roaring_bitmap_words * sizeof(uint64_t));
+        return c;
+    }
+
+    static void release(container& c) noexcept {
+        ::operator delete(c.data);
+        c.data = nullptr;
+    }
+
+    static container clone(const container& c) {
+        const uint32_t units = payload_units(c);
+        container out = make(c.key, c.type, units);
+        std::memcpy(out.data, c.data, units * sizeof(uint16_t));
+        out.cardinality = c.cardinality;
+        out.size = c.size;
+        return out;
+    }
+
+    /**
+     * @brief 保证数组/行程容器能容纳units个uint16_t，按倍增扩容
+     */
+    static void reserve_units(container& c, uint32_t units) {
+        if (units <= c.capacity) {
+            return;
+        }
+        const uint32_t capacity = units > 2 * c.capacity ? units : 2 * c.capacity;
+        void* data = ::operator new(capacity * sizeof(uint16_t));
+        std::memcpy(data, c.data, payload_units(c) * sizeof(uint16_t));
+        ::operator delete(c.data);
+        c.data = data;
+        c.capacity = capacity;
+    }
+
+    // ============================ 容器转换 ============================
+
+    /**
+     * @brief 对容器中每个低16位值按升序调用f
+     */
+    template<typename F>
+    static void for_each_low(const container& c, F& f) {
+        switch (c.type) {
+            case roaring_container_type::array: {
+                const uint16_t* v = values(c);
+                for (uint32_t i = 0; i < c.size; ++i) {
+                    f(v[i]);
+                }
+                break;
+            }
+            case roaring_container_type::bitmap: {
+                const uint64_t* w = words(c);
+                for (uint32_t i = 0; i < roaring_bitmap_words; ++i) {
+                    uint64_t word = w[i];
+                    while (word != 0) {
+                        f(static_cast<uint16_t>(i * 64 + static_cast<uint32_t>(__builtin_ctzll(word))));
+                        word &= word - 1;
+                    }
+                }
+                break;
+            }
+            case roaring_container_type::run: {
+                const uint16_t* r = values(c);
+                for (uint32_t i = 0; i < c.size; ++i) {
+                    const uint32_t end = uint32_t(r[2 * i]) + r[2 * i + 1];
+                    for (uint32_t x = r[2 * i]; x <= end; ++x) {
+                        f(static_cast<uint16_t>(x));
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    static container to_bitmap(const container& c) {
+        if (c.type == roaring_container_type::bitmap) {
+            return clone(c);
+        }
+        container out = make_bitmap(c.key);
+        uint64_t* w = words(out);
+        const uint16_t* v = values(c);
+        if (c.type == roaring_container_type::array) {
+            for (uint32_t i = 0; i < c.size; ++i) {
+                w[v[i] >> 6] |= uint64_t(1) << (v[i] & 63);
+            }
+        } else {
+            for (uint32_t i = 0; i < c.size; ++i) {
+                sugar::roaring_set_range(w, v[2 * i], uint32_t(v[2 * i]) + v[2 * i + 1] + 1);
+            }
+        }
+        out.cardinality = c.cardinality;
+        return out;
+    }
+
+    static container to_array(const container& c) {
+        container out = make(c.key, roaring_container_type::array, c.cardinality);
+        uint16_t* v = values(out);
+        uint32_t n = 0;
+        auto put = [v, &n](uint16_t x) { v[n++] = x; };
+        for_each_low(c, put);
+        out.size = n;
+        out.cardinality = n;
+        return out;
+    }
+
+    static container to_run(const container& c, uint32_t runs) {
+        container out = make(c.key, roaring_container_type::run, 2 * runs);
+        uint16_t* r = values(out);
+        uint32_t n = 0;
+        auto put = [r, &n](uint16_t x) {
+            if (n > 0 && uint32_t(r[2 * n - 2]) + r[2 * n - 1] + 1 == x) {
+                ++r[2 * n - 1];
+            } else {
+                r[2 * n] = x;
+                r[2 * n + 1] = 0;
+                ++n;
+            }
+        };
+        for_each_low(c, put);
+        out.size = n;
+        out.cardinality = c.cardinality;
+        return out;
+    }
+
+    /**
+     * @brief 按基数转为数组或位图
+     */
+    static container materialize(const container& c) {
+        return c.cardinality > roaring_array_max ? to_bitmap(c) : to_array(c);
+    }
+
+    /**
+     * @brief 运算结果的规范化：基数不超过4096的位图转数组，超过4096的数组转位图
+     */
+    static void normalize(container& c) {
+        if ((c.type == roaring_container_type::bitmap && c.cardinality <= roaring_array_max)
+            || (c.type == roaring_container_type::array && c.cardinality > roaring_array_max)) {
+            container out = materialize(c);
+            release(c);
+            c = out;
+        }
+    }
+
+    static uint32_t count_runs(const container& c) noexcept {
+        switch (c.type) {
+            case roaring_container_type::array: {
+                const uint16_t* v = values(c);
+                uint32_t runs = c.size > 0 ? 1 : 0;
+                for (uint32_t i = 1; i < c.size; ++i) {
+                    runs += v[i] != v[i - 1] + 1;
+                }
+                return runs;
+            }
+            case roaring_container_type::bitmap: {
+                // 行程起点：本位为1且前一位为0
+                const uint64_t* w = words(c);
+                uint32_t runs = 0;
+                uint64_t carry = 0;
+                for (uint32_t i = 0; i < roaring_bitmap_words; ++i) {
+                    runs += sugar::roaring_popcount64(w[i] & ~((w[i] << 1) | carry));
+                    carry = w[i] >> 63;
+                }
+                return runs;
+            }
+            default:
+                return c.size;
+        }
+    }
+
+    /**
+     * @brief 行程容器比等价的数组/位图更大时不值得保留
+     */
+    static bool run_is_worse(uint32_t runs, uint32_t cardinality) noexcept {
+        const uint32_t plain_bytes = cardinality <= roaring_array_max ? 2 * cardinality : 8192;
+        return 4 * runs >= plain_bytes;
+    }
+
+    // ============================ 单个容器的查询 ============================
+
+    /**
+     * @brief 起点不大于low的最后一个行程，没有时返回-1
+     */
+    static int32_t find_run(const uint16_t* r, uint32_t runs, uint16_t low) noexcept {
+        int32_t lo = 0;
+        int32_t hi = static_cast<int32_t>(runs) - 1;
+        int32_t found = -1;
+        while (lo <= hi) {
+            const int32_t mid = (lo + hi) / 2;
+            if (r[2 * mid] <= low) {
+                found = mid;
+                lo = mid + 1;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        return found;
+    }
+
+    static bool contains_low(const container& c, uint16_t low) noexcept {
+        switch (c.type) {
+            case roaring_container_type::array:
+                return sugar::binary_search(values(c), values(c) + c.size, low);
+            case roaring_container_type::bitmap:
+                return (words(c)[low >> 6] >> (low & 63)) & 1;
+            default: {
+                const uint16_t* r = values(c);
+                const int32_t i = find_run(r, c.size, low);
+                return i >= 0 && uint32_t(low - r[2 * i]) <= r[2 * i + 1];
+            }
+        }
+    }
+
+    static uint32_t rank_low(const container& c, uint16_t low) noexcept {
+        switch (c.type) {
+            case roaring_container_type::array:
+                return static_cast<uint32_t>(sugar::upper_bound(values(c), values(c) + c.size, low) - values(c));
+            case roaring_container_type::bitmap: {
+                const uint64_t* w = words(c);
+                uint32_t count = 0;
+                for (uint32_t i = 0; i < (low >> 6); ++i) {
+                    count += sugar::roaring_popcount64(w[i]);
+                }
+                return count + sugar::roaring_popcount64(w[low >> 6] & (~uint64_t(0) >> (63 - (low & 63))));
+            }
+            default: {
+                const uint16_t* r = values(c);
+                uint32_t count = 0;
+                for (uint32_t i = 0; i < c.size && r[2 * i] <= low; ++i) {
+                    const uint32_t span = uint32_t(low) - r[2 * i];
+                    count += (span < r[2 * i + 1] ? span : r[2 * i + 1]) + 1;
+                }
+                return count;
+            }
+        }
+    }
+
+    static uint16_t select_low(const container& c, uint32_t i) noexcept {
+        switch (c.type) {
+            case roaring_container_type::array:
+                return values(c)[i];
+            case roaring_container_type::bitmap: {
+                const uint64_t* w = words(c);
+                for (uint32_t k = 0;; ++k) {
+                    const uint32_t bits = sugar::roaring_popcount64(w[k]);
+                    if (i < bits) {
+                        uint64_t word = w[k];
+                        for (; i > 0; --i) {
+                            word &= word - 1;
+                        }
+                        return static_cast<uint16_t>(k * 64 + static_cast<uint32_t>(__builtin_ctzll(word)));
+                    }
+                    i -= bits;
+                }
+            }
+            default: {
+                const uint16_t* r = values(c);
+                for (uint32_t k = 0;; ++k) {
+                    const uint32_t length = uint32_t(r[2 * k + 1]) + 1;
+                    if (i < length) {
+                        return static_cast<uint16_t>(r[2 * k] + i);
+                    }
+                    i -= length;
+                }
+            }
+        }
+    }
+
+    // ============================ 单个容器的修改 ============================
+
+    static bool add_low(container& c, uint16_t low) {
+        switch (c.type) {
+            case roaring_container_type::array: {
+                uint16_t* v = values(c);
+                uint16_t* pos = sugar::lower_bound(v, v + c.size, low);
+                if (pos != v + c.size && *pos == low) {
+                    return false;
+                }
+                if (c.size >= roaring_array_max) {
+                    container b = to_bitmap(c);
+                    release(c);
+                    c = b;
+                    return add_low(c, low);
+                }
+                const uint32_t at = static_cast<uint32_t>(pos - v);
+                reserve_units(c, c.size + 1);
+                v = values(c);
+                std::memmove(v + at + 1, v + at, (c.size - at) * sizeof(uint16_t));
+                v[at] = low;
+                ++c.size;
+                ++c.cardinality;
+                return true;
+            }
+            case roaring_container_type::bitmap: {
+                uint64_t& word = words(c)[low >> 6];
+                const uint64_t mask = uint64_t(1) << (low & 63);
+                if (word & mask) {
+                    return false;
+                }
+                word |= mask;
+                ++c.cardinality;
+                return true;
+            }
+            default:
+                return add_run(c, low);
+        }
+    }
+
+    static bool add_run(container& c, uint16_t low) {
+        uint16_t* r = values(c);
+        const int32_t n = static_cast<int32_t>(c.size);
+        const int32_t i = find_run(r, c.size, low);
+        if (i >= 0 && uint32_t(low - r[2 * i]) <= r[2 * i + 1]) {
+            return false;
+        }
+        const bool join_left = i >= 0 && uint32_t(r[2 * i]) + r[2 * i + 1] + 1 == low;
+        const bool join_right = i + 1 < n && uint32_t(low) + 1 == r[2 * i + 2];
+        ++c.cardinality;
+        if (join_left && join_right) {
+            r[2 * i + 1] = static_cast<uint16_t>(r[2 * i + 2] + r[2 * i + 3] - r[2 * i]);
+            std::memmove(r + 2 * i + 2, r + 2 * i + 4, static_cast<size_t>(n - i - 2) * 2 * sizeof(uint16_t));
+            --c.size;
+        } else if (join_left) {
+            ++r[2 * i + 1];
+        } else if (join_right) {
+            --r[2 * i + 2];
+            ++r[2 * i + 3];
+        } else {
+            reserve_units(c, 2 * (c.size + 1));
+            r = values(c);
+            std::memmove(r + 2 * i + 4, r + 2 * i + 2, static_cast<size_t>(n - i - 1) * 2 * sizeof(uint16_t));
+            r[2 * i + 2] = low;
+            r[2 * i + 3] = 0;
+            ++c.size;
+            if (run_is_worse(c.size, c.cardinality)) {
+                container out = materialize(c);
+                release(c);
+                c = out;
+            }
+        }
+        return true;
+    }
+
+    static bool remove_low(container& c, uint16_t low) {
+        switch (c.type) {
+            case roaring_container_type::array: {
+                uint16_t* v = values(c);
+                uint16_t* pos = sugar::lower_bound(v, v + c.size, low);
+                if (pos == v + c.size || *pos != low) {
+                    return false;
+                }
+                std::memmove(pos, pos + 1, static_cast<size_t>(v + c.size - pos - 1) * sizeof(uint16_t));
+                --c.size;
+                --c.cardinality;
+                return true;
+            }
+            case roaring_container_type::bitmap: {
+                uint64_t& word = words(c)[low >> 6];
+                const uint64_t mask = uint64_t(1) << (low & 63);
+                if (!(word & mask)) {
+                    return false;
+                }
+                word &= ~mask;
+                --c.cardinality;
+                normalize(c);
+                return true;
+            }
+            default:
+                return remove_run(c, low);
+        }
+    }
+
+    static bool remove_run(container& c, uint16_t low) {
+        uint16_t* r = values(c);
+        const int32_t n = static_cast<int32_t>(c.size);
+        const int32_t i = find_run(r, c.size, low);
+        if (i < 0 || uint32_t(low - r[2 * i]) > r[2 * i + 1]) {
+            return false;
+        }
+        const uint32_t start = r[2 * i];
+        const uint32_t end = start + r[2 * i + 1];
+        --c.cardinality;
+        if (start == end) {
+            std::memmove(r + 2 * i, r + 2 * i + 2, static_cast<size_t>(n - i - 1) * 2 * sizeof(uint16_t));
+            --c.size;
+        } else if (low == start) {
+            ++r[2 * i];
+            --r[2 * i + 1];
+        } else if (low == end) {
+            --r[2 * i + 1];
+        } else {
+            reserve_units(c, 2 * (c.size + 1));
+            r = values(c);
+            std::memmove(r + 2 * i + 4, r + 2 * i + 2, static_cast<size_t>(n - i - 1) * 2 * sizeof(uint16_t));
+            r[2 * i + 1] = static_cast<uint16_t>(low - 1 - start);
+            r[2 * i + 2] = static_cast<uint16_t>(low + 1);
+            r[2 * i + 3] = static_cast<uint16_t>(end - low - 1);
+            ++c.size;
+            if (c.cardinality > 0 && run_is_worse(c.size, c.cardinality)) {
+                container out = materialize(c);
+                release(c);
+                c = out;
+            }
+        }
+        return true;
+    }
+
+    // ============================ 容器间运算 ============================
+
+    static bool is_full(const container& c) noexcept { return c.cardinality == 65536; }
+
+    static container container_and(const container& x, const container& y) {
+        if (is_full(x) || is_full(y)) {
+            return clone(is_full(x) ? y : x);
+        }
+        plain_view vx(x);
+        plain_view vy(y);
+        const container& a = vx.get();
+        const container& b = vy.get();
+        if (a.type == roaring_container_type::bitmap && b.type == roaring_container_type::bitmap) {
+            container out = make(a.key, roaring_container_type::bitmap, bitmap_units);
+            out.cardinality = sugar::roaring_words_op<roaring_and_op>(words(a), words(b), words(out));
+            normalize(out);
+            return out;
+        }
+        // 结果不超过4096个，先写入栈上缓冲区，再按实际大小分配；空结果不分配
+        uint16_t scratch[roaring_array_max];
+        uint32_t n = 0;
+        if (a.type == roaring_container_type::bitmap || b.type == roaring_container_type::bitmap) {
+            const container& bits = a.type == roaring_container_type::bitmap ? a : b;
+            const container& list = a.type == roaring_container_type::bitmap ? b : a;
+            const uint16_t* v = values(list);
+            for (uint32_t i = 0; i < list.size; ++i) {
+                scratch[n] = v[i];
+                n += static_cast<uint32_t>((words(bits)[v[i] >> 6] >> (v[i] & 63)) & 1);
+            }
+        } else {
+            n = sugar::roaring_intersect_arrays(values(a), a.size, values(b), b.size, scratch);
+        }
+        container out = make(a.key, roaring_container_type::array, n);
+        if (n > 0) {
+            std::memcpy(out.data, scratch, n * sizeof(uint16_t));
+        }
+        out.size = out.cardinality = n;
+        return out;
+    }
+
+    static container container_or(const container& x, const container& y) {
+        if (is_full(x) || is_full(y)) {
+            return clone(is_full(x) ? x : y);
+        }
+        plain_view vx(x);
+        plain_view vy(y);
+        const container& a = vx.get();
+        const container& b = vy.get();
+        if (a.type == roaring_container_type::bitmap && b.type == roaring_container_type::bitmap) {
+            container out = make(a.key, roaring_container_type::bitmap, bitmap_units);
+            out.cardinality = sugar::roaring_words_op<roaring_or_op>(words(a), words(b), words(out));
+            return out;
+        }
+        if (a.type == roaring_container_type::array && b.type == roaring_container_type::array
+            && a.size + b.size <= roaring_array_max) {
+            container out = make(a.key, roaring_container_type::array, a.size + b.size);
+            uint16_t* end = sugar::set_union(values(a), values(a) + a.size, values(b), values(b) + b.size,
+                                             values(out));
+            out.size = out.cardinality = static_cast<uint32_t>(end - values(out));
+            return out;
+        }
+        // 至少一侧为位图，或两个数组合并后可能超过4096：在位图上逐个置位
+        const bool a_bits = a.type == roaring_container_type::bitmap;
+        container out = to_bitmap(a_bits ? a : b);
+        const container& list = a_bits ? b : a;
+        uint64_t* w = words(out);
+        const uint16_t* v = values(list);
+        for (uint32_t i = 0; i < list.size; ++i) {
+            uint64_t& word = w[v[i] >> 6];
+            const uint64_t mask = uint64_t(1) << (v[i] & 63);
+            out.cardinality += (word & mask) == 0;
+            word |= mask;
+        }
+        normalize(out);
+        return out;
+    }
+
+    static container container_andnot(const container& x, const container& y) {
+        plain_view vx(x);
+        plain_view vy(y);
+        const container& a = vx.get();
+        const container& b = vy.get();
+        if (a.type == roaring_container_type::bitmap) {
+            container out = make(a.key, roaring_container_type::bitmap, bitmap_units);
+            if (b.type == roaring_container_type::bitmap) {
+                out.cardinality = sugar::roaring_words_op<roaring_andnot_op>(words(a), words(b), words(out));
+            } else {
+                std::memcpy(out.data, a.data, roaring_bitmap_words * sizeof(uint64_t));
+                out.cardinality = a.cardinality;
+                uint64_t* w = words(out);
+                const uint16_t* v = values(b);
+                for (uint32_t i = 0; i < b.size; ++i) {
+                    uint64_t& word = w[v[i] >> 6];
+                    const uint64_t mask = uint64_t(1) << (v[i] & 63);
+                    out.cardinality -= (word & mask) != 0;
+                    word &= ~mask;
+                }
+            }
+            normalize(out);
+            return out;
+        }
+        container out = make(a.key, roaring_container_type::array, a.size);
+        const uint16_t* v = values(a);
+        uint16_t* o = values(out);
+        if (b.type == roaring_container_type::bitmap) {
+            uint32_t n = 0;
+            for (uint32_t i = 0; i < a.size; ++i) {
+                o[n] = v[i];
+                n += static_cast<uint32_t>(((words(b)[v[i] >> 6] >> (v[i] & 63)) & 1) ^ 1);
+            }
+            out.size = out.cardinality = n;
+        } else {
+            uint16_t* end = sugar::set_difference(v, v + a.size, values(b), values(b) + b.size, o);
+            out.size = out.cardinality = static_cast<uint32_t>(end - o);
+        }
+        return out;
+    }
+
+    static bool container_equal(const container& a, const container& b) {
+        if (a.cardinality != b.cardinality) {
+            return false;
+        }
+        // 同类型容器的表示是唯一的（行程总是极大的），可直接比较负载
+        if (a.type == b.type) {
+            return a.size == b.size && std::memcmp(a.data, b.data, payload_units(a) * sizeof(uint16_t)) == 0;
+        }
+        container bits_a = to_bitmap(a);
+        container bits_b;
+        try {
+            bits_b = to_bitmap(b);
+        } catch (...) {
+            release(bits_a);
+            throw;
+        }
+        const bool same = std::memcmp(bits_a.data, bits_b.data, roaring_bitmap_words * sizeof(uint64_t)) == 0;
+        release(bits_a);
+        release(bits_b);
+        return same;
+    }
+
+    // ============================ 私有辅助函数 ============================
+
+    /**
+     * @brief 查找键为key的容器；不存在时返回插入位置并置found为false
+     */
+    size_type locate(uint16_t key, bool& found) const noexcept {
+        const size_type n = containers_.size();
+        // 顺序构建时绝大多数访问落在最后一个容器
+        if (n == 0 || containers_[n - 1].key <= key) {
+            found = n > 0 && containers_[n - 1].key == key;
+            return found ? n - 1 : n;
+        }
+        size_type lo = 0;
+        size_type hi = n;
+        while (lo < hi) {
+            const size_type mid = (lo + hi) / 2;
+            if (containers_[mid].key < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        found = containers_[lo].key == key;
+        return lo;
+    }
+
+    void insert_container(size_type pos, container& c) {
+        try {
+            containers_.insert(containers_.begin() + pos, c);
+        } catch (...) {
+            release(c);
+            throw;
+        }
+        size_ += c.cardinality;
+    }
+
+    /**
+     * @brief 收下运算结果；调用方已预留容量，空结果直接释放
+     */
+    void push_result(container& c) noexcept {
+        if (c.cardinality == 0) {
+            release(c);
+            return;
+        }
+        size_ += c.cardinality;
+        containers_.push_back(c);
+    }
+
+    void release_all() noexcept {
+        for (size_type i = 0; i < containers_.size(); ++i) {
+            release(containers_[i]);
+        }
+        containers_.clear();
+        size_ = 0;
+    }
+
+    /**
+     * @brief 检查序列化数据的头部与描述符，返回容器数；负载内容由调用方按需检查
+     */
+    static uint32_t check_format(const unsigned char* data, size_type bytes) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(data == nullptr || bytes < 8 || sugar::roaring_load32(data) != format_magic,
+                                        "roaring_bitmap - bad serialized header");
+        const uint32_t n = sugar::roaring_load32(data + 4);
+        SUGAR_THROW_INVALID_ARGUMENT_IF(n > 65536 || 8 + uint64_t(16) * n > bytes,
+                                        "roaring_bitmap - truncated container directory");
+        const uint64_t directory_end = 8 + uint64_t(16) * n;
+        for (uint32_t i = 0; i < n; ++i) {
+            const unsigned char* d = data + 8 + 16 * size_type(i);
+            const uint16_t key = sugar::roaring_load16(d);
+            const uint16_t type = sugar::roaring_load16(d + 2);
+            const uint32_t size = sugar::roaring_load32(d + 4);
+            const uint32_t cardinality = sugar::roaring_load32(d + 8);
+            const uint32_t offset = sugar::roaring_load32(d + 12);
+            SUGAR_THROW_INVALID_ARGUMENT_IF(i > 0 && key <= sugar::roaring_load16(d - 16),
+                                            "roaring_bitmap - container keys not increasing");
+            SUGAR_THROW_INVALID_ARGUMENT_IF(cardinality == 0 || cardinality > 65536,
+                                            "roaring_bitmap - bad container cardinality");
+            uint64_t units = 0;
+            if (type == static_cast<uint16_t>(roaring_container_type::array)) {
+                SUGAR_THROW_INVALID_ARGUMENT_IF(size != cardinality || size > roaring_array_max,
+                                                "roaring_bitmap - bad array container");
+                units = size;
+            } else if (type == static_cast<uint16_t>(roaring_container_type::bitmap)) {
+                SUGAR_THROW_INVALID_ARGUMENT_IF(size != roaring_bitmap_words, "roaring_bitmap - bad bitmap container");
+                units = bitmap_units;
+            } else {
+                SUGAR_THROW_INVALID_ARGUMENT_IF(type != static_cast<uint16_t>(roaring_container_type::run)
+                                                    || size == 0 || size > 32768,
+                                                "roaring_bitmap - bad run container");
+                units = 2 * uint64_t(size);
+            }
+            SUGAR_THROW_INVALID_ARGUMENT_IF(offset % 8 != 0 || offset < directory_end
+                                                || offset + units * sizeof(uint16_t) > bytes,
+                                            "roaring_bitmap - container payload out of bounds");
+        }
+        return n;
+    }
+
+    static size_type align8(size_type n) noexcept { return (n + 7) & ~size_type(7); }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 默认构造函数，空集合
+     */
+    roaring_bitmap() : size_(0) {}
+
+    /**
+     * @brief 拷贝构造函数
+     */
+    roaring_bitmap(const roaring_bitmap& other) : size_(0) {
+        containers_.reserve(other.containers_.size());
+        try {
+            for (size_type i = 0; i < other.containers_.size(); ++i) {
+                container c = clone(other.containers_[i]);
+                push_result(c);
+            }
+        } catch (...) {
+            release_all();
+            throw;
+        }
+    }
+
+    /**
+     * @brief 移动构造函数
+     */
+    roaring_bitmap(roaring_bitmap&& other) noexcept : size_(other.size_) {
+        containers_.swap(other.containers_);
+        other.size_ = 0;
+    }
+
+    /**
+     * @brief 析构函数
+     */
+    ~roaring_bitmap() {
+        release_all();
+    }
+
+    roaring_bitmap& operator=(const roaring_bitmap& other) {
+        if (this != &other) {
+            roaring_bitmap copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    roaring_bitmap& operator=(roaring_bitmap&& other) noexcept {
+        if (this != &other) {
+            release_all();
+            containers_.swap(other.containers_);
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    void swap(roaring_bitmap& other) noexcept {
+        containers_.swap(other.containers_);
+        sugar::swap(size_, other.size_);
+    }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief 基数（成员个数）
+     */
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief 非空的16位块个数
+     */
+    size_type container_count() const noexcept { return containers_.size(); }
+
+    /**
+     * @brief 占用的堆内存字节数（容器目录与各容器负载）
+     */
+    size_type memory_bytes() const noexcept {
+        size_type bytes = containers_.capacity() * sizeof(container);
+        for (size_type i = 0; i < containers_.size(); ++i) {
+            bytes += containers_[i].capacity * sizeof(uint16_t);
+        }
+        return bytes;
+    }
+
+    // ============================ 查找 ============================
+
+    bool contains(uint32_t x) const noexcept {
+        bool found;
+        const size_type i = locate(static_cast<uint16_t>(x >> 16), found);
+        return found && contains_low(containers_[i], static_cast<uint16_t>(x));
+    }
+
+    /**
+     * @brief 不大于x的成员个数；逐个累加x之前各容器的基数
+     */
+    size_type rank(uint32_t x) const noexcept {
+        const uint16_t key = static_cast<uint16_t>(x >> 16);
+        size_type count = 0;
+        for (size_type i = 0; i < containers_.size() && containers_[i].key <= key; ++i) {
+            count += containers_[i].key < key ? containers_[i].cardinality
+                                              : rank_low(containers_[i], static_cast<uint16_t>(x));
+        }
+        return count;
+    }
+
+    /**
+     * @brief 第i小（从0起）的成员
+     */
+    uint32_t select(size_type i) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= size_, "roaring_bitmap::select - index out of range");
+        for (size_type k = 0;; ++k) {
+            const container& c = containers_[k];
+            if (i < c.cardinality) {
+                return (uint32_t(c.key) << 16) | select_low(c, static_cast<uint32_t>(i));
+            }
+            i -= c.cardinality;
+        }
+    }
+
+    /**
+     * @brief 按升序对每个成员调用f(x)
+     */
+    template<typename F>
+    void for_each(F f) const {
+        for (size_type i = 0; i < containers_.size(); ++i) {
+            const uint32_t high = uint32_t(containers_[i].key) << 16;
+            auto visit = [&f, high](uint16_t low) { f(high | low); };
+            for_each_low(containers_[i], visit);
+        }
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 插入x
+     * @return 是否新插入
+     */
+    bool add(uint32_t x) {
+        const uint16_t key = static_cast<uint16_t>(x >> 16);
+        bool found;
+        const size_type i = locate(key, found);
+        if (!found) {
+            container c = make(key, roaring_container_type::array, 4);
+            values(c)[0] = static_cast<uint16_t>(x);
+            c.size = c.cardinality = 1;
+            insert_container(i, c);
+            return true;
+        }
+        if (!add_low(containers_[i], static_cast<uint16_t>(x))) {
+            return false;
+        }
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief 插入区间[lo, hi)；整块覆盖的块直接成为单个行程
+     */
+    void add_range(uint64_t lo, uint64_t hi) {
+        SUGAR_THROW_OUT_OF_RANGE_IF(hi > (uint64_t(1) << 32), "roaring_bitmap::add_range - range out of bounds");
+        while (lo < hi) {
+            const uint16_t key = static_cast<uint16_t>(lo >> 16);
+            const uint64_t chunk_end = (uint64_t(key) + 1) << 16;
+            const uint32_t low_lo = static_cast<uint32_t>(lo & 0xffff);
+            const uint32_t low_hi = static_cast<uint32_t>((hi < chunk_end ? hi : chunk_end) - (uint64_t(key) << 16));
+            bool found;
+            const size_type i = locate(key, found);
+            if (!found || (low_lo == 0 && low_hi == 65536)) {
+                container r = make(key, roaring_container_type::run, 2);
+                values(r)[0] = static_cast<uint16_t>(low_lo);
+                values(r)[1] = static_cast<uint16_t>(low_hi - low_lo - 1);
+                r.size = 1;
+                r.cardinality = low_hi - low_lo;
+                if (found) {
+                    size_ = size_ - containers_[i].cardinality + r.cardinality;
+                    release(containers_[i]);
+                    containers_[i] = r;
+                } else {
+                    insert_container(i, r);
+                }
+            } else {
+                container& c = containers_[i];
+                if (c.type != roaring_container_type::bitmap) {
+                    container b = to_bitmap(c);
+                    release(c);
+                    c = b;
+                }
+                size_ -= c.cardinality;
+                sugar::roaring_set_range(words(c), low_lo, low_hi);
+                c.cardinality = sugar::roaring_words_count(words(c));
+                size_ += c.cardinality;
+                normalize(c);
+            }
+            lo = (hi < chunk_end ? hi : chunk_end);
+        }
+    }
+
+    /**
+     * @brief 删除x
+     * @return 是否删除了成员
+     */
+    bool remove(uint32_t x) {
+        bool found;
+        const size_type i = locate(static_cast<uint16_t>(x >> 16), found);
+        if (!found || !remove_low(containers_[i], static_cast<uint16_t>(x))) {
+            return false;
+        }
+        --size_;
+        if (containers_[i].cardinality == 0) {
+            release(containers_[i]);
+            containers_.erase(containers_.begin() + i);
+        }
+        return true;
+    }
+
+    void clear() noexcept {
+        release_all();
+    }
+
+    /**
+     * @brief 把行程更省内存的容器转为行程容器，反之转回数组或位图
+     * @return 是否有容器改变了类型
+     */
+    bool run_optimize() {
+        bool changed = false;
+        for (size_type i = 0; i < containers_.size(); ++i) {
+            container& c = containers_[i];
+            const uint32_t runs = count_runs(c);
+            const bool worse = run_is_worse(runs, c.cardinality);
+            if (c.type != roaring_container_type::run && !worse) {
+                container r = to_run(c, runs);
+                release(c);
+                c = r;
+                changed = true;
+            } else if (c.type == roaring_container_type::run && worse) {
+                container m = materialize(c);
+                release(c);
+                c = m;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * @brief 释放数组与行程容器多余的容量
+     */
+    void shrink_to_fit() {
+        for (size_type i = 0; i < containers_.size(); ++i) {
+            container& c = containers_[i];
+            const uint32_t units = payload_units(c);
+            if (c.capacity > units) {
+                container exact = clone(c);
+                release(c);
+                c = exact;
+            }
+        }
+        containers_.shrink_to_fit();
+    }
+
+    // ============================ 集合运算 ============================
+
+    friend roaring_bitmap operator&(const roaring_bitmap& a, const roaring_bitmap& b);
+    friend roaring_bitmap operator|(const roaring_bitmap& a, const roaring_bitmap& b);
+    friend roaring_bitmap operator-(const roaring_bitmap& a, const roaring_bitmap& b);
+    friend bool operator==(const roaring_bitmap& a, const roaring_bitmap& b);
+
+    roaring_bitmap& operator&=(const roaring_bitmap& other) { return *this = *this & other; }
+    roaring_bitmap& operator|=(const roaring_bitmap& other) { return *this = *this | other; }
+    roaring_bitmap& operator-=(const roaring_bitmap& other) { return *this = *this - other; }
+
+    // ============================ 序列化 ============================
+
+    /**
+     * @brief 序列化后的字节数
+     */
+    size_type serialized_size() const noexcept {
+        size_type bytes = align8(8 + 16 * containers_.size());
+        for (size_type i = 0; i < containers_.size(); ++i) {
+            bytes += align8(payload_units(containers_[i]) * sizeof(uint16_t));
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief 写入serialized_size()个字节，填充字节置0
+     */
+    void serialize(unsigned char* out) const noexcept {
+        const size_type n = containers_.size();
+        sugar::roaring_store32(out, format_magic);
+        sugar::roaring_store32(out + 4, static_cast<uint32_t>(n));
+        size_type offset = align8(8 + 16 * n);
+        std::memset(out + 8 + 16 * n, 0, offset - (8 + 16 * n));
+        for (size_type i = 0; i < n; ++i) {
+            const container& c = containers_[i];
+            unsigned char* d = out + 8 + 16 * i;
+            const uint32_t units = payload_units(c);
+            sugar::roaring_store16(d, c.key);
+            sugar::roaring_store16(d + 2, static_cast<uint16_t>(c.type));
+            sugar::roaring_store32(d + 4, c.type == roaring_container_type::bitmap ? roaring_bitmap_words : c.size);
+            sugar::roaring_store32(d + 8, c.cardinality);
+            sugar::roaring_store32(d + 12, static_cast<uint32_t>(offset));
+            unsigned char* p = out + offset;
+            if (c.type == roaring_container_type::bitmap) {
+                for (uint32_t k = 0; k < roaring_bitmap_words; ++k) {
+                    sugar::roaring_store64(p + 8 * k, words(c)[k]);
+                }
+            } else {
+                for (uint32_t k = 0; k < units; ++k) {
+                    sugar::roaring_store16(p + 2 * k, values(c)[k]);
+                }
+            }
+            const size_type end = offset + units * sizeof(uint16_t);
+            offset = align8(end);
+            std::memset(out + end, 0, offset - end);
+        }
+    }
+
+    /**
+     * @brief 从序列化数据构造，检查全部结构与内容，格式错误时抛出 invalid_argument
+     */
+    static roaring_bitmap deserialize(const unsigned char* data, size_type bytes) {
+        const uint32_t n = check_format(data, bytes);
+        roaring_bitmap out;
+        out.containers_.reserve(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            const unsigned char* d = data + 8 + 16 * size_type(i);
+            const roaring_container_type type = static_cast<roaring_container_type>(sugar::roaring_load16(d + 2));
+            const uint32_t size = sugar::roaring_load32(d + 4);
+            const uint32_t cardinality = sugar::roaring_load32(d + 8);
+            const unsigned char* p = data + sugar::roaring_load32(d + 12);
+            container c = make(sugar::roaring_load16(d), type,
+                               type == roaring_container_type::bitmap ? bitmap_units
+                                   : type == roaring_container_type::run ? 2 * size : size);
+            c.size = type == roaring_container_type::bitmap ? 0 : size;
+            c.cardinality = cardinality;
+            uint64_t counted = 0;
+            bool ordered = true;
+            if (type == roaring_container_type::bitmap) {
+                for (uint32_t k = 0; k < roaring_bitmap_words; ++k) {
+                    words(c)[k] = sugar::roaring_load64(p + 8 * k);
+                }
+                counted = sugar::roaring_words_count(words(c));
+            } else if (type == roaring_container_type::array) {
+                for (uint32_t k = 0; k < size; ++k) {
+                    values(c)[k] = sugar::roaring_load16(p + 2 * k);
+                    ordered = ordered && (k == 0 || values(c)[k - 1] < values(c)[k]);
+                }
+                counted = size;
+            } else {
+                // 行程必须升序、互不相邻（保持极大）且不越过65535
+                uint16_t* r = values(c);
+                for (uint32_t k = 0; k < size; ++k) {
+                    r[2 * k] = sugar::roaring_load16(p + 4 * k);
+                    r[2 * k + 1] = sugar::roaring_load16(p + 4 * k + 2);
+                    ordered = ordered && uint32_t(r[2 * k]) + r[2 * k + 1] <= 0xffff
+                              && (k == 0 || uint32_t(r[2 * k - 2]) + r[2 * k - 1] + 1 < r[2 * k]);
+                    counted += uint32_t(r[2 * k + 1]) + 1;
+                }
+            }
+            const bool corrupt = !ordered || counted != cardinality;
+            if (corrupt) {
+                release(c);
+            }
+            SUGAR_THROW_INVALID_ARGUMENT_IF(corrupt, "roaring_bitmap::deserialize - corrupt container payload");
+            out.push_result(c);
+        }
+        return out;
+    }
+};
+
+// ============================ 非成员函数 ============================
+
+/**
+ * @brief 交集
+ */
+inline roaring_bitmap operator&(const roaring_bitmap& a, const roaring_bitmap& b) {
+    roaring_bitmap out;
+    const size_t na = a.containers_.size();
+    const size_t nb = b.containers_.size();
+    out.containers_.reserve(na < nb ? na : nb);
+    size_t i = 0;
+    size_t j = 0;
+    while (i < na && j < nb) {
+        const uint16_t ka = a.containers_[i].key;
+        const uint16_t kb = b.containers_[j].key;
+        if (ka < kb) {
+            ++i;
+        } else if (kb < ka) {
+            ++j;
+        } else {
+            roaring_bitmap::container c = roaring_bitmap::container_and(a.containers_[i++], b.containers_[j++]);
+            out.push_result(c);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief 并集
+ */
+inline roaring_bitmap operator|(const roaring_bitmap& a, const roaring_bitmap& b) {
+    roaring_bitmap out;
+    const size_t na = a.containers_.size();
+    const size_t nb = b.containers_.size();
+    out.containers_.reserve(na + nb);
+    size_t i = 0;
+    size_t j = 0;
+    while (i < na || j < nb) {
+        roaring_bitmap::container c;
+        if (j == nb || (i < na && a.containers_[i].key < b.containers_[j].key)) {
+            c = roaring_bitmap::clone(a.containers_[i++]);
+        } else if (i == na || b.containers_[j].key < a.containers_[i].key) {
+            c = roaring_bitmap::clone(b.containers_[j++]);
+        } else {
+            c = roaring_bitmap::container_or(a.containers_[i++], b.containers_[j++]);
+        }
+        out.push_result(c);
+    }
+    return out;
+}
+
+/**
+ * @brief 差集（andnot）：属于a而不属于b
+ */
+inline roaring_bitmap operator-(const roaring_bitmap& a, const roaring_bitmap& b) {
+    roaring_bitmap out;
+    const size_t na = a.containers_.size();
+    const size_t nb = b.containers_.size();
+    out.containers_.reserve(na);
+    size_t j = 0;
+    for (size_t i = 0; i < na; ++i) {
+        const uint16_t key = a.containers_[i].key;
+        while (j < nb && b.containers_[j].key < key) {
+            ++j;
+        }
+        roaring_bitmap::container c = j < nb && b.containers_[j].key == key
+            ? roaring_bitmap::container_andnot(a.containers_[i], b.containers_[j])
+            : roaring_bitmap::clone(a.containers_[i]);
+        out.push_result(c);
+    }
+    return out;
+}
+
+inline bool operator==(const roaring_bitmap& a, const roaring_bitmap& b) {
+    if (a.size_ != b.size_ || a.containers_.size() != b.containers_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.containers_.size(); ++i) {
+        if (a.containers_[i].key != b.containers_[i].key
+            || !roaring_bitmap::container_equal(a.containers_[i], b.containers_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool operator!=(const roaring_bitmap& a, const roaring_bitmap& b) {
+    return !(a == b);
+}
+
+inline void swap(roaring_bitmap& a, roaring_bitmap& b) noexcept {
+    a.swap(b);
+}
+
+// ============================ roaring_view 类 ============================
+
+/**
+ * @brief roaring_view 类，直接在序列化字节（如mmap映射的文件）上查询，不复制数据
+ *
+ * 构造时只检查头部与容器目录（O(容器数)），保证所有访问都不越界；
+ * 负载内容不做检查，来源不可信时应改用 roaring_bitmap::deserialize。
+ * 视图不拥有数据，数据须在视图使用期间保持有效。
+ */
+class roaring_view {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint32_t;
+    using size_type = size_t;
+
+private:
+    // ============================ 私有成员 ============================
+    const unsigned char* data_;
+    size_type bytes_;
+    uint32_t count_;
+    size_type size_;
+
+    const unsigned char* descriptor(uint32_t i) const noexcept { return data_ + 8 + 16 * size_type(i); }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param data 序列化数据
+     * @param bytes 数据字节数
+     */
+    roaring_view(const void* data, size_type bytes)
+        : data_(static_cast<const unsigned char*>(data)), bytes_(bytes),
+          count_(roaring_bitmap::check_format(data_, bytes)), size_(0) {
+        for (uint32_t i = 0; i < count_; ++i) {
+            size_ += sugar::roaring_load32(descriptor(i) + 8);
+        }
+    }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type container_count() const noexcept { return count_; }
+
+    // ============================ 查找 ============================
+
+    bool contains(uint32_t x) const noexcept {
+        const uint16_t key = static_cast<uint16_t>(x >> 16);
+        const uint16_t low = static_cast<uint16_t>(x);
+        uint32_t lo = 0;
+        uint32_t hi = count_;
+        while (lo < hi) {
+            const uint32_t mid = (lo + hi) / 2;
+            if (sugar::roaring_load16(descriptor(mid)) < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == count_ || sugar::roaring_load16(descriptor(lo)) != key) {
+            return false;
+        }
+        const unsigned char* d = descriptor(lo);
+        const uint16_t type = sugar::roaring_load16(d + 2);
+        const uint32_t size = sugar::roaring_load32(d + 4);
+        const unsigned char* p = data_ + sugar::roaring_load32(d + 12);
+        if (type == static_cast<uint16_t>(roaring_container_type::bitmap)) {
+            return (sugar::roaring_load64(p + 8 * (low >> 6)) >> (low & 63)) & 1;
+        }
+        // 数组按值、行程按起点二分
+        const size_type stride = type == static_cast<uint16_t>(roaring_container_type::array) ? 2 : 4;
+        uint32_t first = 0;
+        uint32_t count = size;
+        while (count > 0) {
+            const uint32_t half = count / 2;
+            if (sugar::roaring_load16(p + stride * (first + half)) <= low) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        if (first == 0) {
+            return false;
+        }
+        const unsigned char* hit = p + stride * (first - 1);
+        const uint16_t start = sugar::roaring_load16(hit);
+        return stride == 2 ? start == low : uint32_t(low - start) <= sugar::roaring_load16(hit + 2);
+    }
+
+    /**
+     * @brief 按升序对每个成员调用f(x)
+     */
+    template<typename F>
+    void for_each(F f) const {
+        for (uint32_t i = 0; i < count_; ++i) {
+            const unsigned char* d = descriptor(i);
+            const uint32_t high = uint32_t(sugar::roaring_load16(d)) << 16;
+            const uint16_t type = sugar::roaring_load16(d + 2);
+            const uint32_t size = sugar::roaring_load32(d + 4);
+            const unsigned char* p = data_ + sugar::roaring_load32(d + 12);
+            if (type == static_cast<uint16_t>(roaring_container_type::array)) {
+                for (uint32_t k = 0; k < size; ++k) {
+                    f(high | sugar::roaring_load16(p + 2 * k));
+                }
+            } else if (type == static_cast<uint16_t>(roaring_container_type::bitmap)) {
+                for (uint32_t k = 0; k < roaring_bitmap_words; ++k) {
+                    uint64_t word = sugar::roaring_load64(p + 8 * k);
+                    while (word != 0) {
+                        f(high | (k * 64 + static_cast<uint32_t>(__builtin_ctzll(word))));
+                        word &= word - 1;
+                    }
+                }
+            } else {
+                for (uint32_t k = 0; k < size; ++k) {
+                    const uint32_t start = sugar::roaring_load16(p + 4 * k);
+                    const uint32_t end = start + sugar::roaring_load16(p + 4 * k + 2);
+                    for (uint32_t x = start; x <= end && x <= 0xffff; ++x) {
+                        f(high | x);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 复制为可修改的 roaring_bitmap（完整检查内容）
+     */
+    roaring_bitmap to_bitmap() const {
+        return roaring_bitmap::deserialize(data_, bytes_);
+    }
+};
+
+} // namespace sugar
+
+#endif // ROARING_H_
@@ -0,0 +1,461 @@
+/*
+ * @file sharded_counter.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 按线程分片的统计：每线程独占缓存行的存储 per_thread、分片计数器 sharded_counter、
+ *        对数-线性分桶的分片直方图 sharded_histogram；写入只碰本线程的缓存行，读取时按需汇总
+ */
+
+#ifndef SHARDED_COUNTER_H_
+#define SHARDED_COUNTER_H_
+
+#include "exceptdef.h"
+#include "mutex.h"
+#include "vector.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace sugar {
+
+// ============================ 线程编号 ============================
+
+/**
+ * @brief thread_index_registry 类，为线程分配从0开始的紧凑编号
+ *
+ * 线程首次使用时领取当前最小的空闲编号，退出时归还，编号因此始终不超过同时存活的线程数，
+ * 可直接用作分片下标。领取和归还只在线程创建、退出时各发生一次，用互斥锁保护即可。
+ */
+class thread_index_registry {
+private:
+    std::mutex lock_;
+    vector<uint32_t> free_;  // 已归还的编号
+    uint32_t next_;          // 从未分配过的最小编号
+
+    thread_index_registry() : next_(0) {}
+
+public:
+    static thread_index_registry& instance() {
+        static thread_index_registry registry;
+        return registry;
+    }
+
+    uint32_t acquire() {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (free_.empty()) {
+            return next_++;
+        }
+        size_t best = 0;
+        for (size_t i = 1; i < free_.size(); ++i) {
+            if (free_[i] < free_[best]) {
+                best = i;
+            }
+        }
+        const uint32_t index = free_[best];
+        free_[best] = free_.back();
+        free_.pop_back();
+        return index;
+    }
+
+    void release(uint32_t index) {
+        std::lock_guard<std::mutex> guard(lock_);
+        free_.push_back(index);
+    }
+};
+
+/**
+ * @brief 当前线程的紧凑编号，线程退出后由之后创建的线程复用
+ */
+inline uint32_t this_thread_index() {
+    struct holder {
+        uint32_t index;
+        holder() : index(thread_index_registry::instance().acquire()) {}
+        ~holder() { thread_index_registry::instance().release(index); }
+    };
+    static thread_local holder h;
+    return h.index;
+}
+
+// ============================ per_thread 类模板 ============================
+
+/**
+ * @brief per_thread 类模板，每个线程一份、各自独占缓存行的T
+ *
+ * 槽位按线程编号下标，每16个为一组在首次使用时分配，组指针用CAS发布，查找无锁。
+ * local() 只由本线程访问，可以不加同步地读写；for_each / combine 遍历所有已分配的槽位，
+ * 与写入并发时T本身需要是原子的（如计数器），否则应在各线程静止时调用。
+ * 线程退出后槽位连同其中的值保留，由之后领到同一编号的线程继续使用，因此累计值不会丢失。
+ */
+template<typename T>
+class per_thread {
+public:
+    // ============================ 类型定义 ============================
+    typedef T value_type;
+    typedef size_t size_type;
+
+    static const size_type chunk_slots = 16;
+    static const size_type max_chunks = 256;
+
+private:
+    typedef cache_aligned<T> slot;
+
+    // ============================ 私有成员 ============================
+    std::atomic<slot*> chunks_[max_chunks];
+    void* raw_[max_chunks];  // ::operator new 返回的原始指针，只由发布该组的线程写入
+
+    // ============================ 私有辅助函数 ============================
+
+    static void destroy_chunk(slot* chunk, void* raw) noexcept {
+        for (size_type i = 0; i < chunk_slots; ++i) {
+            chunk[i].~slot();
+        }
+        ::operator delete(raw);
+    }
+
+    slot* allocate_chunk(size_type c) {
+        void* raw = ::operator new(chunk_slots * sizeof(slot) + cache_line_size - 1);
+        slot* chunk = reinterpret_cast<slot*>((reinterpret_cast<uintptr_t>(raw) + cache_line_size - 1) &
+                                              ~static_cast<uintptr_t>(cache_line_size - 1));
+        size_type built = 0;
+        try {
+            for (; built < chunk_slots; ++built) {
+                ::new (static_cast<void*>(chunk + built)) slot();
+            }
+        } catch (...) {
+            while (built > 0) {
+                chunk[--built].~slot();
+            }
+            ::operator delete(raw);
+            throw;
+        }
+        slot* expected = nullptr;
+        if (chunks_[c].compare_exchange_strong(expected, chunk, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+            raw_[c] = raw;
+            return chunk;
+        }
+        // 同组的另一个线程抢先发布了，释放自己分配的这一组
+        destroy_chunk(chunk, raw);
+        return expected;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    per_thread() noexcept {
+        for (size_type c = 0; c < max_chunks; ++c) {
+            chunks_[c].store(nullptr, std::memory_order_relaxed);
+            raw_[c] = nullptr;
+        }
+    }
+
+    per_thread(const per_thread&) = delete;
+    per_thread& operator=(const per_thread&) = delete;
+
+    ~per_thread() {
+        for (size_type c = 0; c < max_chunks; ++c) {
+            slot* chunk = chunks_[c].load(std::memory_order_relaxed);
+            if (chunk != nullptr) {
+                destroy_chunk(chunk, raw_[c]);
+            }
+        }
+    }
+
+    // ============================ 访问 ============================
+
+    /**
+     * @brief 当前线程的槽位，首次访问所在组时分配内存
+     */
+    T& local() {
+        const size_type index = this_thread_index();
+        SUGAR_THROW_LENGTH_ERROR_IF(index >= chunk_slots * max_chunks, "per_thread::local - too many threads");
+        slot* chunk = chunks_[index / chunk_slots].load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+            chunk = allocate_chunk(index / chunk_slots);
+        }
+        return chunk[index % chunk_slots].value;
+    }
+
+    /**
+     * @brief 对每个已分配的槽位调用 f，包括从未被使用过的默认构造的槽位
+     */
+    template<typename F>
+    void for_each(F f) {
+        for (size_type c = 0; c < max_chunks; ++c) {
+            slot* chunk = chunks_[c].load(std::memory_order_acquire);
+            if (chunk != nullptr) {
+                for (size_type i = 0; i < chunk_slots; ++i) {
+                    f(chunk[i].value);
+                }
+            }
+        }
+    }
+
+    template<typename F>
+    void for_each(F f) const {
+        for (size_type c = 0; c < max_chunks; ++c) {
+            const slot* chunk = chunks_[c].load(std::memory_order_acquire);
+            if (chunk != nullptr) {
+                for (size_type i = 0; i < chunk_slots; ++i) {
+                    f(chunk[i].value);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 以 init 为初值，用 op(累计值, 槽位) 折叠所有槽位
+     */
+    template<typename U, typename BinaryOp>
+    U combine(U init, BinaryOp op) const {
+        for_each([&](const T& value) { init = op(init, value); });
+        return init;
+    }
+
+    /**
+     * @brief 已分配的槽位数
+     */
+    size_type slots() const noexcept {
+        size_type n = 0;
+        for (size_type c = 0; c < max_chunks; ++c) {
+            if (chunks_[c].load(std::memory_order_relaxed) != nullptr) {
+                n += chunk_slots;
+            }
+        }
+        return n;
+    }
+};
+
+// ============================ sharded_counter 类 ============================
+
+/**
+ * @brief sharded_counter 类，按线程分片的计数器
+ *
+ * 每个线程只写自己的槽位，增加计数是一次普通的读和写（relaxed原子load/store，不带lock前缀），
+ * 不同线程的计数落在不同缓存行上，互不干扰；value() 汇总所有槽位，代价与槽位数成正比，
+ * 适合写多读少的指标统计。与写入并发时读到的是某个近似的中间值。
+ */
+class sharded_counter {
+private:
+    per_thread<std::atomic<int64_t>> slots_;
+
+public:
+    sharded_counter() {}
+
+    void add(int64_t n = 1) {
+        std::atomic<int64_t>& slot = slots_.local();
+        slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void sub(int64_t n = 1) { add(-n); }
+
+    sharded_counter& operator++() {
+        add(1);
+        return *this;
+    }
+
+    sharded_counter& operator+=(int64_t n) {
+        add(n);
+        return *this;
+    }
+
+    sharded_counter& operator-=(int64_t n) {
+        add(-n);
+        return *this;
+    }
+
+    /**
+     * @brief 所有线程的计数之和
+     */
+    int64_t value() const {
+        return slots_.combine(int64_t(0), [](int64_t sum, const std::atomic<int64_t>& slot) {
+            return sum + slot.load(std::memory_order_relaxed);
+        });
+    }
+
+    /**
+     * @brief 清零；不能与 add 并发调用
+     */
+    void reset() {
+        slots_.for_each([](std::atomic<int64_t>& slot) { slot.store(0, std::memory_order_relaxed); });
+    }
+};
+
+// ============================ sharded_histogram 类 ============================
+
+/**
+ * @brief 直方图分桶：小于8的值各占一桶，其余每个2的幂区间等分为8个桶，相对误差不超过12.5%
+ */
+const size_t histogram_sub_buckets = 8;
+const size_t histogram_bucket_count = (64 - 2) * histogram_sub_buckets;
+
+/**
+ * @brief histogram_snapshot 结构体，sharded_histogram 某一时刻的汇总结果
+ */
+struct histogram_snapshot {
+    vector<uint64_t> buckets;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;  // count为0时无意义
+    uint64_t max;
+
+    histogram_snapshot() : buckets(histogram_bucket_count, 0), count(0), sum(0), min(UINT64_MAX), max(0) {}
+
+    double mean() const noexcept { return count == 0 ? 0.0 : static_cast<double>(sum) / count; }
+
+    /**
+     * @brief 第 q 分位数（q 取 [0, 1]）的估计值：所在桶的中点，并截断到 [min, max]
+     */
+    uint64_t percentile(double q) const;
+};
+
+/**
+ * @brief sharded_histogram 类，按线程分片的延迟/大小直方图
+ *
+ * 每个线程的桶数组、计数、总和、最值都在自己的槽位里，只由本线程写入；
+ * snapshot() 逐桶汇总。桶按对数-线性划分，覆盖整个uint64取值范围，每个线程约4KB。
+ */
+class sharded_histogram {
+private:
+    struct shard {
+        std::atomic<uint64_t> buckets[histogram_bucket_count];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> min;
+        std::atomic<uint64_t> max;
+
+        shard() : count(0), sum(0), min(UINT64_MAX), max(0) {
+            for (size_t i = 0; i < histogram_bucket_count; ++i) {
+                buckets[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    per_thread<shard> shards_;
+
+    static void bump(std::atomic<uint64_t>& x, uint64_t n) noexcept {
+        x.store(x.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+public:
+    // ============================ 分桶 ============================
+
+    static size_t bucket_of(uint64_t v) noexcept {
+        if (v < histogram_sub_buckets) {
+            return static_cast<size_t>(v);
+        }
+        const size_t e = 63 - static_cast<size_t>(__builtin_clzll(v));  // v 的最高位，至少为3
+        return (e - 2) * histogram_sub_buckets + static_cast<size_t>((v >> (e - 3)) & (histogram_sub_buckets - 1));
+    }
+
+    static uint64_t bucket_lower(size_t b) noexcept {
+        if (b < histogram_sub_buckets) {
+            return b;
+        }
+        const size_t e = b / histogram_sub_buckets + 2;
+        return (histogram_sub_buckets + b % histogram_sub_buckets) << (e - 3);
+    }
+
+    static uint64_t bucket_upper(size_t b) noexcept {
+        return b + 1 == histogram_bucket_count ? UINT64_MAX : bucket_lower(b + 1) - 1;
+    }
+
+    // ============================ 构造函数 ============================
+
+    sharded_histogram() {}
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 记录一个取值
+     */
+    void record(uint64_t v) {
+        shard& s = shards_.local();
+        bump(s.buckets[bucket_of(v)], 1);
+        bump(s.count, 1);
+        bump(s.sum, v);
+        if (v < s.min.load(std::memory_order_relaxed)) {
+            s.min.store(v, std::memory_order_relaxed);
+        }
+        if (v > s.max.load(std::memory_order_relaxed)) {
+            s.max.store(v, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 清零；不能与 record 并发调用
+     */
+    void reset() {
+        shards_.for_each([](shard& s) {
+            for (size_t i = 0; i < histogram_bucket_count; ++i) {
+                s.buckets[i].store(0, std::memory_order_relaxed);
+            }
+            s.count.store(0, std::memory_order_relaxed);
+            s.sum.store(0, std::memory_order_relaxed);
+            s.min.store(UINT64_MAX, std::memory_order_relaxed);
+            s.max.store(0, std::memory_order_relaxed);
+        });
+    }
+
+    // ============================ 查询 ============================
+
+    /**
+     * @brief 汇总所有线程的数据；与写入并发时各字段不保证来自同一时刻
+     */
+    histogram_snapshot snapshot() const {
+        histogram_snapshot out;
+        shards_.for_each([&](const shard& s) {
+            for (size_t i = 0; i < histogram_bucket_count; ++i) {
+                out.buckets[i] += s.buckets[i].load(std::memory_order_relaxed);
+            }
+            out.count += s.count.load(std::memory_order_relaxed);
+            out.sum += s.sum.load(std::memory_order_relaxed);
+            const uint64_t lo = s.min.load(std::memory_order_relaxed);
+            const uint64_t hi = s.max.load(std::memory_order_relaxed);
+            if (lo < out.min) {
+                out.min = lo;
+            }
+            if (hi > out.max) {
+                out.max = hi;
+            }
+        });
+        return out;
+    }
+
+    uint64_t count() const {
+        return shards_.combine(uint64_t(0), [](uint64_t n, const shard& s) {
+            return n + s.count.load(std::memory_order_relaxed);
+        });
+    }
+};
+
+inline uint64_t histogram_snapshot::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    if (q < 0) {
+        q = 0;
+    } else if (q > 1) {
+        q = 1;
+    }
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t b = 0; b < histogram_bucket_count; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            const uint64_t lo = sharded_histogram::bucket_lower(b);
+            const uint64_t mid = lo + (sharded_histogram::bucket_upper(b) - lo) / 2;
+            return mid < min ? min : (mid > max ? max : mid);
+        }
+    }
+    return max;
+}
+
+} // namespace sugar
+
+#endif // SHARDED_COUNTER_H_
@@ -0,0 +1,720 @@
+/*
+ * @file sketch.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 概率摘要：HyperLogLog 基数估计、保守更新的 Count-Min 频率估计与可合并的 KLL 分位数摘要，
+ *        内存固定，支持批量更新和合并各线程的局部摘要
+ */
+
+#ifndef SKETCH_H_
+#define SKETCH_H_
+
+#include "algorithm.h"
+#include "functional.h"
+#include "hash.h"
+#include "random.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace sugar {
+
+// ============================ hyperloglog 类 ============================
+
+/**
+ * @brief hyperloglog 类，HyperLogLog 基数估计
+ *
+ * 键数较少时使用稀疏表示：每个键记一个32位条目（25位下标加6位前导零计数），
+ * 按2^25个虚拟寄存器做线性计数，小基数几乎无误差；条目占用的内存超过稠密表示时
+ * 转为2^precision个8位寄存器。稠密估计使用 Ertl 2017 的改进估计量，
+ * 全范围无需偏差修正表，相对标准误差约 1.04 / sqrt(2^precision)。
+ *
+ * @tparam Key 键类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>，要求64位输出充分混合
+ */
+template<typename Key, typename Hash = hash<Key>>
+class hyperloglog {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using hasher = Hash;
+    using size_type = size_t;
+
+private:
+    static const unsigned sparse_precision = 25;
+    static const unsigned min_precision = 4;
+    static const unsigned max_precision = 18;
+
+    // ============================ 私有成员 ============================
+    vector<uint8_t> registers_;   // 稠密寄存器；为空表示仍是稀疏表示
+    vector<uint32_t> sparse_;     // 按下标排序、每个下标只保留最大计数的条目
+    vector<uint32_t> buffer_;     // 尚未并入sparse_的新条目
+    unsigned precision_;
+    Hash hash_;
+
+    // ============================ 私有辅助函数 ============================
+
+    size_type register_count() const noexcept { return size_type(1) << precision_; }
+
+    static uint32_t encode_sparse(uint64_t h) noexcept {
+        const uint32_t index = static_cast<uint32_t>(h >> (64 - sparse_precision));
+        const uint64_t w = h << sparse_precision;
+        uint32_t rho = 64 - sparse_precision + 1;
+        if (w != 0) {
+            rho = static_cast<uint32_t>(__builtin_clzll(w)) + 1;
+        }
+        return index << 6 | rho;
+    }
+
+    /**
+     * @brief 稀疏条目换算到当前精度下的寄存器下标与值
+     */
+    void apply_sparse(uint32_t entry) noexcept {
+        const unsigned extra = sparse_precision - precision_;
+        const uint32_t index25 = entry >> 6;
+        const uint32_t middle = index25 & ((uint32_t(1) << extra) - 1);
+        uint8_t rho = static_cast<uint8_t>(extra + (entry & 63));
+        if (middle != 0) {
+            rho = static_cast<uint8_t>(extra - (32 - __builtin_clz(middle)) + 1);
+        }
+        uint8_t& reg = registers_[index25 >> extra];
+        reg = reg < rho ? rho : reg;
+    }
+
+    void add_hash(uint64_t h) {
+        if (registers_.empty()) {
+            buffer_.push_back(encode_sparse(h));
+            if (buffer_.size() >= register_count() / 16) {
+                flush_buffer();
+            }
+            return;
+        }
+        const uint64_t w = h << precision_;
+        uint8_t rho = static_cast<uint8_t>(65 - precision_);
+        if (w != 0) {
+            rho = static_cast<uint8_t>(__builtin_clzll(w) + 1);
+        }
+        uint8_t& reg = registers_[h >> (64 - precision_)];
+        reg = reg < rho ? rho : reg;
+    }
+
+    /**
+     * @brief 把buffer_排序后并入sparse_，同一下标保留最大计数；超过稠密表示的大小时转为稠密
+     */
+    void flush_buffer() {
+        sugar::sort(buffer_.begin(), buffer_.end());
+        vector<uint32_t> merged;
+        merged.reserve(sparse_.size() + buffer_.size());
+        size_type i = 0;
+        size_type j = 0;
+        while (i < sparse_.size() || j < buffer_.size()) {
+            const uint32_t e = j == buffer_.size() || (i < sparse_.size() && sparse_[i] < buffer_[j]) ? sparse_[i++]
+                                                                                                      : buffer_[j++];
+            // 条目按（下标，计数）升序，同一下标的后一个计数更大
+            if (!merged.empty() && (merged.back() >> 6) == (e >> 6)) {
+                merged.back() = e;
+            } else {
+                merged.push_back(e);
+            }
+        }
+        sparse_.swap(merged);
+        buffer_.clear();
+        if (sparse_.size() > register_count() / 4) {
+            to_dense();
+        }
+    }
+
+    void to_dense() {
+        registers_.resize(register_count(), 0);
+        for (size_type i = 0; i < sparse_.size(); ++i) {
+            apply_sparse(sparse_[i]);
+        }
+        for (size_type i = 0; i < buffer_.size(); ++i) {
+            apply_sparse(buffer_[i]);
+        }
+        vector<uint32_t>().swap(sparse_);
+        vector<uint32_t>().swap(buffer_);
+    }
+
+    static double sigma(double x) {
+        if (x == 1.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        double y = 1.0;
+        double z = x;
+        for (;;) {
+            x *= x;
+            const double previous = z;
+            z += x * y;
+            y += y;
+            if (z == previous) {
+                return z;
+            }
+        }
+    }
+
+    static double tau(double x) {
+        if (x == 0.0 || x == 1.0) {
+            return 0.0;
+        }
+        double y = 1.0;
+        double z = 1.0 - x;
+        for (;;) {
+            x = std::sqrt(x);
+            const double previous = z;
+            y *= 0.5;
+            z -= (1.0 - x) * (1.0 - x) * y;
+            if (z == previous) {
+                return z / 3.0;
+            }
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造空摘要
+     * @param precision 寄存器数为2^precision，取值[4, 18]，否则抛出 invalid_argument
+     */
+    explicit hyperloglog(unsigned precision = 14, const Hash& hash = Hash()) : precision_(precision), hash_(hash) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(precision < min_precision || precision > max_precision,
+                                        "hyperloglog - precision must be in [4, 18]");
+    }
+
+    // ============================ 容量 ============================
+
+    unsigned precision() const noexcept { return precision_; }
+    bool is_sparse() const noexcept { return registers_.empty(); }
+
+    size_type memory_bytes() const noexcept {
+        return registers_.capacity() + (sparse_.capacity() + buffer_.capacity()) * sizeof(uint32_t);
+    }
+
+    // ============================ 查找 ============================
+
+    /**
+     * @brief 估计不同键的个数
+     */
+    double estimate() const {
+        if (registers_.empty()) {
+            // 稀疏表示：对2^25个虚拟寄存器做线性计数
+            vector<uint32_t> pending(buffer_);
+            sugar::sort(pending.begin(), pending.end());
+            size_type distinct = 0;
+            size_type i = 0;
+            size_type j = 0;
+            uint32_t last = ~uint32_t(0);
+            while (i < sparse_.size() || j < pending.size()) {
+                const uint32_t e = j == pending.size() || (i < sparse_.size() && sparse_[i] < pending[j])
+                                       ? sparse_[i++] : pending[j++];
+                distinct += (e >> 6) != last;
+                last = e >> 6;
+            }
+            const double m = double(uint64_t(1) << sparse_precision);
+            return m * std::log(m / (m - double(distinct)));
+        }
+        const unsigned q = 64 - precision_;
+        uint32_t histogram[66] = {0};
+        for (size_type i = 0; i < registers_.size(); ++i) {
+            ++histogram[registers_[i]];
+        }
+        const double m = double(registers_.size());
+        double z = m * tau(1.0 - histogram[q + 1] / m);
+        for (unsigned k = q; k >= 1; --k) {
+            z = 0.5 * (z + histogram[k]);
+        }
+        z += m * sigma(histogram[0] / m);
+        return 0.5 / std::log(2.0) * m * m / z;
+    }
+
+    // ============================ 修改操作 ============================
+
+    void add(const Key& key) { add_hash(static_cast<uint64_t>(hash_(key))); }
+
+    /**
+     * @brief 批量添加：先成块算出散列值再更新寄存器，散列计算与寄存器更新互不阻塞
+     */
+    void add_range(const vector<Key>& keys) {
+        uint64_t hashes[64];
+        for (size_type first = 0; first < keys.size(); first += 64) {
+            const size_type n = keys.size() - first < 64 ? keys.size() - first : 64;
+            for (size_type i = 0; i < n; ++i) {
+                hashes[i] = static_cast<uint64_t>(hash_(keys[first + i]));
+            }
+            for (size_type i = 0; i < n; ++i) {
+                add_hash(hashes[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief 并入另一个摘要（精度须相同，否则抛出 invalid_argument）；稠密寄存器逐字节取最大值，SSE2下每次16个
+     */
+    void merge(const hyperloglog& other) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(precision_ != other.precision_, "hyperloglog::merge - precision mismatch");
+        if (&other == this) {
+            return;
+        }
+        if (other.registers_.empty()) {
+            if (registers_.empty()) {
+                buffer_.insert(buffer_.end(), other.sparse_.begin(), other.sparse_.end());
+                buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+                flush_buffer();
+            } else {
+                for (size_type i = 0; i < other.sparse_.size(); ++i) {
+                    apply_sparse(other.sparse_[i]);
+                }
+                for (size_type i = 0; i < other.buffer_.size(); ++i) {
+                    apply_sparse(other.buffer_[i]);
+                }
+            }
+            return;
+        }
+        if (registers_.empty()) {
+            to_dense();
+        }
+        uint8_t* a = registers_.data();
+        const uint8_t* b = other.registers_.data();
+        const size_type m = registers_.size();
+        size_type i = 0;
+#if SUGAR_HAS_SSE2
+        for (; i + 16 <= m; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), _mm_max_epu8(x, y));
+        }
+#endif
+        for (; i < m; ++i) {
+            a[i] = a[i] < b[i] ? b[i] : a[i];
+        }
+    }
+
+    void clear() noexcept {
+        vector<uint8_t>().swap(registers_);
+        sparse_.clear();
+        buffer_.clear();
+    }
+};
+
+// ============================ count_min_sketch 类 ============================
+
+/**
+ * @brief count_min_sketch 类，保守更新的 Count-Min 频率估计
+ *
+ * depth行、每行width个64位计数器（width取2的幂）。键的各行位置由一个64位散列值
+ * 双重散列得到。保守更新只把各行计数器抬到“当前最小值 + 增量”，
+ * 估计值仍是真实频率的上界，但过估计比普通更新小得多。
+ * 按 with_error(epsilon, delta) 构造时，以1 - delta的概率过估计不超过 epsilon * total()。
+ *
+ * 合并按计数器相加，合并结果仍是上界。
+ *
+ * @tparam Key 键类型
+ * @tparam Hash 散列函数，默认为sugar::hash<Key>
+ */
+template<typename Key, typename Hash = hash<Key>>
+class count_min_sketch {
+public:
+    // ============================ 类型定义 ============================
+    using key_type = Key;
+    using hasher = Hash;
+    using size_type = size_t;
+
+private:
+    // ============================ 私有成员 ============================
+    vector<uint64_t> counters_;
+    size_type width_;
+    size_type depth_;
+    uint64_t total_;
+    Hash hash_;
+
+    // ============================ 私有辅助函数 ============================
+
+    size_type cell(size_type row, uint64_t h) const noexcept {
+        const uint64_t a = h & 0xffffffffull;
+        const uint64_t b = (h >> 32) | 1;
+        return row * width_ + static_cast<size_type>((a + row * b) & (width_ - 1));
+    }
+
+    void add_hash(uint64_t h, uint64_t count) noexcept {
+        uint64_t low = ~uint64_t(0);
+        for (size_type row = 0; row < depth_; ++row) {
+            const uint64_t c = counters_[cell(row, h)];
+            low = c < low ? c : low;
+        }
+        const uint64_t target = low + count;
+        for (size_type row = 0; row < depth_; ++row) {
+            uint64_t& c = counters_[cell(row, h)];
+            c = c < target ? target : c;
+        }
+        total_ += count;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造depth行、每行至少width个计数器的摘要；参数为0时抛出 invalid_argument
+     */
+    count_min_sketch(size_type width, size_type depth, const Hash& hash = Hash())
+        : width_(1), depth_(depth), total_(0), hash_(hash) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(width == 0 || depth == 0, "count_min_sketch - width and depth must be positive");
+        while (width_ < width) {
+            width_ <<= 1;
+        }
+        counters_.resize(width_ * depth_, 0);
+    }
+
+    /**
+     * @brief 按误差要求构造：width = e / epsilon，depth = ln(1 / delta)
+     */
+    static count_min_sketch with_error(double epsilon, double delta, const Hash& hash = Hash()) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(!(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1),
+                                        "count_min_sketch::with_error - epsilon and delta must be in (0, 1)");
+        return count_min_sketch(static_cast<size_type>(std::ceil(std::exp(1.0) / epsilon)),
+                                static_cast<size_type>(std::ceil(std::log(1.0 / delta))), hash);
+    }
+
+    // ============================ 容量 ============================
+
+    size_type width() const noexcept { return width_; }
+    size_type depth() const noexcept { return depth_; }
+
+    /**
+     * @brief 所有更新的增量之和
+     */
+    uint64_t total() const noexcept { return total_; }
+
+    size_type memory_bytes() const noexcept { return counters_.capacity() * sizeof(uint64_t); }
+
+    // ============================ 查找 ============================
+
+    /**
+     * @brief 估计键的频率，不小于真实值
+     */
+    uint64_t estimate(const Key& key) const {
+        const uint64_t h = static_cast<uint64_t>(hash_(key));
+        uint64_t low = ~uint64_t(0);
+        for (size_type row = 0; row < depth_; ++row) {
+            const uint64_t c = counters_[cell(row, h)];
+            low = c < low ? c : low;
+        }
+        return low;
+    }
+
+    // ============================ 修改操作 ============================
+
+    void add(const Key& key, uint64_t count = 1) { add_hash(static_cast<uint64_t>(hash_(key)), count); }
+
+    /**
+     * @brief 批量添加，每个键计1次
+     */
+    void add_range(const vector<Key>& keys) {
+        uint64_t hashes[64];
+        for (size_type first = 0; first < keys.size(); first += 64) {
+            const size_type n = keys.size() - first < 64 ? keys.size() - first : 64;
+            for (size_type i = 0; i < n; ++i) {
+                hashes[i] = static_cast<uint64_t>(hash_(keys[first + i]));
+            }
+            for (size_type i = 0; i < n; ++i) {
+                add_hash(hashes[i], 1);
+            }
+        }
+    }
+
+    /**
+     * @brief 并入另一个摘要（尺寸须相同，否则抛出 invalid_argument）
+     */
+    void merge(const count_min_sketch& other) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(width_ != other.width_ || depth_ != other.depth_,
+                                        "count_min_sketch::merge - dimension mismatch");
+        for (size_type i = 0; i < counters_.size(); ++i) {
+            counters_[i] += other.counters_[i];
+        }
+        total_ += other.total_;
+    }
+
+    void clear() noexcept {
+        for (size_type i = 0; i < counters_.size(); ++i) {
+            counters_[i] = 0;
+        }
+        total_ = 0;
+    }
+};
+
+// ============================ kll_sketch 类 ============================
+
+/**
+ * @brief kll_sketch 类，KLL 分位数摘要（Karnin, Lang, Liberty 2016）
+ *
+ * 第h层的元素各代表2^h个原始值。某层装满时排序，随机保留奇数位或偶数位的元素升入上一层，
+ * 每次只压缩最低的一个满层（惰性压缩）。层容量自顶向下按2/3递减（最低为8），最高层为k，
+ * 总保留元素约3k个，与数据量无关；k = 200时归一化秩误差约1%~2%。
+ * 合并时逐层拼接后重新压缩，因此各线程的局部摘要可以随意合并。
+ *
+ * @tparam T 值类型
+ * @tparam Compare 比较函数
+ */
+template<typename T, typename Compare = less<T>>
+class kll_sketch {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = T;
+    using size_type = size_t;
+
+private:
+    // ============================ 私有成员 ============================
+    vector<vector<T>> levels_;
+    vector<size_type> capacities_;   // 各层容量，层数变化时重算
+    size_type k_;
+    size_type retained_;   // 各层元素总数
+    size_type capacity_;   // 各层容量之和，retained_达到它时压缩
+    uint64_t count_;
+    T min_;
+    T max_;
+    wyrand rng_;
+    Compare comp_;
+
+    // ============================ 私有辅助函数 ============================
+
+    void grow() {
+        levels_.push_back(vector<T>());
+        capacities_.resize(levels_.size());
+        capacity_ = 0;
+        for (size_type h = 0; h < levels_.size(); ++h) {
+            // 低层容量不低于8，避免对极短的层频繁排序
+            const double depth = static_cast<double>(levels_.size() - h - 1);
+            const size_type capacity = static_cast<size_type>(std::ceil(std::pow(2.0 / 3.0, depth) * k_)) + 1;
+            capacities_[h] = capacity < 8 ? 8 : capacity;
+            capacity_ += capacities_[h];
+        }
+    }
+
+    /**
+     * @brief 压缩最低的满层：排序后隔一个取一个升入上一层，奇数个时最小的元素留在原层
+     */
+    void compress() {
+        for (size_type h = 0; h < levels_.size(); ++h) {
+            if (levels_[h].size() < capacities_[h]) {
+                continue;
+            }
+            if (h + 1 == levels_.size()) {
+                grow();
+            }
+            vector<T>& src = levels_[h];
+            vector<T>& dst = levels_[h + 1];
+            sugar::sort(src.begin(), src.end(), comp_);
+            const size_type n = src.size();
+            const size_type start = n & 1;
+            const size_type offset = static_cast<size_type>(rng_() & 1);
+            for (size_type i = start; i + 1 < n; i += 2) {
+                dst.push_back(src[i + offset]);
+            }
+            src.resize(start);
+            retained_ -= (n - start) / 2;
+            return;
+        }
+    }
+
+    /**
+     * @brief 所有保留元素连同权重，按值排序
+     */
+    vector<pair<T, uint64_t>> weighted() const {
+        vector<pair<T, uint64_t>> items;
+        items.reserve(retained_);
+        for (size_type h = 0; h < levels_.size(); ++h) {
+            for (size_type i = 0; i < levels_[h].size(); ++i) {
+                items.push_back(pair<T, uint64_t>(levels_[h][i], uint64_t(1) << h));
+            }
+        }
+        const Compare& comp = comp_;
+        sugar::sort(items.begin(), items.end(), [&comp](const pair<T, uint64_t>& a, const pair<T, uint64_t>& b) {
+            return comp(a.first, b.first);
+        });
+        return items;
+    }
+
+    void note_extremes(const T& value) {
+        if (count_ == 0 || comp_(value, min_)) {
+            min_ = value;
+        }
+        if (count_ == 0 || comp_(max_, value)) {
+            max_ = value;
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造空摘要
+     * @param k 最高层容量，决定精度与内存；小于8时抛出 invalid_argument
+     */
+    explicit kll_sketch(size_type k = 200, const Compare& comp = Compare())
+        : k_(k), retained_(0), capacity_(0), count_(0), min_(), max_(), comp_(comp) {
+        SUGAR_THROW_INVALID_ARGUMENT_IF(k < 8, "kll_sketch - k must be at least 8");
+        grow();
+    }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return count_ == 0; }
+
+    /**
+     * @brief 添加过的值的个数
+     */
+    uint64_t count() const noexcept { return count_; }
+
+    /**
+     * @brief 当前保留的元素个数
+     */
+    size_type retained() const noexcept { return retained_; }
+
+    size_type memory_bytes() const noexcept {
+        size_type bytes = levels_.capacity() * sizeof(vector<T>) + capacities_.capacity() * sizeof(size_type);
+        for (size_type h = 0; h < levels_.size(); ++h) {
+            bytes += levels_[h].capacity() * sizeof(T);
+        }
+        return bytes;
+    }
+
+    // ============================ 查找 ============================
+
+    const T& min() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(count_ == 0, "kll_sketch::min - sketch is empty");
+        return min_;
+    }
+
+    const T& max() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(count_ == 0, "kll_sketch::max - sketch is empty");
+        return max_;
+    }
+
+    /**
+     * @brief 估计不大于value的值的个数
+     */
+    uint64_t rank(const T& value) const {
+        uint64_t r = 0;
+        for (size_type h = 0; h < levels_.size(); ++h) {
+            uint64_t below = 0;
+            for (size_type i = 0; i < levels_[h].size(); ++i) {
+                below += !comp_(value, levels_[h][i]);
+            }
+            r += below << h;
+        }
+        return r;
+    }
+
+    /**
+     * @brief 批量估计分位数，fractions中每个值须在[0, 1]内；0和1返回精确的最小值与最大值
+     */
+    vector<T> quantiles(const vector<double>& fractions) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(count_ == 0, "kll_sketch::quantiles - sketch is empty");
+        const vector<pair<T, uint64_t>> items = weighted();
+        vector<T> out;
+        out.reserve(fractions.size());
+        for (size_type f = 0; f < fractions.size(); ++f) {
+            const double q = fractions[f];
+            SUGAR_THROW_INVALID_ARGUMENT_IF(!(q >= 0.0 && q <= 1.0), "kll_sketch::quantiles - fraction out of [0, 1]");
+            if (q == 0.0) {
+                out.push_back(min_);
+                continue;
+            }
+            if (q == 1.0) {
+                out.push_back(max_);
+                continue;
+            }
+            const double target = q * static_cast<double>(count_);
+            uint64_t cumulative = 0;
+            size_type i = 0;
+            while (i + 1 < items.size() && static_cast<double>(cumulative + items[i].second) < target) {
+                cumulative += items[i].second;
+                ++i;
+            }
+            out.push_back(items[i].first);
+        }
+        return out;
+    }
+
+    T quantile(double fraction) const {
+        vector<double> fractions(1, fraction);
+        return quantiles(fractions)[0];
+    }
+
+    // ============================ 修改操作 ============================
+
+    void add(const T& value) {
+        note_extremes(value);
+        ++count_;
+        levels_[0].push_back(value);
+        if (++retained_ >= capacity_) {
+            compress();
+        }
+    }
+
+    /**
+     * @brief 批量添加：每次直接填到第0层触发压缩的位置，减少逐个检查
+     */
+    void add_range(const vector<T>& values) {
+        size_type i = 0;
+        while (i < values.size()) {
+            const size_type room = capacity_ - retained_;
+            const size_type n = values.size() - i < room ? values.size() - i : room;
+            for (size_type j = i; j < i + n; ++j) {
+                note_extremes(values[j]);
+                ++count_;
+                levels_[0].push_back(values[j]);
+            }
+            i += n;
+            retained_ += n;
+            if (retained_ >= capacity_) {
+                compress();
+            }
+        }
+    }
+
+    /**
+     * @brief 并入另一个摘要：逐层拼接后压缩到容量以内
+     */
+    void merge(const kll_sketch& other) {
+        if (other.count_ == 0) {
+            return;
+        }
+        if (&other == this) {
+            const kll_sketch copy(other);
+            merge(copy);
+            return;
+        }
+        if (count_ == 0 || comp_(other.min_, min_)) {
+            min_ = other.min_;
+        }
+        if (count_ == 0 || comp_(max_, other.max_)) {
+            max_ = other.max_;
+        }
+        while (levels_.size() < other.levels_.size()) {
+            grow();
+        }
+        for (size_type h = 0; h < other.levels_.size(); ++h) {
+            levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+            retained_ += other.levels_[h].size();
+        }
+        count_ += other.count_;
+        while (retained_ >= capacity_) {
+            compress();
+        }
+    }
+
+    void clear() {
+        levels_.clear();
+        retained_ = 0;
+        count_ = 0;
+        grow();
+    }
+};
+
+} // namespace sugar
+
+#endif // SKETCH_H_
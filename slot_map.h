@@ -0,0 +1,277 @@
+/*
+ * @file slot_map.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 槽位映射：slot_map 用（下标，代数）句柄标识元素，
+ *        值紧密存放便于遍历，删除后旧句柄自动失效
+ */
+
+#ifndef SLOT_MAP_H_
+#define SLOT_MAP_H_
+
+#include "vector.h"
+#include "utility.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace sugar {
+
+// ============================ slot_map_handle ============================
+
+/**
+ * @brief slot_map 的句柄：槽位下标与代数。代数为奇数表示槽位被占用，
+ *        槽位每次分配和释放都会使代数加一，因此删除后旧句柄不会再匹配
+ */
+struct slot_map_handle {
+    uint32_t index;
+    uint32_t generation;
+};
+
+inline bool operator==(const slot_map_handle& lhs, const slot_map_handle& rhs) noexcept {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+inline bool operator!=(const slot_map_handle& lhs, const slot_map_handle& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// ============================ slot_map 类模板 ============================
+
+/**
+ * @brief slot_map 类模板，带代数校验的句柄容器
+ *
+ * 三个数组配合：
+ * - values_ 紧密存放全部值，遍历就是顺序扫描；
+ * - slots_ 是句柄到values_下标的间接层，空闲槽位借用同一字段串成空闲链；
+ * - owners_ 记录values_中每个位置对应的槽位，删除时用末尾元素填洞后据此回写槽位。
+ * 插入、删除、查找都是 O(1)；删除会改变values_中元素的顺序，但不影响其他句柄。
+ *
+ * 代数为32位，同一个槽位被反复分配约20亿次后才会回绕，之后极旧的句柄可能误匹配。
+ *
+ * @tparam T 元素类型
+ */
+template<typename T>
+class slot_map {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = T;
+    using size_type = size_t;
+    using handle_type = slot_map_handle;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = typename vector<T>::iterator;
+    using const_iterator = typename vector<T>::const_iterator;
+
+private:
+    static const uint32_t nil = 0xffffffffu;
+
+    struct slot {
+        uint32_t target;        // 占用时为values_下标，空闲时为下一个空闲槽位
+        uint32_t generation;    // 奇数表示占用
+    };
+
+    // ============================ 私有成员 ============================
+    vector<T> values_;
+    vector<uint32_t> owners_;   // values_[i] 属于 slots_[owners_[i]]
+    vector<slot> slots_;
+    uint32_t free_head_;        // 空闲链表头
+
+    // ============================ 私有辅助函数 ============================
+
+    /**
+     * @brief 保证再追加一个元素不需要重新分配；按倍数扩容
+     */
+    template<typename U>
+    static void reserve_one(vector<U>& v) {
+        if (v.size() == v.capacity()) {
+            v.reserve(2 * v.size() + 1);
+        }
+    }
+
+    /**
+     * @brief 追加值之前预留owners_和slots_的空间，之后的attach_last不会抛出
+     */
+    void prepare_insert() {
+        check_capacity();
+        reserve_one(owners_);
+        if (free_head_ == nil) {
+            reserve_one(slots_);
+        }
+    }
+
+    /**
+     * @brief 为刚追加到values_末尾的值分配槽位，空间已由prepare_insert预留
+     */
+    handle_type attach_last() noexcept {
+        const uint32_t pos = static_cast<uint32_t>(values_.size() - 1);
+        uint32_t index;
+        if (free_head_ != nil) {
+            index = free_head_;
+            free_head_ = slots_[index].target;
+        } else {
+            index = static_cast<uint32_t>(slots_.size());
+            slot fresh = {0, 0};
+            slots_.push_back(fresh);
+        }
+        owners_.push_back(index);
+        slot& s = slots_[index];
+        s.target = pos;
+        ++s.generation;
+        handle_type h = {index, s.generation};
+        return h;
+    }
+
+    bool valid(handle_type h) const noexcept {
+        return h.index < slots_.size() && slots_[h.index].generation == h.generation && (h.generation & 1) != 0;
+    }
+
+    void check_capacity() const {
+        SUGAR_THROW_LENGTH_ERROR_IF(values_.size() >= nil, "slot_map - too many elements");
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    slot_map() : free_head_(nil) {}
+
+    // ============================ 迭代器 ============================
+
+    /**
+     * @brief 按紧密存放顺序遍历全部值；顺序在删除后会改变
+     */
+    iterator begin() noexcept { return values_.begin(); }
+    iterator end() noexcept { return values_.end(); }
+    const_iterator begin() const noexcept { return values_.begin(); }
+    const_iterator end() const noexcept { return values_.end(); }
+
+    T* data() noexcept { return values_.data(); }
+    const T* data() const noexcept { return values_.data(); }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return values_.empty(); }
+    size_type size() const noexcept { return values_.size(); }
+
+    void reserve(size_type n) {
+        values_.reserve(n);
+        owners_.reserve(n);
+        slots_.reserve(n);
+    }
+
+    // ============================ 访问 ============================
+
+    bool contains(handle_type h) const noexcept {
+        return valid(h);
+    }
+
+    /**
+     * @brief 按句柄取值，句柄失效时返回nullptr
+     */
+    T* get(handle_type h) noexcept {
+        return valid(h) ? &values_[slots_[h.index].target] : nullptr;
+    }
+
+    const T* get(handle_type h) const noexcept {
+        return valid(h) ? &values_[slots_[h.index].target] : nullptr;
+    }
+
+    /**
+     * @brief 按句柄取值，句柄失效时抛出out_of_range
+     */
+    T& at(handle_type h) {
+        SUGAR_THROW_OUT_OF_RANGE_IF(!valid(h), "slot_map::at - invalid handle");
+        return values_[slots_[h.index].target];
+    }
+
+    const T& at(handle_type h) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(!valid(h), "slot_map::at - invalid handle");
+        return values_[slots_[h.index].target];
+    }
+
+    /**
+     * @brief 不检查句柄的访问，调用者保证句柄有效
+     */
+    T& operator[](handle_type h) noexcept {
+        SUGAR_DEBUG(valid(h));
+        return values_[slots_[h.index].target];
+    }
+
+    const T& operator[](handle_type h) const noexcept {
+        SUGAR_DEBUG(valid(h));
+        return values_[slots_[h.index].target];
+    }
+
+    /**
+     * @brief values_中第i个值的句柄，遍历时用来取回句柄
+     */
+    handle_type handle_at(size_type i) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= values_.size(), "slot_map::handle_at - index out of range");
+        const uint32_t index = owners_[i];
+        handle_type h = {index, slots_[index].generation};
+        return h;
+    }
+
+    // ============================ 修改操作 ============================
+
+    handle_type insert(const T& value) {
+        prepare_insert();
+        values_.push_back(value);
+        return attach_last();
+    }
+
+    handle_type insert(T&& value) {
+        prepare_insert();
+        values_.push_back(sugar::move(value));
+        return attach_last();
+    }
+
+    template<typename... Args>
+    handle_type emplace(Args&&... args) {
+        prepare_insert();
+        values_.push_back(T(sugar::forward<Args>(args)...));
+        return attach_last();
+    }
+
+    /**
+     * @brief 删除句柄对应的元素：用末尾元素填补空位，句柄失效，槽位进入空闲链
+     * @return 句柄是否有效
+     */
+    bool erase(handle_type h) {
+        if (!valid(h)) {
+            return false;
+        }
+        slot& s = slots_[h.index];
+        const uint32_t pos = s.target;
+        const uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+        if (pos != last) {
+            values_[pos] = sugar::move(values_[last]);
+            owners_[pos] = owners_[last];
+            slots_[owners_[pos]].target = pos;
+        }
+        values_.pop_back();
+        owners_.pop_back();
+        ++s.generation;
+        s.target = free_head_;
+        free_head_ = h.index;
+        return true;
+    }
+
+    /**
+     * @brief 删除全部元素，所有句柄失效，槽位保留以便复用
+     */
+    void clear() {
+        for (size_type i = 0; i < owners_.size(); ++i) {
+            slot& s = slots_[owners_[i]];
+            ++s.generation;
+            s.target = free_head_;
+            free_head_ = owners_[i];
+        }
+        values_.clear();
+        owners_.clear();
+    }
+};
+
+} // namespace sugar
+
+#endif // SLOT_MAP_H_
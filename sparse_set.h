@@ -0,0 +1,375 @@
+/*
+ * @file sparse_set.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 整数集合：sparse_set（稠密数组+稀疏下标，O(1)清空）与
+ *        按密度在有序数组、sparse_set、位图之间切换表示的 integer_set
+ */
+
+#ifndef SPARSE_SET_H_
+#define SPARSE_SET_H_
+
+#include "algorithm.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace sugar {
+
+// ============================ sparse_set 类 ============================
+
+/**
+ * @brief sparse_set 类，[0, universe) 上的整数集合
+ *
+ * dense_ 紧密存放全部成员，sparse_[x] 记录x在dense_中的位置。判断成员时
+ * 检查 sparse_[x] < size 且 dense_[sparse_[x]] == x，因此sparse_中的残留值无需清理：
+ * clear 只把大小置0，是O(1)的。删除时用最后一个成员填位。
+ * 遍历只扫描dense_，代价与成员数成正比，与值域大小无关；遍历顺序不是数值顺序。
+ */
+class sparse_set {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint32_t;
+    using size_type = size_t;
+    using const_iterator = const uint32_t*;
+    using iterator = const_iterator;
+
+private:
+    // ============================ 私有成员 ============================
+    vector<uint32_t> dense_;
+    vector<uint32_t> sparse_;
+    size_type size_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static size_type checked_universe(size_type universe) {
+        // 成员是uint32_t，值域必须在分配之前检查
+        SUGAR_THROW_LENGTH_ERROR_IF(universe > 0xffffffffu, "sparse_set - universe too large");
+        return universe;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param universe 值域上界（不含）
+     */
+    explicit sparse_set(size_type universe = 0)
+        : dense_(checked_universe(universe)), sparse_(universe), size_(0) {}
+
+    // ============================ 迭代器 ============================
+
+    const_iterator begin() const noexcept { return dense_.data(); }
+    const_iterator end() const noexcept { return dense_.data() + size_; }
+    const uint32_t* data() const noexcept { return dense_.data(); }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type universe() const noexcept { return sparse_.size(); }
+
+    // ============================ 查找 ============================
+
+    bool contains(uint32_t x) const noexcept {
+        if (x >= sparse_.size()) {
+            return false;
+        }
+        const uint32_t pos = sparse_[x];
+        return pos < size_ && dense_[pos] == x;
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 插入x，x必须小于universe()
+     * @return 是否新插入
+     */
+    bool insert(uint32_t x) {
+        SUGAR_THROW_OUT_OF_RANGE_IF(x >= sparse_.size(), "sparse_set::insert - value out of range");
+        if (contains(x)) {
+            return false;
+        }
+        dense_[size_] = x;
+        sparse_[x] = static_cast<uint32_t>(size_);
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief 删除x
+     * @return 是否删除了成员
+     */
+    bool erase(uint32_t x) noexcept {
+        if (!contains(x)) {
+            return false;
+        }
+        const uint32_t pos = sparse_[x];
+        const uint32_t last = dense_[size_ - 1];
+        dense_[pos] = last;
+        sparse_[last] = pos;
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief O(1)清空
+     */
+    void clear() noexcept {
+        size_ = 0;
+    }
+};
+
+// ============================ integer_set 类 ============================
+
+/**
+ * @brief integer_set 的存储形态
+ */
+enum class integer_set_mode {
+    sorted,    // 有序数组：成员很少
+    sparse,    // sparse_set：成员不多但也不少
+    bitmap     // 位图：成员稠密
+};
+
+/**
+ * @brief integer_set 类，随密度自动切换存储形态的整数集合
+ *
+ * 成员不超过 sorted_limit 时用有序数组，查找是对一两条缓存行的二分；
+ * 成员达到值域的1/16时改用位图，此时遍历位图（值域/64个字）不比遍历成员数组慢，内存还少得多；
+ * 两者之间用sparse_set，增删查都是O(1)，遍历与成员数成正比。
+ * 向稀疏方向切换的阈值减半，避免在边界上反复转换。
+ * sparse_set的稀疏下标数组在第一次需要时分配，此后保留。
+ */
+class integer_set {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint32_t;
+    using size_type = size_t;
+
+private:
+    static const size_type sorted_limit = 64;
+
+    // ============================ 私有成员 ============================
+    integer_set_mode mode_;
+    size_type universe_;
+    size_type size_;
+    vector<uint32_t> sorted_;
+    sparse_set sparse_;
+    vector<uint64_t> bits_;
+
+    // ============================ 私有辅助函数 ============================
+
+    size_type bitmap_threshold() const noexcept {
+        const size_type t = universe_ / 16;
+        return t > sorted_limit ? t : sorted_limit + 1;
+    }
+
+    bool bit(uint32_t x) const noexcept {
+        return (bits_[x >> 6] >> (x & 63)) & 1;
+    }
+
+    /**
+     * @brief 按顺序取出当前全部成员
+     */
+    vector<uint32_t> members() const {
+        vector<uint32_t> out;
+        out.reserve(size_);
+        for_each([&out](uint32_t x) { out.push_back(x); });
+        return out;
+    }
+
+    void convert(integer_set_mode target) {
+        if (target == mode_) {
+            return;
+        }
+        vector<uint32_t> all = members();
+        sorted_.clear();
+        sparse_.clear();
+        if (mode_ == integer_set_mode::bitmap) {
+            vector<uint64_t>().swap(bits_);
+        }
+        mode_ = target;
+        switch (target) {
+            case integer_set_mode::sorted:
+                if (!sugar::is_sorted(all.begin(), all.end())) {
+                    sugar::sort(all.begin(), all.end());
+                }
+                sorted_.swap(all);
+                break;
+            case integer_set_mode::sparse:
+                if (sparse_.universe() != universe_) {
+                    sparse_ = sparse_set(universe_);
+                }
+                for (size_type i = 0; i < all.size(); ++i) {
+                    sparse_.insert(all[i]);
+                }
+                break;
+            case integer_set_mode::bitmap:
+                bits_.assign((universe_ + 63) / 64, uint64_t(0));
+                for (size_type i = 0; i < all.size(); ++i) {
+                    bits_[all[i] >> 6] |= uint64_t(1) << (all[i] & 63);
+                }
+                break;
+        }
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造函数
+     * @param universe 值域上界（不含）
+     */
+    explicit integer_set(size_type universe)
+        : mode_(integer_set_mode::sorted), universe_(universe), size_(0) {
+        SUGAR_THROW_LENGTH_ERROR_IF(universe > 0xffffffffu, "integer_set - universe too large");
+    }
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type universe() const noexcept { return universe_; }
+    integer_set_mode mode() const noexcept { return mode_; }
+
+    // ============================ 查找 ============================
+
+    bool contains(uint32_t x) const {
+        if (x >= universe_) {
+            return false;
+        }
+        switch (mode_) {
+            case integer_set_mode::sorted:
+                return sugar::binary_search(sorted_.begin(), sorted_.end(), x);
+            case integer_set_mode::sparse:
+                return sparse_.contains(x);
+            default:
+                return bit(x);
+        }
+    }
+
+    /**
+     * @brief 对每个成员调用f(x)；有序数组与位图形态按升序，sparse_set形态按插入位置
+     */
+    template<typename F>
+    void for_each(F f) const {
+        switch (mode_) {
+            case integer_set_mode::sorted:
+                for (size_type i = 0; i < sorted_.size(); ++i) {
+                    f(sorted_[i]);
+                }
+                break;
+            case integer_set_mode::sparse:
+                for (sparse_set::const_iterator it = sparse_.begin(); it != sparse_.end(); ++it) {
+                    f(*it);
+                }
+                break;
+            case integer_set_mode::bitmap:
+                for (size_type w = 0; w < bits_.size(); ++w) {
+                    uint64_t word = bits_[w];
+                    while (word != 0) {
+                        f(static_cast<uint32_t>(w * 64 + static_cast<size_type>(__builtin_ctzll(word))));
+                        word &= word - 1;
+                    }
+                }
+                break;
+        }
+    }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 插入x，x必须小于universe()
+     * @return 是否新插入
+     */
+    bool insert(uint32_t x) {
+        SUGAR_THROW_OUT_OF_RANGE_IF(x >= universe_, "integer_set::insert - value out of range");
+        bool inserted;
+        switch (mode_) {
+            case integer_set_mode::sorted: {
+                vector<uint32_t>::iterator pos = sugar::lower_bound(sorted_.begin(), sorted_.end(), x);
+                inserted = pos == sorted_.end() || *pos != x;
+                if (inserted) {
+                    sorted_.insert(pos, x);
+                }
+                break;
+            }
+            case integer_set_mode::sparse:
+                inserted = sparse_.insert(x);
+                break;
+            default: {
+                uint64_t& word = bits_[x >> 6];
+                const uint64_t mask = uint64_t(1) << (x & 63);
+                inserted = (word & mask) == 0;
+                word |= mask;
+                break;
+            }
+        }
+        if (inserted) {
+            ++size_;
+            if (mode_ != integer_set_mode::bitmap && size_ >= bitmap_threshold()) {
+                convert(integer_set_mode::bitmap);
+            } else if (mode_ == integer_set_mode::sorted && size_ > sorted_limit) {
+                convert(integer_set_mode::sparse);
+            }
+        }
+        return inserted;
+    }
+
+    /**
+     * @brief 删除x
+     * @return 是否删除了成员
+     */
+    bool erase(uint32_t x) {
+        if (x >= universe_) {
+            return false;
+        }
+        bool erased;
+        switch (mode_) {
+            case integer_set_mode::sorted: {
+                vector<uint32_t>::iterator pos = sugar::lower_bound(sorted_.begin(), sorted_.end(), x);
+                erased = pos != sorted_.end() && *pos == x;
+                if (erased) {
+                    sorted_.erase(pos);
+                }
+                break;
+            }
+            case integer_set_mode::sparse:
+                erased = sparse_.erase(x);
+                break;
+            default: {
+                uint64_t& word = bits_[x >> 6];
+                const uint64_t mask = uint64_t(1) << (x & 63);
+                erased = (word & mask) != 0;
+                word &= ~mask;
+                break;
+            }
+        }
+        if (erased) {
+            --size_;
+            if (mode_ == integer_set_mode::bitmap && size_ < bitmap_threshold() / 2) {
+                convert(size_ <= sorted_limit / 2 ? integer_set_mode::sorted : integer_set_mode::sparse);
+            } else if (mode_ == integer_set_mode::sparse && size_ <= sorted_limit / 2) {
+                convert(integer_set_mode::sorted);
+            }
+        }
+        return erased;
+    }
+
+    /**
+     * @brief 清空并回到有序数组形态
+     */
+    void clear() {
+        sorted_.clear();
+        sparse_.clear();
+        vector<uint64_t>().swap(bits_);
+        mode_ = integer_set_mode::sorted;
+        size_ = 0;
+    }
+};
+
+} // namespace sugar
+
+#endif // SPARSE_SET_H_
@@ -0,0 +1,820 @@
+/*
+ * @file test_algorithm.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL algorithm算法库测试
+ */
+
+#include "algorithm.h"
+#include "vector.h"
+#include "functional.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 把原生指针包装成指定类别的迭代器，用于测试前向/双向迭代器路径
+template<typename T, typename Category>
+class tagged_iterator : public sugar::iterator<Category, T> {
+private:
+    T* ptr_;
+
+public:
+    explicit tagged_iterator(T* ptr = nullptr) : ptr_(ptr) {}
+
+    T& operator*() const { return *ptr_; }
+    T* operator->() const { return ptr_; }
+    tagged_iterator& operator++() { ++ptr_; return *this; }
+    tagged_iterator operator++(int) { tagged_iterator tmp = *this; ++ptr_; return tmp; }
+    tagged_iterator& operator--() { --ptr_; return *this; }
+    tagged_iterator operator--(int) { tagged_iterator tmp = *this; --ptr_; return tmp; }
+    bool operator==(const tagged_iterator& other) const { return ptr_ == other.ptr_; }
+    bool operator!=(const tagged_iterator& other) const { return ptr_ != other.ptr_; }
+    T* base() const { return ptr_; }
+};
+
+template<typename T>
+using forward_it = tagged_iterator<T, sugar::forward_iterator_tag>;
+template<typename T>
+using bidirectional_it = tagged_iterator<T, sugar::bidirectional_iterator_tag>;
+
+// 测试函数声明
+void test_heap_algorithms();
+void test_reverse_rotate();
+void test_partition();
+void test_remove_unique();
+void test_shuffle();
+void test_sort_select();
+void test_set_operations();
+void test_search();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Algorithm 测试 ===" << std::endl;
+
+    try {
+        test_heap_algorithms();
+        test_reverse_rotate();
+        test_partition();
+        test_remove_unique();
+        test_shuffle();
+        test_sort_select();
+        test_set_operations();
+        test_search();
+        test_performance();
+
+        std::cout << "\n🎉 All algorithm tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试堆算法
+void test_heap_algorithms() {
+    std::cout << "\n=== 测试堆算法 ===" << std::endl;
+
+    // make_heap / is_heap
+    sugar::vector<int> v = {5, 1, 9, 3, 7, 2, 8, 6, 4, 0};
+    assert(!sugar::is_heap(v.begin(), v.end()));
+    sugar::make_heap(v.begin(), v.end());
+    assert(sugar::is_heap(v.begin(), v.end()));
+    assert(v[0] == 9);
+    std::cout << "✓ make_heap / is_heap" << std::endl;
+
+    // push_heap
+    v.push_back(42);
+    sugar::push_heap(v.begin(), v.end());
+    assert(sugar::is_heap(v.begin(), v.end()));
+    assert(v[0] == 42);
+    std::cout << "✓ push_heap" << std::endl;
+
+    // pop_heap
+    sugar::pop_heap(v.begin(), v.end());
+    assert(v.back() == 42);
+    v.pop_back();
+    assert(sugar::is_heap(v.begin(), v.end()));
+    assert(v[0] == 9);
+    std::cout << "✓ pop_heap" << std::endl;
+
+    // sort_heap
+    sugar::sort_heap(v.begin(), v.end());
+    for (size_t i = 0; i < v.size(); ++i) {
+        assert(v[i] == static_cast<int>(i));
+    }
+    std::cout << "✓ sort_heap" << std::endl;
+
+    // 自定义比较函数（小顶堆）
+    sugar::vector<int> w = {4, 8, 1, 6, 3};
+    sugar::make_heap(w.begin(), w.end(), sugar::greater<int>());
+    assert(w[0] == 1);
+    assert(sugar::is_heap(w.begin(), w.end(), sugar::greater<int>()));
+    sugar::sort_heap(w.begin(), w.end(), sugar::greater<int>());
+    assert(w[0] == 8 && w[4] == 1);
+    std::cout << "✓ 自定义比较函数" << std::endl;
+
+    // is_heap_until
+    int arr[] = {9, 5, 4, 1, 7};
+    assert(sugar::is_heap_until(arr, arr + 5) == arr + 4);
+    std::cout << "✓ is_heap_until" << std::endl;
+
+    // 与std::sort_heap结果对比
+    unsigned int seed = 7;
+    sugar::vector<int> big;
+    std::vector<int> ref;
+    for (int i = 0; i < 2000; ++i) {
+        int x = static_cast<int>(lcg_next(seed) % 500);
+        big.push_back(x);
+        ref.push_back(x);
+        sugar::push_heap(big.begin(), big.end());
+    }
+    assert(sugar::is_heap(big.begin(), big.end()));
+    sugar::sort_heap(big.begin(), big.end());
+    std::sort(ref.begin(), ref.end());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        assert(big[i] == ref[i]);
+    }
+    std::cout << "✓ 随机数据排序结果与std一致" << std::endl;
+}
+
+// 生成随机数据
+template<typename T>
+static std::vector<T> random_data(size_t n, unsigned int seed, unsigned int modulo) {
+    std::vector<T> data(n);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = static_cast<T>(lcg_next(seed) % modulo);
+    }
+    return data;
+}
+
+template<typename T>
+static void check_reverse(size_t n) {
+    std::vector<T> a = random_data<T>(n, static_cast<unsigned int>(n), 120);
+    std::vector<T> b = a;
+    sugar::reverse(a.data(), a.data() + a.size());
+    std::reverse(b.begin(), b.end());
+    assert(a == b);
+}
+
+template<typename T>
+static void check_rotate(size_t n) {
+    for (size_t k = 0; k <= n; k += (n / 7 + 1)) {
+        std::vector<T> a = random_data<T>(n, static_cast<unsigned int>(n + k), 120);
+        std::vector<T> b = a;
+        std::vector<T> c = a;
+        std::vector<T> d = a;
+        T* r = sugar::rotate(a.data(), a.data() + k, a.data() + n);
+        std::rotate(b.begin(), b.begin() + k, b.end());
+        assert(a == b);
+        assert(r == a.data() + (n - k));
+        forward_it<T> fr = sugar::rotate(forward_it<T>(c.data()), forward_it<T>(c.data() + k),
+                                         forward_it<T>(c.data() + n));
+        assert(c == b && fr.base() == c.data() + (n - k));
+        bidirectional_it<T> br = sugar::rotate(bidirectional_it<T>(d.data()), bidirectional_it<T>(d.data() + k),
+                                               bidirectional_it<T>(d.data() + n));
+        assert(d == b && br.base() == d.data() + (n - k));
+    }
+}
+
+// 测试反转与旋转
+void test_reverse_rotate() {
+    std::cout << "\n=== 测试反转与旋转 ===" << std::endl;
+
+    size_t sizes[] = {0, 1, 2, 15, 16, 31, 32, 33, 100, 1001};
+    for (size_t n : sizes) {
+        check_reverse<char>(n);
+        check_reverse<short>(n);
+        check_reverse<int>(n);
+        check_reverse<long long>(n);
+        check_reverse<double>(n);
+    }
+    sugar::vector<std::string> words = {"a", "b", "c", "d"};
+    sugar::reverse(words.begin(), words.end());
+    assert(words[0] == "d" && words[3] == "a");
+    int arr[] = {1, 2, 3, 4, 5};
+    sugar::reverse(bidirectional_it<int>(arr), bidirectional_it<int>(arr + 5));
+    assert(arr[0] == 5 && arr[2] == 3 && arr[4] == 1);
+    std::cout << "✓ reverse（SIMD / 标量 / 双向迭代器）" << std::endl;
+
+    size_t rotate_sizes[] = {1, 2, 10, 200, 1000};
+    for (size_t n : rotate_sizes) {
+        check_rotate<char>(n);
+        check_rotate<int>(n);
+        check_rotate<long long>(n);
+    }
+    sugar::vector<std::string> names = {"a", "b", "c", "d", "e", "f"};
+    std::string* r = sugar::rotate(names.begin(), names.begin() + 4, names.end());
+    assert(names[0] == "e" && names[1] == "f" && names[2] == "a" && r == names.begin() + 2);
+    std::cout << "✓ rotate（memmove / cycle-leader / 前向 / 双向）" << std::endl;
+}
+
+// 测试划分
+void test_partition() {
+    std::cout << "\n=== 测试划分 ===" << std::endl;
+
+    auto is_even = [](int x) { return x % 2 == 0; };
+    size_t sizes[] = {0, 1, 5, 127, 128, 129, 1000, 5000};
+    for (size_t n : sizes) {
+        std::vector<int> a = random_data<int>(n, static_cast<unsigned int>(n) + 1, 1000);
+        std::vector<int> sorted_a = a;
+        std::sort(sorted_a.begin(), sorted_a.end());
+
+        std::vector<int> p = a;
+        int* mid = sugar::partition(p.data(), p.data() + n, is_even);
+        assert(sugar::is_partitioned(p.data(), p.data() + n, is_even));
+        assert(mid - p.data() == std::count_if(a.begin(), a.end(), is_even));
+        std::sort(p.begin(), p.end());
+        assert(p == sorted_a);
+
+        std::vector<int> f = a;
+        forward_it<int> fmid = sugar::partition(forward_it<int>(f.data()), forward_it<int>(f.data() + n), is_even);
+        assert(fmid.base() == f.data() + (mid - p.data()));
+        assert(sugar::is_partitioned(f.data(), f.data() + n, is_even));
+
+        std::vector<int> s = a;
+        std::vector<int> ref = a;
+        int* smid = sugar::stable_partition(s.data(), s.data() + n, is_even);
+        std::stable_partition(ref.begin(), ref.end(), is_even);
+        assert(s == ref);
+        assert(smid - s.data() == mid - p.data());
+
+        if (n > 0) {
+            std::vector<int> sf = a;
+            sugar::stable_partition_inplace(sf.data(), sf.data() + n, is_even, static_cast<ptrdiff_t>(n));
+            assert(sf == ref);
+        }
+    }
+    std::cout << "✓ partition（块划分 / 前向）/ stable_partition（缓冲 / 原地）" << std::endl;
+}
+
+// 测试删除与去重
+void test_remove_unique() {
+    std::cout << "\n=== 测试删除与去重 ===" << std::endl;
+
+    size_t sizes[] = {0, 1, 15, 16, 17, 100, 1000};
+    for (size_t n : sizes) {
+        std::vector<int> a = random_data<int>(n, static_cast<unsigned int>(n) + 2, 8);
+        std::vector<int> b = a;
+        int* e = sugar::remove(a.data(), a.data() + n, 3);
+        std::vector<int>::iterator re = std::remove(b.begin(), b.end(), 3);
+        assert(e - a.data() == re - b.begin());
+        assert(std::equal(a.data(), e, b.begin()));
+
+        std::vector<char> c = random_data<char>(n, static_cast<unsigned int>(n) + 3, 4);
+        std::vector<char> d = c;
+        char* ce = sugar::remove(c.data(), c.data() + n, static_cast<char>(1));
+        std::vector<char>::iterator de = std::remove(d.begin(), d.end(), static_cast<char>(1));
+        assert(ce - c.data() == de - d.begin());
+        assert(std::equal(c.data(), ce, d.begin()));
+
+        std::vector<int> x = random_data<int>(n, static_cast<unsigned int>(n) + 4, 10);
+        std::vector<int> y = x;
+        auto small = [](int v) { return v < 5; };
+        int* xe = sugar::remove_if(x.data(), x.data() + n, small);
+        std::vector<int>::iterator ye = std::remove_if(y.begin(), y.end(), small);
+        assert(xe - x.data() == ye - y.begin());
+        assert(std::equal(x.data(), xe, y.begin()));
+
+        std::vector<int> u = random_data<int>(n, static_cast<unsigned int>(n) + 5, 3);
+        std::vector<int> w = u;
+        int* ue = sugar::unique(u.data(), u.data() + n);
+        std::vector<int>::iterator we = std::unique(w.begin(), w.end());
+        assert(ue - u.data() == we - w.begin());
+        assert(std::equal(u.data(), ue, w.begin()));
+    }
+
+    sugar::vector<std::string> words = {"a", "a", "b", "c", "c", "c", "a"};
+    std::string* end = sugar::unique(words.begin(), words.end());
+    assert(end - words.begin() == 4);
+    assert(words[0] == "a" && words[1] == "b" && words[2] == "c" && words[3] == "a");
+    end = sugar::remove(words.begin(), end, std::string("a"));
+    assert(end - words.begin() == 2 && words[0] == "b");
+
+    // 非传递的谓词：保留每组的第一个元素作为比较基准
+    int arr[] = {1, 2, 3, 10, 11, 20};
+    int* ae = sugar::unique(arr, arr + 6, [](int a, int b) { return b - a < 2; });
+    assert(ae - arr == 4 && arr[0] == 1 && arr[1] == 3 && arr[2] == 10 && arr[3] == 20);
+    std::cout << "✓ remove（SIMD）/ remove_if（无分支）/ unique" << std::endl;
+}
+
+// 测试随机打乱
+void test_shuffle() {
+    std::cout << "\n=== 测试随机打乱 ===" << std::endl;
+
+    std::mt19937 g32(42);
+    std::mt19937_64 g64(42);
+    sugar::vector<int> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    sugar::shuffle(v.begin(), v.end(), g32);
+    sugar::shuffle(v.begin(), v.end(), g64);
+    std::vector<int> sorted(v.begin(), v.end());
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < 1000; ++i) {
+        assert(sorted[i] == i);
+    }
+
+    // 粗略的均匀性检查：3个元素的6种排列都应出现
+    int counts[6] = {0, 0, 0, 0, 0, 0};
+    for (int t = 0; t < 6000; ++t) {
+        int a[] = {0, 1, 2};
+        sugar::shuffle(a, a + 3, g32);
+        counts[a[0] * 2 + (a[1] > a[2] ? 1 : 0)]++;
+    }
+    for (int c : counts) {
+        assert(c > 800 && c < 1200);
+    }
+
+    // 值域小于上界的生成器
+    std::minstd_rand small_range(7);
+    unsigned long long x = sugar::uniform_index(small_range, 1ULL << 40);
+    assert(x < (1ULL << 40));
+    std::cout << "✓ shuffle / uniform_index" << std::endl;
+}
+
+// 生成有序的随机多重集合
+static std::vector<unsigned int> sorted_data(size_t n, unsigned int seed, unsigned int modulo) {
+    std::vector<unsigned int> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = lcg_next(seed) % modulo;
+    }
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+// 生成严格递增的倒排表：相邻元素之差在[1, 2 * gap]内
+static std::vector<unsigned int> posting_list(size_t n, unsigned int seed, unsigned int gap) {
+    std::vector<unsigned int> v(n);
+    unsigned int x = 0;
+    for (size_t i = 0; i < n; ++i) {
+        x += 1 + lcg_next(seed) % (2 * gap);
+        v[i] = x;
+    }
+    return v;
+}
+
+// 对一组输入检查所有集合算法与std一致
+static void check_set_operations(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b) {
+    const unsigned int* a0 = a.data();
+    const unsigned int* a1 = a0 + a.size();
+    const unsigned int* b0 = b.data();
+    const unsigned int* b1 = b0 + b.size();
+    std::vector<unsigned int> expected;
+    std::vector<unsigned int> out(a.size() + b.size() + 1);
+
+    expected.clear();
+    std::set_intersection(a0, a1, b0, b1, std::back_inserter(expected));
+    unsigned int* e = sugar::set_intersection(a0, a1, b0, b1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+    assert(sugar::set_intersection_count(a0, a1, b0, b1) == expected.size());
+    forward_it<const unsigned int> fa0(a0), fa1(a1), fb0(b0), fb1(b1);
+    e = sugar::set_intersection(fa0, fa1, fb0, fb1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+
+    expected.clear();
+    std::set_union(a0, a1, b0, b1, std::back_inserter(expected));
+    e = sugar::set_union(a0, a1, b0, b1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+    assert(sugar::set_union_count(a0, a1, b0, b1) == expected.size());
+    e = sugar::set_union(fa0, fa1, fb0, fb1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+
+    expected.clear();
+    std::set_difference(a0, a1, b0, b1, std::back_inserter(expected));
+    e = sugar::set_difference(a0, a1, b0, b1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+    assert(sugar::set_difference_count(a0, a1, b0, b1) == expected.size());
+    e = sugar::set_difference(fa0, fa1, fb0, fb1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+
+    expected.clear();
+    std::set_symmetric_difference(a0, a1, b0, b1, std::back_inserter(expected));
+    e = sugar::set_symmetric_difference(a0, a1, b0, b1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+    assert(sugar::set_symmetric_difference_count(a0, a1, b0, b1) == expected.size());
+    e = sugar::set_symmetric_difference(fa0, fa1, fb0, fb1, out.data());
+    assert(std::vector<unsigned int>(out.data(), e) == expected);
+
+    assert(sugar::includes(a0, a1, b0, b1) == std::includes(a0, a1, b0, b1));
+    assert(sugar::includes(b0, b1, a0, a1) == std::includes(b0, b1, a0, a1));
+    assert(sugar::includes(fa0, fa1, fb0, fb1) == std::includes(a0, a1, b0, b1));
+}
+
+// 测试有序区间算法
+void test_set_operations() {
+    std::cout << "\n=== 测试有序区间算法 ===" << std::endl;
+
+    int arr[] = {1, 2, 2, 2, 5, 7, 9};
+    assert(sugar::lower_bound(arr, arr + 7, 2) == arr + 1);
+    assert(sugar::upper_bound(arr, arr + 7, 2) == arr + 4);
+    assert(sugar::lower_bound(arr, arr + 7, 10) == arr + 7);
+    assert(sugar::upper_bound(arr, arr + 7, 0) == arr);
+    assert(sugar::binary_search(arr, arr + 7, 5));
+    assert(!sugar::binary_search(arr, arr + 7, 6));
+    forward_it<int> f0(arr), f1(arr + 7);
+    assert(sugar::lower_bound(f0, f1, 5).base() == arr + 4);
+    for (int v = 0; v <= 10; ++v) {
+        assert(sugar::gallop_lower_bound(arr, arr + 7, v, sugar::less<int>()) == std::lower_bound(arr, arr + 7, v));
+    }
+    std::cout << "✓ lower_bound / upper_bound / binary_search / gallop_lower_bound" << std::endl;
+
+    // 含重复元素的多重集合，大小比例覆盖线性归并与galloping两条路径
+    const size_t sizes[] = {0, 1, 3, 10, 50, 1000, 5000};
+    unsigned int seed = 1;
+    for (size_t n1 : sizes) {
+        for (size_t n2 : sizes) {
+            check_set_operations(sorted_data(n1, seed, 200), sorted_data(n2, seed + 1, 200));
+            check_set_operations(sorted_data(n1, seed + 2, 100000), sorted_data(n2, seed + 3, 100000));
+            seed += 4;
+        }
+    }
+    // 子集关系成立的情况
+    std::vector<unsigned int> big = sorted_data(10000, 99, 50);
+    std::vector<unsigned int> sub;
+    for (size_t i = 0; i < big.size(); i += 97) {
+        sub.push_back(big[i]);
+    }
+    assert(sugar::includes(big.data(), big.data() + big.size(), sub.data(), sub.data() + sub.size()));
+    std::cout << "✓ 多重集合语义与std一致（线性归并 / galloping / 前向迭代器）" << std::endl;
+
+    // 严格递增的倒排表走SIMD块求交
+    for (unsigned int gap = 1; gap <= 64; gap *= 4) {
+        std::vector<unsigned int> a = posting_list(3000, gap, gap);
+        std::vector<unsigned int> b = posting_list(2000 + gap, gap + 1, gap);
+        check_set_operations(a, b);
+    }
+    sugar::vector<unsigned int> pa;
+    sugar::vector<unsigned int> pb;
+    for (unsigned int i = 0; i < 100; ++i) {
+        pa.push_back(i * 2);
+        pb.push_back(i * 3);
+    }
+    assert(sugar::set_intersection_count(pa.begin(), pa.end(), pb.begin(), pb.end()) == 34);
+    std::cout << "✓ uint32 SIMD块求交 / 计数版本" << std::endl;
+}
+
+// 测试子串查找
+void test_search() {
+    std::cout << "\n=== 测试子串查找 ===" << std::endl;
+
+    const char* text = "the quick brown fox jumps over the lazy dog";
+    const char* t_end = text + std::strlen(text);
+    const char* word = "the";
+    assert(sugar::search(text, t_end, word, word + 3) == text);
+    assert(sugar::find_end(text, t_end, word, word + 3) == text + 31);
+    const char* none = "cat";
+    assert(sugar::search(text, t_end, none, none + 3) == t_end);
+    assert(sugar::search(text, t_end, none, none) == text);
+    assert(sugar::find_end(text, t_end, none, none) == t_end);
+    std::cout << "✓ search / find_end 基本用法" << std::endl;
+
+    // 小字母表上的随机串，覆盖memchr / SIMD预过滤 / Horspool / 各种长度的边界
+    unsigned int seed = 3;
+    for (int round = 0; round < 300; ++round) {
+        size_t n = lcg_next(seed) % 600;
+        size_t m = lcg_next(seed) % 100;
+        unsigned int alphabet = 1 + lcg_next(seed) % 4;
+        std::string h(n, 'a');
+        std::string pat(m, 'a');
+        for (size_t i = 0; i < n; ++i) {
+            h[i] = static_cast<char>('a' + lcg_next(seed) % alphabet);
+        }
+        // 一半的模式取自文本本身，保证能找到
+        if (m <= n && round % 2 == 0) {
+            pat = h.substr(lcg_next(seed) % (n - m + 1), m);
+        } else {
+            for (size_t i = 0; i < m; ++i) {
+                pat[i] = static_cast<char>('a' + lcg_next(seed) % alphabet);
+            }
+        }
+        const char* h0 = h.data();
+        const char* h1 = h0 + n;
+        const char* p0 = pat.data();
+        const char* p1 = p0 + m;
+        assert(sugar::search(h0, h1, p0, p1) == std::search(h0, h1, p0, p1));
+        assert(sugar::find_end(h0, h1, p0, p1) == std::find_end(h0, h1, p0, p1));
+        sugar::two_way_searcher<const char*> two_way(p0, p1);
+        assert(sugar::search(h0, h1, two_way) == std::search(h0, h1, p0, p1));
+        forward_it<const char> f0(h0), f1(h1), fp0(p0), fp1(p1);
+        assert(sugar::search(f0, f1, fp0, fp1).base() == std::search(h0, h1, p0, p1));
+        assert(sugar::find_end(f0, f1, fp0, fp1).base() == std::find_end(h0, h1, p0, p1));
+
+        size_t count = lcg_next(seed) % 6;
+        assert(sugar::search_n(h0, h1, count, 'a') == std::search_n(h0, h1, count, 'a'));
+        assert(sugar::search_n(f0, f1, count, 'b').base() == std::search_n(h0, h1, count, 'b'));
+    }
+    std::cout << "✓ search / find_end / search_n 与std一致（字节与前向迭代器）" << std::endl;
+
+    // 病态输入：预过滤和Horspool的验证量超出预算后改用Two-Way
+    for (size_t m : {8, 40, 100, 300}) {
+        std::string h(200000, 'a');
+        std::string pat(m, 'a');
+        pat[0] = 'b';
+        const char* h0 = h.data();
+        const char* h1 = h0 + h.size();
+        assert(sugar::search(h0, h1, pat.data(), pat.data() + m) == h1);
+        pat[0] = 'a';
+        pat[m - 1] = 'b';
+        assert(sugar::search(h0, h1, pat.data(), pat.data() + m) == h1);
+        h[150000] = 'b';
+        assert(sugar::search(h0, h1, pat.data(), pat.data() + m) == h0 + 150000 - (m - 1));
+    }
+    std::cout << "✓ 病态输入退回Two-Way" << std::endl;
+
+    // 非字节类型与自定义谓词
+    int arr[] = {1, 2, 3, 1, 2, 3, 4};
+    int pat_arr[] = {1, 2, 3};
+    assert(sugar::search(arr, arr + 7, pat_arr, pat_arr + 3) == arr);
+    assert(sugar::find_end(arr, arr + 7, pat_arr, pat_arr + 3) == arr + 3);
+    assert(sugar::search_n(arr, arr + 7, 2, 3, [](int a, int b) { return a >= b; }) == arr + 5);
+    sugar::default_searcher<int*> searcher(pat_arr + 1, pat_arr + 3);
+    sugar::pair<int*, int*> match = searcher(arr + 2, arr + 7);
+    assert(match.first == arr + 4 && match.second == arr + 6);
+    std::cout << "✓ 通用迭代器 / 自定义谓词 / default_searcher" << std::endl;
+}
+
+// 测试排序与选择
+void test_sort_select() {
+    std::cout << "\n=== 测试排序与选择 ===" << std::endl;
+
+    // 随机、大量重复、有序、逆序、管风琴形输入
+    for (size_t n = 0; n < 2000; n = n * 3 / 2 + 1) {
+        for (int shape = 0; shape < 5; ++shape) {
+            std::vector<int> a = random_data<int>(n, static_cast<unsigned int>(n * 7 + shape), shape == 1 ? 3 : 100000);
+            if (shape == 2) {
+                std::sort(a.begin(), a.end());
+            } else if (shape == 3) {
+                std::sort(a.begin(), a.end(), std::greater<int>());
+            } else if (shape == 4) {
+                for (size_t i = 0; i < n; ++i) {
+                    a[i] = static_cast<int>(i < n / 2 ? i : n - i);
+                }
+            }
+            std::vector<int> ref = a;
+            std::sort(ref.begin(), ref.end());
+
+            std::vector<int> s = a;
+            sugar::sort(s.data(), s.data() + n);
+            assert(s == ref);
+            assert(sugar::is_sorted(s.data(), s.data() + n));
+
+            for (size_t nth = 0; nth < n; nth += n / 7 + 1) {
+                std::vector<int> e = a;
+                sugar::nth_element(e.data(), e.data() + nth, e.data() + n);
+                assert(e[nth] == ref[nth]);
+                for (size_t i = 0; i < n; ++i) {
+                    assert(i < nth ? e[i] <= e[nth] : e[i] >= e[nth]);
+                }
+
+                std::vector<int> p = a;
+                sugar::partial_sort(p.data(), p.data() + nth, p.data() + n);
+                assert(std::equal(p.begin(), p.begin() + nth, ref.begin()));
+            }
+        }
+    }
+    std::cout << "✓ sort / nth_element / partial_sort 与std一致" << std::endl;
+
+    // 自定义比较函数，按降序
+    sugar::vector<int> v = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+    sugar::sort(v.begin(), v.end(), sugar::greater<int>());
+    assert(sugar::is_sorted(v.begin(), v.end(), sugar::greater<int>()));
+    assert(v[0] == 9 && v[10] == 1);
+    assert(sugar::is_sorted_until(v.begin(), v.end()) == v.begin() + 1);
+    std::cout << "✓ 自定义比较函数 / is_sorted_until" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static long long time_us(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：与std对比
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = 4000000;
+    std::vector<int> base = random_data<int>(n, 123, 1000);
+    std::vector<int> a;
+    std::vector<int> b;
+    auto report = [](const char* name, long long us_sugar, long long us_std) {
+        std::cout << name << ": sugar " << us_sugar << " us, std " << us_std << " us" << std::endl;
+    };
+
+    a = base; b = base;
+    report("partition     ",
+           time_us([&] { sugar::partition(a.data(), a.data() + n, [](int x) { return x < 500; }); }),
+           time_us([&] { std::partition(b.begin(), b.end(), [](int x) { return x < 500; }); }));
+
+    a = base; b = base;
+    report("stable_part.  ",
+           time_us([&] { sugar::stable_partition(a.data(), a.data() + n, [](int x) { return x < 500; }); }),
+           time_us([&] { std::stable_partition(b.begin(), b.end(), [](int x) { return x < 500; }); }));
+
+    a = base; b = base;
+    report("remove        ",
+           time_us([&] { sugar::remove(a.data(), a.data() + n, 7); }),
+           time_us([&] { std::remove(b.begin(), b.end(), 7); }));
+
+    a = base; b = base;
+    report("remove_if     ",
+           time_us([&] { sugar::remove_if(a.data(), a.data() + n, [](int x) { return x < 500; }); }),
+           time_us([&] { std::remove_if(b.begin(), b.end(), [](int x) { return x < 500; }); }));
+
+    a = base; b = base;
+    report("unique        ",
+           time_us([&] { sugar::unique(a.data(), a.data() + n); }),
+           time_us([&] { std::unique(b.begin(), b.end()); }));
+
+    a = base; b = base;
+    report("reverse       ",
+           time_us([&] { sugar::reverse(a.data(), a.data() + n); }),
+           time_us([&] { std::reverse(b.begin(), b.end()); }));
+
+    a = base; b = base;
+    report("sort          ",
+           time_us([&] { sugar::sort(a.data(), a.data() + n); }),
+           time_us([&] { std::sort(b.begin(), b.end()); }));
+    assert(a == b);
+
+    a = base; b = base;
+    report("nth_element   ",
+           time_us([&] { sugar::nth_element(a.data(), a.data() + n / 2, a.data() + n); }),
+           time_us([&] { std::nth_element(b.begin(), b.begin() + n / 2, b.end()); }));
+    assert(a[n / 2] == b[n / 2]);
+    assert(a == b);
+
+    a = base; b = base;
+    report("rotate (k=37) ",
+           time_us([&] { sugar::rotate(a.data(), a.data() + 37, a.data() + n); }),
+           time_us([&] { std::rotate(b.begin(), b.begin() + 37, b.end()); }));
+    assert(a == b);
+
+    a = base; b = base;
+    report("rotate (n/3)  ",
+           time_us([&] { sugar::rotate(a.data(), a.data() + n / 3, a.data() + n); }),
+           time_us([&] { std::rotate(b.begin(), b.begin() + n / 3, b.end()); }));
+    assert(a == b);
+
+    std::mt19937_64 g1(1);
+    std::mt19937_64 g2(1);
+    a = base; b = base;
+    report("shuffle       ",
+           time_us([&] { sugar::shuffle(a.data(), a.data() + n, g1); }),
+           time_us([&] { std::shuffle(b.begin(), b.end(), g2); }));
+    std::cout << "✓ " << n << " 个int" << std::endl;
+
+    // 倒排表求交：大表固定为1M个元素，小表按比例缩小
+    const size_t big_n = 1000000;
+    std::vector<unsigned int> big = posting_list(big_n, 5, 8);
+    std::vector<unsigned int> out(2 * big_n);
+    const size_t ratios[] = {1, 10, 100, 1000, 10000};
+    for (size_t ratio : ratios) {
+        std::vector<unsigned int> small = posting_list(big_n / ratio, 6, static_cast<unsigned int>(8 * ratio));
+        const unsigned int* s0 = small.data();
+        const unsigned int* s1 = s0 + small.size();
+        const unsigned int* g0 = big.data();
+        const unsigned int* g1 = g0 + big.size();
+        const int rounds = 10;
+        size_t sugar_n = 0;
+        size_t count_n = 0;
+        size_t std_n = 0;
+        long long us_sugar = time_us([&] {
+            for (int r = 0; r < rounds; ++r) {
+                sugar_n = sugar::set_intersection(s0, s1, g0, g1, out.data()) - out.data();
+            }
+        });
+        long long us_count = time_us([&] {
+            for (int r = 0; r < rounds; ++r) {
+                count_n = sugar::set_intersection_count(s0, s1, g0, g1);
+            }
+        });
+        long long us_std = time_us([&] {
+            for (int r = 0; r < rounds; ++r) {
+                std_n = std::set_intersection(s0, s1, g0, g1, out.data()) - out.data();
+            }
+        });
+        assert(sugar_n == std_n && count_n == std_n);
+        std::cout << "set_intersection 1:" << ratio << ": sugar " << us_sugar / rounds << " us, count "
+                  << us_count / rounds << " us, std " << us_std / rounds << " us" << std::endl;
+
+        long long us_union = time_us([&] {
+            for (int r = 0; r < rounds; ++r) {
+                sugar::set_union(s0, s1, g0, g1, out.data());
+            }
+        });
+        long long us_std_union = time_us([&] {
+            for (int r = 0; r < rounds; ++r) {
+                std::set_union(s0, s1, g0, g1, out.data());
+            }
+        });
+        long long us_diff = time_us([&] {
+            for (int r = 0; r < rounds; ++r) {
+                sugar::set_difference(g0, g1, s0, s1, out.data());
+            }
+        });
+        long long us_std_diff = time_us([&] {
+            for (int r = 0; r < rounds; ++r) {
+                std::set_difference(g0, g1, s0, s1, out.data());
+            }
+        });
+        std::cout << "  set_union: sugar " << us_union / rounds << " us, std " << us_std_union / rounds
+                  << " us; set_difference: sugar " << us_diff / rounds << " us, std " << us_std_diff / rounds
+                  << " us" << std::endl;
+    }
+    std::cout << "✓ 1:1 到 1:10000 的倒排表集合运算" << std::endl;
+
+    // 日志检索：生成约32MB的合成日志，统计每个关键字的出现次数
+    static const char* const levels[] = {"INFO ", "DEBUG", "WARN ", "ERROR"};
+    static const char* const messages[] = {
+        "request completed in 12ms path=/api/v1/items status=200",
+        "cache miss for key session:8f2a91c4 falling back to database",
+        "connection reset by peer while reading response body",
+        "scheduled job nightly-compaction finished, 3 segments merged",
+        "slow query detected: SELECT * FROM orders WHERE user_id=42 took 870ms",
+    };
+    sugar::vector<char> log;
+    log.reserve(33 << 20);
+    unsigned int log_seed = 77;
+    char line[256];
+    while (log.size() < (32u << 20)) {
+        int len = std::snprintf(line, sizeof(line), "2026-10-18T12:%02u:%02u.%03uZ [%s] worker-%u %s\n",
+                                lcg_next(log_seed) % 60, lcg_next(log_seed) % 60, lcg_next(log_seed) % 1000,
+                                levels[lcg_next(log_seed) % 4], lcg_next(log_seed) % 64,
+                                messages[lcg_next(log_seed) % 5]);
+        for (int i = 0; i < len; ++i) {
+            log.push_back(line[i]);
+        }
+    }
+    const char* log0 = log.data();
+    const char* log1 = log0 + log.size();
+    const double log_bytes = static_cast<double>(log.size());
+    static const char* const needles[] = {
+        "Z",
+        "ERROR",
+        "connection reset by peer",
+        "user_id=4242",
+        "nightly-compaction finished, 3 segments merged while reading response body from upstream",
+    };
+    for (const char* needle : needles) {
+        const char* n0 = needle;
+        const char* n1 = needle + std::strlen(needle);
+        size_t sugar_hits = 0;
+        size_t std_hits = 0;
+        long long us_sugar = time_us([&] {
+            sugar::byte_searcher searcher(n0, n1);
+            for (const char* it = log0; (it = sugar::search(it, log1, searcher)) != log1; ++it) {
+                ++sugar_hits;
+            }
+        });
+        long long us_std = time_us([&] {
+            for (const char* it = log0; (it = std::search(it, log1, n0, n1)) != log1; ++it) {
+                ++std_hits;
+            }
+        });
+        assert(sugar_hits == std_hits);
+        std::cout << "search \"" << std::string(n0, n1 - n0 > 24 ? n0 + 24 : n1) << (n1 - n0 > 24 ? "..." : "")
+                  << "\" (" << sugar_hits << " 处): sugar " << log_bytes / (us_sugar + 1) / 1e3 << " GB/s, std "
+                  << log_bytes / (us_std + 1) / 1e3 << " GB/s" << std::endl;
+    }
+
+    // 病态输入：std::search为O(nm)，sugar::search退回Two-Way后保持线性
+    std::string worst(4 << 20, 'a');
+    std::string worst_pat(64, 'a');
+    worst_pat[0] = 'b';
+    worst_pat.back() = 'a';
+    std::string worst_pat2(40, 'a');
+    worst_pat2.back() = 'b';
+    long long us_worst = time_us([&] {
+        assert(sugar::search(worst.data(), worst.data() + worst.size(), worst_pat.data(), worst_pat.data() + 64) ==
+               worst.data() + worst.size());
+        assert(sugar::search(worst.data(), worst.data() + worst.size(), worst_pat2.data(), worst_pat2.data() + 40) ==
+               worst.data() + worst.size());
+    });
+    long long us_worst_std = time_us([&] {
+        assert(std::search(worst.data(), worst.data() + worst.size(), worst_pat2.data(), worst_pat2.data() + 40) ==
+               worst.data() + worst.size());
+    });
+    std::cout << "search 病态输入 (4MB \"aaa...\"): sugar " << us_worst << " us (两个模式), std " << us_worst_std
+              << " us (一个模式)" << std::endl;
+    std::cout << "✓ " << log.size() / (1 << 20) << "MB 日志检索" << std::endl;
+}
@@ -0,0 +1,467 @@
+/*
+ * @file test_art_map.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 自适应基数树测试
+ */
+
+#include "art_map.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+static uint64_t random_u64(unsigned int& state) {
+    uint64_t v = 0;
+    for (int i = 0; i < 5; ++i) {
+        v = (v << 15) ^ lcg_next(state);
+    }
+    return v;
+}
+
+// 逐个比较art_map与std::map的内容与顺序，并双向遍历
+template<typename Key, typename T>
+static void check_same(const sugar::art_map<Key, T>& art, const std::map<Key, T>& ref) {
+    assert(art.size() == ref.size());
+    typename std::map<Key, T>::const_iterator r = ref.begin();
+    for (typename sugar::art_map<Key, T>::const_iterator it = art.begin(); it != art.end(); ++it, ++r) {
+        assert(it->first == r->first && it->second == r->second);
+    }
+    assert(r == ref.end());
+    typename std::map<Key, T>::const_reverse_iterator rr = ref.rbegin();
+    for (typename sugar::art_map<Key, T>::const_iterator it = art.end(); it != art.begin(); ++rr) {
+        --it;
+        assert(it->first == rr->first);
+    }
+}
+
+// 测试函数声明
+void test_integer_keys();
+void test_string_keys();
+void test_node_growth();
+void test_random_against_map();
+void test_bounds_and_prefix();
+void test_copy_and_move();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL ART Map 测试 ===" << std::endl;
+
+    try {
+        test_integer_keys();
+        test_string_keys();
+        test_node_growth();
+        test_random_against_map();
+        test_bounds_and_prefix();
+        test_copy_and_move();
+        test_performance();
+
+        std::cout << "\n🎉 All art_map tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试整数键
+void test_integer_keys() {
+    std::cout << "\n=== 测试整数键 ===" << std::endl;
+
+    sugar::art_map<uint64_t, int> m;
+    assert(m.empty() && m.begin() == m.end() && m.find(1) == m.end());
+    assert(m.insert(sugar::pair<const uint64_t, int>(5, 50)).second);
+    assert(!m.insert(sugar::pair<const uint64_t, int>(5, 51)).second);
+    assert(m.at(5) == 50 && m.size() == 1);
+    m[7] = 70;
+    m[0xffffffffffffffffull] = -1;
+    m[0] = 0;
+    assert(m.size() == 4 && m.contains(7) && !m.contains(6) && m.count(0) == 1);
+    bool thrown = false;
+    try {
+        m.at(6);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(m.begin()->first == 0 && (--m.end())->first == 0xffffffffffffffffull);
+    assert(!m.insert_or_assign(7, 71).second && m.at(7) == 71);
+    assert(m.try_emplace(8, 80).second && !m.try_emplace(8, 81).second && m.at(8) == 80);
+    std::cout << "✓ 插入、查找、at、operator[]、insert_or_assign、try_emplace" << std::endl;
+
+    // 有符号键：翻转符号位后负数排在前面
+    sugar::art_map<int32_t, int> s;
+    const int32_t values[] = {3, -1, 0, -2147483647 - 1, 2147483647, -100, 100};
+    for (int32_t v : values) {
+        s[v] = v;
+    }
+    int32_t prev = 0;
+    bool first = true;
+    for (sugar::art_map<int32_t, int>::iterator it = s.begin(); it != s.end(); ++it) {
+        assert(first || prev < it->first);
+        prev = it->first;
+        first = false;
+    }
+    assert(s.begin()->first == -2147483647 - 1 && s.size() == 7);
+    std::cout << "✓ 有符号整数按数值顺序遍历" << std::endl;
+
+    assert(m.erase(5) == 1 && m.erase(5) == 0 && !m.contains(5));
+    sugar::art_map<uint64_t, int>::iterator next = m.erase(m.find(7));
+    assert(next->first == 8 && m.size() == 3);
+    m.clear();
+    assert(m.empty() && m.begin() == m.end() && m.memory_bytes() == 0);
+    m[1] = 1;
+    assert(m.size() == 1 && m.at(1) == 1);
+    std::cout << "✓ 删除与清空" << std::endl;
+}
+
+// 测试字符串键
+void test_string_keys() {
+    std::cout << "\n=== 测试字符串键 ===" << std::endl;
+
+    // 互为前缀的键、空键、含'\0'的键与超过8字节的公共前缀
+    sugar::art_map<std::string, int> m;
+    std::map<std::string, int> ref;
+    const char* words[] = {"a", "ab", "abc", "abcd", "", "b", "abd", "international", "internationalization",
+                           "internationally", "internal", "intern", "in", "z"};
+    int i = 0;
+    for (const char* w : words) {
+        m[w] = i;
+        ref[w] = i;
+        ++i;
+    }
+    m[std::string("a\0b", 3)] = 100;
+    ref[std::string("a\0b", 3)] = 100;
+    check_same(m, ref);
+    assert(m.at("") == 4 && m.at("intern") == 11 && !m.contains("inter") && !m.contains("internationalizatio"));
+    assert(!m.contains("internationalizationx") && !m.contains("abcde"));
+    std::cout << "✓ 前缀键、空键、含零字节的键有序存储" << std::endl;
+
+    // 逐个删除，每一步都与std::map一致
+    for (const char* w : words) {
+        assert(m.erase(w) == 1);
+        ref.erase(w);
+        check_same(m, ref);
+        for (std::map<std::string, int>::const_iterator it = ref.begin(); it != ref.end(); ++it) {
+            assert(m.at(it->first) == it->second);
+        }
+    }
+    assert(m.size() == 1 && m.erase(std::string("a\0b", 3)) == 1 && m.empty());
+    std::cout << "✓ 删除后路径合并正确" << std::endl;
+
+    // 长公共前缀在中间分裂
+    sugar::art_map<std::string, int> urls;
+    urls["https://example.com/a/b/c/d"] = 1;
+    urls["https://example.com/a/b/c/e"] = 2;
+    urls["https://example.org/"] = 3;
+    urls["https://"] = 4;
+    urls["http://example.com/"] = 5;
+    assert(urls.at("https://example.com/a/b/c/d") == 1 && urls.at("https://") == 4 && urls.size() == 5);
+    assert(urls.begin()->first == "http://example.com/");
+    assert(urls.erase("https://example.org/") == 1 && urls.erase("https://") == 1);
+    assert(urls.at("https://example.com/a/b/c/e") == 2 && !urls.contains("https://example.com/a/b/c/"));
+    std::cout << "✓ 超过8字节的压缩路径分裂与合并" << std::endl;
+}
+
+// 测试节点在Node4/16/48/256之间伸缩
+void test_node_growth() {
+    std::cout << "\n=== 测试节点伸缩 ===" << std::endl;
+
+    sugar::art_map<uint16_t, int> m;
+    std::map<uint16_t, int> ref;
+    // 同一高字节下的低字节依次增加，经过4、16、48、256的每个边界
+    for (int b = 0; b < 256; ++b) {
+        const uint16_t key = static_cast<uint16_t>(0x1200 | ((b * 37) & 0xff));
+        m[key] = b;
+        ref[key] = b;
+        if (b == 3 || b == 4 || b == 15 || b == 16 || b == 47 || b == 48 || b == 255) {
+            check_same(m, ref);
+        }
+    }
+    for (int b = 0; b < 256; ++b) {
+        assert(m.at(static_cast<uint16_t>(0x1200 | b)) == ref[static_cast<uint16_t>(0x1200 | b)]);
+    }
+    // 再逐个删除，经过256→48→16→4的缩小
+    for (int b = 255; b >= 0; --b) {
+        const uint16_t key = static_cast<uint16_t>(0x1200 | ((b * 37) & 0xff));
+        assert(m.erase(key) == 1);
+        ref.erase(key);
+        if (b % 5 == 0 || b < 4) {
+            check_same(m, ref);
+        }
+    }
+    assert(m.empty());
+    std::cout << "✓ 增长到Node256再缩回，内容始终一致" << std::endl;
+}
+
+// 随机插入删除，与std::map对比
+void test_random_against_map() {
+    std::cout << "\n=== 测试随机操作 ===" << std::endl;
+
+    unsigned int seed = 11;
+    sugar::art_map<uint32_t, uint32_t> m;
+    std::map<uint32_t, uint32_t> ref;
+    for (int i = 0; i < 100000; ++i) {
+        // 键空间较小，让插入与删除频繁命中
+        const uint32_t key = static_cast<uint32_t>(random_u64(seed) % 20000) * 2654435761u;
+        if (lcg_next(seed) % 3 == 0) {
+            assert(m.erase(key) == ref.erase(key));
+        } else {
+            m[key] = static_cast<uint32_t>(i);
+            ref[key] = static_cast<uint32_t>(i);
+        }
+    }
+    check_same(m, ref);
+
+    sugar::art_map<std::string, int> s;
+    std::map<std::string, int> sref;
+    const char alphabet[] = "ab/c";
+    for (int i = 0; i < 50000; ++i) {
+        std::string key;
+        const unsigned len = lcg_next(seed) % 12;
+        for (unsigned j = 0; j < len; ++j) {
+            key.push_back(alphabet[lcg_next(seed) % 4]);
+        }
+        if (lcg_next(seed) % 3 == 0) {
+            assert(s.erase(key) == sref.erase(key));
+        } else {
+            s[key] = i;
+            sref[key] = i;
+        }
+    }
+    check_same(s, sref);
+    std::cout << "✓ 10万次整数操作与5万次字符串操作后与std::map一致（" << m.size() << " / " << s.size() << " 个元素）"
+              << std::endl;
+}
+
+// 测试lower_bound、upper_bound与前缀区间
+void test_bounds_and_prefix() {
+    std::cout << "\n=== 测试范围查询 ===" << std::endl;
+
+    unsigned int seed = 3;
+    sugar::art_map<uint64_t, int> m;
+    std::map<uint64_t, int> ref;
+    for (int i = 0; i < 5000; ++i) {
+        const uint64_t key = random_u64(seed) % 100000;
+        m[key] = i;
+        ref[key] = i;
+    }
+    for (int i = 0; i < 20000; ++i) {
+        const uint64_t key = random_u64(seed) % 100100;
+        sugar::art_map<uint64_t, int>::iterator lb = m.lower_bound(key);
+        std::map<uint64_t, int>::iterator rlb = ref.lower_bound(key);
+        assert(rlb == ref.end() ? lb == m.end() : lb->first == rlb->first);
+        sugar::art_map<uint64_t, int>::iterator ub = m.upper_bound(key);
+        std::map<uint64_t, int>::iterator rub = ref.upper_bound(key);
+        assert(rub == ref.end() ? ub == m.end() : ub->first == rub->first);
+    }
+    std::cout << "✓ 整数键 lower_bound / upper_bound 与std::map一致" << std::endl;
+
+    sugar::art_map<std::string, int> s;
+    std::map<std::string, int> sref;
+    const char alphabet[] = "abcxyz/";
+    for (int i = 0; i < 5000; ++i) {
+        std::string key;
+        const unsigned len = 1 + lcg_next(seed) % 14;
+        for (unsigned j = 0; j < len; ++j) {
+            key.push_back(alphabet[lcg_next(seed) % 7]);
+        }
+        s[key] = i;
+        sref[key] = i;
+    }
+    for (int i = 0; i < 5000; ++i) {
+        std::string key;
+        const unsigned len = lcg_next(seed) % 8;
+        for (unsigned j = 0; j < len; ++j) {
+            key.push_back(alphabet[lcg_next(seed) % 7]);
+        }
+        sugar::art_map<std::string, int>::iterator lb = s.lower_bound(key);
+        std::map<std::string, int>::iterator rlb = sref.lower_bound(key);
+        assert(rlb == sref.end() ? lb == s.end() : lb->first == rlb->first);
+
+        // 前缀区间与std::map上逐个判断前缀的结果相同
+        sugar::pair<sugar::art_map<std::string, int>::iterator, sugar::art_map<std::string, int>::iterator> range =
+            s.prefix_range(key);
+        size_t expected = 0;
+        for (std::map<std::string, int>::iterator it = rlb; it != sref.end() && it->first.compare(0, key.size(), key) == 0;
+             ++it) {
+            ++expected;
+        }
+        size_t got = 0;
+        for (sugar::art_map<std::string, int>::iterator it = range.first; it != range.second; ++it) {
+            assert(it->first.compare(0, key.size(), key) == 0);
+            ++got;
+        }
+        assert(got == expected);
+    }
+    sugar::pair<sugar::art_map<std::string, int>::iterator, sugar::art_map<std::string, int>::iterator> all =
+        s.prefix_range("");
+    assert(all.first == s.begin() && all.second == s.end());
+    std::cout << "✓ 字符串键 lower_bound 与 prefix_range 正确" << std::endl;
+}
+
+// 测试拷贝、移动与交换
+void test_copy_and_move() {
+    std::cout << "\n=== 测试拷贝与移动 ===" << std::endl;
+
+    sugar::art_map<std::string, std::string> a;
+    a["x"] = "1";
+    a["xy"] = "2";
+    a["y"] = "3";
+    sugar::art_map<std::string, std::string> b(a);
+    b["z"] = "4";
+    assert(a.size() == 3 && b.size() == 4 && b.at("xy") == "2");
+
+    sugar::art_map<std::string, std::string> c(sugar::move(b));
+    assert(b.empty() && b.begin() == b.end() && c.size() == 4 && (--c.end())->first == "z");
+    b["q"] = "5";
+    assert(b.size() == 1);
+
+    sugar::art_map<std::string, std::string> empty;
+    c.swap(empty);
+    assert(c.empty() && c.begin() == c.end() && empty.size() == 4 && empty.begin()->first == "x");
+    a = empty;
+    assert(a.size() == 4 && a.at("z") == "4");
+    a = sugar::art_map<std::string, std::string>();
+    assert(a.empty());
+    std::cout << "✓ 拷贝、移动、交换后链表哨兵正确" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = 1000000;
+    unsigned int seed = 7;
+    sugar::vector<uint64_t> keys;
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back(random_u64(seed));
+    }
+
+    sugar::art_map<uint64_t, uint64_t> art;
+    std::map<uint64_t, uint64_t> tree;
+    std::unordered_map<uint64_t, uint64_t> hashed;
+    double art_insert = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            art[keys[i]] = i;
+        }
+    });
+    double tree_insert = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            tree[keys[i]] = i;
+        }
+    });
+    double hash_insert = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            hashed[keys[i]] = i;
+        }
+    });
+    uint64_t sum = 0;
+    double art_find = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            sum += art.find(keys[i])->second;
+        }
+    });
+    double tree_find = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            sum += tree.find(keys[i])->second;
+        }
+    });
+    double hash_find = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            sum += hashed.find(keys[i])->second;
+        }
+    });
+    double art_scan = seconds([&] {
+        for (sugar::art_map<uint64_t, uint64_t>::iterator it = art.begin(); it != art.end(); ++it) {
+            sum += it->second;
+        }
+    });
+    double tree_scan = seconds([&] {
+        for (std::map<uint64_t, uint64_t>::iterator it = tree.begin(); it != tree.end(); ++it) {
+            sum += it->second;
+        }
+    });
+    std::cout << "uint64 插入: art " << n / art_insert / 1e6 << " M/s, map " << n / tree_insert / 1e6
+              << " M/s, unordered_map " << n / hash_insert / 1e6 << " M/s" << std::endl;
+    std::cout << "uint64 查找: art " << n / art_find / 1e6 << " M/s, map " << n / tree_find / 1e6
+              << " M/s, unordered_map " << n / hash_find / 1e6 << " M/s" << std::endl;
+    std::cout << "有序遍历: art " << n / art_scan / 1e6 << " M/s, map " << n / tree_scan / 1e6 << " M/s, 占用 "
+              << art.memory_bytes() / (1024 * 1024) << " MB" << std::endl;
+
+    // URL风格的字符串键：长公共前缀，按目录前缀扫描
+    const size_t m = 300000;
+    sugar::vector<std::string> urls;
+    for (size_t i = 0; i < m; ++i) {
+        std::string url = "https://example.com/";
+        url += std::to_string(lcg_next(seed) % 64);
+        url += "/";
+        url += std::to_string(lcg_next(seed) % 64);
+        url += "/item";
+        url += std::to_string(random_u64(seed) % 1000000);
+        urls.push_back(url);
+    }
+    sugar::art_map<std::string, size_t> surl;
+    std::map<std::string, size_t> turl;
+    for (size_t i = 0; i < m; ++i) {
+        surl[urls[i]] = i;
+        turl[urls[i]] = i;
+    }
+    double art_sfind = seconds([&] {
+        for (size_t i = 0; i < m; ++i) {
+            sum += surl.find(urls[i])->second;
+        }
+    });
+    double tree_sfind = seconds([&] {
+        for (size_t i = 0; i < m; ++i) {
+            sum += turl.find(urls[i])->second;
+        }
+    });
+    size_t art_hits = 0;
+    size_t tree_hits = 0;
+    double art_prefix = seconds([&] {
+        for (int d = 0; d < 64; ++d) {
+            const std::string prefix = "https://example.com/" + std::to_string(d) + "/";
+            sugar::pair<sugar::art_map<std::string, size_t>::iterator, sugar::art_map<std::string, size_t>::iterator>
+                range = surl.prefix_range(prefix);
+            for (sugar::art_map<std::string, size_t>::iterator it = range.first; it != range.second; ++it) {
+                ++art_hits;
+            }
+        }
+    });
+    double tree_prefix = seconds([&] {
+        for (int d = 0; d < 64; ++d) {
+            const std::string prefix = "https://example.com/" + std::to_string(d) + "/";
+            for (std::map<std::string, size_t>::iterator it = turl.lower_bound(prefix);
+                 it != turl.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+                ++tree_hits;
+            }
+        }
+    });
+    assert(art_hits == tree_hits && art_hits == turl.size());
+    std::cout << "URL 查找: art " << m / art_sfind / 1e6 << " M/s, map " << m / tree_sfind / 1e6 << " M/s; 前缀扫描 "
+              << art_hits << " 项: art " << art_prefix * 1e3 << " ms, map " << tree_prefix * 1e3 << " ms" << std::endl;
+    std::cout << "✓ 性能对比完成 (" << sum % 10 << ")" << std::endl;
+}
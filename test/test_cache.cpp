@@ -0,0 +1,429 @@
+/*
+ * @file test_cache.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 定长缓存测试
+ */
+
+#include "cache.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_lru_cache();
+void test_clock_cache();
+void test_lru_against_model();
+void test_non_trivial_types();
+void test_sharded_cache();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Cache 测试 ===" << std::endl;
+
+    try {
+        test_lru_cache();
+        test_clock_cache();
+        test_lru_against_model();
+        test_non_trivial_types();
+        test_sharded_cache();
+        test_performance();
+
+        std::cout << "\n🎉 All cache tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试LRU缓存
+void test_lru_cache() {
+    std::cout << "\n=== 测试 lru_cache ===" << std::endl;
+
+    sugar::lru_cache<int, int> cache(3);
+    std::vector<std::pair<int, int>> evicted;
+    cache.set_eviction_callback([&](const int& k, int& v) { evicted.push_back(std::make_pair(k, v)); });
+    assert(cache.empty() && cache.capacity() == 3);
+    assert(cache.put(1, 10));
+    assert(cache.put(2, 20));
+    assert(cache.put(3, 30));
+    assert(*cache.get(1) == 10);          // 顺序：1 3 2
+    assert(cache.put(4, 40));             // 淘汰2
+    assert(evicted.size() == 1 && evicted[0].first == 2 && evicted[0].second == 20);
+    assert(cache.get(2) == nullptr);
+    assert(!cache.put(3, 33));            // 覆盖并提到表头：3 4 1
+    assert(*cache.peek(1) == 10);         // peek不改变顺序
+    assert(cache.put(5, 50));             // 淘汰1
+    assert(evicted.back().first == 1);
+    assert(cache.size() == 3);
+    std::cout << "✓ get / put / 淘汰最久未用 / 淘汰回调" << std::endl;
+
+    std::vector<int> order;
+    cache.for_each([&](const int& k, const int&) { order.push_back(k); });
+    assert((order == std::vector<int>{5, 3, 4}));
+    assert(cache.erase(3));
+    assert(!cache.erase(3));
+    assert(cache.put(6, 60));             // 复用erase释放的节点，不淘汰
+    assert(evicted.size() == 2);
+    assert(cache.contains(4) && cache.contains(5) && cache.contains(6));
+    cache.clear();
+    assert(cache.empty() && !cache.contains(4));
+    assert(evicted.size() == 2);
+    for (int i = 0; i < 10; ++i) {
+        cache.put(i, i);
+    }
+    assert(cache.size() == 3 && cache.contains(9) && cache.contains(7) && !cache.contains(6));
+    std::cout << "✓ for_each 顺序 / erase / clear" << std::endl;
+
+    bool threw = false;
+    try {
+        sugar::lru_cache<int, int> zero(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ 容量为0时抛出 invalid_argument" << std::endl;
+}
+
+// 测试CLOCK缓存
+void test_clock_cache() {
+    std::cout << "\n=== 测试 clock_cache ===" << std::endl;
+
+    sugar::clock_cache<int, int> cache(3);
+    std::vector<int> evicted;
+    cache.set_eviction_callback([&](const int& k, int&) { evicted.push_back(k); });
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    assert(*cache.get(1) == 10);
+    cache.put(4, 40);    // 指针经过1时清引用位，淘汰2
+    assert((evicted == std::vector<int>{2}));
+    cache.put(5, 50);    // 3未被引用，淘汰3
+    assert((evicted == std::vector<int>{2, 3}));
+    cache.put(6, 60);    // 1的引用位已清，淘汰1
+    assert((evicted == std::vector<int>{2, 3, 1}));
+    assert(cache.size() == 3 && cache.contains(4) && cache.contains(5) && cache.contains(6));
+    std::cout << "✓ 二次机会淘汰顺序" << std::endl;
+
+    // 热点键反复命中后不会被扫描淘汰
+    sugar::clock_cache<int, int> scan(100);
+    for (int round = 0; round < 50; ++round) {
+        for (int hot = 0; hot < 10; ++hot) {
+            if (scan.get(hot) == nullptr) {
+                scan.put(hot, hot);
+            }
+        }
+        for (int i = 0; i < 20; ++i) {
+            scan.put(1000 + round * 20 + i, i);
+        }
+    }
+    for (int hot = 0; hot < 10; ++hot) {
+        assert(scan.contains(hot));
+    }
+    int counted = 0;
+    scan.for_each([&](const int&, const int&) { ++counted; });
+    assert(counted == 100);
+    std::cout << "✓ 热点键在扫描负载下保留" << std::endl;
+}
+
+// 与std::list + std::unordered_map实现的参考LRU逐步比对
+void test_lru_against_model() {
+    std::cout << "\n=== 测试随机操作序列 ===" << std::endl;
+
+    const size_t capacity = 257;
+    sugar::lru_cache<uint32_t, uint32_t> cache(capacity);
+    std::list<std::pair<uint32_t, uint32_t>> model;
+    std::unordered_map<uint32_t, std::list<std::pair<uint32_t, uint32_t>>::iterator> where;
+    uint32_t last_evicted = 0;
+    cache.set_eviction_callback([&](const uint32_t& k, uint32_t&) { last_evicted = k; });
+    unsigned int seed = 42;
+    for (int i = 0; i < 300000; ++i) {
+        const uint32_t key = lcg_next(seed) % 600;
+        const unsigned int op = lcg_next(seed) % 10;
+        if (op < 5) {
+            uint32_t* v = cache.get(key);
+            if (where.count(key) == 0) {
+                assert(v == nullptr);
+            } else {
+                assert(v != nullptr && *v == where[key]->second);
+                model.splice(model.begin(), model, where[key]);
+            }
+        } else if (op < 9) {
+            const uint32_t value = static_cast<uint32_t>(i);
+            const bool inserted = cache.put(key, value);
+            assert(inserted == (where.count(key) == 0));
+            if (!inserted) {
+                where[key]->second = value;
+                model.splice(model.begin(), model, where[key]);
+            } else {
+                if (model.size() == capacity) {
+                    assert(last_evicted == model.back().first);
+                    where.erase(model.back().first);
+                    model.pop_back();
+                }
+                model.push_front(std::make_pair(key, value));
+                where[key] = model.begin();
+            }
+        } else {
+            assert(cache.erase(key) == (where.count(key) == 1));
+            if (where.count(key) == 1) {
+                model.erase(where[key]);
+                where.erase(key);
+            }
+        }
+        assert(cache.size() == model.size());
+    }
+    std::list<std::pair<uint32_t, uint32_t>>::iterator it = model.begin();
+    cache.for_each([&](const uint32_t& k, const uint32_t& v) {
+        assert(it->first == k && it->second == v);
+        ++it;
+    });
+    assert(it == model.end());
+    std::cout << "✓ 30万次随机操作的命中与淘汰顺序与参考实现一致" << std::endl;
+}
+
+// 非平凡类型：键值在节点中原地构造与析构
+void test_non_trivial_types() {
+    std::cout << "\n=== 测试非平凡类型 ===" << std::endl;
+
+    sugar::lru_cache<std::string, std::string> lru(64);
+    sugar::clock_cache<std::string, std::string> clock(64);
+    for (int i = 0; i < 1000; ++i) {
+        const std::string key = "key-" + std::to_string(i % 200);
+        const std::string value(static_cast<size_t>(i % 50), 'v');
+        lru.put(key, value);
+        clock.put(key, value);
+        if (i % 7 == 0) {
+            lru.erase("key-" + std::to_string(i % 13));
+            clock.erase("key-" + std::to_string(i % 13));
+        }
+    }
+    assert(lru.size() <= 64 && clock.size() <= 64);
+    const std::string* v = lru.peek("key-199");
+    assert(v != nullptr && *v == std::string(999 % 50, 'v'));
+    std::string moved_key = "moved";
+    lru.put(sugar::move(moved_key), std::string("value"));
+    assert(*lru.get("moved") == "value");
+    lru.clear();
+    assert(lru.empty());
+    std::cout << "✓ std::string 键值的插入、覆盖、淘汰与析构" << std::endl;
+}
+
+// 测试分片并发缓存
+void test_sharded_cache() {
+    std::cout << "\n=== 测试 sharded_cache ===" << std::endl;
+
+    sugar::concurrent_lru_cache<uint64_t, uint64_t> lru(4096, 8);
+    sugar::concurrent_clock_cache<uint64_t, uint64_t> clock(4096);
+    assert(lru.shard_count() == 8 && lru.capacity() == 4096);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            unsigned int seed = static_cast<unsigned int>(t + 1);
+            for (int i = 0; i < 100000; ++i) {
+                const uint64_t key = lcg_next(seed) % 10000;
+                uint64_t v = 0;
+                if (lru.get(key, v)) {
+                    assert(v == key * 7);
+                } else {
+                    lru.put(key, key * 7);
+                }
+                if (clock.get(key, v)) {
+                    assert(v == key * 7);
+                } else {
+                    clock.put(key, key * 7);
+                }
+                if (i % 100 == 0) {
+                    lru.erase(key + 1);
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    assert(lru.size() <= lru.capacity() && clock.size() <= clock.capacity());
+    assert(lru.size() > 3000);
+    lru.clear();
+    assert(lru.size() == 0);
+    std::cout << "✓ 4个线程并发读写，值一致且不超过容量" << std::endl;
+}
+
+// 手写的哈希表+链表LRU，作为对比基准
+// 统计std::list+std::unordered_map基线的堆内存；sugar缓存直接用memory_bytes()
+static std::atomic<size_t> g_std_allocated(0);
+
+template<typename T>
+struct counting_allocator {
+    typedef T value_type;
+
+    counting_allocator() noexcept {}
+    template<typename U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        g_std_allocated.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const counting_allocator<T>&, const counting_allocator<U>&) noexcept {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const counting_allocator<T>&, const counting_allocator<U>&) noexcept {
+    return false;
+}
+
+class std_lru {
+    typedef std::pair<uint64_t, uint64_t> entry;
+    typedef std::list<entry, counting_allocator<entry>> order_list;
+    typedef std::unordered_map<uint64_t, order_list::iterator, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                               counting_allocator<std::pair<const uint64_t, order_list::iterator>>>
+        index_map;
+
+public:
+    explicit std_lru(size_t capacity) : capacity_(capacity) { where_.reserve(capacity); }
+
+    uint64_t* get(uint64_t key) {
+        index_map::iterator it = where_.find(key);
+        if (it == where_.end()) {
+            return nullptr;
+        }
+        order_.splice(order_.begin(), order_, it->second);
+        return &it->second->second;
+    }
+
+    void put(uint64_t key, uint64_t value) {
+        if (uint64_t* v = get(key)) {
+            *v = value;
+            return;
+        }
+        if (order_.size() == capacity_) {
+            where_.erase(order_.back().first);
+            order_.pop_back();
+        }
+        order_.push_front(std::make_pair(key, value));
+        where_[key] = order_.begin();
+    }
+
+private:
+    size_t capacity_;
+    order_list order_;
+    index_map where_;
+};
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：命中路径延迟与每个元素的内存
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t capacity = 1 << 20;
+    // 键打散到64位空间，避免std::hash恒等散列带来的访存局部性
+    std::vector<uint64_t> keys(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        keys[i] = (i + 1) * 0x9e3779b97f4a7c15ull;
+    }
+
+    sugar::lru_cache<uint64_t, uint64_t> lru(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        lru.put(keys[i], i);
+    }
+    const double lru_bytes = static_cast<double>(lru.memory_bytes()) / capacity;
+    sugar::clock_cache<uint64_t, uint64_t> clock(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        clock.put(keys[i], i);
+    }
+    const double clock_bytes = static_cast<double>(clock.memory_bytes()) / capacity;
+    const size_t before = g_std_allocated.load();
+    std_lru reference(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        reference.put(keys[i], i);
+    }
+    const double std_bytes = static_cast<double>(g_std_allocated.load() - before) / capacity;
+    std::cout << "每个元素内存（8字节键+8字节值）: lru_cache " << lru_bytes << " B, clock_cache " << clock_bytes
+              << " B, std::list+std::unordered_map " << std_bytes << " B" << std::endl;
+
+    // 随机命中：每次都命中，测量查找+更新替换状态
+    const int lookups = 4000000;
+    std::vector<uint32_t> order(lookups);
+    unsigned int seed = 9;
+    for (int i = 0; i < lookups; ++i) {
+        order[static_cast<size_t>(i)] = (lcg_next(seed) << 15 | lcg_next(seed)) % capacity;
+    }
+    uint64_t sink = 0;
+    double lru_s = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            sink += *lru.get(keys[order[static_cast<size_t>(i)]]);
+        }
+    });
+    double clock_s = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            sink += *clock.get(keys[order[static_cast<size_t>(i)]]);
+        }
+    });
+    double std_s = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            sink += *reference.get(keys[order[static_cast<size_t>(i)]]);
+        }
+    });
+    std::cout << "100万元素随机命中: lru_cache " << lru_s / lookups * 1e9 << " ns, clock_cache "
+              << clock_s / lookups * 1e9 << " ns, std::list+std::unordered_map " << std_s / lookups * 1e9
+              << " ns (" << (sink & 1) << ")" << std::endl;
+
+    // 热点集中在1%的键上，命中路径基本在缓存中
+    for (int i = 0; i < lookups; ++i) {
+        order[static_cast<size_t>(i)] %= capacity / 100;
+    }
+    lru_s = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            sink += *lru.get(keys[order[static_cast<size_t>(i)]]);
+        }
+    });
+    clock_s = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            sink += *clock.get(keys[order[static_cast<size_t>(i)]]);
+        }
+    });
+    std_s = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            sink += *reference.get(keys[order[static_cast<size_t>(i)]]);
+        }
+    });
+    std::cout << "1%热点命中: lru_cache " << lru_s / lookups * 1e9 << " ns, clock_cache " << clock_s / lookups * 1e9
+              << " ns, std::list+std::unordered_map " << std_s / lookups * 1e9 << " ns (" << (sink & 1) << ")"
+              << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
@@ -0,0 +1,375 @@
+/*
+ * @file test_concurrent_hash_map.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 并发散列表测试
+ */
+
+#include "concurrent_hash_map.h"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 统计存活对象个数的键
+static long live_keys = 0;
+
+struct counted_key {
+    int id;
+    explicit counted_key(int i) : id(i) { ++live_keys; }
+    counted_key(const counted_key& o) : id(o.id) { ++live_keys; }
+    ~counted_key() { --live_keys; }
+    bool operator==(const counted_key& o) const { return id == o.id; }
+};
+
+struct counted_key_hash {
+    size_t operator()(const counted_key& k) const { return static_cast<size_t>(k.id) * 0x9e3779b97f4a7c15ull; }
+};
+
+// 值为负时拷贝抛出异常
+struct throwing_value {
+    int v;
+    explicit throwing_value(int x) : v(x) {}
+    throwing_value(const throwing_value& o) : v(o.v) {
+        if (v < 0) {
+            throw std::runtime_error("throwing_value copy");
+        }
+    }
+    throwing_value& operator=(const throwing_value& o) {
+        v = o.v;
+        return *this;
+    }
+};
+
+// 测试函数声明
+void test_basic_operations();
+void test_random_against_std();
+void test_non_trivial_types();
+void test_concurrent_compute();
+void test_concurrent_readers();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Concurrent Hash Map 测试 ===" << std::endl;
+
+    try {
+        test_basic_operations();
+        test_random_against_std();
+        test_non_trivial_types();
+        test_concurrent_compute();
+        test_concurrent_readers();
+        test_performance();
+
+        std::cout << "\n🎉 All concurrent_hash_map tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试基本操作
+void test_basic_operations() {
+    std::cout << "\n=== 测试基本操作 ===" << std::endl;
+
+    sugar::concurrent_hash_map<int, int> map(4);
+    assert(map.lock_free_reads);
+    assert(map.shard_count() == 4);
+    assert(map.empty());
+
+    assert(map.insert(1, 10));
+    assert(!map.insert(1, 11));
+    int value = 0;
+    assert(map.find(1, value) && value == 10);
+    assert(!map.insert_or_assign(1, 12));
+    assert(map.find(1, value) && value == 12);
+    assert(map.insert_or_assign(2, 20));
+    assert(map.size() == 2);
+    std::cout << "✓ insert / insert_or_assign / find" << std::endl;
+
+    assert(map.compute(3, [](int& v) { v += 5; }) == 5);
+    assert(map.compute(3, [](int& v) { v *= 2; }) == 10);
+    assert(map.update(3, [](int& v) { ++v; }));
+    assert(!map.update(4, [](int& v) { ++v; }));
+    assert(!map.contains(4));
+    assert(map.find(3, value) && value == 11);
+    std::cout << "✓ compute / update" << std::endl;
+
+    assert(map.erase(1));
+    assert(!map.erase(1));
+    assert(!map.contains(1));
+    assert(map.size() == 2);
+    map.clear();
+    assert(map.empty() && !map.contains(2));
+    assert(map.insert(2, 1));
+    std::cout << "✓ erase / clear" << std::endl;
+
+    bool threw = false;
+    try {
+        sugar::concurrent_hash_map<int, int> too_many((size_t(1) << 16) + 1);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ 分片数过多时抛出 length_error" << std::endl;
+}
+
+// 随机操作序列与std::unordered_map对照，覆盖扩容、墓碑和迁移中途的读写
+void test_random_against_std() {
+    std::cout << "\n=== 测试随机操作序列 ===" << std::endl;
+
+    for (size_t shards : {1u, 8u}) {
+        sugar::concurrent_hash_map<uint32_t, uint64_t> map(shards);
+        std::unordered_map<uint32_t, uint64_t> ref;
+        unsigned int seed = static_cast<unsigned int>(shards);
+        for (int i = 0; i < 400000; ++i) {
+            // 前半段以插入为主持续扩容，后半段插删各半产生大量墓碑
+            const unsigned int op = lcg_next(seed) % 10;
+            const uint32_t key = (lcg_next(seed) << 15 | lcg_next(seed)) % (i < 200000 ? 100000u : 20000u);
+            if (op < 4 || (i < 200000 && op < 7)) {
+                const uint64_t v = static_cast<uint64_t>(i);
+                assert(map.insert_or_assign(key, v) == (ref.count(key) == 0));
+                ref[key] = v;
+            } else if (op < 8) {
+                assert(map.erase(key) == (ref.erase(key) == 1));
+            } else {
+                uint64_t v = 0;
+                std::unordered_map<uint32_t, uint64_t>::iterator it = ref.find(key);
+                assert(map.find(key, v) == (it != ref.end()));
+                assert(it == ref.end() || v == it->second);
+            }
+            if (i % 50000 == 0) {
+                assert(map.size() == ref.size());
+            }
+        }
+        assert(map.size() == ref.size());
+        size_t visited = 0;
+        map.for_each([&](uint32_t k, uint64_t v) {
+            assert(ref.at(k) == v);
+            ++visited;
+        });
+        assert(visited == ref.size());
+    }
+    std::cout << "✓ 40万次随机插入/删除/查找与 std::unordered_map 一致" << std::endl;
+}
+
+// 非平凡类型走加锁读路径
+void test_non_trivial_types() {
+    std::cout << "\n=== 测试非平凡类型 ===" << std::endl;
+
+    sugar::concurrent_hash_map<std::string, std::string> map(2);
+    assert(!map.lock_free_reads);
+    for (int i = 0; i < 5000; ++i) {
+        map.insert(std::to_string(i), std::string(static_cast<size_t>(i % 40), 'x'));
+    }
+    for (int i = 0; i < 5000; i += 2) {
+        assert(map.erase(std::to_string(i)));
+    }
+    map.compute("7", [](std::string& s) { s += "!"; });
+    std::string value;
+    assert(map.find("7", value) && value == std::string(7, 'x') + "!");
+    assert(!map.find("8", value));
+    assert(map.size() == 2500);
+    map.clear();
+    assert(map.empty());
+    std::cout << "✓ std::string 键值：插入、删除、compute 与析构" << std::endl;
+
+    // 值的构造抛出异常时，已构造的键被析构，表的状态不变
+    live_keys = 0;
+    {
+        sugar::concurrent_hash_map<counted_key, throwing_value, counted_key_hash> guarded(1);
+        for (int i = 0; i < 100; ++i) {
+            assert(guarded.insert(counted_key(i), throwing_value(i)));
+        }
+        const long keys_before = live_keys;
+        for (int i = 100; i < 200; ++i) {
+            bool thrown = false;
+            try {
+                guarded.insert(counted_key(i), throwing_value(-1));
+            } catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            assert(thrown && live_keys == keys_before);
+        }
+        throwing_value out(0);
+        assert(guarded.size() == 100 && !guarded.find(counted_key(150), out));
+        // 之后仍可正常插入并触发扩容
+        for (int i = 100; i < 1000; ++i) {
+            assert(guarded.insert(counted_key(i), throwing_value(i)));
+        }
+        assert(guarded.size() == 1000 && guarded.find(counted_key(999), out) && out.v == 999);
+    }
+    assert(live_keys == 0);
+    std::cout << "✓ 值构造抛出异常时键被析构，表保持一致" << std::endl;
+}
+
+// 多线程compute计数，结果必须精确
+void test_concurrent_compute() {
+    std::cout << "\n=== 测试并发 compute ===" << std::endl;
+
+    sugar::concurrent_hash_map<int, long> map(16);
+    const int threads = 8;
+    const int per_thread = 50000;
+    const int keys = 1000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&map, t]() {
+            unsigned int seed = static_cast<unsigned int>(t + 1);
+            for (int i = 0; i < per_thread; ++i) {
+                map.compute(static_cast<int>(lcg_next(seed) % keys), [](long& v) { ++v; });
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    long total = 0;
+    map.for_each([&](int, long v) { total += v; });
+    assert(total == static_cast<long>(threads) * per_thread);
+    assert(map.size() == static_cast<size_t>(keys));
+    std::cout << "✓ " << threads << " 个线程各 " << per_thread << " 次 compute，总计数精确" << std::endl;
+}
+
+// 写者反复插入与删除时，无锁读者看到的值要么不存在，要么是完整写入的值
+void test_concurrent_readers() {
+    std::cout << "\n=== 测试并发读写 ===" << std::endl;
+
+    struct pair_value {
+        uint64_t a;
+        uint64_t b;
+    };
+    sugar::concurrent_hash_map<uint64_t, pair_value> map(4);
+    std::atomic<bool> stop(false);
+    std::atomic<long> hits(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.push_back(std::thread([&, t]() {
+            unsigned int seed = static_cast<unsigned int>(t + 100);
+            long local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const uint64_t key = lcg_next(seed) % 50000;
+                pair_value v;
+                if (map.find(key, v)) {
+                    assert(v.a % 50000 == key && v.b == v.a * 3);
+                    ++local;
+                }
+            }
+            hits += local;
+        }));
+    }
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; ++t) {
+        writers.push_back(std::thread([&, t]() {
+            unsigned int seed = static_cast<unsigned int>(t + 7);
+            for (int round = 0; round < 300000; ++round) {
+                const uint64_t key = lcg_next(seed) % 50000;
+                if (round % 3 == 2) {
+                    map.erase(key);
+                } else {
+                    const uint64_t a = key + 50000 * static_cast<uint64_t>(round);
+                    pair_value v = {a, a * 3};
+                    map.insert_or_assign(key, v);
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < writers.size(); ++t) {
+        writers[t].join();
+    }
+    stop = true;
+    for (size_t t = 0; t < readers.size(); ++t) {
+        readers[t].join();
+    }
+    std::cout << "✓ 读者未观察到写了一半的值（命中 " << hits.load() << " 次）" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 基准键：把序号打散到64位空间。连续的小整数配合std::hash的恒等散列时，桶和节点地址都随键单调，
+// 访存局部性远好于真实负载（指针、ID等），会让对比失真
+static uint64_t bench_key(uint64_t i) {
+    return i * 0x9e3779b97f4a7c15ull;
+}
+
+// 在threads个线程上跑总计ops次操作，90%查找、10%写入
+template<typename Find, typename Write>
+static double run_mixed(int threads, int ops, Find find, Write write) {
+    return seconds([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&, t]() {
+                unsigned int seed = static_cast<unsigned int>(t * 977 + 1);
+                const int n = ops / threads;
+                for (int i = 0; i < n; ++i) {
+                    const uint64_t key = bench_key((lcg_next(seed) << 15 | lcg_next(seed)) % 1000000);
+                    if (lcg_next(seed) % 10 == 0) {
+                        write(key);
+                    } else {
+                        find(key);
+                    }
+                }
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    });
+}
+
+// 测试性能：90%读10%写，与全局互斥锁保护的std::unordered_map比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int ops = 2000000;
+    std::cout << "90/10 读写混合，100万键，共 " << ops << " 次操作（Mops/s）：" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        sugar::concurrent_hash_map<uint64_t, uint64_t> map(0, 1000000);
+        std::unordered_map<uint64_t, uint64_t> ref;
+        std::mutex ref_lock;
+        for (uint64_t i = 0; i < 1000000; i += 2) {
+            map.insert(bench_key(i), i);
+            ref[bench_key(i)] = i;
+        }
+        // 查找结果不再使用：find内部有原子读和加锁，编译器不会把调用优化掉
+        double sugar_s = run_mixed(threads, ops,
+            [&](uint64_t key) {
+                uint64_t v = 0;
+                map.find(key, v);
+            },
+            [&](uint64_t key) { map.insert_or_assign(key, key); });
+        double std_s = run_mixed(threads, ops,
+            [&](uint64_t key) {
+                std::lock_guard<std::mutex> guard(ref_lock);
+                ref.find(key);
+            },
+            [&](uint64_t key) {
+                std::lock_guard<std::mutex> guard(ref_lock);
+                ref[key] = key;
+            });
+        std::cout << "  " << threads << " 线程: sugar " << ops / sugar_s / 1e6 << ", std::unordered_map+mutex "
+                  << ops / std_s / 1e6 << std::endl;
+    }
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
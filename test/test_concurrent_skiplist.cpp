@@ -0,0 +1,290 @@
+/*
+ * @file test_concurrent_skiplist.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 并发跳表测试
+ */
+
+#include "concurrent_skiplist.h"
+#include "vector.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+static uint64_t random_u64(unsigned int& state) {
+    uint64_t v = 0;
+    for (int i = 0; i < 5; ++i) {
+        v = (v << 15) ^ lcg_next(state);
+    }
+    return v;
+}
+
+// 测试函数声明
+void test_basic_operations();
+void test_string_keys();
+void test_concurrent_inserts();
+void test_concurrent_readers();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Concurrent Skiplist 测试 ===" << std::endl;
+
+    try {
+        test_basic_operations();
+        test_string_keys();
+        test_concurrent_inserts();
+        test_concurrent_readers();
+        test_performance();
+
+        std::cout << "\n🎉 All concurrent_skiplist tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试单线程下的基本操作
+void test_basic_operations() {
+    std::cout << "\n=== 测试基本操作 ===" << std::endl;
+
+    sugar::concurrent_skiplist<uint64_t, int> list;
+    assert(list.empty() && list.begin() == list.end() && list.find(3) == list.end());
+    assert(list.insert(5, 50).second);
+    assert(!list.insert(5, 51).second && list.find(5)->second == 50);
+    assert(list.try_emplace(3, 30).second && list.try_emplace(9, 90).second);
+    assert(list.size() == 3 && list.contains(3) && !list.contains(4));
+    assert(list.lower_bound(4)->first == 5 && list.lower_bound(5)->first == 5);
+    assert(list.upper_bound(5)->first == 9 && list.upper_bound(9) == list.end());
+    assert(list.lower_bound(0)->first == 3 && list.lower_bound(10) == list.end());
+    std::cout << "✓ 插入、重复插入、查找、lower_bound / upper_bound" << std::endl;
+
+    // 随机键与std::map对比顺序
+    unsigned int seed = 17;
+    sugar::concurrent_skiplist<uint64_t, uint64_t> big;
+    std::map<uint64_t, uint64_t> ref;
+    for (uint64_t i = 0; i < 100000; ++i) {
+        const uint64_t key = random_u64(seed) % 60000;
+        assert(big.insert(key, i).second == ref.insert(std::make_pair(key, i)).second);
+    }
+    assert(big.size() == ref.size());
+    std::map<uint64_t, uint64_t>::const_iterator r = ref.begin();
+    for (sugar::concurrent_skiplist<uint64_t, uint64_t>::const_iterator it = big.begin(); it != big.end(); ++it, ++r) {
+        assert(it->first == r->first && it->second == r->second);
+    }
+    assert(r == ref.end());
+    for (uint64_t key = 0; key < 60010; key += 7) {
+        std::map<uint64_t, uint64_t>::const_iterator lb = ref.lower_bound(key);
+        sugar::concurrent_skiplist<uint64_t, uint64_t>::const_iterator it = big.lower_bound(key);
+        assert(lb == ref.end() ? it == big.end() : it->first == lb->first);
+    }
+    std::cout << "✓ 10万次随机插入后有序遍历与std::map一致，占用 " << big.memory_bytes() / 1024 << " KB" << std::endl;
+
+    // 自定义比较：降序
+    sugar::concurrent_skiplist<int, int, sugar::greater<int>> desc;
+    for (int i = 0; i < 100; ++i) {
+        desc.insert(i, i);
+    }
+    assert(desc.begin()->first == 99 && desc.lower_bound(50)->first == 50 && desc.upper_bound(50)->first == 49);
+    std::cout << "✓ 自定义比较函数" << std::endl;
+}
+
+// 测试非平凡类型：析构时逐个释放
+void test_string_keys() {
+    std::cout << "\n=== 测试字符串键 ===" << std::endl;
+
+    sugar::concurrent_skiplist<std::string, std::string> list;
+    const char* words[] = {"pear", "apple", "fig", "banana", "cherry", "apple"};
+    for (const char* w : words) {
+        list.insert(w, std::string(w) + std::string(40, '!'));
+    }
+    assert(list.size() == 5 && list.begin()->first == "apple");
+    assert(list.find("fig")->second.size() == 43 && list.find("grape") == list.end());
+    std::string joined;
+    for (sugar::concurrent_skiplist<std::string, std::string>::const_iterator it = list.begin(); it != list.end(); ++it) {
+        joined += it->first + ",";
+    }
+    assert(joined == "apple,banana,cherry,fig,pear,");
+    std::cout << "✓ 字符串键有序存储，值在跳表析构时释放" << std::endl;
+}
+
+// 多线程并发插入：互不相交的键全部可见，重叠的键只插入一次
+void test_concurrent_inserts() {
+    std::cout << "\n=== 测试并发插入 ===" << std::endl;
+
+    const int threads = 8;
+    const int per_thread = 20000;
+    sugar::concurrent_skiplist<uint64_t, uint64_t> list;
+    std::atomic<int> wins(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&list, &wins, t]() {
+            int local = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                // 一半是线程私有的键，一半是所有线程争抢的共享键
+                const uint64_t own = (static_cast<uint64_t>(i) * threads + t) * 2 + 1;
+                list.insert(own, own * 10);
+                if (list.insert(static_cast<uint64_t>(i) * 2, static_cast<uint64_t>(t)).second) {
+                    ++local;
+                }
+            }
+            wins += local;
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    assert(wins.load() == per_thread);
+    assert(list.size() == static_cast<size_t>(threads + 1) * per_thread);
+    size_t count = 0;
+    uint64_t prev = 0;
+    for (sugar::concurrent_skiplist<uint64_t, uint64_t>::const_iterator it = list.begin(); it != list.end(); ++it) {
+        assert(count == 0 || prev < it->first);
+        assert(it->first % 2 == 0 ? it->second < static_cast<uint64_t>(threads) : it->second == it->first * 10);
+        prev = it->first;
+        ++count;
+    }
+    assert(count == list.size());
+    for (uint64_t key = 0; key < static_cast<uint64_t>(threads) * per_thread * 2; ++key) {
+        assert(list.contains(key) == (key % 2 == 1 || key < static_cast<uint64_t>(per_thread) * 2));
+    }
+    std::cout << "✓ " << threads << " 个线程并发插入 " << list.size() << " 个键，共享键各只成功一次" << std::endl;
+}
+
+// 写者插入的同时，读者的有序扫描始终严格递增，已插入的键随后一定能查到
+void test_concurrent_readers() {
+    std::cout << "\n=== 测试并发读写 ===" << std::endl;
+
+    sugar::concurrent_skiplist<uint64_t, uint64_t> list;
+    std::atomic<uint64_t> published(0);
+    std::atomic<bool> stop(false);
+    std::atomic<long> scans(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.push_back(std::thread([&]() {
+            long local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                // 写者按序号递增发布，读到的发布值之前的键都必须可见
+                const uint64_t upto = published.load(std::memory_order_acquire);
+                for (uint64_t k = upto > 64 ? upto - 64 : 0; k < upto; ++k) {
+                    sugar::concurrent_skiplist<uint64_t, uint64_t>::const_iterator it = list.find(k * 0x9e3779b97f4a7c15ull);
+                    assert(it != list.end() && it->second == k);
+                }
+                uint64_t prev = 0;
+                bool first = true;
+                size_t seen = 0;
+                for (sugar::concurrent_skiplist<uint64_t, uint64_t>::const_iterator it = list.begin();
+                     it != list.end() && seen < 2000; ++it, ++seen) {
+                    assert(first || prev < it->first);
+                    prev = it->first;
+                    first = false;
+                }
+                ++local;
+            }
+            scans += local;
+        }));
+    }
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; ++t) {
+        writers.push_back(std::thread([&, t]() {
+            for (uint64_t k = static_cast<uint64_t>(t); k < 100000; k += 2) {
+                list.insert(k * 0x9e3779b97f4a7c15ull, k);
+                if (t == 0) {
+                    // 只由一个写者发布：等另一个写者的前一个键也插入后再推进
+                    while (k > 0 && !list.contains((k - 1) * 0x9e3779b97f4a7c15ull)) {
+                        std::this_thread::yield();
+                    }
+                    published.store(k + 1, std::memory_order_release);
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < writers.size(); ++t) {
+        writers[t].join();
+    }
+    stop = true;
+    for (size_t t = 0; t < readers.size(); ++t) {
+        readers[t].join();
+    }
+    assert(list.size() == 100000);
+    std::cout << "✓ 读者扫描 " << scans.load() << " 次，始终有序且不漏已发布的键" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 在threads个线程上各插入ops/threads个随机键
+template<typename Insert>
+static double run_inserts(int threads, int ops, Insert insert) {
+    return seconds([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&, t]() {
+                unsigned int seed = static_cast<unsigned int>(t * 977 + 1);
+                const int n = ops / threads;
+                for (int i = 0; i < n; ++i) {
+                    insert(random_u64(seed));
+                }
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    });
+}
+
+// 测试性能：并发插入与有序扫描，与全局互斥锁保护的std::map比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int ops = 300000;
+    std::cout << "并发插入 " << ops << " 个随机键（Mops/s）与插入后的全量有序扫描：" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        sugar::concurrent_skiplist<uint64_t, uint64_t> list;
+        std::map<uint64_t, uint64_t> ref;
+        std::mutex ref_lock;
+        double list_s = run_inserts(threads, ops, [&](uint64_t key) { list.insert(key, key); });
+        double map_s = run_inserts(threads, ops, [&](uint64_t key) {
+            std::lock_guard<std::mutex> guard(ref_lock);
+            ref.insert(std::make_pair(key, key));
+        });
+        uint64_t sum = 0;
+        double list_scan = seconds([&] {
+            for (sugar::concurrent_skiplist<uint64_t, uint64_t>::const_iterator it = list.begin(); it != list.end(); ++it) {
+                sum += it->second;
+            }
+        });
+        double map_scan = seconds([&] {
+            for (std::map<uint64_t, uint64_t>::const_iterator it = ref.begin(); it != ref.end(); ++it) {
+                sum -= it->second;
+            }
+        });
+        assert(sum == 0 && list.size() == ref.size());
+        std::cout << "  " << threads << " 线程: 插入 sugar " << ops / list_s / 1e6 << ", std::map+mutex "
+                  << ops / map_s / 1e6 << "; 扫描 sugar " << list.size() / list_scan / 1e6 << ", std::map "
+                  << ref.size() / map_scan / 1e6 << std::endl;
+    }
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
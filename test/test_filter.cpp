@@ -0,0 +1,324 @@
+/*
+ * @file test_filter.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 近似成员过滤器测试
+ */
+
+#include "filter.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+static uint64_t random_u64(unsigned int& state) {
+    uint64_t v = 0;
+    for (int i = 0; i < 5; ++i) {
+        v = (v << 15) ^ lcg_next(state);
+    }
+    return v;
+}
+
+// 测试函数声明
+void test_bloom_filter();
+void test_cuckoo_filter();
+void test_binary_fuse_filter();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Filter 测试 ===" << std::endl;
+
+    try {
+        test_bloom_filter();
+        test_cuckoo_filter();
+        test_binary_fuse_filter();
+        test_performance();
+
+        std::cout << "\n🎉 All filter tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 生成互不相同的正例与反例：正例为偶数，反例为奇数
+static void make_keys(size_t n, unsigned int seed, sugar::vector<uint64_t>& present, sugar::vector<uint64_t>& absent) {
+    present.clear();
+    absent.clear();
+    for (size_t i = 0; i < n; ++i) {
+        present.push_back(random_u64(seed) & ~uint64_t(1));
+        absent.push_back(random_u64(seed) | 1);
+    }
+}
+
+// 无漏报并返回误报率
+template<typename Filter>
+static double false_positive_rate(const Filter& f, const sugar::vector<uint64_t>& present,
+                                  const sugar::vector<uint64_t>& absent) {
+    for (size_t i = 0; i < present.size(); ++i) {
+        assert(f.contains(present[i]));
+    }
+    size_t hits = 0;
+    for (size_t i = 0; i < absent.size(); ++i) {
+        hits += f.contains(absent[i]);
+    }
+    return static_cast<double>(hits) / absent.size();
+}
+
+// 序列化往返并检查损坏的输入被拒绝
+template<typename Filter>
+static Filter round_trip(const Filter& f) {
+    sugar::vector<unsigned char> bytes(f.serialized_size());
+    f.serialize(bytes.data());
+    int thrown = 0;
+    try {
+        Filter::deserialize(bytes.data(), bytes.size() - 1);
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    bytes[0] ^= 1;
+    try {
+        Filter::deserialize(bytes.data(), bytes.size());
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    bytes[0] ^= 1;
+    assert(thrown == 2);
+    return Filter::deserialize(bytes.data(), bytes.size());
+}
+
+// 测试bloom_filter
+void test_bloom_filter() {
+    std::cout << "\n=== 测试 bloom_filter ===" << std::endl;
+
+    sugar::vector<uint64_t> present;
+    sugar::vector<uint64_t> absent;
+    make_keys(20000, 1, present, absent);
+    sugar::bloom_filter<uint64_t> f(present);
+    assert(f.size() == present.size());
+    assert(f.bits_per_key() >= 10.0 && f.bits_per_key() < 10.1);
+    const double fpr = false_positive_rate(f, present, absent);
+    assert(fpr > 0.002 && fpr < 0.02);
+    sugar::bloom_filter<uint64_t> dense(present, 16.0);
+    assert(false_positive_rate(dense, present, absent) < 0.003);
+    std::cout << "✓ 无漏报，每键10位误报率 " << fpr * 100 << "%" << std::endl;
+
+    sugar::bloom_filter<uint64_t> copy = round_trip(f);
+    assert(copy.size() == f.size() && copy.block_count() == f.block_count());
+    assert(false_positive_rate(copy, present, absent) == fpr);
+    sugar::bloom_filter<uint64_t> moved(std::move(copy));
+    copy = moved;
+    assert(copy.contains(present[0]) && moved.contains(present[1]));
+    moved.clear();
+    assert(moved.size() == 0 && !moved.contains(present[0]));
+    std::cout << "✓ 序列化往返、拷贝与移动，截断或魔数错误抛出 invalid_argument" << std::endl;
+
+    sugar::vector<std::string> words;
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back("key-" + std::to_string(i));
+    }
+    sugar::bloom_filter<std::string> sf(words);
+    size_t hits = 0;
+    for (int i = 0; i < 1000; ++i) {
+        assert(sf.contains(words[static_cast<size_t>(i)]));
+        hits += sf.contains("other-" + std::to_string(i));
+    }
+    assert(hits < 30);
+    bool threw = false;
+    try {
+        sugar::bloom_filter<int> bad(10, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ 字符串键，bits_per_key 非正抛出 invalid_argument" << std::endl;
+}
+
+// 测试cuckoo_filter
+void test_cuckoo_filter() {
+    std::cout << "\n=== 测试 cuckoo_filter ===" << std::endl;
+
+    sugar::vector<uint64_t> present;
+    sugar::vector<uint64_t> absent;
+    make_keys(20000, 2, present, absent);
+    sugar::cuckoo_filter<uint64_t> f(present);
+    assert(f.size() == present.size());
+    const double fpr = false_positive_rate(f, present, absent);
+    assert(fpr < 0.001);
+    std::cout << "✓ 无漏报，误报率 " << fpr * 100 << "%，每键 " << f.bits_per_key() << " 位" << std::endl;
+
+    // 删除一半后，剩下的一半仍无漏报，被删的大部分不再命中
+    for (size_t i = 0; i < present.size(); i += 2) {
+        assert(f.erase(present[i]));
+    }
+    assert(f.size() == present.size() / 2);
+    size_t still = 0;
+    for (size_t i = 0; i < present.size(); ++i) {
+        if (i % 2 == 1) {
+            assert(f.contains(present[i]));
+        } else {
+            still += f.contains(present[i]);
+        }
+    }
+    assert(still < 20);
+    assert(!f.erase(absent[0]) || f.size() == present.size() / 2 - 1);
+    std::cout << "✓ 删除一半的键，其余无漏报，被删键仅 " << still << " 个误报" << std::endl;
+
+    // 同一个键插入两次需要删除两次
+    sugar::cuckoo_filter<int> small(100);
+    assert(small.insert(7) && small.insert(7) && small.size() == 2);
+    assert(small.erase(7) && small.contains(7));
+    assert(small.erase(7) && !small.contains(7) && small.empty());
+
+    // 填满后insert返回false，删除后可再插入
+    sugar::cuckoo_filter<int> tiny(8);
+    int inserted = 0;
+    while (tiny.insert(inserted)) {
+        ++inserted;
+    }
+    assert(tiny.full() && inserted >= 8 && static_cast<size_t>(inserted) <= 4 * tiny.bucket_count());
+    for (int i = 0; i < inserted; ++i) {
+        assert(tiny.contains(i));
+    }
+    assert(tiny.erase(0) && !tiny.full() && tiny.insert(-1));
+    std::cout << "✓ 重复键按副本计数，装满后 insert 返回 false，删除后恢复" << std::endl;
+
+    sugar::cuckoo_filter<int> restored = round_trip(tiny);
+    assert(restored.size() == tiny.size() && restored.full() == tiny.full());
+    for (int i = 1; i < inserted; ++i) {
+        assert(restored.contains(i));
+    }
+    bool threw = false;
+    try {
+        sugar::vector<int> same(200, 5);
+        sugar::cuckoo_filter<int> bad(same);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ 序列化往返，大量重复键构造时抛出 length_error" << std::endl;
+}
+
+// 测试binary_fuse_filter
+void test_binary_fuse_filter() {
+    std::cout << "\n=== 测试 binary_fuse_filter ===" << std::endl;
+
+    sugar::vector<uint64_t> present;
+    sugar::vector<uint64_t> absent;
+    make_keys(50000, 3, present, absent);
+    sugar::binary_fuse_filter<uint64_t> f(present);
+    const double fpr = false_positive_rate(f, present, absent);
+    assert(fpr > 0.002 && fpr < 0.006);
+    assert(f.bits_per_key() < 10.0);
+    std::cout << "✓ 无漏报，误报率 " << fpr * 100 << "%，每键 " << f.bits_per_key() << " 位" << std::endl;
+
+    // 各种规模（含0和1）与重复键
+    const size_t sizes[] = {0, 1, 2, 3, 10, 100, 1000, 12345};
+    for (size_t n : sizes) {
+        sugar::vector<uint64_t> keys;
+        for (size_t i = 0; i < n; ++i) {
+            keys.push_back(present[i]);
+            if (i % 3 == 0) {
+                keys.push_back(present[i]);
+            }
+        }
+        sugar::binary_fuse_filter<uint64_t> g(keys);
+        assert(g.size() == n);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            assert(g.contains(keys[i]));
+        }
+    }
+    std::cout << "✓ 0~12345个键与重复键都能构造且无漏报" << std::endl;
+
+    sugar::binary_fuse_filter<uint64_t> copy = round_trip(f);
+    assert(copy.size() == f.size());
+    assert(false_positive_rate(copy, present, absent) == fpr);
+    sugar::vector<std::string> words;
+    for (int i = 0; i < 500; ++i) {
+        words.push_back(std::to_string(i * 7919));
+    }
+    sugar::binary_fuse_filter<std::string> sf(words);
+    for (size_t i = 0; i < words.size(); ++i) {
+        assert(sf.contains(words[i]));
+    }
+    std::cout << "✓ 序列化往返，字符串键" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 对一个过滤器测量误报率与查询吞吐并输出
+template<typename Filter>
+static void report(const char* name, const Filter& f, double build_s, const sugar::vector<uint64_t>& present,
+                   const sugar::vector<uint64_t>& absent) {
+    size_t hits = 0;
+    double lookup_s = seconds([&] {
+        for (size_t i = 0; i < absent.size(); ++i) {
+            hits += f.contains(absent[i]);
+            hits += f.contains(present[i]);
+        }
+    });
+    const double fpr = static_cast<double>(hits - present.size()) / absent.size();
+    std::cout << name << ": 误报率 " << fpr * 100 << "%, 每键 " << f.bits_per_key() << " 位, 查询 "
+              << 2 * absent.size() / lookup_s / 1e6 << " M/s, 构造 " << build_s * 1e3 << " ms" << std::endl;
+}
+
+// 测试性能
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = 1000000;
+    sugar::vector<uint64_t> present;
+    sugar::vector<uint64_t> absent;
+    make_keys(n, 4, present, absent);
+
+    std::unordered_set<uint64_t> baseline;
+    double set_build = seconds([&] {
+        baseline.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            baseline.insert(present[i]);
+        }
+    });
+    size_t hits = 0;
+    double set_lookup = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            hits += baseline.count(absent[i]);
+            hits += baseline.count(present[i]);
+        }
+    });
+    assert(hits == n);
+    std::cout << "std::unordered_set: 精确, 查询 " << 2 * n / set_lookup / 1e6 << " M/s, 构造 " << set_build * 1e3
+              << " ms" << std::endl;
+
+    sugar::bloom_filter<uint64_t> bloom;
+    double bloom_build = seconds([&] { bloom = sugar::bloom_filter<uint64_t>(present); });
+    report("bloom_filter (10位/键)", bloom, bloom_build, present, absent);
+
+    sugar::cuckoo_filter<uint64_t> cuckoo;
+    double cuckoo_build = seconds([&] { cuckoo = sugar::cuckoo_filter<uint64_t>(present); });
+    report("cuckoo_filter", cuckoo, cuckoo_build, present, absent);
+
+    sugar::binary_fuse_filter<uint64_t> fuse;
+    double fuse_build = seconds([&] { fuse = sugar::binary_fuse_filter<uint64_t>(present); });
+    report("binary_fuse_filter", fuse, fuse_build, present, absent);
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
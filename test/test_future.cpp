@@ -0,0 +1,469 @@
+/*
+ * @file test_future.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 异步任务测试
+ */
+
+#include "future.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 测试函数声明
+void test_promise_future();
+void test_exceptions();
+void test_allocator();
+void test_then_inline();
+void test_then_executor();
+void test_async();
+void test_when_all();
+void test_when_any();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Future 测试 ===" << std::endl;
+
+    try {
+        test_promise_future();
+        test_exceptions();
+        test_allocator();
+        test_then_inline();
+        test_then_executor();
+        test_async();
+        test_when_all();
+        test_when_any();
+        test_performance();
+
+        std::cout << "\n🎉 All future tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试promise与future的基本用法
+void test_promise_future() {
+    std::cout << "\n=== 测试 promise / future ===" << std::endl;
+
+    sugar::promise<int> p;
+    sugar::future<int> f = p.get_future();
+    assert(f.valid() && !f.is_ready());
+    p.set_value(42);
+    assert(f.is_ready() && f.get() == 42 && !f.valid());
+    std::cout << "✓ 设置后取值，取值后 future 失效" << std::endl;
+
+    // 另一个线程稍后设置，get 阻塞等待
+    sugar::promise<std::string> ps;
+    sugar::future<std::string> fs = ps.get_future();
+    std::thread producer([&ps]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ps.set_value(5, 'x');
+    });
+    assert(fs.get() == "xxxxx");
+    producer.join();
+    std::cout << "✓ 跨线程阻塞等待，set_value 原地构造结果" << std::endl;
+
+    // 只移动的结果类型与void
+    sugar::promise<std::unique_ptr<int>> pu;
+    sugar::future<std::unique_ptr<int>> fu = pu.get_future();
+    pu.set_value(new int(7));
+    std::unique_ptr<int> owned = fu.get();
+    assert(*owned == 7);
+    sugar::promise<void> pv;
+    sugar::future<void> fv = pv.get_future();
+    pv.set_value();
+    fv.get();
+    std::cout << "✓ 只移动类型与 void" << std::endl;
+
+    // promise 可移动
+    sugar::promise<int> a;
+    sugar::future<int> fa = a.get_future();
+    sugar::promise<int> b(sugar::move(a));
+    b.set_value(3);
+    assert(fa.get() == 3);
+    assert(sugar::make_ready_future(9).get() == 9);
+    std::cout << "✓ promise 移动、make_ready_future" << std::endl;
+}
+
+// 测试异常传递与误用检查
+void test_exceptions() {
+    std::cout << "\n=== 测试异常 ===" << std::endl;
+
+    sugar::promise<int> p;
+    sugar::future<int> f = p.get_future();
+    p.set_exception(std::make_exception_ptr(std::runtime_error("boom")));
+    bool caught = false;
+    try {
+        f.get();
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "boom";
+    }
+    assert(caught);
+
+    // promise 未设置就析构
+    sugar::future<int> orphan;
+    {
+        sugar::promise<int> dropped;
+        orphan = dropped.get_future();
+    }
+    caught = false;
+    try {
+        orphan.get();
+    } catch (const std::future_error& e) {
+        caught = e.code() == std::future_errc::broken_promise;
+    }
+    assert(caught);
+    std::cout << "✓ set_exception 与 broken_promise" << std::endl;
+
+    sugar::promise<int> twice;
+    sugar::future<int> once = twice.get_future();
+    twice.set_value(1);
+    int errors = 0;
+    try {
+        twice.get_future();
+    } catch (const std::logic_error&) {
+        ++errors;
+    }
+    try {
+        twice.set_value(2);
+    } catch (const std::logic_error&) {
+        ++errors;
+    }
+    once.get();
+    try {
+        once.get();
+    } catch (const std::logic_error&) {
+        ++errors;
+    }
+    assert(errors == 3);
+    std::cout << "✓ 重复取 future、重复设置、重复取值抛出 logic_error" << std::endl;
+}
+
+// 计数分配器：记录共享状态的分配次数
+static int allocations = 0;
+static int deallocations = 0;
+
+template<typename T>
+class counting_allocator : public sugar::allocator<T> {
+public:
+    counting_allocator() noexcept {}
+    template<typename U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++allocations;
+        return sugar::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ++deallocations;
+        sugar::allocator<T>::deallocate(p, n);
+    }
+};
+
+// 测试共享状态只分配一次，且由指定的分配器释放
+void test_allocator() {
+    std::cout << "\n=== 测试分配器 ===" << std::endl;
+
+    {
+        sugar::promise<std::string> p(sugar::allocator_arg, counting_allocator<char>());
+        sugar::future<std::string> f = p.get_future();
+        assert(allocations == 1 && deallocations == 0);
+        p.set_value("hello");
+        assert(f.get() == "hello");
+        assert(deallocations == 0);  // promise 仍持有状态
+    }
+    assert(allocations == 1 && deallocations == 1);
+    std::cout << "✓ 共享状态经 allocator_traits 分配一次，最后一个持有者释放" << std::endl;
+}
+
+// 测试就地执行的续接
+void test_then_inline() {
+    std::cout << "\n=== 测试 then（就地执行） ===" << std::endl;
+
+    sugar::promise<int> p;
+    const std::thread::id setter_thread = std::this_thread::get_id();
+    std::thread::id ran_on;
+    sugar::future<std::string> f = p.get_future()
+                                       .then([&](sugar::future<int> x) {
+                                           ran_on = std::this_thread::get_id();
+                                           return x.get() * 2;
+                                       })
+                                       .then([](sugar::future<int> x) { return std::to_string(x.get()); });
+    assert(!f.is_ready());
+    p.set_value(21);
+    assert(f.is_ready() && f.get() == "42" && ran_on == setter_thread);
+    std::cout << "✓ 续接在 set_value 的线程中依次执行" << std::endl;
+
+    // 已就绪的 future 上挂续接立即执行；void 续接；异常沿链传递
+    int side = 0;
+    sugar::future<void> done = sugar::make_ready_future(5).then([&side](sugar::future<int> x) { side = x.get(); });
+    assert(done.is_ready() && side == 5);
+    done.get();
+    sugar::future<int> failed = sugar::make_ready_future(1)
+                                    .then([](sugar::future<int>) -> int { throw std::runtime_error("step"); })
+                                    .then([](sugar::future<int> x) { return x.get() + 1; });
+    bool caught = false;
+    try {
+        failed.get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    std::cout << "✓ 已就绪时立即执行、void 续接、异常沿链传递" << std::endl;
+
+    // 很长的就地续接链不会耗尽栈空间
+    sugar::promise<long> start;
+    sugar::future<long> tail = start.get_future();
+    const long links = 200000;
+    for (long i = 0; i < links; ++i) {
+        tail = tail.then([](sugar::future<long> x) { return x.get() + 1; });
+    }
+    start.set_value(0);
+    assert(tail.get() == links);
+    std::cout << "✓ " << links << " 级续接链" << std::endl;
+}
+
+// 测试投递到线程池的续接
+void test_then_executor() {
+    std::cout << "\n=== 测试 then（线程池） ===" << std::endl;
+
+    sugar::task_executor pool(2);
+    assert(pool.size() == 2);
+    sugar::promise<int> p;
+    const std::thread::id main_thread = std::this_thread::get_id();
+    std::atomic<bool> on_pool(false);
+    sugar::future<int> f = p.get_future().then(pool, [&](sugar::future<int> x) {
+        on_pool = std::this_thread::get_id() != main_thread;
+        return x.get() + 1;
+    });
+    p.set_value(1);
+    assert(f.get() == 2 && on_pool.load());
+
+    // 在多个线程上并发完成多条链
+    const int chains = 64;
+    std::vector<sugar::promise<int>> starts(chains);
+    std::vector<sugar::future<int>> ends;
+    for (int c = 0; c < chains; ++c) {
+        sugar::future<int> g = starts[c].get_future();
+        for (int i = 0; i < 20; ++i) {
+            g = i % 2 == 0 ? g.then(pool, [](sugar::future<int> x) { return x.get() + 1; })
+                           : g.then([](sugar::future<int> x) { return x.get() + 1; });
+        }
+        ends.push_back(sugar::move(g));
+    }
+    std::vector<std::thread> setters;
+    for (int t = 0; t < 4; ++t) {
+        setters.push_back(std::thread([&, t]() {
+            for (int c = t; c < chains; c += 4) {
+                starts[c].set_value(c);
+            }
+        }));
+    }
+    for (size_t t = 0; t < setters.size(); ++t) {
+        setters[t].join();
+    }
+    for (int c = 0; c < chains; ++c) {
+        assert(ends[c].get() == c + 20);
+    }
+    std::cout << "✓ 续接在线程池中执行，" << chains << " 条混合链并发完成" << std::endl;
+}
+
+// 测试async
+void test_async() {
+    std::cout << "\n=== 测试 async ===" << std::endl;
+
+    sugar::task_executor pool(2);
+    sugar::future<int> f = sugar::async(pool, []() { return 6 * 7; });
+    assert(f.get() == 42);
+    sugar::future<void> v = sugar::async(pool, []() {});
+    v.get();
+    sugar::future<int> e = sugar::async([]() -> int { throw std::invalid_argument("bad"); });
+    bool caught = false;
+    try {
+        e.get();
+    } catch (const std::invalid_argument&) {
+        caught = true;
+    }
+    assert(caught);
+
+    // 线程池析构前执行完队列中的任务
+    std::atomic<int> ran(0);
+    {
+        sugar::task_executor local(1);
+        for (int i = 0; i < 100; ++i) {
+            sugar::async(local, [&ran]() { ++ran; });
+        }
+    }
+    assert(ran.load() == 100);
+    std::cout << "✓ 在线程池上执行、异常传递、析构前排空队列" << std::endl;
+}
+
+// 测试when_all
+void test_when_all() {
+    std::cout << "\n=== 测试 when_all ===" << std::endl;
+
+    sugar::vector<sugar::promise<int>> ps;
+    for (int i = 0; i < 5; ++i) {
+        ps.push_back(sugar::promise<int>());
+    }
+    sugar::vector<sugar::future<int>> fs;
+    for (size_t i = 0; i < ps.size(); ++i) {
+        fs.push_back(ps[i].get_future());
+    }
+    fs.push_back(sugar::make_ready_future(100));
+    sugar::future<sugar::vector<sugar::future<int>>> all = sugar::when_all(sugar::move(fs));
+    for (size_t i = ps.size(); i > 0; --i) {
+        assert(!all.is_ready());
+        ps[i - 1].set_value(static_cast<int>(i));
+    }
+    assert(all.is_ready());
+    sugar::vector<sugar::future<int>> results = all.get();
+    int sum = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        assert(results[i].is_ready());
+        sum += results[i].get();
+    }
+    assert(results.size() == 6 && sum == 115);
+
+    sugar::future<sugar::vector<sugar::future<int>>> none = sugar::when_all(sugar::vector<sugar::future<int>>());
+    assert(none.is_ready() && none.get().empty());
+
+    // 多个线程池任务全部完成后汇总
+    sugar::task_executor pool(2);
+    sugar::vector<sugar::future<long>> tasks;
+    for (long i = 0; i < 50; ++i) {
+        tasks.push_back(sugar::async(pool, [i]() { return i * i; }));
+    }
+    long total = sugar::when_all(sugar::move(tasks))
+                     .then([](sugar::future<sugar::vector<sugar::future<long>>> r) {
+                         sugar::vector<sugar::future<long>> done = r.get();
+                         long s = 0;
+                         for (size_t i = 0; i < done.size(); ++i) {
+                             s += done[i].get();
+                         }
+                         return s;
+                     })
+                     .get();
+    assert(total == 49 * 50 * 99 / 6);
+    std::cout << "✓ 全部完成后就绪、空输入、汇总线程池任务" << std::endl;
+}
+
+// 测试when_any
+void test_when_any() {
+    std::cout << "\n=== 测试 when_any ===" << std::endl;
+
+    sugar::vector<sugar::promise<std::string>> ps;
+    for (int i = 0; i < 3; ++i) {
+        ps.push_back(sugar::promise<std::string>());
+    }
+    sugar::vector<sugar::future<std::string>> fs;
+    for (size_t i = 0; i < ps.size(); ++i) {
+        fs.push_back(ps[i].get_future());
+    }
+    sugar::future<sugar::when_any_result<std::string>> any = sugar::when_any(sugar::move(fs));
+    assert(!any.is_ready());
+    ps[1].set_value("second");
+    assert(any.is_ready());
+    sugar::when_any_result<std::string> r = any.get();
+    assert(r.index == 1 && r.futures.size() == 3 && r.futures[1].get() == "second");
+    assert(!r.futures[0].is_ready());
+
+    // 其余输入随后完成，仍可取值或继续挂续接
+    sugar::future<size_t> len = r.futures[2].then([](sugar::future<std::string> x) { return x.get().size(); });
+    ps[0].set_value("first");
+    ps[2].set_value("third!");
+    assert(r.futures[0].get() == "first" && len.get() == 6);
+
+    sugar::future<sugar::when_any_result<int>> empty = sugar::when_any(sugar::vector<sugar::future<int>>());
+    assert(empty.get().index == static_cast<size_t>(-1));
+
+    // 已就绪的输入立即胜出
+    sugar::promise<int> pending;
+    sugar::vector<sugar::future<int>> mixed;
+    mixed.push_back(pending.get_future());
+    mixed.push_back(sugar::make_ready_future(1));
+    assert(sugar::when_any(sugar::move(mixed)).get().index == 1);
+    pending.set_value(0);
+    std::cout << "✓ 最先完成者胜出，其余输入仍可使用" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：续接链与往返的单级延迟，与std::async比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    // 就地续接链：构建后一次性触发
+    const int inline_links = 200000;
+    double inline_s = seconds([&] {
+        sugar::promise<int> start;
+        sugar::future<int> tail = start.get_future();
+        for (int i = 0; i < inline_links; ++i) {
+            tail = tail.then([](sugar::future<int> x) { return x.get() + 1; });
+        }
+        start.set_value(0);
+        assert(tail.get() == inline_links);
+    });
+
+    // 每级都投递到线程池的续接链
+    const int pool_links = 20000;
+    sugar::task_executor pool(2);
+    double pool_s = seconds([&] {
+        sugar::promise<int> start;
+        sugar::future<int> tail = start.get_future();
+        for (int i = 0; i < pool_links; ++i) {
+            tail = tail.then(pool, [](sugar::future<int> x) { return x.get() + 1; });
+        }
+        start.set_value(0);
+        assert(tail.get() == pool_links);
+    });
+
+    // std::async 链：每级一个线程，等待前一级的结果
+    const int std_links = 500;
+    double std_chain_s = seconds([&] {
+        std::future<int> tail = std::async(std::launch::async, []() { return 0; });
+        for (int i = 0; i < std_links; ++i) {
+            tail = std::async(std::launch::async, [](std::future<int> prev) { return prev.get() + 1; },
+                              std::move(tail));
+        }
+        assert(tail.get() == std_links);
+    });
+    std::cout << "续接链单级延迟（微秒）: sugar 就地 " << inline_s / inline_links * 1e6 << ", sugar 线程池 "
+              << pool_s / pool_links * 1e6 << ", std::async " << std_chain_s / std_links * 1e6 << std::endl;
+
+    // 提交任务并等待结果的往返延迟
+    const int round_trips = 20000;
+    double sugar_rt = seconds([&] {
+        for (int i = 0; i < round_trips; ++i) {
+            assert(sugar::async(pool, [i]() { return i; }).get() == i);
+        }
+    });
+    const int std_round_trips = 2000;
+    double std_rt = seconds([&] {
+        for (int i = 0; i < std_round_trips; ++i) {
+            assert(std::async(std::launch::async, [i]() { return i; }).get() == i);
+        }
+    });
+    std::cout << "async(f).get() 往返延迟（微秒）: sugar " << sugar_rt / round_trips * 1e6 << ", std::async "
+              << std_rt / std_round_trips * 1e6 << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
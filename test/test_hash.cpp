@@ -0,0 +1,165 @@
+/*
+ * @file test_hash.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 散列函数测试
+ */
+
+#include "hash.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+// 测试函数声明
+void test_hash_functor();
+void test_hash_bytes();
+void test_avalanche();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Hash 测试 ===" << std::endl;
+
+    try {
+        test_hash_functor();
+        test_hash_bytes();
+        test_avalanche();
+        test_performance();
+
+        std::cout << "\n🎉 All hash tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试hash仿函数
+void test_hash_functor() {
+    std::cout << "\n=== 测试 hash 仿函数 ===" << std::endl;
+
+    sugar::hash<int> hi;
+    sugar::hash<unsigned long long> hu;
+    assert(hi(42) == hi(42));
+    assert(hi(42) != hi(43));
+    assert(hu(42ULL) == static_cast<size_t>(sugar::hash_mix64(42)));
+
+    // 连续整数取低10位作桶号时分布均匀（恒等散列在这里会完全聚集在步长的倍数上）
+    std::vector<int> buckets(1024, 0);
+    for (int i = 0; i < 1024 * 64; ++i) {
+        ++buckets[hi(i * 1024) & 1023];
+    }
+    for (int b : buckets) {
+        assert(b > 20 && b < 120);
+    }
+    std::cout << "✓ 整数散列：相同输入相同输出，低位分布均匀" << std::endl;
+
+    sugar::hash<double> hd;
+    assert(hd(0.0) == hd(-0.0));
+    assert(hd(1.5) != hd(2.5));
+    sugar::hash<char> hc;
+    assert(hc('a') != hc('b'));
+    int x = 0;
+    int y = 0;
+    sugar::hash<int*> hp;
+    assert(hp(&x) != hp(&y));
+    sugar::hash<std::string> hs;
+    assert(hs("hello") == hs(std::string("hello")));
+    assert(hs("hello") != hs("hellp"));
+    assert(hs(std::string()) == hs(""));
+    sugar::hash<std::wstring> hw;
+    assert(hw(L"ab") != hw(L"ba"));
+    std::cout << "✓ 浮点 / 字符 / 指针 / 字符串" << std::endl;
+}
+
+// 测试字节散列
+void test_hash_bytes() {
+    std::cout << "\n=== 测试 hash_bytes ===" << std::endl;
+
+    // 覆盖0~200字节的全部长度分支；只改一个字节或只改长度都应得到不同散列
+    std::string base(200, '\0');
+    for (size_t i = 0; i < base.size(); ++i) {
+        base[i] = static_cast<char>(i * 31 + 7);
+    }
+    std::set<uint64_t> seen;
+    for (size_t len = 0; len <= base.size(); ++len) {
+        uint64_t h = sugar::hash_bytes(base.data(), len);
+        assert(h == sugar::hash_bytes(base.data(), len));
+        assert(seen.insert(h).second);
+        for (size_t pos = 0; pos < len; pos += 7) {
+            std::string changed = base.substr(0, len);
+            changed[pos] ^= 1;
+            assert(sugar::hash_bytes(changed.data(), len) != h);
+        }
+    }
+    // 种子改变结果
+    assert(sugar::hash_bytes("abc", 3, 1) != sugar::hash_bytes("abc", 3, 2));
+    std::cout << "✓ 各长度分支、单字节改动与种子" << std::endl;
+}
+
+// 雪崩：翻转任一输入位，约一半输出位随之翻转
+void test_avalanche() {
+    std::cout << "\n=== 测试雪崩效应 ===" << std::endl;
+
+    const int samples = 2000;
+    uint64_t state = 1;
+    double worst = 0;
+    double total = 0;
+    for (int bit = 0; bit < 64; ++bit) {
+        long flipped = 0;
+        for (int s = 0; s < samples; ++s) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            uint64_t a = sugar::hash_mix64(state);
+            uint64_t b = sugar::hash_mix64(state ^ (uint64_t(1) << bit));
+            flipped += __builtin_popcountll(a ^ b);
+        }
+        double ratio = static_cast<double>(flipped) / (64.0 * samples);
+        total += ratio;
+        worst = std::max(worst, std::fabs(ratio - 0.5));
+    }
+    assert(worst < 0.02);
+    std::cout << "✓ hash_mix64 平均翻转比例 " << total / 64 << "，最大偏差 " << worst << std::endl;
+}
+
+// 测试性能：与std::hash比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int n = 20000000;
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    sugar::hash<unsigned long long> sh;
+    for (int i = 0; i < n; ++i) {
+        sink += sh(static_cast<unsigned long long>(i));
+    }
+    double sugar_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+
+    std::string text(1 << 20, 'x');
+    for (size_t i = 0; i < text.size(); ++i) {
+        text[i] = static_cast<char>(i * 131);
+    }
+    const int rounds = 200;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        text[0] = static_cast<char>(r);
+        sink += sugar::hash_bytes(text.data(), text.size());
+    }
+    double sugar_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    std::hash<std::string> std_hash;
+    for (int r = 0; r < rounds; ++r) {
+        text[0] = static_cast<char>(r);
+        sink += std_hash(text);
+    }
+    double std_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double gb = static_cast<double>(text.size()) * rounds / 1e9;
+    std::cout << "整数散列 " << sugar_ns << " ns/个；1MB字节散列 sugar " << gb / sugar_s << " GB/s, std::hash "
+              << gb / std_s << " GB/s (" << (sink & 1) << ")" << std::endl;
+}
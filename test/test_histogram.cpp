@@ -0,0 +1,283 @@
+/*
+ * @file test_histogram.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 直方图与计数排序测试
+ */
+
+#include "histogram.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_histogram();
+void test_parallel_histogram();
+void test_counting_sort();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Histogram 测试 ===" << std::endl;
+
+    try {
+        test_histogram();
+        test_parallel_histogram();
+        test_counting_sort();
+        test_performance();
+
+        std::cout << "\n🎉 All histogram tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 随机字节，run_percent控制出现长游程的比例
+static std::vector<unsigned char> random_bytes(size_t n, unsigned int seed, unsigned int run_percent) {
+    std::vector<unsigned char> v(n);
+    size_t i = 0;
+    while (i < n) {
+        if (lcg_next(seed) % 100 < run_percent) {
+            size_t len = 1 + lcg_next(seed) % 200;
+            unsigned char c = static_cast<unsigned char>(lcg_next(seed));
+            for (; len > 0 && i < n; --len) {
+                v[i++] = c;
+            }
+        } else {
+            v[i++] = static_cast<unsigned char>(lcg_next(seed) >> 3);
+        }
+    }
+    return v;
+}
+
+// 朴素参考实现
+template<typename T>
+static std::vector<uint64_t> naive_histogram(const T* p, size_t n, size_t bins) {
+    std::vector<uint64_t> counts(bins, 0);
+    for (size_t i = 0; i < n; ++i) {
+        ++counts[static_cast<size_t>(p[i])];
+    }
+    return counts;
+}
+
+// 测试单线程直方图
+void test_histogram() {
+    std::cout << "\n=== 测试 histogram ===" << std::endl;
+
+    // 不同长度、起点不对齐、有无游程
+    for (size_t n = 0; n < 5000; n = n * 3 / 2 + 1) {
+        for (unsigned int runs : {0u, 50u, 100u}) {
+            std::vector<unsigned char> data = random_bytes(n + 3, static_cast<unsigned int>(n + runs), runs);
+            for (size_t offset = 0; offset < 3; ++offset) {
+                std::vector<uint64_t> counts(256, 0);
+                sugar::histogram(data.data() + offset, data.data() + offset + n, counts.data());
+                assert(counts == naive_histogram(data.data() + offset, n, 256));
+            }
+        }
+    }
+    std::cout << "✓ 字节直方图（各种长度/不对齐/游程）" << std::endl;
+
+    // char 按 unsigned char 取值
+    const char text[] = "\xff\xff\x01 abc";
+    sugar::vector<size_t> char_counts(256, 0);
+    sugar::histogram(text, text + 7, char_counts.begin());
+    assert(char_counts[255] == 2 && char_counts[1] == 1 && char_counts[' '] == 1 && char_counts['a'] == 1);
+    // 结果累加到已有计数上
+    sugar::histogram(text, text + 7, char_counts.begin());
+    assert(char_counts[255] == 4);
+    std::cout << "✓ char 键与累加语义" << std::endl;
+
+    // 16位键
+    std::vector<uint16_t> codes(100003);
+    unsigned int seed = 3;
+    for (size_t i = 0; i < codes.size(); ++i) {
+        codes[i] = static_cast<uint16_t>(i % 5 == 0 ? 65535 : (lcg_next(seed) << 1) ^ lcg_next(seed));
+    }
+    std::vector<uint64_t> counts16(65536, 0);
+    sugar::histogram(codes.data() + 1, codes.data() + codes.size(), counts16.data());
+    assert(counts16 == naive_histogram(codes.data() + 1, codes.size() - 1, 65536));
+    std::cout << "✓ uint16_t 直方图" << std::endl;
+
+    // 通用迭代器
+    sugar::vector<int> small = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+    int generic[10] = {0};
+    sugar::histogram(small.begin(), small.end(), generic);
+    assert(generic[5] == 3 && generic[1] == 2 && generic[0] == 0 && generic[9] == 1);
+    std::cout << "✓ 通用迭代器逐个计数" << std::endl;
+}
+
+// 测试多线程直方图
+void test_parallel_histogram() {
+    std::cout << "\n=== 测试 parallel_histogram ===" << std::endl;
+
+    std::vector<unsigned char> data = random_bytes(3000001, 11, 20);
+    std::vector<uint64_t> expected = naive_histogram(data.data(), data.size(), 256);
+    for (size_t threads : {0u, 1u, 2u, 4u, 7u}) {
+        std::vector<uint64_t> counts(256, 0);
+        sugar::parallel_histogram(data.data(), data.data() + data.size(), counts.data(), threads);
+        assert(counts == expected);
+    }
+    std::vector<uint16_t> codes(1000000);
+    for (size_t i = 0; i < codes.size(); ++i) {
+        codes[i] = static_cast<uint16_t>(data[i] * 251 + data[i + 1]);
+    }
+    std::vector<uint64_t> counts16(65536, 0);
+    sugar::parallel_histogram(codes.data(), codes.data() + codes.size(), counts16.data(), 3);
+    assert(counts16 == naive_histogram(codes.data(), codes.size(), 65536));
+    std::cout << "✓ 各线程数结果与单线程一致（字节 / uint16_t）" << std::endl;
+}
+
+// 带负载的记录，用于检验稳定性
+struct record {
+    uint16_t code;
+    int seq;
+};
+
+// 测试计数排序
+void test_counting_sort() {
+    std::cout << "\n=== 测试 counting_sort ===" << std::endl;
+
+    std::vector<unsigned char> bytes = random_bytes(100000, 5, 30);
+    std::vector<unsigned char> ref = bytes;
+    std::sort(ref.begin(), ref.end());
+    sugar::counting_sort(bytes.data(), bytes.data() + bytes.size());
+    assert(bytes == ref);
+
+    std::vector<uint16_t> codes(50000);
+    unsigned int seed = 8;
+    for (size_t i = 0; i < codes.size(); ++i) {
+        codes[i] = static_cast<uint16_t>(lcg_next(seed) * 2 + 1);
+    }
+    std::vector<uint16_t> ref16 = codes;
+    std::sort(ref16.begin(), ref16.end());
+    sugar::counting_sort(codes.data(), codes.data() + codes.size());
+    assert(codes == ref16);
+    std::cout << "✓ 字节 / uint16_t 原地计数排序" << std::endl;
+
+    // 有符号字节按值排序，负数在前
+    signed char small[] = {5, -3, 100, -128, 0, 127, -1, 1};
+    sugar::counting_sort(small, small + 8);
+    const signed char expected[] = {-128, -3, -1, 0, 1, 5, 100, 127};
+    for (int i = 0; i < 8; ++i) {
+        assert(small[i] == expected[i]);
+    }
+    std::vector<signed char> sbytes(100000);
+    std::vector<char> chars(100000);
+    for (size_t i = 0; i < sbytes.size(); ++i) {
+        sbytes[i] = static_cast<signed char>(lcg_next(seed) & 0xff);
+        chars[i] = static_cast<char>(lcg_next(seed) & 0xff);
+    }
+    std::vector<signed char> sref = sbytes;
+    std::vector<char> cref = chars;
+    std::sort(sref.begin(), sref.end());
+    std::sort(cref.begin(), cref.end());
+    sugar::counting_sort(sbytes.data(), sbytes.data() + sbytes.size());
+    sugar::counting_sort(chars.data(), chars.data() + chars.size());
+    assert(sbytes == sref && chars == cref);
+    std::cout << "✓ signed char / char 按值排序" << std::endl;
+
+    // 按键稳定排序
+    std::vector<record> records(20000);
+    for (size_t i = 0; i < records.size(); ++i) {
+        records[i].code = static_cast<uint16_t>(lcg_next(seed) % 300);
+        records[i].seq = static_cast<int>(i);
+    }
+    std::vector<record> sorted(records.size());
+    std::vector<record>::iterator end = sugar::counting_sort(records.begin(), records.end(), sorted.begin(),
+                                                             [](const record& r) { return r.code; });
+    assert(end == sorted.end());
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        assert(sorted[i - 1].code < sorted[i].code ||
+               (sorted[i - 1].code == sorted[i].code && sorted[i - 1].seq < sorted[i].seq));
+    }
+    sugar::counting_sort(records.begin(), records.end(), sorted.begin(),
+                         [](const record& r) { return static_cast<unsigned char>(r.seq & 0xff); });
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        assert((sorted[i - 1].seq & 0xff) <= (sorted[i].seq & 0xff));
+    }
+    sugar::counting_sort(records.begin(), records.end(), sorted.begin(),
+                         [](const record& r) { return static_cast<signed char>(r.seq & 0xff); });
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        const signed char a = static_cast<signed char>(sorted[i - 1].seq & 0xff);
+        const signed char b = static_cast<signed char>(sorted[i].seq & 0xff);
+        assert(a < b || (a == b && sorted[i - 1].seq < sorted[i].seq));
+    }
+    std::cout << "✓ 按8/16位键的稳定计数排序" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：1GB字节
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = size_t(1) << 30;
+    std::vector<unsigned char> data(n);
+    unsigned int seed = 1;
+    // 前半随机，后半是长游程（模拟填充与稀疏编码）
+    for (size_t i = 0; i < n / 2; ++i) {
+        data[i] = static_cast<unsigned char>(lcg_next(seed) >> 3);
+    }
+    for (size_t i = n / 2; i < n; i += 4096) {
+        std::fill(data.begin() + static_cast<ptrdiff_t>(i), data.begin() + static_cast<ptrdiff_t>(i + 4096),
+                  static_cast<unsigned char>(lcg_next(seed) % 4));
+    }
+    const double gb = static_cast<double>(n) / 1e9;
+
+    std::vector<uint64_t> naive(256, 0);
+    double naive_s = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            ++naive[data[i]];
+        }
+    });
+    std::vector<uint64_t> counts(256, 0);
+    double sugar_s = seconds([&] { sugar::histogram(data.data(), data.data() + n, counts.data()); });
+    assert(counts == naive);
+    std::vector<uint64_t> parallel(256, 0);
+    double parallel_s = seconds([&] { sugar::parallel_histogram(data.data(), data.data() + n, parallel.data()); });
+    assert(parallel == naive);
+    // 每个键一次std::count，只在16MB上测量
+    const size_t sample = size_t(16) << 20;
+    size_t total = 0;
+    double count_s = seconds([&] {
+        for (int key = 0; key < 256; ++key) {
+            total += static_cast<size_t>(std::count(data.begin(), data.begin() + static_cast<ptrdiff_t>(sample),
+                                                    static_cast<unsigned char>(key)));
+        }
+    });
+    assert(total == sample);
+    std::cout << "1GB 字节直方图: 朴素循环 " << gb / naive_s << " GB/s, sugar::histogram " << gb / sugar_s
+              << " GB/s, parallel_histogram " << gb / parallel_s << " GB/s, 逐键std::count "
+              << static_cast<double>(sample) / 1e9 / count_s << " GB/s" << std::endl;
+
+    // 计数排序与std::sort
+    const size_t m = size_t(64) << 20;
+    std::vector<unsigned char> a(data.begin(), data.begin() + static_cast<ptrdiff_t>(m));
+    std::vector<unsigned char> b = a;
+    double counting_s = seconds([&] { sugar::counting_sort(a.data(), a.data() + m); });
+    double std_s = seconds([&] { std::sort(b.begin(), b.end()); });
+    assert(a == b);
+    std::cout << "64MB 字节排序: counting_sort " << counting_s * 1e3 << " ms, std::sort " << std_s * 1e3 << " ms"
+              << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
@@ -0,0 +1,323 @@
+/*
+ * @file test_hive.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 蜂巢容器测试
+ */
+
+#include "hive.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_basic_operations();
+void test_skip_field();
+void test_random_against_model();
+void test_copy_and_move();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Hive 测试 ===" << std::endl;
+
+    try {
+        test_basic_operations();
+        test_skip_field();
+        test_random_against_model();
+        test_copy_and_move();
+        test_performance();
+
+        std::cout << "\n🎉 All hive tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试基本操作
+void test_basic_operations() {
+    std::cout << "\n=== 测试基本操作 ===" << std::endl;
+
+    sugar::hive<std::string> h;
+    assert(h.empty() && h.begin() == h.end());
+    std::vector<std::string*> ptrs;
+    for (int i = 0; i < 100; ++i) {
+        ptrs.push_back(&*h.insert(std::to_string(i)));
+    }
+    assert(h.size() == 100 && h.capacity() >= 100);
+    std::cout << "✓ insert" << std::endl;
+
+    // 删除偶数，奇数元素的地址不变
+    for (int i = 0; i < 100; i += 2) {
+        h.erase(h.get_iterator(ptrs[static_cast<size_t>(i)]));
+    }
+    assert(h.size() == 50);
+    for (int i = 1; i < 100; i += 2) {
+        assert(*ptrs[static_cast<size_t>(i)] == std::to_string(i));
+    }
+    std::set<std::string> seen(h.begin(), h.end());
+    assert(seen.size() == 50 && seen.count("1") == 1 && seen.count("2") == 0);
+    std::cout << "✓ erase 后其余元素地址不变，遍历只看到存活元素" << std::endl;
+
+    // 新元素复用空洞，不增加容量
+    const size_t cap = h.capacity();
+    for (int i = 0; i < 50; ++i) {
+        h.emplace(3, 'x');
+    }
+    assert(h.size() == 100 && h.capacity() == cap);
+    assert(std::count(h.begin(), h.end(), std::string("xxx")) == 50);
+    std::cout << "✓ 插入复用空洞" << std::endl;
+
+    // erase_if 与 clear
+    assert(h.erase_if([](const std::string& s) { return s == "xxx"; }) == 50);
+    assert(h.size() == 50);
+    h.clear();
+    assert(h.empty() && h.begin() == h.end());
+    h.insert("again");
+    assert(*h.begin() == "again");
+    std::cout << "✓ erase_if / clear" << std::endl;
+}
+
+// 遍历顺序与反向遍历：借助与插入同序的计数检查跳跃域
+void test_skip_field() {
+    std::cout << "\n=== 测试跳跃域 ===" << std::endl;
+
+    sugar::hive<int> h;
+    std::vector<sugar::hive<int>::iterator> its;
+    for (int i = 0; i < 300; ++i) {
+        its.push_back(h.insert(i));
+    }
+    // 没有删除时遍历顺序即插入顺序
+    int expect = 0;
+    for (sugar::hive<int>::iterator it = h.begin(); it != h.end(); ++it) {
+        assert(*it == expect++);
+    }
+    // 按各种模式挖洞：单个、相邻合并、左右合并、整块清空
+    const int pattern[] = {5, 7, 6, 0, 1, 2, 3, 4, 8, 9, 10, 11, 12, 13, 14, 15, 100, 102, 101, 299, 298};
+    std::set<int> erased;
+    for (int p : pattern) {
+        h.erase(its[static_cast<size_t>(p)]);
+        erased.insert(p);
+        std::vector<int> forward;
+        for (int v : h) {
+            forward.push_back(v);
+        }
+        std::vector<int> expected;
+        for (int i = 0; i < 300; ++i) {
+            if (erased.count(i) == 0) {
+                expected.push_back(i);
+            }
+        }
+        assert(forward == expected);
+        // 反向遍历
+        std::vector<int> backward;
+        for (sugar::hive<int>::iterator it = h.end(); it != h.begin();) {
+            --it;
+            backward.push_back(*it);
+        }
+        std::reverse(backward.begin(), backward.end());
+        assert(backward == expected);
+    }
+    std::cout << "✓ 各种空洞合并情形下正向、反向遍历正确" << std::endl;
+
+    // erase返回下一个元素
+    sugar::hive<int>::iterator next = h.erase(its[16]);
+    assert(*next == 17);
+    // 删除最后一个元素返回end
+    assert(h.erase(its[297]) == h.end());
+    std::cout << "✓ erase 返回后继迭代器" << std::endl;
+}
+
+// 与std::multiset逐步比对随机插删
+void test_random_against_model() {
+    std::cout << "\n=== 测试随机操作序列 ===" << std::endl;
+
+    sugar::hive<uint64_t> h;
+    std::multiset<uint64_t> model;
+    std::vector<uint64_t*> live;
+    unsigned int seed = 23;
+    for (int i = 0; i < 200000; ++i) {
+        const unsigned int op = lcg_next(seed) % 10;
+        if (op < 5 || live.empty()) {
+            uint64_t v = static_cast<uint64_t>(lcg_next(seed));
+            live.push_back(&*h.insert(v));
+            model.insert(v);
+        } else {
+            const size_t k = (lcg_next(seed) << 15 | lcg_next(seed)) % live.size();
+            uint64_t* p = live[k];
+            model.erase(model.find(*p));
+            h.erase(h.get_iterator(p));
+            live[k] = live.back();
+            live.pop_back();
+        }
+        if (i % 20000 == 0) {
+            std::multiset<uint64_t> got(h.begin(), h.end());
+            assert(got == model);
+        }
+        // 某个阶段大量删除，验证空块被释放
+        if (i == 150000) {
+            while (live.size() > 10) {
+                model.erase(model.find(*live.back()));
+                h.erase(h.get_iterator(live.back()));
+                live.pop_back();
+            }
+            assert(h.capacity() < 10 * 8192);
+        }
+    }
+    std::multiset<uint64_t> got(h.begin(), h.end());
+    assert(got == model && h.size() == model.size());
+    std::cout << "✓ 20万次随机插入/删除与参考实现一致，空块被释放" << std::endl;
+}
+
+// 拷贝与移动
+void test_copy_and_move() {
+    std::cout << "\n=== 测试拷贝与移动 ===" << std::endl;
+
+    sugar::hive<std::string> a;
+    for (int i = 0; i < 1000; ++i) {
+        a.insert(std::string(static_cast<size_t>(i % 30), 'a'));
+    }
+    a.erase_if([](const std::string& s) { return s.size() % 3 == 0; });
+    sugar::hive<std::string> b(a);
+    assert(b.size() == a.size());
+    assert(std::multiset<std::string>(a.begin(), a.end()) == std::multiset<std::string>(b.begin(), b.end()));
+    sugar::hive<std::string> c(std::move(a));
+    assert(a.empty() && c.size() == b.size());
+    a = c;
+    assert(a.size() == c.size());
+    c = sugar::hive<std::string>();
+    assert(c.empty());
+    sugar::swap(a, c);
+    assert(a.empty() && c.size() == b.size());
+    sugar::hive<std::string>::const_iterator cit = c.cbegin();
+    assert(!cit->empty());
+    std::cout << "✓ 拷贝构造 / 移动构造 / 赋值 / swap" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct entity {
+    double x, y;
+    uint64_t id;
+    uint64_t pad[5];
+};
+
+// 测试性能：插入、随机删除、遍历混合，与vector和list比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int n = 50000;
+    const int rounds = 20;
+    const int churn = n / 100;
+    // 每轮随机删除1%并补回1%，然后完整遍历一次
+    double sink = 0;
+    unsigned int seed = 3;
+    double hive_s = seconds([&] {
+        sugar::hive<entity> h;
+        std::vector<entity*> handles;
+        for (int i = 0; i < n; ++i) {
+            entity e = {1.0 * i, 2.0, static_cast<uint64_t>(i), {0}};
+            handles.push_back(&*h.insert(e));
+        }
+        for (int r = 0; r < rounds; ++r) {
+            for (int k = 0; k < churn; ++k) {
+                const size_t idx = (lcg_next(seed) << 15 | lcg_next(seed)) % handles.size();
+                h.erase(h.get_iterator(handles[idx]));
+                entity e = {1.0 * k, 2.0, static_cast<uint64_t>(k), {0}};
+                handles[idx] = &*h.insert(e);
+            }
+            for (const entity& e : h) {
+                sink += e.x;
+            }
+        }
+    });
+
+    seed = 3;
+    double vector_s = seconds([&] {
+        sugar::vector<entity> v;
+        for (int i = 0; i < n; ++i) {
+            entity e = {1.0 * i, 2.0, static_cast<uint64_t>(i), {0}};
+            v.push_back(e);
+        }
+        for (int r = 0; r < rounds; ++r) {
+            for (int k = 0; k < churn; ++k) {
+                const size_t idx = (lcg_next(seed) << 15 | lcg_next(seed)) % v.size();
+                v.erase(v.begin() + static_cast<ptrdiff_t>(idx));
+                entity e = {1.0 * k, 2.0, static_cast<uint64_t>(k), {0}};
+                v.push_back(e);
+            }
+            for (const entity& e : v) {
+                sink += e.x;
+            }
+        }
+    });
+
+    seed = 3;
+    double list_s = seconds([&] {
+        std::list<entity> l;
+        std::vector<std::list<entity>::iterator> handles;
+        for (int i = 0; i < n; ++i) {
+            entity e = {1.0 * i, 2.0, static_cast<uint64_t>(i), {0}};
+            handles.push_back(l.insert(l.end(), e));
+        }
+        for (int r = 0; r < rounds; ++r) {
+            for (int k = 0; k < churn; ++k) {
+                const size_t idx = (lcg_next(seed) << 15 | lcg_next(seed)) % handles.size();
+                l.erase(handles[idx]);
+                entity e = {1.0 * k, 2.0, static_cast<uint64_t>(k), {0}};
+                handles[idx] = l.insert(l.end(), e);
+            }
+            for (const entity& e : l) {
+                sink += e.x;
+            }
+        }
+    });
+    std::cout << "5万元素×20轮（每轮删1%补1%后遍历）: hive " << hive_s * 1e3 << " ms, sugar::vector "
+              << vector_s * 1e3 << " ms, std::list " << list_s * 1e3 << " ms (" << (sink > 0) << ")" << std::endl;
+
+    // 纯遍历：高删除率后空洞很多时的遍历开销
+    sugar::hive<entity> h;
+    std::vector<entity*> handles;
+    for (int i = 0; i < n * 20; ++i) {
+        entity e = {1.0 * i, 2.0, static_cast<uint64_t>(i), {0}};
+        handles.push_back(&*h.insert(e));
+    }
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (lcg_next(seed) % 4 != 0) {
+            h.erase(h.get_iterator(handles[i]));
+        }
+    }
+    double iter_s = seconds([&] {
+        for (int r = 0; r < 10; ++r) {
+            for (const entity& e : h) {
+                sink += e.x;
+            }
+        }
+    });
+    std::cout << "删除75%后遍历: " << iter_s / 10 / static_cast<double>(h.size()) * 1e9 << " ns/个存活元素 ("
+              << (sink > 0) << ")" << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
@@ -0,0 +1,312 @@
+/*
+ * @file test_indexed_heap.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL indexed_heap / pairing_heap / radix_heap 测试
+ */
+
+#include "indexed_heap.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static uint32_t lcg_next(uint32_t& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// CSR 格式的有向图
+struct graph {
+    sugar::vector<uint32_t> offsets;
+    sugar::vector<uint32_t> targets;
+    sugar::vector<uint32_t> weights;
+};
+
+// 生成随机图：每个顶点out_degree条出边，权重在[1, 100]
+static graph make_graph(uint32_t n, uint32_t out_degree, uint32_t seed) {
+    graph g;
+    g.offsets.reserve(n + 1);
+    g.targets.reserve(static_cast<size_t>(n) * out_degree);
+    g.weights.reserve(static_cast<size_t>(n) * out_degree);
+    g.offsets.push_back(0);
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t e = 0; e < out_degree; ++e) {
+            uint32_t v = ((lcg_next(seed) << 15) | lcg_next(seed)) % n;
+            g.targets.push_back(v);
+            g.weights.push_back(lcg_next(seed) % 100 + 1);
+        }
+        g.offsets.push_back(static_cast<uint32_t>(g.targets.size()));
+    }
+    return g;
+}
+
+static const uint64_t kInf = static_cast<uint64_t>(-1);
+
+// 使用可寻址堆（indexed_heap / pairing_heap）的Dijkstra
+template<typename Heap>
+static sugar::vector<uint64_t> dijkstra_addressable(const graph& g, uint32_t source) {
+    size_t n = g.offsets.size() - 1;
+    sugar::vector<uint64_t> dist(n, kInf);
+    Heap heap(n);
+    dist[source] = 0;
+    heap.push(source, 0);
+    while (!heap.empty()) {
+        size_t u = heap.pop();
+        for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            uint32_t v = g.targets[e];
+            uint64_t nd = dist[u] + g.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push_or_decrease(v, nd);
+            }
+        }
+    }
+    return dist;
+}
+
+// 使用radix_heap的Dijkstra（单调键，惰性删除）
+static sugar::vector<uint64_t> dijkstra_radix(const graph& g, uint32_t source) {
+    size_t n = g.offsets.size() - 1;
+    sugar::vector<uint64_t> dist(n, kInf);
+    sugar::radix_heap<uint64_t, uint32_t> heap;
+    dist[source] = 0;
+    heap.push(0, source);
+    while (!heap.empty()) {
+        sugar::pair<uint64_t, uint32_t> top = heap.pop();
+        uint32_t u = top.second;
+        if (top.first != dist[u]) {
+            continue;
+        }
+        for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            uint32_t v = g.targets[e];
+            uint64_t nd = dist[u] + g.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push(nd, v);
+            }
+        }
+    }
+    return dist;
+}
+
+// 使用std::priority_queue的Dijkstra（惰性删除），作为参照
+static sugar::vector<uint64_t> dijkstra_std(const graph& g, uint32_t source) {
+    size_t n = g.offsets.size() - 1;
+    sugar::vector<uint64_t> dist(n, kInf);
+    typedef std::pair<uint64_t, uint32_t> item;
+    std::priority_queue<item, std::vector<item>, std::greater<item>> heap;
+    dist[source] = 0;
+    heap.push(item(0, source));
+    while (!heap.empty()) {
+        item top = heap.top();
+        heap.pop();
+        uint32_t u = top.second;
+        if (top.first != dist[u]) {
+            continue;
+        }
+        for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            uint32_t v = g.targets[e];
+            uint64_t nd = dist[u] + g.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push(item(nd, v));
+            }
+        }
+    }
+    return dist;
+}
+
+// 测试函数声明
+void test_indexed_heap();
+void test_pairing_heap();
+void test_radix_heap();
+void test_dijkstra();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Indexed Heap 测试 ===" << std::endl;
+
+    try {
+        test_indexed_heap();
+        test_pairing_heap();
+        test_radix_heap();
+        test_dijkstra();
+        test_performance();
+
+        std::cout << "\n🎉 All indexed_heap tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 可寻址堆的通用测试
+template<typename Heap>
+static void check_addressable_heap() {
+    Heap heap(10);
+    assert(heap.empty());
+    heap.push(0, 50);
+    heap.push(1, 30);
+    heap.push(2, 40);
+    heap.push(3, 10);
+    heap.push(4, 20);
+    assert(heap.size() == 5);
+    assert(heap.top() == 3);
+    assert(heap.top_key() == 10);
+
+    // decrease_key
+    heap.decrease_key(0, 5);
+    assert(heap.top() == 0);
+    assert(heap.key(0) == 5);
+
+    // erase
+    heap.erase(3);
+    assert(!heap.contains(3));
+    assert(heap.size() == 4);
+
+    // push_or_decrease
+    assert(!heap.push_or_decrease(2, 45));
+    assert(heap.push_or_decrease(2, 15));
+    assert(heap.push_or_decrease(7, 1));
+
+    size_t expected[] = {7, 0, 2, 4, 1};
+    for (size_t h : expected) {
+        assert(heap.top() == h);
+        assert(heap.pop() == h);
+    }
+    assert(heap.empty());
+
+    // 错误用法
+    heap.push(5, 1);
+    try {
+        heap.push(5, 2);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+    }
+    try {
+        heap.decrease_key(5, 3);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+    }
+    try {
+        heap.push(10, 1);
+        assert(false);
+    } catch (const std::out_of_range&) {
+    }
+    heap.clear();
+    assert(heap.empty() && !heap.contains(5));
+}
+
+void test_indexed_heap() {
+    std::cout << "\n=== 测试indexed_heap ===" << std::endl;
+    check_addressable_heap<sugar::indexed_heap<int>>();
+    check_addressable_heap<sugar::indexed_heap<int, sugar::less<int>, 2>>();
+
+    // update可以双向调整
+    sugar::indexed_heap<int> heap(4);
+    heap.push(0, 1);
+    heap.push(1, 2);
+    heap.push(2, 3);
+    heap.update(0, 10);
+    assert(heap.top() == 1);
+    heap.update(2, 0);
+    assert(heap.top() == 2);
+    std::cout << "✓ push / pop / decrease_key / update / erase" << std::endl;
+}
+
+void test_pairing_heap() {
+    std::cout << "\n=== 测试pairing_heap ===" << std::endl;
+    check_addressable_heap<sugar::pairing_heap<int>>();
+
+    // 随机操作与排序结果一致
+    uint32_t seed = 3;
+    sugar::pairing_heap<int> heap(1000);
+    for (size_t i = 0; i < 1000; ++i) {
+        heap.push(i, static_cast<int>(lcg_next(seed) % 10000));
+    }
+    for (size_t i = 0; i < 1000; i += 3) {
+        heap.decrease_key(i, heap.key(i) - 5000);
+    }
+    for (size_t i = 1; i < 1000; i += 7) {
+        heap.erase(i);
+    }
+    int prev = -100000;
+    while (!heap.empty()) {
+        int k = heap.top_key();
+        assert(k >= prev);
+        prev = k;
+        heap.pop();
+    }
+    std::cout << "✓ push / pop / decrease_key / erase" << std::endl;
+}
+
+void test_radix_heap() {
+    std::cout << "\n=== 测试radix_heap ===" << std::endl;
+    sugar::radix_heap<uint32_t, int> heap;
+    heap.push(5, 50);
+    heap.push(1, 10);
+    heap.push(9, 90);
+    heap.push(1, 11);
+    assert(heap.size() == 4);
+    assert(heap.top().first == 1);
+    assert(heap.pop().first == 1);
+    assert(heap.pop().first == 1);
+    heap.push(3, 30);
+    assert(heap.pop().second == 30);
+    try {
+        heap.push(2, 20);  // 小于最近弹出的键
+        assert(false);
+    } catch (const std::invalid_argument&) {
+    }
+    assert(heap.pop().second == 50);
+    assert(heap.pop().second == 90);
+    assert(heap.empty());
+    std::cout << "✓ 单调push / pop" << std::endl;
+}
+
+void test_dijkstra() {
+    std::cout << "\n=== 测试Dijkstra ===" << std::endl;
+    graph g = make_graph(2000, 8, 11);
+    sugar::vector<uint64_t> ref = dijkstra_std(g, 0);
+    assert(dijkstra_addressable<sugar::indexed_heap<uint64_t>>(g, 0) == ref);
+    assert(dijkstra_addressable<sugar::pairing_heap<uint64_t>>(g, 0) == ref);
+    assert(dijkstra_radix(g, 0) == ref);
+    std::cout << "✓ 三种堆的最短路结果与std::priority_queue一致" << std::endl;
+}
+
+// 测试性能：合成图上的Dijkstra
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+    const uint32_t n = 200000;
+    const uint32_t degree = 8;
+    graph g = make_graph(n, degree, 5);
+
+    typedef std::chrono::steady_clock clock;
+    clock::time_point t0 = clock::now();
+    sugar::vector<uint64_t> d_std = dijkstra_std(g, 0);
+    clock::time_point t1 = clock::now();
+    sugar::vector<uint64_t> d_idx = dijkstra_addressable<sugar::indexed_heap<uint64_t>>(g, 0);
+    clock::time_point t2 = clock::now();
+    sugar::vector<uint64_t> d_pair = dijkstra_addressable<sugar::pairing_heap<uint64_t>>(g, 0);
+    clock::time_point t3 = clock::now();
+    sugar::vector<uint64_t> d_radix = dijkstra_radix(g, 0);
+    clock::time_point t4 = clock::now();
+    assert(d_idx == d_std && d_pair == d_std && d_radix == d_std);
+
+    typedef std::chrono::milliseconds ms;
+    std::cout << "顶点 " << n << "，边 " << n * degree << std::endl;
+    std::cout << "std::priority_queue (惰性删除): " << std::chrono::duration_cast<ms>(t1 - t0).count() << " ms" << std::endl;
+    std::cout << "sugar::indexed_heap:            " << std::chrono::duration_cast<ms>(t2 - t1).count() << " ms" << std::endl;
+    std::cout << "sugar::pairing_heap:            " << std::chrono::duration_cast<ms>(t3 - t2).count() << " ms" << std::endl;
+    std::cout << "sugar::radix_heap:              " << std::chrono::duration_cast<ms>(t4 - t3).count() << " ms" << std::endl;
+    std::cout << "✓ 合成图Dijkstra" << std::endl;
+}
@@ -0,0 +1,289 @@
+/*
+ * @file test_multi_searcher.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 多模式匹配测试
+ */
+
+#include "multi_searcher.h"
+#include "algorithm.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_basic();
+void test_engines();
+void test_exceptions();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Multi Searcher 测试 ===" << std::endl;
+
+    try {
+        test_basic();
+        test_engines();
+        test_exceptions();
+        test_performance();
+
+        std::cout << "\n🎉 All multi_searcher tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+typedef std::tuple<size_t, size_t, size_t> match_key;
+
+// 把匹配结果排序成(起点, 模式, 终点)，便于比较不同引擎
+static std::vector<match_key> normalize(const std::vector<sugar::multi_match>& matches) {
+    std::vector<match_key> keys;
+    for (const sugar::multi_match& m : matches) {
+        keys.push_back(match_key(m.begin, m.pattern, m.end));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// 朴素的参考实现：逐个模式查找所有（可重叠的）出现位置
+static std::vector<match_key> brute_force(const std::vector<std::string>& patterns, const std::string& text) {
+    std::vector<match_key> keys;
+    for (size_t id = 0; id < patterns.size(); ++id) {
+        const std::string& p = patterns[id];
+        for (size_t pos = text.find(p); pos != std::string::npos; pos = text.find(p, pos + 1)) {
+            keys.push_back(match_key(pos, id, pos + p.size()));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// 测试基本功能
+void test_basic() {
+    std::cout << "\n=== 测试基本功能 ===" << std::endl;
+
+    sugar::multi_searcher searcher;
+    assert(searcher.empty());
+    assert(searcher.add("he") == 0);
+    assert(searcher.add("she") == 1);
+    assert(searcher.add("his") == 2);
+    assert(searcher.add("hers") == 3);
+    assert(searcher.size() == 4);
+    searcher.compile(sugar::multi_searcher::aho_corasick);
+    assert(searcher.engine() == sugar::multi_searcher::aho_corasick);
+
+    const char* text = "ushers";
+    std::vector<sugar::multi_match> matches;
+    searcher.find_all(text, text + 6, std::back_inserter(matches));
+    // Aho-Corasick 按终点顺序报告："she"与"he"同在下标4结束
+    assert(matches.size() == 3);
+    assert(matches[0].end == 4 && matches[1].end == 4);
+    assert(matches[2].pattern == 3 && matches[2].begin == 2 && matches[2].end == 6);
+    std::cout << "✓ 经典例子 ushers：she / he / hers" << std::endl;
+
+    // 结果写入sugar::vector
+    sugar::vector<sugar::multi_match> out(8);
+    sugar::multi_match* end = searcher.find_all(text, text + 6, out.data());
+    assert(end - out.data() == 3);
+    std::cout << "✓ 通过输出迭代器报告匹配" << std::endl;
+
+    // 空文本
+    matches.clear();
+    searcher.find_all(text, text, std::back_inserter(matches));
+    assert(matches.empty());
+    std::cout << "✓ 空文本" << std::endl;
+}
+
+// 两种引擎与朴素实现一致
+void test_engines() {
+    std::cout << "\n=== 测试两种引擎 ===" << std::endl;
+
+    unsigned int seed = 5;
+    for (int round = 0; round < 200; ++round) {
+        unsigned int alphabet = 2 + lcg_next(seed) % 6;
+        size_t count = 1 + lcg_next(seed) % (round % 3 == 0 ? 40 : 8);
+        std::vector<std::string> patterns;
+        for (size_t i = 0; i < count; ++i) {
+            std::string p(1 + lcg_next(seed) % 6, 'a');
+            for (char& c : p) {
+                c = static_cast<char>('a' + lcg_next(seed) % alphabet);
+            }
+            patterns.push_back(p);
+        }
+        std::string text(lcg_next(seed) % 300, 'a');
+        for (char& c : text) {
+            c = static_cast<char>('a' + lcg_next(seed) % alphabet);
+        }
+        std::vector<match_key> expected = brute_force(patterns, text);
+
+        sugar::multi_searcher searcher;
+        for (const std::string& p : patterns) {
+            searcher.add(p.data(), p.data() + p.size());
+        }
+        const sugar::multi_searcher::engine_type engines[] = {
+            sugar::multi_searcher::aho_corasick, sugar::multi_searcher::teddy, sugar::multi_searcher::automatic};
+        for (sugar::multi_searcher::engine_type engine : engines) {
+            searcher.compile(engine);
+            std::vector<sugar::multi_match> matches;
+            searcher.find_all(text.data(), text.data() + text.size(), std::back_inserter(matches));
+            assert(normalize(matches) == expected);
+        }
+    }
+    std::cout << "✓ aho_corasick / teddy / automatic 与朴素实现一致（含重复与互为前后缀的模式）" << std::endl;
+
+    // 全部256个字节值都出现在模式中
+    sugar::multi_searcher all_bytes;
+    std::string text;
+    for (int c = 0; c < 256; ++c) {
+        char p[2] = {static_cast<char>(c), static_cast<char>(255 - c)};
+        all_bytes.add(p, p + 2);
+        text.push_back(p[0]);
+        text.push_back(p[1]);
+    }
+    all_bytes.compile();
+    assert(all_bytes.engine() == sugar::multi_searcher::aho_corasick);
+    std::vector<sugar::multi_match> matches;
+    all_bytes.find_all(text.data(), text.data() + text.size(), std::back_inserter(matches));
+    std::vector<std::string> patterns;
+    for (int c = 0; c < 256; ++c) {
+        patterns.push_back(std::string(1, static_cast<char>(c)) + static_cast<char>(255 - c));
+    }
+    assert(normalize(matches) == brute_force(patterns, text));
+    std::cout << "✓ 全字节字母表" << std::endl;
+
+    // 少量模式时自动选择teddy
+    sugar::multi_searcher small;
+    small.add("ERROR");
+    small.add("WARN");
+    small.compile();
+    assert(small.engine() == sugar::multi_searcher::teddy);
+    std::cout << "✓ 自动选择引擎" << std::endl;
+}
+
+// 测试异常
+void test_exceptions() {
+    std::cout << "\n=== 测试异常 ===" << std::endl;
+
+    sugar::multi_searcher searcher;
+    bool caught = false;
+    try {
+        searcher.add("");
+    } catch (const std::invalid_argument&) {
+        caught = true;
+    }
+    assert(caught);
+
+    searcher.add("x");
+    caught = false;
+    try {
+        std::vector<sugar::multi_match> matches;
+        const char* text = "xx";
+        searcher.find_all(text, text + 2, std::back_inserter(matches));
+    } catch (const std::logic_error&) {
+        caught = true;
+    }
+    assert(caught);
+    std::cout << "✓ 空模式 / 未编译时查找" << std::endl;
+}
+
+// 只计数的输出迭代器
+struct count_iterator {
+    size_t* count;
+    count_iterator& operator*() { return *this; }
+    count_iterator& operator=(const sugar::multi_match&) { ++*count; return *this; }
+    count_iterator& operator++() { return *this; }
+};
+
+// 测试性能：与逐个模式调用sugar::search比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    // 合成日志
+    static const char* const words[] = {
+        "request", "completed", "path=/api/v1/items", "status=200", "cache", "miss", "session", "database",
+        "connection", "reset", "peer", "reading", "response", "scheduled", "job", "compaction", "segments",
+        "slow", "query", "SELECT", "orders", "user_id=42", "took", "870ms", "worker", "INFO", "DEBUG", "WARN"};
+    const size_t word_count = sizeof(words) / sizeof(words[0]);
+    std::string log;
+    unsigned int seed = 11;
+    while (log.size() < (8u << 20)) {
+        log += words[lcg_next(seed) % word_count];
+        log.push_back(lcg_next(seed) % 12 == 0 ? '\n' : ' ');
+    }
+    const char* t0 = log.data();
+    const char* t1 = t0 + log.size();
+    const double bytes = static_cast<double>(log.size());
+
+    const size_t set_sizes[] = {4, 32, 1000};
+    for (size_t k : set_sizes) {
+        // 关键字：随机小写串，少量取自日志词表以保证有命中
+        std::vector<std::string> keywords;
+        for (size_t i = 0; i < k; ++i) {
+            if (i % 4 == 0 && i / 4 < word_count) {
+                keywords.push_back(words[i / 4]);
+            } else {
+                std::string w(5 + lcg_next(seed) % 8, 'a');
+                for (char& c : w) {
+                    c = static_cast<char>('a' + lcg_next(seed) % 26);
+                }
+                keywords.push_back(w);
+            }
+        }
+        sugar::multi_searcher searcher;
+        for (const std::string& w : keywords) {
+            searcher.add(w.data(), w.data() + w.size());
+        }
+
+        size_t loop_hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const std::string& w : keywords) {
+            sugar::byte_searcher single(w.data(), w.data() + w.size());
+            for (const char* it = t0; (it = sugar::search(it, t1, single)) != t1; ++it) {
+                ++loop_hits;
+            }
+        }
+        double loop_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const sugar::multi_searcher::engine_type engines[] = {
+            sugar::multi_searcher::aho_corasick, sugar::multi_searcher::teddy};
+        const char* names[] = {"aho_corasick", "teddy       "};
+        for (int e = 0; e < 2; ++e) {
+            searcher.compile(engines[e]);
+            if (searcher.engine() != engines[e]) {
+                continue;
+            }
+            size_t hits = 0;
+            count_iterator counter = {&hits};
+            start = std::chrono::steady_clock::now();
+            searcher.find_all(t0, t1, counter);
+            double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            assert(hits == loop_hits);
+            std::cout << k << " 个关键字 " << names[e] << ": " << bytes / s / 1e9 << " GB/s";
+            if (engines[e] == sugar::multi_searcher::aho_corasick) {
+                std::cout << " (转移表 " << searcher.table_bytes() / 1024 << " KB)";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << k << " 个关键字 逐个search:  " << bytes / loop_s / 1e9 << " GB/s (" << loop_hits << " 处命中)"
+                  << std::endl;
+    }
+    std::cout << "✓ " << log.size() / (1 << 20) << "MB 日志多关键字匹配" << std::endl;
+}
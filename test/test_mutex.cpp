@@ -0,0 +1,349 @@
+/*
+ * @file test_mutex.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 轻量锁测试
+ */
+
+#include "mutex.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_cache_aligned();
+void test_mutual_exclusion();
+void test_try_lock();
+void test_shared_spin_mutex();
+void test_ticket_order();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Mutex 测试 ===" << std::endl;
+
+    try {
+        test_cache_aligned();
+        test_mutual_exclusion();
+        test_try_lock();
+        test_shared_spin_mutex();
+        test_ticket_order();
+        test_performance();
+
+        std::cout << "\n🎉 All mutex tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试cache_aligned
+void test_cache_aligned() {
+    std::cout << "\n=== 测试 cache_aligned ===" << std::endl;
+
+    static_assert(alignof(sugar::cache_aligned<char>) == sugar::cache_line_size, "对齐到缓存行");
+    static_assert(sizeof(sugar::cache_aligned<char>) == sugar::cache_line_size, "补齐到缓存行");
+    static_assert(sizeof(sugar::cache_aligned<char[100]>) == 2 * sugar::cache_line_size, "补齐到整数倍");
+
+    sugar::cache_aligned<std::atomic<long>> counters[4];
+    for (int i = 0; i < 4; ++i) {
+        assert(reinterpret_cast<uintptr_t>(&counters[i]) % sugar::cache_line_size == 0);
+        counters[i]->store(i);
+    }
+    sugar::cache_aligned<int> v(42);
+    assert(*v == 42 && v.get() == 42);
+    std::cout << "✓ 对齐、大小与访问" << std::endl;
+
+    // 非const左值、const左值的拷贝与赋值都走拷贝而不是转发构造
+    sugar::cache_aligned<int> copy(v);
+    const sugar::cache_aligned<int>& cref = v;
+    sugar::cache_aligned<int> copy2(cref);
+    sugar::cache_aligned<int> moved(sugar::move(copy2));
+    copy = sugar::cache_aligned<int>(7);
+    assert(*copy == 7 && *moved == 42 && *v == 42);
+    sugar::cache_aligned<std::pair<int, long>> both(3, 4L);
+    assert(both->first == 3 && both->second == 4L);
+    std::cout << "✓ 拷贝、移动与多参数原地构造" << std::endl;
+}
+
+// 多线程在锁保护下做非原子的读-改-写，总数必须精确
+template<typename Lock>
+static void check_exclusion(const char* name) {
+    Lock lock;
+    long counter = 0;
+    const int threads = 4;
+    const int per_thread = 50000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&]() {
+            for (int i = 0; i < per_thread; ++i) {
+                std::lock_guard<Lock> guard(lock);
+                counter = counter + 1;
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    assert(counter == static_cast<long>(threads) * per_thread);
+    std::cout << "✓ " << name << "：" << threads << " 个线程各加锁 " << per_thread << " 次，计数精确" << std::endl;
+}
+
+void test_mutual_exclusion() {
+    std::cout << "\n=== 测试互斥 ===" << std::endl;
+
+    check_exclusion<sugar::spinlock>("spinlock");
+    check_exclusion<sugar::ticket_lock>("ticket_lock");
+    check_exclusion<sugar::adaptive_mutex>("adaptive_mutex");
+    check_exclusion<sugar::shared_spin_mutex>("shared_spin_mutex");
+}
+
+// 测试try_lock语义
+void test_try_lock() {
+    std::cout << "\n=== 测试 try_lock ===" << std::endl;
+
+    sugar::spinlock s;
+    assert(s.try_lock() && s.is_locked() && !s.try_lock());
+    s.unlock();
+    assert(!s.is_locked());
+
+    sugar::ticket_lock t;
+    assert(t.try_lock() && t.is_locked() && !t.try_lock());
+    t.unlock();
+    assert(!t.is_locked() && t.try_lock());
+    t.unlock();
+
+    sugar::adaptive_mutex m;
+    assert(m.try_lock() && m.is_locked() && !m.try_lock());
+    m.unlock();
+    assert(!m.is_locked());
+
+    // 持锁线程休眠足够久，让等待者进入futex休眠，再验证能被唤醒
+    m.lock();
+    std::atomic<bool> acquired(false);
+    std::thread waiter([&]() {
+        m.lock();
+        acquired = true;
+        m.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(!acquired.load());
+    m.unlock();
+    waiter.join();
+    assert(acquired.load() && !m.is_locked());
+    std::cout << "✓ try_lock 与休眠等待者的唤醒" << std::endl;
+}
+
+// 测试读写锁
+void test_shared_spin_mutex() {
+    std::cout << "\n=== 测试 shared_spin_mutex ===" << std::endl;
+
+    sugar::shared_spin_mutex rw;
+    rw.lock_shared();
+    assert(rw.try_lock_shared() && rw.readers() == 2 && !rw.try_lock());
+    rw.unlock_shared();
+    rw.unlock_shared();
+    assert(rw.readers() == 0 && rw.try_lock() && !rw.try_lock_shared());
+    rw.unlock();
+
+    // 写者等待期间新读者不能进入
+    rw.lock_shared();
+    std::atomic<bool> written(false);
+    std::thread writer([&]() {
+        rw.lock();
+        written = true;
+        rw.unlock();
+    });
+    while (rw.try_lock_shared()) {
+        rw.unlock_shared();
+        std::this_thread::yield();
+    }
+    assert(!written.load());
+    rw.unlock_shared();
+    writer.join();
+    assert(written.load() && rw.try_lock_shared());
+    rw.unlock_shared();
+    std::cout << "✓ 多读者共享、写者独占、写者优先" << std::endl;
+
+    // 读者看到的两个字段总是一致
+    long a = 0;
+    long b = 0;
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.push_back(std::thread([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                rw.lock_shared();
+                assert(a == b);
+                rw.unlock_shared();
+            }
+        }));
+    }
+    for (int i = 0; i < 20000; ++i) {
+        rw.lock();
+        ++a;
+        ++b;
+        rw.unlock();
+    }
+    stop = true;
+    for (size_t t = 0; t < readers.size(); ++t) {
+        readers[t].join();
+    }
+    assert(a == 20000 && b == 20000);
+    std::cout << "✓ 读写并发时读者不会看到写了一半的状态" << std::endl;
+}
+
+// 票据锁按取号顺序放行
+void test_ticket_order() {
+    std::cout << "\n=== 测试票据锁顺序 ===" << std::endl;
+
+    sugar::ticket_lock lock;
+    lock.lock();
+    std::vector<int> order;
+    std::atomic<int> arrived(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        // 逐个启动，保证取号顺序就是线程编号
+        workers.push_back(std::thread([&, t]() {
+            ++arrived;
+            lock.lock();
+            order.push_back(t);
+            lock.unlock();
+        }));
+        while (arrived.load() != t + 1) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    lock.unlock();
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    assert(order.size() == 4);
+    for (int t = 0; t < 4; ++t) {
+        assert(order[t] == t);
+    }
+    std::cout << "✓ 先来先得" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 短临界区：更新同一缓存行上的几个计数；临界区外做少量本地计算
+struct shared_state {
+    uint64_t slots[8];
+};
+
+template<typename Lock>
+static double contention(int threads, int ops) {
+    Lock lock;
+    sugar::cache_aligned<shared_state> state;
+    for (int i = 0; i < 8; ++i) {
+        state->slots[i] = 0;
+    }
+    double s = seconds([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&, t]() {
+                unsigned int seed = static_cast<unsigned int>(t + 1);
+                const int n = ops / threads;
+                for (int i = 0; i < n; ++i) {
+                    const unsigned r = lcg_next(seed);
+                    lock.lock();
+                    state->slots[r & 7] += r;
+                    ++state->slots[0];
+                    lock.unlock();
+                }
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    });
+    assert(state->slots[0] >= static_cast<uint64_t>(ops / threads) * threads);
+    return ops / s / 1e6;
+}
+
+// 读多写少：90%共享锁
+template<typename Lock, typename ReadLock, typename ReadUnlock>
+static double read_mostly(int threads, int ops, ReadLock read_lock, ReadUnlock read_unlock) {
+    Lock lock;
+    sugar::cache_aligned<shared_state> state;
+    for (int i = 0; i < 8; ++i) {
+        state->slots[i] = 0;
+    }
+    std::atomic<uint64_t> sink(0);
+    double s = seconds([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&, t]() {
+                unsigned int seed = static_cast<unsigned int>(t + 1);
+                const int n = ops / threads;
+                uint64_t sum = 0;
+                for (int i = 0; i < n; ++i) {
+                    const unsigned r = lcg_next(seed);
+                    if (r % 10 == 0) {
+                        lock.lock();
+                        state->slots[r & 7] += r;
+                        lock.unlock();
+                    } else {
+                        read_lock(lock);
+                        sum += state->slots[r & 7];
+                        read_unlock(lock);
+                    }
+                }
+                sink += sum;  // 防止读被优化掉
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    });
+    return ops / s / 1e6;
+}
+
+// 测试性能：不同线程数下的吞吐曲线（Mops/s）
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int ops = 400000;
+    std::cout << "短临界区争用曲线，共 " << ops << " 次加锁（Mops/s）：" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16}) {
+        std::cout << "  " << threads << " 线程: std::mutex " << contention<std::mutex>(threads, ops) << ", spinlock "
+                  << contention<sugar::spinlock>(threads, ops) << ", ticket_lock "
+                  << contention<sugar::ticket_lock>(threads, ops) << ", adaptive_mutex "
+                  << contention<sugar::adaptive_mutex>(threads, ops) << std::endl;
+    }
+    std::cout << "90% 读 10% 写（Mops/s）：" << std::endl;
+    for (int threads : {1, 4, 16}) {
+        const double mutex_rate = read_mostly<std::mutex>(
+            threads, ops, [](std::mutex& m) { m.lock(); }, [](std::mutex& m) { m.unlock(); });
+        const double shared_rate = read_mostly<sugar::shared_spin_mutex>(
+            threads, ops, [](sugar::shared_spin_mutex& m) { m.lock_shared(); },
+            [](sugar::shared_spin_mutex& m) { m.unlock_shared(); });
+        std::cout << "  " << threads << " 线程: std::mutex " << mutex_rate << ", shared_spin_mutex " << shared_rate
+                  << std::endl;
+    }
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
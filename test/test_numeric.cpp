@@ -0,0 +1,299 @@
+/*
+ * @file test_numeric.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 数值算法测试
+ */
+
+#include "numeric.h"
+#include "functional.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_sequential();
+void test_reduce();
+void test_compensated_sum();
+void test_scan();
+void test_parallel();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Numeric 测试 ===" << std::endl;
+
+    try {
+        test_sequential();
+        test_reduce();
+        test_compensated_sum();
+        test_scan();
+        test_parallel();
+        test_performance();
+
+        std::cout << "\n🎉 All numeric tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试顺序算法
+void test_sequential() {
+    std::cout << "\n=== 测试顺序算法 ===" << std::endl;
+
+    int a[10];
+    sugar::iota(a, a + 10, 1);
+    for (int i = 0; i < 10; ++i) {
+        assert(a[i] == i + 1);
+    }
+    std::cout << "✓ iota" << std::endl;
+
+    assert(sugar::accumulate(a, a + 10, 0) == 55);
+    assert(sugar::accumulate(a, a + 5, 1, sugar::multiplies<int>()) == 120);
+    assert(sugar::accumulate(a, a, 7) == 7);
+    std::cout << "✓ accumulate" << std::endl;
+
+    int b[10];
+    sugar::iota(b, b + 10, 0);
+    assert(sugar::inner_product(a, a + 10, b, 0) == std::inner_product(a, a + 10, b, 0));
+    assert(sugar::inner_product(a, a + 3, b, 0, sugar::plus<int>(), sugar::minus<int>()) == 3);
+    std::cout << "✓ inner_product" << std::endl;
+}
+
+// 测试可重结合归约
+void test_reduce() {
+    std::cout << "\n=== 测试可重结合归约 ===" << std::endl;
+
+    unsigned int seed = 7;
+    for (int n = 0; n < 200; ++n) {
+        std::vector<int> vi(n);
+        std::vector<double> vd(n);
+        std::vector<float> vf(n);
+        for (int i = 0; i < n; ++i) {
+            vi[i] = static_cast<int>(lcg_next(seed)) - 16384;
+            vd[i] = static_cast<double>(lcg_next(seed)) / 64.0;
+            vf[i] = static_cast<float>(lcg_next(seed) % 256) / 4.0f;
+        }
+        const int* pi = vi.data();
+        const double* pd = vd.data();
+        const float* pf = vf.data();
+
+        assert(sugar::reduce(pi, pi + n) == std::accumulate(pi, pi + n, 0));
+        assert(sugar::reduce(pi, pi + n, 5) == std::accumulate(pi, pi + n, 5));
+        assert(sugar::reduce(pi, pi + n, 0LL, sugar::plus<long long>()) == std::accumulate(pi, pi + n, 0LL));
+        // 这些数据的和在double/float中可精确表示，重结合不影响结果
+        assert(sugar::reduce(pd, pd + n, 0.0) == std::accumulate(pd, pd + n, 0.0));
+        assert(sugar::reduce(pf, pf + n, 0.0f) == std::accumulate(pf, pf + n, 0.0f));
+
+        assert(sugar::transform_reduce(pi, pi + n, 0LL, sugar::plus<long long>(),
+                                       [](int x) { return static_cast<long long>(x) * x; }) ==
+               std::inner_product(pi, pi + n, pi, 0LL));
+        assert(sugar::transform_reduce(pd, pd + n, pd, 0.0) == std::inner_product(pd, pd + n, pd, 0.0));
+        assert(sugar::transform_reduce(pf, pf + n, pf, 0.0f) == std::inner_product(pf, pf + n, pf, 0.0f));
+        assert(sugar::transform_reduce(pi, pi + n, pi, 0) == std::inner_product(pi, pi + n, pi, 0));
+    }
+    std::cout << "✓ reduce 与 std::accumulate 一致（int/float/double）" << std::endl;
+    std::cout << "✓ transform_reduce 一元/二元形式" << std::endl;
+
+    // 自定义的可结合操作：取最大值
+    int arr[] = {3, 9, 2, 7, 9, 1, 8, 4, 6, 5, 0};
+    assert(sugar::reduce(arr, arr + 11, -1, [](int x, int y) { return x > y ? x : y; }) == 9);
+    std::cout << "✓ 自定义操作" << std::endl;
+}
+
+// 测试补偿求和
+void test_compensated_sum() {
+    std::cout << "\n=== 测试补偿求和 ===" << std::endl;
+
+    // 1 + 大量小量：朴素求和会丢掉全部小量
+    const int n = 1000000;
+    std::vector<float> v(n + 1, 1e-8f);
+    v[0] = 1.0f;
+    double exact = 1.0 + static_cast<double>(n) * static_cast<double>(1e-8f);
+
+    float naive = sugar::accumulate(v.data(), v.data() + v.size(), 0.0f);
+    float kahan = sugar::kahan_sum(v.data(), v.data() + v.size(), 0.0f);
+    float pairwise = sugar::pairwise_sum(v.data(), v.data() + v.size(), 0.0f);
+    assert(naive == 1.0f);
+    assert(std::fabs(kahan - exact) < 1e-4);
+    assert(std::fabs(pairwise - exact) < 1e-4);
+    std::cout << "✓ kahan_sum 误差 " << std::fabs(kahan - exact)
+              << "，pairwise_sum 误差 " << std::fabs(pairwise - exact)
+              << "，朴素求和误差 " << std::fabs(naive - exact) << std::endl;
+
+    // Neumaier 变体：加数比累加值大时也能补偿
+    double big[] = {1.0, 1e100, 1.0, -1e100};
+    assert(sugar::kahan_sum(big, big + 4, 0.0) == 2.0);
+    std::cout << "✓ kahan_sum 处理大数抵消" << std::endl;
+
+    assert(sugar::pairwise_sum(big, big, 3.0) == 3.0);
+    assert(sugar::kahan_sum(big, big, 3.0) == 3.0);
+    std::cout << "✓ 空区间" << std::endl;
+}
+
+// 测试扫描
+void test_scan() {
+    std::cout << "\n=== 测试扫描 ===" << std::endl;
+
+    unsigned int seed = 11;
+    for (int n = 0; n < 100; ++n) {
+        std::vector<int> in(n);
+        std::vector<float> fin(n);
+        for (int i = 0; i < n; ++i) {
+            in[i] = static_cast<int>(lcg_next(seed)) - 16384;
+            fin[i] = static_cast<float>(lcg_next(seed) % 64);
+        }
+        std::vector<int> expected(n);
+        std::partial_sum(in.begin(), in.end(), expected.begin());
+
+        std::vector<int> out(n);
+        int* e = sugar::inclusive_scan(in.data(), in.data() + n, out.data());
+        assert(e == out.data() + n);
+        assert(out == expected);
+
+        std::vector<int> inplace = in;
+        sugar::inclusive_scan(inplace.data(), inplace.data() + n, inplace.data());
+        assert(inplace == expected);
+
+        std::vector<float> fout(n), fexpected(n);
+        std::partial_sum(fin.begin(), fin.end(), fexpected.begin());
+        sugar::inclusive_scan(fin.data(), fin.data() + n, fout.data());
+        assert(fout == fexpected);
+
+        std::vector<long long> lout(n);
+        sugar::inclusive_scan(in.data(), in.data() + n, lout.data(), sugar::plus<long long>(), 100LL);
+        for (int i = 0; i < n; ++i) {
+            assert(lout[i] == expected[i] + 100LL);
+        }
+
+        sugar::exclusive_scan(in.data(), in.data() + n, out.data(), 0);
+        for (int i = 0; i < n; ++i) {
+            assert(out[i] == (i == 0 ? 0 : expected[i - 1]));
+        }
+    }
+    std::cout << "✓ inclusive_scan（SIMD int/float，含原地扫描）" << std::endl;
+    std::cout << "✓ inclusive_scan 带初始值" << std::endl;
+    std::cout << "✓ exclusive_scan" << std::endl;
+
+    int arr[] = {1, 2, 3, 4};
+    int prod[4];
+    sugar::exclusive_scan(arr, arr + 4, prod, 1, sugar::multiplies<int>());
+    assert(prod[0] == 1 && prod[1] == 1 && prod[2] == 2 && prod[3] == 6);
+    sugar::inclusive_scan(arr, arr + 4, prod, sugar::multiplies<int>());
+    assert(prod[0] == 1 && prod[1] == 2 && prod[2] == 6 && prod[3] == 24);
+    std::cout << "✓ 自定义操作扫描" << std::endl;
+}
+
+// 测试多线程归约与扫描
+void test_parallel() {
+    std::cout << "\n=== 测试多线程归约与扫描 ===" << std::endl;
+
+    unsigned int seed = 13;
+    const int sizes[] = {0, 1, 4095, 4096, 10000, 100003};
+    for (int n : sizes) {
+        std::vector<int> in(n);
+        for (int i = 0; i < n; ++i) {
+            in[i] = static_cast<int>(lcg_next(seed)) - 16384;
+        }
+        std::vector<int> expected(n);
+        std::partial_sum(in.begin(), in.end(), expected.begin());
+        long long total = std::accumulate(in.begin(), in.end(), 0LL);
+
+        for (size_t threads = 1; threads <= 8; ++threads) {
+            assert(sugar::parallel_reduce(in.data(), in.data() + n, 0LL, sugar::plus<long long>(), threads) ==
+                   total);
+
+            std::vector<int> out(n);
+            sugar::parallel_inclusive_scan(in.data(), in.data() + n, out.data(), sugar::plus<int>(), threads);
+            assert(out == expected);
+
+            std::vector<int> inplace = in;
+            sugar::parallel_inclusive_scan(inplace.data(), inplace.data() + n, inplace.data(),
+                                           sugar::plus<int>(), threads);
+            assert(inplace == expected);
+
+            std::vector<long long> ex(n);
+            sugar::parallel_exclusive_scan(in.data(), in.data() + n, ex.data(), 10LL,
+                                           sugar::plus<long long>(), threads);
+            for (int i = 0; i < n; ++i) {
+                assert(ex[i] == 10LL + (i == 0 ? 0 : expected[i - 1]));
+            }
+        }
+
+        std::vector<int> out(n);
+        sugar::parallel_inclusive_scan(in.data(), in.data() + n, out.data());
+        assert(out == expected);
+    }
+    std::cout << "✓ parallel_reduce 与顺序结果一致" << std::endl;
+    std::cout << "✓ parallel_inclusive_scan（含原地扫描）" << std::endl;
+    std::cout << "✓ parallel_exclusive_scan" << std::endl;
+}
+
+// 测试性能：报告各线程数下的带宽
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = 1 << 24;
+    std::vector<float> data(n);
+    std::vector<int> idata(n);
+    unsigned int seed = 17;
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = static_cast<float>(lcg_next(seed) % 16);
+        idata[i] = static_cast<int>(lcg_next(seed) % 16);
+    }
+    const float* first = data.data();
+    const float* last = first + n;
+    const double bytes = static_cast<double>(n) * sizeof(float);
+
+    auto start = std::chrono::steady_clock::now();
+    volatile float std_sum = std::accumulate(first, last, 0.0f);
+    auto mid = std::chrono::steady_clock::now();
+    volatile float sugar_sum = sugar::reduce(first, last, 0.0f);
+    auto end = std::chrono::steady_clock::now();
+    (void)std_sum;
+    (void)sugar_sum;
+    double std_s = std::chrono::duration<double>(mid - start).count();
+    double sugar_s = std::chrono::duration<double>(end - mid).count();
+    std::cout << "std::accumulate<float>: " << bytes / std_s / 1e9 << " GB/s" << std::endl;
+    std::cout << "sugar::reduce<float>:   " << bytes / sugar_s / 1e9 << " GB/s" << std::endl;
+
+    std::vector<int> out(n);
+    start = std::chrono::steady_clock::now();
+    std::partial_sum(idata.begin(), idata.end(), out.begin());
+    mid = std::chrono::steady_clock::now();
+    sugar::inclusive_scan(idata.data(), idata.data() + n, out.data());
+    end = std::chrono::steady_clock::now();
+    std_s = std::chrono::duration<double>(mid - start).count();
+    sugar_s = std::chrono::duration<double>(end - mid).count();
+    std::cout << "std::partial_sum<int>:       " << bytes / std_s / 1e9 << " GB/s" << std::endl;
+    std::cout << "sugar::inclusive_scan<int>:  " << bytes / sugar_s / 1e9 << " GB/s" << std::endl;
+
+    size_t max_threads = sugar::default_thread_count();
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        start = std::chrono::steady_clock::now();
+        volatile float psum = sugar::parallel_reduce(first, last, 0.0f, sugar::plus<float>(), threads);
+        mid = std::chrono::steady_clock::now();
+        sugar::parallel_inclusive_scan(idata.data(), idata.data() + n, out.data(), sugar::plus<int>(), threads);
+        end = std::chrono::steady_clock::now();
+        (void)psum;
+        double reduce_s = std::chrono::duration<double>(mid - start).count();
+        double scan_s = std::chrono::duration<double>(end - mid).count();
+        std::cout << threads << " 线程: parallel_reduce " << bytes / reduce_s / 1e9
+                  << " GB/s, parallel_inclusive_scan " << bytes / scan_s / 1e9 << " GB/s" << std::endl;
+    }
+    std::cout << "✓ " << n << " 个元素的归约与扫描" << std::endl;
+}
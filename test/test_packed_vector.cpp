@@ -0,0 +1,305 @@
+/*
+ * @file test_packed_vector.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 压缩整数序列测试
+ */
+
+#include "packed_vector.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+static uint64_t random_u64(unsigned int& state) {
+    uint64_t v = 0;
+    for (int i = 0; i < 5; ++i) {
+        v = (v << 15) ^ lcg_next(state);
+    }
+    return v;
+}
+
+// 测试函数声明
+void test_packed_vector();
+void test_delta_vector();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Packed Vector 测试 ===" << std::endl;
+
+    try {
+        test_packed_vector();
+        test_delta_vector();
+        test_performance();
+
+        std::cout << "\n🎉 All packed_vector tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 单个位宽的随机测试
+template<unsigned Bits>
+static void check_bits() {
+    const uint64_t mask = sugar::packed_vector<Bits>::max_value();
+    sugar::packed_vector<Bits> pv;
+    std::vector<uint64_t> model;
+    unsigned int seed = Bits;
+    for (int i = 0; i < 3000; ++i) {
+        const uint64_t v = random_u64(seed) & mask;
+        pv.push_back(v);
+        model.push_back(v);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        const size_t k = lcg_next(seed) % model.size();
+        model[k] = random_u64(seed) & mask;
+        pv.set(k, model[k]);
+    }
+    for (size_t i = 0; i < model.size(); ++i) {
+        assert(pv[i] == model[i]);
+    }
+    // 各种对齐的批量解码
+    std::vector<uint64_t> out(model.size());
+    for (int r = 0; r < 50; ++r) {
+        const size_t first = lcg_next(seed) % model.size();
+        const size_t count = lcg_next(seed) % (model.size() - first + 1);
+        pv.decode(first, count, out.data());
+        for (size_t i = 0; i < count; ++i) {
+            assert(out[i] == model[first + i]);
+        }
+    }
+    sugar::vector<uint64_t> all;
+    pv.decode(all);
+    assert(all.size() == model.size());
+    for (size_t i = 0; i < model.size(); ++i) {
+        assert(all[i] == model[i]);
+    }
+    // 缩短后再增长，旧值不残留
+    pv.resize(100);
+    pv.resize(200, mask);
+    assert(pv.size() == 200 && pv[99] == model[99] && pv[100] == mask && pv.back() == mask);
+    pv.pop_back();
+    pv.push_back(0);
+    assert(pv.back() == 0 && pv[198] == mask);
+}
+
+// 测试packed_vector
+void test_packed_vector() {
+    std::cout << "\n=== 测试 packed_vector ===" << std::endl;
+
+    check_bits<1>();
+    check_bits<3>();
+    check_bits<7>();
+    check_bits<13>();
+    check_bits<31>();
+    check_bits<32>();
+    check_bits<33>();
+    check_bits<57>();
+    check_bits<63>();
+    check_bits<64>();
+    std::cout << "✓ 10种位宽的 push_back / set / 随机访问 / 批量解码 / resize" << std::endl;
+
+    sugar::packed_vector<12> pv(1000, 4095);
+    assert(pv.size() == 1000 && pv[999] == 4095);
+    assert(pv.memory_bytes() <= (1000 * 12 / 64 + 2) * 8);
+    int thrown = 0;
+    try {
+        pv.push_back(4096);
+    } catch (const std::out_of_range&) {
+        ++thrown;
+    }
+    try {
+        pv.at(1000);
+    } catch (const std::out_of_range&) {
+        ++thrown;
+    }
+    assert(thrown == 2 && pv.size() == 1000);
+    std::cout << "✓ 内存按位宽计，超宽的值与越界下标抛出 out_of_range" << std::endl;
+}
+
+// 与逐值比对检查delta_vector
+static void check_delta(const std::vector<uint64_t>& model) {
+    sugar::delta_vector dv;
+    for (size_t i = 0; i < model.size(); ++i) {
+        dv.push_back(model[i]);
+    }
+    assert(dv.size() == model.size());
+    for (size_t i = 0; i < model.size(); ++i) {
+        assert(dv[i] == model[i]);
+    }
+    std::vector<uint64_t> out(model.size() + 1);
+    unsigned int seed = static_cast<unsigned int>(model.size());
+    for (int r = 0; r < 50; ++r) {
+        const size_t first = (lcg_next(seed) << 15 | lcg_next(seed)) % (model.size() + 1);
+        const size_t count = (lcg_next(seed) << 15 | lcg_next(seed)) % (model.size() - first + 1);
+        dv.decode(first, count, out.data());
+        for (size_t i = 0; i < count; ++i) {
+            assert(out[i] == model[first + i]);
+        }
+    }
+    sugar::vector<uint64_t> all;
+    dv.decode(all);
+    for (size_t i = 0; i < model.size(); ++i) {
+        assert(all[i] == model[i]);
+    }
+}
+
+// 测试delta_vector
+void test_delta_vector() {
+    std::cout << "\n=== 测试 delta_vector ===" << std::endl;
+
+    unsigned int seed = 77;
+    std::vector<uint64_t> timestamps;
+    uint64_t t = 1760000000000ull;
+    for (int i = 0; i < 10000; ++i) {
+        t += lcg_next(seed) % 50;
+        timestamps.push_back(t);
+    }
+    check_delta(timestamps);
+
+    // 块内各种位宽：常量（0位）、窄、32位边界、超过32位、全64位
+    std::vector<uint64_t> mixed;
+    const unsigned widths[] = {0, 1, 5, 17, 31, 32, 33, 48, 63, 64};
+    for (unsigned w : widths) {
+        const uint64_t range = w == 64 ? ~uint64_t(0) : (uint64_t(1) << w) - 1;
+        const uint64_t base = w == 64 ? 0 : random_u64(seed) & ~range;
+        for (int i = 0; i < 128; ++i) {
+            // 每块至少出现一次最大差值，保证位宽恰好为w
+            mixed.push_back(base + (i == 77 ? range : random_u64(seed) & range));
+        }
+    }
+    for (int i = 0; i < 57; ++i) {
+        mixed.push_back(random_u64(seed));
+    }
+    check_delta(mixed);
+    check_delta(std::vector<uint64_t>(1, 42));
+    std::cout << "✓ 时间戳、各种块内位宽与不满一块的尾部，随机访问与批量解码一致" << std::endl;
+
+    sugar::delta_vector dv;
+    bool threw = false;
+    try {
+        dv.at(0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw && dv.empty());
+    for (uint64_t i = 0; i < 1280; ++i) {
+        dv.push_back(1000000 + i);
+    }
+    // 每块差值0..127占7位：128*7/8 = 112字节数据 + 块头
+    dv.shrink_to_fit();
+    assert(dv.memory_bytes() < 10 * (112 + 32));
+    dv.clear();
+    assert(dv.empty());
+    std::cout << "✓ 连续值每个约7位，at 越界抛出 out_of_range" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：压缩率与解码吞吐
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = 4 * 1024 * 1024;
+    const int rounds = 5;
+    const double raw_bytes = static_cast<double>(n * sizeof(uint64_t));
+    sugar::vector<uint64_t> raw(n);
+    sugar::vector<uint64_t> out(n);
+    unsigned int seed = 9;
+    uint64_t sink = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        raw[i] = random_u64(seed);
+    }
+    double copy_s = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            std::memcpy(out.data(), raw.data(), n * sizeof(uint64_t));
+            sink += out[static_cast<size_t>(r)];
+        }
+    });
+    std::cout << "基准 memcpy: " << raw_bytes * rounds / copy_s / 1e9 << " GB/s" << std::endl;
+
+    // 计数：小于1000的值，定宽10位
+    sugar::packed_vector<10> counts;
+    counts.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        raw[i] = lcg_next(seed) % 1000;
+        counts.push_back(raw[i]);
+    }
+    double counts_s = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            counts.decode(out);
+            sink += out[static_cast<size_t>(r)];
+        }
+    });
+    assert(out[n - 1] == raw[n - 1]);
+    std::cout << "计数 packed_vector<10>: 压缩比 " << raw_bytes / counts.memory_bytes() << "x, 解码 "
+              << raw_bytes * rounds / counts_s / 1e9 << " GB/s" << std::endl;
+
+    // 时间戳：毫秒级，相邻间隔0~49
+    sugar::delta_vector stamps;
+    uint64_t t = 1760000000000ull;
+    for (size_t i = 0; i < n; ++i) {
+        t += lcg_next(seed) % 50;
+        raw[i] = t;
+        stamps.push_back(t);
+    }
+    stamps.shrink_to_fit();
+    double stamps_s = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            stamps.decode(out);
+            sink += out[static_cast<size_t>(r)];
+        }
+    });
+    assert(out[n - 1] == raw[n - 1]);
+    const int probes = 1000000;
+    double stamps_random = seconds([&] {
+        for (int i = 0; i < probes; ++i) {
+            sink += stamps[(lcg_next(seed) << 15 | lcg_next(seed)) % n];
+        }
+    });
+    std::cout << "时间戳 delta_vector: 压缩比 " << raw_bytes / stamps.memory_bytes() << "x, 解码 "
+              << raw_bytes * rounds / stamps_s / 1e9 << " GB/s, 随机访问 " << stamps_random / probes * 1e9
+              << " ns" << std::endl;
+
+    // ID：稀疏递增，间隔0~30000
+    sugar::delta_vector ids;
+    uint64_t id = 0;
+    for (size_t i = 0; i < n; ++i) {
+        id += lcg_next(seed);
+        raw[i] = id;
+        ids.push_back(id);
+    }
+    ids.shrink_to_fit();
+    double ids_s = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            ids.decode(out);
+            sink += out[static_cast<size_t>(r)];
+        }
+    });
+    assert(out[n / 2] == raw[n / 2]);
+    std::cout << "递增ID delta_vector: 压缩比 " << raw_bytes / ids.memory_bytes() << "x, 解码 "
+              << raw_bytes * rounds / ids_s / 1e9 << " GB/s (" << (sink & 1) << ")" << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
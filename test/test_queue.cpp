@@ -0,0 +1,220 @@
+/*
+ * @file test_queue.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL priority_queue容器适配器测试
+ */
+
+#include "queue.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <queue>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_basic();
+void test_arity();
+void test_push_range();
+void test_exceptions();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Priority Queue 测试 ===" << std::endl;
+
+    try {
+        test_basic();
+        test_arity();
+        test_push_range();
+        test_exceptions();
+        test_performance();
+
+        std::cout << "\n🎉 All priority_queue tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试基本操作
+void test_basic() {
+    std::cout << "\n=== 测试基本操作 ===" << std::endl;
+
+    sugar::priority_queue<int> pq;
+    assert(pq.empty());
+    assert(pq.size() == 0);
+    assert(sugar::priority_queue<int>::arity == 4);
+
+    int arr[] = {3, 1, 4, 1, 5, 9, 2, 6};
+    for (int x : arr) {
+        pq.push(x);
+    }
+    assert(pq.size() == 8);
+    assert(pq.top() == 9);
+    std::cout << "✓ push / top" << std::endl;
+
+    int expected[] = {9, 6, 5, 4, 3, 2, 1, 1};
+    for (int x : expected) {
+        assert(pq.top() == x);
+        pq.pop();
+    }
+    assert(pq.empty());
+    std::cout << "✓ pop 按优先级顺序" << std::endl;
+
+    // 小顶堆
+    sugar::priority_queue<int, sugar::vector<int>, sugar::greater<int>> min_pq(arr, arr + 8);
+    assert(min_pq.top() == 1);
+    min_pq.emplace(0);
+    assert(min_pq.top() == 0);
+    std::cout << "✓ 迭代器构造 / 小顶堆 / emplace" << std::endl;
+
+    // swap
+    sugar::priority_queue<int> a;
+    sugar::priority_queue<int> b;
+    a.push(1);
+    b.push(2);
+    b.push(3);
+    a.swap(b);
+    assert(a.size() == 2 && a.top() == 3);
+    assert(b.size() == 1 && b.top() == 1);
+    std::cout << "✓ swap" << std::endl;
+}
+
+// 测试不同叉数与std::priority_queue结果一致
+template<size_t Arity>
+void check_against_std() {
+    unsigned int seed = static_cast<unsigned int>(Arity);
+    sugar::priority_queue<int, sugar::vector<int>, sugar::less<int>, Arity> pq;
+    std::priority_queue<int> ref;
+    for (int i = 0; i < 5000; ++i) {
+        int op = static_cast<int>(lcg_next(seed) % 3);
+        if (op < 2 || ref.empty()) {
+            int x = static_cast<int>(lcg_next(seed) % 1000);
+            pq.push(x);
+            ref.push(x);
+        } else {
+            assert(pq.top() == ref.top());
+            pq.pop();
+            ref.pop();
+        }
+        assert(pq.size() == ref.size());
+    }
+    while (!ref.empty()) {
+        assert(pq.top() == ref.top());
+        pq.pop();
+        ref.pop();
+    }
+}
+
+void test_arity() {
+    std::cout << "\n=== 测试不同叉数 ===" << std::endl;
+    check_against_std<2>();
+    check_against_std<3>();
+    check_against_std<4>();
+    check_against_std<8>();
+    std::cout << "✓ 2/3/4/8叉堆与std::priority_queue结果一致" << std::endl;
+}
+
+// 测试批量插入
+void test_push_range() {
+    std::cout << "\n=== 测试批量插入 ===" << std::endl;
+
+    unsigned int seed = 99;
+    sugar::vector<int> data;
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back(static_cast<int>(lcg_next(seed) % 10000));
+    }
+
+    // 大批量：整体重新建堆
+    sugar::priority_queue<int> pq;
+    pq.push(5);
+    pq.push_range(data.begin(), data.end());
+    assert(pq.size() == 1001);
+
+    // 小批量：逐个上浮
+    int small[] = {20000, -1, 15000};
+    pq.push_range(small, small + 3);
+    assert(pq.size() == 1004);
+
+    int prev = pq.top();
+    assert(prev == 20000);
+    while (!pq.empty()) {
+        assert(pq.top() <= prev);
+        prev = pq.top();
+        pq.pop();
+    }
+    assert(prev == -1);
+    std::cout << "✓ push_range" << std::endl;
+}
+
+// 测试异常
+void test_exceptions() {
+    std::cout << "\n=== 测试异常 ===" << std::endl;
+
+    sugar::priority_queue<int> pq;
+    try {
+        pq.top();
+        assert(false);
+    } catch (const std::out_of_range&) {
+        // 期望的异常
+    }
+    try {
+        pq.pop();
+        assert(false);
+    } catch (const std::out_of_range&) {
+        // 期望的异常
+    }
+    std::cout << "✓ 空队列访问异常" << std::endl;
+}
+
+// 测试性能：与std::priority_queue对比
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int n = 1000000;
+    unsigned int seed = 1;
+    std::vector<int> data(n);
+    for (int i = 0; i < n; ++i) {
+        data[i] = static_cast<int>((lcg_next(seed) << 15) | lcg_next(seed));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    sugar::priority_queue<int> pq;
+    for (int x : data) {
+        pq.push(x);
+    }
+    long long sugar_sum = 0;
+    while (!pq.empty()) {
+        sugar_sum += pq.top();
+        pq.pop();
+    }
+    auto mid = std::chrono::steady_clock::now();
+    std::priority_queue<int> ref;
+    for (int x : data) {
+        ref.push(x);
+    }
+    long long std_sum = 0;
+    while (!ref.empty()) {
+        std_sum += ref.top();
+        ref.pop();
+    }
+    auto end = std::chrono::steady_clock::now();
+    assert(sugar_sum == std_sum);
+
+    std::cout << "sugar::priority_queue (4叉): "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(mid - start).count() << " ms" << std::endl;
+    std::cout << "std::priority_queue:         "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - mid).count() << " ms" << std::endl;
+    std::cout << "✓ " << n << " 次 push/pop" << std::endl;
+}
@@ -0,0 +1,449 @@
+/*
+ * @file test_reclamation.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 内存回收测试
+ */
+
+#include "reclamation.h"
+#include "vector.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 统计释放次数的分配器，析构时先把对象写坏，便于暴露过早回收
+static std::atomic<long> g_freed(0);
+
+template<typename T>
+struct counting_allocator : sugar::allocator<T> {
+    template<typename U>
+    void destroy(U* p) {
+        p->poison();
+        sugar::destroy(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ++g_freed;
+        sugar::allocator<T>::deallocate(p, n);
+    }
+};
+
+struct tracked {
+    uint64_t value;
+
+    void poison() { value = 0xdeaddeaddeaddeadull; }
+};
+
+// ============================ 读多写少的无锁链表 ============================
+
+// 节点按键有序，写者（互斥串行）以复制替换的方式更新值，读者无锁遍历。
+// 替换前先置removed再摘链，读者据此判断前驱是否仍在链上（危险指针需要这一步校验）
+struct list_node {
+    uint64_t key;
+    uint64_t value;
+    uint64_t check;
+    std::atomic<list_node*> next;
+    std::atomic<bool> removed;
+
+    list_node(uint64_t k, uint64_t v, list_node* n) : key(k), value(v), check(k ^ (v * 0x9e3779b97f4a7c15ull)), next(n), removed(false) {}
+
+    void poison() { check = ~check; }
+    bool valid() const { return check == (key ^ (value * 0x9e3779b97f4a7c15ull)); }
+};
+
+typedef counting_allocator<list_node> node_allocator;
+
+class read_mostly_list {
+private:
+    std::atomic<list_node*> head_;
+    std::mutex write_lock_;
+
+public:
+    explicit read_mostly_list(uint64_t n) : head_(nullptr) {
+        for (uint64_t k = n; k > 0; --k) {
+            node_allocator alloc;
+            list_node* node = alloc.allocate(1);
+            alloc.construct(node, k - 1, 0, head_.load());
+            head_.store(node);
+        }
+    }
+
+    ~read_mostly_list() {
+        list_node* p = head_.load();
+        while (p != nullptr) {
+            list_node* next = p->next.load();
+            sugar::reclaim_with_allocator<list_node, node_allocator>(p);
+            p = next;
+        }
+    }
+
+    std::atomic<list_node*>& head() { return head_; }
+
+    // 用新节点替换键为key的节点，返回被摘下的旧节点
+    list_node* replace(uint64_t key, uint64_t value) {
+        std::lock_guard<std::mutex> guard(write_lock_);
+        std::atomic<list_node*>* link = &head_;
+        list_node* cur = link->load();
+        while (cur->key != key) {
+            link = &cur->next;
+            cur = link->load();
+        }
+        node_allocator alloc;
+        list_node* fresh = alloc.allocate(1);
+        alloc.construct(fresh, key, value, cur->next.load());
+        cur->removed.store(true);
+        link->store(fresh);
+        return cur;
+    }
+};
+
+// 不回收：读者直接遍历，摘下的节点留到最后
+static uint64_t find_unsafe(read_mostly_list& list, uint64_t key) {
+    list_node* p = list.head().load(std::memory_order_acquire);
+    while (p->key != key) {
+        p = p->next.load(std::memory_order_acquire);
+    }
+    return p->value;
+}
+
+// EBR：整个遍历在一个临界区内
+static uint64_t find_epoch(read_mostly_list& list, sugar::epoch_domain::handle& h, uint64_t key) {
+    sugar::epoch_domain::guard g = h.pin();
+    list_node* p = list.head().load(std::memory_order_acquire);
+    while (p->key != key) {
+        p = p->next.load(std::memory_order_acquire);
+    }
+    assert(p->valid());
+    return p->value;
+}
+
+// 危险指针：两个槽交替保护前驱与当前节点，前驱已被摘下时从头重来
+static uint64_t find_hazard(read_mostly_list& list, sugar::hazard_domain::handle& h, uint64_t key) {
+    for (;;) {
+        size_t slot = 0;
+        list_node* prev = nullptr;
+        list_node* cur = h.protect(slot, list.head());
+        bool restart = false;
+        while (cur->key != key) {
+            prev = cur;
+            slot ^= 1;
+            cur = h.protect(slot, prev->next);
+            if (prev->removed.load()) {
+                restart = true;
+                break;
+            }
+        }
+        if (!restart) {
+            assert(cur->valid());
+            const uint64_t v = cur->value;
+            h.clear_all();
+            return v;
+        }
+    }
+}
+
+// 测试函数声明
+void test_epoch_domain();
+void test_hazard_domain();
+void test_concurrent_list();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Reclamation 测试 ===" << std::endl;
+
+    try {
+        test_epoch_domain();
+        test_hazard_domain();
+        test_concurrent_list();
+        test_performance();
+
+        std::cout << "\n🎉 All reclamation tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+static tracked* make_tracked(uint64_t v) {
+    counting_allocator<tracked> alloc;
+    tracked* p = alloc.allocate(1);
+    alloc.construct(p, tracked{v});
+    return p;
+}
+
+// 测试基于纪元的回收
+void test_epoch_domain() {
+    std::cout << "\n=== 测试 epoch_domain ===" << std::endl;
+
+    g_freed = 0;
+    {
+        sugar::epoch_domain domain;
+        sugar::epoch_domain::handle reader = domain.attach();
+        sugar::epoch_domain::handle writer = domain.attach();
+
+        // 读者停在临界区内时，之后摘下的对象一个也不能回收
+        reader.enter();
+        for (int i = 0; i < 500; ++i) {
+            writer.retire<tracked, counting_allocator<tracked>>(make_tracked(i));
+        }
+        for (int i = 0; i < 10; ++i) {
+            writer.collect();
+        }
+        assert(g_freed.load() == 0 && writer.pending() == 500 && domain.epoch() <= 1);
+        reader.leave();
+        for (int i = 0; i < 4; ++i) {
+            writer.collect();
+        }
+        assert(g_freed.load() == 500 && writer.pending() == 0);
+        std::cout << "✓ 读者在临界区内时不回收，离开后两次纪元推进即整批回收" << std::endl;
+
+        // 嵌套的pin
+        {
+            sugar::epoch_domain::guard outer = reader.pin();
+            {
+                sugar::epoch_domain::guard inner = reader.pin();
+            }
+            assert(reader.pinned());
+        }
+        assert(!reader.pinned());
+
+        // handle析构时未到期的对象交给域托管，由其他handle或域的析构释放
+        {
+            sugar::epoch_domain::handle temp = domain.attach();
+            reader.enter();
+            for (int i = 0; i < 10; ++i) {
+                temp.retire<tracked, counting_allocator<tracked>>(make_tracked(i));
+            }
+        }
+        assert(g_freed.load() == 500);
+        reader.leave();
+        for (int i = 0; i < 4; ++i) {
+            writer.collect();
+        }
+        assert(g_freed.load() == 510);
+
+        // 记录被复用
+        for (int i = 0; i < 100; ++i) {
+            sugar::epoch_domain::handle h = domain.attach();
+            h.retire<tracked, counting_allocator<tracked>>(make_tracked(i));
+        }
+    }
+    assert(g_freed.load() == 610);
+    std::cout << "✓ handle析构后托管的对象全部回收" << std::endl;
+}
+
+// 测试危险指针
+void test_hazard_domain() {
+    std::cout << "\n=== 测试 hazard_domain ===" << std::endl;
+
+    g_freed = 0;
+    {
+        sugar::hazard_domain domain;
+        sugar::hazard_domain::handle reader = domain.attach();
+        sugar::hazard_domain::handle writer = domain.attach();
+
+        std::atomic<tracked*> shared(make_tracked(1));
+        tracked* p = reader.protect(0, shared);
+        assert(p->value == 1);
+        shared.store(make_tracked(2));
+        writer.retire<tracked, counting_allocator<tracked>>(p);
+        writer.scan();
+        assert(g_freed.load() == 0 && writer.pending() == 1 && p->value == 1);
+        reader.clear(0);
+        writer.scan();
+        assert(g_freed.load() == 1 && writer.pending() == 0);
+        std::cout << "✓ 受保护的对象在槽清除之前不会回收" << std::endl;
+
+        // 待回收量有界：攒到阈值就扫描
+        reader.protect(1, shared);
+        size_t peak = 0;
+        for (int i = 0; i < 10000; ++i) {
+            writer.retire<tracked, counting_allocator<tracked>>(make_tracked(i));
+            peak = writer.pending() > peak ? writer.pending() : peak;
+        }
+        assert(peak <= 64 && g_freed.load() + static_cast<long>(writer.pending()) == 10001);
+        std::cout << "✓ 摘下1万个对象，积压峰值 " << peak << " 个" << std::endl;
+
+        // 被保护对象所在handle之外的托管
+        {
+            sugar::hazard_domain::handle temp = domain.attach();
+            temp.retire<tracked, counting_allocator<tracked>>(shared.exchange(nullptr));
+        }
+        writer.scan();
+        assert(writer.pending() == 1);
+        reader.clear_all();
+        writer.scan();
+        assert(writer.pending() == 0 && g_freed.load() == 10002);
+    }
+    std::cout << "✓ 受保护对象经托管后由其他handle回收" << std::endl;
+}
+
+// 多个读者与写者同时访问链表，读者从不读到已回收的节点
+void test_concurrent_list() {
+    std::cout << "\n=== 测试并发链表 ===" << std::endl;
+
+    const int readers = 3;
+    const int writes = 20000;
+    {
+        g_freed = 0;
+        read_mostly_list list(32);
+        sugar::epoch_domain domain;
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < readers; ++t) {
+            threads.push_back(std::thread([&, t]() {
+                sugar::epoch_domain::handle h = domain.attach();
+                unsigned int seed = static_cast<unsigned int>(t + 1);
+                while (!stop.load(std::memory_order_relaxed)) {
+                    find_epoch(list, h, lcg_next(seed) % 32);
+                }
+            }));
+        }
+        std::thread writer([&]() {
+            sugar::epoch_domain::handle h = domain.attach();
+            unsigned int seed = 99;
+            for (int i = 0; i < writes; ++i) {
+                h.retire<list_node, node_allocator>(list.replace(lcg_next(seed) % 32, static_cast<uint64_t>(i)));
+            }
+            stop = true;
+        });
+        writer.join();
+        for (size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+        }
+    }
+    assert(g_freed.load() == writes + 32);
+    std::cout << "✓ EBR：" << readers << " 个读者与写者并发，" << writes << " 次替换后全部回收" << std::endl;
+
+    {
+        g_freed = 0;
+        read_mostly_list list(32);
+        sugar::hazard_domain domain;
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < readers; ++t) {
+            threads.push_back(std::thread([&, t]() {
+                sugar::hazard_domain::handle h = domain.attach();
+                unsigned int seed = static_cast<unsigned int>(t + 1);
+                while (!stop.load(std::memory_order_relaxed)) {
+                    find_hazard(list, h, lcg_next(seed) % 32);
+                }
+            }));
+        }
+        std::thread writer([&]() {
+            sugar::hazard_domain::handle h = domain.attach();
+            unsigned int seed = 99;
+            for (int i = 0; i < writes; ++i) {
+                h.retire<list_node, node_allocator>(list.replace(lcg_next(seed) % 32, static_cast<uint64_t>(i)));
+            }
+            stop = true;
+        });
+        writer.join();
+        for (size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+        }
+    }
+    assert(g_freed.load() == writes + 32);
+    std::cout << "✓ 危险指针：" << readers << " 个读者与写者并发，" << writes << " 次替换后全部回收" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 在threads个线程上跑总计ops次操作，95%查找、5%替换；Worker(t)返回每个线程的操作函数
+template<typename Worker>
+static double run_mixed(int threads, int ops, Worker worker) {
+    return seconds([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&, t]() { worker(t, ops / threads); }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    });
+}
+
+// 测试性能：读多写少的链表上，不回收、EBR、危险指针三种方式的吞吐
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const uint64_t length = 64;
+    const int ops = 400000;
+    std::cout << length << " 个节点的链表，95%查找 5%替换，共 " << ops << " 次操作（Mops/s）：" << std::endl;
+    for (int threads : {1, 2, 4, 8}) {
+        read_mostly_list leak_list(length);
+        std::mutex leak_lock;
+        sugar::vector<list_node*> leaked;
+        double none_s = run_mixed(threads, ops, [&](int t, int n) {
+            unsigned int seed = static_cast<unsigned int>(t * 977 + 1);
+            for (int i = 0; i < n; ++i) {
+                const uint64_t key = lcg_next(seed) % length;
+                if (lcg_next(seed) % 20 == 0) {
+                    list_node* old = leak_list.replace(key, static_cast<uint64_t>(i));
+                    std::lock_guard<std::mutex> guard(leak_lock);
+                    leaked.push_back(old);
+                } else {
+                    find_unsafe(leak_list, key);
+                }
+            }
+        });
+        for (size_t i = 0; i < leaked.size(); ++i) {
+            sugar::reclaim_with_allocator<list_node, node_allocator>(leaked[i]);
+        }
+
+        read_mostly_list epoch_list(length);
+        sugar::epoch_domain epochs;
+        double epoch_s = run_mixed(threads, ops, [&](int t, int n) {
+            sugar::epoch_domain::handle h = epochs.attach();
+            unsigned int seed = static_cast<unsigned int>(t * 977 + 1);
+            for (int i = 0; i < n; ++i) {
+                const uint64_t key = lcg_next(seed) % length;
+                if (lcg_next(seed) % 20 == 0) {
+                    h.retire<list_node, node_allocator>(epoch_list.replace(key, static_cast<uint64_t>(i)));
+                } else {
+                    find_epoch(epoch_list, h, key);
+                }
+            }
+        });
+
+        read_mostly_list hazard_list(length);
+        sugar::hazard_domain hazards;
+        double hazard_s = run_mixed(threads, ops, [&](int t, int n) {
+            sugar::hazard_domain::handle h = hazards.attach();
+            unsigned int seed = static_cast<unsigned int>(t * 977 + 1);
+            for (int i = 0; i < n; ++i) {
+                const uint64_t key = lcg_next(seed) % length;
+                if (lcg_next(seed) % 20 == 0) {
+                    h.retire<list_node, node_allocator>(hazard_list.replace(key, static_cast<uint64_t>(i)));
+                } else {
+                    find_hazard(hazard_list, h, key);
+                }
+            }
+        });
+        std::cout << "  " << threads << " 线程: 不回收 " << ops / none_s / 1e6 << ", EBR " << ops / epoch_s / 1e6
+                  << ", 危险指针 " << ops / hazard_s / 1e6 << std::endl;
+    }
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
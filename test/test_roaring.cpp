@@ -0,0 +1,416 @@
+/*
+ * @file test_roaring.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 压缩位图测试
+ */
+
+#include "roaring.h"
+#include "algorithm.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+static uint32_t random_u32(unsigned int& state) {
+    return (static_cast<uint32_t>(lcg_next(state)) << 17) ^ (static_cast<uint32_t>(lcg_next(state)) << 2)
+           ^ lcg_next(state);
+}
+
+static std::vector<uint32_t> members_of(const sugar::roaring_bitmap& r) {
+    std::vector<uint32_t> out;
+    r.for_each([&out](uint32_t x) { out.push_back(x); });
+    return out;
+}
+
+// 测试函数声明
+void test_basic_operations();
+void test_random_against_model();
+void test_set_operations();
+void test_serialization();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Roaring Bitmap 测试 ===" << std::endl;
+
+    try {
+        test_basic_operations();
+        test_random_against_model();
+        test_set_operations();
+        test_serialization();
+        test_performance();
+
+        std::cout << "\n🎉 All roaring tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试基本操作
+void test_basic_operations() {
+    std::cout << "\n=== 测试基本操作 ===" << std::endl;
+
+    sugar::roaring_bitmap r;
+    assert(r.empty() && !r.contains(0));
+    assert(r.add(7) && r.add(0xffffffffu) && r.add(1u << 20) && !r.add(7));
+    assert(r.size() == 3 && r.container_count() == 3);
+    assert(r.contains(7) && r.contains(0xffffffffu) && !r.contains(8));
+    assert(r.remove(1u << 20) && !r.remove(1u << 20) && r.container_count() == 2);
+    std::cout << "✓ add / remove / contains，空容器被回收" << std::endl;
+
+    // 一个块内超过4096个成员后转为位图，内存封顶8KB
+    sugar::roaring_bitmap dense;
+    for (uint32_t x = 0; x < 65536; x += 2) {
+        dense.add(x);
+    }
+    assert(dense.size() == 32768 && dense.container_count() == 1);
+    assert(dense.memory_bytes() < 8192 + 256);
+    for (uint32_t x = 0; x < 65536; x += 2) {
+        assert(dense.contains(x) && !dense.contains(x + 1));
+    }
+    // 删回4096个以下时转回数组
+    for (uint32_t x = 0; x < 60000; x += 2) {
+        dense.remove(x);
+    }
+    assert(dense.size() == 2768 && dense.contains(60000) && !dense.contains(59998));
+    std::cout << "✓ 数组 <-> 位图 随基数转换" << std::endl;
+
+    // 区间：整块覆盖时只用一个行程
+    sugar::roaring_bitmap ranges;
+    ranges.add_range(100, 300000);
+    assert(ranges.size() == 299900 && ranges.container_count() == 5);
+    assert(ranges.memory_bytes() < 1024);
+    assert(!ranges.contains(99) && ranges.contains(100) && ranges.contains(299999) && !ranges.contains(300000));
+    // 在行程上打孔、补洞
+    assert(ranges.remove(150000) && !ranges.contains(150000) && ranges.contains(150001));
+    assert(ranges.add(150000) && ranges.size() == 299900);
+    ranges.add_range(0xffff0000u, uint64_t(1) << 32);
+    assert(ranges.contains(0xffffffffu) && ranges.size() == 299900 + 65536);
+    bool threw = false;
+    try {
+        ranges.add_range(0, (uint64_t(1) << 32) + 1);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ add_range 生成行程容器，行程上可增删单个值" << std::endl;
+
+    // run_optimize：连续区间多时转为行程，结果集合不变
+    sugar::roaring_bitmap runs;
+    for (uint32_t x = 0; x < 200000; ++x) {
+        if ((x / 1000) % 2 == 0) {
+            runs.add(x);
+        }
+    }
+    sugar::roaring_bitmap before(runs);
+    const size_t bytes_before = runs.memory_bytes();
+    assert(runs.run_optimize());
+    assert(runs.memory_bytes() < bytes_before / 20);
+    assert(runs == before && members_of(runs) == members_of(before));
+    assert(!runs.run_optimize());
+    std::cout << "✓ run_optimize 压缩 " << bytes_before << " -> " << runs.memory_bytes() << " 字节，内容不变"
+              << std::endl;
+
+    // rank / select
+    std::vector<uint32_t> all = members_of(runs);
+    for (size_t i = 0; i < all.size(); i += 997) {
+        assert(runs.select(i) == all[i]);
+        assert(runs.rank(all[i]) == i + 1);
+        assert(before.select(i) == all[i] && before.rank(all[i]) == i + 1);
+    }
+    assert(runs.rank(1500) == 1000 && runs.rank(0xffffffffu) == runs.size());
+    threw = false;
+    try {
+        runs.select(runs.size());
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ rank / select" << std::endl;
+}
+
+// 与std::set逐步比对随机操作
+void test_random_against_model() {
+    std::cout << "\n=== 测试随机操作序列 ===" << std::endl;
+
+    sugar::roaring_bitmap r;
+    std::set<uint32_t> model;
+    unsigned int seed = 41;
+    for (int i = 0; i < 100000; ++i) {
+        // 块0很稠密，块1中等，其余块稀疏，让三种容器都出现
+        const unsigned int chunk = lcg_next(seed) % 8;
+        const uint32_t span = chunk == 0 ? 8000 : chunk == 1 ? 65536 : 300;
+        const uint32_t x = (chunk << 16) | (random_u32(seed) % span);
+        const unsigned int op = lcg_next(seed) % 100;
+        if (op < 55) {
+            assert(r.add(x) == model.insert(x).second);
+        } else if (op < 97) {
+            assert(r.remove(x) == (model.erase(x) == 1));
+        } else if (op < 99) {
+            const uint32_t length = lcg_next(seed) % 1500;
+            r.add_range(x, uint64_t(x) + length);
+            for (uint32_t k = 0; k < length; ++k) {
+                model.insert(x + k);
+            }
+        } else {
+            r.run_optimize();
+        }
+        assert(r.size() == model.size());
+        if (i % 10000 == 0) {
+            assert(members_of(r) == std::vector<uint32_t>(model.begin(), model.end()));
+            for (int k = 0; k < 100; ++k) {
+                const uint32_t probe = ((lcg_next(seed) % 9) << 16) | lcg_next(seed);
+                assert(r.contains(probe) == (model.count(probe) == 1));
+                assert(r.rank(probe) == static_cast<size_t>(std::distance(model.begin(), model.upper_bound(probe))));
+            }
+        }
+    }
+    assert(members_of(r) == std::vector<uint32_t>(model.begin(), model.end()));
+    std::cout << "✓ 10万次随机增删/区间插入/run_optimize 与 std::set 一致" << std::endl;
+}
+
+// 构造一个混合了三种容器的随机位图
+static sugar::roaring_bitmap make_mixed(unsigned int seed, bool optimize) {
+    sugar::roaring_bitmap r;
+    for (uint32_t chunk = 0; chunk < 12; ++chunk) {
+        const unsigned int kind = lcg_next(seed) % 5;
+        const uint32_t base = chunk << 16;
+        if (kind == 0) {
+            for (int k = 0; k < 200; ++k) {
+                r.add(base | lcg_next(seed));
+            }
+        } else if (kind == 1) {
+            for (int k = 0; k < 20000; ++k) {
+                r.add(base | (random_u32(seed) & 0xffff));
+            }
+        } else if (kind == 2) {
+            for (int k = 0; k < 20; ++k) {
+                const uint32_t start = base | (lcg_next(seed) & 0xffff);
+                r.add_range(start, sugar::min(uint64_t(start) + lcg_next(seed) % 2000, uint64_t(base) + 65536));
+            }
+        } else if (kind == 3) {
+            r.add_range(base, uint64_t(base) + 65536);
+        }
+    }
+    if (optimize) {
+        r.run_optimize();
+    }
+    return r;
+}
+
+// 集合运算与std::set_*比对
+void test_set_operations() {
+    std::cout << "\n=== 测试集合运算 ===" << std::endl;
+
+    for (unsigned int round = 0; round < 20; ++round) {
+        sugar::roaring_bitmap a = make_mixed(round * 2 + 1, round % 2 == 0);
+        sugar::roaring_bitmap b = make_mixed(round * 2 + 2, round % 3 == 0);
+        const std::vector<uint32_t> va = members_of(a);
+        const std::vector<uint32_t> vb = members_of(b);
+        std::vector<uint32_t> expect;
+        std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expect));
+        sugar::roaring_bitmap both = a & b;
+        assert(members_of(both) == expect && both.size() == expect.size());
+        expect.clear();
+        std::set_union(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expect));
+        sugar::roaring_bitmap either = a | b;
+        assert(members_of(either) == expect && either.size() == expect.size());
+        expect.clear();
+        std::set_difference(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expect));
+        sugar::roaring_bitmap only = a - b;
+        assert(members_of(only) == expect && only.size() == expect.size());
+
+        sugar::roaring_bitmap c(a);
+        c |= b;
+        assert(c == either);
+        c &= b;
+        assert(c == b);
+        c -= a;
+        assert(c == (b - a));
+        assert((a | a) == a && (a & a) == a && (a - a).empty());
+    }
+    std::cout << "✓ 20组混合容器的 & | - 及复合赋值与 std::set_* 一致" << std::endl;
+
+    // 不同表示的相同集合相等
+    sugar::roaring_bitmap x = make_mixed(99, false);
+    sugar::roaring_bitmap y = make_mixed(99, true);
+    assert(x == y && members_of(x) == members_of(y));
+    y.add(0x7fffffffu);
+    assert(x != y);
+    std::cout << "✓ 行程与数组/位图表示的相同集合判等" << std::endl;
+}
+
+// 测试序列化与映射视图
+void test_serialization() {
+    std::cout << "\n=== 测试序列化 ===" << std::endl;
+
+    sugar::roaring_bitmap r = make_mixed(7, true);
+    r.add(0xfffffff0u);
+    const size_t bytes = r.serialized_size();
+    assert(bytes % 8 == 0);
+    // 多留一个字节，在奇数地址上也测试一次
+    std::vector<unsigned char> buffer(bytes + 1);
+    r.serialize(buffer.data());
+    sugar::roaring_bitmap back = sugar::roaring_bitmap::deserialize(buffer.data(), bytes);
+    assert(back == r && back.size() == r.size());
+    std::cout << "✓ serialize / deserialize 往返一致（" << bytes << " 字节）" << std::endl;
+
+    std::copy_backward(buffer.begin(), buffer.end() - 1, buffer.end());
+    for (int shift = 0; shift < 2; ++shift) {
+        sugar::roaring_view view(buffer.data() + 1 - shift, bytes);
+        assert(view.size() == r.size() && view.container_count() == r.container_count());
+        unsigned int seed = 5;
+        for (int k = 0; k < 20000; ++k) {
+            const uint32_t probe = k % 2 ? r.select(random_u32(seed) % r.size()) : (random_u32(seed) & 0xfffff);
+            assert(view.contains(probe) == r.contains(probe));
+        }
+        assert(view.contains(0xfffffff0u) && !view.contains(0xfffffff1u));
+        std::vector<uint32_t> seen;
+        view.for_each([&seen](uint32_t v) { seen.push_back(v); });
+        assert(seen == members_of(r));
+        assert(view.to_bitmap() == r);
+        std::copy(buffer.begin() + 1, buffer.end(), buffer.begin());
+    }
+    std::cout << "✓ roaring_view 在对齐与未对齐的字节上直接查询、遍历" << std::endl;
+
+    // 损坏的数据
+    int rejected = 0;
+    const size_t damaged_at[] = {0, 4, 8 + 2, 8 + 12, bytes - 3};
+    for (size_t pos : damaged_at) {
+        std::vector<unsigned char> bad(buffer.begin(), buffer.begin() + static_cast<ptrdiff_t>(bytes));
+        bad[pos] ^= 0x5a;
+        try {
+            sugar::roaring_bitmap::deserialize(bad.data(), bad.size());
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    try {
+        sugar::roaring_view truncated(buffer.data(), bytes - 8);
+    } catch (const std::invalid_argument&) {
+        ++rejected;
+    }
+    assert(rejected == 6);
+    sugar::roaring_bitmap empty = r - r;
+    std::vector<unsigned char> small(empty.serialized_size());
+    empty.serialize(small.data());
+    assert(sugar::roaring_bitmap::deserialize(small.data(), small.size()).empty());
+    std::cout << "✓ 头部、目录、负载损坏或截断时抛出 invalid_argument" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static sugar::vector<uint32_t> sorted_vector(const sugar::roaring_bitmap& r) {
+    sugar::vector<uint32_t> v;
+    v.reserve(r.size());
+    r.for_each([&v](uint32_t x) { v.push_back(x); });
+    return v;
+}
+
+// 测试性能：内存与运算吞吐，对比有序 sugar::vector<uint32_t>
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const char* names[] = {"稀疏（全值域随机20万）", "中等（6400万值域内100万）", "稠密（200万值域内100万）",
+                           "聚簇（200段长区间）"};
+    const uint32_t universes[] = {0xffffffffu, 1u << 26, 1u << 21, 1u << 28};
+    for (int kind = 0; kind < 4; ++kind) {
+        const uint32_t universe = universes[kind];
+        sugar::roaring_bitmap a;
+        sugar::roaring_bitmap b;
+        unsigned int seed = 11 + static_cast<unsigned int>(kind);
+        for (sugar::roaring_bitmap* r : {&a, &b}) {
+            if (kind < 3) {
+                // 按升序批量插入，每次都落在最后一个容器的末尾
+                std::vector<uint32_t> keys(kind == 0 ? 200000 : 1000000);
+                for (size_t k = 0; k < keys.size(); ++k) {
+                    keys[k] = random_u32(seed) % universe;
+                }
+                std::sort(keys.begin(), keys.end());
+                for (size_t k = 0; k < keys.size(); ++k) {
+                    r->add(keys[k]);
+                }
+            } else {
+                for (int k = 0; k < 200; ++k) {
+                    const uint32_t start = random_u32(seed) % universe;
+                    r->add_range(start, uint64_t(start) + 5000 + random_u32(seed) % 20000);
+                }
+            }
+            r->run_optimize();
+            r->shrink_to_fit();
+        }
+        const sugar::vector<uint32_t> va = sorted_vector(a);
+        const sugar::vector<uint32_t> vb = sorted_vector(b);
+        std::cout << names[kind] << "：每个成员 roaring " << static_cast<double>(a.memory_bytes()) / a.size()
+                  << " 字节，有序数组 4 字节" << std::endl;
+
+        const int rounds = 10;
+        size_t sink = 0;
+        double r_and = seconds([&] {
+            for (int i = 0; i < rounds; ++i) {
+                sink += (a & b).size();
+            }
+        });
+        sugar::vector<uint32_t> out;
+        double v_and = seconds([&] {
+            for (int i = 0; i < rounds; ++i) {
+                out.resize(sugar::min(va.size(), vb.size()));
+                sink += static_cast<size_t>(
+                    sugar::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), out.begin()) - out.begin());
+            }
+        });
+        double r_or = seconds([&] {
+            for (int i = 0; i < rounds; ++i) {
+                sink += (a | b).size();
+            }
+        });
+        double v_or = seconds([&] {
+            for (int i = 0; i < rounds; ++i) {
+                out.resize(va.size() + vb.size());
+                sink += static_cast<size_t>(
+                    sugar::set_union(va.begin(), va.end(), vb.begin(), vb.end(), out.begin()) - out.begin());
+            }
+        });
+        const int probes = 200000;
+        double r_find = seconds([&] {
+            unsigned int s = 3;
+            for (int i = 0; i < probes; ++i) {
+                sink += a.contains(random_u32(s) % universe);
+            }
+        });
+        double v_find = seconds([&] {
+            unsigned int s = 3;
+            for (int i = 0; i < probes; ++i) {
+                sink += sugar::binary_search(va.begin(), va.end(), random_u32(s) % universe);
+            }
+        });
+        std::cout << "    与: roaring " << r_and / rounds * 1e3 << " ms, 有序数组 " << v_and / rounds * 1e3
+                  << " ms；或: roaring " << r_or / rounds * 1e3 << " ms, 有序数组 " << v_or / rounds * 1e3
+                  << " ms；随机判断: roaring " << r_find / probes * 1e9 << " ns, 有序数组 "
+                  << v_find / probes * 1e9 << " ns (" << (sink & 1) << ")" << std::endl;
+    }
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
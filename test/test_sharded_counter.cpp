@@ -0,0 +1,310 @@
+/*
+ * @file test_sharded_counter.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 分片计数器与直方图测试
+ */
+
+#include "sharded_counter.h"
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_thread_index();
+void test_per_thread();
+void test_sharded_counter();
+void test_histogram_buckets();
+void test_sharded_histogram();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Sharded Counter 测试 ===" << std::endl;
+
+    try {
+        test_thread_index();
+        test_per_thread();
+        test_sharded_counter();
+        test_histogram_buckets();
+        test_sharded_histogram();
+        test_performance();
+
+        std::cout << "\n🎉 All sharded_counter tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试线程编号：同时存活的线程编号互不相同，退出后被复用
+void test_thread_index() {
+    std::cout << "\n=== 测试线程编号 ===" << std::endl;
+
+    const uint32_t main_index = sugar::this_thread_index();
+    assert(sugar::this_thread_index() == main_index);
+
+    const int threads = 8;
+    std::vector<uint32_t> seen(threads);
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            seen[t] = sugar::this_thread_index();
+            ++ready;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+        }));
+    }
+    while (ready.load() != threads) {
+        std::this_thread::yield();
+    }
+    go = true;
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    std::set<uint32_t> distinct(seen.begin(), seen.end());
+    assert(distinct.size() == static_cast<size_t>(threads) && distinct.count(main_index) == 0);
+    std::cout << "✓ " << threads << " 个同时存活的线程编号互不相同" << std::endl;
+
+    // 之前的线程都已退出，新线程复用最小的空闲编号，编号保持紧凑
+    uint32_t reused = 0;
+    std::thread later([&]() { reused = sugar::this_thread_index(); });
+    later.join();
+    assert(reused == *distinct.begin());
+    std::cout << "✓ 退出线程的编号被复用" << std::endl;
+}
+
+// 测试per_thread：各线程拿到独立的槽位，且槽位独占缓存行
+void test_per_thread() {
+    std::cout << "\n=== 测试 per_thread ===" << std::endl;
+
+    sugar::per_thread<long> storage;
+    assert(storage.slots() == 0);
+    storage.local() = 7;
+    assert(storage.local() == 7 && storage.slots() == sugar::per_thread<long>::chunk_slots);
+    assert(reinterpret_cast<uintptr_t>(&storage.local()) % sugar::cache_line_size == 0);
+
+    const int threads = 20;  // 跨过第一组的16个槽位
+    std::vector<std::thread> workers;
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            long& mine = storage.local();
+            ++ready;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i <= t; ++i) {
+                mine += 1;
+            }
+            assert(&mine == &storage.local());
+        }));
+    }
+    while (ready.load() != threads) {
+        std::this_thread::yield();
+    }
+    go = true;
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    const long total = storage.combine(0L, [](long sum, long v) { return sum + v; });
+    assert(total == 7 + threads * (threads + 1) / 2);
+    assert(storage.slots() >= 2 * sugar::per_thread<long>::chunk_slots);
+    std::cout << "✓ " << threads << " 个线程各写自己的槽位，combine 汇总为 " << total << std::endl;
+}
+
+// 测试sharded_counter
+void test_sharded_counter() {
+    std::cout << "\n=== 测试 sharded_counter ===" << std::endl;
+
+    sugar::sharded_counter counter;
+    assert(counter.value() == 0);
+    ++counter;
+    counter += 10;
+    counter -= 3;
+    counter.sub();
+    assert(counter.value() == 7);
+    counter.reset();
+    assert(counter.value() == 0);
+
+    const int threads = 8;
+    const int per_thread = 100000;
+    std::atomic<bool> stop(false);
+    int64_t last = 0;
+    std::thread reader([&]() {
+        // 并发读：汇总值单调不减且不超过最终值
+        while (!stop.load()) {
+            const int64_t v = counter.value();
+            assert(v >= last && v <= static_cast<int64_t>(threads) * per_thread);
+            last = v;
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&]() {
+            for (int i = 0; i < per_thread; ++i) {
+                counter.add();
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    stop = true;
+    reader.join();
+    assert(counter.value() == static_cast<int64_t>(threads) * per_thread);
+    std::cout << "✓ " << threads << " 个线程并发计数精确，并发读单调" << std::endl;
+
+    // 线程退出后其计数保留
+    std::thread([&]() { counter.add(5); }).join();
+    assert(counter.value() == static_cast<int64_t>(threads) * per_thread + 5);
+    std::cout << "✓ 退出线程的计数不丢失" << std::endl;
+}
+
+// 测试分桶边界
+void test_histogram_buckets() {
+    std::cout << "\n=== 测试直方图分桶 ===" << std::endl;
+
+    typedef sugar::sharded_histogram H;
+    for (uint64_t v = 0; v < 8; ++v) {
+        assert(H::bucket_of(v) == v && H::bucket_lower(v) == v && H::bucket_upper(v) == v);
+    }
+    assert(H::bucket_of(8) == 8 && H::bucket_of(15) == 15 && H::bucket_of(16) == 16 && H::bucket_of(17) == 16);
+    assert(H::bucket_of(UINT64_MAX) == sugar::histogram_bucket_count - 1);
+    for (size_t b = 0; b < sugar::histogram_bucket_count; ++b) {
+        assert(H::bucket_of(H::bucket_lower(b)) == b && H::bucket_of(H::bucket_upper(b)) == b);
+        if (b > 0) {
+            assert(H::bucket_lower(b) == H::bucket_upper(b - 1) + 1);
+        }
+        // 桶宽不超过下界的1/8
+        assert(H::bucket_upper(b) - H::bucket_lower(b) <= H::bucket_lower(b) / 8);
+    }
+    std::cout << "✓ " << sugar::histogram_bucket_count << " 个桶首尾相接覆盖整个uint64，相对宽度不超过12.5%"
+              << std::endl;
+}
+
+// 测试sharded_histogram
+void test_sharded_histogram() {
+    std::cout << "\n=== 测试 sharded_histogram ===" << std::endl;
+
+    sugar::sharded_histogram hist;
+    sugar::histogram_snapshot empty = hist.snapshot();
+    assert(empty.count == 0 && empty.percentile(0.5) == 0 && empty.mean() == 0.0);
+
+    // 4个线程交错记录1..100000，合起来是均匀分布
+    const int threads = 4;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            for (uint64_t v = 1 + t; v <= 100000; v += threads) {
+                hist.record(v);
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    sugar::histogram_snapshot s = hist.snapshot();
+    assert(s.count == 100000 && hist.count() == 100000);
+    assert(s.sum == 100000ull * 100001 / 2 && s.min == 1 && s.max == 100000);
+    assert(s.mean() == 50000.5);
+    const double qs[] = {0.5, 0.9, 0.99, 0.999};
+    for (double q : qs) {
+        const double exact = q * 100000;
+        const double estimate = static_cast<double>(s.percentile(q));
+        assert(estimate > exact * 0.92 && estimate < exact * 1.08);
+    }
+    assert(s.percentile(0) == 1 && s.percentile(1) == 100000);
+    std::cout << "✓ p50=" << s.percentile(0.5) << " p99=" << s.percentile(0.99) << "，误差在桶宽以内" << std::endl;
+
+    hist.reset();
+    assert(hist.snapshot().count == 0 && hist.snapshot().max == 0);
+    std::cout << "✓ reset" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// threads个线程各执行ops/threads次body
+template<typename Body>
+static double run_threads(int threads, int ops, Body body) {
+    return seconds([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&, t]() {
+                unsigned int seed = static_cast<unsigned int>(t + 1);
+                const int n = ops / threads;
+                for (int i = 0; i < n; ++i) {
+                    body(seed);
+                }
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    });
+}
+
+// 测试性能：多线程计数，与单个原子变量比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int ops = 32000000;
+    std::cout << "多线程共 " << ops << " 次自增（Mops/s）：" << std::endl;
+    for (int threads : {1, 8, 64}) {
+        std::atomic<int64_t> single(0);
+        sugar::sharded_counter sharded;
+        const double atomic_s = run_threads(threads, ops, [&](unsigned int&) {
+            single.fetch_add(1, std::memory_order_relaxed);
+        });
+        const double sharded_s = run_threads(threads, ops, [&](unsigned int&) { sharded.add(); });
+        assert(single.load() == sharded.value() && sharded.value() == ops / threads * threads);
+        std::cout << "  " << threads << " 线程: std::atomic " << ops / atomic_s / 1e6 << ", sharded_counter "
+                  << ops / sharded_s / 1e6 << std::endl;
+    }
+
+    // 直方图记录：与全局互斥锁保护的共享直方图比较
+    const int records = 6400000;
+    const int threads = 64;
+    sugar::sharded_histogram hist;
+    std::vector<uint64_t> shared(sugar::histogram_bucket_count, 0);
+    std::mutex shared_lock;
+    const double sharded_s = run_threads(threads, records, [&](unsigned int& seed) {
+        hist.record(lcg_next(seed) * 37);
+    });
+    const double locked_s = run_threads(threads, records, [&](unsigned int& seed) {
+        const size_t b = sugar::sharded_histogram::bucket_of(lcg_next(seed) * 37);
+        std::lock_guard<std::mutex> guard(shared_lock);
+        ++shared[b];
+    });
+    assert(hist.count() == static_cast<uint64_t>(records));
+    std::cout << "  " << threads << " 线程记录直方图: 互斥锁 " << records / locked_s / 1e6 << ", sharded_histogram "
+              << records / sharded_s / 1e6 << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
@@ -0,0 +1,341 @@
+/*
+ * @file test_sketch.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 概率摘要测试
+ */
+
+#include "sketch.h"
+#include "algorithm.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+static uint64_t random_u64(unsigned int& state) {
+    uint64_t v = 0;
+    for (int i = 0; i < 5; ++i) {
+        v = (v << 15) ^ lcg_next(state);
+    }
+    return v;
+}
+
+// 偏斜分布：小键出现得多，近似Zipf
+static uint64_t skewed_key(unsigned int& state, uint64_t universe) {
+    const double u = (lcg_next(state) * 32768.0 + lcg_next(state) + 1) / (32768.0 * 32768.0 + 1);
+    return static_cast<uint64_t>(std::pow(static_cast<double>(universe), u)) - 1;
+}
+
+// 测试函数声明
+void test_hyperloglog();
+void test_count_min_sketch();
+void test_kll_sketch();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Sketch 测试 ===" << std::endl;
+
+    try {
+        test_hyperloglog();
+        test_count_min_sketch();
+        test_kll_sketch();
+        test_performance();
+
+        std::cout << "\n🎉 All sketch tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试hyperloglog
+void test_hyperloglog() {
+    std::cout << "\n=== 测试 hyperloglog ===" << std::endl;
+
+    sugar::hyperloglog<uint64_t> empty;
+    assert(empty.estimate() == 0.0 && empty.is_sparse());
+
+    // 稀疏阶段：小基数几乎精确，重复键不计
+    sugar::hyperloglog<uint64_t> small;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        small.add(i);
+        small.add(i);
+    }
+    assert(small.is_sparse());
+    assert(std::fabs(small.estimate() - 1000.0) < 2.0);
+    assert(small.memory_bytes() < 16384);
+    std::cout << "✓ 稀疏表示：1000个键估计 " << small.estimate() << "，占用 " << small.memory_bytes() << " 字节"
+              << std::endl;
+
+    // 各种基数下的相对误差（p = 14，标准误差约0.8%）
+    const uint64_t cardinalities[] = {5000, 20000, 100000, 1000000};
+    for (uint64_t n : cardinalities) {
+        sugar::hyperloglog<uint64_t> h;
+        sugar::vector<uint64_t> keys;
+        for (uint64_t i = 0; i < n; ++i) {
+            keys.push_back(i * 0x9e3779b97f4a7c15ull);
+        }
+        h.add_range(keys);
+        assert(n < 20000 || !h.is_sparse());
+        const double error = std::fabs(h.estimate() - double(n)) / double(n);
+        assert(error < 0.03);
+    }
+    std::cout << "✓ 5千~100万个键，稠密表示相对误差小于3%" << std::endl;
+
+    // 两半分别统计后合并，寄存器与整体统计完全相同
+    sugar::hyperloglog<uint64_t> whole;
+    sugar::hyperloglog<uint64_t> left;
+    sugar::hyperloglog<uint64_t> right;
+    sugar::hyperloglog<uint64_t> tiny;
+    for (uint64_t i = 0; i < 200000; ++i) {
+        whole.add(i);
+        (i % 2 == 0 ? left : right).add(i);
+        if (i < 300) {
+            tiny.add(i + 1000000);
+        }
+    }
+    left.merge(right);
+    assert(left.estimate() == whole.estimate());
+    // 稀疏并入稠密、稠密并入稀疏、稀疏并入稀疏
+    whole.merge(tiny);
+    left.merge(tiny);
+    assert(whole.estimate() == left.estimate());
+    sugar::hyperloglog<uint64_t> sparse_target;
+    sparse_target.add(42);
+    sparse_target.merge(tiny);
+    assert(sparse_target.is_sparse() && std::fabs(sparse_target.estimate() - 301.0) < 1.0);
+    sparse_target.merge(right);
+    assert(!sparse_target.is_sparse());
+    assert(std::fabs(sparse_target.estimate() - 100301.0) / 100301.0 < 0.03);
+    int thrown = 0;
+    try {
+        sugar::hyperloglog<uint64_t> other(12);
+        whole.merge(other);
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    try {
+        sugar::hyperloglog<uint64_t> bad(3);
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    assert(thrown == 2);
+
+    sugar::hyperloglog<std::string> words(10);
+    for (int i = 0; i < 5000; ++i) {
+        words.add("user-" + std::to_string(i % 3000));
+    }
+    assert(std::fabs(words.estimate() - 3000.0) / 3000.0 < 0.1);
+    std::cout << "✓ 稀疏/稠密之间任意合并，精度不同时抛出 invalid_argument，字符串键" << std::endl;
+}
+
+// 测试count_min_sketch
+void test_count_min_sketch() {
+    std::cout << "\n=== 测试 count_min_sketch ===" << std::endl;
+
+    sugar::count_min_sketch<uint64_t> cms = sugar::count_min_sketch<uint64_t>::with_error(0.001, 0.01);
+    assert(cms.width() == 4096 && cms.depth() == 5);
+    std::unordered_map<uint64_t, uint64_t> truth;
+    unsigned int seed = 3;
+    const int n = 200000;
+    for (int i = 0; i < n; ++i) {
+        const uint64_t key = skewed_key(seed, 100000);
+        cms.add(key);
+        ++truth[key];
+    }
+    cms.add(123456789, 1000);
+    truth[123456789] += 1000;
+    assert(cms.total() == uint64_t(n) + 1000);
+    size_t within = 0;
+    for (std::unordered_map<uint64_t, uint64_t>::const_iterator it = truth.begin(); it != truth.end(); ++it) {
+        const uint64_t est = cms.estimate(it->first);
+        assert(est >= it->second);
+        within += est - it->second <= 0.001 * cms.total();
+    }
+    assert(within >= truth.size() * 99 / 100);
+    assert(cms.estimate(0) >= truth[0] && cms.estimate(0) < truth[0] + 20);
+    std::cout << "✓ 估计值不低于真实频率，" << within * 100.0 / truth.size() << "% 的键过估计不超过 epsilon*N"
+              << std::endl;
+
+    // 合并两个线程的局部摘要
+    sugar::count_min_sketch<uint64_t> a(1000, 4);
+    sugar::count_min_sketch<uint64_t> b(1000, 4);
+    assert(a.width() == 1024);
+    sugar::vector<uint64_t> keys;
+    for (uint64_t i = 0; i < 5000; ++i) {
+        keys.push_back(i % 50);
+    }
+    a.add_range(keys);
+    b.add_range(keys);
+    a.merge(b);
+    assert(a.total() == 10000);
+    for (uint64_t k = 0; k < 50; ++k) {
+        assert(a.estimate(k) >= 200);
+    }
+    int thrown = 0;
+    try {
+        a.merge(cms);
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    try {
+        sugar::count_min_sketch<uint64_t>::with_error(0.0, 0.1);
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    assert(thrown == 2);
+    a.clear();
+    assert(a.total() == 0 && a.estimate(1) == 0);
+    std::cout << "✓ 合并后仍为上界，尺寸不同或参数非法时抛出 invalid_argument" << std::endl;
+}
+
+// 返回摘要在若干分位点上的最大归一化秩误差
+static double max_rank_error(const sugar::kll_sketch<double>& s, sugar::vector<double> sorted) {
+    sugar::sort(sorted.begin(), sorted.end());
+    double worst = 0;
+    for (int p = 1; p < 100; ++p) {
+        const double q = s.quantile(p / 100.0);
+        const double actual = static_cast<double>(sugar::upper_bound(sorted.begin(), sorted.end(), q) - sorted.begin());
+        const double error = std::fabs(actual / sorted.size() - p / 100.0);
+        worst = error > worst ? error : worst;
+    }
+    return worst;
+}
+
+// 测试kll_sketch
+void test_kll_sketch() {
+    std::cout << "\n=== 测试 kll_sketch ===" << std::endl;
+
+    // 少于k个值时精确
+    sugar::kll_sketch<int> exact;
+    for (int i = 100; i >= 1; --i) {
+        exact.add(i);
+    }
+    assert(exact.count() == 100 && exact.retained() == 100);
+    assert(exact.quantile(0.5) == 50 && exact.min() == 1 && exact.max() == 100);
+    assert(exact.rank(10) == 10 && exact.rank(0) == 0);
+    std::cout << "✓ 未压缩时分位数与秩精确" << std::endl;
+
+    unsigned int seed = 4;
+    sugar::vector<double> values;
+    for (int i = 0; i < 300000; ++i) {
+        values.push_back(std::pow(lcg_next(seed) / 32768.0, 3.0) * 1000.0);
+    }
+    sugar::kll_sketch<double> s;
+    s.add_range(values);
+    assert(s.count() == values.size() && s.retained() < 1000);
+    const double error = max_rank_error(s, values);
+    assert(error < 0.02);
+    std::cout << "✓ 30万个值保留 " << s.retained() << " 个，最大秩误差 " << error * 100 << "%" << std::endl;
+
+    // 8个局部摘要合并
+    sugar::kll_sketch<double> merged;
+    for (int part = 0; part < 8; ++part) {
+        sugar::kll_sketch<double> local;
+        for (size_t i = static_cast<size_t>(part); i < values.size(); i += 8) {
+            local.add(values[i]);
+        }
+        merged.merge(local);
+    }
+    assert(merged.count() == values.size() && merged.retained() < 1000);
+    assert(merged.min() == s.min() && merged.max() == s.max());
+    assert(max_rank_error(merged, values) < 0.02);
+    merged.merge(merged);
+    assert(merged.count() == 2 * values.size());
+    std::cout << "✓ 8个局部摘要合并后误差 " << max_rank_error(merged, values) * 100 << "%" << std::endl;
+
+    int thrown = 0;
+    sugar::kll_sketch<double> none;
+    try {
+        none.quantile(0.5);
+    } catch (const std::out_of_range&) {
+        ++thrown;
+    }
+    try {
+        s.quantile(1.5);
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    assert(thrown == 2);
+    std::cout << "✓ 空摘要查询抛出 out_of_range，分位点越界抛出 invalid_argument" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = 4000000;
+    unsigned int seed = 5;
+    sugar::vector<uint64_t> stream;
+    for (size_t i = 0; i < n; ++i) {
+        stream.push_back(random_u64(seed) % 1000000);
+    }
+
+    std::unordered_set<uint64_t> exact_set;
+    double set_s = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            exact_set.insert(stream[i]);
+        }
+    });
+    sugar::hyperloglog<uint64_t> hll;
+    double hll_s = seconds([&] { hll.add_range(stream); });
+    const double distinct = static_cast<double>(exact_set.size());
+    std::cout << "hyperloglog: " << n / hll_s / 1e6 << " M/s (unordered_set " << n / set_s / 1e6 << " M/s), 误差 "
+              << std::fabs(hll.estimate() - distinct) / distinct * 100 << "%, " << hll.memory_bytes() << " 字节"
+              << std::endl;
+
+    for (size_t i = 0; i < n; ++i) {
+        stream[i] = skewed_key(seed, 1000000);
+    }
+    std::unordered_map<uint64_t, uint64_t> exact_map;
+    double map_s = seconds([&] {
+        for (size_t i = 0; i < n; ++i) {
+            ++exact_map[stream[i]];
+        }
+    });
+    sugar::count_min_sketch<uint64_t> cms = sugar::count_min_sketch<uint64_t>::with_error(0.0001, 0.01);
+    double cms_s = seconds([&] { cms.add_range(stream); });
+    double over = 0;
+    for (std::unordered_map<uint64_t, uint64_t>::const_iterator it = exact_map.begin(); it != exact_map.end(); ++it) {
+        over += static_cast<double>(cms.estimate(it->first) - it->second);
+    }
+    std::cout << "count_min_sketch: " << n / cms_s / 1e6 << " M/s (unordered_map " << n / map_s / 1e6
+              << " M/s), 平均过估计 " << over / exact_map.size() << ", " << cms.memory_bytes() / 1024 << " KB"
+              << std::endl;
+
+    sugar::vector<double> values;
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(static_cast<double>(random_u64(seed) % 1000000007));
+    }
+    sugar::kll_sketch<double> kll;
+    double kll_s = seconds([&] { kll.add_range(values); });
+    sugar::vector<double> sorted(values);
+    double sort_s = seconds([&] { sugar::sort(sorted.begin(), sorted.end()); });
+    std::cout << "kll_sketch: " << n / kll_s / 1e6 << " M/s (全量排序 " << n / sort_s / 1e6 << " M/s), 最大秩误差 "
+              << max_rank_error(kll, values) * 100 << "%, 保留 " << kll.retained() << " 个" << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
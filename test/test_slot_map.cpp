@@ -0,0 +1,310 @@
+/*
+ * @file test_slot_map.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 槽位映射测试
+ */
+
+#include "slot_map.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_basic_operations();
+void test_stale_handles();
+void test_exception_safety();
+void test_random_against_model();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Slot Map 测试 ===" << std::endl;
+
+    try {
+        test_basic_operations();
+        test_stale_handles();
+        test_exception_safety();
+        test_random_against_model();
+        test_performance();
+
+        std::cout << "\n🎉 All slot_map tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试基本操作
+void test_basic_operations() {
+    std::cout << "\n=== 测试基本操作 ===" << std::endl;
+
+    sugar::slot_map<std::string> map;
+    assert(map.empty());
+    sugar::slot_map_handle a = map.insert("alpha");
+    sugar::slot_map_handle b = map.emplace(3, 'b');
+    std::string gamma = "gamma";
+    sugar::slot_map_handle c = map.insert(std::move(gamma));
+    assert(map.size() == 3);
+    assert(map[a] == "alpha" && map.at(b) == "bbb" && *map.get(c) == "gamma");
+    assert(a != b && a == a);
+    std::cout << "✓ insert / emplace / 按句柄访问" << std::endl;
+
+    // 删除中间元素后，其他句柄不受影响
+    assert(map.erase(a));
+    assert(!map.erase(a));
+    assert(map.size() == 2 && !map.contains(a) && map.get(a) == nullptr);
+    assert(map[b] == "bbb" && map[c] == "gamma");
+    std::cout << "✓ erase 后其他句柄仍有效" << std::endl;
+
+    // 紧密遍历，并能取回句柄
+    std::string joined;
+    for (const std::string& s : map) {
+        joined += s;
+    }
+    assert(joined.size() == 8);
+    for (size_t i = 0; i < map.size(); ++i) {
+        assert(map[map.handle_at(i)] == map.data()[i]);
+    }
+    std::cout << "✓ 紧密遍历与 handle_at" << std::endl;
+
+    bool threw = false;
+    try {
+        map.at(a);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    sugar::slot_map_handle bogus = {1000, 1};
+    assert(!map.contains(bogus));
+    map.clear();
+    assert(map.empty() && !map.contains(b) && !map.contains(c));
+    std::cout << "✓ 失效句柄：at 抛出 out_of_range，clear 使全部句柄失效" << std::endl;
+}
+
+// 槽位复用后，旧句柄不能访问新元素
+void test_stale_handles() {
+    std::cout << "\n=== 测试失效句柄 ===" << std::endl;
+
+    sugar::slot_map<int> map;
+    sugar::slot_map_handle first = map.insert(1);
+    map.erase(first);
+    sugar::slot_map_handle second = map.insert(2);
+    assert(second.index == first.index);       // 复用同一槽位
+    assert(second.generation != first.generation);
+    assert(!map.contains(first) && map[second] == 2);
+    for (int i = 0; i < 1000; ++i) {
+        sugar::slot_map_handle h = map.insert(i);
+        assert(map.erase(h));
+        assert(!map.contains(h));
+    }
+    assert(map.size() == 1 && map[second] == 2);
+    std::cout << "✓ 同一槽位反复分配，旧句柄全部失效" << std::endl;
+}
+
+// 复制时可能抛出异常的值类型
+struct fragile {
+    static bool fail;
+    int v;
+    explicit fragile(int x) : v(x) {}
+    fragile(const fragile& other) : v(other.v) {
+        if (fail) {
+            throw std::runtime_error("fragile copy");
+        }
+    }
+    fragile(fragile&& other) noexcept : v(other.v) {}
+    fragile& operator=(const fragile& other) {
+        v = other.v;
+        return *this;
+    }
+    fragile& operator=(fragile&& other) noexcept {
+        v = other.v;
+        return *this;
+    }
+};
+
+bool fragile::fail = false;
+
+// 插入抛出异常时，值、属主和槽位保持一致，空闲链不被破坏
+void test_exception_safety() {
+    std::cout << "\n=== 测试异常安全 ===" << std::endl;
+
+    sugar::slot_map<fragile> map;
+    std::vector<sugar::slot_map_handle> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.push_back(map.insert(fragile(i)));
+    }
+    sugar::slot_map_handle erased = handles[10];
+    assert(map.erase(erased));
+
+    // 先在空闲链非空时抛出，再在空闲链为空时抛出
+    for (int round = 0; round < 2; ++round) {
+        const size_t before = map.size();
+        fragile value(-1);
+        fragile::fail = true;
+        bool threw = false;
+        try {
+            map.insert(value);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        fragile::fail = false;
+        assert(threw && map.size() == before);
+        for (size_t i = 0; i < map.size(); ++i) {
+            const sugar::slot_map_handle h = map.handle_at(i);
+            assert(map.contains(h) && &map[h] == map.data() + i && map[h].v != -1);
+        }
+        assert(!map.contains(erased));
+        for (int i = 0; i < 100; ++i) {
+            assert(i == 10 || map[handles[i]].v == i);
+        }
+        if (round == 0) {
+            // 失败的插入不消耗空闲槽位
+            handles[10] = map.insert(fragile(10));
+            assert(handles[10].index == erased.index && handles[10].generation != erased.generation);
+        }
+    }
+    std::cout << "✓ 插入抛出异常后句柄、属主与空闲链保持一致" << std::endl;
+}
+
+// 与以句柄为键的std::unordered_map逐步比对
+void test_random_against_model() {
+    std::cout << "\n=== 测试随机操作序列 ===" << std::endl;
+
+    sugar::slot_map<uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> model;
+    std::vector<sugar::slot_map_handle> handles;    // 包括已失效的句柄
+    unsigned int seed = 17;
+    for (int i = 0; i < 200000; ++i) {
+        const unsigned int op = lcg_next(seed) % 10;
+        if (op < 4 || handles.empty()) {
+            sugar::slot_map_handle h = map.insert(static_cast<uint64_t>(i));
+            const uint64_t id = (static_cast<uint64_t>(h.index) << 32) | h.generation;
+            assert(model.count(id) == 0);
+            model[id] = static_cast<uint64_t>(i);
+            handles.push_back(h);
+        } else {
+            sugar::slot_map_handle h = handles[(lcg_next(seed) << 15 | lcg_next(seed)) % handles.size()];
+            const uint64_t id = (static_cast<uint64_t>(h.index) << 32) | h.generation;
+            const bool alive = model.count(id) == 1;
+            if (op < 7) {
+                assert(map.erase(h) == alive);
+                model.erase(id);
+            } else {
+                const uint64_t* v = map.get(h);
+                assert((v != nullptr) == alive);
+                assert(!alive || *v == model[id]);
+            }
+        }
+    }
+    assert(map.size() == model.size());
+    uint64_t sum = 0;
+    uint64_t model_sum = 0;
+    for (uint64_t v : map) {
+        sum += v;
+    }
+    for (std::unordered_map<uint64_t, uint64_t>::const_iterator it = model.begin(); it != model.end(); ++it) {
+        model_sum += it->second;
+    }
+    assert(sum == model_sum);
+    std::cout << "✓ 20万次随机插入/删除/查找（含失效句柄）与参考实现一致" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 典型的实体组件
+struct particle {
+    float x, y, z;
+    float vx, vy, vz;
+};
+
+// 测试性能：遍历与按句柄查找，与以句柄为键的散列表比较
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const int n = 1000000;
+    sugar::slot_map<particle> map;
+    std::unordered_map<uint64_t, particle> table;
+    std::vector<sugar::slot_map_handle> handles;
+    map.reserve(n);
+    table.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        particle p = {static_cast<float>(i), 0, 0, 1, 2, 3};
+        sugar::slot_map_handle h = map.insert(p);
+        handles.push_back(h);
+        table[(static_cast<uint64_t>(h.index) << 32) | h.generation] = p;
+    }
+    // 删掉一半再插回，模拟实体的生灭
+    unsigned int seed = 5;
+    for (int i = 0; i < n / 2; ++i) {
+        const size_t k = (lcg_next(seed) << 15 | lcg_next(seed)) % handles.size();
+        const sugar::slot_map_handle old = handles[k];
+        if (map.erase(old)) {
+            table.erase((static_cast<uint64_t>(old.index) << 32) | old.generation);
+            particle p = {static_cast<float>(i), 0, 0, 1, 2, 3};
+            handles[k] = map.insert(p);
+            table[(static_cast<uint64_t>(handles[k].index) << 32) | handles[k].generation] = p;
+        }
+    }
+
+    const int rounds = 20;
+    float sink = 0;
+    double map_iter = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (particle& p : map) {
+                p.x += p.vx;
+                sink += p.x;
+            }
+        }
+    });
+    double table_iter = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (std::unordered_map<uint64_t, particle>::iterator it = table.begin(); it != table.end(); ++it) {
+                it->second.x += it->second.vx;
+                sink += it->second.x;
+            }
+        }
+    });
+    std::cout << "遍历100万元素: slot_map " << map_iter / rounds / n * 1e9 << " ns/个, std::unordered_map "
+              << table_iter / rounds / n * 1e9 << " ns/个" << std::endl;
+
+    const int lookups = 4000000;
+    std::vector<sugar::slot_map_handle> order(lookups);
+    for (int i = 0; i < lookups; ++i) {
+        order[static_cast<size_t>(i)] = handles[(lcg_next(seed) << 15 | lcg_next(seed)) % handles.size()];
+    }
+    double map_find = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            sink += map[order[static_cast<size_t>(i)]].y;
+        }
+    });
+    double table_find = seconds([&] {
+        for (int i = 0; i < lookups; ++i) {
+            const sugar::slot_map_handle h = order[static_cast<size_t>(i)];
+            sink += table.find((static_cast<uint64_t>(h.index) << 32) | h.generation)->second.y;
+        }
+    });
+    std::cout << "随机按句柄查找: slot_map " << map_find / lookups * 1e9 << " ns, std::unordered_map "
+              << table_find / lookups * 1e9 << " ns (" << (sink > 0) << ")" << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
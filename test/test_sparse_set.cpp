@@ -0,0 +1,277 @@
+/*
+ * @file test_sparse_set.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 整数集合测试
+ */
+
+#include "sparse_set.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+static uint32_t random_below(unsigned int& state, uint32_t n) {
+    return ((static_cast<uint32_t>(lcg_next(state)) << 15) | lcg_next(state)) % n;
+}
+
+// 测试函数声明
+void test_sparse_set();
+void test_integer_set_modes();
+void test_integer_set_random();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Sparse Set 测试 ===" << std::endl;
+
+    try {
+        test_sparse_set();
+        test_integer_set_modes();
+        test_integer_set_random();
+        test_performance();
+
+        std::cout << "\n🎉 All sparse_set tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 测试sparse_set
+void test_sparse_set() {
+    std::cout << "\n=== 测试 sparse_set ===" << std::endl;
+
+    sugar::sparse_set s(100);
+    assert(s.empty() && s.universe() == 100);
+    assert(s.insert(5) && s.insert(99) && s.insert(0));
+    assert(!s.insert(5));
+    assert(s.size() == 3 && s.contains(5) && s.contains(0) && !s.contains(6) && !s.contains(1000));
+    assert(s.erase(5) && !s.erase(5));
+    assert(s.size() == 2 && !s.contains(5) && s.contains(99));
+    std::vector<uint32_t> members(s.begin(), s.end());
+    std::sort(members.begin(), members.end());
+    assert((members == std::vector<uint32_t>{0, 99}));
+    std::cout << "✓ insert / erase / contains / 稠密遍历" << std::endl;
+
+    // O(1) clear 后残留的稀疏下标不影响判断
+    s.clear();
+    assert(s.empty() && !s.contains(0) && !s.contains(99));
+    assert(s.insert(99) && s.size() == 1 && !s.contains(0));
+    bool threw = false;
+    try {
+        s.insert(100);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ O(1) clear，越界插入抛出 out_of_range" << std::endl;
+
+    // 值域超过uint32_t时在分配之前抛出
+    if (sizeof(size_t) > 4) {
+        threw = false;
+        try {
+            sugar::sparse_set huge(static_cast<size_t>(0xffffffffu) + 1);
+        } catch (const std::length_error&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "✓ 值域过大抛出 length_error" << std::endl;
+    }
+}
+
+// 测试形态切换
+void test_integer_set_modes() {
+    std::cout << "\n=== 测试 integer_set 形态切换 ===" << std::endl;
+
+    sugar::integer_set s(1 << 16);
+    assert(s.mode() == sugar::integer_set_mode::sorted);
+    for (uint32_t x = 0; x < 64; ++x) {
+        s.insert(x * 7);
+    }
+    assert(s.mode() == sugar::integer_set_mode::sorted);
+    s.insert(1);
+    assert(s.mode() == sugar::integer_set_mode::sparse);
+    // 达到值域的1/16转为位图
+    for (uint32_t x = 0; s.size() < (1u << 16) / 16; x += 3) {
+        s.insert(x);
+    }
+    assert(s.mode() == sugar::integer_set_mode::bitmap);
+    std::vector<uint32_t> ordered;
+    s.for_each([&](uint32_t x) { ordered.push_back(x); });
+    assert(ordered.size() == s.size() && std::is_sorted(ordered.begin(), ordered.end()));
+    std::cout << "✓ 有序数组 -> sparse_set -> 位图，位图按升序遍历" << std::endl;
+
+    // 删除到阈值一半以下才转回，避免抖动
+    while (s.size() >= (1u << 16) / 32) {
+        s.erase(ordered.back());
+        ordered.pop_back();
+    }
+    assert(s.mode() == sugar::integer_set_mode::sparse);
+    while (s.size() > 32) {
+        s.erase(ordered.back());
+        ordered.pop_back();
+    }
+    assert(s.mode() == sugar::integer_set_mode::sorted);
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        assert(s.contains(ordered[i]));
+    }
+    s.clear();
+    assert(s.empty() && s.mode() == sugar::integer_set_mode::sorted && !s.contains(0));
+    std::cout << "✓ 删除后带滞回地转回稀疏形态，clear 回到有序数组" << std::endl;
+
+    // 小值域：位图阈值不低于有序数组上限
+    sugar::integer_set tiny(100);
+    for (uint32_t x = 0; x < 100; ++x) {
+        tiny.insert(x);
+    }
+    assert(tiny.size() == 100 && tiny.mode() == sugar::integer_set_mode::bitmap);
+    std::cout << "✓ 小值域直接由有序数组转为位图" << std::endl;
+}
+
+// 各密度下随机增删与std::set比对
+void test_integer_set_random() {
+    std::cout << "\n=== 测试 integer_set 随机操作 ===" << std::endl;
+
+    const uint32_t universe = 20000;
+    sugar::integer_set s(universe);
+    std::set<uint32_t> model;
+    unsigned int seed = 31;
+    bool seen[3] = {false, false, false};
+    for (int phase = 0; phase < 6; ++phase) {
+        // 偶数阶段偏向插入，奇数阶段偏向删除，让密度来回跨越各个阈值
+        for (int i = 0; i < 30000; ++i) {
+            const uint32_t x = random_below(seed, phase < 2 ? universe / 8 : universe);
+            const bool grow = (lcg_next(seed) % 10) < (phase % 2 == 0 ? 7u : 2u);
+            if (grow) {
+                assert(s.insert(x) == model.insert(x).second);
+            } else {
+                assert(s.erase(x) == (model.erase(x) == 1));
+            }
+            assert(s.size() == model.size());
+            seen[static_cast<int>(s.mode())] = true;
+            if (i % 5000 == 0) {
+                std::vector<uint32_t> got;
+                s.for_each([&](uint32_t v) { got.push_back(v); });
+                std::sort(got.begin(), got.end());
+                assert(got == std::vector<uint32_t>(model.begin(), model.end()));
+                const uint32_t probe = random_below(seed, universe);
+                assert(s.contains(probe) == (model.count(probe) == 1));
+            }
+        }
+    }
+    assert(seen[0] && seen[1] && seen[2]);
+    std::cout << "✓ 18万次随机增删在三种形态间往返，与 std::set 一致" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：值域100万，不同密度下的遍历与成员判断
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const uint32_t universe = 1000000;
+    const int probes = 2000000;
+    for (uint32_t members : {1000u, 10000u, 100000u, 500000u}) {
+        sugar::sparse_set sparse(universe);
+        sugar::integer_set adaptive(universe);
+        std::vector<bool> bits(universe, false);
+        std::unordered_set<uint32_t> hashed;
+        unsigned int seed = members;
+        while (sparse.size() < members) {
+            const uint32_t x = random_below(seed, universe);
+            sparse.insert(x);
+            adaptive.insert(x);
+            bits[x] = true;
+            hashed.insert(x);
+        }
+        // 只扫成员的结构按成员数定轮数，要扫整个值域或散列桶的结构固定10轮
+        const int rounds = static_cast<int>(20000000 / members);
+        const int scan_rounds = 10;
+        uint64_t sum = 0;
+        double sparse_iter = seconds([&] {
+            for (int r = 0; r < rounds; ++r) {
+                for (sugar::sparse_set::const_iterator it = sparse.begin(); it != sparse.end(); ++it) {
+                    sum += *it;
+                }
+            }
+        });
+        double adaptive_iter = seconds([&] {
+            for (int r = 0; r < rounds; ++r) {
+                adaptive.for_each([&](uint32_t x) { sum += x; });
+            }
+        });
+        double bits_iter = seconds([&] {
+            for (int r = 0; r < scan_rounds; ++r) {
+                for (uint32_t x = 0; x < universe; ++x) {
+                    if (bits[x]) {
+                        sum += x;
+                    }
+                }
+            }
+        });
+        double hashed_iter = seconds([&] {
+            for (int r = 0; r < scan_rounds; ++r) {
+                for (std::unordered_set<uint32_t>::const_iterator it = hashed.begin(); it != hashed.end(); ++it) {
+                    sum += *it;
+                }
+            }
+        });
+        std::cout << "成员 " << members << "（" << adaptive.size() * 100.0 / universe << "%，integer_set 形态 "
+                  << static_cast<int>(adaptive.mode()) << "）遍历一次: sparse_set " << sparse_iter / rounds * 1e6
+                  << " us, integer_set " << adaptive_iter / rounds * 1e6 << " us, std::vector<bool> "
+                  << bits_iter / scan_rounds * 1e6 << " us, std::unordered_set " << hashed_iter / scan_rounds * 1e6
+                  << " us" << std::endl;
+
+        std::vector<uint32_t> queries(probes);
+        for (int i = 0; i < probes; ++i) {
+            queries[static_cast<size_t>(i)] = random_below(seed, universe);
+        }
+        size_t hits = 0;
+        double sparse_find = seconds([&] {
+            for (int i = 0; i < probes; ++i) {
+                hits += sparse.contains(queries[static_cast<size_t>(i)]);
+            }
+        });
+        double adaptive_find = seconds([&] {
+            for (int i = 0; i < probes; ++i) {
+                hits += adaptive.contains(queries[static_cast<size_t>(i)]);
+            }
+        });
+        double bits_find = seconds([&] {
+            for (int i = 0; i < probes; ++i) {
+                hits += bits[queries[static_cast<size_t>(i)]];
+            }
+        });
+        double hashed_find = seconds([&] {
+            for (int i = 0; i < probes; ++i) {
+                hits += hashed.count(queries[static_cast<size_t>(i)]);
+            }
+        });
+        std::cout << "    随机判断: sparse_set " << sparse_find / probes * 1e9 << " ns, integer_set "
+                  << adaptive_find / probes * 1e9 << " ns, std::vector<bool> " << bits_find / probes * 1e9
+                  << " ns, std::unordered_set " << hashed_find / probes * 1e9 << " ns (" << ((sum + hits) & 1)
+                  << ")" << std::endl;
+    }
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
@@ -0,0 +1,275 @@
+/*
+ * @file test_top_k.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL top-k 选择测试
+ */
+
+#include "top_k.h"
+#include "functional.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 测试函数声明
+void test_top_k();
+void test_accumulator();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Top-K 测试 ===" << std::endl;
+
+    try {
+        test_top_k();
+        test_accumulator();
+        test_performance();
+
+        std::cout << "\n🎉 All top_k tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+static std::vector<int> random_scores(size_t n, unsigned int seed, unsigned int modulo) {
+    std::vector<int> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<int>(((lcg_next(seed) << 15) | lcg_next(seed)) % modulo);
+    }
+    return v;
+}
+
+// 参考实现：降序排序后取前k个
+static std::vector<int> expected_top(std::vector<int> v, size_t k) {
+    std::sort(v.begin(), v.end(), std::greater<int>());
+    v.resize(std::min(k, v.size()));
+    return v;
+}
+
+// 带编号的候选项，只按分数比较
+struct candidate {
+    float score;
+    int id;
+};
+
+struct by_score {
+    bool operator()(const candidate& a, const candidate& b) const {
+        return a.score < b.score;
+    }
+};
+
+// 测试原地top_k
+void test_top_k() {
+    std::cout << "\n=== 测试 top_k ===" << std::endl;
+
+    for (size_t n = 0; n < 3000; n = n * 2 + 1) {
+        for (unsigned int modulo : {5u, 1000000u}) {
+            std::vector<int> data = random_scores(n, static_cast<unsigned int>(n + modulo), modulo);
+            const size_t ks[] = {0, 1, 7, n / 16, n / 2, n, n + 5};
+            for (size_t k : ks) {
+                std::vector<int> expected = expected_top(data, k);
+                std::vector<int> a = data;
+                std::vector<int> b = data;
+                std::vector<int> c = data;
+                int* m1 = sugar::top_k(a.data(), a.data() + n, k);
+                int* m2 = sugar::top_k_heap(b.data(), b.data() + n, k, sugar::less<int>());
+                int* m3 = sugar::top_k_select(c.data(), c.data() + n, k, sugar::less<int>());
+                assert(static_cast<size_t>(m1 - a.data()) == expected.size());
+                assert(m2 - b.data() == m1 - a.data() && m3 - c.data() == m1 - a.data());
+                assert(std::equal(expected.begin(), expected.end(), a.begin()));
+                assert(std::equal(expected.begin(), expected.end(), b.begin()));
+                assert(std::equal(expected.begin(), expected.end(), c.begin()));
+                // 剩余元素仍是原来的多重集
+                std::sort(a.begin(), a.end());
+                std::vector<int> sorted = data;
+                std::sort(sorted.begin(), sorted.end());
+                assert(a == sorted);
+            }
+        }
+    }
+    std::cout << "✓ top_k / top_k_heap / top_k_select 与排序结果一致（含k=0、k>n、大量重复）" << std::endl;
+
+    // 自定义比较函数：按分数保留最高的3个
+    std::vector<candidate> cands;
+    for (int i = 0; i < 100; ++i) {
+        candidate c = {static_cast<float>((i * 37) % 101), i};
+        cands.push_back(c);
+    }
+    std::vector<candidate>::iterator end = sugar::top_k(cands.begin(), cands.end(), 3, by_score());
+    assert(end - cands.begin() == 3);
+    assert(cands[0].score == 100.0f && cands[1].score == 99.0f && cands[2].score == 98.0f);
+    assert((cands[0].id * 37) % 101 == 100);
+    std::cout << "✓ 自定义比较函数" << std::endl;
+}
+
+// 测试流式累加器
+void test_accumulator() {
+    std::cout << "\n=== 测试 top_k_accumulator ===" << std::endl;
+
+    const size_t n = 100000;
+    const size_t k = 100;
+    std::vector<int> data = random_scores(n, 3, 50000);
+    std::vector<int> expected = expected_top(data, k);
+
+    sugar::top_k_accumulator<int> acc(k);
+    assert(acc.empty() && acc.k() == k);
+    const int* storage = &*acc.begin();
+    // 不同大小的批次，单个push与批量push混用
+    size_t pos = 0;
+    unsigned int seed = 9;
+    while (pos < n) {
+        size_t batch = std::min<size_t>(n - pos, lcg_next(seed) % 5000);
+        if (batch % 3 == 0) {
+            for (size_t i = 0; i < batch; ++i) {
+                acc.push(data[pos + i]);
+            }
+        } else {
+            acc.push(data.data() + pos, data.data() + pos + batch);
+        }
+        pos += batch;
+    }
+    assert(acc.full() && acc.size() == k);
+    assert(acc.threshold() == expected.back());
+    assert(&*acc.begin() == storage);
+    std::cout << "✓ 分批输入，存储不重新分配" << std::endl;
+
+    std::vector<int> out(k);
+    assert(acc.extract(out.data()) == out.data() + k);
+    assert(out == expected);
+    // extract后仍可继续使用
+    acc.push(1 << 30);
+    acc.extract(out.data());
+    assert(out[0] == (1 << 30) && out[k - 1] == expected[k - 2]);
+    std::cout << "✓ extract 按从好到差输出，且不破坏累加器" << std::endl;
+
+    // 多线程分片后合并
+    const int threads = 4;
+    std::vector<sugar::top_k_accumulator<int>> parts(threads, sugar::top_k_accumulator<int>(k));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t] {
+            size_t lo = n * t / threads;
+            size_t hi = n * (t + 1) / threads;
+            parts[t].push(data.data() + lo, data.data() + hi);
+        }));
+    }
+    for (std::thread& w : workers) {
+        w.join();
+    }
+    sugar::top_k_accumulator<int> merged(k);
+    for (int t = 0; t < threads; ++t) {
+        merged.merge(parts[t]);
+    }
+    merged.extract(out.data());
+    assert(out == expected);
+    std::cout << "✓ 跨线程 merge" << std::endl;
+
+    // 保留最小的k个 / k=0 / 未满 / 清空
+    sugar::top_k_accumulator<int, sugar::greater<int>> smallest(3);
+    smallest.push(data.begin(), data.end());
+    int low[3];
+    smallest.extract(low);
+    std::vector<int> sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    assert(low[0] == sorted[0] && low[1] == sorted[1] && low[2] == sorted[2]);
+
+    sugar::top_k_accumulator<int> none(0);
+    none.push(data.begin(), data.end());
+    none.push(5);
+    assert(none.empty());
+
+    sugar::top_k_accumulator<int> partial(10);
+    partial.push(data.begin(), data.begin() + 4);
+    assert(partial.size() == 4 && !partial.full());
+    partial.clear();
+    assert(partial.empty());
+    bool caught = false;
+    try {
+        partial.threshold();
+    } catch (const std::out_of_range&) {
+        caught = true;
+    }
+    assert(caught);
+    std::cout << "✓ 自定义比较函数 / k=0 / 未满 / clear / 异常" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static long long time_us(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：不同k与n下的各实现及std::partial_sort
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t sizes[] = {1000000, 10000000};
+    for (size_t n : sizes) {
+        std::vector<int> base = random_scores(n, static_cast<unsigned int>(n), 1u << 30);
+        std::vector<int> a;
+        const size_t ks[] = {10, 100, 1000, 10000, 100000, 1000000};
+        for (size_t k : ks) {
+            if (k >= n) {
+                continue;
+            }
+            a = base;
+            long long heap_us = time_us([&] { sugar::top_k_heap(a.data(), a.data() + n, k, sugar::less<int>()); });
+            int best = a[0];
+            a = base;
+            long long select_us = time_us([&] { sugar::top_k_select(a.data(), a.data() + n, k, sugar::less<int>()); });
+            assert(a[0] == best);
+            a = base;
+            long long auto_us = time_us([&] { sugar::top_k(a.data(), a.data() + n, k); });
+            assert(a[0] == best);
+            a = base;
+            long long std_us = time_us([&] { std::partial_sort(a.begin(), a.begin() + k, a.end(), std::greater<int>()); });
+            assert(a[0] == best);
+
+            // 流式：8K一批送入累加器，4线程分片后合并
+            sugar::top_k_accumulator<int> acc(k);
+            long long stream_us = time_us([&] {
+                for (size_t pos = 0; pos < n; pos += 8192) {
+                    acc.push(base.data() + pos, base.data() + std::min(n, pos + 8192));
+                }
+            });
+            std::vector<sugar::top_k_accumulator<int>> parts(4, sugar::top_k_accumulator<int>(k));
+            sugar::top_k_accumulator<int> merged(k);
+            long long parallel_us = time_us([&] {
+                std::vector<std::thread> workers;
+                for (size_t t = 0; t < 4; ++t) {
+                    workers.push_back(std::thread([&, t] {
+                        parts[t].push(base.data() + n * t / 4, base.data() + n * (t + 1) / 4);
+                    }));
+                }
+                for (std::thread& w : workers) {
+                    w.join();
+                }
+                for (size_t t = 0; t < 4; ++t) {
+                    merged.merge(parts[t]);
+                }
+            });
+            assert(acc.size() == k && merged.size() == k && acc.threshold() == merged.threshold());
+
+            std::cout << "n=" << n << " k=" << k << ": heap " << heap_us << " us, select " << select_us
+                      << " us, top_k " << auto_us << " us, std::partial_sort " << std_us << " us, 流式 "
+                      << stream_us << " us, 4线程合并 " << parallel_us << " us" << std::endl;
+        }
+    }
+    std::cout << "✓ top_k 性能对比" << std::endl;
+}
@@ -0,0 +1,236 @@
+/*
+ * @file test_varint.cpp
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 变长整数编码测试
+ */
+
+#include "varint.h"
+#include "vector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// 简单的线性同余随机数，保证测试可复现
+static unsigned int lcg_next(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+// 位长均匀分布的随机数：小值与大值都常见
+static uint64_t random_length_u64(unsigned int& state, unsigned max_bits) {
+    uint64_t v = 0;
+    for (int i = 0; i < 5; ++i) {
+        v = (v << 15) ^ lcg_next(state);
+    }
+    const unsigned bits = lcg_next(state) % (max_bits + 1);
+    return bits == 64 ? v : v & ((uint64_t(1) << bits) - 1);
+}
+
+// 测试函数声明
+void test_varint_buffer();
+void test_stream_vbyte_buffer();
+void test_performance();
+
+int main() {
+    std::cout << "=== MyMiniSTL Varint 测试 ===" << std::endl;
+
+    try {
+        test_varint_buffer();
+        test_stream_vbyte_buffer();
+        test_performance();
+
+        std::cout << "\n🎉 All varint tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
+
+// 随机区间批量解码与模型比对
+template<typename Buffer, typename T>
+static void check_ranges(const Buffer& buf, const std::vector<T>& model, unsigned int seed) {
+    std::vector<T> out(model.size() + 1);
+    for (int r = 0; r < 200; ++r) {
+        const size_t first = (lcg_next(seed) << 15 | lcg_next(seed)) % (model.size() + 1);
+        const size_t count = (lcg_next(seed) << 15 | lcg_next(seed)) % (model.size() - first + 1);
+        buf.decode(first, count, out.data());
+        for (size_t i = 0; i < count; ++i) {
+            assert(out[i] == model[first + i]);
+        }
+    }
+    for (size_t i = 0; i < model.size(); i += 7) {
+        assert(buf[i] == model[i]);
+    }
+}
+
+// 测试varint_buffer
+void test_varint_buffer() {
+    std::cout << "\n=== 测试 varint_buffer ===" << std::endl;
+
+    const uint64_t edges[] = {0, 1, 127, 128, 16383, 16384, 0xffffffffull, 0x100000000ull, ~uint64_t(0)};
+    const size_t edge_bytes[] = {1, 1, 1, 2, 2, 3, 5, 5, 10};
+    sugar::varint_buffer buf;
+    size_t expected = 0;
+    for (size_t i = 0; i < 9; ++i) {
+        buf.push_back(edges[i]);
+        expected += edge_bytes[i];
+        assert(buf.encoded_bytes() == expected);
+    }
+    for (size_t i = 0; i < 9; ++i) {
+        assert(buf.at(i) == edges[i]);
+    }
+    bool threw = false;
+    try {
+        buf.at(9);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ 7位一组的边界值编码长度正确，at 越界抛出 out_of_range" << std::endl;
+
+    buf.clear();
+    assert(buf.empty() && buf.encoded_bytes() == 0);
+    unsigned int seed = 5;
+    std::vector<uint64_t> model;
+    for (int i = 0; i < 20000; ++i) {
+        // 前半段全是单字节值，覆盖8字节快速路径
+        const uint64_t v = i < 10000 ? lcg_next(seed) & 0x7f : random_length_u64(seed, 64);
+        buf.push_back(v);
+        model.push_back(v);
+    }
+    check_ranges(buf, model, 11);
+    sugar::vector<uint64_t> all;
+    buf.decode(all);
+    assert(all.size() == model.size() && all[19999] == model[19999] && all[0] == model[0]);
+    std::cout << "✓ 混合长度的随机访问与任意区间批量解码与模型一致" << std::endl;
+}
+
+// 测试stream_vbyte_buffer
+void test_stream_vbyte_buffer() {
+    std::cout << "\n=== 测试 stream_vbyte_buffer ===" << std::endl;
+
+    const uint32_t edges[] = {0, 255, 256, 65535, 65536, 0xffffff, 0x1000000, 0xffffffffu};
+    const size_t edge_bytes[] = {1, 1, 2, 2, 3, 3, 4, 4};
+    sugar::stream_vbyte_buffer buf;
+    size_t data_bytes = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        buf.push_back(edges[i]);
+        data_bytes += edge_bytes[i];
+    }
+    // 控制字节每4个值1字节
+    assert(buf.encoded_bytes() == data_bytes + 2);
+    for (size_t i = 0; i < 8; ++i) {
+        assert(buf.at(i) == edges[i]);
+    }
+    uint32_t out[8];
+    buf.decode(0, 8, out);
+    assert(std::memcmp(out, edges, sizeof(edges)) == 0);
+    bool threw = false;
+    try {
+        buf.decode(5, 4, out);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ 1~4字节边界值，解码越界抛出 out_of_range" << std::endl;
+
+    buf.clear();
+    assert(buf.empty() && buf.encoded_bytes() == 0);
+    unsigned int seed = 6;
+    std::vector<uint32_t> model;
+    for (int i = 0; i < 20003; ++i) {
+        const uint32_t v = static_cast<uint32_t>(random_length_u64(seed, 32));
+        buf.push_back(v);
+        model.push_back(v);
+    }
+    check_ranges(buf, model, 12);
+    sugar::vector<uint32_t> all;
+    buf.decode(all);
+    assert(all.size() == model.size() && all[20002] == model[20002]);
+    std::cout << "✓ 不满4个的尾组、任意起点的区间解码与模型一致" << std::endl;
+}
+
+// 计时辅助
+template<typename F>
+static double seconds(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 测试性能：压缩率与解码吞吐
+void test_performance() {
+    std::cout << "\n=== 测试性能 ===" << std::endl;
+
+    const size_t n = 4 * 1024 * 1024;
+    const int rounds = 5;
+    const int probes = 1000000;
+    unsigned int seed = 8;
+    uint64_t sink = 0;
+
+    // 计数类数据：大多小于128，偶有大值
+    sugar::varint_buffer counts;
+    sugar::stream_vbyte_buffer counts32;
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t v = lcg_next(seed) % 16 == 0 ? lcg_next(seed) << 8 : lcg_next(seed) & 0x7f;
+        counts.push_back(v);
+        counts32.push_back(v);
+    }
+    counts.shrink_to_fit();
+    counts32.shrink_to_fit();
+
+    sugar::vector<uint64_t> out64;
+    double varint_s = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            counts.decode(out64);
+            sink += out64[static_cast<size_t>(r)];
+        }
+    });
+    double varint_random = seconds([&] {
+        for (int i = 0; i < probes; ++i) {
+            sink += counts[(lcg_next(seed) << 15 | lcg_next(seed)) % n];
+        }
+    });
+    const double raw64 = static_cast<double>(n * sizeof(uint64_t));
+    std::cout << "varint_buffer: 压缩比 " << raw64 / counts.memory_bytes() << "x, 解码 "
+              << raw64 * rounds / varint_s / 1e9 << " GB/s, 随机访问 " << varint_random / probes * 1e9 << " ns"
+              << std::endl;
+
+    sugar::vector<uint32_t> out32;
+    double svb_s = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            counts32.decode(out32);
+            sink += out32[static_cast<size_t>(r)];
+        }
+    });
+    double svb_random = seconds([&] {
+        for (int i = 0; i < probes; ++i) {
+            sink += counts32[(lcg_next(seed) << 15 | lcg_next(seed)) % n];
+        }
+    });
+    assert(out32[n - 1] == out64[n - 1]);
+    const double raw32 = static_cast<double>(n * sizeof(uint32_t));
+    std::cout << "stream_vbyte_buffer: 压缩比 " << raw32 / counts32.memory_bytes() << "x, 解码 "
+              << raw32 * rounds / svb_s / 1e9 << " GB/s, 随机访问 " << svb_random / probes * 1e9 << " ns"
+              << std::endl;
+
+    // 基准：未压缩数组的拷贝
+    sugar::vector<uint32_t> copy(n);
+    double copy_s = seconds([&] {
+        for (int r = 0; r < rounds; ++r) {
+            std::memcpy(copy.data(), out32.data(), n * sizeof(uint32_t));
+            sink += copy[static_cast<size_t>(r)];
+        }
+    });
+    std::cout << "基准 memcpy: " << raw32 * rounds / copy_s / 1e9 << " GB/s (" << (sink & 1) << ")" << std::endl;
+    std::cout << "✓ 性能对比完成" << std::endl;
+}
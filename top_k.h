@@ -0,0 +1,246 @@
+/*
+ * @file top_k.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL top-k 选择：原地top_k（小k用有界堆，大k用nth_element+排序）
+ *        以及可分批输入、可跨线程合并的top_k_accumulator
+ */
+
+#ifndef TOP_K_H_
+#define TOP_K_H_
+
+#include "algorithm.h"
+#include "vector.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "exceptdef.h"
+#include <cstddef>
+
+namespace sugar {
+
+// ============================ top_k 算法 ============================
+
+/**
+ * @brief 反转比较函数：worse(a, b) 表示a比b更好（按comp更大）。
+ *        用它建堆时堆顶是保留元素中最差的一个，新元素只需与堆顶比较
+ */
+template<typename Compare>
+struct top_k_worse {
+    Compare comp;
+
+    explicit top_k_worse(Compare c = Compare()) : comp(c) {}
+
+    template<typename T>
+    bool operator()(const T& a, const T& b) const {
+        return comp(b, a);
+    }
+};
+
+/**
+ * @brief n至少是k的该倍数时top_k走有界堆，否则走nth_element
+ *
+ * 随机输入下有界堆只在约 k*ln(n/k) 次替换时付出O(log k)，其余元素只与堆顶比较一次；
+ * k接近n时替换频繁，期望O(n)的选择算法更划算
+ */
+const size_t top_k_heap_ratio = 16;
+
+/**
+ * @brief 有界堆top-k：前k个位置建成以最差者为顶的堆，再扫描其余元素
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param k 需要的元素个数
+ * @param comp 比较函数，按comp越大越靠前
+ * @return first + min(k, last - first)，[first, 返回值)按从好到差排列
+ */
+template<typename RandomIt, typename Compare>
+RandomIt top_k_heap(RandomIt first, RandomIt last, size_t k, Compare comp) {
+    const size_t n = static_cast<size_t>(last - first);
+    RandomIt middle = first + (k < n ? k : n);
+    sugar::partial_sort(first, middle, last, top_k_worse<Compare>(comp));
+    return middle;
+}
+
+/**
+ * @brief 选择版top-k：nth_element把前k好的元素划分到前面，再只对这k个排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param k 需要的元素个数
+ * @param comp 比较函数，按comp越大越靠前
+ * @return first + min(k, last - first)，[first, 返回值)按从好到差排列
+ */
+template<typename RandomIt, typename Compare>
+RandomIt top_k_select(RandomIt first, RandomIt last, size_t k, Compare comp) {
+    const size_t n = static_cast<size_t>(last - first);
+    RandomIt middle = first + (k < n ? k : n);
+    top_k_worse<Compare> worse(comp);
+    sugar::nth_element(first, middle, last, worse);
+    sugar::sort(first, middle, worse);
+    return middle;
+}
+
+/**
+ * @brief 原地选出[first, last)中按comp最大的k个元素，按从好到差放在区间开头，其余元素顺序未指定。
+ *        不分配内存
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param k 需要的元素个数，超过区间长度时相当于整体降序排序
+ * @param comp 比较函数，按comp越大越靠前
+ * @return first + min(k, last - first)
+ */
+template<typename RandomIt, typename Compare>
+RandomIt top_k(RandomIt first, RandomIt last, size_t k, Compare comp) {
+    const size_t n = static_cast<size_t>(last - first);
+    if (k <= n / top_k_heap_ratio) {
+        return sugar::top_k_heap(first, last, k, comp);
+    }
+    return sugar::top_k_select(first, last, k, comp);
+}
+
+/**
+ * @brief 原地选出[first, last)中最大的k个元素（使用operator<）
+ */
+template<typename RandomIt>
+RandomIt top_k(RandomIt first, RandomIt last, size_t k) {
+    return sugar::top_k(first, last, k, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// ============================ top_k_accumulator 类模板 ============================
+
+/**
+ * @brief top_k_accumulator 类模板，流式top-k
+ *
+ * 构造时按k预留存储，此后push/merge/extract都不再分配内存。
+ * 内部是容量为k、以最差元素为顶的堆：未满时直接入堆，满后新元素先与堆顶比较，
+ * 不优于堆顶的直接丢弃，因此大批量输入时绝大多数元素只花一次比较。
+ * 多线程时每个线程各持一个累加器处理自己的分片，最后用merge合并。
+ *
+ * @tparam T 元素类型
+ * @tparam Compare 比较函数，按comp越大越靠前，默认为sugar::less<T>（保留最大的k个）
+ */
+template<typename T, typename Compare = less<T>>
+class top_k_accumulator {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = T;
+    using value_compare = Compare;
+    using size_type = size_t;
+    using const_iterator = typename vector<T>::const_iterator;
+
+private:
+    // ============================ 私有成员 ============================
+    vector<T> heap_;               // 以最差元素为顶的堆，容量固定为k
+    size_type k_;                  // 保留的元素个数
+    top_k_worse<Compare> worse_;   // 反转后的比较函数
+
+    // ============================ 私有辅助函数 ============================
+
+    // 用value替换堆顶并下沉
+    void replace_top(const T& value) {
+        sugar::adjust_heap(heap_.begin(), ptrdiff_t(0), static_cast<ptrdiff_t>(heap_.size()), T(value), worse_);
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 构造保留k个元素的累加器，一次性预留全部存储
+     * @param k 保留的元素个数
+     * @param comp 比较函数
+     */
+    explicit top_k_accumulator(size_type k, const Compare& comp = Compare())
+        : heap_(), k_(k), worse_(comp) {
+        heap_.reserve(k);
+    }
+
+    // ============================ 容量 ============================
+
+    size_type size() const noexcept { return heap_.size(); }
+    size_type k() const noexcept { return k_; }
+    bool empty() const noexcept { return heap_.empty(); }
+    bool full() const noexcept { return heap_.size() == k_; }
+
+    /**
+     * @brief 当前保留元素中最差的一个；累加器已满时，不优于它的新元素都会被丢弃
+     */
+    const T& threshold() const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(heap_.empty(), "top_k_accumulator::threshold - accumulator is empty");
+        return heap_.front();
+    }
+
+    /**
+     * @brief 保留元素的无序视图（堆序）
+     */
+    const_iterator begin() const noexcept { return heap_.begin(); }
+    const_iterator end() const noexcept { return heap_.end(); }
+
+    // ============================ 修改操作 ============================
+
+    /**
+     * @brief 加入一个元素
+     * @param value 元素
+     */
+    void push(const T& value) {
+        if (heap_.size() < k_) {
+            heap_.push_back(value);
+            sugar::push_heap(heap_.begin(), heap_.end(), worse_);
+        } else if (k_ > 0 && worse_(value, heap_.front())) {
+            replace_top(value);
+        }
+    }
+
+    /**
+     * @brief 批量加入[first, last)
+     * @param first 起始迭代器
+     * @param last 结束迭代器
+     */
+    template<typename InputIt>
+    void push(InputIt first, InputIt last) {
+        for (; first != last && heap_.size() < k_; ++first) {
+            heap_.push_back(*first);
+            sugar::push_heap(heap_.begin(), heap_.end(), worse_);
+        }
+        if (k_ == 0) {
+            return;
+        }
+        for (; first != last; ++first) {
+            // 堆顶只在替换时变化，热循环里只有一次比较
+            if (worse_(*first, heap_.front())) {
+                replace_top(*first);
+            }
+        }
+    }
+
+    /**
+     * @brief 合并另一个累加器保留的元素，结果等价于把两者的输入一起交给本累加器
+     * @param other 另一个累加器，k可以不同
+     */
+    void merge(const top_k_accumulator& other) {
+        push(other.heap_.begin(), other.heap_.end());
+    }
+
+    /**
+     * @brief 清空保留的元素，保留已预留的存储
+     */
+    void clear() noexcept {
+        heap_.clear();
+    }
+
+    /**
+     * @brief 按从好到差的顺序输出保留的元素，累加器内容不变、可以继续使用
+     * @param out 输出迭代器
+     * @return 输出结束位置
+     */
+    template<typename OutputIt>
+    OutputIt extract(OutputIt out) {
+        sugar::sort_heap(heap_.begin(), heap_.end(), worse_);
+        out = sugar::copy(heap_.begin(), heap_.end(), out);
+        // 从好到差的逆序（从差到好）对worse_而言恰好是合法的堆
+        sugar::reverse(heap_.begin(), heap_.end());
+        return out;
+    }
+};
+
+} // namespace sugar
+
+#endif // TOP_K_H_
@@ -0,0 +1,399 @@
+/*
+ * @file varint.h
+ * @author sugar
+ * @date 2026-10-18
+ * @brief MyMiniSTL 变长整数编码：LEB128 格式的 varint_buffer 与控制字节/数据分离的 stream_vbyte_buffer
+ */
+
+#ifndef VARINT_H_
+#define VARINT_H_
+
+#include "algorithm.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// stream-vbyte 的向量解码需要 SSSE3 的 pshufb（SUGAR_HAS_SSSE3 见 algorithm.h）；未开启时走按控制字节查表的标量路径
+
+namespace sugar {
+
+// ============================ varint_buffer 类 ============================
+
+/**
+ * @brief varint_buffer 类，LEB128 编码的64位无符号整数序列，只支持追加
+ *
+ * 每字节存7位，最高位表示后面还有字节。小于128的值只占1字节。
+ * 每64个值记录一次起始字节偏移，随机访问最多顺序跳过63个值。
+ * 批量解码时一次检查8个字节的最高位，全为0时8个单字节值直接展开。
+ */
+class varint_buffer {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint64_t;
+    using size_type = size_t;
+
+private:
+    static const size_type index_stride = 64;
+
+    // ============================ 私有成员 ============================
+    vector<uint8_t> bytes_;
+    vector<size_type> index_;    // 第64k个值的起始字节偏移
+    size_type size_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static const uint8_t* decode_one(const uint8_t* p, uint64_t& value) noexcept {
+        uint64_t v = *p & 0x7f;
+        unsigned shift = 7;
+        while (*p++ & 0x80) {
+            v |= uint64_t(*p & 0x7f) << shift;
+            shift += 7;
+        }
+        value = v;
+        return p;
+    }
+
+    const uint8_t* seek(size_type i) const noexcept {
+        const uint8_t* p = bytes_.data() + index_[i / index_stride];
+        for (size_type k = i % index_stride; k > 0; --k) {
+            while (*p++ & 0x80) {
+            }
+        }
+        return p;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 默认构造函数
+     */
+    varint_buffer() : size_(0) {}
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief 编码后的字节数（不含索引）
+     */
+    size_type encoded_bytes() const noexcept { return bytes_.size(); }
+
+    /**
+     * @brief 占用的堆内存字节数
+     */
+    size_type memory_bytes() const noexcept {
+        return bytes_.capacity() + index_.capacity() * sizeof(size_type);
+    }
+
+    void shrink_to_fit() {
+        bytes_.shrink_to_fit();
+        index_.shrink_to_fit();
+    }
+
+    // ============================ 元素访问 ============================
+
+    uint64_t operator[](size_type i) const noexcept {
+        SUGAR_DEBUG(i < size_);
+        uint64_t value;
+        decode_one(seek(i), value);
+        return value;
+    }
+
+    uint64_t at(size_type i) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= size_, "varint_buffer::at - index out of range");
+        return (*this)[i];
+    }
+
+    /**
+     * @brief 批量解码[first, first + count)到out
+     */
+    void decode(size_type first, size_type count, uint64_t* out) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(first > size_ || count > size_ - first,
+                                    "varint_buffer::decode - range out of bounds");
+        if (count == 0) {
+            return;
+        }
+        const uint8_t* p = seek(first);
+        const uint8_t* end = bytes_.data() + bytes_.size();
+        while (count >= 8 && end - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0) {
+                for (int k = 0; k < 8; ++k) {
+                    out[k] = p[k];
+                }
+                p += 8;
+                out += 8;
+                count -= 8;
+            } else {
+                p = decode_one(p, *out++);
+                --count;
+            }
+        }
+        for (; count > 0; --count) {
+            p = decode_one(p, *out++);
+        }
+    }
+
+    /**
+     * @brief 全部解码到out
+     */
+    void decode(vector<uint64_t>& out) const {
+        out.resize(size_);
+        decode(0, size_, out.data());
+    }
+
+    // ============================ 修改操作 ============================
+
+    void push_back(uint64_t value) {
+        if (size_ % index_stride == 0) {
+            index_.push_back(bytes_.size());
+        }
+        while (value >= 0x80) {
+            bytes_.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes_.push_back(static_cast<uint8_t>(value));
+        ++size_;
+    }
+
+    void clear() noexcept {
+        bytes_.clear();
+        index_.clear();
+        size_ = 0;
+    }
+};
+
+// ============================ stream_vbyte_buffer 类 ============================
+
+/**
+ * @brief stream_vbyte_buffer 类，stream-vbyte 编码的32位无符号整数序列，只支持追加
+ *
+ * 每个值按大小占1~4个小端字节，长度另存在控制流里：每个值2位，4个值一个控制字节。
+ * 长度与数据分开后，解码一组4个值不再有逐字节的依赖：控制字节直接查表得到
+ * pshufb 的洗牌模板和这组数据的总长，一条指令把16字节展开成4个32位值。
+ * 没有SSSE3时按同样的表逐值做4字节读取加掩码。
+ * 与 varint_buffer 一样每64个值记录一次数据偏移，随机访问时整组跳过按查表累加长度。
+ */
+class stream_vbyte_buffer {
+public:
+    // ============================ 类型定义 ============================
+    using value_type = uint32_t;
+    using size_type = size_t;
+
+private:
+    static const size_type index_stride = 64;
+
+    /**
+     * @brief 由控制字节查得的组长与洗牌模板
+     */
+    struct tables {
+        uint8_t length[256];
+#if SUGAR_HAS_SSSE3
+        alignas(16) uint8_t shuffle[256][16];
+#endif
+
+        tables() {
+            for (unsigned c = 0; c < 256; ++c) {
+                unsigned offset = 0;
+                for (unsigned k = 0; k < 4; ++k) {
+                    const unsigned len = ((c >> (2 * k)) & 3) + 1;
+#if SUGAR_HAS_SSSE3
+                    for (unsigned b = 0; b < 4; ++b) {
+                        shuffle[c][4 * k + b] = static_cast<uint8_t>(b < len ? offset + b : 0x80);
+                    }
+#endif
+                    offset += len;
+                }
+                length[c] = static_cast<uint8_t>(offset);
+            }
+        }
+    };
+
+    static const tables& lookup() {
+        static const tables t;
+        return t;
+    }
+
+    // ============================ 私有成员 ============================
+    vector<uint8_t> control_;
+    vector<uint8_t> data_;
+    vector<size_type> index_;    // 第64k个值的数据起始偏移
+    size_type size_;
+
+    // ============================ 私有辅助函数 ============================
+
+    static unsigned length_of(uint32_t v) noexcept {
+        return v < (1u << 8) ? 1 : v < (1u << 16) ? 2 : v < (1u << 24) ? 3 : 4;
+    }
+
+    unsigned length_at(size_type i) const noexcept {
+        return ((control_[i / 4] >> (2 * (i % 4))) & 3) + 1;
+    }
+
+    /**
+     * @brief 读取len个小端字节；后面至少还有4个字节时用一次4字节读取加掩码
+     */
+    static uint32_t read(const uint8_t* p, const uint8_t* end, unsigned len) noexcept {
+        uint32_t v = 0;
+        if (end - p >= 4) {
+            v = uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+            return v & (~uint32_t(0) >> (32 - 8 * len));
+        }
+        for (unsigned b = len; b > 0; --b) {
+            v = (v << 8) | p[b - 1];
+        }
+        return v;
+    }
+
+    const uint8_t* seek(size_type i) const noexcept {
+        const tables& t = lookup();
+        const uint8_t* p = data_.data() + index_[i / index_stride];
+        for (size_type g = i / index_stride * (index_stride / 4); g < i / 4; ++g) {
+            p += t.length[control_[g]];
+        }
+        for (size_type k = i & ~size_type(3); k < i; ++k) {
+            p += length_at(k);
+        }
+        return p;
+    }
+
+    /**
+     * @brief 解码从控制字节ctrl开始的groups个完整组（每组4个值）
+     */
+    static const uint8_t* decode_groups(const uint8_t* ctrl, size_type groups, const uint8_t* p,
+                                        const uint8_t* end, uint32_t* out) noexcept {
+        size_type g = 0;
+#if SUGAR_HAS_SSSE3
+        const tables& t = lookup();
+        for (; g < groups && end - p >= 16; ++g) {
+            const uint8_t c = ctrl[g];
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[c]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * g), _mm_shuffle_epi8(in, mask));
+            p += t.length[c];
+        }
+#endif
+        for (; g < groups; ++g) {
+            const unsigned c = ctrl[g];
+            for (unsigned k = 0; k < 4; ++k) {
+                const unsigned len = ((c >> (2 * k)) & 3) + 1;
+                out[4 * g + k] = read(p, end, len);
+                p += len;
+            }
+        }
+        return p;
+    }
+
+public:
+    // ============================ 构造函数 ============================
+
+    /**
+     * @brief 默认构造函数
+     */
+    stream_vbyte_buffer() : size_(0) {}
+
+    // ============================ 容量 ============================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief 编码后的字节数（控制流与数据流，不含索引）
+     */
+    size_type encoded_bytes() const noexcept { return control_.size() + data_.size(); }
+
+    /**
+     * @brief 占用的堆内存字节数
+     */
+    size_type memory_bytes() const noexcept {
+        return control_.capacity() + data_.capacity() + index_.capacity() * sizeof(size_type);
+    }
+
+    void shrink_to_fit() {
+        control_.shrink_to_fit();
+        data_.shrink_to_fit();
+        index_.shrink_to_fit();
+    }
+
+    // ============================ 元素访问 ============================
+
+    uint32_t operator[](size_type i) const noexcept {
+        SUGAR_DEBUG(i < size_);
+        return read(seek(i), data_.data() + data_.size(), length_at(i));
+    }
+
+    uint32_t at(size_type i) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(i >= size_, "stream_vbyte_buffer::at - index out of range");
+        return (*this)[i];
+    }
+
+    /**
+     * @brief 批量解码[first, first + count)到out：首尾不满一组的逐个解，中间按组解
+     */
+    void decode(size_type first, size_type count, uint32_t* out) const {
+        SUGAR_THROW_OUT_OF_RANGE_IF(first > size_ || count > size_ - first,
+                                    "stream_vbyte_buffer::decode - range out of bounds");
+        if (count == 0) {
+            return;
+        }
+        const uint8_t* p = seek(first);
+        const uint8_t* end = data_.data() + data_.size();
+        const size_type last = first + count;
+        size_type i = first;
+        for (; i < last && i % 4 != 0; ++i) {
+            const unsigned len = length_at(i);
+            *out++ = read(p, end, len);
+            p += len;
+        }
+        const size_type groups = (last - i) / 4;
+        p = decode_groups(control_.data() + i / 4, groups, p, end, out);
+        out += 4 * groups;
+        i += 4 * groups;
+        for (; i < last; ++i) {
+            const unsigned len = length_at(i);
+            *out++ = read(p, end, len);
+            p += len;
+        }
+    }
+
+    /**
+     * @brief 全部解码到out
+     */
+    void decode(vector<uint32_t>& out) const {
+        out.resize(size_);
+        decode(0, size_, out.data());
+    }
+
+    // ============================ 修改操作 ============================
+
+    void push_back(uint32_t value) {
+        if (size_ % index_stride == 0) {
+            index_.push_back(data_.size());
+        }
+        if (size_ % 4 == 0) {
+            control_.push_back(0);
+        }
+        const unsigned len = length_of(value);
+        control_.back() = static_cast<uint8_t>(control_.back() | ((len - 1) << (2 * (size_ % 4))));
+        for (unsigned b = 0; b < len; ++b) {
+            data_.push_back(static_cast<uint8_t>(value >> (8 * b)));
+        }
+        ++size_;
+    }
+
+    void clear() noexcept {
+        control_.clear();
+        data_.clear();
+        index_.clear();
+        size_ = 0;
+    }
+};
+
+} // namespace sugar
+
+#endif // VARINT_H_